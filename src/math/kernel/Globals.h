@@ -118,6 +118,7 @@ static const double MAXGAM  = 171.624376956302725;
 // matrix errors
 #define HW_MATH_MSG_OUTOFMEMORY     "Error: available memory exhausted"
 #define HW_MATH_MSG_ALLOCFAILED     "Error: allocation failure"
+#define HW_MATH_MSG_ARRAYTOOLARGE   "Error: invalid dimensions; array is too large"
 #define HW_MATH_MSG_NONEMPTYMATRIX  "Error: invalid matrix; must be []"
 #define HW_MATH_MSG_EMPTYMATRIX     "Error: invalid matrix; must contain data"
 #define HW_MATH_MSG_MATRIXRESIZE    "Error: invalid matrix; cannot be resized"
@@ -284,6 +285,7 @@ enum hwMathMsgCode
     // matrix errors
     HW_MATH_ERR_OUTOFMEMORY,
     HW_MATH_ERR_ALLOCFAILED,
+    HW_MATH_ERR_ARRAYTOOLARGE,
     HW_MATH_ERR_EMPTYMATRIX,
     HW_MATH_ERR_NONEMPTYMATRIX,
     HW_MATH_ERR_MATRIXRESIZE,
@@ -105,6 +105,7 @@ std::string GetHMathErrMsg(hwMathMsgCode code)
             // matrix errors
             case HW_MATH_ERR_OUTOFMEMORY:           retStr = HW_MATH_MSG_OUTOFMEMORY;       break;
             case HW_MATH_ERR_ALLOCFAILED:           retStr = HW_MATH_MSG_ALLOCFAILED;       break;
+            case HW_MATH_ERR_ARRAYTOOLARGE:         retStr = HW_MATH_MSG_ARRAYTOOLARGE;     break;
             case HW_MATH_ERR_EMPTYMATRIX:           retStr = HW_MATH_MSG_EMPTYMATRIX;       break;
             case HW_MATH_ERR_NONEMPTYMATRIX:        retStr = HW_MATH_MSG_NONEMPTYMATRIX;    break;
             case HW_MATH_ERR_MATRIXRESIZE:          retStr = HW_MATH_MSG_MATRIXRESIZE;      break;
@@ -0,0 +1,590 @@
+/**
+* @file hwBlasBackend.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  BLAS / LAPACK backend selection
+//
+//:---------------------------------------------------------------------------
+
+#include <hwBlasBackend.h>
+
+#include <cstdlib>
+
+#ifdef OS_WIN
+#   include <windows.h>
+#else
+#   include <dlfcn.h>
+#endif
+
+//*******************************************************************
+//                    Reference BLAS / LAPACK prototypes
+//*******************************************************************
+
+// y = x
+extern "C" void dcopy_(int* N, double* DX, int* INCX, double* DY, int* INCY);
+extern "C" void zcopy_(int* N, complexD* DX, int* INCX, complexD* DY, int* INCY);
+// y = ay
+extern "C" void dscal_(int* N, double* DA, double* DX, int* INCX);
+extern "C" void zscal_(int* N, complexD* DA, complexD* DX, int* INCX);
+// y = ax + y
+extern "C" void daxpy_(int* N, double* DA, double* DX, int* INCX, double* DY, int* INCY);
+extern "C" void zaxpy_(int* N, complexD* DA, complexD* DX, int* INCX, complexD* DY, int* INCY);
+// C = alpha*op( A )*op( B ) + beta*C
+extern "C" void dgemm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                       double* ALPHA, double* A, int* LDA, double* B, int* LDB,
+                       double* BETA, double* C, int* LDC);
+extern "C" void zgemm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                       complexD* ALPHA, complexD* A, int* LDA, complexD* B,
+                       int* LDB, complexD* BETA, complexD* C, int* LDC);
+extern "C" void sgemm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                       float* ALPHA, float* A, int* LDA, float* B, int* LDB,
+                       float* BETA, float* C, int* LDC);
+extern "C" void cgemm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                       complexF* ALPHA, complexF* A, int* LDA, complexF* B,
+                       int* LDB, complexF* BETA, complexF* C, int* LDC);
+// y = alpha*op( A )*x + beta*y
+extern "C" void dgemv_(char* TRANS, int* M, int* N, double* ALPHA, double* A, int* LDA,
+                       double* X, int* INCX, double* BETA, double* Y, int* INCY);
+// C = alpha*A*A' + beta*C or C = alpha*A'*A + beta*C, for one triangle of C
+extern "C" void dsyrk_(char* UPLO, char* TRANS, int* N, int* K, double* ALPHA, double* A,
+                       int* LDA, double* BETA, double* C, int* LDC);
+// Dot(X,Y)
+extern "C" double ddot_(int* N, double* DX, int* INCX, double* DY, int* INCY);
+extern "C" void zdotc_(complexD* dotc, int* N, complexD* DX, int* INCX, complexD* DY, int* INCY);
+// LU decomposition
+extern "C" void dgetrf_(int* M, int* N, double* A, int* LDA, int* IPIV, int* INFO);
+extern "C" void zgetrf_(int* M, int* N, complexD* A, int* LDA, int* IPIV, int* INFO);
+extern "C" void dgetrs_(char* TRANS, int* N, int* NRHS, double* A, int* LDA, int* IPIV,
+                        double* B, int* LDB, int* INFO);
+// Matrix inversion
+extern "C" void dgetri_(int* N, double* A, int* LDA, int* IPIV, double* WORK, int* LWORK, int* INFO);
+extern "C" void zgetri_(int* N, complexD* A, int* LDA, int* IPIV, complexD* WORK, int* LWORK, int* INFO);
+// Solve AX=B via LU
+extern "C" void dgesv_(int* N, int* NRHS, double* A, int* LDA, int* IPIV,
+                       double* B, int* LDB, int* INFO);
+extern "C" void zgesv_(int* N, int* NRHS, complexD* A, int* LDA, int* IPIV,
+                       complexD* B, int* LDB, int* INFO);
+// Solve AX=B via LU for triangular A
+extern "C" void dgtsv_(int* N, int* NRHS, double* DL, double* D,
+                       double* DU, double* B, int* LDB, int* INFO);
+// LU decomposition of tridiagonal A, its solve and its condition number
+extern "C" void dgttrf_(int* N, double* DL, double* D, double* DU, double* DU2,
+                        int* IPIV, int* INFO);
+extern "C" void dgttrs_(char* TRANS, int* N, int* NRHS, double* DL, double* D,
+                        double* DU, double* DU2, int* IPIV, double* B, int* LDB,
+                        int* INFO);
+extern "C" void dgtcon_(char* NORM, int* N, double* DL, double* D, double* DU,
+                        double* DU2, int* IPIV, double* ANORM, double* RCOND,
+                        double* WORK, int* IWORK, int* INFO);
+// Solve AX=B via LU for band A, and its condition number
+extern "C" void dgbsv_(int* N, int* KL, int* KU, int* NRHS, double* AB,
+                       int* LDAB, int* IPIV, double* B, int* LDB, int* INFO);
+extern "C" void dgbcon_(char* NORM, int* N, int* KL, int* KU, double* AB,
+                        int* LDAB, int* IPIV, double* ANORM, double* RCOND,
+                        double* WORK, int* IWORK, int* INFO);
+// Solve AX=B via Cholesky for SPD A
+extern "C" void dposv_(char* UPLO, int* N, int* NRHS, double* A, int* LDA, double* B,
+                       int* LDB, int* INFO);
+// Solve AX=B via Cholesky for SPD triangular A, and its condition number
+extern "C" void dptsv_(int* N, int* NRHS, double* D, double* E, double* B,
+                       int* LDB, int* INFO);
+extern "C" void dptcon_(int* N, double* D, double* E, double* ANORM, double* RCOND,
+                        double* WORK, int* INFO);
+// Solve AX=B via Cholesky for SPD BAND A, and its condition number
+extern "C" void dpbsv_(char* UPLO, int* N, int* KD, int* NRHS, double* AB,
+                       int* LDAB, double* B, int* LDB, int* INFO);
+extern "C" void dpbcon_(char* UPLO, int* N, int* KD, double* AB, int* LDAB,
+                        double* ANORM, double* RCOND, double* WORK, int* IWORK,
+                        int* INFO);
+// Solve AX=B for symmetric indefinite A, and its condition number
+extern "C" void dsysv_(char* UPLO, int* N, int* NRHS, double* A, int* LDA,
+                       int* IPIV, double* B, int* LDB, double* WORK,
+                       int* LWORK, int* INFO);
+extern "C" void dsycon_(char* UPLO, int* N, double* A, int* LDA, int* IPIV,
+                        double* ANORM, double* RCOND, double* WORK, int* IWORK,
+                        int* INFO);
+// Eigen decomposition
+extern "C" void dsyev_(char* JOBZ, char* UPLO, int* N, double* A, int* LDA, double* W,
+                       double* WORK, int* LWORK, int* INFO);
+extern "C" void dgeevx_(char* balanc, char* jobvl, char* jobvr, char* sense, int* n,
+                        double* a, int* lda, double* wr ,double* wi, double* vl,
+                        int* ldvl, double* vr, int* ldvr, int* ilo, int* ihi,
+                        double* scale, double* abnrm, double* rconde, double* rcondv,
+                        double* work, int* lwork, int* iwork, int* info);
+extern "C" void zheev_(char* jobz, char* uplo, int* n, complexD* a, int* lda, double* w,
+                       complexD* work, int* lwork, double* rwork, int* info);
+extern "C" void zgeevx_(char* balanc, char* jobvl, char* jobvr, char* sense, int* n,
+                        complexD* a, int* lda, complexD* w, complexD* vl, int* ldvl,
+                        complexD* vr, int* ldvr, int* ilo, int* ihi, double* scale,
+                        double* abnrm, double* rconde, double* rcondv, complexD* work,
+                        int* lwork, double* rwork, int* info);
+extern "C" void dstev_(char* JOBZ, int* N, double* D, double* E, double* Z,
+                       int* LDZ, double* WORK, int* INFO);
+extern "C" void dsbev_(char* JOBZ, char* UPLO, int* N, int* KD, double* AB,
+                       int* LDAB, double* W, double* Z, int* LDZ,
+                       double* WORK, int* INFO);
+//! Balance a matrix
+extern "C" void dgebal_(char* job, int* n, double* a, int* lda, int* ilo, int* ihi,
+                        double* scale, int* info);
+extern "C" void zgebal_(char* job, int* n, complexD* a, int* lda, int* ilo, int* ihi,
+                        double* scale, int* info);
+//! Generalized Eigen decomposition
+extern "C" void dsygv_(int* itype, char* jobz, char* uplo ,int* n, double* a, int* lda,
+                       double* b, int* ldb, double* w, double* work, int* lwork, int* info);
+extern "C" void dggev_(char* jobvl, char* jobvr ,int* n, double* a, int* lda, double* b,
+                       int* ldb, double* alphar, double* alphai, double* beta, double* vl,
+                       int* ldvl, double* vr, int* ldvr, double* work, int* lwork, int* info);
+extern "C" void zhegv_(int* itype, char* jobz, char* uplo, int* n, complexD* a, int* lda,
+                       complexD* b, int* ldb, double* w, complexD* work, int* lwork,
+                       double* rwork, int* info);
+extern "C" void zggev_(char* jobvl, char* jobvr, int* n, complexD* a, int* lda, complexD* b,
+                       int* ldb, complexD* alpha, complexD* beta, complexD* vl, int* ldvl,
+                       complexD* vr, int* ldvr, complexD* work, int* lwork, double* rwork,
+                       int* info);
+// Cholesky decomposition of SPD matrix
+extern "C" void dpotrf_(char* UPLO, int* N, double* A, int* LDA, int* INFO);
+// Solve with the Cholesky decomposition, and its condition number
+extern "C" void dpotrs_(char* UPLO, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, int* INFO);
+extern "C" void dpocon_(char* UPLO, int* N, double* A, int* LDA, double* ANORM, double* RCOND,
+                        double* WORK, int* IWORK, int* INFO);
+// Triangular solve, and its condition number
+extern "C" void dtrtrs_(char* UPLO, char* TRANS, char* DIAG, int* N, int* NRHS, double* A, int* LDA,
+                        double* B, int* LDB, int* INFO);
+extern "C" void dtrcon_(char* NORM, char* UPLO, char* DIAG, int* N, double* A, int* LDA, double* RCOND,
+                        double* WORK, int* IWORK, int* INFO);
+// Singular value decomposition
+extern "C" void dgesvd_(char* JOBU, char* JOBVT, int* M, int* N, double* A, int* LDA, double* S, double* U,
+                        int* LDU, double* VT, int* LDVT, double* WORK, int* LWORK, int* INFO);
+extern "C" void zgesvd_(char *jobu, char *jobvt, int *m, int *n, complexD *a, int *lda, double *s, complexD *u,
+                        int *ldu, complexD *vt, int *ldvt, complexD *work, int *lwork, double *rwork, int *info);
+extern "C" void dgesdd_(char* JOBZ, int* M, int* N, double* A, int* LDA, double* S, double* U,
+                        int* LDU, double* VT, int* LDVT, double* WORK, int* LWORK, int* INFO);
+// QR decomposition
+extern "C" void dgeqrf_(int* M, int* N, double* A, int* LDA, double* TAU, double* WORK,
+                        int* LWORK, int* INFO);
+extern "C" void dorgqr_(int* M, int* N, int* K, double* A, int* LDA, double* TAU,
+                        double* WORK, int* LWORK, int* INFO);
+extern "C" void zgeqrf_(int* M, int* N, complexD* A, int* LDA, complexD* TAU, complexD* WORK,
+                        int* LWORK, int* INFO);
+extern "C" void zungqr_(int* M, int* N, int* K, complexD* A, int* LDA, complexD* TAU,
+                        complexD* WORK, int* LWORK, int* INFO);
+// Schur decomposition
+extern "C" void dgees_(char* jobvs, char* sort, void* select, int* n, double* a, int* lda, int* sdim,
+                       double* wr, double* wi, double* vs, int* ldvs, double* work ,int* lwork,
+                       void* bwork, int* info);
+extern "C" void zgees_(char* jobvs, char* sort, void* select, int* n, complexD* a, int* lda,
+                       int* sdim, complexD* w, complexD* vs, int* ldvs, complexD* work,
+                       int* lwork, double* rwork, void* bwork, int* info);
+// Solve AX=B via QR
+//extern "C" void dgels_(char* TRANS, int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB,
+//                       double* WORK, int* LWORK, int* INFO);
+//extern "C" void zgels_(char* TRANS, int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB,
+//                       complexD* WORK, int* LWORK, int* INFO);
+extern "C" void dgelsy_(int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, int* JPVT,
+                        double* RCOND, int* RANK, double* WORK, int* LWORK, int* INFO);
+extern "C" void zgelsy_(int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB, int* JPVT,
+                        double* RCOND, int* RANK, complexD* WORK, int* LWORK, double* RWORK, int* INFO);
+// Solve AX=B via SVD
+extern "C" void dgelss_(int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, double* S,
+                        double* RCOND, int* RANK, double* WORK, int* LWORK, int* INFO);
+extern "C" void zgelss_(int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB, double* S,
+                        double* RCOND, int* RANK, complexD* WORK, int* LWORK, double* RWORK, int* INFO);
+// Condition number
+extern "C" void dgecon_(char* NORM, int* N, double* A, int* LDA, double* ANORM, double* RCOND,
+                        double* WORK, int* IWORK, int* INFO);
+extern "C" void zgecon_(char* norm, int* n, complexD* a, int* lda, double* anorm, double* rcond,
+                        complexD* work, double* rwork, int* info);
+// Matrix norm
+extern "C" double dlange_(char* norm, int* m, int* n, double* a, int* lda, double* work);
+extern "C" double zlange_(char* norm, int* m, int* n, complexD* a, int* lda, double* work);
+// Vector L2 norm
+extern "C" double dnrm2_(int* N,double* X, int* INCX);
+
+//*******************************************************************
+//                    Active entry points
+//*******************************************************************
+decltype(hwBlas::dcopy_) hwBlas::dcopy_ = ::dcopy_;
+decltype(hwBlas::zcopy_) hwBlas::zcopy_ = ::zcopy_;
+decltype(hwBlas::dscal_) hwBlas::dscal_ = ::dscal_;
+decltype(hwBlas::zscal_) hwBlas::zscal_ = ::zscal_;
+decltype(hwBlas::daxpy_) hwBlas::daxpy_ = ::daxpy_;
+decltype(hwBlas::zaxpy_) hwBlas::zaxpy_ = ::zaxpy_;
+decltype(hwBlas::dgemm_) hwBlas::dgemm_ = ::dgemm_;
+decltype(hwBlas::zgemm_) hwBlas::zgemm_ = ::zgemm_;
+decltype(hwBlas::sgemm_) hwBlas::sgemm_ = ::sgemm_;
+decltype(hwBlas::cgemm_) hwBlas::cgemm_ = ::cgemm_;
+decltype(hwBlas::dgemv_) hwBlas::dgemv_ = ::dgemv_;
+decltype(hwBlas::dsyrk_) hwBlas::dsyrk_ = ::dsyrk_;
+decltype(hwBlas::ddot_) hwBlas::ddot_ = ::ddot_;
+decltype(hwBlas::zdotc_) hwBlas::zdotc_ = ::zdotc_;
+decltype(hwBlas::dgetrf_) hwBlas::dgetrf_ = ::dgetrf_;
+decltype(hwBlas::zgetrf_) hwBlas::zgetrf_ = ::zgetrf_;
+decltype(hwBlas::dgetrs_) hwBlas::dgetrs_ = ::dgetrs_;
+decltype(hwBlas::dgetri_) hwBlas::dgetri_ = ::dgetri_;
+decltype(hwBlas::zgetri_) hwBlas::zgetri_ = ::zgetri_;
+decltype(hwBlas::dgesv_) hwBlas::dgesv_ = ::dgesv_;
+decltype(hwBlas::zgesv_) hwBlas::zgesv_ = ::zgesv_;
+decltype(hwBlas::dgtsv_) hwBlas::dgtsv_ = ::dgtsv_;
+decltype(hwBlas::dgttrf_) hwBlas::dgttrf_ = ::dgttrf_;
+decltype(hwBlas::dgttrs_) hwBlas::dgttrs_ = ::dgttrs_;
+decltype(hwBlas::dgtcon_) hwBlas::dgtcon_ = ::dgtcon_;
+decltype(hwBlas::dgbsv_) hwBlas::dgbsv_ = ::dgbsv_;
+decltype(hwBlas::dgbcon_) hwBlas::dgbcon_ = ::dgbcon_;
+decltype(hwBlas::dposv_) hwBlas::dposv_ = ::dposv_;
+decltype(hwBlas::dptsv_) hwBlas::dptsv_ = ::dptsv_;
+decltype(hwBlas::dptcon_) hwBlas::dptcon_ = ::dptcon_;
+decltype(hwBlas::dpbsv_) hwBlas::dpbsv_ = ::dpbsv_;
+decltype(hwBlas::dpbcon_) hwBlas::dpbcon_ = ::dpbcon_;
+decltype(hwBlas::dsysv_) hwBlas::dsysv_ = ::dsysv_;
+decltype(hwBlas::dsycon_) hwBlas::dsycon_ = ::dsycon_;
+decltype(hwBlas::dsyev_) hwBlas::dsyev_ = ::dsyev_;
+decltype(hwBlas::dgeevx_) hwBlas::dgeevx_ = ::dgeevx_;
+decltype(hwBlas::zheev_) hwBlas::zheev_ = ::zheev_;
+decltype(hwBlas::zgeevx_) hwBlas::zgeevx_ = ::zgeevx_;
+decltype(hwBlas::dstev_) hwBlas::dstev_ = ::dstev_;
+decltype(hwBlas::dsbev_) hwBlas::dsbev_ = ::dsbev_;
+decltype(hwBlas::dgebal_) hwBlas::dgebal_ = ::dgebal_;
+decltype(hwBlas::zgebal_) hwBlas::zgebal_ = ::zgebal_;
+decltype(hwBlas::dsygv_) hwBlas::dsygv_ = ::dsygv_;
+decltype(hwBlas::dggev_) hwBlas::dggev_ = ::dggev_;
+decltype(hwBlas::zhegv_) hwBlas::zhegv_ = ::zhegv_;
+decltype(hwBlas::zggev_) hwBlas::zggev_ = ::zggev_;
+decltype(hwBlas::dpotrf_) hwBlas::dpotrf_ = ::dpotrf_;
+decltype(hwBlas::dpotrs_) hwBlas::dpotrs_ = ::dpotrs_;
+decltype(hwBlas::dpocon_) hwBlas::dpocon_ = ::dpocon_;
+decltype(hwBlas::dtrtrs_) hwBlas::dtrtrs_ = ::dtrtrs_;
+decltype(hwBlas::dtrcon_) hwBlas::dtrcon_ = ::dtrcon_;
+decltype(hwBlas::dgesvd_) hwBlas::dgesvd_ = ::dgesvd_;
+decltype(hwBlas::zgesvd_) hwBlas::zgesvd_ = ::zgesvd_;
+decltype(hwBlas::dgesdd_) hwBlas::dgesdd_ = ::dgesdd_;
+decltype(hwBlas::dgeqrf_) hwBlas::dgeqrf_ = ::dgeqrf_;
+decltype(hwBlas::dorgqr_) hwBlas::dorgqr_ = ::dorgqr_;
+decltype(hwBlas::zgeqrf_) hwBlas::zgeqrf_ = ::zgeqrf_;
+decltype(hwBlas::zungqr_) hwBlas::zungqr_ = ::zungqr_;
+decltype(hwBlas::dgees_) hwBlas::dgees_ = ::dgees_;
+decltype(hwBlas::zgees_) hwBlas::zgees_ = ::zgees_;
+decltype(hwBlas::dgelsy_) hwBlas::dgelsy_ = ::dgelsy_;
+decltype(hwBlas::zgelsy_) hwBlas::zgelsy_ = ::zgelsy_;
+decltype(hwBlas::dgelss_) hwBlas::dgelss_ = ::dgelss_;
+decltype(hwBlas::zgelss_) hwBlas::zgelss_ = ::zgelss_;
+decltype(hwBlas::dgecon_) hwBlas::dgecon_ = ::dgecon_;
+decltype(hwBlas::zgecon_) hwBlas::zgecon_ = ::zgecon_;
+decltype(hwBlas::dlange_) hwBlas::dlange_ = ::dlange_;
+decltype(hwBlas::zlange_) hwBlas::zlange_ = ::zlange_;
+decltype(hwBlas::dnrm2_) hwBlas::dnrm2_ = ::dnrm2_;
+
+namespace
+{
+    //! Entry point of a routine and its reference implementation
+    struct BlasEntry
+    {
+        const char* name;
+        void**      entry;
+        void*       reference;
+    };
+
+    #define BLAS_ENTRY(f) { #f, (void**) &hwBlas::f, (void*) ::f }
+
+    //! Routines taken from a loaded library. zdotc_ is excluded because
+    //! optimized libraries return the complex result by value rather than
+    //! through the first argument.
+    BlasEntry blasTable[] =
+    {
+    BLAS_ENTRY(dcopy_),
+    BLAS_ENTRY(zcopy_),
+    BLAS_ENTRY(dscal_),
+    BLAS_ENTRY(zscal_),
+    BLAS_ENTRY(daxpy_),
+    BLAS_ENTRY(zaxpy_),
+    BLAS_ENTRY(dgemm_),
+    BLAS_ENTRY(zgemm_),
+    BLAS_ENTRY(sgemm_),
+    BLAS_ENTRY(cgemm_),
+    BLAS_ENTRY(dgemv_),
+    BLAS_ENTRY(dsyrk_),
+    BLAS_ENTRY(ddot_),
+    BLAS_ENTRY(dgetrf_),
+    BLAS_ENTRY(zgetrf_),
+    BLAS_ENTRY(dgetrs_),
+    BLAS_ENTRY(dgetri_),
+    BLAS_ENTRY(zgetri_),
+    BLAS_ENTRY(dgesv_),
+    BLAS_ENTRY(zgesv_),
+    BLAS_ENTRY(dgtsv_),
+    BLAS_ENTRY(dgttrf_),
+    BLAS_ENTRY(dgttrs_),
+    BLAS_ENTRY(dgtcon_),
+    BLAS_ENTRY(dgbsv_),
+    BLAS_ENTRY(dgbcon_),
+    BLAS_ENTRY(dposv_),
+    BLAS_ENTRY(dptsv_),
+    BLAS_ENTRY(dptcon_),
+    BLAS_ENTRY(dpbsv_),
+    BLAS_ENTRY(dpbcon_),
+    BLAS_ENTRY(dsysv_),
+    BLAS_ENTRY(dsycon_),
+    BLAS_ENTRY(dsyev_),
+    BLAS_ENTRY(dgeevx_),
+    BLAS_ENTRY(zheev_),
+    BLAS_ENTRY(zgeevx_),
+    BLAS_ENTRY(dstev_),
+    BLAS_ENTRY(dsbev_),
+    BLAS_ENTRY(dgebal_),
+    BLAS_ENTRY(zgebal_),
+    BLAS_ENTRY(dsygv_),
+    BLAS_ENTRY(dggev_),
+    BLAS_ENTRY(zhegv_),
+    BLAS_ENTRY(zggev_),
+    BLAS_ENTRY(dpotrf_),
+    BLAS_ENTRY(dpotrs_),
+    BLAS_ENTRY(dpocon_),
+    BLAS_ENTRY(dtrtrs_),
+    BLAS_ENTRY(dtrcon_),
+    BLAS_ENTRY(dgesvd_),
+    BLAS_ENTRY(zgesvd_),
+    BLAS_ENTRY(dgesdd_),
+    BLAS_ENTRY(dgeqrf_),
+    BLAS_ENTRY(dorgqr_),
+    BLAS_ENTRY(zgeqrf_),
+    BLAS_ENTRY(zungqr_),
+    BLAS_ENTRY(dgees_),
+    BLAS_ENTRY(zgees_),
+    BLAS_ENTRY(dgelsy_),
+    BLAS_ENTRY(zgelsy_),
+    BLAS_ENTRY(dgelss_),
+    BLAS_ENTRY(zgelss_),
+    BLAS_ENTRY(dgecon_),
+    BLAS_ENTRY(zgecon_),
+    BLAS_ENTRY(dlange_),
+    BLAS_ENTRY(zlange_),
+    BLAS_ENTRY(dnrm2_),
+    };
+
+    #undef BLAS_ENTRY
+
+    const int blasTableSize = sizeof(blasTable) / sizeof(BlasEntry);
+
+    typedef void (*SetThreadsFunc)(int);
+    typedef int  (*GetThreadsFunc)();
+    typedef void (*SetThreadsFunc64)(long long);
+    typedef long long (*GetThreadsFunc64)();
+
+    void*            libHandle  = NULL;
+    std::string      libName    = "reference";
+    std::string      libFile;
+    SetThreadsFunc   setThreads = NULL;
+    GetThreadsFunc   getThreads = NULL;
+    SetThreadsFunc64 setThreads64 = NULL;    // BLIS uses a 64 bit dim_t
+    GetThreadsFunc64 getThreads64 = NULL;
+
+    void* OpenLibrary(const std::string& lib)
+    {
+#ifdef OS_WIN
+        return (void*) LoadLibraryA(lib.c_str());
+#else
+        int flags = RTLD_NOW | RTLD_LOCAL;
+#   ifdef RTLD_DEEPBIND
+        // resolve calls made inside the library (e.g. from its LAPACK to
+        // its BLAS) to the library itself rather than to the reference
+        // routines linked into mathcore
+        flags |= RTLD_DEEPBIND;
+#   endif
+        return dlopen(lib.c_str(), flags);
+#endif
+    }
+
+    void* GetSymbol(void* handle, const char* name)
+    {
+#ifdef OS_WIN
+        return (void*) GetProcAddress((HMODULE) handle, name);
+#else
+        return dlsym(handle, name);
+#endif
+    }
+
+    void CloseLibrary(void* handle)
+    {
+#ifdef OS_WIN
+        FreeLibrary((HMODULE) handle);
+#else
+        dlclose(handle);
+#endif
+    }
+
+    //! Restore the reference routines
+    void ResetTable()
+    {
+        for (int i = 0; i < blasTableSize; ++i)
+            *blasTable[i].entry = blasTable[i].reference;
+    }
+}
+
+//! Loads the backend named by the OML_BLAS environment variable
+bool hwBlasBackend::Initialize()
+{
+    const char* env = getenv("OML_BLAS");
+
+    if (!env || !*env)
+        return true;
+
+    return Load(env);
+}
+
+//! Loads a BLAS / LAPACK shared library
+bool hwBlasBackend::Load(const std::string& lib)
+{
+    if (lib.empty())
+        return false;
+
+    if (lib == "auto")
+    {
+        // first optimized library found on the search path
+#ifdef OS_WIN
+        const char* candidates[] = { "libopenblas.dll", "mkl_rt.2.dll", "mkl_rt.dll",
+                                     "libblis.4.dll", "libblis.dll" };
+#else
+        const char* candidates[] = { "libopenblas.so.0", "libopenblas.so", "libmkl_rt.so.2",
+                                     "libmkl_rt.so", "libblis.so.4", "libblis.so" };
+#endif
+        int numCandidates = sizeof(candidates) / sizeof(const char*);
+
+        for (int i = 0; i < numCandidates; ++i)
+        {
+            if (Load(candidates[i]))
+                return true;
+        }
+
+        return false;
+    }
+
+    void* handle = NULL;
+
+    if (lib != "reference")
+    {
+        handle = OpenLibrary(lib);
+
+        if (!handle)
+            return false;
+
+        // a library without dgemm is not a BLAS library
+        if (!GetSymbol(handle, "dgemm_"))
+        {
+            CloseLibrary(handle);
+            return false;
+        }
+    }
+
+    ResetTable();
+
+    void* oldHandle = libHandle;
+
+    libHandle    = handle;
+    libName      = "reference";
+    libFile.clear();
+    setThreads   = NULL;
+    getThreads   = NULL;
+    setThreads64 = NULL;
+    getThreads64 = NULL;
+
+    if (handle)
+    {
+        for (int i = 0; i < blasTableSize; ++i)
+        {
+            void* func = GetSymbol(handle, blasTable[i].name);
+
+            if (func)
+                *blasTable[i].entry = func;
+        }
+
+        libFile = lib;
+
+        if (GetSymbol(handle, "openblas_set_num_threads"))
+        {
+            libName    = "openblas";
+            setThreads = (SetThreadsFunc) GetSymbol(handle, "openblas_set_num_threads");
+            getThreads = (GetThreadsFunc) GetSymbol(handle, "openblas_get_num_threads");
+        }
+        else if (GetSymbol(handle, "MKL_Set_Num_Threads"))
+        {
+            libName    = "mkl";
+            setThreads = (SetThreadsFunc) GetSymbol(handle, "MKL_Set_Num_Threads");
+            getThreads = (GetThreadsFunc) GetSymbol(handle, "MKL_Get_Max_Threads");
+        }
+        else if (GetSymbol(handle, "bli_thread_set_num_threads"))
+        {
+            libName      = "blis";
+            setThreads64 = (SetThreadsFunc64) GetSymbol(handle, "bli_thread_set_num_threads");
+            getThreads64 = (GetThreadsFunc64) GetSymbol(handle, "bli_thread_get_num_threads");
+        }
+        else
+        {
+            libName = "other";
+        }
+    }
+
+    if (oldHandle)
+        CloseLibrary(oldHandle);
+
+    return true;
+}
+
+//! Returns the backend name
+std::string hwBlasBackend::GetName()
+{
+    return libName;
+}
+
+//! Returns the file name of the loaded library
+std::string hwBlasBackend::GetLibrary()
+{
+    return libFile;
+}
+
+//! Returns the number of threads used by the backend
+int hwBlasBackend::GetNumThreads()
+{
+    if (getThreads)
+        return getThreads();
+
+    if (getThreads64)
+        return (int) getThreads64();
+
+    return 1;
+}
+
+//! Sets the number of threads used by the backend
+bool hwBlasBackend::SetNumThreads(int numThreads)
+{
+    if (numThreads < 1)
+        return false;
+
+    if (setThreads)
+    {
+        setThreads(numThreads);
+        return true;
+    }
+
+    if (setThreads64)
+    {
+        setThreads64(numThreads);
+        return true;
+    }
+
+    return (numThreads == 1);
+}
@@ -0,0 +1,386 @@
+/**
+* @file hwConvolution.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Direct and FFT linear convolution kernels
+//
+//:---------------------------------------------------------------------------
+
+#include <hwConvolution.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <hwThreadPool.h>
+
+namespace
+{
+    //! Measured cost of the FFT convolution per n*log2(n), relative to one
+    //! multiply-add of the direct sum
+    const double FFT_COST = 10.0;
+
+    //! Return the smallest power of 2 that is at least n
+    int PowerOf2(int n)
+    {
+        int p = 1;
+
+        while (p < n)
+            p <<= 1;
+
+        return p;
+    }
+
+    //! Determine if the FFT is cheaper than the direct sum, given the number
+    //! of multiply-adds of the direct sum and the padded transform size
+    bool UseFFT(double directOps, int p, int q)
+    {
+        double size = static_cast<double>(p) * q;
+        double fftOps = FFT_COST * size * std::log2(size);
+
+        return directOps > fftOps;
+    }
+
+    //! In place radix 2 FFT of n interleaved complex values, forward when
+    //! sign is -1 and unscaled inverse when sign is 1. The stride is the
+    //! distance between successive values.
+    void FFT(double* a, int n, int stride, int sign, const std::vector<double>& twiddle)
+    {
+        // bit reversal permutation
+        for (int i = 1, j = 0; i < n; ++i)
+        {
+            int bit = n >> 1;
+
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+
+            j ^= bit;
+
+            if (i < j)
+            {
+                std::swap(a[2 * i * stride], a[2 * j * stride]);
+                std::swap(a[2 * i * stride + 1], a[2 * j * stride + 1]);
+            }
+        }
+
+        // butterflies, with the twiddles of each stage stored contiguously
+        for (int half = 1; half < n; half <<= 1)
+        {
+            const double* w = twiddle.data() + 2 * half;
+
+            for (int i = 0; i < n; i += 2 * half)
+            {
+                double* u = a + 2 * i * stride;
+                double* v = a + 2 * (i + half) * stride;
+
+                for (int j = 0; j < half; ++j)
+                {
+                    double wr = w[2 * j];
+                    double wi = sign * w[2 * j + 1];
+                    double vr = v[0] * wr - v[1] * wi;
+                    double vi = v[0] * wi + v[1] * wr;
+                    v[0] = u[0] - vr;
+                    v[1] = u[1] - vi;
+                    u[0] += vr;
+                    u[1] += vi;
+                    u += 2 * stride;
+                    v += 2 * stride;
+                }
+            }
+        }
+    }
+
+    //! Return the twiddle factors for transforms of size n, where the stage
+    //! combining transforms of size half has exp(-pi*i*j/half) for j < half
+    //! at complex offset half
+    std::vector<double> Twiddles(int n)
+    {
+        std::vector<double> twiddle(2 * std::max(n, 2));
+
+        for (int half = 1; half < n; half <<= 1)
+        {
+            double theta = -3.14159265358979323846 / half;
+
+            for (int j = 0; j < half; ++j)
+            {
+                twiddle[2 * (half + j)] = std::cos(theta * j);
+                twiddle[2 * (half + j) + 1] = std::sin(theta * j);
+            }
+        }
+
+        return twiddle;
+    }
+
+    //! In place 2D FFT of a column major p x q array of interleaved complex
+    //! values, with p and q powers of 2
+    void FFT2D(double* a, int p, int q, int sign,
+               const std::vector<double>& colTwiddle, const std::vector<double>& rowTwiddle)
+    {
+        if (p > 1)
+        {
+            hwThreadPool::ParallelFor(q, [&](int64_t begin, int64_t end)
+            {
+                for (int j = begin; j < end; ++j)
+                    FFT(a + 2 * j * p, p, 1, sign, colTwiddle);
+            }, 5 * p);
+        }
+
+        if (q > 1)
+        {
+            hwThreadPool::ParallelFor(p, [&](int64_t begin, int64_t end)
+            {
+                for (int i = begin; i < end; ++i)
+                    FFT(a + 2 * i, q, p, sign, rowTwiddle);
+            }, 5 * q);
+        }
+    }
+
+    //! Scalar helpers so the direct sums can be written once
+    inline void AddProduct(double& sum, double a, double b) { sum += a * b; }
+    inline void AddProduct(hwComplex& sum, const hwComplex& a, const hwComplex& b) { sum += a * b; }
+    inline double Zero(const double*) { return 0.0; }
+    inline hwComplex Zero(const hwComplex*) { return hwComplex(0.0, 0.0); }
+
+    //! Direct 2D sum over the overlap of y and the reversed, shifted x, for
+    //! the window (top, left, m, n). y is traversed in increasing order.
+    template <typename T>
+    void DirectConv2D(const T* x, int xm, int xn, const T* y, int ym, int yn,
+                      int top, int left, int m, int n, T* c)
+    {
+        if (xn == 1 && yn == 1)
+        {
+            // vectors, without the column loop
+            hwThreadPool::ParallelFor(m, [=](int64_t begin, int64_t end)
+            {
+                for (int ic = begin; ic < end; ++ic)
+                {
+                    int i = top + ic;
+                    int ilo = std::max(0, i - xm + 1);
+                    int ihi = std::min(ym - 1, i);
+                    const T* xp = x + i - ilo;
+                    T value = Zero(x);
+
+                    for (int ii = ilo; ii <= ihi; ++ii)
+                        AddProduct(value, *xp--, y[ii]);
+
+                    c[ic] = value;
+                }
+            }, std::min(xm, ym));
+
+            return;
+        }
+
+        hwThreadPool::ParallelFor(n, [=](int64_t begin, int64_t end)
+        {
+            for (int jc = begin; jc < end; ++jc)
+            {
+                int j = left + jc;
+                int jlo = std::max(0, j - xn + 1);
+                int jhi = std::min(yn - 1, j);
+
+                for (int ic = 0; ic < m; ++ic)
+                {
+                    int i = top + ic;
+                    int ilo = std::max(0, i - xm + 1);
+                    int ihi = std::min(ym - 1, i);
+                    T value = Zero(x);
+
+                    for (int ii = ilo; ii <= ihi; ++ii)
+                    {
+                        for (int jj = jlo; jj <= jhi; ++jj)
+                            AddProduct(value, x[(j - jj) * xm + i - ii], y[jj * ym + ii]);
+                    }
+
+                    c[jc * m + ic] = value;
+                }
+            }
+        }, m * std::max(1, std::min(xm, ym) * std::min(xn, yn)));
+    }
+
+    //! Number of multiply-adds of the direct sum for a window
+    double DirectOps(int xm, int xn, int ym, int yn, int m, int n)
+    {
+        return static_cast<double>(m) * n * std::min(xm, ym) * std::min(xn, yn);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Computes c(k) = sum x(start+k-j) y(j), for k = 0 to count-1
+//------------------------------------------------------------------------------
+void hwConvolution::Conv(const double* x, int nx, const double* y, int ny,
+                         int start, int count, double* c)
+{
+    Conv2D(x, nx, 1, y, ny, 1, start, 0, count, 1, c);
+}
+//------------------------------------------------------------------------------
+// Computes c(k) = sum x(start+k-j) y(j), for k = 0 to count-1
+//------------------------------------------------------------------------------
+void hwConvolution::Conv(const hwComplex* x, int nx, const hwComplex* y, int ny,
+                         int start, int count, hwComplex* c)
+{
+    Conv2D(x, nx, 1, y, ny, 1, start, 0, count, 1, c);
+}
+//------------------------------------------------------------------------------
+// Computes the m x n window at (top, left) of the 2D convolution of x and y
+//------------------------------------------------------------------------------
+void hwConvolution::Conv2D(const double* x, int xm, int xn, const double* y, int ym, int yn,
+                           int top, int left, int m, int n, double* c)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    int p = PowerOf2(xm + ym - 1);
+    int q = PowerOf2(xn + yn - 1);
+
+    if (!UseFFT(DirectOps(xm, xn, ym, yn, m, n), p, q))
+    {
+        DirectConv2D(x, xm, xn, y, ym, yn, top, left, m, n, c);
+        return;
+    }
+
+    // transform both real operands at once as z = x + i*y
+    std::vector<double> z(2 * static_cast<size_t>(p) * q, 0.0);
+
+    for (int j = 0; j < xn; ++j)
+    {
+        for (int i = 0; i < xm; ++i)
+            z[2 * (static_cast<size_t>(j) * p + i)] = x[j * xm + i];
+    }
+
+    for (int j = 0; j < yn; ++j)
+    {
+        for (int i = 0; i < ym; ++i)
+            z[2 * (static_cast<size_t>(j) * p + i) + 1] = y[j * ym + i];
+    }
+
+    std::vector<double> colTwiddle = Twiddles(p);
+    std::vector<double> rowTwiddle = Twiddles(q);
+
+    FFT2D(z.data(), p, q, -1, colTwiddle, rowTwiddle);
+
+    // separate the transforms with X(k) = (Z(k) + conj(Z(-k)))/2 and
+    // Y(k) = (Z(k) - conj(Z(-k)))/2i, and form their product, whose value
+    // at -k is the conjugate of its value at k
+    for (int j = 0; j < q; ++j)
+    {
+        int nj = (q - j) % q;
+
+        for (int i = 0; i < p; ++i)
+        {
+            int ni = (p - i) % p;
+            size_t k = static_cast<size_t>(j) * p + i;
+            size_t nk = static_cast<size_t>(nj) * p + ni;
+
+            if (nk < k)
+                continue;
+
+            double ar = z[2 * k];
+            double ai = z[2 * k + 1];
+            double br = z[2 * nk];
+            double bi = -z[2 * nk + 1];
+            double xr = 0.5 * (ar + br);
+            double xi = 0.5 * (ai + bi);
+            double yr = 0.5 * (ai - bi);
+            double yi = -0.5 * (ar - br);
+            double wr = xr * yr - xi * yi;
+            double wi = xr * yi + xi * yr;
+
+            z[2 * k] = wr;
+            z[2 * k + 1] = wi;
+            z[2 * nk] = wr;
+            z[2 * nk + 1] = -wi;
+        }
+    }
+
+    FFT2D(z.data(), p, q, 1, colTwiddle, rowTwiddle);
+
+    double scale = 1.0 / (static_cast<double>(p) * q);
+
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < m; ++i)
+            c[j * m + i] = z[2 * (static_cast<size_t>(left + j) * p + top + i)] * scale;
+    }
+}
+//------------------------------------------------------------------------------
+// Computes the m x n window at (top, left) of the 2D convolution of x and y
+//------------------------------------------------------------------------------
+void hwConvolution::Conv2D(const hwComplex* x, int xm, int xn, const hwComplex* y, int ym, int yn,
+                           int top, int left, int m, int n, hwComplex* c)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    int p = PowerOf2(xm + ym - 1);
+    int q = PowerOf2(xn + yn - 1);
+
+    if (!UseFFT(4.0 * DirectOps(xm, xn, ym, yn, m, n), p, q))
+    {
+        DirectConv2D(x, xm, xn, y, ym, yn, top, left, m, n, c);
+        return;
+    }
+
+    size_t size = static_cast<size_t>(p) * q;
+    std::vector<double> a(2 * size, 0.0);
+    std::vector<double> b(2 * size, 0.0);
+
+    for (int j = 0; j < xn; ++j)
+    {
+        for (int i = 0; i < xm; ++i)
+        {
+            a[2 * (static_cast<size_t>(j) * p + i)] = x[j * xm + i].Real();
+            a[2 * (static_cast<size_t>(j) * p + i) + 1] = x[j * xm + i].Imag();
+        }
+    }
+
+    for (int j = 0; j < yn; ++j)
+    {
+        for (int i = 0; i < ym; ++i)
+        {
+            b[2 * (static_cast<size_t>(j) * p + i)] = y[j * ym + i].Real();
+            b[2 * (static_cast<size_t>(j) * p + i) + 1] = y[j * ym + i].Imag();
+        }
+    }
+
+    std::vector<double> colTwiddle = Twiddles(p);
+    std::vector<double> rowTwiddle = Twiddles(q);
+
+    FFT2D(a.data(), p, q, -1, colTwiddle, rowTwiddle);
+    FFT2D(b.data(), p, q, -1, colTwiddle, rowTwiddle);
+
+    for (size_t k = 0; k < size; ++k)
+    {
+        double ar = a[2 * k];
+        double ai = a[2 * k + 1];
+        a[2 * k] = ar * b[2 * k] - ai * b[2 * k + 1];
+        a[2 * k + 1] = ar * b[2 * k + 1] + ai * b[2 * k];
+    }
+
+    FFT2D(a.data(), p, q, 1, colTwiddle, rowTwiddle);
+
+    double scale = 1.0 / static_cast<double>(size);
+
+    for (int j = 0; j < n; ++j)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            size_t k = static_cast<size_t>(left + j) * p + top + i;
+            c[j * m + i] = hwComplex(a[2 * k] * scale, a[2 * k + 1] * scale);
+        }
+    }
+}
@@ -0,0 +1,247 @@
+/**
+* @file hwMemoryPool.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Pooled allocator with per thread caches
+//
+//:---------------------------------------------------------------------------
+
+#include <hwMemoryPool.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef OS_WIN
+#   include <malloc.h>
+#endif
+
+namespace
+{
+    //! Smallest size class, in bytes
+    const size_t MIN_CLASS_SIZE = 64;
+    //! Number of size classes; the largest is MIN_CLASS_SIZE << (NUM_CLASSES-1) = 4 MB
+    const int NUM_CLASSES = 17;
+    //! Class index of uncached blocks
+    const int LARGE_CLASS = NUM_CLASSES;
+    //! Most blocks a thread caches per class
+    const int MAX_CACHED_BLOCKS = 64;
+    //! Most bytes a thread caches per class
+    const size_t MAX_CACHED_BYTES = 8 * 1024 * 1024;
+
+    //! Block header, padded to the alignment so the payload stays aligned
+    union BlockHeader
+    {
+        struct
+        {
+            BlockHeader* next;      // free list link while cached
+            size_t       size;      // usable size
+            int          sizeClass;
+        } info;
+        char pad[hwMemoryPool::ALIGNMENT];
+    };
+
+    //! Cached blocks of the current thread. It is trivially destructible so
+    //! that it remains usable while other thread_local and static objects are
+    //! destroyed.
+    struct ThreadCache
+    {
+        BlockHeader* head[NUM_CLASSES];
+        int          count[NUM_CLASSES];
+        bool         released;
+    };
+
+    thread_local ThreadCache threadCache;
+
+    std::atomic<long long> numAllocations(0);
+    std::atomic<long long> numPoolHits(0);
+    std::atomic<long long> numSystemAllocs(0);
+    std::atomic<long long> numFrees(0);
+    std::atomic<long long> bytesInUse(0);
+    std::atomic<long long> peakBytesInUse(0);
+    std::atomic<long long> bytesCached(0);
+
+    void* SystemAllocate(size_t bytes)
+    {
+#ifdef OS_WIN
+        return _aligned_malloc(bytes, hwMemoryPool::ALIGNMENT);
+#else
+        void* block = nullptr;
+
+        if (posix_memalign(&block, hwMemoryPool::ALIGNMENT, bytes))
+            return nullptr;
+
+        return block;
+#endif
+    }
+
+    void SystemFree(void* block)
+    {
+#ifdef OS_WIN
+        _aligned_free(block);
+#else
+        free(block);
+#endif
+    }
+
+    //! Release the blocks of all classes in the thread cache
+    void ReleaseCache(ThreadCache& cache)
+    {
+        for (int i = 0; i < NUM_CLASSES; ++i)
+        {
+            while (cache.head[i])
+            {
+                BlockHeader* header = cache.head[i];
+                cache.head[i] = header->info.next;
+                bytesCached -= (long long) header->info.size;
+                SystemFree(header);
+            }
+
+            cache.count[i] = 0;
+        }
+    }
+
+    //! Releases the thread cache when the thread exits
+    struct CacheReleaser
+    {
+        ~CacheReleaser()
+        {
+            ReleaseCache(threadCache);
+            threadCache.released = true;
+        }
+    };
+
+    //! Size class that fits the request, or LARGE_CLASS
+    int SizeClass(size_t bytes, size_t& classSize)
+    {
+        classSize = MIN_CLASS_SIZE;
+
+        for (int i = 0; i < NUM_CLASSES; ++i)
+        {
+            if (bytes <= classSize)
+                return i;
+
+            classSize <<= 1;
+        }
+
+        classSize = (bytes + hwMemoryPool::ALIGNMENT - 1) & ~(hwMemoryPool::ALIGNMENT - 1);
+        return LARGE_CLASS;
+    }
+
+    void AddInUse(long long bytes)
+    {
+        long long inUse = (bytesInUse += bytes);
+        long long peak  = peakBytesInUse.load(std::memory_order_relaxed);
+
+        while (inUse > peak && !peakBytesInUse.compare_exchange_weak(peak, inUse))
+            ;
+    }
+}
+
+//! Allocate a block
+void* hwMemoryPool::Allocate(size_t bytes)
+{
+    if (bytes > ((size_t) -1) / 2)
+        throw std::bad_alloc();
+
+    size_t classSize;
+    int sizeClass = SizeClass(bytes ? bytes : 1, classSize);
+
+    ++numAllocations;
+
+    if (sizeClass != LARGE_CLASS && threadCache.head[sizeClass])
+    {
+        BlockHeader* header = threadCache.head[sizeClass];
+        threadCache.head[sizeClass] = header->info.next;
+        --threadCache.count[sizeClass];
+
+        ++numPoolHits;
+        bytesCached -= (long long) classSize;
+        AddInUse((long long) classSize);
+
+        return header + 1;
+    }
+
+    BlockHeader* header = static_cast<BlockHeader*>(SystemAllocate(classSize + sizeof(BlockHeader)));
+
+    if (!header)
+        throw std::bad_alloc();
+
+    header->info.next      = nullptr;
+    header->info.size      = classSize;
+    header->info.sizeClass = sizeClass;
+
+    ++numSystemAllocs;
+    AddInUse((long long) classSize);
+
+    return header + 1;
+}
+
+//! Release a block
+void hwMemoryPool::Free(void* block)
+{
+    if (!block)
+        return;
+
+    BlockHeader* header = static_cast<BlockHeader*>(block) - 1;
+    int sizeClass = header->info.sizeClass;
+    size_t size = header->info.size;
+
+    ++numFrees;
+    bytesInUse -= (long long) size;
+
+    if (sizeClass == LARGE_CLASS || threadCache.released ||
+        threadCache.count[sizeClass] >= MAX_CACHED_BLOCKS ||
+        (threadCache.count[sizeClass] + 1) * size > MAX_CACHED_BYTES)
+    {
+        SystemFree(header);
+        return;
+    }
+
+    // register the cache for release at thread exit
+    static thread_local CacheReleaser releaser;
+    (void) releaser;
+
+    header->info.next = threadCache.head[sizeClass];
+    threadCache.head[sizeClass] = header;
+    ++threadCache.count[sizeClass];
+    bytesCached += (long long) size;
+}
+
+//! Release the blocks cached by the calling thread
+void hwMemoryPool::Trim()
+{
+    ReleaseCache(threadCache);
+}
+
+//! Get the allocation counters
+hwMemoryPool::Stats hwMemoryPool::GetStats()
+{
+    Stats stats;
+
+    stats.allocations    = numAllocations;
+    stats.poolHits       = numPoolHits;
+    stats.systemAllocs   = numSystemAllocs;
+    stats.frees          = numFrees;
+    stats.bytesInUse     = bytesInUse;
+    stats.peakBytesInUse = peakBytesInUse;
+    stats.bytesCached    = bytesCached;
+
+    return stats;
+}
@@ -0,0 +1,56 @@
+/**
+* @file hwSolverPath.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Per thread record of the solvers used by the last linear solve
+//
+//:---------------------------------------------------------------------------
+
+#include <hwSolverPath.h>
+
+namespace
+{
+    //! Solvers tried by the last solve on this thread
+    thread_local std::string path;
+}
+
+//------------------------------------------------------------------------------
+// Clears the path at the start of a solve
+//------------------------------------------------------------------------------
+void hwSolverPath::Reset()
+{
+    path.clear();
+}
+//------------------------------------------------------------------------------
+// Appends a solver to the path
+//------------------------------------------------------------------------------
+void hwSolverPath::Add(const char* solver)
+{
+    if (!path.empty())
+        path += " -> ";
+
+    path += solver;
+}
+//------------------------------------------------------------------------------
+// Gets the solvers tried by the last solve
+//------------------------------------------------------------------------------
+std::string hwSolverPath::Get()
+{
+    return path;
+}
@@ -0,0 +1,359 @@
+/**
+* @file hwThreadPool.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Shared work-stealing thread pool
+//
+//:---------------------------------------------------------------------------
+
+#include <hwThreadPool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    //! Default number of elements below which loops run serially
+    const int DEFAULT_THRESHOLD = 100000;
+    //! Chunks per thread, so that threads finishing early can steal work
+    const int CHUNKS_PER_THREAD = 4;
+    //! Elements per chunk of a reduction in deterministic mode
+    const int DETERMINISTIC_CHUNK_SIZE = 16384;
+
+    std::atomic<int>  numThreadsSetting(0);
+    std::atomic<int>  thresholdSetting(DEFAULT_THRESHOLD);
+    std::atomic<bool> deterministicSetting(false);
+
+    //! True on pool threads and on a thread running a parallel loop
+    thread_local bool inParallelLoop = false;
+
+    //! Chunks queued for one thread
+    struct ChunkQueue
+    {
+        std::mutex      mutex;
+        std::deque<int> chunks;
+    };
+
+    //! A parallel loop in progress
+    struct Job
+    {
+        const std::function<void(int)>* body;
+        std::unique_ptr<ChunkQueue[]>   queues;
+        int                             numQueues;
+        std::mutex                      errorMutex;
+        std::exception_ptr              error;
+    };
+
+    //! Takes a chunk from the front of the own queue, or steals one from the
+    //! back of another queue
+    bool TakeChunk(Job& job, int self, int& chunk)
+    {
+        for (int i = 0; i < job.numQueues; ++i)
+        {
+            ChunkQueue& queue = job.queues[(self + i) % job.numQueues];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (queue.chunks.empty())
+                continue;
+
+            if (i == 0)
+            {
+                chunk = queue.chunks.front();
+                queue.chunks.pop_front();
+            }
+            else
+            {
+                chunk = queue.chunks.back();
+                queue.chunks.pop_back();
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    //! Runs chunks until none are left to take
+    void Work(Job& job, int self)
+    {
+        int chunk;
+
+        while (TakeChunk(job, self, chunk))
+        {
+            try
+            {
+                (*job.body)(chunk);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(job.errorMutex);
+
+                if (!job.error)
+                    job.error = std::current_exception();
+            }
+        }
+    }
+
+    //! Worker threads and the hand-off of jobs to them
+    class Pool
+    {
+    public:
+        Pool() : m_job(nullptr), m_generation(0), m_pending(0), m_stop(false) {}
+
+        //! Runs body(chunk) for each chunk with the given number of threads
+        void Run(int numChunks, int numThreads, const std::function<void(int)>& body)
+        {
+            std::unique_lock<std::mutex> runLock(m_runMutex, std::defer_lock);
+
+            if (numThreads > 1 && numChunks > 1 && !inParallelLoop)
+                runLock.try_lock();
+
+            // serial if the pool is busy with a loop of another thread
+            if (!runLock.owns_lock())
+            {
+                for (int chunk = 0; chunk < numChunks; ++chunk)
+                    body(chunk);
+
+                return;
+            }
+
+            StartWorkers(numThreads - 1);
+
+            Job job;
+            job.body      = &body;
+            job.numQueues = static_cast<int>(m_workers.size()) + 1;
+            job.queues.reset(new ChunkQueue[job.numQueues]);
+
+            // neighbouring chunks start on the same thread
+            for (int q = 0; q < job.numQueues; ++q)
+            {
+                int begin = static_cast<int>(static_cast<long long>(numChunks) * q / job.numQueues);
+                int end   = static_cast<int>(static_cast<long long>(numChunks) * (q + 1) / job.numQueues);
+
+                for (int chunk = begin; chunk < end; ++chunk)
+                    job.queues[q].chunks.push_back(chunk);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job     = &job;
+                m_pending = static_cast<int>(m_workers.size());
+                ++m_generation;
+            }
+
+            m_wake.notify_all();
+
+            inParallelLoop = true;
+            Work(job, 0);
+            inParallelLoop = false;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock, [this] { return m_pending == 0; });
+                m_job = nullptr;
+            }
+
+            if (job.error)
+                std::rethrow_exception(job.error);
+        }
+
+    private:
+        //! Ensures the given number of workers is running
+        void StartWorkers(int numWorkers)
+        {
+            if (static_cast<int>(m_workers.size()) == numWorkers)
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_wake.notify_all();
+
+            for (size_t i = 0; i < m_workers.size(); ++i)
+                m_workers[i].join();
+
+            m_workers.clear();
+            m_stop = false;
+
+            for (int i = 0; i < numWorkers; ++i)
+                m_workers.push_back(std::thread(&Pool::WorkerLoop, this, i + 1, m_generation));
+        }
+
+        //! Waits for jobs and works on them
+        void WorkerLoop(int self, unsigned int generation)
+        {
+            inParallelLoop = true;
+
+            while (true)
+            {
+                Job* job;
+
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+
+                    if (m_stop)
+                        return;
+
+                    generation = m_generation;
+                    job        = m_job;
+                }
+
+                Work(*job, self);
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+
+                    if (--m_pending == 0)
+                        m_done.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+        std::mutex               m_runMutex;    // held while a loop runs
+        std::mutex               m_mutex;       // guards the members below
+        std::condition_variable  m_wake;
+        std::condition_variable  m_done;
+        Job*                     m_job;
+        unsigned int             m_generation;
+        int                      m_pending;     // workers still on m_job
+        bool                     m_stop;
+    };
+
+    //! The pool is never destroyed, so that no thread is joined during exit
+    Pool& GetPool()
+    {
+        static Pool* pool = new Pool;
+        return *pool;
+    }
+}
+
+//*******************************************************************
+//                    hwThreadPool public functions
+//*******************************************************************
+
+//! Set the number of threads
+void hwThreadPool::SetNumThreads(int numThreads)
+{
+    numThreadsSetting = numThreads > 0 ? numThreads : 0;
+}
+
+//! Get the number of threads
+int hwThreadPool::GetNumThreads()
+{
+    int numThreads = numThreadsSetting;
+
+    if (numThreads == 0)
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+
+    return numThreads > 0 ? numThreads : 1;
+}
+
+//! Set the serial threshold
+void hwThreadPool::SetThreshold(int threshold)
+{
+    thresholdSetting = threshold > 0 ? threshold : 0;
+}
+
+//! Get the serial threshold
+int hwThreadPool::GetThreshold()
+{
+    return thresholdSetting;
+}
+
+//! Set deterministic mode
+void hwThreadPool::SetDeterministic(bool deterministic)
+{
+    deterministicSetting = deterministic;
+}
+
+//! Get deterministic mode
+bool hwThreadPool::IsDeterministic()
+{
+    return deterministicSetting;
+}
+
+//! Run a loop of independent iterations
+void hwThreadPool::ParallelFor(int64_t n, const std::function<void(int64_t, int64_t)>& body, int64_t work)
+{
+    if (n < 1)
+        return;
+
+    int numThreads = GetNumThreads();
+
+    if (n < 2 || numThreads < 2 || inParallelLoop ||
+        n * work < GetThreshold())
+    {
+        body(0, n);
+        return;
+    }
+
+    int numChunks = numThreads * CHUNKS_PER_THREAD;
+
+    if (numChunks > n)
+        numChunks = static_cast<int>(n);
+
+    ParallelChunks(n, numChunks, [&](int, int64_t begin, int64_t end)
+    {
+        body(begin, end);
+    });
+}
+
+//! Get the number of chunks of a reduction
+int hwThreadPool::ReductionChunks(int64_t n)
+{
+    if (n < 2 || n < GetThreshold())
+        return 1;
+
+    if (IsDeterministic())
+        return static_cast<int>((n + DETERMINISTIC_CHUNK_SIZE - 1) / DETERMINISTIC_CHUNK_SIZE);
+
+    int numThreads = GetNumThreads();
+
+    if (numThreads < 2 || inParallelLoop)
+        return 1;
+
+    int numChunks = numThreads * CHUNKS_PER_THREAD;
+
+    return numChunks < n ? numChunks : static_cast<int>(n);
+}
+
+//! Run a loop over chunks
+void hwThreadPool::ParallelChunks(int64_t n, int numChunks, const std::function<void(int, int64_t, int64_t)>& body)
+{
+    if (numChunks < 1)
+        return;
+
+    std::function<void(int)> chunkBody = [&](int chunk)
+    {
+        int64_t begin = n * chunk / numChunks;
+        int64_t end   = n * (chunk + 1) / numChunks;
+
+        body(chunk, begin, end);
+    };
+
+    GetPool().Run(numChunks, GetNumThreads(), chunkBody);
+}
@@ -0,0 +1,296 @@
+/**
+* @file hwVectorMath.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Vectorized elementwise math functions
+//
+//:---------------------------------------------------------------------------
+
+#include <hwVectorMath.h>
+
+#include "hwVectorMathTable.h"
+
+#include <atomic>
+#include <math.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#   include <intrin.h>
+#endif
+
+//*******************************************************************
+//                    Scalar implementation
+//*******************************************************************
+
+static void ScalarExp(int64_t n, const double* x, double* y)
+{
+    for (int64_t i = 0; i < n; ++i)
+        y[i] = exp(x[i]);
+}
+
+static void ScalarLog(int64_t n, const double* x, double* y)
+{
+    for (int64_t i = 0; i < n; ++i)
+        y[i] = log(x[i]);
+}
+
+static void ScalarSin(int64_t n, const double* x, double* y)
+{
+    for (int64_t i = 0; i < n; ++i)
+        y[i] = sin(x[i]);
+}
+
+static void ScalarCos(int64_t n, const double* x, double* y)
+{
+    for (int64_t i = 0; i < n; ++i)
+        y[i] = cos(x[i]);
+}
+
+static void ScalarSqrt(int64_t n, const double* x, double* y)
+{
+    for (int64_t i = 0; i < n; ++i)
+        y[i] = sqrt(x[i]);
+}
+
+static void ScalarAbs(int64_t n, const double* x, double* y)
+{
+    for (int64_t i = 0; i < n; ++i)
+        y[i] = fabs(x[i]);
+}
+
+static void ScalarAtan2(int64_t n, const double* y, const double* x, double* z)
+{
+    for (int64_t i = 0; i < n; ++i)
+        z[i] = atan2(y[i], x[i]);
+}
+
+static void ScalarHypot(int64_t n, const double* x, const double* y, double* z)
+{
+    for (int64_t i = 0; i < n; ++i)
+        z[i] = hypot(x[i], y[i]);
+}
+
+static const hwVectorMathTable scalarTable = { "scalar",
+    ScalarExp, ScalarLog, ScalarSin, ScalarCos, ScalarSqrt, ScalarAbs, ScalarAtan2, ScalarHypot };
+
+//*******************************************************************
+//                    Instruction set selection
+//*******************************************************************
+
+//! Returns true if the CPU and OS support AVX2 and FMA
+static bool HasAVX2()
+{
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int info[4];
+    __cpuid(info, 0);
+
+    if (info[0] < 7)
+        return false;
+
+    __cpuid(info, 1);
+
+    bool fma     = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx     = (info[2] & (1 << 28)) != 0;
+
+    if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+//! Returns true if the CPU and OS support AVX-512F
+static bool HasAVX512()
+{
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && defined(_M_X64)
+    if (!HasAVX2() || (_xgetbv(0) & 0xE6) != 0xE6)
+        return false;
+
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 16)) != 0;
+#else
+    return false;
+#endif
+}
+
+//! Returns the table for an instruction set name, or NULL if unavailable
+static const hwVectorMathTable* GetTable(const std::string& name)
+{
+    if (name == "scalar")
+        return &scalarTable;
+
+    if (name == "avx2")
+        return HasAVX2() ? hwGetVectorMathAVX2() : nullptr;
+
+    if (name == "avx512")
+        return HasAVX512() ? hwGetVectorMathAVX512() : nullptr;
+
+    if (name == "auto")
+    {
+        const hwVectorMathTable* table = GetTable("avx512");
+
+        if (!table)
+            table = GetTable("avx2");
+
+        return table ? table : &scalarTable;
+    }
+
+    return nullptr;
+}
+
+//! Returns the table in use
+static std::atomic<const hwVectorMathTable*>& ActiveTable()
+{
+    static std::atomic<const hwVectorMathTable*> table(GetTable("auto"));
+    return table;
+}
+
+//*******************************************************************
+//                    hwVectorMath public functions
+//*******************************************************************
+
+// Number of complex elements split into real arrays at a time
+static const int BLOCK_SIZE = 256;
+
+//! Compute y = exp(x)
+void hwVectorMath::Exp(int64_t n, const double* x, double* y)
+{
+    ActiveTable().load()->exp(n, x, y);
+}
+
+//! Compute y = exp(x) for complex x
+void hwVectorMath::Exp(int64_t n, const hwComplex* x, hwComplex* y)
+{
+    const hwVectorMathTable* table = ActiveTable().load();
+
+    double re[BLOCK_SIZE];
+    double im[BLOCK_SIZE];
+    double c[BLOCK_SIZE];
+
+    for (int64_t start = 0; start < n; start += BLOCK_SIZE)
+    {
+        int count = (n - start < BLOCK_SIZE) ? static_cast<int>(n - start) : BLOCK_SIZE;
+
+        for (int i = 0; i < count; ++i)
+        {
+            re[i] = x[start + i].Real();
+            im[i] = x[start + i].Imag();
+        }
+
+        // exp(a + bi) = exp(a) * (cos(b) + i sin(b)), as hwComplex::exp
+        table->exp(count, re, re);
+        table->cos(count, im, c);
+        table->sin(count, im, im);
+
+        for (int i = 0; i < count; ++i)
+            y[start + i] = hwComplex(re[i] * c[i], re[i] * im[i]);
+    }
+}
+
+//! Compute y = log(x)
+void hwVectorMath::Log(int64_t n, const double* x, double* y)
+{
+    ActiveTable().load()->log(n, x, y);
+}
+
+//! Compute y = sin(x)
+void hwVectorMath::Sin(int64_t n, const double* x, double* y)
+{
+    ActiveTable().load()->sin(n, x, y);
+}
+
+//! Compute y = cos(x)
+void hwVectorMath::Cos(int64_t n, const double* x, double* y)
+{
+    ActiveTable().load()->cos(n, x, y);
+}
+
+//! Compute y = sqrt(x)
+void hwVectorMath::Sqrt(int64_t n, const double* x, double* y)
+{
+    ActiveTable().load()->sqrt(n, x, y);
+}
+
+//! Compute y = |x|
+void hwVectorMath::Abs(int64_t n, const double* x, double* y)
+{
+    ActiveTable().load()->abs(n, x, y);
+}
+
+//! Compute y = |x| for complex x
+void hwVectorMath::Abs(int64_t n, const hwComplex* x, double* y)
+{
+    const hwVectorMathTable* table = ActiveTable().load();
+
+    double re[BLOCK_SIZE];
+    double im[BLOCK_SIZE];
+
+    for (int64_t start = 0; start < n; start += BLOCK_SIZE)
+    {
+        int count = (n - start < BLOCK_SIZE) ? static_cast<int>(n - start) : BLOCK_SIZE;
+
+        for (int i = 0; i < count; ++i)
+        {
+            re[i] = x[start + i].Real();
+            im[i] = x[start + i].Imag();
+        }
+
+        table->hypot(count, re, im, y + start);
+    }
+}
+
+//! Compute z = atan2(y, x)
+void hwVectorMath::Atan2(int64_t n, const double* y, const double* x, double* z)
+{
+    ActiveTable().load()->atan2(n, y, x, z);
+}
+
+//! Compute z = hypot(x, y)
+void hwVectorMath::Hypot(int64_t n, const double* x, const double* y, double* z)
+{
+    ActiveTable().load()->hypot(n, x, y, z);
+}
+
+//! Get the instruction set in use
+std::string hwVectorMath::GetInstructionSet()
+{
+    return ActiveTable().load()->name;
+}
+
+//! Select the instruction set
+bool hwVectorMath::SetInstructionSet(const std::string& name)
+{
+    const hwVectorMathTable* table = GetTable(name);
+
+    if (!table)
+        return false;
+
+    ActiveTable().store(table);
+    return true;
+}
@@ -0,0 +1,142 @@
+/**
+* @file hwVectorMathAVX2.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  AVX2 and FMA elementwise math kernels. Only called after the CPU has
+//  been checked, so this file is compiled for AVX2 regardless of the
+//  target of the rest of the library.
+//
+//:---------------------------------------------------------------------------
+
+#include "hwVectorMathTable.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <math.h>
+#include <stdint.h>
+
+#if defined(__clang__)
+#   pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#   pragma GCC push_options
+#   pragma GCC target("avx2,fma")
+#endif
+
+#include <immintrin.h>
+
+namespace
+{
+
+//! Four doubles in an AVX register
+struct AVX2
+{
+    typedef __m256d D;
+    typedef __m256d M;
+
+    static const int N = 4;
+
+    static D Load(const double* p)        { return _mm256_loadu_pd(p); }
+    static void Store(double* p, D x)     { _mm256_storeu_pd(p, x); }
+    static D Set(double a)                { return _mm256_set1_pd(a); }
+    static D Bits(uint64_t a)             { return _mm256_castsi256_pd(_mm256_set1_epi64x((long long) a)); }
+
+    static D Add(D a, D b)                { return _mm256_add_pd(a, b); }
+    static D Sub(D a, D b)                { return _mm256_sub_pd(a, b); }
+    static D Mul(D a, D b)                { return _mm256_mul_pd(a, b); }
+    static D Div(D a, D b)                { return _mm256_div_pd(a, b); }
+    static D Fma(D a, D b, D c)           { return _mm256_fmadd_pd(a, b, c); }
+    static D Sqrt(D a)                    { return _mm256_sqrt_pd(a); }
+    static D Min(D a, D b)                { return _mm256_min_pd(a, b); }
+    static D Max(D a, D b)                { return _mm256_max_pd(a, b); }
+    static D Round(D a)                   { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static D Floor(D a)                   { return _mm256_round_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+    static D And(D a, D b)                { return _mm256_and_pd(a, b); }
+    static D Or(D a, D b)                 { return _mm256_or_pd(a, b); }
+    static D Xor(D a, D b)                { return _mm256_xor_pd(a, b); }
+    static D AndNot(D a, D b)             { return _mm256_andnot_pd(a, b); }
+
+    static M Lt(D a, D b)                 { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static M Gt(D a, D b)                 { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static M Ge(D a, D b)                 { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static M Eq(D a, D b)                 { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static M IsNan(D a)                   { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+    static M MAnd(M a, M b)               { return _mm256_and_pd(a, b); }
+    static M MOr(M a, M b)                { return _mm256_or_pd(a, b); }
+    static D Select(M m, D a, D b)        { return _mm256_blendv_pd(b, a, m); }
+    static bool Any(M m)                  { return _mm256_movemask_pd(m) != 0; }
+
+    static D Pow2(D k)
+    {
+        // The low bits of k + 1.5 * 2^52 hold k as an integer
+        __m256i i = _mm256_castpd_si256(_mm256_add_pd(k, _mm256_set1_pd(6755399441055744.0)));
+        i = _mm256_add_epi64(_mm256_slli_epi64(i, 52), _mm256_set1_epi64x(1023LL << 52));
+        return _mm256_castsi256_pd(i);
+    }
+
+    static D Exponent(D a)
+    {
+        // Build the double 2^52 + e and subtract 2^52
+        __m256i e = _mm256_srli_epi64(_mm256_castpd_si256(a), 52);
+        e = _mm256_or_si256(e, _mm256_set1_epi64x(0x4330000000000000LL));
+        return _mm256_sub_pd(_mm256_castsi256_pd(e), _mm256_set1_pd(4503599627370496.0));
+    }
+};
+
+} // namespace
+
+#include "hwVectorMathKernels.h"
+
+namespace
+{
+
+void Exp(int64_t n, const double* x, double* y)   { Map1<AVX2, ExpKernel<AVX2> >(n, x, y); }
+void Log(int64_t n, const double* x, double* y)   { Map1<AVX2, LogKernel<AVX2> >(n, x, y); }
+void Sin(int64_t n, const double* x, double* y)   { Map1<AVX2, SinCosKernel<AVX2, false> >(n, x, y); }
+void Cos(int64_t n, const double* x, double* y)   { Map1<AVX2, SinCosKernel<AVX2, true> >(n, x, y); }
+void Sqrt(int64_t n, const double* x, double* y)  { Map1<AVX2, SqrtKernel<AVX2> >(n, x, y); }
+void Abs(int64_t n, const double* x, double* y)   { Map1<AVX2, AbsKernel<AVX2> >(n, x, y); }
+
+void Atan2(int64_t n, const double* y, const double* x, double* z) { Map2<AVX2, Atan2Kernel<AVX2> >(n, y, x, z); }
+void Hypot(int64_t n, const double* x, const double* y, double* z) { Map2<AVX2, HypotKernel<AVX2> >(n, x, y, z); }
+
+} // namespace
+
+#if defined(__clang__)
+#   pragma clang attribute pop
+#elif defined(__GNUC__)
+#   pragma GCC pop_options
+#endif
+
+//! AVX2 and FMA table
+const hwVectorMathTable* hwGetVectorMathAVX2()
+{
+    static const hwVectorMathTable table = { "avx2", Exp, Log, Sin, Cos, Sqrt, Abs, Atan2, Hypot };
+    return &table;
+}
+
+#else
+
+//! AVX2 and FMA table
+const hwVectorMathTable* hwGetVectorMathAVX2()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,493 @@
+/**
+* @file hwVectorMathKernels.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Elementwise math kernels, written once for any vector width. An
+//  instruction set source file defines a vector type V and includes this
+//  file. V provides, for a vector D of V::N doubles and a lane mask M:
+//
+//  Load, Store, Set, Bits, Add, Sub, Mul, Div, Fma (a * b + c), Sqrt, Min,
+//  Max, Round (to nearest), Floor, And, Or, Xor, AndNot (~a & b), Lt, Gt,
+//  Ge, Eq, IsNan, MAnd, MOr, Select (m ? a : b), Any, Pow2 (2^k for
+//  integral k in [-1022, 1023]) and Exponent (biased exponent of a
+//  positive x).
+//
+//  The algorithms and coefficients are those of fdlibm, so results stay
+//  within one ulp of libm. Groups containing arguments a kernel does not
+//  cover are computed with libm.
+//
+//:---------------------------------------------------------------------------
+
+#ifndef _hwVectorMathKernels_h
+#define _hwVectorMathKernels_h
+
+#include <math.h>
+
+// The kernels are compiled for a specific instruction set in each including
+// file, so they must not be shared with other files through the linker
+namespace
+{
+
+//! Applies a group kernel to n elements
+template <class V, class K>
+void Map1(int64_t n, const double* x, double* y)
+{
+    int64_t i = 0;
+
+    for (; i + V::N <= n; i += V::N)
+        K::Group(x + i, y + i);
+
+    if (i < n)
+    {
+        double xt[V::N];
+        double yt[V::N];
+        int    count = static_cast<int>(n - i);
+
+        for (int j = 0; j < V::N; ++j)
+            xt[j] = (j < count) ? x[i + j] : 1.0;
+
+        K::Group(xt, yt);
+
+        for (int j = 0; j < count; ++j)
+            y[i + j] = yt[j];
+    }
+}
+
+//! Applies a two argument group kernel to n elements
+template <class V, class K>
+void Map2(int64_t n, const double* x1, const double* x2, double* y)
+{
+    int64_t i = 0;
+
+    for (; i + V::N <= n; i += V::N)
+        K::Group(x1 + i, x2 + i, y + i);
+
+    if (i < n)
+    {
+        double xt1[V::N];
+        double xt2[V::N];
+        double yt[V::N];
+        int    count = static_cast<int>(n - i);
+
+        for (int j = 0; j < V::N; ++j)
+        {
+            xt1[j] = (j < count) ? x1[i + j] : 1.0;
+            xt2[j] = (j < count) ? x2[i + j] : 1.0;
+        }
+
+        K::Group(xt1, xt2, yt);
+
+        for (int j = 0; j < count; ++j)
+            y[i + j] = yt[j];
+    }
+}
+
+//! Flips the sign of x where m is set
+template <class V>
+typename V::D FlipSign(typename V::M m, typename V::D x)
+{
+    return V::Select(m, V::Xor(x, V::Set(-0.0)), x);
+}
+
+//! Square root
+template <class V>
+struct SqrtKernel
+{
+    static void Group(const double* x, double* y)
+    {
+        V::Store(y, V::Sqrt(V::Load(x)));
+    }
+};
+
+//! Absolute value
+template <class V>
+struct AbsKernel
+{
+    static void Group(const double* x, double* y)
+    {
+        V::Store(y, V::AndNot(V::Set(-0.0), V::Load(x)));
+    }
+};
+
+//! Exponential, reduced to exp(r) * 2^k with |r| <= ln(2)/2
+template <class V>
+struct ExpKernel
+{
+    typedef typename V::D D;
+
+    static void Group(const double* px, double* py)
+    {
+        D x = V::Load(px);
+
+        // Beyond these bounds the result is 0 or inf, which the scaling
+        // below produces by underflow or overflow
+        D xc = V::Min(V::Max(x, V::Set(-746.0)), V::Set(710.0));
+        D k  = V::Round(V::Mul(xc, V::Set(1.44269504088896338700e+00)));
+
+        // ln2 split so that k * ln2_hi is exact
+        D r = V::Fma(k, V::Set(-6.93147180369123816490e-01), xc);
+        r   = V::Fma(k, V::Set(-1.90821492927058770002e-10), r);
+
+        // Taylor series of exp(r) - 1 - r, accurate to 2^-57
+        D p = V::Set(1.0 / 6227020800.0);
+        p = V::Fma(p, r, V::Set(1.0 / 479001600.0));
+        p = V::Fma(p, r, V::Set(1.0 / 39916800.0));
+        p = V::Fma(p, r, V::Set(1.0 / 3628800.0));
+        p = V::Fma(p, r, V::Set(1.0 / 362880.0));
+        p = V::Fma(p, r, V::Set(1.0 / 40320.0));
+        p = V::Fma(p, r, V::Set(1.0 / 5040.0));
+        p = V::Fma(p, r, V::Set(1.0 / 720.0));
+        p = V::Fma(p, r, V::Set(1.0 / 120.0));
+        p = V::Fma(p, r, V::Set(1.0 / 24.0));
+        p = V::Fma(p, r, V::Set(1.0 / 6.0));
+        p = V::Fma(p, r, V::Set(0.5));
+
+        D y = V::Add(V::Set(1.0), V::Fma(p, V::Mul(r, r), r));
+
+        // Scale in two steps so that 2^k never leaves the normal range
+        D k1 = V::Floor(V::Mul(k, V::Set(0.5)));
+        D k2 = V::Sub(k, k1);
+        y = V::Mul(V::Mul(y, V::Pow2(k1)), V::Pow2(k2));
+
+        V::Store(py, V::Select(V::IsNan(x), x, y));
+    }
+};
+
+//! Natural logarithm, reduced to log(1 + f) + e * ln2 with
+//! sqrt(2)/2 <= 1 + f < sqrt(2)
+template <class V>
+struct LogKernel
+{
+    typedef typename V::D D;
+    typedef typename V::M M;
+
+    static void Group(const double* px, double* py)
+    {
+        D x = V::Load(px);
+
+        // Move subnormals into the normal range
+        M sub  = V::Lt(x, V::Set(2.2250738585072014e-308));
+        D xs   = V::Select(sub, V::Mul(x, V::Set(18014398509481984.0)), x);
+        D e    = V::Sub(V::Exponent(xs), V::Select(sub, V::Set(1023.0 + 54.0), V::Set(1023.0)));
+        D m    = V::Or(V::And(xs, V::Bits(0x000FFFFFFFFFFFFFULL)), V::Set(1.0));
+        M half = V::Gt(m, V::Set(1.41421356237309504880));
+
+        m = V::Select(half, V::Mul(m, V::Set(0.5)), m);
+        e = V::Select(half, V::Add(e, V::Set(1.0)), e);
+
+        D f    = V::Sub(m, V::Set(1.0));
+        D s    = V::Div(f, V::Add(V::Set(2.0), f));
+        D z    = V::Mul(s, s);
+        D w    = V::Mul(z, z);
+        D t1   = V::Mul(w, V::Fma(w, V::Fma(w, V::Set(1.531383769920937332e-01),
+                                          V::Set(2.222219843214978396e-01)),
+                                 V::Set(3.999999999940941908e-01)));
+        D t2   = V::Mul(z, V::Fma(w, V::Fma(w, V::Fma(w, V::Set(1.479819860511658591e-01),
+                                                   V::Set(1.818357216161805012e-01)),
+                                          V::Set(2.857142874366239149e-01)),
+                                 V::Set(6.666666666666735130e-01)));
+        D R    = V::Add(t2, t1);
+        D hfsq = V::Mul(V::Mul(V::Set(0.5), f), f);
+
+        D y = V::Sub(V::Mul(e, V::Set(6.93147180369123816490e-01)),
+                     V::Sub(V::Sub(hfsq, V::Add(V::Mul(s, V::Add(hfsq, R)),
+                                                V::Mul(e, V::Set(1.90821492927058770002e-10)))),
+                            f));
+
+        y = V::Select(V::Eq(x, V::Set(0.0)), V::Set(-HUGE_VAL), y);
+        y = V::Select(V::Lt(x, V::Set(0.0)), V::Set(NAN), y);
+        y = V::Select(V::Eq(x, V::Set(HUGE_VAL)), x, y);
+        y = V::Select(V::IsNan(x), x, y);
+
+        V::Store(py, y);
+    }
+};
+
+//! Reduces x to y0 + y1 = x - k * pi/2 with |y0| <= pi/4, for
+//! |x| < 2^19 * pi/2, using pi/2 split into three 33 bit parts
+template <class V>
+void ReducePio2(typename V::D x, typename V::D& k, typename V::D& y0, typename V::D& y1)
+{
+    typedef typename V::D D;
+
+    k = V::Round(V::Mul(x, V::Set(6.36619772367581382433e-01)));
+
+    D r = V::Sub(x, V::Mul(k, V::Set(1.57079632673412561417e+00)));
+    D t = r;
+    D w = V::Mul(k, V::Set(6.07710050630396597660e-11));
+    r   = V::Sub(t, w);
+    w   = V::Sub(V::Mul(k, V::Set(2.02226624879595063154e-21)), V::Sub(V::Sub(t, r), w));
+    t   = r;
+    D w3 = V::Mul(k, V::Set(2.02226624871116645580e-21));
+    r   = V::Sub(t, w3);
+    w   = V::Sub(V::Mul(k, V::Set(8.47842766036889956997e-32)), V::Sub(V::Sub(t, r), w3));
+    y0  = V::Sub(r, w);
+    y1  = V::Sub(V::Sub(r, y0), w);
+}
+
+//! sin(x + y) for |x + y| <= pi/4
+template <class V>
+typename V::D KernelSin(typename V::D x, typename V::D y)
+{
+    typedef typename V::D D;
+
+    D z = V::Mul(x, x);
+    D w = V::Mul(z, z);
+    D r = V::Add(V::Fma(z, V::Fma(z, V::Set(2.75573137070700676789e-06),
+                                     V::Set(-1.98412698298579493134e-04)),
+                        V::Set(8.33333333332248946124e-03)),
+                 V::Mul(V::Mul(z, w), V::Fma(z, V::Set(1.58969099521155010221e-10),
+                                            V::Set(-2.50507602534068634195e-08))));
+    D v = V::Mul(z, x);
+
+    return V::Sub(x, V::Sub(V::Sub(V::Mul(z, V::Sub(V::Mul(V::Set(0.5), y), V::Mul(v, r))), y),
+                            V::Mul(v, V::Set(-1.66666666666666324348e-01))));
+}
+
+//! cos(x + y) for |x + y| <= pi/4
+template <class V>
+typename V::D KernelCos(typename V::D x, typename V::D y)
+{
+    typedef typename V::D D;
+
+    D z  = V::Mul(x, x);
+    D w  = V::Mul(z, z);
+    D r  = V::Add(V::Mul(z, V::Fma(z, V::Fma(z, V::Set(2.48015872894767294178e-05),
+                                              V::Set(-1.38888888888741095749e-03)),
+                                   V::Set(4.16666666666666019037e-02))),
+                  V::Mul(V::Mul(w, w), V::Fma(z, V::Fma(z, V::Set(-1.13596475577881948265e-11),
+                                                        V::Set(2.08757232129817482790e-09)),
+                                             V::Set(-2.75573143513906633035e-07))));
+    D hz = V::Mul(V::Set(0.5), z);
+    D one = V::Set(1.0);
+    w    = V::Sub(one, hz);
+
+    return V::Add(w, V::Add(V::Sub(V::Sub(one, w), hz), V::Sub(V::Mul(z, r), V::Mul(x, y))));
+}
+
+//! Sine and cosine; cosine when COS is true
+template <class V, bool COS>
+struct SinCosKernel
+{
+    typedef typename V::D D;
+    typedef typename V::M M;
+
+    static void Group(const double* px, double* py)
+    {
+        D x = V::Load(px);
+
+        // Large, infinite and NaN arguments go to libm
+        if (V::Any(V::MOr(V::IsNan(x), V::Gt(V::AndNot(V::Set(-0.0), x), V::Set(823549.6)))))
+        {
+            for (int j = 0; j < V::N; ++j)
+                py[j] = COS ? cos(px[j]) : sin(px[j]);
+            return;
+        }
+
+        D k, y0, y1;
+        ReducePio2<V>(x, k, y0, y1);
+
+        // quadrant = k mod 4
+        D q  = V::Sub(k, V::Mul(V::Set(4.0), V::Floor(V::Mul(k, V::Set(0.25)))));
+        D s  = KernelSin<V>(y0, y1);
+        D c  = KernelCos<V>(y0, y1);
+        M odd = V::MOr(V::Eq(q, V::Set(1.0)), V::Eq(q, V::Set(3.0)));
+        D y;
+
+        if (COS)
+        {
+            y = V::Select(odd, s, c);
+            y = FlipSign<V>(V::MOr(V::Eq(q, V::Set(1.0)), V::Eq(q, V::Set(2.0))), y);
+        }
+        else
+        {
+            y = V::Select(odd, c, s);
+            y = FlipSign<V>(V::Gt(q, V::Set(1.5)), y);
+        }
+
+        V::Store(py, y);
+    }
+};
+
+//! atan(x) for x >= 0, reduced with the breakpoints 7/16, 11/16, 19/16
+//! and 39/16
+template <class V>
+typename V::D KernelAtan(typename V::D x)
+{
+    typedef typename V::D D;
+    typedef typename V::M M;
+
+    D one = V::Set(1.0);
+    M id0 = V::MAnd(V::Ge(x, V::Set(0.4375)), V::Lt(x, V::Set(0.6875)));
+    M id1 = V::MAnd(V::Ge(x, V::Set(0.6875)), V::Lt(x, V::Set(1.1875)));
+    M id2 = V::MAnd(V::Ge(x, V::Set(1.1875)), V::Lt(x, V::Set(2.4375)));
+    M id3 = V::Ge(x, V::Set(2.4375));
+
+    D num = x;
+    D den = one;
+    D hi  = V::Set(0.0);
+    D lo  = V::Set(0.0);
+
+    num = V::Select(id0, V::Sub(V::Mul(V::Set(2.0), x), one), num);
+    den = V::Select(id0, V::Add(V::Set(2.0), x), den);
+    hi  = V::Select(id0, V::Set(4.63647609000806093515e-01), hi);
+    lo  = V::Select(id0, V::Set(2.26987774529616870924e-17), lo);
+
+    num = V::Select(id1, V::Sub(x, one), num);
+    den = V::Select(id1, V::Add(x, one), den);
+    hi  = V::Select(id1, V::Set(7.85398163397448278999e-01), hi);
+    lo  = V::Select(id1, V::Set(3.06161699786838301793e-17), lo);
+
+    num = V::Select(id2, V::Sub(x, V::Set(1.5)), num);
+    den = V::Select(id2, V::Add(one, V::Mul(V::Set(1.5), x)), den);
+    hi  = V::Select(id2, V::Set(9.82793723247329054082e-01), hi);
+    lo  = V::Select(id2, V::Set(1.39033110312309984516e-17), lo);
+
+    num = V::Select(id3, V::Set(-1.0), num);
+    den = V::Select(id3, x, den);
+    hi  = V::Select(id3, V::Set(1.57079632679489655800e+00), hi);
+    lo  = V::Select(id3, V::Set(6.12323399573676603587e-17), lo);
+
+    D t  = V::Div(num, den);
+    D z  = V::Mul(t, t);
+    D w  = V::Mul(z, z);
+    D s1 = V::Mul(z, V::Fma(w, V::Fma(w, V::Fma(w, V::Fma(w, V::Fma(w,
+                      V::Set(1.62858201153657823623e-02),
+                      V::Set(4.97687799461593236017e-02)),
+                      V::Set(6.66107313738753120669e-02)),
+                      V::Set(9.09088713343650656196e-02)),
+                      V::Set(1.42857142725034663711e-01)),
+                      V::Set(3.33333333333329318027e-01)));
+    D s2 = V::Mul(w, V::Fma(w, V::Fma(w, V::Fma(w, V::Fma(w,
+                      V::Set(-3.65315727442169155270e-02),
+                      V::Set(-5.83357013379057348645e-02)),
+                      V::Set(-7.69187620504482999495e-02)),
+                      V::Set(-1.11111104054623557880e-01)),
+                      V::Set(-1.99999999998764832476e-01)));
+
+    // Without a breakpoint, hi = lo = 0 and this is t - t * (s1 + s2)
+    return V::Sub(hi, V::Sub(V::Sub(V::Mul(t, V::Add(s1, s2)), lo), t));
+}
+
+//! Four quadrant arctangent of y / x
+template <class V>
+struct Atan2Kernel
+{
+    typedef typename V::D D;
+    typedef typename V::M M;
+
+    static void Group(const double* py, const double* px, double* pz)
+    {
+        D y = V::Load(py);
+        D x = V::Load(px);
+
+        D ay = V::AndNot(V::Set(-0.0), y);
+        D ax = V::AndNot(V::Set(-0.0), x);
+
+        // Infinite and NaN arguments go to libm
+        D big = V::Set(1.79769313486231570815e+308);
+
+        if (V::Any(V::MOr(V::MOr(V::IsNan(x), V::IsNan(y)),
+                          V::MOr(V::Gt(ax, big), V::Gt(ay, big)))))
+        {
+            for (int j = 0; j < V::N; ++j)
+                pz[j] = atan2(py[j], px[j]);
+            return;
+        }
+
+        D one  = V::Set(1.0);
+        M zero = V::MOr(V::Eq(ax, V::Set(0.0)), V::Eq(ay, V::Set(0.0)));
+        D a    = KernelAtan<V>(V::Div(V::Select(zero, one, ay), V::Select(zero, one, ax)));
+
+        D sy    = V::And(y, V::Set(-0.0));
+        M xneg  = V::Lt(V::Or(V::And(x, V::Set(-0.0)), one), V::Set(0.0));
+        D pi    = V::Set(3.1415926535897931160e+00);
+        D pi_lo = V::Set(1.2246467991473531772e-16);
+
+        // x < 0: pi - atan(|y / x|)
+        D z = V::Select(xneg, V::Sub(pi, V::Sub(a, pi_lo)), a);
+
+        // atan2(+-0, x) = +-0 or +-pi, atan2(y, +-0) = +-pi/2
+        z = V::Select(V::Eq(ax, V::Set(0.0)), V::Set(1.57079632679489661923e+00), z);
+        z = V::Select(V::Eq(ay, V::Set(0.0)), V::Select(xneg, pi, V::Set(0.0)), z);
+
+        V::Store(pz, V::Or(z, sy));
+    }
+};
+
+//! Hypotenuse, with a correction step for the rounding of x^2 + y^2
+template <class V>
+struct HypotKernel
+{
+    typedef typename V::D D;
+    typedef typename V::M M;
+
+    static void Group(const double* px, const double* py, double* pz)
+    {
+        D ax = V::AndNot(V::Set(-0.0), V::Load(px));
+        D ay = V::AndNot(V::Set(-0.0), V::Load(py));
+
+        // Infinite and NaN arguments go to libm
+        D big = V::Set(1.79769313486231570815e+308);
+
+        if (V::Any(V::MOr(V::MOr(V::IsNan(ax), V::IsNan(ay)),
+                          V::MOr(V::Gt(ax, big), V::Gt(ay, big)))))
+        {
+            for (int j = 0; j < V::N; ++j)
+                pz[j] = hypot(px[j], py[j]);
+            return;
+        }
+
+        D a = V::Max(ax, ay);
+        D b = V::Min(ax, ay);
+
+        // Scale by a power of 2 so the squares neither overflow nor underflow
+        M large = V::Gt(a, V::Set(3.2733906078961419e+150));     // 2^500
+        M small = V::Lt(a, V::Set(3.0549363634996047e-151));     // 2^-500
+        D scale = V::Select(large, V::Set(2.4099198651028841e-181),  // 2^-600
+                  V::Select(small, V::Set(4.1495155688809929e+180),  // 2^600
+                            V::Set(1.0)));
+        D undo  = V::Select(large, V::Set(4.1495155688809929e+180),
+                  V::Select(small, V::Set(2.4099198651028841e-181),
+                            V::Set(1.0)));
+
+        a = V::Mul(a, scale);
+        b = V::Mul(b, scale);
+
+        D h = V::Sqrt(V::Fma(a, a, V::Mul(b, b)));
+
+        // d = a^2 + b^2 - h^2, from the exact products
+        D hh = V::Mul(h, h);
+        D hl = V::Fma(h, h, V::Sub(V::Set(0.0), hh));
+        D aa = V::Mul(a, a);
+        D al = V::Fma(a, a, V::Sub(V::Set(0.0), aa));
+        D bb = V::Mul(b, b);
+        D bl = V::Fma(b, b, V::Sub(V::Set(0.0), bb));
+        D d  = V::Add(V::Add(V::Sub(aa, hh), bb), V::Sub(V::Add(al, bl), hl));
+
+        h = V::Add(h, V::Div(d, V::Add(h, h)));
+        h = V::Select(V::Eq(a, V::Set(0.0)), V::Set(0.0), h);
+
+        V::Store(pz, V::Mul(h, undo));
+    }
+};
+
+} // namespace
+
+#endif // _hwVectorMathKernels_h
@@ -0,0 +1,53 @@
+/**
+* @file hwVectorMathTable.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Function tables for the vectorized elementwise math implementations
+//
+//:---------------------------------------------------------------------------
+
+#ifndef _hwVectorMathTable_h
+#define _hwVectorMathTable_h
+
+#include <stdint.h>
+
+typedef void (*hwVectorMathFunc1)(int64_t n, const double* x, double* y);
+typedef void (*hwVectorMathFunc2)(int64_t n, const double* x1, const double* x2, double* y);
+
+//! Real array functions of one instruction set
+struct hwVectorMathTable
+{
+    const char*       name;
+    hwVectorMathFunc1 exp;
+    hwVectorMathFunc1 log;
+    hwVectorMathFunc1 sin;
+    hwVectorMathFunc1 cos;
+    hwVectorMathFunc1 sqrt;
+    hwVectorMathFunc1 abs;
+    hwVectorMathFunc2 atan2;
+    hwVectorMathFunc2 hypot;
+};
+
+//! AVX2 and FMA table, or NULL if not compiled for x86-64
+const hwVectorMathTable* hwGetVectorMathAVX2();
+
+//! AVX-512 table, or NULL if not compiled for x86-64
+const hwVectorMathTable* hwGetVectorMathAVX512();
+
+#endif // _hwVectorMathTable_h
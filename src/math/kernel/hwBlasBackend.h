@@ -0,0 +1,263 @@
+/**
+* @file hwBlasBackend.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+#ifndef _hwBlasBackend_h
+#define _hwBlasBackend_h
+
+#include "MathCoreExports.h"
+
+#include <complex>
+#include <string>
+
+typedef std::complex<double> complexD;
+typedef std::complex<float> complexF;
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Selects the BLAS / LAPACK library used by the matrix kernel
+//!
+//! The reference BLAS and LAPACK libraries are linked into mathcore. Load()
+//! replaces them at run time with an optimized, Fortran ABI compatible
+//! library such as OpenBLAS, MKL (mkl_rt) or BLIS. Routines the library does
+//! not export continue to use the reference implementation.
+//!
+//------------------------------------------------------------------------------
+class MATHCORE_DECLS hwBlasBackend
+{
+public:
+    //!
+    //! Loads the backend named by the OML_BLAS environment variable, which
+    //! may be "reference", "auto" or the path of a shared library
+    //!
+    static bool Initialize();
+    //!
+    //! Loads a BLAS / LAPACK shared library. lib may also be "reference" to
+    //! revert to the reference libraries or "auto" to load the first
+    //! optimized library found. Returns false if lib cannot be used.
+    //! \param lib Library name or path
+    //!
+    static bool Load(const std::string& lib);
+    //!
+    //! Returns the backend name: reference, openblas, mkl, blis or other
+    //!
+    static std::string GetName();
+    //!
+    //! Returns the file name of the loaded library, or an empty string
+    //!
+    static std::string GetLibrary();
+    //!
+    //! Returns the number of threads used by the backend
+    //!
+    static int GetNumThreads();
+    //!
+    //! Sets the number of threads used by the backend. Returns false if the
+    //! backend does not support threading.
+    //! \param numThreads Number of threads
+    //!
+    static bool SetNumThreads(int numThreads);
+};
+
+//*******************************************************************
+//                    BLAS / LAPACK routines
+//*******************************************************************
+//! Entry points called by hwTMatrixLP.cc. Each pointer refers to the
+//! routine in the active backend.
+namespace hwBlas
+{
+
+// y = x
+extern MATHCORE_DECLS void (*dcopy_)(int* N, double* DX, int* INCX, double* DY, int* INCY);
+extern MATHCORE_DECLS void (*zcopy_)(int* N, complexD* DX, int* INCX, complexD* DY, int* INCY);
+// y = ay
+extern MATHCORE_DECLS void (*dscal_)(int* N, double* DA, double* DX, int* INCX);
+extern MATHCORE_DECLS void (*zscal_)(int* N, complexD* DA, complexD* DX, int* INCX);
+// y = ax + y
+extern MATHCORE_DECLS void (*daxpy_)(int* N, double* DA, double* DX, int* INCX, double* DY, int* INCY);
+extern MATHCORE_DECLS void (*zaxpy_)(int* N, complexD* DA, complexD* DX, int* INCX, complexD* DY, int* INCY);
+// C = alpha*op( A )*op( B ) + beta*C
+extern MATHCORE_DECLS void (*dgemm_)(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                                     double* ALPHA, double* A, int* LDA, double* B, int* LDB,
+                                     double* BETA, double* C, int* LDC);
+extern MATHCORE_DECLS void (*zgemm_)(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                                     complexD* ALPHA, complexD* A, int* LDA, complexD* B,
+                                     int* LDB, complexD* BETA, complexD* C, int* LDC);
+extern MATHCORE_DECLS void (*sgemm_)(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                                     float* ALPHA, float* A, int* LDA, float* B, int* LDB,
+                                     float* BETA, float* C, int* LDC);
+extern MATHCORE_DECLS void (*cgemm_)(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                                     complexF* ALPHA, complexF* A, int* LDA, complexF* B,
+                                     int* LDB, complexF* BETA, complexF* C, int* LDC);
+// y = alpha*op( A )*x + beta*y
+extern MATHCORE_DECLS void (*dgemv_)(char* TRANS, int* M, int* N, double* ALPHA, double* A,
+                                     int* LDA, double* X, int* INCX, double* BETA, double* Y,
+                                     int* INCY);
+// C = alpha*A*A' + beta*C or C = alpha*A'*A + beta*C, for one triangle of C
+extern MATHCORE_DECLS void (*dsyrk_)(char* UPLO, char* TRANS, int* N, int* K, double* ALPHA,
+                                     double* A, int* LDA, double* BETA, double* C, int* LDC);
+// Dot(X,Y)
+extern MATHCORE_DECLS double (*ddot_)(int* N, double* DX, int* INCX, double* DY, int* INCY);
+extern MATHCORE_DECLS void (*zdotc_)(complexD* dotc, int* N, complexD* DX, int* INCX, complexD* DY, int* INCY);
+// LU decomposition
+extern MATHCORE_DECLS void (*dgetrf_)(int* M, int* N, double* A, int* LDA, int* IPIV, int* INFO);
+extern MATHCORE_DECLS void (*zgetrf_)(int* M, int* N, complexD* A, int* LDA, int* IPIV, int* INFO);
+extern MATHCORE_DECLS void (*dgetrs_)(char* TRANS, int* N, int* NRHS, double* A, int* LDA, int* IPIV,
+                                      double* B, int* LDB, int* INFO);
+// Matrix inversion
+extern MATHCORE_DECLS void (*dgetri_)(int* N, double* A, int* LDA, int* IPIV, double* WORK, int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*zgetri_)(int* N, complexD* A, int* LDA, int* IPIV, complexD* WORK, int* LWORK, int* INFO);
+// Solve AX=B via LU
+extern MATHCORE_DECLS void (*dgesv_)(int* N, int* NRHS, double* A, int* LDA, int* IPIV,
+                                     double* B, int* LDB, int* INFO);
+extern MATHCORE_DECLS void (*zgesv_)(int* N, int* NRHS, complexD* A, int* LDA, int* IPIV,
+                                     complexD* B, int* LDB, int* INFO);
+// Solve AX=B via LU for triangular A
+extern MATHCORE_DECLS void (*dgtsv_)(int* N, int* NRHS, double* DL, double* D,
+                                     double* DU, double* B, int* LDB, int* INFO);
+// LU decomposition of tridiagonal A, its solve and its condition number
+extern MATHCORE_DECLS void (*dgttrf_)(int* N, double* DL, double* D, double* DU, double* DU2,
+                                      int* IPIV, int* INFO);
+extern MATHCORE_DECLS void (*dgttrs_)(char* TRANS, int* N, int* NRHS, double* DL, double* D,
+                                      double* DU, double* DU2, int* IPIV, double* B, int* LDB,
+                                      int* INFO);
+extern MATHCORE_DECLS void (*dgtcon_)(char* NORM, int* N, double* DL, double* D, double* DU,
+                                      double* DU2, int* IPIV, double* ANORM, double* RCOND,
+                                      double* WORK, int* IWORK, int* INFO);
+// Solve AX=B via LU for band A, and its condition number
+extern MATHCORE_DECLS void (*dgbsv_)(int* N, int* KL, int* KU, int* NRHS, double* AB,
+                                     int* LDAB, int* IPIV, double* B, int* LDB, int* INFO);
+extern MATHCORE_DECLS void (*dgbcon_)(char* NORM, int* N, int* KL, int* KU, double* AB,
+                                      int* LDAB, int* IPIV, double* ANORM, double* RCOND,
+                                      double* WORK, int* IWORK, int* INFO);
+// Solve AX=B via Cholesky for SPD A
+extern MATHCORE_DECLS void (*dposv_)(char* UPLO, int* N, int* NRHS, double* A, int* LDA, double* B,
+                                     int* LDB, int* INFO);
+// Solve AX=B via Cholesky for SPD triangular A, and its condition number
+extern MATHCORE_DECLS void (*dptsv_)(int* N, int* NRHS, double* D, double* E, double* B,
+                                     int* LDB, int* INFO);
+extern MATHCORE_DECLS void (*dptcon_)(int* N, double* D, double* E, double* ANORM, double* RCOND,
+                                      double* WORK, int* INFO);
+// Solve AX=B via Cholesky for SPD BAND A, and its condition number
+extern MATHCORE_DECLS void (*dpbsv_)(char* UPLO, int* N, int* KD, int* NRHS, double* AB,
+                                     int* LDAB, double* B, int* LDB, int* INFO);
+extern MATHCORE_DECLS void (*dpbcon_)(char* UPLO, int* N, int* KD, double* AB, int* LDAB,
+                                      double* ANORM, double* RCOND, double* WORK, int* IWORK,
+                                      int* INFO);
+// Solve AX=B for symmetric indefinite A, and its condition number
+extern MATHCORE_DECLS void (*dsysv_)(char* UPLO, int* N, int* NRHS, double* A, int* LDA,
+                                     int* IPIV, double* B, int* LDB, double* WORK,
+                                     int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*dsycon_)(char* UPLO, int* N, double* A, int* LDA, int* IPIV,
+                                      double* ANORM, double* RCOND, double* WORK, int* IWORK,
+                                      int* INFO);
+// Eigen decomposition
+extern MATHCORE_DECLS void (*dsyev_)(char* JOBZ, char* UPLO, int* N, double* A, int* LDA, double* W,
+                                     double* WORK, int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*dgeevx_)(char* balanc, char* jobvl, char* jobvr, char* sense, int* n,
+                                      double* a, int* lda, double* wr ,double* wi, double* vl,
+                                      int* ldvl, double* vr, int* ldvr, int* ilo, int* ihi,
+                                      double* scale, double* abnrm, double* rconde, double* rcondv,
+                                      double* work, int* lwork, int* iwork, int* info);
+extern MATHCORE_DECLS void (*zheev_)(char* jobz, char* uplo, int* n, complexD* a, int* lda, double* w,
+                                     complexD* work, int* lwork, double* rwork, int* info);
+extern MATHCORE_DECLS void (*zgeevx_)(char* balanc, char* jobvl, char* jobvr, char* sense, int* n,
+                                      complexD* a, int* lda, complexD* w, complexD* vl, int* ldvl,
+                                      complexD* vr, int* ldvr, int* ilo, int* ihi, double* scale,
+                                      double* abnrm, double* rconde, double* rcondv, complexD* work,
+                                      int* lwork, double* rwork, int* info);
+extern MATHCORE_DECLS void (*dstev_)(char* JOBZ, int* N, double* D, double* E, double* Z,
+                                     int* LDZ, double* WORK, int* INFO);
+extern MATHCORE_DECLS void (*dsbev_)(char* JOBZ, char* UPLO, int* N, int* KD, double* AB,
+                                     int* LDAB, double* W, double* Z, int* LDZ,
+                                     double* WORK, int* INFO);
+//! Balance a matrix
+extern MATHCORE_DECLS void (*dgebal_)(char* job, int* n, double* a, int* lda, int* ilo, int* ihi,
+                                      double* scale, int* info);
+extern MATHCORE_DECLS void (*zgebal_)(char* job, int* n, complexD* a, int* lda, int* ilo, int* ihi,
+                                      double* scale, int* info);
+//! Generalized Eigen decomposition
+extern MATHCORE_DECLS void (*dsygv_)(int* itype, char* jobz, char* uplo ,int* n, double* a, int* lda,
+                                     double* b, int* ldb, double* w, double* work, int* lwork, int* info);
+extern MATHCORE_DECLS void (*dggev_)(char* jobvl, char* jobvr ,int* n, double* a, int* lda, double* b,
+                                     int* ldb, double* alphar, double* alphai, double* beta, double* vl,
+                                     int* ldvl, double* vr, int* ldvr, double* work, int* lwork, int* info);
+extern MATHCORE_DECLS void (*zhegv_)(int* itype, char* jobz, char* uplo, int* n, complexD* a, int* lda,
+                                     complexD* b, int* ldb, double* w, complexD* work, int* lwork,
+                                     double* rwork, int* info);
+extern MATHCORE_DECLS void (*zggev_)(char* jobvl, char* jobvr, int* n, complexD* a, int* lda, complexD* b,
+                                     int* ldb, complexD* alpha, complexD* beta, complexD* vl, int* ldvl,
+                                     complexD* vr, int* ldvr, complexD* work, int* lwork, double* rwork,
+                                     int* info);
+// Cholesky decomposition of SPD matrix
+extern MATHCORE_DECLS void (*dpotrf_)(char* UPLO, int* N, double* A, int* LDA, int* INFO);
+// Solve with the Cholesky decomposition, and its condition number
+extern MATHCORE_DECLS void (*dpotrs_)(char* UPLO, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, int* INFO);
+extern MATHCORE_DECLS void (*dpocon_)(char* UPLO, int* N, double* A, int* LDA, double* ANORM, double* RCOND,
+                                      double* WORK, int* IWORK, int* INFO);
+// Triangular solve, and its condition number
+extern MATHCORE_DECLS void (*dtrtrs_)(char* UPLO, char* TRANS, char* DIAG, int* N, int* NRHS, double* A, int* LDA,
+                                      double* B, int* LDB, int* INFO);
+extern MATHCORE_DECLS void (*dtrcon_)(char* NORM, char* UPLO, char* DIAG, int* N, double* A, int* LDA, double* RCOND,
+                                      double* WORK, int* IWORK, int* INFO);
+// Singular value decomposition
+extern MATHCORE_DECLS void (*dgesvd_)(char* JOBU, char* JOBVT, int* M, int* N, double* A, int* LDA, double* S, double* U,
+                                      int* LDU, double* VT, int* LDVT, double* WORK, int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*zgesvd_)(char *jobu, char *jobvt, int *m, int *n, complexD *a, int *lda, double *s, complexD *u,
+                                      int *ldu, complexD *vt, int *ldvt, complexD *work, int *lwork, double *rwork, int *info);
+extern MATHCORE_DECLS void (*dgesdd_)(char* JOBZ, int* M, int* N, double* A, int* LDA, double* S, double* U,
+                                      int* LDU, double* VT, int* LDVT, double* WORK, int* LWORK, int* INFO);
+// QR decomposition
+extern MATHCORE_DECLS void (*dgeqrf_)(int* M, int* N, double* A, int* LDA, double* TAU, double* WORK,
+                                      int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*dorgqr_)(int* M, int* N, int* K, double* A, int* LDA, double* TAU,
+                                      double* WORK, int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*zgeqrf_)(int* M, int* N, complexD* A, int* LDA, complexD* TAU, complexD* WORK,
+                                      int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*zungqr_)(int* M, int* N, int* K, complexD* A, int* LDA, complexD* TAU,
+                                      complexD* WORK, int* LWORK, int* INFO);
+// Schur decomposition
+extern MATHCORE_DECLS void (*dgees_)(char* jobvs, char* sort, void* select, int* n, double* a, int* lda, int* sdim,
+                                     double* wr, double* wi, double* vs, int* ldvs, double* work ,int* lwork,
+                                     void* bwork, int* info);
+extern MATHCORE_DECLS void (*zgees_)(char* jobvs, char* sort, void* select, int* n, complexD* a, int* lda,
+                                     int* sdim, complexD* w, complexD* vs, int* ldvs, complexD* work,
+                                     int* lwork, double* rwork, void* bwork, int* info);
+// Solve AX=B via QR
+//extern "C" void dgels_(char* TRANS, int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB,
+//                       double* WORK, int* LWORK, int* INFO);
+//extern "C" void zgels_(char* TRANS, int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB,
+//                       complexD* WORK, int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*dgelsy_)(int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, int* JPVT,
+                                      double* RCOND, int* RANK, double* WORK, int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*zgelsy_)(int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB, int* JPVT,
+                                      double* RCOND, int* RANK, complexD* WORK, int* LWORK, double* RWORK, int* INFO);
+// Solve AX=B via SVD
+extern MATHCORE_DECLS void (*dgelss_)(int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, double* S,
+                                      double* RCOND, int* RANK, double* WORK, int* LWORK, int* INFO);
+extern MATHCORE_DECLS void (*zgelss_)(int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB, double* S,
+                                      double* RCOND, int* RANK, complexD* WORK, int* LWORK, double* RWORK, int* INFO);
+// Condition number
+extern MATHCORE_DECLS void (*dgecon_)(char* NORM, int* N, double* A, int* LDA, double* ANORM, double* RCOND,
+                                      double* WORK, int* IWORK, int* INFO);
+extern MATHCORE_DECLS void (*zgecon_)(char* norm, int* n, complexD* a, int* lda, double* anorm, double* rcond,
+                                      complexD* work, double* rwork, int* info);
+// Matrix norm
+extern MATHCORE_DECLS double (*dlange_)(char* norm, int* m, int* n, double* a, int* lda, double* work);
+extern MATHCORE_DECLS double (*zlange_)(char* norm, int* m, int* n, complexD* a, int* lda, double* work);
+// Vector L2 norm
+extern MATHCORE_DECLS double (*dnrm2_)(int* N,double* X, int* INCX);
+}
+
+#endif // _hwBlasBackend_h
@@ -0,0 +1,96 @@
+/**
+* @file hwConvolution.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+#ifndef _hwConvolution_h
+#define _hwConvolution_h
+
+#include "MathCoreExports.h"
+#include "hwComplex.h"
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Linear convolution kernels for real and complex data
+//!
+//! Each function computes a window of the full linear convolution, so that
+//! the 'same' and 'valid' shapes do not form the full result. The direct sum
+//! is used for short operands, where it is exact for integer data, and a
+//! zero padded FFT for long ones, where its O(n log n) cost wins.
+//!
+//------------------------------------------------------------------------------
+class MATHCORE_DECLS hwConvolution
+{
+public:
+    //!
+    //! Computes c(k) = sum x(start+k-j) y(j), for k = 0 to count-1
+    //! \param x     First operand
+    //! \param nx    Length of x
+    //! \param y     Second operand
+    //! \param ny    Length of y
+    //! \param start First index of the full convolution to compute
+    //! \param count Number of elements to compute
+    //! \param c     Output, with count elements
+    //!
+    static void Conv(const double* x, int nx, const double* y, int ny,
+                     int start, int count, double* c);
+    //!
+    //! Computes c(k) = sum x(start+k-j) y(j), for k = 0 to count-1
+    //! \param x     First operand
+    //! \param nx    Length of x
+    //! \param y     Second operand
+    //! \param ny    Length of y
+    //! \param start First index of the full convolution to compute
+    //! \param count Number of elements to compute
+    //! \param c     Output, with count elements
+    //!
+    static void Conv(const hwComplex* x, int nx, const hwComplex* y, int ny,
+                     int start, int count, hwComplex* c);
+    //!
+    //! Computes the m x n window at (top, left) of the 2D convolution of the
+    //! column major matrices x and y
+    //! \param x    First operand
+    //! \param xm   Rows of x
+    //! \param xn   Columns of x
+    //! \param y    Second operand
+    //! \param ym   Rows of y
+    //! \param yn   Columns of y
+    //! \param top  First row of the full convolution to compute
+    //! \param left First column of the full convolution to compute
+    //! \param m    Number of rows to compute
+    //! \param n    Number of columns to compute
+    //! \param c    Column major m x n output
+    //!
+    static void Conv2D(const double* x, int xm, int xn, const double* y, int ym, int yn,
+                       int top, int left, int m, int n, double* c);
+    //!
+    //! Computes the m x n window at (top, left) of the 2D convolution of the
+    //! column major matrices x and y
+    //! \param x    First operand
+    //! \param xm   Rows of x
+    //! \param xn   Columns of x
+    //! \param y    Second operand
+    //! \param ym   Rows of y
+    //! \param yn   Columns of y
+    //! \param top  First row of the full convolution to compute
+    //! \param left First column of the full convolution to compute
+    //! \param m    Number of rows to compute
+    //! \param n    Number of columns to compute
+    //! \param c    Column major m x n output
+    //!
+    static void Conv2D(const hwComplex* x, int xm, int xn, const hwComplex* y, int ym, int yn,
+                       int top, int left, int m, int n, hwComplex* c);
+};
+
+#endif // _hwConvolution_h
@@ -0,0 +1,73 @@
+/**
+* @file hwMemoryPool.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+#ifndef _hwMemoryPool_h
+#define _hwMemoryPool_h
+
+#include "MathCoreExports.h"
+
+#include <cstddef>
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Pooled allocator for matrix objects and data buffers
+//!
+//! Blocks are 64-byte aligned and rounded up to a power of two size class.
+//! Freed blocks are cached per thread and reused by later requests of the
+//! same class, so short-lived temporaries do not reach the system allocator.
+//! Blocks larger than the largest class are not cached.
+//!
+//------------------------------------------------------------------------------
+class MATHCORE_DECLS hwMemoryPool
+{
+public:
+    //! Alignment of every block, in bytes
+    static const size_t ALIGNMENT = 64;
+
+    //! Allocation counters
+    struct Stats
+    {
+        long long allocations;      //!< Blocks requested
+        long long poolHits;         //!< Requests served from a thread cache
+        long long systemAllocs;     //!< Requests served by the system allocator
+        long long frees;            //!< Blocks returned
+        long long bytesInUse;       //!< Bytes held by live blocks
+        long long peakBytesInUse;   //!< Maximum of bytesInUse
+        long long bytesCached;      //!< Bytes held in thread caches
+    };
+
+    //!
+    //! Returns a 64-byte aligned block of at least the given size, or
+    //! throws std::bad_alloc
+    //! \param bytes Requested size
+    //!
+    static void* Allocate(size_t bytes);
+    //!
+    //! Returns a block obtained from Allocate to the pool
+    //! \param block Block to release, may be null
+    //!
+    static void Free(void* block);
+    //!
+    //! Releases the blocks cached by the calling thread to the system
+    //!
+    static void Trim();
+    //!
+    //! Gets the allocation counters
+    //!
+    static Stats GetStats();
+};
+
+#endif // _hwMemoryPool_h
@@ -0,0 +1,52 @@
+/**
+* @file hwSolverPath.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+#ifndef _hwSolverPath_h
+#define _hwSolverPath_h
+
+#include "MathCoreExports.h"
+
+#include <string>
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Record of the solvers used by the last linear solve
+//!
+//! Left and right division choose a solver from the structure of the matrix
+//! and fall back to a more general one when it fails. Each solver tried is
+//! appended to the path, so the last entry produced the result. The path is
+//! kept per thread.
+//!
+//------------------------------------------------------------------------------
+class MATHCORE_DECLS hwSolverPath
+{
+public:
+    //!
+    //! Clears the path at the start of a solve
+    //!
+    static void Reset();
+    //!
+    //! Appends a solver to the path
+    //! \param solver Solver name
+    //!
+    static void Add(const char* solver);
+    //!
+    //! Gets the solvers tried by the last solve, separated by " -> "
+    //!
+    static std::string Get();
+};
+
+#endif // _hwSolverPath_h
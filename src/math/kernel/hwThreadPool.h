@@ -0,0 +1,124 @@
+/**
+* @file hwThreadPool.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+#ifndef _hwThreadPool_h
+#define _hwThreadPool_h
+
+#include "MathCoreExports.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Shared work-stealing thread pool for elementwise and reduction loops
+//!
+//! A loop over n elements is split into chunks. Each thread takes chunks from
+//! its own queue and steals from the queues of the others when it runs out.
+//! Loops below the threshold, and loops started from inside a pool thread,
+//! run serially on the calling thread.
+//!
+//! Elementwise results do not depend on the partition. Reductions combine the
+//! partial results of the chunks in chunk order. By default the partition
+//! follows the thread count, so a reduction may round differently when the
+//! thread count changes. In deterministic mode the chunks have a fixed size,
+//! so the result depends only on the data and the threshold.
+//!
+//------------------------------------------------------------------------------
+class MATHCORE_DECLS hwThreadPool
+{
+public:
+    //!
+    //! Sets the number of threads, including the calling thread
+    //! \param numThreads Thread count; 0 selects the number of cores
+    //!
+    static void SetNumThreads(int numThreads);
+    //!
+    //! Gets the number of threads, including the calling thread
+    //!
+    static int GetNumThreads();
+    //!
+    //! Sets the number of elements below which loops run serially
+    //! \param threshold Element count
+    //!
+    static void SetThreshold(int threshold);
+    //!
+    //! Gets the number of elements below which loops run serially
+    //!
+    static int GetThreshold();
+    //!
+    //! Sets whether reductions use a partition independent of the thread count
+    //! \param deterministic Deterministic mode flag
+    //!
+    static void SetDeterministic(bool deterministic);
+    //!
+    //! Returns true if reductions use a partition independent of the thread count
+    //!
+    static bool IsDeterministic();
+    //!
+    //! Calls body(begin, end) over a partition of [0, n). Use for loops whose
+    //! iterations are independent.
+    //! \param n     Number of iterations
+    //! \param body  Loop body
+    //! \param work  Number of elements processed per iteration
+    //!
+    static void ParallelFor(int64_t n, const std::function<void(int64_t, int64_t)>& body, int64_t work = 1);
+    //!
+    //! Returns the number of chunks a reduction over n elements is split into
+    //! \param n Number of elements
+    //!
+    static int ReductionChunks(int64_t n);
+    //!
+    //! Calls body(chunk, begin, end) for each chunk of [0, n) split into
+    //! numChunks equal parts
+    //! \param n         Number of elements
+    //! \param numChunks Number of chunks, from ReductionChunks
+    //! \param body      Chunk body
+    //!
+    static void ParallelChunks(int64_t n, int numChunks, const std::function<void(int, int64_t, int64_t)>& body);
+    //!
+    //! Reduces [0, n). Each chunk is reduced by chunkFunc(begin, end) and the
+    //! chunk results are combined in order by combine.
+    //! \param n         Number of elements
+    //! \param chunkFunc Reduction of a chunk
+    //! \param combine   Combination of two partial results
+    //!
+    template <typename T, typename ChunkFunc, typename Combine>
+    static T Reduce(int64_t n, ChunkFunc chunkFunc, Combine combine)
+    {
+        int numChunks = ReductionChunks(n);
+
+        if (numChunks < 2)
+            return chunkFunc(0, n);
+
+        std::vector<T> partial(numChunks);
+
+        ParallelChunks(n, numChunks, [&](int chunk, int64_t begin, int64_t end)
+        {
+            partial[chunk] = chunkFunc(begin, end);
+        });
+
+        T result = partial[0];
+
+        for (int i = 1; i < numChunks; ++i)
+            result = combine(result, partial[i]);
+
+        return result;
+    }
+};
+
+#endif // _hwThreadPool_h
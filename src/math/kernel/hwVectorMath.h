@@ -0,0 +1,134 @@
+/**
+* @file hwVectorMath.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* Copyright (C) 2009-2018 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  Vectorized elementwise math functions
+//
+//:---------------------------------------------------------------------------
+
+#ifndef _hwVectorMath_h
+#define _hwVectorMath_h
+
+#include "MathCoreExports.h"
+#include "hwComplex.h"
+
+#include <cstdint>
+#include <string>
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Elementwise math functions on arrays
+//!
+//! Each function applies a libm function to n elements. On x86-64 the work
+//! is done by AVX-512 or AVX2 kernels selected from the CPU at run time, and
+//! everywhere else by a scalar loop calling libm. The vector kernels agree
+//! with libm to within one unit in the last place. Elements the kernels do
+//! not cover, such as very large trigonometric arguments, are passed to libm.
+//! Input and output arrays may be the same.
+//!
+//------------------------------------------------------------------------------
+class MATHCORE_DECLS hwVectorMath
+{
+public:
+    //!
+    //! Computes y = exp(x)
+    //! \param n Number of elements
+    //! \param x Input
+    //! \param y Output
+    //!
+    static void Exp(int64_t n, const double* x, double* y);
+    //!
+    //! Computes y = exp(x) for complex x
+    //! \param n Number of elements
+    //! \param x Input
+    //! \param y Output
+    //!
+    static void Exp(int64_t n, const hwComplex* x, hwComplex* y);
+    //!
+    //! Computes y = log(x)
+    //! \param n Number of elements
+    //! \param x Input
+    //! \param y Output
+    //!
+    static void Log(int64_t n, const double* x, double* y);
+    //!
+    //! Computes y = sin(x)
+    //! \param n Number of elements
+    //! \param x Input, in radians
+    //! \param y Output
+    //!
+    static void Sin(int64_t n, const double* x, double* y);
+    //!
+    //! Computes y = cos(x)
+    //! \param n Number of elements
+    //! \param x Input, in radians
+    //! \param y Output
+    //!
+    static void Cos(int64_t n, const double* x, double* y);
+    //!
+    //! Computes y = sqrt(x)
+    //! \param n Number of elements
+    //! \param x Input
+    //! \param y Output
+    //!
+    static void Sqrt(int64_t n, const double* x, double* y);
+    //!
+    //! Computes y = |x|
+    //! \param n Number of elements
+    //! \param x Input
+    //! \param y Output
+    //!
+    static void Abs(int64_t n, const double* x, double* y);
+    //!
+    //! Computes y = |x| for complex x
+    //! \param n Number of elements
+    //! \param x Input
+    //! \param y Output
+    //!
+    static void Abs(int64_t n, const hwComplex* x, double* y);
+    //!
+    //! Computes z = atan2(y, x)
+    //! \param n Number of elements
+    //! \param y First input
+    //! \param x Second input
+    //! \param z Output
+    //!
+    static void Atan2(int64_t n, const double* y, const double* x, double* z);
+    //!
+    //! Computes z = hypot(x, y)
+    //! \param n Number of elements
+    //! \param x First input
+    //! \param y Second input
+    //! \param z Output
+    //!
+    static void Hypot(int64_t n, const double* x, const double* y, double* z);
+
+    //!
+    //! Returns the instruction set in use: avx512, avx2 or scalar
+    //!
+    static std::string GetInstructionSet();
+    //!
+    //! Selects the instruction set. name is avx512, avx2, scalar or auto for
+    //! the best one the CPU supports. Returns false if it is not available.
+    //! \param name Instruction set name
+    //!
+    static bool SetInstructionSet(const std::string& name);
+};
+
+#endif // _hwVectorMath_h
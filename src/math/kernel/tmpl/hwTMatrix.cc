@@ -29,7 +29,11 @@
 
 #include <Globals.h>
 #include <hwMathStatus.h>
+#include <hwMathException.h>
 #include <tmpl/hwTComplex.h>
+#include <hwConvolution.h>
+#include <hwThreadPool.h>
+#include <hwVectorMath.h>
 
 #ifdef max
    #undef max
@@ -181,6 +185,28 @@ hwTMatrix<T1, T2>::hwTMatrix(const hwTMatrix<T1, T2>& source)
     }
 }
 
+//! Move constructor
+template<typename T1, typename T2>
+hwTMatrix<T1, T2>::hwTMatrix(hwTMatrix<T1, T2>&& source)
+    : m_refCount(1)
+{
+    m_bits.ownData = 0;
+    MakeEmpty();
+
+    // shared or external data cannot be taken from the source
+    if (source.m_refCount > 1 || !source.m_bits.ownData)
+    {
+        hwMathStatus status = Copy(source);
+
+        if (!status.IsOk())
+            MakeEmpty();
+
+        return;
+    }
+
+    Transfer(source);
+}
+
 //! Destructor
 template<typename T1, typename T2>
 hwTMatrix<T1, T2>::~hwTMatrix()
@@ -203,6 +229,21 @@ hwTMatrix<T1, T2>& hwTMatrix<T1, T2>::operator=(const hwTMatrix<T1, T2>& rhs)
     return *this;
 }
 
+//! Implement the move = operator
+template<typename T1, typename T2>
+hwTMatrix<T1, T2>& hwTMatrix<T1, T2>::operator=(hwTMatrix<T1, T2>&& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    if (rhs.m_refCount > 1 || !rhs.m_bits.ownData || !m_bits.ownData)
+        Copy(rhs);
+    else
+        Transfer(rhs);
+
+    return *this;
+}
+
 // ****************************************************
 //             Data Type and Ownership
 // ****************************************************
@@ -214,7 +255,7 @@ bool hwTMatrix<T1, T2>::IsRealData() const
 {
     if (m_complex)
     {
-        for (int i = 0; i < Size(); ++i)
+        for (int64_t i = 0; i < Size(); ++i)
         {
             if (m_complex[i].Imag() != 0.0)
                 return false;
@@ -244,6 +285,9 @@ hwMathStatus hwTMatrix<T1, T2>::Dimension(int size, DataType dataType)
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::Dimension(int m, int n, DataType dataType)
 {
+    if (static_cast<int64_t>(m) * n > std::numeric_limits<int64_t>::max() / static_cast<int64_t>(sizeof(T2)))
+        return hwMathStatus(HW_MATH_ERR_ARRAYTOOLARGE, 1, 2);
+
     if (m_real)
     {
         if (dataType == REAL)
@@ -311,6 +355,9 @@ hwMathStatus hwTMatrix<T1, T2>::Resize(int m, int n, bool initZero)
     if (n < 0)
         return hwMathStatus(HW_MATH_ERR_ARRAYDIM, 2);
 
+    if (static_cast<int64_t>(m) * n > std::numeric_limits<int64_t>::max() / static_cast<int64_t>(sizeof(T2)))
+        return hwMathStatus(HW_MATH_ERR_ARRAYTOOLARGE, 1, 2);
+
     int m_old = m_nRows;
     int n_old = m_nCols;
 
@@ -429,21 +476,21 @@ hwMathStatus hwTMatrix<T1, T2>::Reshape(int m, int n)
     if (n < 0 && n != -1)
         return hwMathStatus(HW_MATH_ERR_ARRAYDIM, 2);
 
-    int size = Size();
+    int64_t size = Size();
 
     if (m == -1)
     {
         if (n == -1)
             return hwMathStatus(HW_MATH_ERR_MATRIXRESHAPE1, 1, 2);
 
-        m = size / n;
+        m = static_cast<int>(size / n);
     }
     else if (n == -1)
     {
-        n = size / m;
+        n = static_cast<int>(size / m);
     }
 
-    if (m * n != Size())
+    if (static_cast<long long>(m) * n != size)
         return hwMathStatus(HW_MATH_ERR_MATRIXRESHAPE2, 1, 2);
 
     m_nRows = m;
@@ -604,16 +651,54 @@ bool hwTMatrix<T1, T2>::IsHermitian(T1 tol) const
 
 #include <GeneralFuncs.h>
 
+//! Determine the lower and upper bandwidths of the matrix. Each column is
+//! scanned from its ends toward the diagonal and stops at the first nonzero,
+//! so a dense matrix costs O(n) and a banded or triangular one O(n^2).
+template<typename T1, typename T2>
+void hwTMatrix<T1, T2>::Bandwidth(int& lower, int& upper) const
+{
+    lower = 0;
+    upper = 0;
+
+    for (int j = 0; j < m_nCols; ++j)
+    {
+        int64_t start = static_cast<int64_t>(j) * m_nRows;
+
+        for (int i = m_nRows - 1; i > j + lower; --i)
+        {
+            bool nonzero = m_real ? m_real[start + i] != (T1) 0 :
+                           m_complex[start + i].Real() != (T1) 0 || m_complex[start + i].Imag() != (T1) 0;
+
+            if (nonzero)
+            {
+                lower = i - j;
+                break;
+            }
+        }
+
+        for (int i = 0; i < j - upper && i < m_nRows; ++i)
+        {
+            bool nonzero = m_real ? m_real[start + i] != (T1) 0 :
+                           m_complex[start + i].Real() != (T1) 0 || m_complex[start + i].Imag() != (T1) 0;
+
+            if (nonzero)
+            {
+                upper = j - i;
+                break;
+            }
+        }
+    }
+}
+
 //! Determine if the matrix contains non-finite elements
 template<typename T1, typename T2>
 bool hwTMatrix<T1, T2>::IsFinite() const
 {
-    int i = 0;
-    int size = Size();
+    int64_t size = Size();
 
     if (IsReal())
     {
-        for (i = 0; i < size; ++i) 
+        for (int64_t i = 0; i < size; ++i) 
         {
             if (IsNaN_T(m_real[i]) || IsInf_T(m_real[i]) || IsNegInf_T(m_real[i]))
                 return false;
@@ -621,7 +706,7 @@ bool hwTMatrix<T1, T2>::IsFinite() const
     }
     else
     {
-        for (i = 0; i < size; ++i) 
+        for (int64_t i = 0; i < size; ++i) 
         {
             T1 real = m_complex[i].Real();
             T1 imag = m_complex[i].Imag();
@@ -640,8 +725,7 @@ bool hwTMatrix<T1, T2>::IsFinite() const
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<bool>& R) const
 {
-    int i = 0;
-    int size = Size();
+    int64_t size = Size();
     hwMathStatus status;
 
     status = R.Dimension(m_nRows, m_nCols, hwTMatrix<bool>::REAL);
@@ -654,7 +738,7 @@ hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<bool>& R) const
 
     if (IsReal())
     {
-        for (i = 0; i < size; ++i) 
+        for (int64_t i = 0; i < size; ++i) 
         {
             if (IsNaN_T(m_real[i]) || IsInf_T(m_real[i]) || IsNegInf_T(m_real[i])) 
                 R(i) = false;
@@ -664,7 +748,7 @@ hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<bool>& R) const
     }
     else
     {
-        for (i = 0; i < size; ++i) 
+        for (int64_t i = 0; i < size; ++i) 
         {
             T1 real = m_complex[i].Real();
             T1 imag = m_complex[i].Imag();
@@ -687,8 +771,7 @@ hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<bool>& R) const
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<double>& R) const
 {
-    int i = 0;
-    int size = Size();
+    int64_t size = Size();
     hwMathStatus status;
 
     status = R.Dimension(m_nRows, m_nCols, hwTMatrix<double>::REAL);
@@ -701,7 +784,7 @@ hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<double>& R) const
 
     if (IsReal())
     {
-        for (i = 0; i < size; ++i) 
+        for (int64_t i = 0; i < size; ++i) 
         {
             if (IsNaN_T(m_real[i]) || IsInf_T(m_real[i]) || IsNegInf_T(m_real[i])) 
                 R(i) = 0.0;
@@ -711,7 +794,7 @@ hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<double>& R) const
     }
     else
     {
-        for (i = 0; i < size; ++i) 
+        for (int64_t i = 0; i < size; ++i) 
         {
             T1 real = m_complex[i].Real();
             T1 imag = m_complex[i].Imag();
@@ -736,7 +819,7 @@ hwMathStatus hwTMatrix<T1, T2>::IsFinite(hwTMatrix<double>& R) const
 
 //! Return a reference to the real matrix element at the specified single index
 template<typename T1, typename T2>
-T1& hwTMatrix<T1, T2>::operator()(int index, IndexDir dir)
+T1& hwTMatrix<T1, T2>::operator()(int64_t index, IndexDir dir)
 {
     // m = m_nRows
     // n = m_nCols
@@ -757,7 +840,7 @@ T1& hwTMatrix<T1, T2>::operator()(int index, IndexDir dir)
 
 //! Return a const reference to the real data element at the specified single index
 template<typename T1, typename T2>
-const T1& hwTMatrix<T1, T2>::operator()(int index, IndexDir dir) const
+const T1& hwTMatrix<T1, T2>::operator()(int64_t index, IndexDir dir) const
 {
     if (dir == BY_COL)
         return m_real[index];
@@ -772,19 +855,19 @@ T1& hwTMatrix<T1, T2>::operator()(int i, int j)
     // m = m_nRows
     // n = m_nCols
     // index = j*m + i
-    return m_real[j*m_nRows + i];
+    return m_real[static_cast<int64_t>(j)*m_nRows + i];
 }
 
 //! Return a reference to the real data element at the specified index pair
 template<typename T1, typename T2>
 const T1& hwTMatrix<T1, T2>::operator()(int i, int j) const
 {
-    return m_real[j*m_nRows + i];
+    return m_real[static_cast<int64_t>(j)*m_nRows + i];
 }
 
 //! Set the element at the specified single index to a real value
 template<typename T1, typename T2>
-void hwTMatrix<T1, T2>::SetElement(int index, T1 real, IndexDir dir)
+void hwTMatrix<T1, T2>::SetElement(int64_t index, T1 real, IndexDir dir)
 {
     if (m_real)
         (*this)(index, dir) = real;
@@ -806,16 +889,16 @@ void hwTMatrix<T1, T2>::SetElement(int i, int j, T1 real)
 template<typename T1, typename T2>
 void hwTMatrix<T1, T2>::SetElements(T1 value)
 {
-    int size = Size();
+    int64_t size = Size();
 
     if (m_real)
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             m_real[i] = value;
     }
     else if (m_complex)
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             m_complex[i] = value;
     }
 }
@@ -826,7 +909,7 @@ void hwTMatrix<T1, T2>::SetElements(T1 value)
 
 //! Return a reference to the complex matrix element at the specified single index
 template<typename T1, typename T2>
-T2& hwTMatrix<T1, T2>::z(int index, IndexDir dir)
+T2& hwTMatrix<T1, T2>::z(int64_t index, IndexDir dir)
 {
     if (dir == BY_COL)
         return m_complex[index];
@@ -836,7 +919,7 @@ T2& hwTMatrix<T1, T2>::z(int index, IndexDir dir)
 
 //! Return a reference to the complex matrix element at the specified single index
 template<typename T1, typename T2>
-const T2& hwTMatrix<T1, T2>::z(int index, IndexDir dir) const
+const T2& hwTMatrix<T1, T2>::z(int64_t index, IndexDir dir) const
 {
     if (dir == BY_COL)
         return m_complex[index];
@@ -848,19 +931,19 @@ const T2& hwTMatrix<T1, T2>::z(int index, IndexDir dir) const
 template<typename T1, typename T2>
 T2& hwTMatrix<T1, T2>::z(int i, int j)
 {
-    return m_complex[j*m_nRows + i];
+    return m_complex[static_cast<int64_t>(j)*m_nRows + i];
 }
 
 //! Return a reference to the complex matrix element at the specified index pair
 template<typename T1, typename T2>
 const T2& hwTMatrix<T1, T2>::z(int i, int j) const
 {
-    return m_complex[j*m_nRows + i];
+    return m_complex[static_cast<int64_t>(j)*m_nRows + i];
 }
 
 //! Set the element at the specified single index to a complex value
 template<typename T1, typename T2>
-void hwTMatrix<T1, T2>::SetElement(int index, T2 cplx, IndexDir dir)
+void hwTMatrix<T1, T2>::SetElement(int64_t index, T2 cplx, IndexDir dir)
 {
     if (m_real)
         MakeComplex();
@@ -885,9 +968,9 @@ hwMathStatus hwTMatrix<T1, T2>::SetElements(T2 value)
     if (IsReal())
         return hwMathStatus(HW_MATH_ERR_ARRAYTYPE);
 
-    int size = Size();
+    int64_t size = Size();
 
-    for (int i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
         m_complex[i] = value;
 
     return hwMathStatus();
@@ -913,9 +996,9 @@ hwMathStatus hwTMatrix<T1, T2>::MakeComplex()
         return hwMathStatus(HW_MATH_ERR_ALLOCFAILED, 0);
     }
 
-    int size = Size();
+    int64_t size = Size();
 
-    for (int i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
     {
         m_complex[i].Real() = m_real[i];
         m_complex[i].Imag() = (T1) 0;
@@ -961,7 +1044,7 @@ hwMathStatus hwTMatrix<T1, T2>::PackComplex(const hwTMatrix<T1, T2>& real, const
         return status;
     }
 
-    int size = Size();
+    int64_t size = Size();
     T1* pReal = real.m_real;
     T1* pComplex = reinterpret_cast<T1*> (m_complex);
 
@@ -1018,7 +1101,7 @@ hwMathStatus hwTMatrix<T1, T2>::UnpackComplex(hwTMatrix<T1, T2>* real, hwTMatrix
         }
     }
 
-    int size = Size();
+    int64_t size = Size();
     T1* pComplex = reinterpret_cast<T1*> (m_complex);
 
     if (real && imag)
@@ -1077,8 +1160,8 @@ hwMathStatus hwTMatrix<T1, T2>::InsertElements(const hwTMatrix<T1, T2>& source,
     if (!elems.IsVector())
         return status(HW_MATH_ERR_NOVECTOR, 3);
 
-    int sourceSize = source.Size();
-    int elemsSize = elems.Size();
+    int sourceSize = static_cast<int>(source.Size());
+    int elemsSize = static_cast<int>(elems.Size());
 
     if (startElem < 0)
         return status(HW_MATH_ERR_NONNONNEGINT, 2);
@@ -1134,7 +1217,7 @@ hwMathStatus hwTMatrix<T1, T2>::InsertElements(const hwTMatrix<T1, T2>& source,
     if (!source.IsVector())
         return status(HW_MATH_ERR_NOVECTOR, 1);
 
-    int sourceSize = source.Size();
+    int sourceSize = static_cast<int>(source.Size());
 
     if (startElem < 0)
         return status(HW_MATH_ERR_NONNONNEGINT, 2);
@@ -1182,7 +1265,7 @@ hwMathStatus hwTMatrix<T1, T2>::DeleteElements(const hwTMatrix<T1, T2>& source,
     if (!source.IsVector())
         return status(HW_MATH_ERR_NOVECTOR, 1);
 
-    int sourceSize = source.Size();
+    int sourceSize = static_cast<int>(source.Size());
 
     if (startElem < 0)
         return status(HW_MATH_ERR_NONNONNEGINT, 2);
@@ -1252,13 +1335,16 @@ hwMathStatus hwTMatrix<T1, T2>::DeleteElements(int startElem, int numElems)
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::ConcatRows(const hwTMatrix<T1, T2>& source)
 {
-    int size = source.Size();
+    int64_t size = source.Size();
     hwMathStatus status;
 
     if (this == &source)
         return status(HW_MATH_ERR_NOTALLOWED);      // disallow in-place operation
 
-    status = Dimension(size, source.Type());
+    if (size > std::numeric_limits<int>::max())
+        return status(HW_MATH_ERR_ARRAYTOOLARGE, 1);
+
+    status = Dimension(static_cast<int>(size), source.Type());
 
     if (!status.IsOk())
     {
@@ -1268,13 +1354,13 @@ hwMathStatus hwTMatrix<T1, T2>::ConcatRows(const hwTMatrix<T1, T2>& source)
 
     if (m_real)
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             (*this)(i) = source(i, BY_ROW);
     }
 
     if (m_complex)
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             z(i) = source.z(i, BY_ROW);
     }
 
@@ -1505,13 +1591,16 @@ hwMathStatus hwTMatrix<T1, T2>::WriteRow(int rowNum, const hwTMatrix<T1, T2>& ro
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::ConcatColumns(const hwTMatrix<T1, T2>& source)
 {
-    int size = source.Size();
+    int64_t size = source.Size();
 
     if (this == &source)
         return hwMathStatus(HW_MATH_ERR_NOTALLOWED);      // disallow in-place operation
 
+    if (size > std::numeric_limits<int>::max())
+        return hwMathStatus(HW_MATH_ERR_ARRAYTOOLARGE, 1);
+
     Copy(source);
-    m_nRows = size;
+    m_nRows = static_cast<int>(size);
     m_nCols = 1;
 
     return hwMathStatus();
@@ -1826,8 +1915,8 @@ hwMathStatus hwTMatrix<T1, T2>::WriteSubmatrix(int startElem, const hwTMatrix<T1
             MakeComplex();
     }
 
-    int sourceSize = source.Size();
-    int targetSize = Size();
+    int sourceSize = static_cast<int>(source.Size());
+    int targetSize = static_cast<int>(Size());
 
     if (startElem + sourceSize > targetSize)
         targetSize = startElem + sourceSize;
@@ -1911,7 +2000,7 @@ hwMathStatus hwTMatrix<T1, T2>::Diag(const hwTMatrix<T1, T2>& source, int k)
 
     if (source.IsVector())
     {
-        int size = source.Size();
+        int size = static_cast<int>(source.Size());
         int n = size + abs(k);
 
         status = Dimension(n, n, source.Type());
@@ -2097,7 +2186,6 @@ hwMathStatus hwTMatrix<T1, T2>::Transpose()
         {
             T1* temp_real = m_real;
             char* temp_real_memory = m_real_memory;
-            hwTMatrix<T1, T2> tempM(m, n, temp_real, REAL);
 
             m_real = nullptr;
 
@@ -2110,11 +2198,7 @@ hwMathStatus hwTMatrix<T1, T2>::Transpose()
                 return hwMathStatus(HW_MATH_ERR_ALLOCFAILED, 0);
             }
 
-            for (int i = 0; i < m; ++i)
-            {
-                for (int j = 0; j < n; ++j)
-                    (*this)(j, i) = tempM(i, j);
-            }
+            TransposeData(temp_real, m, n, m_real);
 
             FreeMemory(temp_real_memory, temp_real);
         }
@@ -2123,7 +2207,6 @@ hwMathStatus hwTMatrix<T1, T2>::Transpose()
         {
             T2* temp_complex = m_complex;
             char* temp_complex_memory = m_complex_memory;
-            hwTMatrix<T1, T2> tempM(m, n, temp_complex, COMPLEX);
 
             m_complex = nullptr;
 
@@ -2136,11 +2219,7 @@ hwMathStatus hwTMatrix<T1, T2>::Transpose()
                 return hwMathStatus(HW_MATH_ERR_ALLOCFAILED, 0);
             }
 
-            for (int i = 0; i < m; ++i)
-            {
-                for (int j = 0; j < n; ++j)
-                    z(j, i) = tempM.z(i, j);
-            }
+            TransposeData(temp_complex, m, n, m_complex);
 
             FreeMemory(temp_complex_memory, temp_complex);
         }
@@ -2157,42 +2236,27 @@ hwMathStatus hwTMatrix<T1, T2>::Transpose(const hwTMatrix<T1, T2>& source)
 
     if (source.IsVector())
     {
-        int size = Size();
+        int64_t size = Size();
 
         if (m_real)
         {
-            for (int i = 0; i < size; ++i)
+            for (int64_t i = 0; i < size; ++i)
                 m_real[i] = source.m_real[i];
         }
 
         if (m_complex)
         {
-            for (int i = 0; i < size; ++i)
+            for (int64_t i = 0; i < size; ++i)
                 m_complex[i] = source.m_complex[i];
         }
     }
     else
     {
-        int m = m_nRows;
-        int n = m_nCols;
-
         if (m_real)
-        {
-            for (int i = 0; i < m; ++i)
-            {
-                for (int j = 0; j < n; ++j)
-                    (*this)(i, j) = source(j, i);
-            }
-        }
+            TransposeData(source.m_real, source.m_nRows, source.m_nCols, m_real);
 
         if (m_complex)
-        {
-            for (int i = 0; i < m; ++i)
-            {
-                for (int j = 0; j < n; ++j)
-                    z(i, j) = source.z(j, i);
-            }
-        }
+            TransposeData(source.m_complex, source.m_nRows, source.m_nCols, m_complex);
     }
 
     return status;
@@ -2205,9 +2269,9 @@ void hwTMatrix<T1, T2>::Conjugate()
     if (IsReal())
         return;
 
-    int size = Size();
+    int64_t size = Size();
 
-    for (int i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
         m_complex[i].Imag() = -m_complex[i].Imag();
 }
 
@@ -2223,9 +2287,9 @@ void hwTMatrix<T1, T2>::Conjugate(const hwTMatrix<T1, T2>& source)
     {
         hwMathStatus status = Dimension(source.m_nRows, source.m_nCols, COMPLEX);
 
-        int size = Size();
+        int64_t size = Size();
 
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
         {
             m_complex[i].Real() =  source.m_complex[i].Real();
             m_complex[i].Imag() = -source.m_complex[i].Imag();
@@ -2266,7 +2330,7 @@ hwMathStatus hwTMatrix<T1, T2>::Add(const hwTMatrix<T1, T2>& A, const hwTMatrix<
     hwMathStatus status;
     int m = A.m_nRows;
     int n = A.m_nCols;
-    int size = A.Size();
+    int64_t size = A.Size();
 
     if (A.m_nRows != B.m_nRows || A.m_nCols != B.m_nCols)
     {
@@ -2293,35 +2357,51 @@ hwMathStatus hwTMatrix<T1, T2>::Add(const hwTMatrix<T1, T2>& A, const hwTMatrix<
 
     if (A.IsReal() && B.IsReal())
     {
-        for (int i = 0; i < m; ++i)
+        const T1* a_r = A.m_real;
+        const T1* b_r = B.m_real;
+        T1* c_r = m_real;
+
+        hwThreadPool::ParallelFor(size, [=](int64_t begin, int64_t end)
         {
-            for (int j = 0; j < n; ++j)
-                (*this)(i, j) = A(i, j) + B(i, j);
-        }
+            for (int64_t k = begin; k < end; ++k)
+                c_r[k] = a_r[k] + b_r[k];
+        });
     }
     else if (!A.IsReal() && !B.IsReal())
     {
-        for (int i = 0; i < m; ++i)
+        const T2* a_c = A.m_complex;
+        const T2* b_c = B.m_complex;
+        T2* c_c = m_complex;
+
+        hwThreadPool::ParallelFor(size, [=](int64_t begin, int64_t end)
         {
-            for (int j = 0; j < n; ++j)
-                z(i, j) = A.z(i, j) + B.z(i, j);
-        }
+            for (int64_t k = begin; k < end; ++k)
+                c_c[k] = a_c[k] + b_c[k];
+        });
     }
     else if (A.IsReal() && !B.IsReal())
     {
-        for (int i = 0; i < m; ++i)
+        const T1* a_r = A.m_real;
+        const T2* b_c = B.m_complex;
+        T2* c_c = m_complex;
+
+        hwThreadPool::ParallelFor(size, [=](int64_t begin, int64_t end)
         {
-            for (int j = 0; j < n; ++j)
-                z(i, j) = A(i, j) + B.z(i, j);
-        }
+            for (int64_t k = begin; k < end; ++k)
+                c_c[k] = a_r[k] + b_c[k];
+        });
     }
     else // if (!A.IsReal() && B.IsReal())
     {
-        for (int i = 0; i < m; ++i)
+        const T2* a_c = A.m_complex;
+        const T1* b_r = B.m_real;
+        T2* c_c = m_complex;
+
+        hwThreadPool::ParallelFor(size, [=](int64_t begin, int64_t end)
         {
-            for (int j = 0; j < n; ++j)
-                z(i, j) = A.z(i, j) + B(i, j);
-        }
+            for (int64_t k = begin; k < end; ++k)
+                c_c[k] = a_c[k] + b_r[k];
+        });
     }
 
     return status;
@@ -2335,7 +2415,7 @@ hwMathStatus hwTMatrix<T1, T2>::Add(const hwTMatrix<T1, T2>& A, T1 real)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
     hwMathStatus status;
-    int count = A.Size();
+    int64_t count = A.Size();
 
     status = Dimension(A.m_nRows, A.m_nCols, A.Type());
 
@@ -2374,7 +2454,7 @@ hwMathStatus hwTMatrix<T1, T2>::Add(const hwTMatrix<T1, T2>& A, const T2& cmplx)
 
     int m = A.m_nRows;
     int n = A.m_nCols;
-    int count = A.Size();
+    int64_t count = A.Size();
     hwMathStatus status = Dimension(m, n, COMPLEX);
 
     if (!status.IsOk())
@@ -2411,7 +2491,7 @@ hwMathStatus hwTMatrix<T1, T2>::AddEquals(const hwTMatrix<T1, T2>& A)
     hwMathStatus status;
     int m = m_nRows;
     int n = m_nCols;
-    int size = Size();
+    int64_t size = Size();
 
     if (A.m_nRows != m || A.m_nCols != n)
     {
@@ -2468,7 +2548,7 @@ hwMathStatus hwTMatrix<T1, T2>::AddEquals(const hwTMatrix<T1, T2>& A)
 template<typename T1, typename T2>
 void hwTMatrix<T1, T2>::AddEquals(T1 real)
 {
-    int count = Size();
+    int64_t count = Size();
 
     if (IsReal())
     {
@@ -2491,7 +2571,7 @@ template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::AddEquals(const T2& cmplx)
 {
     hwMathStatus status;
-    int count = Size();
+    int64_t count = Size();
 
     if (IsReal())
     {
@@ -2526,7 +2606,7 @@ hwMathStatus hwTMatrix<T1, T2>::Subtr(const hwTMatrix<T1, T2>& A, const hwTMatri
     // check dimensions
     int m = A.m_nRows;
     int n = A.m_nCols;
-    int size = A.Size();
+    int64_t size = A.Size();
 
     if (A.m_nRows != B.m_nRows || A.m_nCols != B.m_nCols)
     {
@@ -2595,7 +2675,7 @@ hwMathStatus hwTMatrix<T1, T2>::Subtr(const hwTMatrix<T1, T2>& A, T1 real)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
     hwMathStatus status;
-    int count = A.Size();
+    int64_t count = A.Size();
 
     status = Dimension(A.m_nRows, A.m_nCols, A.Type());
 
@@ -2634,7 +2714,7 @@ hwMathStatus hwTMatrix<T1, T2>::Subtr(const hwTMatrix<T1, T2>& A, const T2& cmpl
 
     int m = A.m_nRows;
     int n = A.m_nCols;
-    int count = A.Size();
+    int64_t count = A.Size();
     hwMathStatus status = Dimension(m, n, COMPLEX);
 
     if (!status.IsOk())
@@ -2670,7 +2750,7 @@ hwMathStatus hwTMatrix<T1, T2>::Subtr(T1 real, const hwTMatrix<T1, T2>& A)
     if (this == &A)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
-    int count = A.Size();
+    int64_t count = A.Size();
     hwMathStatus status = Dimension(A.m_nRows, A.m_nCols, A.Type());
 
     if (!status.IsOk())
@@ -2706,7 +2786,7 @@ hwMathStatus hwTMatrix<T1, T2>::Subtr(const T2& cmplx, const hwTMatrix<T1, T2>&
     if (this == &A)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
-    int count = A.Size();
+    int64_t count = A.Size();
     hwMathStatus status = Dimension(A.m_nRows, A.m_nCols, COMPLEX);
 
     if (!status.IsOk())
@@ -2739,7 +2819,7 @@ hwMathStatus hwTMatrix<T1, T2>::Subtr(const T2& cmplx, const hwTMatrix<T1, T2>&
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::Negate(const hwTMatrix<T1, T2>& A)
 {
-    int count = A.Size();
+    int64_t count = A.Size();
     hwMathStatus status = Dimension(A.m_nRows, A.m_nCols, A.Type());
 
     if (!status.IsOk())
@@ -2778,7 +2858,7 @@ hwMathStatus hwTMatrix<T1, T2>::SubtrEquals(const hwTMatrix<T1, T2>& A)
     hwMathStatus status;
     int m = m_nRows;
     int n = m_nCols;
-    int size = Size();
+    int64_t size = Size();
 
     if (A.m_nRows != m || A.m_nCols != n)
     {
@@ -2835,7 +2915,7 @@ hwMathStatus hwTMatrix<T1, T2>::SubtrEquals(const hwTMatrix<T1, T2>& A)
 template<typename T1, typename T2>
 void hwTMatrix<T1, T2>::SubtrEquals(T1 real)
 {
-    int count = Size();
+    int64_t count = Size();
 
     if (IsReal())
     {
@@ -2858,7 +2938,7 @@ template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::SubtrEquals(const T2& cmplx)
 {
     hwMathStatus status;
-    int count = Size();
+    int64_t count = Size();
 
     if (IsReal())
     {
@@ -2926,65 +3006,55 @@ hwMathStatus hwTMatrix<T1, T2>::Mult(const hwTMatrix<T1, T2>& A, const hwTMatrix
         return status;
     }
 
-    if (A.IsReal() && B.IsReal())
-    {
-        T1 temp_r;
-        SetElements((T1) 0);
+    MultBlocked(A, B);
 
-        // optimized for column storage
-        for (int j = 0; j < n; j++)
-        {
-            for (int k = 0; k < bm; k++)
-            {
-                temp_r = B(k, j);
+    return status;
+}       
 
-                for (int i = 0; i < m; i++)
-                    (*this)(i, j) += A(i, k) * temp_r;
-            }
-        }
-    }
-    else if (!A.IsReal() && !B.IsReal())
-    {
-        for (int i = 0; i < m; ++i)
-        {
-            for (int j = 0; j < n; ++j)
-            {
-                z(i, j).Set((T1) 0, (T1) 0);
+//! Multiply two matrices, using either one transposed, so that
+//! (*this) = op(A) * op(B)
+template<typename T1, typename T2>
+hwMathStatus hwTMatrix<T1, T2>::MultTrans(const hwTMatrix<T1, T2>& A, bool transA,
+                                          const hwTMatrix<T1, T2>& B, bool transB)
+{
+    if (this == &A)
+        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+    if (this == &B)
+        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
-                for (int k = 0; k < bm; ++k)
-                    z(i, j) += A.z(i, k) * B.z(k, j);
-            }
-        }
-    }
-    else if (A.IsReal() && !B.IsReal())
+    hwTMatrix<T1, T2> AT;
+    hwTMatrix<T1, T2> BT;
+    hwMathStatus status;
+
+    if (transA)
     {
-        for (int i = 0; i < m; ++i)
-        {
-            for (int j = 0; j < n; ++j)
-            {
-                z(i, j).Set((T1) 0, (T1) 0);
+        status = AT.Transpose(A);
 
-                for (int k = 0; k < bm; ++k)
-                    z(i, j) += B.z(k, j) * A(i, k);
-            }
+        if (!status.IsOk())
+        {
+            status.ResetArgs();
+            return status;
         }
     }
-    else // if (!A.IsReal() && B.IsReal())
+
+    if (transB)
     {
-        for (int i = 0; i < m; ++i)
-        {
-            for (int j = 0; j < n; ++j)
-            {
-                z(i, j).Set((T1) 0, (T1) 0);
+        status = BT.Transpose(B);
 
-                for (int k = 0; k < bm; ++k)
-                    z(i, j) += A.z(i, k) * B(k, j);
-            }
+        if (!status.IsOk())
+        {
+            status.ResetArgs();
+            return status;
         }
     }
 
+    status = Mult(transA ? AT : A, transB ? BT : B);
+
+    if (status.GetArg2() == 2)
+        status.SetArg2(3);
+
     return status;
-}       
+}
 
 //! Multiply a matrix and a real number so that (*this) = A * real
 template<typename T1, typename T2>
@@ -2993,7 +3063,7 @@ hwMathStatus hwTMatrix<T1, T2>::Mult(const hwTMatrix<T1, T2>& A, T1 real)
     if (this == &A)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
-    int size = A.Size();
+    int64_t size = A.Size();
     hwMathStatus status = Dimension(A.m_nRows, A.m_nCols, A.Type());
 
     if (!status.IsOk())
@@ -3004,12 +3074,12 @@ hwMathStatus hwTMatrix<T1, T2>::Mult(const hwTMatrix<T1, T2>& A, T1 real)
 
     if (A.IsReal())
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             (*this)(i) = A(i) * real;
     }
     else
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             z(i) = A.z(i) * real;
     }
 
@@ -3023,7 +3093,7 @@ hwMathStatus hwTMatrix<T1, T2>::Mult(const hwTMatrix<T1, T2>& A, const T2& cmplx
     if (this == &A)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
-    int size = A.Size();
+    int64_t size = A.Size();
     hwMathStatus status = Dimension(A.m_nRows, A.m_nCols, COMPLEX);
 
     if (!status.IsOk())
@@ -3034,12 +3104,12 @@ hwMathStatus hwTMatrix<T1, T2>::Mult(const hwTMatrix<T1, T2>& A, const T2& cmplx
 
     if (A.IsReal())
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             z(i) = A(i) * cmplx;
     }
     else
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             z(i) = A.z(i) * cmplx;
     }
 
@@ -3080,7 +3150,7 @@ hwMathStatus hwTMatrix<T1, T2>::MultEquals(const hwTMatrix<T1, T2>& A)
 template<typename T1, typename T2>
 void hwTMatrix<T1, T2>::MultEquals(T1 real)
 {
-    int count = Size();
+    int64_t count = Size();
 
     if (IsReal())
     {
@@ -3103,7 +3173,7 @@ template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::MultEquals(const T2& cmplx)
 {
     hwMathStatus status;
-    int count = Size();
+    int64_t count = Size();
 
     if (IsReal())
     {
@@ -3148,7 +3218,7 @@ hwMathStatus hwTMatrix<T1, T2>::Divide(T1 real, const hwTMatrix<T1, T2>& A)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
     hwMathStatus status;
-    int size = A.Size();
+    int64_t size = A.Size();
 
     status = Dimension(A.m_nRows, A.m_nCols, A.Type());
 
@@ -3160,14 +3230,14 @@ hwMathStatus hwTMatrix<T1, T2>::Divide(T1 real, const hwTMatrix<T1, T2>& A)
 
     if (A.IsReal())
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             (*this)(i) = real / A(i);
     }
     else
     {
         T2 c(real, (T1) 0);
 
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             z(i) = c / A.z(i);
     }
 
@@ -3182,7 +3252,7 @@ hwMathStatus hwTMatrix<T1, T2>::Divide(const T2& cmplx, const hwTMatrix<T1, T2>&
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
     hwMathStatus status;
-    int size = A.Size();
+    int64_t size = A.Size();
 
     status = Dimension(A.m_nRows, A.m_nCols, COMPLEX);
 
@@ -3194,12 +3264,12 @@ hwMathStatus hwTMatrix<T1, T2>::Divide(const T2& cmplx, const hwTMatrix<T1, T2>&
 
     if (A.IsReal())
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             z(i) = cmplx / A(i);
     }
     else
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             z(i) = cmplx / A.z(i);
     }
 
@@ -3233,7 +3303,7 @@ hwMathStatus hwTMatrix<T1, T2>::MultByElems(const hwTMatrix<T1, T2>& A, const hw
 
     hwTMatrix<T1, T2>& C = (*this);
     hwMathStatus status;
-    int count = A.Size();
+    int64_t count = A.Size();
     int m = A.m_nRows;
     int n = A.m_nCols;
 
@@ -3256,13 +3326,15 @@ hwMathStatus hwTMatrix<T1, T2>::MultByElems(const hwTMatrix<T1, T2>& A, const hw
         if (!status.IsOk())
             return status;
 
-        T1* a_r = A.m_real;
-        T1* b_r = B.m_real;
+        const T1* a_r = A.m_real;
+        const T1* b_r = B.m_real;
         T1* c_r = C.m_real;
 
-        // note: This could be implemented with DSBMV if multiprocessor version is available
-        while (count--)
-            *c_r++ = (*a_r++) * (*b_r++);
+        hwThreadPool::ParallelFor(count, [=](int64_t begin, int64_t end)
+        {
+            for (int64_t k = begin; k < end; ++k)
+                c_r[k] = a_r[k] * b_r[k];
+        });
     }
     else if (!A.IsReal() && !B.IsReal())
     {
@@ -3271,12 +3343,15 @@ hwMathStatus hwTMatrix<T1, T2>::MultByElems(const hwTMatrix<T1, T2>& A, const hw
         if (!status.IsOk())
             return status;
 
-        T2* a_c = A.m_complex;
-        T2* b_c = B.m_complex;
+        const T2* a_c = A.m_complex;
+        const T2* b_c = B.m_complex;
         T2* c_c = C.m_complex;
 
-        while (count--)
-            *c_c++ = (*a_c++) * (*b_c++);
+        hwThreadPool::ParallelFor(count, [=](int64_t begin, int64_t end)
+        {
+            for (int64_t k = begin; k < end; ++k)
+                c_c[k] = a_c[k] * b_c[k];
+        });
     }
     else if (A.IsReal() && !B.IsReal())
     {
@@ -3335,7 +3410,7 @@ hwMathStatus hwTMatrix<T1, T2>::DivideByElems(const hwTMatrix<T1, T2>& A, const
 
     hwTMatrix<T1, T2>& C = (*this);
     hwMathStatus status;
-    int count = A.Size();
+    int64_t count = A.Size();
     int m = A.m_nRows;
     int n = A.m_nCols;
 
@@ -3445,7 +3520,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base, T1 p
     hwMathStatus status;
     int m = Base.m_nRows;
     int n = Base.m_nCols;
-    int count = -1;
+    int64_t count = -1;
     hwTMatrix<T1, T2>* B = (hwTMatrix<T1, T2>*) &Base;
 
     // check for negative real bases to non-integer exponents
@@ -3470,15 +3545,14 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base, T1 p
         if (!status.IsOk())
             return status;
 
-        int index = 0;
-        T1* b_r = Base.m_real;
-        count = Size();
+        const T1* b_r = Base.m_real;
+        T2* c_c = C.m_complex;
 
-        while (index < count)
+        hwThreadPool::ParallelFor(Size(), [=](int64_t begin, int64_t end)
         {
-            C.z(index) = hwTComplex<T1>::pow_c(*b_r++, power);
-            ++index;
-        }
+            for (int64_t k = begin; k < end; ++k)
+                c_c[k] = hwTComplex<T1>::pow_c(b_r[k], power);
+        }, 8);
     }
     else if (Base.IsReal())
     {
@@ -3494,16 +3568,14 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base, T1 p
             return status;
         }
 
-        T1* b_r = B->m_real;
+        const T1* b_r = B->m_real;
         T1* c_r = C.m_real;
-        count = Size();
 
-        while (count--)
+        hwThreadPool::ParallelFor(Size(), [=](int64_t begin, int64_t end)
         {
-            *c_r = CustomPow(*b_r, power);
-            ++c_r;
-            ++b_r;
-        }
+            for (int64_t k = begin; k < end; ++k)
+                c_r[k] = CustomPow(b_r[k], power);
+        }, 8);
     }
     else
     {
@@ -3519,10 +3591,14 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base, T1 p
             return status;
         }
 
-        count = Size();
+        const T2* b_c = Base.m_complex;
+        T2* c_c = C.m_complex;
 
-        while (count--)
-            C.z(count) = hwTComplex<T1>::pow(Base.z(count), power);
+        hwThreadPool::ParallelFor(Size(), [=](int64_t begin, int64_t end)
+        {
+            for (int64_t k = begin; k < end; ++k)
+                c_c[k] = hwTComplex<T1>::pow(b_c[k], power);
+        }, 8);
     }
 
     return status;
@@ -3542,7 +3618,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base, T2 p
 
     hwMathStatus status = C.Dimension(m, n, COMPLEX);
 
-    int count = Size();
+    int64_t count = Size();
 
     if (!status.IsOk())
     {
@@ -3606,7 +3682,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base,
     hwMathStatus status;
     int m = Base.m_nRows;
     int n = Base.m_nCols;
-    int count = -1;
+    int64_t count = -1;
 
     // check for negative bases to real non-integer exponents
     if (Base.IsReal() && Pow.IsReal())
@@ -3639,7 +3715,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base,
             return status;
         }
 
-        int index = 0;
+        int64_t index = 0;
         const T1* b_r = Base.GetRealData();
         const T1* p_r = Pow.GetRealData();
         count = Size();
@@ -3664,13 +3740,15 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base,
             return status;
         }
 
-        T1* b_r = Base.m_real;
-        T1* p_r = Pow.m_real;
+        const T1* b_r = Base.m_real;
+        const T1* p_r = Pow.m_real;
         T1* c_r = C.m_real;
-        count = Size();
 
-        while (count--)
-            *c_r++ = CustomPow((*b_r++), (*p_r++));
+        hwThreadPool::ParallelFor(Size(), [=](int64_t begin, int64_t end)
+        {
+            for (int64_t k = begin; k < end; ++k)
+                c_r[k] = CustomPow(b_r[k], p_r[k]);
+        }, 8);
     }
     else if (!Base.IsReal() && !Pow.IsReal())
     {
@@ -3686,14 +3764,15 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base,
             return status;
         }
 
-        int index = 0;
-        count = Size();
+        const T2* b_c = Base.m_complex;
+        const T2* p_c = Pow.m_complex;
+        T2* c_c = C.m_complex;
 
-        while (index < count)
+        hwThreadPool::ParallelFor(Size(), [=](int64_t begin, int64_t end)
         {
-            C.z(index) = hwTComplex<T1>::pow(Base.z(index), Pow.z(index));
-            ++index;
-        }
+            for (int64_t k = begin; k < end; ++k)
+                c_c[k] = hwTComplex<T1>::pow(b_c[k], p_c[k]);
+        }, 8);
     }
     else if (Base.IsReal() && !Pow.IsReal())
     {
@@ -3709,7 +3788,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base,
             return status;
         }
 
-        int index = 0;
+        int64_t index = 0;
         T1* b_r = Base.m_real;
         count = Size();
 
@@ -3733,7 +3812,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(const hwTMatrix<T1, T2>& Base,
             return status;
         }
 
-        int index = 0;
+        int64_t index = 0;
         T1* p_r = Pow.m_real;
         count = Size();
 
@@ -3759,7 +3838,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(T1 base, const hwTMatrix<T1, T2>& P
     hwMathStatus status;
     int m = Pow.m_nRows;
     int n = Pow.m_nCols;
-    int count = -1;
+    int64_t count = -1;
 
     // check for negative base to real non-integer exponents
     if (base < 0.0 && Pow.IsReal())
@@ -3781,7 +3860,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(T1 base, const hwTMatrix<T1, T2>& P
         if (!status.IsOk())
             return status;
 
-        int index = 0;
+        int64_t index = 0;
         T1* p_r = Pow.m_real;
         count = Size();
 
@@ -3826,7 +3905,7 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(T1 base, const hwTMatrix<T1, T2>& P
             return status;
         }
 
-        int index = 0;
+        int64_t index = 0;
         count = Size();
 
         while (index < count)
@@ -3850,8 +3929,8 @@ hwMathStatus hwTMatrix<T1, T2>::PowerByElems(T2 base, const hwTMatrix<T1, T2>& P
     hwTMatrix<T1, T2>& C = (*this);
     int m = Pow.m_nRows;
     int n = Pow.m_nCols;
-    int count = Pow.Size();
-    int index = 0;
+    int64_t count = Pow.Size();
+    int64_t index = 0;
 
     hwMathStatus status = C.Dimension(m, n, COMPLEX);
 
@@ -3904,13 +3983,13 @@ bool hwTMatrix<T1, T2>::IsEqual(const hwTMatrix<T1, T2>& A, T1 tol) const
     if (A.m_nRows != m || A.m_nCols != n)
         return false;
 
-    int size = Size();
+    int64_t size = Size();
 
     if (m_real)
     {
         if (A.m_real)
         {
-            for (int i = 0; i < size; ++i)
+            for (int64_t i = 0; i < size; ++i)
             {
                 if (!AreEqual(m_real[i], A.m_real[i], tol))
                     return false;
@@ -3918,7 +3997,7 @@ bool hwTMatrix<T1, T2>::IsEqual(const hwTMatrix<T1, T2>& A, T1 tol) const
         }
         else if (A.m_complex)
         {
-            for (int i = 0; i < size; ++i)
+            for (int64_t i = 0; i < size; ++i)
             {
                 if (!A.m_complex[i].IsReal(tol))
                     return false;
@@ -3930,7 +4009,7 @@ bool hwTMatrix<T1, T2>::IsEqual(const hwTMatrix<T1, T2>& A, T1 tol) const
     }
     else if (A.m_complex)
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
         {
             if (!m_complex[i].IsEqual(A.m_complex[i], tol))
                 return false;
@@ -3938,7 +4017,7 @@ bool hwTMatrix<T1, T2>::IsEqual(const hwTMatrix<T1, T2>& A, T1 tol) const
     }
     else if (A.m_real)
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
         {
             if (!m_complex[i].IsReal(tol))
                 return false;
@@ -4266,7 +4345,7 @@ hwMathStatus hwTMatrix<T1, T2>::L2NormSq(T1& normSq) const
     if (!IsVector())
         return hwMathStatus(HW_MATH_ERR_VECTOR, 0);
 
-    int count = Size();
+    int64_t count = Size();
 
     normSq = 0.0;
 
@@ -4304,7 +4383,7 @@ hwMathStatus hwTMatrix<T1, T2>::Dot(const hwTMatrix<T1, T2>& A, const hwTMatrix<
     if (!B.IsEmptyOrVector())
         return hwMathStatus(HW_MATH_ERR_VECTOR, 2);
 
-    int count = A.Size();
+    int64_t count = A.Size();
 
     if (B.Size() != count)
         return hwMathStatus(HW_MATH_ERR_ARRAYSIZE, 0, 1);
@@ -4416,6 +4495,14 @@ hwMathStatus hwTMatrix<T1, T2>::Cross(const hwTMatrix<T1, T2>& A, const hwTMatri
 //! Linear convolution of two vectors
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::ConvLin(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y)
+{
+    return ConvLin(X, Y, 0, _max(static_cast<int>(X.Size() + Y.Size() - 1), 0));
+}
+
+//! Elements start to start+count-1 of the linear convolution of two vectors
+template<typename T1, typename T2>
+hwMathStatus hwTMatrix<T1, T2>::ConvLin(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y,
+                                        int start, int count)
 {
     if (this == &X)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
@@ -4425,27 +4512,24 @@ hwMathStatus hwTMatrix<T1, T2>::ConvLin(const hwTMatrix<T1, T2>& X, const hwTMat
     // X is reversed and passed over Y
     hwMathStatus status;
 
-    if (X.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
-
     if (!X.IsVector())
         return status(HW_MATH_ERR_VECTOR, 1);
 
-    if (Y.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 2);
-
     if (!Y.IsVector())
         return status(HW_MATH_ERR_VECTOR, 2);
 
-    int xn = X.Size();
-    int yn = Y.Size();
+    if (start < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 3);
+
+    if (count < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 4);
 
-    int cn = xn + yn - 1;       // size of conv
+    DataType type = (X.m_complex || Y.m_complex) ? COMPLEX : REAL;
 
     if (X.m_nRows == 1)
-        status = Dimension(1, cn, REAL);
+        status = Dimension(1, count, type);
     else
-        status = Dimension(cn, 1, REAL);
+        status = Dimension(count, 1, type);
 
     if (!status.IsOk())
     {
@@ -4455,75 +4539,30 @@ hwMathStatus hwTMatrix<T1, T2>::ConvLin(const hwTMatrix<T1, T2>& X, const hwTMat
         return status;
     }
 
-    int partial = _min(xn, yn) - 1; // size of partial overlaps
-    int count;
-    T1 value;
-    T1* x_start = X.m_real;
-    T1* y_start = Y.m_real;
-    T1* x;
-    T1* y;
-    T1* c = m_real;
-
-    // leading partial overlap
-    for (int i = 0; i < partial; ++i)
+    if (type == REAL)
     {
-        x = x_start + i;
-        y = y_start;
-        count = i + 1;
-        value = (T1) 0;
-
-        while (count--)
-            value += (*x--) * (*y++);
-
-        c[i] = value;
+        hwConvolution::Conv(X.m_real, static_cast<int>(X.Size()), Y.m_real, static_cast<int>(Y.Size()), start, count, m_real);
+        return status;
     }
 
-    // complete overlap
-    if (xn < yn)
-    {
-        for (int i = partial; i < yn; ++i)
-        {
-            x = x_start + partial;
-            y = y_start - partial + i;
-            count = xn;
-            value = (T1) 0;
+    hwTMatrix<T1, T2> tempX;
+    hwTMatrix<T1, T2> tempY;
+    const hwTMatrix<T1, T2>* Xc;
+    const hwTMatrix<T1, T2>* Yc;
 
-            while (count--)
-                value += (*x--) * (*y++);
+    status = ComplexOperand(X, tempX, Xc);
 
-            c[i] = value;
-        }
-    }
-    else
-    {
-        for (int i = partial; i < xn; ++i)
-        {
-            x = x_start + i;
-            y = y_start;
-            count = yn;
-            value = (T1) 0;
-
-            while (count--)
-                value += (*x--) * (*y++);
+    if (status.IsOk())
+        status = ComplexOperand(Y, tempY, Yc);
 
-            c[i] = value;
-        }
-    }
-
-    // trailing partial overlap
-    for (int i = cn - partial; i < cn; ++i)
+    if (!status.IsOk())
     {
-        x = x_start + xn - 1;
-        y = y_start - xn + 1 + i;
-        count = cn - i;
-        value = (T1) 0;
-
-        while (count--)
-            value += (*x--) * (*y++);
-
-        c[i] = value;
+        status.ResetArgs();
+        return status;
     }
 
+    hwConvolution::Conv(Xc->m_complex, static_cast<int>(X.Size()), Yc->m_complex, static_cast<int>(Y.Size()), start, count, m_complex);
+
     return status;
 }
 
@@ -4537,29 +4576,26 @@ hwMathStatus hwTMatrix<T1, T2>::CorrLin(const hwTMatrix<T1, T2>& X, const hwTMat
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
     // linear correlation - time domain
-    // X is passed over Y
+    // X is passed over Y, which is the convolution of X with Y reversed and
+    // conjugated
     hwMathStatus status;
 
-    if (X.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
-
     if (!X.IsVector())
         return status(HW_MATH_ERR_VECTOR, 1);
 
-    if (Y.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 2);
-
     if (!Y.IsVector())
         return status(HW_MATH_ERR_VECTOR, 2);
 
-    int xn = X.Size();
-    int yn = Y.Size();
+    int xn = static_cast<int>(X.Size());    // vectors, so the sizes fit in an int
+    int yn = static_cast<int>(Y.Size());
     int cn = xn + yn - 1;       // size of corr
 
+    DataType type = (X.m_complex || Y.m_complex) ? COMPLEX : REAL;
+
     if (X.m_nRows == 1)
-        status = Dimension(1, cn, REAL);
+        status = Dimension(1, cn, type);
     else
-        status = Dimension(cn, 1, REAL);
+        status = Dimension(cn, 1, type);
 
     if (!status.IsOk())
     {
@@ -4569,75 +4605,38 @@ hwMathStatus hwTMatrix<T1, T2>::CorrLin(const hwTMatrix<T1, T2>& X, const hwTMat
         return status;
     }
 
-    int partial = _min(xn, yn) - 1; // size of partial overlaps
-    int count;
-    T1 value;
-    T1* x_start = X.m_real;
-    T1* y_start = Y.m_real;
-    T1* x;
-    T1* y;
-    T1* c = m_real;
+    hwTMatrix<T1, T2> reversed(yn, 1, type);
 
-    // leading partial overlap
-    for (int i = 0; i < partial; ++i)
+    if (type == REAL)
     {
-        x = x_start;
-        y = y_start + yn - 1 - i;
-        count = i + 1;
-        value = (T1) 0;
-
-        while (count--)
-            value += (*x++) * (*y++);
+        for (int i = 0; i < yn; ++i)
+            reversed.m_real[i] = Y.m_real[yn - 1 - i];
 
-        c[i] = value;
+        hwConvolution::Conv(reversed.m_real, yn, X.m_real, xn, 0, cn, m_real);
+        return status;
     }
 
-    // complete overlap
-    if (xn < yn)
+    for (int i = 0; i < yn; ++i)
     {
-        for (int i = partial; i < yn; ++i)
-        {
-            x = x_start;
-            y = y_start + yn - 1 - i;
-            count = xn;
-            value = (T1) 0;
-
-            while (count--)
-                value += (*x++) * (*y++);
-
-            c[i] = value;
-        }
+        if (Y.m_complex)
+            reversed.m_complex[i] = Y.m_complex[yn - 1 - i].Conjugate();
+        else
+            reversed.m_complex[i] = T2(Y.m_real[yn - 1 - i], (T1) 0);
     }
-    else
-    {
-        for (int i = partial; i < xn; ++i)
-        {
-            x = x_start - yn + 1 + i;
-            y = y_start;
-            count = yn;
-            value = (T1) 0;
 
-            while (count--)
-                value += (*x++) * (*y++);
+    hwTMatrix<T1, T2> tempX;
+    const hwTMatrix<T1, T2>* Xc;
 
-            c[i] = value;
-        }
-    }
+    status = ComplexOperand(X, tempX, Xc);
 
-    // trailing partial overlap
-    for (int i = cn - partial; i < cn; ++i)
+    if (!status.IsOk())
     {
-        x = x_start - yn + 1 + i;
-        y = y_start;
-        count = cn - i;
-        value = (T1) 0;
-
-        while (count--)
-            value += (*x++) * (*y++);
-
-        c[i] = value;
+        status.ResetArgs();
+        return status;
     }
 
+    hwConvolution::Conv(reversed.m_complex, yn, Xc->m_complex, xn, 0, cn, m_complex);
+
     return status;
 }
 
@@ -4647,25 +4646,20 @@ hwMathStatus hwTMatrix<T1, T2>::CorrLin(const hwTMatrix<T1, T2>& X)
 {
     hwMathStatus status;
 
-    if (X.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
-
     if (X.IsVector())
         return status(HW_MATH_ERR_NOVECTOR, 1);
 
     int m = X.m_nRows;
     int n = X.m_nCols;
-    const double* col1;
-    const double* col2;
-    const double* colr;
+    DataType type = X.Type();
 
     if (m == 0)
     {
-        status = Dimension(0, n*n, REAL);
+        status = Dimension(0, n*n, type);
         return status;
     }
 
-    status = Dimension(2*m-1, n*n, REAL);
+    status = Dimension(2*m-1, n*n, type);
 
     if (!status.IsOk())
     {
@@ -4675,15 +4669,28 @@ hwMathStatus hwTMatrix<T1, T2>::CorrLin(const hwTMatrix<T1, T2>& X)
 
     for (int i = 0; i < n; ++i)
     {
-        col1 = &X(0, i);
-        hwTMatrix<T1, T2> vec1(m, 1, (void*) col1, REAL);
-
         for (int j = 0; j < n; ++j)
         {
-            col2 = &X(0, j);
-            colr = &(*this)(0, n*i+j);
-            hwTMatrix<T1, T2> vec2(m, 1, (void*) col2, REAL);
-            hwTMatrix<T1, T2> vecr(2*m-1, 1, (void*) colr, REAL);
+            void* col1;
+            void* col2;
+            void* colr;
+
+            if (type == REAL)
+            {
+                col1 = X.m_real + static_cast<int64_t>(m) * i;
+                col2 = X.m_real + static_cast<int64_t>(m) * j;
+                colr = m_real + static_cast<int64_t>(2*m-1) * (n*i+j);
+            }
+            else
+            {
+                col1 = X.m_complex + static_cast<int64_t>(m) * i;
+                col2 = X.m_complex + static_cast<int64_t>(m) * j;
+                colr = m_complex + static_cast<int64_t>(2*m-1) * (n*i+j);
+            }
+
+            hwTMatrix<T1, T2> vec1(m, 1, col1, type);
+            hwTMatrix<T1, T2> vec2(m, 1, col2, type);
+            hwTMatrix<T1, T2> vecr(2*m-1, 1, colr, type);
 
             status = vecr.CorrLin(vec1, vec2);
 
@@ -4703,6 +4710,26 @@ hwMathStatus hwTMatrix<T1, T2>::CorrLin(const hwTMatrix<T1, T2>& X)
 //! 2D convolution of two matrices
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::Conv2D(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y)
+{
+    int cm = X.m_nRows + Y.m_nRows - 1;     // # rows in conv
+    int cn = X.m_nCols + Y.m_nCols - 1;     // # cols in conv
+
+    if (cm < 1 || cn < 1)
+    {
+        if (this == &X || this == &Y)
+            return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+
+        Dimension(_max(cm, 0), _max(cn, 0), REAL);
+        return hwMathStatus();
+    }
+
+    return Conv2D(X, Y, 0, 0, cm, cn);
+}
+
+//! The m x n block at (top, left) of the 2D convolution of two matrices
+template<typename T1, typename T2>
+hwMathStatus hwTMatrix<T1, T2>::Conv2D(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y,
+                                       int top, int left, int m, int n)
 {
     if (this == &X)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
@@ -4713,123 +4740,62 @@ hwMathStatus hwTMatrix<T1, T2>::Conv2D(const hwTMatrix<T1, T2>& X, const hwTMatr
     // X is reversed and passed over Y
     hwMathStatus status;
 
-    if (X.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
+    if (top < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 3);
 
-    if (Y.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 2);
+    if (left < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 4);
 
-    int xm = X.m_nRows;
-    int xn = X.m_nCols;
-    int ym = Y.m_nRows;
-    int yn = Y.m_nCols;
+    if (m < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 5);
 
-    int cm = xm + ym - 1;       // # rows in conv
-    int cn = xn + yn - 1;       // # cols in conv
+    if (n < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 6);
 
-    status = Dimension(cm, cn, REAL);
+    DataType type = (X.m_complex || Y.m_complex) ? COMPLEX : REAL;
+
+    status = Dimension(m, n, type);
 
     if (!status.IsOk())
     {
-        if (cm < 1 || cn < 1)
-            return hwMathStatus();
-
         if (status.GetArg1() != 0)
             status.ResetArgs();
 
         return status;
     }
 
-    // find each conv(i, j)
-    int start_xi, index_xi;             // X column indexing
-    int start_xj, index_xj;             // X row indexing
-    int start_yi, stop_yi;              // Y column window
-    int start_yj, stop_yj;              // Y row window
-    int partial_i = _min(xm, ym) - 1;   // size of partial col overlaps
-    int partial_j = _min(xn, yn) - 1;   // size of partial row overlaps
-    T1 value;
-
-    for (int i = 0; i < cm; ++i)
+    if (X.IsEmpty() || Y.IsEmpty())
     {
-        if (i < partial_i)
-        {
-            start_yi = 0;
-            stop_yi = i + 1;
-            start_xi = i;
-        }
-        else if (i < cm - partial_i)
-        {
-            if (xm < ym)
-            {
-                start_yi = i - xm + 1;
-                stop_yi = i + 1;
-                start_xi = xm - 1;
-            }
-            else
-            {
-                start_yi = 0;
-                stop_yi = ym;
-                start_xi = i;
-            }
-        }
-        else
-        {
-            start_yi = i - xm + 1;
-            stop_yi = ym;
-            start_xi = partial_i;
-        }
-
-        for (int j = 0; j < cn; ++j)
-        {
-            if (j < partial_j)
-            {
-                start_yj = 0;
-                stop_yj = j + 1;
-                start_xj = j;
-            }
-            else if (j < cn - partial_j)
-            {
-                if (xn < yn)
-                {
-                    start_yj = j - xn + 1;
-                    stop_yj = j + 1;
-                    start_xj = xn - 1;
-                }
-                else
-                {
-                    start_yj = 0;
-                    stop_yj = yn;
-                    start_xj = j;
-                }
-            }
-            else
-            {
-                start_yj = j - xn + 1;
-                stop_yj = yn;
-                start_xj = partial_j;
-            }
+        SetElements((T1) 0);
+        return status;
+    }
 
-            // multiply the 2D overlap of Y and the reversed, shifted X
-            value = (T1) 0;
-            index_xi = start_xi;
+    if (type == REAL)
+    {
+        hwConvolution::Conv2D(X.m_real, X.m_nRows, X.m_nCols, Y.m_real, Y.m_nRows, Y.m_nCols,
+                              top, left, m, n, m_real);
+        return status;
+    }
 
-            for (int ii = start_yi; ii < stop_yi; ++ii)
-            {
-                index_xj = start_xj;
+    hwTMatrix<T1, T2> tempX;
+    hwTMatrix<T1, T2> tempY;
+    const hwTMatrix<T1, T2>* Xc;
+    const hwTMatrix<T1, T2>* Yc;
 
-                for (int jj = start_yj; jj < stop_yj; ++jj)
-                {
-                    value += X(index_xi, index_xj) * Y(ii, jj);
-                    --index_xj;
-                }
+    status = ComplexOperand(X, tempX, Xc);
 
-                --index_xi;
-            }
+    if (status.IsOk())
+        status = ComplexOperand(Y, tempY, Yc);
 
-            (*this)(i, j) = value;
-        }
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
     }
 
+    hwConvolution::Conv2D(Xc->m_complex, X.m_nRows, X.m_nCols, Yc->m_complex, Y.m_nRows, Y.m_nCols,
+                          top, left, m, n, m_complex);
+
     return status;
 }
 
@@ -4837,6 +4803,27 @@ hwMathStatus hwTMatrix<T1, T2>::Conv2D(const hwTMatrix<T1, T2>& X, const hwTMatr
 template<typename T1, typename T2>
 hwMathStatus hwTMatrix<T1, T2>::Conv2D(const hwTMatrix<T1, T2>& col, const hwTMatrix<T1, T2>& row,
                                        const hwTMatrix<T1, T2>& X)
+{
+    int cm = X.m_nRows + static_cast<int>(col.Size()) - 1;    // # rows in conv
+    int cn = X.m_nCols + static_cast<int>(row.Size()) - 1;    // # cols in conv
+
+    if (cm < 1 || cn < 1)
+    {
+        if (this == &col || this == &row || this == &X)
+            return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+
+        Dimension(_max(cm, 0), _max(cn, 0), REAL);
+        return hwMathStatus();
+    }
+
+    return Conv2D(col, row, X, 0, 0, cm, cn);
+}
+
+//! The m x n block at (top, left) of the 2D convolution of a matrix with a
+//! column vector and a row vector
+template<typename T1, typename T2>
+hwMathStatus hwTMatrix<T1, T2>::Conv2D(const hwTMatrix<T1, T2>& col, const hwTMatrix<T1, T2>& row,
+                                       const hwTMatrix<T1, T2>& X, int top, int left, int m, int n)
 {
     if (this == &col)
         return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
@@ -4857,139 +4844,128 @@ hwMathStatus hwTMatrix<T1, T2>::Conv2D(const hwTMatrix<T1, T2>& col, const hwTMa
     if (!col.IsVector())
         return status(HW_MATH_ERR_VECTOR, 1);
 
-    if (col.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
-
     if (!row.IsVector())
         return status(HW_MATH_ERR_VECTOR, 2);
 
-    if (row.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 2);
+    if (top < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 4);
 
-    if (X.m_complex)
-        return status(HW_MATH_ERR_COMPLEXSUPPORT, 3);
+    if (left < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 5);
 
-    int xm = X.m_nRows;
-    int xn = X.m_nCols;
+    if (m < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 6);
 
-    int colSize = col.Size();
-    int rowSize = row.Size();
-    int cm = xm + colSize - 1;       // # rows in conv
-    int cn = xn + rowSize - 1;       // # cols in conv
+    if (n < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 7);
 
-    status = Dimension(cm, cn, REAL);
+    DataType type = (col.m_complex || row.m_complex || X.m_complex) ? COMPLEX : REAL;
+
+    status = Dimension(m, n, type);
 
     if (!status.IsOk())
     {
-        if (cm < 1 || cn < 1)
-            return hwMathStatus();
+        if (status.GetArg1() != 0)
+            status.ResetArgs();
 
         return status;
     }
 
-    // find each conv(i, j)
-    int start_xi, stop_xi;                      // matrix column window
-    int start_xj, stop_xj;                      // matrix row window
-    int start_col, index_col;                   // column vector indexing
-    int start_row, index_row;                   // row vector indexing
-    int partial_col = _min(xm, colSize) - 1;    // size of partial col overlaps
-    int partial_row = _min(xn, rowSize) - 1;    // size of partial row overlaps
-    T1 value;
-    hwTMatrix<T1, T2> row_temp(1, xn, REAL);
+    if (m == 0 || n == 0)
+        return status;
 
-    for (int i = 0; i < cm; ++i)
+    int xm = X.m_nRows;
+    int xn = X.m_nCols;
+
+    if (X.IsEmpty())
     {
-        if (i < partial_col)
-        {
-            start_xi = 0;
-            stop_xi = i + 1;
-            start_col = i;
-        }
-        else if (i < cm - partial_col)
-        {
-            if (xm < colSize)
-            {
-                start_xi = 0;
-                stop_xi = xm;
-                start_col = i;
-            }
-            else
-            {
-                start_xi = i - colSize + 1;
-                stop_xi = i + 1;
-                start_col = colSize - 1;
-            }
-        }
-        else
-        {
-            start_xi = i - colSize + 1;
-            stop_xi = xm;
-            start_col = partial_col;
-        }
+        SetElements((T1) 0);
+        return status;
+    }
+
+    // rows top to top+m-1 of the column convolutions, and then columns left
+    // to left+n-1 of the convolutions of those rows
+    if (type == REAL)
+    {
+        hwTMatrix<T1, T2> temp(m, xn, REAL);
+        hwTMatrix<T1, T2> tempRow(xn, 1, REAL);
+        hwTMatrix<T1, T2> outRow(n, 1, REAL);
 
-        // multiply the overlap of each X column and the reversed, shifted col
-        // put output in a temporary row
-        row_temp.SetElements((T1) 0);
-        index_col = start_col;
+        for (int j = 0; j < xn; ++j)
+            hwConvolution::Conv(col.m_real, static_cast<int>(col.Size()), X.m_real + static_cast<int64_t>(j) * xm, xm, top, m, temp.m_real + static_cast<int64_t>(j) * m);
 
-        for (int ii = start_xi; ii < stop_xi; ++ii)
+        for (int i = 0; i < m; ++i)
         {
-            value = col(index_col);
-
             for (int j = 0; j < xn; ++j)
-                row_temp(j) += value * X(ii, j);
+                tempRow.m_real[j] = temp.m_real[static_cast<int64_t>(j) * m + i];
+
+            hwConvolution::Conv(row.m_real, static_cast<int>(row.Size()), tempRow.m_real, xn, left, n, outRow.m_real);
 
-            --index_col;
+            for (int j = 0; j < n; ++j)
+                m_real[static_cast<int64_t>(j) * m + i] = outRow.m_real[j];
         }
 
-        // convolve 'row' with the temporary row
-        for (int j = 0; j < cn; ++j)
-        {
-            if (j < partial_row)
-            {
-                start_xj = 0;
-                stop_xj = j + 1;
-                start_row = j;
-            }
-            else if (j < cn - partial_row)
-            {
-                if (xn < rowSize)
-                {
-                    start_xj = 0;
-                    stop_xj = xn;
-                    start_row = j;
-                }
-                else
-                {
-                    start_xj = j - rowSize + 1;
-                    stop_xj = j + 1;
-                    start_row = rowSize - 1;
-                }
-            }
-            else
-            {
-                start_xj = j - rowSize + 1;
-                stop_xj = xn;
-                start_row = partial_row;
-            }
+        return status;
+    }
 
-            // multiply the overlap of row_temp and the reversed, shifted row
-            value = (T1) 0;
-            index_row = start_row;
+    hwTMatrix<T1, T2> tempCol;
+    hwTMatrix<T1, T2> tempRowVec;
+    hwTMatrix<T1, T2> tempX;
+    const hwTMatrix<T1, T2>* colc;
+    const hwTMatrix<T1, T2>* rowc;
+    const hwTMatrix<T1, T2>* Xc;
 
-            for (int jj = start_xj; jj < stop_xj; ++jj)
-            {
-                value += row(index_row) * row_temp(jj);
-                --index_row;
-            }
+    status = ComplexOperand(col, tempCol, colc);
 
-            (*this)(i, j) = value;
-        }
+    if (status.IsOk())
+        status = ComplexOperand(row, tempRowVec, rowc);
+
+    if (status.IsOk())
+        status = ComplexOperand(X, tempX, Xc);
+
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
+    }
+
+    hwTMatrix<T1, T2> temp(m, xn, COMPLEX);
+    hwTMatrix<T1, T2> tempRow(xn, 1, COMPLEX);
+    hwTMatrix<T1, T2> outRow(n, 1, COMPLEX);
+
+    for (int j = 0; j < xn; ++j)
+        hwConvolution::Conv(colc->m_complex, static_cast<int>(col.Size()), Xc->m_complex + static_cast<int64_t>(j) * xm, xm, top, m, temp.m_complex + static_cast<int64_t>(j) * m);
+
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = 0; j < xn; ++j)
+            tempRow.m_complex[j] = temp.m_complex[static_cast<int64_t>(j) * m + i];
+
+        hwConvolution::Conv(rowc->m_complex, static_cast<int>(row.Size()), tempRow.m_complex, xn, left, n, outRow.m_complex);
+
+        for (int j = 0; j < n; ++j)
+            m_complex[static_cast<int64_t>(j) * m + i] = outRow.m_complex[j];
     }
 
     return status;
 }
 
+//! Point to A, or to a complex copy of A in temp if A is real
+template<typename T1, typename T2>
+hwMathStatus hwTMatrix<T1, T2>::ComplexOperand(const hwTMatrix<T1, T2>& A, hwTMatrix<T1, T2>& temp,
+                                               const hwTMatrix<T1, T2>*& operand)
+{
+    operand = &A;
+
+    if (A.m_complex)
+        return hwMathStatus();
+
+    hwMathStatus status = temp.PackComplex(A);
+    operand = &temp;
+
+    return status;
+}
+
 // ****************************************************
 //            Magnitude / Phase Operations
 // ****************************************************
@@ -5011,18 +4987,17 @@ inline hwMathStatus hwTMatrix<double>::Abs(const hwTMatrix<double>& A)
         return status;
     }
 
-    int size = Size();
+    const double* a_r = A.m_real;
+    const hwComplex* a_c = A.m_complex;
+    double* c_r = m_real;
 
-    if (A.IsReal())
-    {
-        for (int i = 0; i < size; ++i)
-            (*this)(i) = fabs(A(i));
-    }
-    else
+    hwThreadPool::ParallelFor(Size(), [=](int64_t begin, int64_t end)
     {
-        for (int i = 0; i < size; ++i)
-            (*this)(i) = A.z(i).Mag();
-    }
+        if (a_c)
+            hwVectorMath::Abs(end - begin, a_c + begin, c_r + begin);
+        else
+            hwVectorMath::Abs(end - begin, a_r + begin, c_r + begin);
+    });
 
     return status;
 }
@@ -5044,16 +5019,16 @@ inline hwMathStatus hwTMatrix<double>::AbsSq(const hwTMatrix<double>& A)
         return status;
     }
 
-    int size = Size();
+    int64_t size = Size();
 
     if (A.IsReal())
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             (*this)(i) = A(i) * A(i);
     }
     else
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             (*this)(i) = A.z(i).MagSq();
     }
 
@@ -5083,9 +5058,9 @@ inline hwMathStatus hwTMatrix<double>::Phase(const hwTMatrix<double>& A)
     }
     else
     {
-        int size = Size();
+        int64_t size = Size();
 
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             (*this)(i) = A.z(i).Arg();
     }
 
@@ -5163,10 +5138,14 @@ inline hwMathStatus hwTMatrix<double>::Hypot(const hwTMatrix<double>& A, const h
 		{
 			if (A.m_nRows == B.m_nRows && A.m_nCols == B.m_nCols)
 			{
-				for (int i = 0; i < A.m_nRows * A.m_nCols; i++)
+				const double* a_r = A.m_real;
+				const double* b_r = B.m_real;
+				double* c_r = m_real;
+
+				hwThreadPool::ParallelFor(A.m_nRows * A.m_nCols, [=](int64_t begin, int64_t end)
 				{
-					(*this)(i) = _hypot(A(i), B(i));
-				}
+					hwVectorMath::Hypot(end - begin, a_r + begin, b_r + begin, c_r + begin);
+				});
 			}
 			else if (A.m_nRows == 1 && A.m_nCols == 1)
 			{
@@ -5422,30 +5401,21 @@ inline void hwTMatrix<double>::SetCapacity(DataType dataType)
         return;
     }
 
-    size_t maxSize = std::numeric_limits<int>::max();
-
-    if ((size_t) m_nCols > maxSize / (size_t) m_nRows)
-    {
-        m_capacity = -1;    // force allocaction failure
-        return;
-    }
+    int64_t maxSize = std::numeric_limits<int64_t>::max() / static_cast<int64_t>(sizeof(hwTComplex<double>));
+    int64_t size = Size();
 
-    int size = Size();
+    if (size > maxSize)
+        throw hwMathException(HW_MATH_ERR_ARRAYTOOLARGE);
 
     if (size > m_capacity)
     {
         if (m_capacity > maxSize - m_capacity)
         {
-            m_capacity = static_cast<int>(maxSize);
+            m_capacity = maxSize;
         }
         else
         {
             m_capacity = _max(2 * m_capacity, size);
-
-            if (dataType == REAL)   // extend for 16-byte alignment
-                m_capacity += 2;
-            else
-                m_capacity++;
         }
     }
 }
@@ -5466,20 +5436,16 @@ void hwTMatrix<T1, T2>::SetCapacity(DataType dataType)
         return;
     }
 
-    size_t maxSize = std::numeric_limits<int>::max();
-    
-    if ((size_t) m_nCols > maxSize / (size_t) m_nRows)
-    {
-        m_capacity = -1;    // force allocaction failure
-        return;
-    }
+    int64_t maxSize = std::numeric_limits<int64_t>::max() / static_cast<int64_t>(sizeof(T2));
+    int64_t size = Size();
 
-    int size = Size();
+    if (size > maxSize)
+        throw hwMathException(HW_MATH_ERR_ARRAYTOOLARGE);
 
     if (size > m_capacity)
     {
         if (m_capacity > maxSize - m_capacity)
-            m_capacity = static_cast<int>(maxSize);
+            m_capacity = maxSize;
         else
             m_capacity = _max(2 * m_capacity, size);
     }
@@ -5492,12 +5458,12 @@ inline void hwTMatrix<double>::Deallocate()
     if (m_bits.ownData)
     {
         if (m_real_memory)
-            delete [] m_real_memory;
+            hwMemoryPool::Free(m_real_memory);
         else if (m_real)
             delete [] m_real;	    // ownership of external data was assumed
 
         if (m_complex_memory)
-            delete [] m_complex_memory;
+            hwMemoryPool::Free(m_complex_memory);
         else if (m_complex)
             delete [] m_complex;    // ownership of external data was assumed
     }
@@ -5539,9 +5505,9 @@ inline void hwTMatrix<double>::Allocate(DataType dataType)
 
         try
         {
-            m_real_memory = new char[m_capacity * sizeof(double)];
-            m_real = reinterpret_cast<double*>
-                     ((reinterpret_cast<std::ptrdiff_t> (m_real_memory) + 15) & ~ 0xF);   // 16-byte alignment
+            // 64-byte aligned block from the memory pool
+            m_real_memory = static_cast<char*>(hwMemoryPool::Allocate(m_capacity * sizeof(double)));
+            m_real = reinterpret_cast<double*>(m_real_memory);
         }
         catch (std::bad_alloc&)
         {
@@ -5560,9 +5526,9 @@ inline void hwTMatrix<double>::Allocate(DataType dataType)
 
         try
         {
-            m_complex_memory = new char[m_capacity * sizeof(hwTComplex<double>)];
-            m_complex = reinterpret_cast<hwTComplex<double>*>
-                        ((reinterpret_cast<std::ptrdiff_t> (m_complex_memory) + 15) & ~ 0xF);   // 16-byte alignment
+            // 64-byte aligned block from the memory pool
+            m_complex_memory = static_cast<char*>(hwMemoryPool::Allocate(m_capacity * sizeof(hwTComplex<double>)));
+            m_complex = reinterpret_cast<hwTComplex<double>*>(m_complex_memory);
         }
         catch (std::bad_alloc&)
         {
@@ -5631,7 +5597,7 @@ void hwTMatrix<T1, T2>::FreeMemory(char*& pMemory, T1*& pReal)
 {
     if (pMemory)     // aligned memory
     {
-        delete [] pMemory;
+        hwMemoryPool::Free(pMemory);
         pMemory = nullptr;
         pReal = nullptr;
     }
@@ -5648,7 +5614,7 @@ void hwTMatrix<T1, T2>::FreeMemory(char*& pMemory, T2*& pComplex)
 {
     if (pMemory)     // aligned memory
     {
-        delete [] pMemory;
+        hwMemoryPool::Free(pMemory);
         pMemory = nullptr;
         pComplex = nullptr;
     }
@@ -5771,7 +5737,7 @@ hwMathStatus hwTMatrix<T1, T2>::Copy(const hwTMatrix<T1, T2>& source)
         return hwMathStatus(HW_MATH_ERR_NOTALLOWED);
     }
 
-    int newSize = Size();
+    int64_t newSize = Size();
 
     if (newSize > 0)
     {
@@ -5784,6 +5750,28 @@ hwMathStatus hwTMatrix<T1, T2>::Copy(const hwTMatrix<T1, T2>& source)
     return hwMathStatus();
 }
 
+//! Transfer contents from another object
+template<typename T1, typename T2>
+void hwTMatrix<T1, T2>::Transfer(hwTMatrix<T1, T2>& source)
+{
+    Deallocate();
+    m_bits = source.m_bits;
+    m_nRows = source.m_nRows;
+    m_nCols = source.m_nCols;
+    m_capacity = source.m_capacity;
+    m_real_memory = source.m_real_memory;
+    m_complex_memory = source.m_complex_memory;
+    m_real = source.m_real;
+    m_complex = source.m_complex;
+
+    source.m_real_memory = nullptr;
+    source.m_complex_memory = nullptr;
+    source.m_real = nullptr;
+    source.m_complex = nullptr;
+
+    source.MakeEmpty();
+}
+
 //! Copy a real submatrix from another matrix to *this
 template<typename T1, typename T2>
 void hwTMatrix<T1, T2>::CopyBlock(const T1* real, int m, int n, int row1, int row2,
@@ -5796,19 +5784,19 @@ void hwTMatrix<T1, T2>::CopyBlock(const T1* real, int m, int n, int row1, int ro
     // ii and jj are the indices of the first element to which the submatrix will be copied
     int m_max = _min(row1+m_nRows-1-ii, row2);
     int n_max = _min(col1+m_nCols-1-jj, col2);
-    int offset_t;   // target offset
-    int offset_s;   // source offset
-    int numElems;
+    int64_t offset_t;   // target offset
+    int64_t offset_s;   // source offset
+    int64_t numElems;
     int numRows = m_max - row1 + 1;
 
     if (numRows == m && numRows == m_nRows)  // contiguous memory for both source and target
     {
-        numElems = numRows * (n_max-col1+1);
+        numElems = static_cast<int64_t>(numRows) * (n_max-col1+1);
 
         if (numElems)
         {
-            offset_t = jj * m_nRows;
-            offset_s = col1 * m;
+            offset_t = static_cast<int64_t>(jj) * m_nRows;
+            offset_s = static_cast<int64_t>(col1) * m;
             CopyData(m_real + offset_t, numElems, real + offset_s, numElems);
         }
     }
@@ -5818,8 +5806,8 @@ void hwTMatrix<T1, T2>::CopyBlock(const T1* real, int m, int n, int row1, int ro
 
         if (numElems)
         {
-            offset_t = jj * m_nRows + ii;
-            offset_s = col1 * m + row1;
+            offset_t = static_cast<int64_t>(jj) * m_nRows + ii;
+            offset_s = static_cast<int64_t>(col1) * m + row1;
 
             for (int i = col1; i <= n_max; ++i)
             {
@@ -5843,19 +5831,19 @@ void hwTMatrix<T1, T2>::CopyBlock(const T2* cmplx, int m, int n, int row1, int r
     // ii and jj are the indices of the first element to which the submatrix will be copied
     int m_max = _min(row1+m_nRows-1-ii, row2);
     int n_max = _min(col1+m_nCols-1-jj, col2);
-    int offset_t;   // target offset
-    int offset_s;   // source offset
-    int numElems;
+    int64_t offset_t;   // target offset
+    int64_t offset_s;   // source offset
+    int64_t numElems;
     int numRows = m_max - row1 + 1;
 
     if (numRows == m && numRows == m_nRows)  // contiguous memory for both source and target
     {
-        numElems = numRows * (n_max-col1+1);
+        numElems = static_cast<int64_t>(numRows) * (n_max-col1+1);
 
         if (numElems)
         {
-            offset_t = jj * m_nRows;
-            offset_s = col1 * m;
+            offset_t = static_cast<int64_t>(jj) * m_nRows;
+            offset_s = static_cast<int64_t>(col1) * m;
             CopyData(m_complex + offset_t, numElems, cmplx + offset_s, numElems);
         }
     }
@@ -5865,8 +5853,8 @@ void hwTMatrix<T1, T2>::CopyBlock(const T2* cmplx, int m, int n, int row1, int r
 
         if (numElems)
         {
-            offset_t = jj * m_nRows + ii;
-            offset_s = col1 * m + row1;
+            offset_t = static_cast<int64_t>(jj) * m_nRows + ii;
+            offset_s = static_cast<int64_t>(col1) * m + row1;
 
             T2* start_t = m_complex + offset_t;
             T2* start_s = (T2*) cmplx + offset_s;
@@ -5883,7 +5871,7 @@ void hwTMatrix<T1, T2>::CopyBlock(const T2* cmplx, int m, int n, int row1, int r
 
 //! Copy data
 template<typename T1, typename T2>
-void hwTMatrix<T1, T2>::CopyData(void* dest, int arraySize, const void* src, int count)
+void hwTMatrix<T1, T2>::CopyData(void* dest, int64_t arraySize, const void* src, int64_t count)
 {
     // memcpy cannot be used here
     if (m_real)
@@ -5891,7 +5879,7 @@ void hwTMatrix<T1, T2>::CopyData(void* dest, int arraySize, const void* src, int
         T1* destTemp = reinterpret_cast<T1*>(dest);
         const T1* srcTemp = reinterpret_cast<T1*>(const_cast<void *>(src));
         
-        for (int i = 0; i < count; ++i)
+        for (int64_t i = 0; i < count; ++i)
             destTemp[i] = srcTemp[i];
     }
     else if (m_complex)
@@ -5899,7 +5887,7 @@ void hwTMatrix<T1, T2>::CopyData(void* dest, int arraySize, const void* src, int
         T2* destTemp = reinterpret_cast<T2*>(dest);
         const T2* srcTemp = reinterpret_cast<T2*>(const_cast<void *>(src));
         
-        for (int i = 0; i < count; ++i)
+        for (int64_t i = 0; i < count; ++i)
             destTemp[i] = srcTemp[i];
     }
 }
@@ -5908,16 +5896,16 @@ void hwTMatrix<T1, T2>::CopyData(void* dest, int arraySize, const void* src, int
 template<typename T1, typename T2>
 void hwTMatrix<T1, T2>::ZeroBlock(int row1, int row2, int col1, int col2)
 {
-    int numBytes;
+    int64_t numBytes;
     int numRows = row2 - row1 + 1;
 
     if (m_real)
     {
-        T1* start = m_real + (col1 * m_nRows + row1);
+        T1* start = m_real + (static_cast<int64_t>(col1) * m_nRows + row1);
 
         if (numRows == m_nRows)  // contiguous memory
         {
-            numBytes = numRows * (col2-col1+1) * sizeof(T1);
+            numBytes = static_cast<int64_t>(numRows) * (col2-col1+1) * sizeof(T1);
 
             if (numBytes > 0)
                 memset(start, 0, numBytes);
@@ -5939,11 +5927,11 @@ void hwTMatrix<T1, T2>::ZeroBlock(int row1, int row2, int col1, int col2)
 
     if (m_complex)
     {
-        T2* start = m_complex + (col1 * m_nRows + row1);
+        T2* start = m_complex + (static_cast<int64_t>(col1) * m_nRows + row1);
 
         if (numRows == m_nRows)  // contiguous memory
         {
-            numBytes = numRows * (col2-col1+1) * sizeof(T2);
+            numBytes = static_cast<int64_t>(numRows) * (col2-col1+1) * sizeof(T2);
 
             if (numBytes > 0)
                 memset(start, 0, numBytes);
@@ -5963,3 +5951,117 @@ void hwTMatrix<T1, T2>::ZeroBlock(int row1, int row2, int col1, int col2)
         }
     }
 }
+
+//! Transpose an m x n array into dest with cache blocked loops
+template<typename T1, typename T2>
+template<typename T>
+void hwTMatrix<T1, T2>::TransposeData(const T* src, int m, int n, T* dest)
+{
+    // square tiles keep both the rows read from src and the rows written
+    // to dest in cache, which a plain i/j loop cannot do for one of them
+    const int block = 32;
+
+    for (int j0 = 0; j0 < n; j0 += block)
+    {
+        int j1 = _min(j0 + block, n);
+
+        for (int i0 = 0; i0 < m; i0 += block)
+        {
+            int i1 = _min(i0 + block, m);
+
+            for (int j = j0; j < j1; ++j)
+            {
+                const T* col = src + static_cast<int64_t>(j) * m;
+
+                for (int i = i0; i < i1; ++i)
+                    dest[j + static_cast<int64_t>(i) * n] = col[i];
+            }
+        }
+    }
+}
+
+//! Multiply two matrices with cache blocked loops so that (*this) = A * B,
+//! where *this has already been dimensioned
+template<typename T1, typename T2>
+void hwTMatrix<T1, T2>::MultBlocked(const hwTMatrix<T1, T2>& A, const hwTMatrix<T1, T2>& B)
+{
+    // the column oriented j/k/i loop order is blocked over k and i so
+    // that a panel of A remains in cache while each column of B is
+    // applied to it, and the inner loop runs with unit stride
+    const int blockM = 256;
+    const int blockK = 128;
+    int m = A.m_nRows;
+    int n = B.m_nCols;
+    int bm = B.m_nRows;
+
+    if (IsReal())
+        SetElements((T1) 0);
+    else
+        SetElements(T2((T1) 0, (T1) 0));
+
+    for (int k0 = 0; k0 < bm; k0 += blockK)
+    {
+        int k1 = _min(k0 + blockK, bm);
+
+        for (int i0 = 0; i0 < m; i0 += blockM)
+        {
+            int i1 = _min(i0 + blockM, m);
+
+            for (int j = 0; j < n; ++j)
+            {
+                if (A.IsReal() && B.IsReal())
+                {
+                    T1* c_r = m_real + static_cast<int64_t>(j) * m;
+
+                    for (int k = k0; k < k1; ++k)
+                    {
+                        T1 b_r = B.m_real[k + static_cast<int64_t>(j) * bm];
+                        const T1* a_r = A.m_real + static_cast<int64_t>(k) * m;
+
+                        for (int i = i0; i < i1; ++i)
+                            c_r[i] += a_r[i] * b_r;
+                    }
+                }
+                else if (!A.IsReal() && !B.IsReal())
+                {
+                    T2* c_c = m_complex + static_cast<int64_t>(j) * m;
+
+                    for (int k = k0; k < k1; ++k)
+                    {
+                        const T2& b_c = B.m_complex[k + static_cast<int64_t>(j) * bm];
+                        const T2* a_c = A.m_complex + static_cast<int64_t>(k) * m;
+
+                        for (int i = i0; i < i1; ++i)
+                            c_c[i] += a_c[i] * b_c;
+                    }
+                }
+                else if (A.IsReal() && !B.IsReal())
+                {
+                    T2* c_c = m_complex + static_cast<int64_t>(j) * m;
+
+                    for (int k = k0; k < k1; ++k)
+                    {
+                        const T2& b_c = B.m_complex[k + static_cast<int64_t>(j) * bm];
+                        const T1* a_r = A.m_real + static_cast<int64_t>(k) * m;
+
+                        for (int i = i0; i < i1; ++i)
+                            c_c[i] += b_c * a_r[i];
+                    }
+                }
+                else // if (!A.IsReal() && B.IsReal())
+                {
+                    T2* c_c = m_complex + static_cast<int64_t>(j) * m;
+
+                    for (int k = k0; k < k1; ++k)
+                    {
+                        T1 b_r = B.m_real[k + static_cast<int64_t>(j) * bm];
+                        const T2* a_c = A.m_complex + static_cast<int64_t>(k) * m;
+
+                        for (int i = i0; i < i1; ++i)
+                            c_c[i] += a_c[i] * b_r;
+                    }
+                }
+            }
+        }
+    }
+}
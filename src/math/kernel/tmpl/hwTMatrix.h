@@ -17,6 +17,9 @@
 #ifndef _hwTMatrix_h
 #define _hwTMatrix_h
 
+#include <cstdint>
+#include <hwMemoryPool.h>
+
 //! Forward declarations
 class hwMathStatus;
 template < typename T > class hwTComplex;
@@ -65,10 +68,18 @@ public:
     hwTMatrix(int m, int n, void* data, DataType dataType);
     //! Copy constructor
     hwTMatrix(const hwTMatrix<T1, T2>& source);
+    //! Move constructor
+    hwTMatrix(hwTMatrix<T1, T2>&& source);
     //! Destructor
     ~hwTMatrix();
     //! Implement the = operator
     hwTMatrix<T1, T2>& operator=(const hwTMatrix<T1, T2>& rhs);
+    //! Implement the move = operator
+    hwTMatrix<T1, T2>& operator=(hwTMatrix<T1, T2>&& rhs);
+    //! Allocate matrix objects from the memory pool
+    static void* operator new(size_t size) { return hwMemoryPool::Allocate(size); }
+    //! Return matrix objects to the memory pool
+    static void operator delete(void* ptr) { hwMemoryPool::Free(ptr); }
 
     // ****************************************************
     //             Data Type and Ownership
@@ -114,7 +125,7 @@ public:
     //! Return the number of columns
     int N() const { return m_nCols; }
     //! Return the number of elements
-    int Size() const { return m_nCols * m_nRows; }
+    int64_t Size() const { return static_cast<int64_t>(m_nCols) * m_nRows; }
     //! Determine if the matrix is empty
     bool IsEmpty() const { return ((m_real || m_complex) ? false : true); }
     //! Determine if the matrix is a vector
@@ -127,6 +138,10 @@ public:
     bool IsSymmetric(T1 tol = (T1) 0) const;
     //! Determine if the matrix is Hermitian
     bool IsHermitian(T1 tol = (T1) 0) const;
+    //! Determine the number of nonzero diagonals below and above the main diagonal
+    void Bandwidth(int& lower, int& upper) const;
+    //! Determine if band storage of a square matrix is much smaller than the matrix
+    static bool IsNarrowBand(int n, int lower, int upper) { return (2 * lower + upper + 1) * 4 <= n; }
     //! Determine if the matrix contains non-finite elements
     bool IsFinite() const;
     //! Determine if the matrix contains non-finite elements
@@ -143,19 +158,19 @@ public:
     //! Return the T1* data vector pointer
     T1* GetRealData() { return m_real; }
     //! Return a reference to the real vector element at the specified single index
-    T1& operator()(int index) { return m_real[index]; }
+    T1& operator()(int64_t index) { return m_real[index]; }
     //! Return a const reference to the real data element at the specified single index
-    const T1& operator()(int index) const { return m_real[index]; }
+    const T1& operator()(int64_t index) const { return m_real[index]; }
     //! Return a reference to the real matrix element at the specified single index
-    T1& operator()(int index, IndexDir dir);
+    T1& operator()(int64_t index, IndexDir dir);
     //! Return a const reference to the real data element at the specified single index
-    const T1& operator()(int index, IndexDir dir) const;
+    const T1& operator()(int64_t index, IndexDir dir) const;
     //! Return a reference to the real matrix element at the specified index pair
     T1& operator()(int i, int j);
     //! Return a const reference to the real data element at the specified index pair
     const T1& operator()(int i, int j) const;
     //! Set the element at the specified single index to a real value
-    void SetElement(int index, T1 real, IndexDir dir = BY_COL);
+    void SetElement(int64_t index, T1 real, IndexDir dir = BY_COL);
     //! Set the element at the specified index pair to a real value
     void SetElement(int i, int j, T1 real);
     //! Set every matrix element to a specified real value
@@ -170,19 +185,19 @@ public:
     //! Return the T2* data vector pointer
     T2* GetComplexData() { return m_complex; };
     //! Return a reference to the complex vector element at the specified single index
-    T2& z(int index) { return m_complex[index]; }
+    T2& z(int64_t index) { return m_complex[index]; }
     //! Return a const reference to the complex data element at the specified single index
-    const T2& z(int index) const { return m_complex[index]; }
+    const T2& z(int64_t index) const { return m_complex[index]; }
     //! Return a reference to the complex matrix element at the specified single index
-    T2& z(int index, IndexDir dir);
+    T2& z(int64_t index, IndexDir dir);
     //! Return a const reference to the complex data element at the specified single index
-    const T2& z(int index, IndexDir dir) const;
+    const T2& z(int64_t index, IndexDir dir) const;
     //! Return a reference to the complex matrix element at the specified index pair
     T2& z(int i, int j);
     //! Return a const reference to the complex data element at the specified index pair
     const T2& z(int i, int j) const;
     //! Set the element at the specified single index to a complex value
-    void SetElement(int index, T2 cplx, IndexDir dir = BY_COL);
+    void SetElement(int64_t index, T2 cplx, IndexDir dir = BY_COL);
     //! Set the element at the specified index pair to a complex value
     void SetElement(int i, int j, T2 cplx);
     //! Set every matrix element to a specified complex value
@@ -355,6 +370,9 @@ public:
     hwMathStatus SubtrEquals(const T2& cmplx);
     //! Multiply two matrices
     hwMathStatus Mult(const hwTMatrix<T1, T2>& A, const hwTMatrix<T1, T2>& B);
+    //! Multiply two matrices, using either one transposed, op(A) * op(B)
+    hwMathStatus MultTrans(const hwTMatrix<T1, T2>& A, bool transA,
+                           const hwTMatrix<T1, T2>& B, bool transB);
     //! Multiply a matrix and a real number
     hwMathStatus Mult(const hwTMatrix<T1, T2>& A, T1 real);
     //! Multiply a matrix and a complex number
@@ -408,19 +426,32 @@ public:
     //! Solve symmetric positive definite linear system AX=B with Cholesky decomposition,
     //! where X = *this
     hwMathStatus LSolveSPD(const hwTMatrix<double>& A, const hwTMatrix<double>& B);
-    //! Solve tridigonal linear system AX=B with LU decomposition, where X = *this
+    //! Solve tridigonal linear system AX=B with LU decomposition, where X = *this.
+    //! The structured solvers below estimate the reciprocal 1-norm condition
+    //! number of A when rcond is not null.
     hwMathStatus LSolveT(const hwTMatrix<double>& D, const hwTMatrix<double>& DL,
-                         const hwTMatrix<double>& DU, const hwTMatrix<double>& B);
+                         const hwTMatrix<double>& DU, const hwTMatrix<double>& B,
+                         double* rcond = nullptr);
     //! Solve band linear system AX=B with LU decomposition, where X = *this
     hwMathStatus LSolveB(const hwTMatrix<double>& A, int kl, int ku,
-                         const hwTMatrix<double>& B);
+                         const hwTMatrix<double>& B, double* rcond = nullptr);
     //! Solve SPD tridigonal linear system AX=B with Cholesky decomposition, where X = *this
     hwMathStatus LSolveSPDT(const hwTMatrix<double>& D, const hwTMatrix<double>& E,
-                            const hwTMatrix<double>& B);
+                            const hwTMatrix<double>& B, double* rcond = nullptr);
     //! Solve SPD band linear system AX=B with Cholesky decomposition, where X = *this
-    hwMathStatus LSolveSPDB(const hwTMatrix<double>& A, int kd, const hwTMatrix<double>& B);
+    hwMathStatus LSolveSPDB(const hwTMatrix<double>& A, int kd, const hwTMatrix<double>& B,
+                            double* rcond = nullptr);
     //! Solve symmetric indefinite linear system AX=B, where X = *this
-    hwMathStatus LSolveSI(const hwTMatrix<double>& A, const hwTMatrix<double>& B);
+    hwMathStatus LSolveSI(const hwTMatrix<double>& A, const hwTMatrix<double>& B,
+                          double* rcond = nullptr);
+    //! Solve square linear system AX=B with a solver chosen from the structure
+    //! of A, where X = *this
+    hwMathStatus LSolveStructured(const hwTMatrix<double>& A, const hwTMatrix<double>& B);
+    //! Factor square matrix A for repeated solves, where the factors are *this
+    hwMathStatus Factor(const hwTMatrix<double>& A, hwTMatrix<int>& pivots);
+    //! Solve linear system AX=B with the factors of A from Factor, where X = *this
+    hwMathStatus SolveFactored(const hwTMatrix<double>& F, const hwTMatrix<int>& pivots,
+                               const hwTMatrix<double>& B);
     //! Solve linear system AX=B with QR decomposition, where X = *this
     hwMathStatus QRSolve(const hwTMatrix<double>& A, const hwTMatrix<double>& B);
     //! Solve real linear system AX=B with SVD, where X = *this
@@ -530,14 +561,23 @@ public:
     hwMathStatus Cross(const hwTMatrix<T1, T2>& A, const hwTMatrix<T1, T2>& B);
     //! Linear convolution of two vectors in the time domain
     hwMathStatus ConvLin(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y);
+    //! Elements start to start+count-1 of the linear convolution of two vectors
+    hwMathStatus ConvLin(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y, int start, int count);
     //! Linear correlation of two vectors in the time domain
     hwMathStatus CorrLin(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y);
     //! Linear correlation of matrix columns in the time domain
     hwMathStatus CorrLin(const hwTMatrix<T1, T2>& X);
     //! 2D convolution of two matrices
     hwMathStatus Conv2D(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y);
+    //! The m x n block at (top, left) of the 2D convolution of two matrices
+    hwMathStatus Conv2D(const hwTMatrix<T1, T2>& X, const hwTMatrix<T1, T2>& Y,
+                        int top, int left, int m, int n);
     //! 2D convolution of a matrix with a column vector and a row vector
     hwMathStatus Conv2D(const hwTMatrix<T1, T2>& col, const hwTMatrix<T1, T2>& row, const hwTMatrix<T1, T2>& X);
+    //! The m x n block at (top, left) of the 2D convolution of a matrix with a
+    //! column vector and a row vector
+    hwMathStatus Conv2D(const hwTMatrix<T1, T2>& col, const hwTMatrix<T1, T2>& row, const hwTMatrix<T1, T2>& X,
+                        int top, int left, int m, int n);
 
     // ****************************************************
     //           Magnitude / Phase Operations
@@ -601,8 +641,8 @@ private:
     int m_nRows;
     //! The number of columns
     int m_nCols;
-    //! Allocated memory capacity (utilized memory may be smaller)
-    int m_capacity;
+    //! Allocated memory capacity in elements (utilized memory may be smaller)
+    int64_t m_capacity;
     //! Pointer to unaligned memory for new T1
     char* m_real_memory;
     //! Pointer to unaligned memory for new T2
@@ -633,6 +673,8 @@ private:
     void MakeEmpty();
     //! Copy matrix data from a source
     hwMathStatus Copy(const hwTMatrix<T1, T2>& source);
+    //! Transfer contents from another object
+    void Transfer(hwTMatrix<T1, T2>& source);
     //! Copy a real submatrix from another matrix to *this
     void CopyBlock(const T1* real, int m, int n, int row1, int row2,
                    int col1, int col2, int ii, int jj);
@@ -640,9 +682,17 @@ private:
     void CopyBlock(const T2* cmplx, int m, int n, int row1, int row2,
                    int col1, int col2, int ii, int jj);
     //! Copy data
-    void CopyData(void* dest, int arraySize, const void* src, int count);
+    void CopyData(void* dest, int64_t arraySize, const void* src, int64_t count);
     //! Set a submatrix of *this to zeros
     void ZeroBlock(int row1, int row2, int col1, int col2);
+    //! Multiply two matrices with cache blocked loops, with *this already dimensioned
+    void MultBlocked(const hwTMatrix<T1, T2>& A, const hwTMatrix<T1, T2>& B);
+    //! Transpose an m x n array into dest with cache blocked loops
+    template <typename T>
+    static void TransposeData(const T* src, int m, int n, T* dest);
+    //! Point to A, or to a complex copy of A in temp if A is real
+    static hwMathStatus ComplexOperand(const hwTMatrix<T1, T2>& A, hwTMatrix<T1, T2>& temp,
+                                       const hwTMatrix<T1, T2>*& operand);
 
     // ****************************************************
     //         Decomposition and Solver Functions
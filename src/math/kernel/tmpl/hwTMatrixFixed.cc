@@ -0,0 +1,370 @@
+/**
+* @file hwTMatrixFixed.cc
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  hwTMatrixFixed template function implementation file
+//
+//:---------------------------------------------------------------------------
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <hwThreadPool.h>
+
+// ****************************************************
+//                 Single Matrix Kernels
+// ****************************************************
+
+//! Return the determinant
+template<typename T1, int N>
+T1 hwTMatrixFixed<T1, N>::Determinant(const T1* A)
+{
+    if (N == 1)
+        return A[0];
+
+    if (N == 2)
+        return A[0] * A[3] - A[2] * A[1];
+
+    if (N == 3)
+    {
+        return A[0] * (A[4] * A[8] - A[7] * A[5])
+             - A[3] * (A[1] * A[8] - A[7] * A[2])
+             + A[6] * (A[1] * A[5] - A[4] * A[2]);
+    }
+
+    // LU decomposition with partial pivoting
+    T1 lu[N * N];
+    T1 det = (T1) 1;
+
+    for (int i = 0; i < N * N; ++i)
+        lu[i] = A[i];
+
+    for (int k = 0; k < N; ++k)
+    {
+        int p = k;
+        T1 amax = std::abs(lu[k * N + k]);
+
+        for (int i = k + 1; i < N; ++i)
+        {
+            if (std::abs(lu[k * N + i]) > amax)
+            {
+                amax = std::abs(lu[k * N + i]);
+                p = i;
+            }
+        }
+
+        if (amax == (T1) 0)
+            return (T1) 0;
+
+        if (p != k)
+        {
+            for (int j = k; j < N; ++j)
+                std::swap(lu[j * N + k], lu[j * N + p]);
+
+            det = -det;
+        }
+
+        T1 pivot = lu[k * N + k];
+        det *= pivot;
+
+        for (int i = k + 1; i < N; ++i)
+        {
+            T1 factor = lu[k * N + i] / pivot;
+
+            for (int j = k + 1; j < N; ++j)
+                lu[j * N + i] -= factor * lu[j * N + k];
+        }
+    }
+
+    return det;
+}
+
+//! Compute the inverse, returning false if the matrix is singular
+template<typename T1, int N>
+bool hwTMatrixFixed<T1, N>::Inverse(const T1* A, T1* inv)
+{
+    // Gauss-Jordan elimination with partial pivoting
+    T1 a[N * N];
+
+    for (int i = 0; i < N * N; ++i)
+    {
+        a[i] = A[i];
+        inv[i] = (T1) 0;
+    }
+
+    for (int i = 0; i < N; ++i)
+        inv[i * N + i] = (T1) 1;
+
+    for (int k = 0; k < N; ++k)
+    {
+        int p = k;
+        T1 amax = std::abs(a[k * N + k]);
+
+        for (int i = k + 1; i < N; ++i)
+        {
+            if (std::abs(a[k * N + i]) > amax)
+            {
+                amax = std::abs(a[k * N + i]);
+                p = i;
+            }
+        }
+
+        if (amax == (T1) 0)
+            return false;
+
+        if (p != k)
+        {
+            for (int j = 0; j < N; ++j)
+            {
+                std::swap(a[j * N + k], a[j * N + p]);
+                std::swap(inv[j * N + k], inv[j * N + p]);
+            }
+        }
+
+        T1 scale = (T1) 1 / a[k * N + k];
+
+        for (int j = 0; j < N; ++j)
+        {
+            a[j * N + k] *= scale;
+            inv[j * N + k] *= scale;
+        }
+
+        for (int i = 0; i < N; ++i)
+        {
+            T1 factor = a[k * N + i];
+
+            if (i == k || factor == (T1) 0)
+                continue;
+
+            for (int j = 0; j < N; ++j)
+            {
+                a[j * N + i] -= factor * a[j * N + k];
+                inv[j * N + i] -= factor * inv[j * N + k];
+            }
+        }
+    }
+
+    return true;
+}
+
+//! Compute the eigenvalues in ascending order, and the eigenvectors when
+//! vectors is not NULL, of a symmetric matrix
+template<typename T1, int N>
+void hwTMatrixFixed<T1, N>::EigenSym(const T1* A, T1* values, T1* vectors)
+{
+    // cyclic Jacobi rotations, which converge quadratically and keep small
+    // eigenvalues accurate
+    T1 a[N * N];
+    T1 v[N * N];
+    T1 amax = (T1) 0;
+
+    for (int i = 0; i < N * N; ++i)
+    {
+        if (std::abs(A[i]) > amax)
+            amax = std::abs(A[i]);
+
+        v[i] = (T1) 0;
+    }
+
+    for (int i = 0; i < N; ++i)
+        v[i * N + i] = (T1) 1;
+
+    // work on A / max|a(i,j)| so that the squared norms below can neither
+    // overflow nor underflow, and scale the eigenvalues back at the end
+    T1 scale = (amax > (T1) 0 && amax < std::numeric_limits<T1>::infinity()) ? amax : (T1) 1;
+    T1 norm = (T1) 0;
+
+    for (int i = 0; i < N * N; ++i)
+    {
+        a[i] = A[i] / scale;
+        norm += a[i] * a[i];
+    }
+
+    T1 tol = std::numeric_limits<T1>::epsilon() * std::numeric_limits<T1>::epsilon() * norm;
+
+    for (int sweep = 0; sweep < 50; ++sweep)
+    {
+        T1 off = (T1) 0;
+
+        for (int q = 1; q < N; ++q)
+        {
+            for (int p = 0; p < q; ++p)
+                off += a[q * N + p] * a[q * N + p];
+        }
+
+        if (off <= tol)
+            break;
+
+        for (int q = 1; q < N; ++q)
+        {
+            for (int p = 0; p < q; ++p)
+            {
+                T1 apq = a[q * N + p];
+
+                if (apq == (T1) 0)
+                    continue;
+
+                // the rotation that zeroes a(p,q)
+                T1 tau = (a[q * N + q] - a[p * N + p]) / (2 * apq);
+                T1 t = (tau >= (T1) 0 ? (T1) 1 : (T1) -1) / (std::abs(tau) + std::sqrt((T1) 1 + tau * tau));
+                T1 c = (T1) 1 / std::sqrt((T1) 1 + t * t);
+                T1 s = t * c;
+
+                // update the symmetric matrix in place, so that only the rows
+                // and columns p and q change
+                a[p * N + p] -= t * apq;
+                a[q * N + q] += t * apq;
+                a[q * N + p] = (T1) 0;
+                a[p * N + q] = (T1) 0;
+
+                for (int k = 0; k < N; ++k)
+                {
+                    if (k == p || k == q)
+                        continue;
+
+                    T1 akp = a[p * N + k];
+                    T1 akq = a[q * N + k];
+                    a[p * N + k] = a[k * N + p] = c * akp - s * akq;
+                    a[q * N + k] = a[k * N + q] = s * akp + c * akq;
+                }
+
+                if (!vectors)
+                    continue;
+
+                for (int k = 0; k < N; ++k)
+                {
+                    T1 vkp = v[p * N + k];
+                    T1 vkq = v[q * N + k];
+                    v[p * N + k] = c * vkp - s * vkq;
+                    v[q * N + k] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    int order[N];
+
+    for (int i = 0; i < N; ++i)
+    {
+        T1 d = a[i * N + i];
+        int j = i;
+
+        for (; j > 0 && a[order[j - 1] * N + order[j - 1]] > d; --j)
+            order[j] = order[j - 1];
+
+        order[j] = i;
+    }
+
+    for (int i = 0; i < N; ++i)
+    {
+        values[i] = a[order[i] * N + order[i]] * scale;
+
+        if (vectors)
+        {
+            for (int k = 0; k < N; ++k)
+                vectors[i * N + k] = v[order[i] * N + k];
+        }
+    }
+}
+
+//! Determine if the matrix is symmetric
+template<typename T1, int N>
+bool hwTMatrixFixed<T1, N>::IsSymmetric(const T1* A)
+{
+    for (int j = 1; j < N; ++j)
+    {
+        for (int i = 0; i < j; ++i)
+        {
+            if (A[j * N + i] != A[i * N + j])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// ****************************************************
+//                     Batch Kernels
+// ****************************************************
+
+//! Compute the determinants of count matrices
+template<typename T1, int N>
+void hwTMatrixFixed<T1, N>::Determinant(const T1* A, int count, T1* det)
+{
+    hwThreadPool::ParallelFor(count, [=](int64_t begin, int64_t end)
+    {
+        for (int64_t k = begin; k < end; ++k)
+            det[k] = Determinant(A + k * N * N);
+    }, N * N);
+}
+
+//! Compute the inverses of count matrices, returning the number that are
+//! singular, whose inverses are set to Inf
+template<typename T1, int N>
+int hwTMatrixFixed<T1, N>::Inverse(const T1* A, int count, T1* inv)
+{
+    std::atomic<int> numSingular(0);
+
+    hwThreadPool::ParallelFor(count, [=, &numSingular](int64_t begin, int64_t end)
+    {
+        int singular = 0;
+
+        for (int64_t k = begin; k < end; ++k)
+        {
+            T1* page = inv + k * N * N;
+
+            if (!Inverse(A + k * N * N, page))
+            {
+                for (int i = 0; i < N * N; ++i)
+                    page[i] = std::numeric_limits<T1>::infinity();
+
+                ++singular;
+            }
+        }
+
+        numSingular += singular;
+    }, N * N * N);
+
+    return numSingular;
+}
+
+//! Compute the eigenvalues, and the eigenvectors when vectors is not NULL, of
+//! count symmetric matrices
+template<typename T1, int N>
+void hwTMatrixFixed<T1, N>::EigenSym(const T1* A, int count, T1* values, T1* vectors)
+{
+    hwThreadPool::ParallelFor(count, [=](int64_t begin, int64_t end)
+    {
+        for (int64_t k = begin; k < end; ++k)
+            EigenSym(A + k * N * N, values + k * N, vectors ? vectors + k * N * N : NULL);
+    }, 10 * N * N * N);
+}
+
+//! Determine if all of count matrices are symmetric
+template<typename T1, int N>
+bool hwTMatrixFixed<T1, N>::IsSymmetric(const T1* A, int count)
+{
+    for (int k = 0; k < count; ++k)
+    {
+        if (!IsSymmetric(A + k * N * N))
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,69 @@
+/**
+* @file hwTMatrixFixed.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+#ifndef _hwTMatrixFixed_h
+#define _hwTMatrixFixed_h
+
+// -------------------------------------------------------------------
+//! hwTMatrixFixed holds kernels for real N x N matrices, where N is a
+//! compile time constant. The matrices are column major arrays of N*N
+//! elements with no object wrapper, status or heap workspace, so the
+//! loops unroll and the kernels can be applied to millions of small
+//! matrices.
+//!
+//! The batch functions take count matrices stored one after another,
+//! which is the layout of the pages of an N x N x count array, and
+//! split the pages across the shared thread pool.
+// -------------------------------------------------------------------
+
+//! hwTMatrixFixed class definition
+template <typename T1, int N> class hwTMatrixFixed
+{
+public:
+    // ****************************************************
+    //                 Single Matrix Kernels
+    // ****************************************************
+
+    //! Return the determinant
+    static T1 Determinant(const T1* A);
+    //! Compute the inverse, returning false if the matrix is singular
+    static bool Inverse(const T1* A, T1* inv);
+    //! Compute the eigenvalues in ascending order, and the eigenvectors
+    //! when vectors is not NULL, of a symmetric matrix
+    static void EigenSym(const T1* A, T1* values, T1* vectors);
+    //! Determine if the matrix is symmetric
+    static bool IsSymmetric(const T1* A);
+
+    // ****************************************************
+    //                     Batch Kernels
+    // ****************************************************
+
+    //! Compute the determinants of count matrices
+    static void Determinant(const T1* A, int count, T1* det);
+    //! Compute the inverses of count matrices, returning the number that are
+    //! singular, whose inverses are set to Inf
+    static int Inverse(const T1* A, int count, T1* inv);
+    //! Compute the eigenvalues, and the eigenvectors when vectors is not
+    //! NULL, of count symmetric matrices
+    static void EigenSym(const T1* A, int count, T1* values, T1* vectors);
+    //! Determine if all of count matrices are symmetric
+    static bool IsSymmetric(const T1* A, int count);
+};
+
+//! template implementation file
+#include <tmpl/hwTMatrixFixed.cc>
+
+#endif // _hwTMatrixFixed_h
@@ -23,6 +23,7 @@
 //:---------------------------------------------------------------------------
 
 #include <hwComplex.h>
+#include <hwSolverPath.h>
 #include <complex>
 typedef std::complex<double> complexD;
 
@@ -32,145 +33,27 @@ typedef std::complex<double> complexD;
 #ifndef _BLAS_LAPACK_h
 #define _BLAS_LAPACK_h
 
-// y = x
-extern "C" void dcopy_(int* N, double* DX, int* INCX, double* DY, int* INCY);
-extern "C" void zcopy_(int* N, complexD* DX, int* INCX, complexD* DY, int* INCY);
-// y = ay
-extern "C" void dscal_(int* N, double* DA, double* DX, int* INCX);
-extern "C" void zscal_(int* N, complexD* DA, complexD* DX, int* INCX);
-// y = ax + y
-extern "C" void daxpy_(int* N, double* DA, double* DX, int* INCX, double* DY, int* INCY);
-extern "C" void zaxpy_(int* N, complexD* DA, complexD* DX, int* INCX, complexD* DY, int* INCY);
-// C = alpha*op( A )*op( B ) + beta*C
-extern "C" void dgemm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
-                       double* ALPHA, double* A, int* LDA, double* B, int* LDB,
-                       double* BETA, double* C, int* LDC);
-extern "C" void zgemm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
-                       complexD* ALPHA, complexD* A, int* LDA, complexD* B,
-                       int* LDB, complexD* BETA, complexD* C, int* LDC);
-// Dot(X,Y)
-extern "C" double ddot_(int* N, double* DX, int* INCX, double* DY, int* INCY);
-extern "C" void zdotc_(complexD* dotc, int* N, complexD* DX, int* INCX, complexD* DY, int* INCY);
-// LU decomposition
-extern "C" void dgetrf_(int* M, int* N, double* A, int* LDA, int* IPIV, int* INFO);
-extern "C" void zgetrf_(int* M, int* N, complexD* A, int* LDA, int* IPIV, int* INFO);
-// Matrix inversion
-extern "C" void dgetri_(int* N, double* A, int* LDA, int* IPIV, double* WORK, int* LWORK, int* INFO);
-extern "C" void zgetri_(int* N, complexD* A, int* LDA, int* IPIV, complexD* WORK, int* LWORK, int* INFO);
-// Solve AX=B via LU
-extern "C" void dgesv_(int* N, int* NRHS, double* A, int* LDA, int* IPIV,
-                       double* B, int* LDB, int* INFO);
-extern "C" void zgesv_(int* N, int* NRHS, complexD* A, int* LDA, int* IPIV,
-                       complexD* B, int* LDB, int* INFO);
-// Solve AX=B via LU for triangular A
-extern "C" void dgtsv_(int* N, int* NRHS, double* DL, double* D,
-                       double* DU, double* B, int* LDB, int* INFO);
-// Solve AX=B via LU for band A
-extern "C" void dgbsv_(int* N, int* KL, int* KU, int* NRHS, double* AB,
-                       int* LDAB, int* IPIV, double* B, int* LDB, int* INFO);
-// Solve AX=B via Cholesky for SPD A
-extern "C" void dposv_(char* UPLO, int* N, int* NRHS, double* A, int* LDA, double* B,
-                       int* LDB, int* INFO);
-// Solve AX=B via Cholesky for SPD triangular A
-extern "C" void dptsv_(int* N, int* NRHS, double* D, double* E, double* B,
-                       int* LDB, int* INFO);
-// Solve AX=B via Cholesky for SPD BAND A
-extern "C" void dpbsv_(char* UPLO, int* N, int* KD, int* NRHS, double* AB,
-                       int* LDAB, double* B, int* LDB, int* INFO);
-// Solve AX=B for symmetric indefinite A
-extern "C" void dsysv_(char* UPLO, int* N, int* NRHS, double* A, int* LDA,
-                       int* IPIV, double* B, int* LDB, double* WORK,
-                       int* LWORK, int* INFO);
-// Eigen decomposition
-extern "C" void dsyev_(char* JOBZ, char* UPLO, int* N, double* A, int* LDA, double* W,
-                       double* WORK, int* LWORK, int* INFO);
-extern "C" void dgeevx_(char* balanc, char* jobvl, char* jobvr, char* sense, int* n,
-                        double* a, int* lda, double* wr ,double* wi, double* vl,
-                        int* ldvl, double* vr, int* ldvr, int* ilo, int* ihi,
-                        double* scale, double* abnrm, double* rconde, double* rcondv,
-                        double* work, int* lwork, int* iwork, int* info);
-extern "C" void zheev_(char* jobz, char* uplo, int* n, complexD* a, int* lda, double* w,
-                       complexD* work, int* lwork, double* rwork, int* info);
-extern "C" void zgeevx_(char* balanc, char* jobvl, char* jobvr, char* sense, int* n,
-                        complexD* a, int* lda, complexD* w, complexD* vl, int* ldvl,
-                        complexD* vr, int* ldvr, int* ilo, int* ihi, double* scale,
-                        double* abnrm, double* rconde, double* rcondv, complexD* work,
-                        int* lwork, double* rwork, int* info);
-extern "C" void dstev_(char* JOBZ, int* N, double* D, double* E, double* Z,
-                       int* LDZ, double* WORK, int* INFO);
-extern "C" void dsbev_(char* JOBZ, char* UPLO, int* N, int* KD, double* AB,
-                       int* LDAB, double* W, double* Z, int* LDZ,
-                       double* WORK, int* INFO);
-//! Balance a matrix
-extern "C" void dgebal_(char* job, int* n, double* a, int* lda, int* ilo, int* ihi,
-                        double* scale, int* info);
-extern "C" void zgebal_(char* job, int* n, complexD* a, int* lda, int* ilo, int* ihi,
-                        double* scale, int* info);
-//! Generalized Eigen decomposition
-extern "C" void dsygv_(int* itype, char* jobz, char* uplo ,int* n, double* a, int* lda,
-                       double* b, int* ldb, double* w, double* work, int* lwork, int* info);
-extern "C" void dggev_(char* jobvl, char* jobvr ,int* n, double* a, int* lda, double* b,
-                       int* ldb, double* alphar, double* alphai, double* beta, double* vl,
-                       int* ldvl, double* vr, int* ldvr, double* work, int* lwork, int* info);
-extern "C" void zhegv_(int* itype, char* jobz, char* uplo, int* n, complexD* a, int* lda,
-                       complexD* b, int* ldb, double* w, complexD* work, int* lwork,
-                       double* rwork, int* info);
-extern "C" void zggev_(char* jobvl, char* jobvr, int* n, complexD* a, int* lda, complexD* b,
-                       int* ldb, complexD* alpha, complexD* beta, complexD* vl, int* ldvl,
-                       complexD* vr, int* ldvr, complexD* work, int* lwork, double* rwork,
-                       int* info);
-// Cholesky decomposition of SPD matrix
-extern "C" void dpotrf_(char* UPLO, int* N, double* A, int* LDA, int* INFO);
-// Singular value decomposition
-extern "C" void dgesvd_(char* JOBU, char* JOBVT, int* M, int* N, double* A, int* LDA, double* S, double* U,
-                        int* LDU, double* VT, int* LDVT, double* WORK, int* LWORK, int* INFO);
-extern "C" void zgesvd_(char *jobu, char *jobvt, int *m, int *n, complexD *a, int *lda, double *s, complexD *u,
-                        int *ldu, complexD *vt, int *ldvt, complexD *work, int *lwork, double *rwork, int *info);
-extern "C" void dgesdd_(char* JOBZ, int* M, int* N, double* A, int* LDA, double* S, double* U,
-                        int* LDU, double* VT, int* LDVT, double* WORK, int* LWORK, int* INFO);
-// QR decomposition
-extern "C" void dgeqrf_(int* M, int* N, double* A, int* LDA, double* TAU, double* WORK,
-                        int* LWORK, int* INFO);
-extern "C" void dorgqr_(int* M, int* N, int* K, double* A, int* LDA, double* TAU,
-                        double* WORK, int* LWORK, int* INFO);
-extern "C" void zgeqrf_(int* M, int* N, complexD* A, int* LDA, complexD* TAU, complexD* WORK,
-                        int* LWORK, int* INFO);
-extern "C" void zungqr_(int* M, int* N, int* K, complexD* A, int* LDA, complexD* TAU,
-                        complexD* WORK, int* LWORK, int* INFO);
-// Schur decomposition
-extern "C" void dgees_(char* jobvs, char* sort, void* select, int* n, double* a, int* lda, int* sdim,
-                       double* wr, double* wi, double* vs, int* ldvs, double* work ,int* lwork,
-                       void* bwork, int* info);
-extern "C" void zgees_(char* jobvs, char* sort, void* select, int* n, complexD* a, int* lda,
-                       int* sdim, complexD* w, complexD* vs, int* ldvs, complexD* work,
-                       int* lwork, double* rwork, void* bwork, int* info);
-// Solve AX=B via QR
-//extern "C" void dgels_(char* TRANS, int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB,
-//                       double* WORK, int* LWORK, int* INFO);
-//extern "C" void zgels_(char* TRANS, int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB,
-//                       complexD* WORK, int* LWORK, int* INFO);
-extern "C" void dgelsy_(int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, int* JPVT,
-                        double* RCOND, int* RANK, double* WORK, int* LWORK, int* INFO);
-extern "C" void zgelsy_(int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB, int* JPVT,
-                        double* RCOND, int* RANK, complexD* WORK, int* LWORK, double* RWORK, int* INFO);
-// Solve AX=B via SVD
-extern "C" void dgelss_(int* M, int* N, int* NRHS, double* A, int* LDA, double* B, int* LDB, double* S,
-                        double* RCOND, int* RANK, double* WORK, int* LWORK, int* INFO);
-extern "C" void zgelss_(int* M, int* N, int* NRHS, complexD* A, int* LDA, complexD* B, int* LDB, double* S,
-                        double* RCOND, int* RANK, complexD* WORK, int* LWORK, double* RWORK, int* INFO);
-// Condition number
-extern "C" void dgecon_(char* NORM, int* N, double* A, int* LDA, double* ANORM, double* RCOND,
-                        double* WORK, int* IWORK, int* INFO);
-extern "C" void zgecon_(char* norm, int* n, complexD* a, int* lda, double* anorm, double* rcond,
-                        complexD* work, double* rwork, int* info);
-// Matrix norm
-extern "C" double dlange_(char* norm, int* m, int* n, double* a, int* lda, double* work);
-extern "C" double zlange_(char* norm, int* m, int* n, complexD* a, int* lda, double* work);
-// Vector L2 norm
-extern "C" double dnrm2_(int* N,double* X, int* INCX);
+#include <hwBlasBackend.h>
 
 #endif // _BLAS_LAPACK_h
 
+// Matrix products with no more multiplications than this are computed
+// without BLAS
+static const int MULT_SMALL_SIZE = 4096;
+
+// Level 1 BLAS counts are ints, so longer arrays are processed in blocks
+// of this many elements. Half the int range leaves room for the doubled
+// counts used on interleaved complex data.
+static const int64_t BLAS_BLOCK_SIZE = std::numeric_limits<int>::max() / 2;
+
+//! Call func(offset, count) on consecutive blocks that cover n elements
+template<typename Func>
+static void BlasBlocks(int64_t n, Func func)
+{
+    for (int64_t offset = 0; offset < n; offset += BLAS_BLOCK_SIZE)
+        func(offset, static_cast<int>(_min(n - offset, BLAS_BLOCK_SIZE)));
+}
+
 //*******************************************************************
 //           hwTMatrix<double> private implementations
 //*******************************************************************
@@ -179,14 +62,17 @@ extern "C" double dnrm2_(int* N,double* X, int* INCX);
 
 //! Copy data
 template<>
-inline void hwTMatrix<double>::CopyData(void* dest, int arraySize, const void* src, int count)
+inline void hwTMatrix<double>::CopyData(void* dest, int64_t arraySize, const void* src, int64_t count)
 {
     int inc = 1;
 
-    if (IsReal())
-        dcopy_((int*) &count, (double*) src, &inc, (double*) dest, &inc);
-    else
-        zcopy_((int*) &count, (complexD*) src, &inc, (complexD*) dest, &inc);
+    BlasBlocks(count, [&](int64_t k, int n)
+    {
+        if (IsReal())
+            hwBlas::dcopy_(&n, (double*) src + k, &inc, (double*) dest + k, &inc);
+        else
+            hwBlas::zcopy_(&n, (complexD*) src + k, &inc, (complexD*) dest + k, &inc);
+    });
 }
 
 //! Real LU decomposition (PA = LU)
@@ -263,7 +149,7 @@ inline hwMathStatus hwTMatrix<double>::RealLU(hwTMatrix<double>& L, hwTMatrix<do
             return status(HW_MATH_ERR_ALLOCFAILED);
         }
 
-        dgetrf_(&m, &n, a, &lda, ipiv, &info); 
+        hwBlas::dgetrf_(&m, &n, a, &lda, ipiv, &info); 
 
         if (info != 0)
             status(HW_MATH_WARN_SINGMATRIX, 1);
@@ -401,7 +287,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexLU(hwTMatrix<double>& L, hwTMatrix
             return status(HW_MATH_ERR_ALLOCFAILED);
         }
 
-        zgetrf_(&m, &n, a, &lda, ipiv, &info); 
+        hwBlas::zgetrf_(&m, &n, a, &lda, ipiv, &info); 
 
         if (info != 0)
             status(HW_MATH_WARN_SINGMATRIX, 1);
@@ -554,7 +440,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompReal(bool balance, hwTMatrix<d
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // workspace query
-    dgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dWR, dWI,
+    hwBlas::dgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dWR, dWI,
             VL, &LDVL, dVR, &LDVR, &ILO, &IHI, dSCALE, &ABNRM,
             dRCONDE, dRCONDV, &WORKSZE, &LWORK, iIWORK, &INFO);
 
@@ -571,7 +457,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompReal(bool balance, hwTMatrix<d
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // decompose the matrix
-    dgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dWR, dWI,
+    hwBlas::dgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dWR, dWI,
             VL, &LDVL, dVR, &LDVR, &ILO, &IHI, dSCALE, &ABNRM,
             dRCONDE, dRCONDV, dWORK, &LWORK, iIWORK, &INFO);
 
@@ -741,7 +627,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompComplex(bool balance, hwTMatri
         BALANC = 'B';
 
     // workspace query
-    zgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dW,
+    hwBlas::zgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dW,
             VL, &LDVL, dVR, &LDVR, &ILO, &IHI, dSCALE, &ABNRM,
             dRCONDE, dRCONDV, dWZ, &LWORK, dRWORK, &INFO);
 
@@ -758,7 +644,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompComplex(bool balance, hwTMatri
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // decompose the matrix
-    zgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dW,
+    hwBlas::zgeevx_(&BALANC, &JOBVL, &JOBVR, &SENSE, &n, dA, &LDA, dW,
             VL, &LDVL, dVR, &LDVR, &ILO, &IHI, dSCALE, &ABNRM,
             dRCONDE, dRCONDV, dWORK, &LWORK, dRWORK, &INFO);
 
@@ -801,7 +687,7 @@ inline hwMathStatus hwTMatrix<double>::BalanceReal(bool noperm, hwTMatrix<double
     if (!dB || !dSCALE)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    dgebal_(&JOB, &n, dB, &n, &ILO, &IHI, dSCALE, &INFO);
+    hwBlas::dgebal_(&JOB, &n, dB, &n, &ILO, &IHI, dSCALE, &INFO);
 
     if (INFO < 0)
         return status(HW_MATH_ERR_DECOMPFAIL);
@@ -888,7 +774,7 @@ inline hwMathStatus hwTMatrix<double>::BalanceComplex(bool noperm, hwTMatrix<dou
     if (!dB || !dSCALE)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    zgebal_(&JOB, &n, dB, &n, &ILO, &IHI, dSCALE, &INFO);
+    hwBlas::zgebal_(&JOB, &n, dB, &n, &ILO, &IHI, dSCALE, &INFO);
 
     if (INFO < 0)
         return hwMathStatus(HW_MATH_ERR_DECOMPFAIL);
@@ -993,7 +879,7 @@ inline hwMathStatus hwTMatrix<double>::GeneralizedEigenDecompReal(const hwTMatri
     if (!dA || !dB || !dVR || !dALPHAR || !dALPHAI || !dBeta)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    dggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHAR, dALPHAI,
+    hwBlas::dggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHAR, dALPHAI,
            dBeta, VL, &LDVL, dVR, &LDVR, &WORKSZE, &LWORK, &INFO);
 
     if (INFO < 0)
@@ -1007,7 +893,7 @@ inline hwMathStatus hwTMatrix<double>::GeneralizedEigenDecompReal(const hwTMatri
     if (!dW)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    dggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHAR, dALPHAI,
+    hwBlas::dggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHAR, dALPHAI,
            dBeta, VL, &LDVL, dVR, &LDVR, dW, &LWORK, &INFO);
 
     if (INFO < 0)
@@ -1080,7 +966,7 @@ inline hwMathStatus hwTMatrix<double>::GeneralizedEigenDecompComplex(const hwTMa
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // workspace query
-    zggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHA, dBETA,
+    hwBlas::zggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHA, dBETA,
            VL, &LDVL, dV, &LDVR, &WORKSIZE, &LWORK, dR, &INFO);
 
     if (INFO < 0)
@@ -1096,7 +982,7 @@ inline hwMathStatus hwTMatrix<double>::GeneralizedEigenDecompComplex(const hwTMa
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // decompose the matrix
-    zggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHA, dBETA,
+    hwBlas::zggev_(&JOBVL, &JOBVR, &n, dA, &LDA, dB, &LDB, dALPHA, dBETA,
            VL, &LDVL, dV, &LDVR, dWORK, &LWORK, dR, &INFO);
 
     if (INFO < 0)
@@ -1150,7 +1036,7 @@ inline hwMathStatus hwTMatrix<double>::GeneralizedEigenDecompRealSymmetric(const
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // workspace query
-    dsygv_(&ITYPE, &JOBZ, &UPLO, &N, dVR, &LDA, dB, &LDB, dD, &WORKSIZE, &LWORK, &INFO);
+    hwBlas::dsygv_(&ITYPE, &JOBZ, &UPLO, &N, dVR, &LDA, dB, &LDB, dD, &WORKSIZE, &LWORK, &INFO);
 
     LWORK = static_cast<int>(WORKSIZE);
 
@@ -1162,7 +1048,7 @@ inline hwMathStatus hwTMatrix<double>::GeneralizedEigenDecompRealSymmetric(const
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // decompose the matrix
-    dsygv_(&ITYPE, &JOBZ, &UPLO, &N, dVR, &LDA, dB, &LDB, dD, dW, &LWORK, &INFO);
+    hwBlas::dsygv_(&ITYPE, &JOBZ, &UPLO, &N, dVR, &LDA, dB, &LDB, dD, dW, &LWORK, &INFO);
 
     if (INFO > N)
         return status;
@@ -1218,7 +1104,7 @@ inline hwMathStatus hwTMatrix<double>::GeneralizedEigenDecompComplexHermitian(co
     if (!dA || !dB || !dD || !dRWORK || !dWORK)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    zhegv_(&ITYPE, &JOBZ, &UPLO, &n, dA, &LDA, dB,
+    hwBlas::zhegv_(&ITYPE, &JOBZ, &UPLO, &n, dA, &LDA, dB,
            &LDB, dD, dWORK, &LWORK, dRWORK, &INFO);
 
     if (INFO > n)
@@ -1343,7 +1229,7 @@ inline hwMathStatus hwTMatrix<double>::RealSVD(const SVDtype& type, hwTMatrix<do
         work[0] = 0.;
 
         // workspace query
-        dgesvd_(&JOBU, &JOBVT, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work, &lwork, &info);
+        hwBlas::dgesvd_(&JOBU, &JOBVT, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work, &lwork, &info);
 
         lwork = static_cast<int>(work[0]);
         delete [] work;
@@ -1358,7 +1244,7 @@ inline hwMathStatus hwTMatrix<double>::RealSVD(const SVDtype& type, hwTMatrix<do
         }
 
         // decompose the matrix
-        dgesvd_(&JOBU, &JOBVT, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work, &lwork, &info);
+        hwBlas::dgesvd_(&JOBU, &JOBVT, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work, &lwork, &info);
 
         delete [] work;
 
@@ -1519,7 +1405,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexSVD(const SVDtype& type, hwTMatrix
         }
 
         // workspace query
-        zgesvd_(&JOBU, &JOBVT, &m, &n, a, &LDA, s, u, &LDU, vt, &LDVT, WORKC,  &LWORK, drwork, &INFO);
+        hwBlas::zgesvd_(&JOBU, &JOBVT, &m, &n, a, &LDA, s, u, &LDU, vt, &LDVT, WORKC,  &LWORK, drwork, &INFO);
 
         LWORK = static_cast<int>(WORKC[0].real());
         delete [] WORKC;
@@ -1536,7 +1422,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexSVD(const SVDtype& type, hwTMatrix
         }
 
         // decompose the matrix
-        zgesvd_(&JOBU, &JOBVT, &m, &n, a, &LDA, s, u, &LDU, vt, &LDVT, WORKC,  &LWORK, drwork, &INFO);
+        hwBlas::zgesvd_(&JOBU, &JOBVT, &m, &n, a, &LDA, s, u, &LDU, vt, &LDVT, WORKC,  &LWORK, drwork, &INFO);
         delete [] WORKC;
         
         if (INFO != 0)
@@ -1616,7 +1502,7 @@ inline hwMathStatus hwTMatrix<double>::RealQR(hwTMatrix<double>& Q, hwTMatrix<do
             return status(HW_MATH_ERR_ALLOCFAILED);
         }
 
-        dgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
+        hwBlas::dgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
 
         lwork = static_cast<int>(work[0]);
         delete [] work;
@@ -1631,7 +1517,7 @@ inline hwMathStatus hwTMatrix<double>::RealQR(hwTMatrix<double>& Q, hwTMatrix<do
         }
 
         // decompose the matrix
-        dgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
+        hwBlas::dgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
 
         if (info != 0)
         {
@@ -1677,7 +1563,7 @@ inline hwMathStatus hwTMatrix<double>::RealQR(hwTMatrix<double>& Q, hwTMatrix<do
             return status(HW_MATH_ERR_ALLOCFAILED);
         }
 
-        dorgqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
+        hwBlas::dorgqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
 
         lwork = static_cast<int>(work[0]);
         delete [] work;
@@ -1692,7 +1578,7 @@ inline hwMathStatus hwTMatrix<double>::RealQR(hwTMatrix<double>& Q, hwTMatrix<do
         }
 
         // construct Q
-        dorgqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
+        hwBlas::dorgqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
 
         delete [] work;
         delete [] tau;
@@ -1773,7 +1659,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexQR(hwTMatrix<double>& Q, hwTMatrix
             return status(HW_MATH_ERR_ALLOCFAILED);
         }
 
-        zgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
+        hwBlas::zgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
 
         lwork = static_cast<int>(work[0].real());
         delete [] work;
@@ -1788,7 +1674,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexQR(hwTMatrix<double>& Q, hwTMatrix
         }
 
         // decompose the matrix
-        zgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
+        hwBlas::zgeqrf_(&m, &n, q, &lda, tau, work, &lwork, &info);
 
         if (info != 0)
         {
@@ -1834,7 +1720,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexQR(hwTMatrix<double>& Q, hwTMatrix
             return status(HW_MATH_ERR_ALLOCFAILED);
         }
 
-        zungqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
+        hwBlas::zungqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
 
         lwork = static_cast<int>(work[0].real());
         delete [] work;
@@ -1849,7 +1735,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexQR(hwTMatrix<double>& Q, hwTMatrix
         }
 
         // construct Q
-        zungqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
+        hwBlas::zungqr_(&m, &k, &k, q, &lda, tau, work, &lwork, &info);
 
         delete [] work;
         delete [] tau;
@@ -1953,7 +1839,7 @@ inline hwMathStatus hwTMatrix<double>::RealPinv(const hwTMatrix<double>& source)
 
     int lwork = -1;
 
-    dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
+    hwBlas::dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
             work, &lwork, &info);
 
     lwork = static_cast<int>(work[0]);
@@ -1972,7 +1858,7 @@ inline hwMathStatus hwTMatrix<double>::RealPinv(const hwTMatrix<double>& source)
     }
 
     // decompose the matrix and the solve system
-    dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
+    hwBlas::dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
             work, &lwork, &info);
 
     delete [] s;
@@ -2071,7 +1957,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexPinv(const hwTMatrix<double>& sour
 
     int lwork = -1;
 
-    zgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
+    hwBlas::zgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
             work, &lwork, rwork, &info);
 
     lwork = static_cast<int>(work[0].real());
@@ -2090,7 +1976,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexPinv(const hwTMatrix<double>& sour
     }
 
     // decompose the matrix and the solve system
-    zgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
+    hwBlas::zgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
             work, &lwork, rwork, &info);
 
     delete [] s;
@@ -2175,7 +2061,7 @@ inline hwMathStatus hwTMatrix<double>::RealSchur(hwTMatrix<double>& U,
 	memset(iBWORK, 0, sizeof(int) * BWORK.Size());
     
     // workspace query
-    dgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dWR, dWI,
+    hwBlas::dgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dWR, dWI,
            dU, &LDVS, &WORKOPTIMAL, &LWORKMIN, iBWORK, &INFO);
 
     if (INFO < 0)
@@ -2190,7 +2076,7 @@ inline hwMathStatus hwTMatrix<double>::RealSchur(hwTMatrix<double>& U,
     double* dWORK = WORK.m_real;
 
     // decompose matrix
-    dgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dWR, dWI,
+    hwBlas::dgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dWR, dWI,
            dU, &LDVS, dWORK, &LWORK, iBWORK, &INFO);
 
     if (INFO < 0)
@@ -2262,7 +2148,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexSchur(hwTMatrix<double>& U,
 	memset(iBWORK, 0, sizeof(int) * BWORK.Size());
 
     // workspace query
-    zgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dW,
+    hwBlas::zgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dW,
            dU, &LDVS, dWORK, &LWORKMIN, dRWORK, iBWORK, &INFO);
 
     if (INFO < 0)
@@ -2287,7 +2173,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexSchur(hwTMatrix<double>& U,
 	memset(dWORK, 0, sizeof(complexD) * WORK.Size());
 
     // decompose matrix
-    zgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dW,
+    hwBlas::zgees_(&JOBVS, &SORT, NULL, &n, dT, &LDA, &SDIM, dW,
            dU, &LDVS, dWORK, &LWORK, dRWORK, iBWORK, &INFO);
 
     if (INFO < 0)
@@ -2302,7 +2188,7 @@ inline hwMathStatus hwTMatrix<double>::RealRCond(double& rCondNum) const
 {
     hwMathStatus status;
 
-    for (int i = 0; i < Size(); ++i)
+    for (int64_t i = 0; i < Size(); ++i)
     {
         if (IsNaN_T(m_real[i]))
         {
@@ -2335,7 +2221,7 @@ inline hwMathStatus hwTMatrix<double>::RealRCond(double& rCondNum) const
     int n = m_nCols;
     int INFO = 0;
 
-    Anorm = dlange_(&NORM, &m, &n, dA, &m, NULL);
+    Anorm = hwBlas::dlange_(&NORM, &m, &n, dA, &m, NULL);
 
     hwTMatrix<int> IPIV(_min(m, n), 1, hwTMatrix<int>::REAL);
 
@@ -2344,7 +2230,7 @@ inline hwMathStatus hwTMatrix<double>::RealRCond(double& rCondNum) const
     if (!dA || !iPiv)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    dgetrf_(&m, &n, dA, &m, iPiv, &INFO);
+    hwBlas::dgetrf_(&m, &n, dA, &m, iPiv, &INFO);
 
     if (INFO < 0)
         return hwMathStatus(HW_MATH_ERR_DECOMPFAIL);
@@ -2359,7 +2245,7 @@ inline hwMathStatus hwTMatrix<double>::RealRCond(double& rCondNum) const
     if (!dW || !iW)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    dgecon_(&NORM, &n, dA, &n, &Anorm, &rCondNum, dW, iW, &INFO);
+    hwBlas::dgecon_(&NORM, &n, dA, &n, &Anorm, &rCondNum, dW, iW, &INFO);
 
     if (INFO < 0)
         return hwMathStatus(HW_MATH_ERR_DECOMPFAIL);
@@ -2373,7 +2259,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexRCond(double& rCondNum) const
 {
     hwMathStatus status;
     
-    for (int i = 0; i < Size(); ++i)
+    for (int64_t i = 0; i < Size(); ++i)
     {
         if (IsNaN_T(m_complex[i].Real()))
         {
@@ -2414,7 +2300,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexRCond(double& rCondNum) const
 
     complexD* dA = (complexD*) Ain.m_complex;
 
-    Anorm = zlange_(&NORM, &m, &n, dA, &m, NULL);
+    Anorm = hwBlas::zlange_(&NORM, &m, &n, dA, &m, NULL);
     
     hwTMatrix<int> IPIV(_min(m, n), 1, hwTMatrix<int>::REAL);
 
@@ -2423,7 +2309,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexRCond(double& rCondNum) const
     if (!dA || !iPiv)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    zgetrf_(&m, &n, dA, &m, iPiv, &INFO);
+    hwBlas::zgetrf_(&m, &n, dA, &m, iPiv, &INFO);
 
     if (INFO < 0)
         return hwMathStatus(HW_MATH_ERR_DECOMPFAIL);
@@ -2439,7 +2325,7 @@ inline hwMathStatus hwTMatrix<double>::ComplexRCond(double& rCondNum) const
     if (!dW || !dRW)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    zgecon_(&NORM, &n, dA, &m, &Anorm, &rCondNum, dW, dRW, &INFO);
+    hwBlas::zgecon_(&NORM, &n, dA, &m, &Anorm, &rCondNum, dW, dRW, &INFO);
 
     if (INFO < 0)
         return hwMathStatus(HW_MATH_ERR_DECOMPFAIL);
@@ -2547,7 +2433,7 @@ inline hwMathStatus hwTMatrix<double>::QRSolve(const hwTMatrix<double>& A, const
         memset(jpvt, 0, n*sizeof(int));
 
         // dgels_(&TRANS, &m, &n, &bn, a, &lda, b, &ldb, work, &lwork, &info);
-        dgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
+        hwBlas::dgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
                 work, &lwork, &info);
 
         lwork = static_cast<int>(work[0]);
@@ -2564,7 +2450,7 @@ inline hwMathStatus hwTMatrix<double>::QRSolve(const hwTMatrix<double>& A, const
 
         // decompose the matrix and solve
         // dgels_(&TRANS, &m, &n, &bn, a, &lda, b, &ldb, work, &lwork, &info);
-        dgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
+        hwBlas::dgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
                 work, &lwork, &info);
 
         if (info != 0 || rank < _min(m, n))
@@ -2646,7 +2532,7 @@ inline hwMathStatus hwTMatrix<double>::QRSolve(const hwTMatrix<double>& A, const
         memset(jpvt, 0, n*sizeof(int));
 
         // zgels_(&TRANS, &m, &n, &bn, a, &lda, b, &ldb, work, &lwork, &info);
-        zgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
+        hwBlas::zgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
                 work, &lwork, rwork, &info);
 
         lwork = static_cast<int>(work[0].real());
@@ -2663,7 +2549,7 @@ inline hwMathStatus hwTMatrix<double>::QRSolve(const hwTMatrix<double>& A, const
 
         // decompose the matrix and solve
         // zgels_(&TRANS, &m, &n, &bn, a, &lda, b, &ldb, work, &lwork, &info);
-        zgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
+        hwBlas::zgelsy_(&m, &n, &bn, a, &lda, b, &ldb, jpvt, &rcond, &rank,
                 work, &lwork, rwork, &info);
 
         if (info != 0 || rank < _min(m, n))
@@ -2759,7 +2645,7 @@ inline hwMathStatus hwTMatrix<double>::LSolve(const hwTMatrix<double>& A, const
         double* x_r = X.m_real;
         double* a_r = Acopy.m_real;
 
-        dgesv_(&n, &bn, a_r, &lda, ipiv, x_r, &ldb, &info);
+        hwBlas::dgesv_(&n, &bn, a_r, &lda, ipiv, x_r, &ldb, &info);
     }
     else if (!A.IsReal() && !B.IsReal())
     {
@@ -2776,7 +2662,7 @@ inline hwMathStatus hwTMatrix<double>::LSolve(const hwTMatrix<double>& A, const
         complexD* a_c = (complexD*) Acopy.m_complex;
         complexD* x_c = (complexD*) X.m_complex;
 
-        zgesv_(&n, &bn, a_c, &lda, ipiv, x_c, &ldb, &info);
+        hwBlas::zgesv_(&n, &bn, a_c, &lda, ipiv, x_c, &ldb, &info);
     }
     else if (A.IsReal() && !B.IsReal())
     {
@@ -2801,7 +2687,7 @@ inline hwMathStatus hwTMatrix<double>::LSolve(const hwTMatrix<double>& A, const
         complexD* a_c = (complexD*) Acopy.m_complex;
         complexD* x_c = (complexD*) X.m_complex;
 
-        zgesv_(&n, &bn, a_c, &lda, ipiv, x_c, &ldb, &info);
+        hwBlas::zgesv_(&n, &bn, a_c, &lda, ipiv, x_c, &ldb, &info);
     }
     else // if (!A.IsReal() && B.IsReal())
     {
@@ -2818,7 +2704,7 @@ inline hwMathStatus hwTMatrix<double>::LSolve(const hwTMatrix<double>& A, const
         complexD* a_c = (complexD*) Acopy.m_complex;
         complexD* x_c = (complexD*) X.m_complex;
 
-        zgesv_(&n, &bn, a_c, &lda, ipiv, x_c, &ldb, &info);
+        hwBlas::zgesv_(&n, &bn, a_c, &lda, ipiv, x_c, &ldb, &info);
     }
 
     delete [] ipiv;
@@ -2834,1173 +2720,984 @@ inline hwMathStatus hwTMatrix<double>::LSolve(const hwTMatrix<double>& A, const
     return status;
 }
 
-//! Add two matrices so that (*this) = A + B
+//! Solve tridigonal linear system AX=B with LU decomposition, where X = *this
 template<>
-inline hwMathStatus hwTMatrix<double>::Add(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::LSolveT(const hwTMatrix<double>& D, const hwTMatrix<double>& DL,
+                                               const hwTMatrix<double>& DU, const hwTMatrix<double>& B,
+                                               double* rcond)
 {
     hwMathStatus status;
 
-    if (this == &A)
-        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
-    if (this == &B)
-        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+    if (!D.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 1);
 
-    // check dimensions
-    int m = A.m_nRows;
-    int n = A.m_nCols;
-    int size = A.Size();
+    if (!D.IsVector())
+        return status(HW_MATH_ERR_VECTOR, 1);
 
-    if (B.m_nRows != m || B.m_nCols != n)
-    {
-        if (size == 0 && B.Size() == 1)
-            status = Dimension(A.m_nRows, A.m_nCols, REAL);
-        else if (size == 1 && B.Size() == 0)
-            status = Dimension(B.m_nRows, B.m_nCols, REAL);
-        else
-            status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+    if (!DL.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 2);
 
-        return status;
-    }
+    if (!DL.IsVector())
+        return status(HW_MATH_ERR_VECTOR, 2);
 
-    // prepare for LAPACK function call
-    int inc = 1;
-    double a[2] = {1.0, 0.0};   // real or complex
+    if (!DU.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 3);
 
-    if (A.IsReal() && B.IsReal())
-        status = Dimension(m, n, REAL);
-    else
-        status = Dimension(m, n, COMPLEX);
+    if (!DU.IsVector())
+        return status(HW_MATH_ERR_VECTOR, 3);
 
-    if (!status.IsOk())
-    {
-        status.SetArg1(0);
-        return status;
-    }
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 4);
 
-    if (A.IsReal() && B.IsReal())
-    {
-        if (size != 0)
-        {
-            double* t_r = m_real;
-            double* a_r = (double*) A.m_real;
-            double* b_r = (double*) B.m_real;
+    if (DL.Size() != D.Size() - 1)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-            dcopy_(&size, a_r, &inc, t_r, &inc);
-            daxpy_(&size, a, b_r, &inc, t_r, &inc);
-        }
-    }
-    else if (!A.IsReal() && !B.IsReal())
-    {
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
-        complexD* b_c = (complexD*) B.m_complex;
+    if (DU.Size() != D.Size() - 1)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 3);
 
-        zcopy_(&size, a_c, &inc, t_c, &inc);
-        zaxpy_(&size, (complexD*) a, b_c, &inc, t_c, &inc);
-    }
-    else if (A.IsReal() && !B.IsReal())
+    int n = static_cast<int>(D.Size());
+    int nrhs = B.m_nCols;
+    int info;
+
+    if (B.m_nRows != n)
+        return hwMathStatus(HW_MATH_ERR_ARRAYSIZE, 1, 4);
+
+    *this = B;
+
+    if (B.IsEmpty())
+        return status(HW_MATH_ERR_NONE);
+
+    if (IsEmpty())
+        return status(HW_MATH_ERR_ALLOCFAILED);
+
+    hwTMatrix<double> DC(D);
+    hwTMatrix<double> DLC(DL);
+    hwTMatrix<double> DUC(DU);
+    hwTMatrix<double> DU2(n, REAL);
+    hwTMatrix<int> ipiv(n, hwTMatrix<int>::REAL);
+    double* x = m_real;
+    double* d = DC.m_real;
+    double* dl = DLC.m_real;
+    double* du = DUC.m_real;
+    int* p = ipiv.GetRealData();
+
+    if (!x || !DU2.m_real || !p)
+        return status(HW_MATH_ERR_ALLOCFAILED);
+
+    // 1-norm of A, taken before the factorization overwrites it
+    double anorm = 0.0;
+
+    for (int j = 0; j < n; ++j)
     {
-        double* t_c = (double*) m_complex;
-        double* a_r = A.m_real;
-        double* b_c = (double*) B.m_complex;
+        double sum = fabs(d[j]);
 
-        int inc2 = 2;
-        int size2 = size<<1;
-        dcopy_(&size2, b_c, &inc, t_c, &inc);
-        daxpy_(&size, a, a_r, &inc, t_c, &inc2);
+        if (j > 0)
+            sum += fabs(du[j - 1]);
+        if (j < n - 1)
+            sum += fabs(dl[j]);
+        if (sum > anorm)
+            anorm = sum;
     }
-    else // if (!A.IsReal() && B.IsReal())
+
+    char trans = 'N';
+
+    hwBlas::dgttrf_(&n, dl, d, du, DU2.m_real, p, &info);
+
+    if (info != 0)
+        return status(HW_MATH_ERR_DECOMPFAIL);
+
+    hwBlas::dgttrs_(&trans, &n, &nrhs, dl, d, du, DU2.m_real, p, x, &n, &info);
+
+    if (rcond)
     {
-        double* t_c = (double*) m_complex;
-        double* a_c = (double*) A.m_complex;
-        double* b_r = B.m_real;
+        char norm = '1';
+        hwTMatrix<double> work(2 * n, REAL);
+        hwTMatrix<int> iwork(n, hwTMatrix<int>::REAL);
 
-        int inc2 = 2;
-        int size2 = size<<1;
-        dcopy_(&size2, a_c, &inc, t_c, &inc);
-        daxpy_(&size, a, b_r, &inc, t_c, &inc2);
+        if (!work.m_real || !iwork.GetRealData())
+            return status(HW_MATH_ERR_ALLOCFAILED);
+
+        hwBlas::dgtcon_(&norm, &n, dl, d, du, DU2.m_real, p, &anorm, rcond,
+                        work.m_real, iwork.GetRealData(), &info);
     }
 
     return status;
 }
 
-//! Add a matrix to the calling object so that (this) += A
+//! Solve band linear system AX=B with LU decomposition, where X = *this
 template<>
-inline hwMathStatus hwTMatrix<double>::AddEquals(const hwTMatrix<double>& A)
+inline hwMathStatus hwTMatrix<double>::LSolveB(const hwTMatrix<double>& A, int kl, int ku,
+                                               const hwTMatrix<double>& B, double* rcond)
 {
+    // To format A see SizeBandMatrix() and SetBandMatrixElem()
     hwMathStatus status;
 
-    if (this == &A)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
+    if (!A.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 1);
 
-    // check dimensions
-    int m = m_nRows;
-    int n = m_nCols;
-    int size = Size();
+    if (kl < 0 || kl > A.m_nCols - 1)
+        return status(HW_MATH_ERR_KLUD, 2);
 
-    if (A.m_nRows != m || A.m_nCols != n)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+    if (ku < 0 || ku > A.m_nCols - 1)
+        return status(HW_MATH_ERR_KLUD, 3);
 
-    if (IsReal() && !A.IsReal())
-    {
-        status = MakeComplex();
+    int ldab = 2*kl+ku+1;
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(0);
-            return status;
-        }
-    }
+    if (A.m_nRows != ldab)
+        return status(HW_MATH_ERR_ARRAYDIM, 2, 3);
 
-    // prepare for LAPACK function call
-    int inc = 1;
-    double a[2] = {1.0, 0.0};   // real or complex
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 4);
 
-    if (IsReal() && A.IsReal())
+    if (B.m_nRows != A.m_nCols)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 4);
+
+    int info;
+    int n = A.m_nCols;
+    int nrhs = B.m_nCols;
+    hwTMatrix<int> ipiv(n, hwTMatrix<int>::REAL);     // vector of pivots
+    hwTMatrix<double> decomp(A);
+
+    *this = B;
+
+    if (B.IsEmpty())
+        return status(HW_MATH_ERR_NONE);
+
+    if (IsEmpty())
+        return status(HW_MATH_ERR_ALLOCFAILED);
+
+    int* p = ipiv.GetRealData();
+    double* d = decomp.m_real;
+    double* x = m_real;
+
+    if (!d || !x)
+        return status(HW_MATH_ERR_ALLOCFAILED);
+
+    hwBlas::dgbsv_(&n, &kl, &ku, &nrhs, d, &ldab, p, x, &n, &info);
+
+    if (info != 0)
+        return status(HW_MATH_ERR_DECOMPFAIL);
+
+    if (rcond)
     {
-        if (size != 0)
+        // 1-norm of A from its band, which starts at row kl of the storage
+        char norm = '1';
+        double anorm = 0.0;
+
+        for (int j = 0; j < n; ++j)
         {
-            double* t_r = m_real;
-            double* a_r = (double*) A.m_real;
+            const double* col = A.m_real + j * ldab;
+            int first = _max(0, j - ku);
+            int last = _min(n - 1, j + kl);
+            double sum = 0.0;
+
+            for (int i = first; i <= last; ++i)
+                sum += fabs(col[kl + ku + i - j]);
 
-            daxpy_(&size, a, a_r, &inc, t_r, &inc);
+            if (sum > anorm)
+                anorm = sum;
         }
-    }
-    else if (!IsReal() && !A.IsReal())
-    {
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
 
-        zaxpy_(&size, (complexD*) a, a_c, &inc, t_c, &inc);
-    }
-    else // if (!IsReal() && A.IsReal())
-    {
-        double* t_c = (double*) m_complex;
-        double* a_r = (double*) A.m_real;
+        hwTMatrix<double> work(3 * n, REAL);
+        hwTMatrix<int> iwork(n, hwTMatrix<int>::REAL);
 
-        int inc2 = 2;
-        daxpy_(&size, a, a_r, &inc, t_c, &inc2);
+        if (!work.m_real || !iwork.GetRealData())
+            return status(HW_MATH_ERR_ALLOCFAILED);
+
+        hwBlas::dgbcon_(&norm, &n, &kl, &ku, d, &ldab, p, &anorm, rcond,
+                        work.m_real, iwork.GetRealData(), &info);
     }
 
     return status;
 }
 
-//! Subtract one matrix from another so that (*this) = A - B
+//! Solve symmetric positive definite linear system AX=B with Cholesky decomposition,
+//! where X = *this
 template<>
-inline hwMathStatus hwTMatrix<double>::Subtr(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::LSolveSPD(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
 {
     hwMathStatus status;
 
     if (this == &A)
         return status(HW_MATH_ERR_NOTIMPLEMENT);
+
     if (this == &B)
         return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    // check dimensions
+    hwTMatrix<double>& X = (*this);
     int m = A.m_nRows;
     int n = A.m_nCols;
-    int size = A.Size();
 
-    if (B.m_nRows != m || B.m_nCols != n)
-    {
-        if (size == 0 && B.Size() == 1)
-            status = Dimension(A.m_nRows, A.m_nCols, REAL);
-        else if (size == 1 && B.Size() == 0)
-            status = Dimension(B.m_nRows, B.m_nCols, REAL);
-        else
-            status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+    if (m < n)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-        return status;
-    }
+    if (B.m_nRows != m)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-    // prepare for LAPACK function call
-    int inc = 1;
-    double a[2] = {-1.0, 0.0};   // real or complex
+    if (!A.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 1);
 
-    if (A.IsReal() && B.IsReal())
-        status = Dimension(m, n, REAL);
-    else
-        status = Dimension(m, n, COMPLEX);
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 2);
 
-    if (!status.IsOk())
-    {
-        status.SetArg1(0);
-        return status;
-    }
+    hwTMatrix<double> AA(A);
 
-    if (A.IsReal() && B.IsReal())
-    {
-        if (size != 0)
-        {
-            double* t_r = m_real;
-            double* a_r = A.m_real;
-            double* b_r = B.m_real;
+    X = B;
 
-            dcopy_(&size, a_r, &inc, t_r, &inc);
-            daxpy_(&size, a, b_r, &inc, t_r, &inc);
-        }
-    }
-    else if (!A.IsReal() && !B.IsReal())
-    {
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
-        complexD* b_c = (complexD*) B.m_complex;
+    if (B.IsEmpty())
+        return status(HW_MATH_ERR_NONE);
 
-        zcopy_(&size, a_c, &inc, t_c, &inc);
-        zaxpy_(&size, (complexD*) a, b_c, &inc, t_c, &inc);
-    }
-    else if (A.IsReal() && !B.IsReal())
-    {
-        complexD* t_c = (complexD*) m_complex;
-        double* a_r = A.m_real;
-        complexD* b_c = (complexD*) B.m_complex;
+    if (X.IsEmpty())
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-        SetElements(0.0);
+    double* a = AA.m_real;
+    double* x = X.m_real;
 
-        int inc2 = 2;
-        dcopy_(&size, a_r, &inc, (double*) t_c, &inc2);
-        zaxpy_(&size, (complexD*) a, b_c, &inc, t_c, &inc);
-    }
-    else // if (!A.IsReal() && B.IsReal())
-    {
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
-        double* b_r = B.m_real;
+    if (!a || !x)
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-        int inc2 = 2;
-        zcopy_(&size, a_c, &inc, t_c, &inc);
-        daxpy_(&size, a, b_r, &inc, (double*) t_c, &inc2);
-    }
+    // decompose the matrix and solve
+    int lda = m;
+    int ldb = m;
+    int info;
+    int bn = B.m_nCols;
+    char UPLO = 'L';
+
+    hwBlas::dposv_(&UPLO, &n, &bn, a, &lda, x, &ldb, &info);
+
+    if (info != 0)
+        status(HW_MATH_ERR_MTXNOTSPD, 1);
 
     return status;
 }
 
-//! Subtract a matrix from the calling object so that (this) -= A
+//! Solve SPD tridigonal linear system AX=B with Cholesky decomposition,
+//! where X = *this
 template<>
-inline hwMathStatus hwTMatrix<double>::SubtrEquals(const hwTMatrix<double>& A)
+inline hwMathStatus hwTMatrix<double>::LSolveSPDT(const hwTMatrix<double>& D, const hwTMatrix<double>& E,
+                                                  const hwTMatrix<double>& B, double* rcond)
 {
     hwMathStatus status;
 
-    if (this == &A)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
+    if (!D.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 1);
 
-    // check dimensions
-    int m = m_nRows;
-    int n = m_nCols;
-    int size = Size();
+    if (!D.IsVector())
+        return status(HW_MATH_ERR_VECTOR, 1);
 
-    if (A.m_nRows != m || A.m_nCols != n)
+    if (!E.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 2);
+
+    if (!E.IsVector())
+        return status(HW_MATH_ERR_VECTOR, 2);
+
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 3);
+
+    int n = static_cast<int>(D.Size());
+
+    if (E.Size() != n - 1)
         return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-    // prepare for LAPACK function call
-    int inc = 1;
-    double a[2] = {-1.0, 0.0};   // real or complex
+    if (B.m_nRows != n)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 3);
 
-    if (IsReal() && A.IsReal())
-    {
-        if (size != 0)
-        {
-            double* t_r = m_real;
-            double* a_r = A.m_real;
+    *this = B;
 
-            daxpy_(&size, a, a_r, &inc, t_r, &inc);
-        }
-    }
-    else if (!IsReal() && !A.IsReal())
+    if (B.IsEmpty())
+        return status(HW_MATH_ERR_NONE);
+
+    if (IsEmpty())
+        return status(HW_MATH_ERR_ALLOCFAILED);
+
+    hwTMatrix<double> DD(D);
+    hwTMatrix<double> EE(E);
+    double* d = DD.m_real;
+    double* e = EE.m_real;
+    double* x = m_real;
+    int info;
+    int nrhs = B.m_nCols;
+
+    if (!d || !e || !x)
+        return status(HW_MATH_ERR_ALLOCFAILED);
+
+    // 1-norm of A, taken before the factorization overwrites it
+    double anorm = 0.0;
+
+    for (int j = 0; j < n; ++j)
     {
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
+        double sum = fabs(d[j]);
 
-        zaxpy_(&size, (complexD*) &a, a_c, &inc, t_c, &inc);
+        if (j > 0)
+            sum += fabs(e[j - 1]);
+        if (j < n - 1)
+            sum += fabs(e[j]);
+        if (sum > anorm)
+            anorm = sum;
     }
-    else if (IsReal() && !A.IsReal())
-    {
-        status = MakeComplex();
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(0);
-            return status;
-        }
+    hwBlas::dptsv_(&n, &nrhs, d, e, x, &n, &info);
 
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
+    if (info != 0)
+        return status(HW_MATH_ERR_DECOMPFAIL);
 
-        zaxpy_(&size, (complexD*) &a, a_c, &inc, t_c, &inc);
-    }
-    else // if (!IsReal() && A.IsReal())
+    if (rcond)
     {
-        double* t_c = (double*) m_complex;
-        double* a_r = A.m_real;
+        hwTMatrix<double> work(n, REAL);
 
-        int inc2 = 2;
-        daxpy_(&size, a, a_r, &inc, t_c, &inc2);
+        if (!work.m_real)
+            return status(HW_MATH_ERR_ALLOCFAILED);
+
+        hwBlas::dptcon_(&n, d, e, &anorm, rcond, work.m_real, &info);
     }
 
     return status;
 }
 
-//! Multiply two matrices so that (*this) = A * B
+//! Solve SPD band linear system AX=B with Cholesky decomposition,
+//! where X = *this
 template<>
-inline hwMathStatus hwTMatrix<double>::Mult(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::LSolveSPDB(const hwTMatrix<double>& A, int kd,
+                                       const hwTMatrix<double>& B, double* rcond)
 {
+    // To format A see SizeSymBandMatrix() and SetSymBandMatrixElem()
     hwMathStatus status;
 
-    if (this == &A)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
-
-    if (this == &B)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
+    if (!A.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 1);
 
-    // get dimensions info
-    int m = A.m_nRows;
-    int n = B.m_nCols;
-    int k = A.m_nCols;
+    if (kd < 0 || kd > A.m_nCols - 1)
+        return hwMathStatus(HW_MATH_ERR_KLUD, 2);
 
-    if (B.m_nRows != k)
-    {
-        if (A.Size() == 0 && B.Size() == 1)
-            status = Dimension(A.m_nRows, A.m_nCols, REAL);
-        else if (A.Size() == 1 && B.Size() == 0)
-            status = Dimension(B.m_nRows, B.m_nCols, REAL);
-        else
-            status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+    int ldab = kd+1;
 
-        return status;
-    }
+    if (A.m_nRows != ldab)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1);
 
-    // prepare for LAPACK function call
-    char TRANSA = 'N';
-    char TRANSB = 'N';
-    int LDA = A.m_nRows;
-    int LDB = B.m_nRows;
-    int LDC = A.m_nRows;    // = C.m_nRows
-    double ALPHA[2] = {1.0, 0.0};   // real or complex
-    double BETA[2] = {0.0, 0.0};    // real or complex
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 3);
 
-    if (A.IsReal() && B.IsReal())
-    {
-        status = Dimension(m, n, REAL);
+    int n = A.m_nCols;
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(3);
-            return status;
-        }
+    if (B.m_nRows != n)
+        return hwMathStatus(HW_MATH_ERR_ARRAYSIZE, 1, 3);
 
-        if (A.Size() != 0 && B.Size() != 0)
-        {
-            double* t_r = m_real;
-            double* a_r = A.m_real;
-            double* b_r = B.m_real;
+    char uplo = 'L';
+    int info;
+    int nrhs = B.m_nCols;
+    hwTMatrix<double> decomp(A);
 
-            dgemm_(&TRANSA, &TRANSB, &m, &n, &k, ALPHA, a_r, &LDA, b_r, &LDB, BETA, t_r, &LDC);
-        }
-        else if (Size() != 0)
-        {
-            SetElements(0.0);
-        }
-    }
-    else if (!A.IsReal() && !B.IsReal())
-    {
-        status = Dimension(m, n, COMPLEX);
+    *this = B;
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(3);
-            return status;
-        }
+    if (B.IsEmpty())
+        return status(HW_MATH_ERR_NONE);
 
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
-        complexD* b_c = (complexD*) B.m_complex;
+    if (IsEmpty())
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-        zgemm_(&TRANSA, &TRANSB, &m, &n, &k, (complexD*) &ALPHA,
-               a_c, &LDA, b_c, &LDB, (complexD*) &BETA, t_c, &LDC);
-    }
-    else if (A.IsReal() && !B.IsReal())
-    {
-        status = Dimension(m, n, COMPLEX);
+    double* d = decomp.m_real;
+    double* x = m_real;
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(3);
-            return status;
-        }
+    if (!d || !x)
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-        if (A.Size() != 0)
-        {
-            hwTMatrix<double> AC(A);
-            AC.MakeComplex();
+    hwBlas::dpbsv_(&uplo, &n, &kd, &nrhs, d, &ldab, x, &n, &info);
 
-            complexD* t_c = (complexD*) m_complex;
-            complexD* a_c = (complexD*) AC.m_complex;
-            complexD* b_c = (complexD*) B.m_complex;
+    if (info != 0)
+        return status(HW_MATH_ERR_DECOMPFAIL);
 
-            zgemm_(&TRANSA, &TRANSB, &m, &n, &k, (complexD*) &ALPHA,
-                   a_c, &LDA, b_c, &LDB, (complexD*) &BETA, t_c, &LDC);
-        }
-        else if (Size() != 0)
-        {
-            Dimension(m, n, REAL);
-            SetElements(0.0);
-        }
-    }
-    else // if (!A.IsReal() && B.IsReal())
+    if (rcond)
     {
-        status = Dimension(m, n, COMPLEX);
+        // 1-norm of A, where each stored subdiagonal element also appears
+        // above the diagonal in the column of its row
+        hwTMatrix<double> colSum(n, REAL);
+        hwTMatrix<double> work(3 * n, REAL);
+        hwTMatrix<int> iwork(n, hwTMatrix<int>::REAL);
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(3);
-            return status;
-        }
+        if (!colSum.m_real || !work.m_real || !iwork.GetRealData())
+            return status(HW_MATH_ERR_ALLOCFAILED);
 
-        if (B.Size() != 0)
+        colSum.SetElements(0.0);
+
+        for (int j = 0; j < n; ++j)
         {
-            hwTMatrix<double> BC(B);
-            BC.MakeComplex();
-            complexD* t_c = (complexD*) m_complex;
-            complexD* a_c = (complexD*) A.m_complex;
-            complexD* b_c = (complexD*) BC.m_complex;
+            const double* col = A.m_real + j * ldab;
+            int last = _min(n - 1, j + kd);
+
+            colSum.m_real[j] += fabs(col[0]);
 
-            zgemm_(&TRANSA, &TRANSB, &m, &n, &k, (complexD*) &ALPHA,
-                   a_c, &LDA, b_c, &LDB, (complexD*) &BETA, t_c, &LDC);
+            for (int i = j + 1; i <= last; ++i)
+            {
+                colSum.m_real[j] += fabs(col[i - j]);
+                colSum.m_real[i] += fabs(col[i - j]);
+            }
         }
-        else if (Size() != 0)
+
+        double anorm = 0.0;
+
+        for (int j = 0; j < n; ++j)
         {
-            Dimension(m, n, REAL);
-            SetElements(0.0);
+            if (colSum.m_real[j] > anorm)
+                anorm = colSum.m_real[j];
         }
+
+        hwBlas::dpbcon_(&uplo, &n, &kd, d, &ldab, &anorm, rcond, work.m_real,
+                        iwork.GetRealData(), &info);
     }
 
     return status;
 }
 
-//! Multiply a matrix by a real number so that (*this) = A * x
+//! Solve symmetric indefinite linear system AX=B, where X = *this
 template<>
-inline hwMathStatus hwTMatrix<double>::Mult(const hwTMatrix<double>& A, double x)
+inline hwMathStatus hwTMatrix<double>::LSolveSI(const hwTMatrix<double>& A, const hwTMatrix<double>& B,
+                                                double* rcond)
 {
     hwMathStatus status;
 
-    if (this == &A)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
-
-    // get dimensions info
+    // check dimensions
     int m = A.m_nRows;
     int n = A.m_nCols;
-    int size = A.Size();
 
-    // prepare for LAPACK function call
-    int inc = 1;
+    if (!A.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 1);
 
-    if (A.IsReal())
-    {
-        status = Dimension(m, n, REAL);
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 2);
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(0);
-            return status;
-        }
-
-        if (size != 0)
-        {
-            double* t_r = m_real;
-            double* a_r = A.m_real;
+    if (A.m_nRows != n)
+        return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
 
-            dcopy_(&size, a_r, &inc, t_r, &inc);
-            dscal_(&size, (double*) &x, t_r, &inc);
-        }
-    }
-    else
-    {
-        status = Dimension(m, n, COMPLEX);
+    if (B.m_nRows != m)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(0);
-            return status;
-        }
+    // prepare for LAPACK function call
+    char uplo = 'L';
+    int info;
+    int lwork = -1;
+    int nrhs = B.m_nCols;
+    hwTMatrix<int> ipiv(n, hwTMatrix<int>::REAL);     // vector of pivots
+    hwTMatrix<double> decomp(A);
 
-        complexD* t_c = (complexD*) m_complex;
-        complexD* a_c = (complexD*) A.m_complex;
+    *this = B;
 
-        int size2 = size<<1;
-        zcopy_(&size, a_c, &inc, t_c, &inc);
-        dscal_(&size2, (double*) &x, (double*) t_c, &inc);
-    }
+    if (B.IsEmpty())
+        return status(HW_MATH_ERR_NONE);
 
-    return status;
-}
+    if (IsEmpty())
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-//! Multiply a matrix by a complex number so that (*this) = A * z
-template<>
-inline hwMathStatus hwTMatrix<double>::Mult(const hwTMatrix<double>& A, const hwTComplex<double>& z)
-{
-    hwMathStatus status;    
+    double* d = decomp.m_real;
+    int* p = ipiv.GetRealData();
+    double* x = m_real;
+    double* work;
     
-    if (this == &A)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
-
-    // get dimensions info
-    int m = A.m_nRows;
-    int n = A.m_nCols;
-    int size = A.Size();
-    int inc = 1;
-
-    status = Dimension(m, n, COMPLEX);
-
-    if (!status.IsOk())
-    {
-        status.SetArg1(0);
-        return status;
-    }
-
-    complexD* t_c = (complexD*) m_complex;
+    if (!d || !p || !x)
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-    if (A.IsReal())
+    // workspace query
+    try
     {
-        if (size != 0)
-        {
-            hwTMatrix<double> AC(A);
-
-            AC.MakeComplex();
-            complexD* a_c = (complexD*) AC.m_complex;
-            zcopy_(&size, a_c, &inc, t_c, &inc);
-            zscal_(&size, (complexD*) &z, t_c, &inc);
-        }
+        work = new double[1];
     }
-    else
+    catch (std::bad_alloc&) 
     {
-        complexD* a_c = (complexD*) A.m_complex;
-        zcopy_(&size, a_c, &inc, t_c, &inc);
-        zscal_(&size, (complexD*) &z, t_c, &inc);
+        return status(HW_MATH_ERR_ALLOCFAILED);
     }
 
-    return status;
-}
+    hwBlas::dsysv_(&uplo, &n, &nrhs, d, &n, p, x, &n, work, &lwork, &info);
 
-//! Multiply a matrix by a real number so that (*this)* = x
-template<>
-inline void hwTMatrix<double>::MultEquals(double x)
-{
-    int size = Size();
-    int inc = 1;
+    if (info != 0)
+        return hwMathStatus(HW_MATH_ERR_DECOMPFAIL, 0);
 
-    if (IsReal())
+    lwork = static_cast<int>(work[0]);
+    delete [] work;
+
+    try
     {
-        if (size != 0)
-        {
-            double* t_r = m_real;
-            dscal_(&size, (double*) &x, t_r, &inc);
-        }
+        work = new double[lwork];
     }
-    else
+    catch (std::bad_alloc&) 
     {
-        double* t_c = (double*) m_complex;
-
-        int size2 = size<<1;
-        dscal_(&size2, (double*) &x, t_c, &inc);
+        return status(HW_MATH_ERR_ALLOCFAILED);
     }
-}
 
-//! Multiply a matrix by a complex number so that (*this)* = z
-template<>
-inline hwMathStatus hwTMatrix<double>::MultEquals(const hwTComplex<double>& z)
-{
-    int size = Size();
-    int inc = 1;
-    hwMathStatus status;
+    // solve the system
+    hwBlas::dsysv_(&uplo, &n, &nrhs, d, &n, p, x, &n, work, &lwork, &info);
 
-    if (IsReal())
-    {
-        status = MakeComplex();
+    delete [] work;
 
-        if (!status.IsOk())
-        {
-            status.SetArg1(0);
-            return status;
-        }
-    }
+    if (info != 0)
+        return status(HW_MATH_ERR_DECOMPFAIL);
 
-    if (size != 0)
+    if (rcond)
     {
-        complexD* t_c = (complexD*) m_complex;
-        zscal_(&size, (complexD*) &z, t_c, &inc);
+        char norm = '1';
+        hwTMatrix<double> cwork(2 * n, REAL);
+        hwTMatrix<int> iwork(n, hwTMatrix<int>::REAL);
+
+        if (!cwork.m_real || !iwork.GetRealData())
+            return status(HW_MATH_ERR_ALLOCFAILED);
+
+        double anorm = hwBlas::dlange_(&norm, &n, &n, A.m_real, &n, cwork.m_real);
+
+        hwBlas::dsycon_(&uplo, &n, d, &n, p, &anorm, rcond, cwork.m_real,
+                        iwork.GetRealData(), &info);
     }
 
     return status;
 }
 
-//! Divide a matrix by a matrix so that (*this) = A \ B, or A(*this) = B
+//! Solve square linear system AX=B with a solver chosen from the structure
+//! of A, where X = *this. Each solver tried is recorded in hwSolverPath.
 template<>
-inline hwMathStatus hwTMatrix<double>::DivideLeft(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::LSolveStructured(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
 {
     hwMathStatus status;
 
-    if (A.m_nRows == A.m_nCols)
-    {
-        if (B.IsEmpty() && A.Size() == 1)   // treat A as a scalar
-            return Dimension(B.m_nRows, B.m_nCols, hwTMatrix<double>::REAL);
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+    if (this == &B)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-        status = LSolve(A, B);
-    }
-    else
+    int n = A.m_nCols;
+
+    if (!A.IsReal() || !B.IsReal() || A.m_nRows != n || B.m_nRows != n || B.IsEmpty())
     {
-        status = QRSolve(A, B);
+        hwSolverPath::Add("lu");
+        return LSolve(A, B);
     }
 
-    if (status == HW_MATH_WARN_MTXNOTFULLRANK || status == HW_MATH_WARN_SINGMATRIXDIV)
-    {
-        // status = SVDSolve(A, B);     - this will fail if B contains NaN
-        hwTMatrix<double> P;
-        hwMathStatus status2 = P.Pinv(A);
+    hwTMatrix<double>& X = (*this);
+    int nrhs = B.m_nCols;
+    int info;
+    int kl;
+    int ku;
+    double rcond;
 
-        if (!status2.IsOk())
-            return status2;
+    // the scan stops at the first nonzero from each end of a column, so it is
+    // cheap for dense matrices
+    A.Bandwidth(kl, ku);
 
-        (*this) = P * B;
-    }
+    bool narrow = IsNarrowBand(n, kl, ku);
 
-    return status;
-}
+    if (kl == 0 && ku == 0)
+    {
+        hwSolverPath::Add("diagonal");
 
-//! Divide a matrix by a matrix so that (*this) = B / A, or (*this)A = B
-template<>
-inline hwMathStatus hwTMatrix<double>::DivideRight(const hwTMatrix<double>& B, const hwTMatrix<double>& A)
-{
-    if (this == &A)
-        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
-    if (this == &B)
-        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+        double dmin = fabs(A.m_real[0]);
+        double dmax = dmin;
 
-    hwTMatrix<double>& X = (*this);
-    hwMathStatus status;
-    hwTMatrix<double> AT;
-    hwTMatrix<double> BT;
-    hwTMatrix<double> XT;
+        for (int i = 1; i < n; ++i)
+        {
+            double d = fabs(A.m_real[i * (n + 1)]);
 
-    status = AT.Transpose(A);
+            if (d < dmin)
+                dmin = d;
+            if (d > dmax)
+                dmax = d;
+        }
 
-    if (!status.IsOk())
-    {
-        status.ResetArgs();
-        return status;
-    }
+        X = B;
 
-    status = BT.Transpose(B);
+        for (int j = 0; j < nrhs; ++j)
+        {
+            double* x = X.m_real + j * n;
 
-    if (!status.IsOk())
-    {
-        status.ResetArgs();
-        return status;
-    }
+            for (int i = 0; i < n; ++i)
+                x[i] /= A.m_real[i * (n + 1)];
+        }
 
-    status = XT.Transpose(X);
+        if (dmax == 0.0 || dmin / dmax < 1.0e-12)
+            status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-    if (!status.IsOk())
-    {
-        status.ResetArgs();
         return status;
     }
 
-    status = XT.DivideLeft(AT, BT);
-
-    if (!status.IsOk())
+    if (kl == 0 || ku == 0)
     {
-        if (status.GetArg1() == 1)
-            status.SetArg1(2);
-        else if (status.GetArg1() == 2)
-            status.SetArg1(1);
-
-        if (status.GetArg2() == 2)
-            status.SetArg2(1);
-    }
+        char uplo = (kl == 0) ? 'U' : 'L';
+        char norm = '1';
+        char trans = 'N';
+        char diag = 'N';
+        double* a = A.m_real;     // not written by dtrcon_ or dtrtrs_
 
-    hwMathStatus status2 = X.Transpose(XT);
+        hwSolverPath::Add(uplo == 'U' ? "upper triangular" : "lower triangular");
 
-    if (!status2.IsOk())
-    {
-        status2.ResetArgs();
-        return status2;
-    }
+        hwTMatrix<double> work(3 * n, REAL);
+        hwTMatrix<int> iwork(n, hwTMatrix<int>::REAL);
 
-    return status;
-}
+        if (!work.m_real || !iwork.GetRealData())
+            return status(HW_MATH_ERR_ALLOCFAILED);
 
-//! Implement the /= operator with a matrix argument
-template<>
-inline hwMathStatus hwTMatrix<double>::DivideEquals(const hwTMatrix<double>& A)
-{
-    hwTMatrix<double> temp(*this);
-    hwMathStatus status;
+        hwBlas::dtrcon_(&norm, &uplo, &diag, &n, a, &n, &rcond, work.m_real,
+                        iwork.GetRealData(), &info);
 
-    status = DivideRight(A, temp);
+        X = B;
 
-    if (!status.IsOk())
-        MakeEmpty();
+        if (X.IsEmpty())
+            return status(HW_MATH_ERR_ALLOCFAILED);
 
-    return status;
-}
+        hwBlas::dtrtrs_(&uplo, &trans, &diag, &n, &nrhs, a, &n, X.m_real, &n, &info);
 
-//! Real determinant
-template<>
-inline hwMathStatus hwTMatrix<double>::Determinant(double& det) const
-{
-    const hwTMatrix<double>& A = (*this);
-    hwMathStatus status;
-    int n = A.m_nCols;
+        if (info != 0)
+        {
+            status(HW_MATH_WARN_SINGMATRIXDIV, 1);
+            X.SetElements(std::numeric_limits<double>::infinity());
+        }
+        else if (rcond < 1.0e-12)
+        {
+            status(HW_MATH_WARN_SINGMATRIXDIV, 1);
+        }
 
-    if (A.IsEmpty())
-    {
-        det = 1.0;
         return status;
     }
 
-    if (A.m_nRows != n)
-        return status(HW_MATH_ERR_MTXNOTSQUARE, 0);
+    bool symmetric = (kl == ku) && A.IsSymmetric();
+    bool positiveDiag = symmetric;
 
-    if (!A.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 0);
+    for (int i = 0; positiveDiag && i < n; ++i)
+        positiveDiag = A.m_real[i * (n + 1)] > 0.0;
 
-    hwTMatrix<double> B(A);
-    double* a = B.m_real;
+    // Cholesky is attempted on any symmetric matrix with a positive diagonal.
+    // If it breaks down the matrix is indefinite, and the solve falls back to
+    // the solver for the same structure without symmetry.
+    if (positiveDiag)
+    {
+        if (kl == 1)
+        {
+            hwSolverPath::Add("spd tridiagonal");
 
-    // decompose the matrix
-    int lda = n;
-    int info;
-    int* ipiv;
-
-    try
-    {
-        ipiv = new int[n];
-    }
-    catch (std::bad_alloc&) 
-    {
-        return status(HW_MATH_ERR_ALLOCFAILED);
-    }
-
-    dgetrf_(&n, &n, a, &lda, ipiv, &info); 
-
-    if (info < 0)
-        return status(HW_MATH_ERR_NOTCONVERGE);
-
-    // compute determinant from trace
-    int pivSign = 1;
-
-    for (int i = 0; i < n-1; ++i)
-    {
-        if (i != ipiv[i]-1)
-            pivSign = -pivSign;
-    }
+            hwTMatrix<double> D(n, REAL);
+            hwTMatrix<double> E(n - 1, REAL);
 
-    delete [] ipiv;
-
-    det = (double) pivSign * B(0, 0);
-
-    for (int i = 1; i < n; ++i)
-        det *= B(i, i);
+            for (int i = 0; i < n; ++i)
+                D.m_real[i] = A.m_real[i * (n + 1)];
 
-    return status;
-}
+            for (int i = 0; i < n - 1; ++i)
+                E.m_real[i] = A.m_real[i * (n + 1) + 1];
 
-//! Complex determinant
-template<>
-inline hwMathStatus hwTMatrix<double>::Determinant(hwTComplex<double>& det) const
-{
-    const hwTMatrix<double>& A = (*this);
-    hwMathStatus status;
-    int n = A.m_nCols;
+            status = LSolveSPDT(D, E, B, &rcond);
 
-    if (A.IsEmpty())
-    {
-        det.Set(1.0, 0.0);
-        return status;
-    }
+            if (status.IsOk())
+            {
+                if (rcond < 1.0e-12)
+                    status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-    if (A.m_nRows != n)
-        return status(HW_MATH_ERR_MTXNOTSQUARE, 0);
+                return status;
+            }
 
-    if (A.IsReal())
-    {
-        double det_r;
-        status = Determinant(det_r);
+            status = hwMathStatus();
+        }
+        else if (narrow)
+        {
+            hwSolverPath::Add("spd banded");
 
-        if (!status.IsOk())
-            return status;
+            hwTMatrix<double> AB;
 
-        det.Set(det_r, 0.0);
-    }
+            status = AB.Dimension(kl + 1, n, REAL);
 
-    hwTMatrix<double> B(A);
-    complexD* a_c = (complexD*) B.m_complex;
+            if (!status.IsOk())
+                return status;
 
-    // decompose the matrix
-    int lda = n;
-    int info;
-    int* ipiv;
+            AB.SetElements(0.0);
 
-    try
-    {
-        ipiv = new int[n];
-    }
-    catch (std::bad_alloc&) 
-    {
-        return status(HW_MATH_ERR_ALLOCFAILED);
-    }
+            for (int j = 0; j < n; ++j)
+            {
+                int last = _min(n - 1, j + kl);
 
-    zgetrf_(&n, &n, a_c, &lda, ipiv, &info); 
+                for (int i = j; i <= last; ++i)
+                    AB.m_real[j * (kl + 1) + i - j] = A.m_real[j * n + i];
+            }
 
-    if (info < 0)
-        return status(HW_MATH_ERR_NOTCONVERGE);
+            status = LSolveSPDB(AB, kl, B, &rcond);
 
-    // compute determinant from trace
-    int i;
-    int pivSign = 1;
+            if (status.IsOk())
+            {
+                if (rcond < 1.0e-12)
+                    status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-    for (i = 0; i < n-1; ++i)
-    {
-        if (i != ipiv[i]-1)
-            pivSign = -pivSign;
-    }
+                return status;
+            }
 
-    delete [] ipiv;
+            status = hwMathStatus();
+        }
+        else
+        {
+            hwSolverPath::Add("cholesky");
 
-    det = B.z(0, 0) * (double) pivSign;
+            char uplo = 'L';
+            char norm = '1';
+            hwTMatrix<double> L(A);
 
-    for (i = 1; i < n; ++i)
-        det *= B.z(i, i);
+            if (L.IsEmpty())
+                return status(HW_MATH_ERR_ALLOCFAILED);
 
-    return status;
-}
+            hwBlas::dpotrf_(&uplo, &n, L.m_real, &n, &info);
 
-//! Invert a matrix
-template<>
-inline hwMathStatus hwTMatrix<double>::Inverse(const hwTMatrix<double>& source)
-{
-    hwMathStatus status;
+            if (info == 0)
+            {
+                hwTMatrix<double> work(3 * n, REAL);
+                hwTMatrix<int> iwork(n, hwTMatrix<int>::REAL);
 
-    if (this == &source)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
+                if (!work.m_real || !iwork.GetRealData())
+                    return status(HW_MATH_ERR_ALLOCFAILED);
 
-    hwTMatrix<double>& inv = (*this);
+                double anorm = hwBlas::dlange_(&norm, &n, &n, A.m_real, &n, work.m_real);
 
-    // check dimensions
-    int n = source.m_nCols;
+                hwBlas::dpocon_(&uplo, &n, L.m_real, &n, &anorm, &rcond, work.m_real,
+                                iwork.GetRealData(), &info);
 
-    if (source.m_nRows != n)
-        return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
+                X = B;
 
-    if (n == 0)
-        return inv.Dimension(0, 0, REAL);
+                if (X.IsEmpty())
+                    return status(HW_MATH_ERR_ALLOCFAILED);
 
-    // prepare for LAPACK function call
-    inv = source;
+                hwBlas::dpotrs_(&uplo, &n, &nrhs, L.m_real, &n, X.m_real, &n, &info);
 
-    int lda = n;
-    int info;
-    int lwork = -1;
-    int* ipiv;
+                if (rcond < 1.0e-12)
+                    status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-    try
-    {
-        ipiv = new int[n];
-    }
-    catch (std::bad_alloc&) 
-    {
-        return status(HW_MATH_ERR_ALLOCFAILED);
+                return status;
+            }
+        }
     }
 
-    if (source.IsReal())
+    if (kl == 1 && ku == 1)
     {
-        // decompose the matrix
-        double* a_r = inv.m_real;
-        double* work = NULL;
+        hwSolverPath::Add("tridiagonal");
 
-        dgetrf_(&n, &n, a_r, &lda, ipiv, &info); 
+        hwTMatrix<double> D(n, REAL);
+        hwTMatrix<double> DL(n - 1, REAL);
+        hwTMatrix<double> DU(n - 1, REAL);
 
-        if (info != 0)
-        {
-            inv.SetElements(std::numeric_limits<double>::infinity());
-            return status(HW_MATH_WARN_SINGMATRIX, 1);
-        }
+        for (int i = 0; i < n; ++i)
+            D.m_real[i] = A.m_real[i * (n + 1)];
 
-        // workspace query
-        try
-        {
-            work = new double[1];
-        }
-        catch (std::bad_alloc&) 
+        for (int i = 0; i < n - 1; ++i)
         {
-            if (ipiv)
-                delete [] ipiv;
-
-            return status(HW_MATH_ERR_ALLOCFAILED);
+            DL.m_real[i] = A.m_real[i * (n + 1) + 1];
+            DU.m_real[i] = A.m_real[(i + 1) * (n + 1) - 1];
         }
 
-        dgetri_(&n, a_r, &lda, ipiv, work, &lwork, &info);
-
-        lwork = static_cast<int>(work[0]);
-        delete [] work;
+        status = LSolveT(D, DL, DU, B, &rcond);
 
-        // back substitute
-        try
-        {
-            work = new double[lwork];
-        }
-        catch (std::bad_alloc&) 
+        if (status.IsOk())
         {
-            if (ipiv)
-                delete [] ipiv;
+            if (rcond < 1.0e-12)
+                status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-            return status(HW_MATH_ERR_ALLOCFAILED);
+            return status;
         }
 
-        dgetri_(&n, a_r, &lda, ipiv, work, &lwork, &info);
-
-        delete [] work;
+        status = hwMathStatus();
     }
-    else
+    else if (narrow)
     {
-        // decompose the matrix
-        complexD* a_c = (complexD*) inv.m_complex;
-        complexD* work = NULL;
+        hwSolverPath::Add("banded");
 
-        zgetrf_(&n, &n, a_c, &lda, ipiv, &info); 
+        int ldab = 2 * kl + ku + 1;
+        hwTMatrix<double> AB;
 
-        if (info != 0)
-        {
-            inv.SetElements(std::numeric_limits<double>::infinity());
-            return status(HW_MATH_WARN_SINGMATRIX, 1);
-        }
+        status = AB.Dimension(ldab, n, REAL);
 
-        // workspace query
-        try
+        if (!status.IsOk())
+            return status;
+
+        AB.SetElements(0.0);
+
+        for (int j = 0; j < n; ++j)
         {
-            work = new complexD[1];
+            int first = _max(0, j - ku);
+            int last = _min(n - 1, j + kl);
+
+            for (int i = first; i <= last; ++i)
+                AB.m_real[j * ldab + kl + ku + i - j] = A.m_real[j * n + i];
         }
-        catch (std::bad_alloc&) 
+
+        status = LSolveB(AB, kl, ku, B, &rcond);
+
+        if (status.IsOk())
         {
-            if (ipiv)
-                delete [] ipiv;
+            if (rcond < 1.0e-12)
+                status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-            return status(HW_MATH_ERR_ALLOCFAILED);
+            return status;
         }
 
-        zgetri_(&n, a_c, &lda, ipiv, work, &lwork, &info);
+        status = hwMathStatus();
+    }
+    else if (symmetric)
+    {
+        hwSolverPath::Add("ldl");
 
-        lwork = static_cast<int>(work[0].real());
-        delete [] work;
+        status = LSolveSI(A, B, &rcond);
 
-        try
-        {
-            work = new complexD[lwork];
-        }
-        catch (std::bad_alloc&) 
+        if (status.IsOk())
         {
-            if (ipiv)
-                delete [] ipiv;
+            if (rcond < 1.0e-12)
+                status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-            return status(HW_MATH_ERR_ALLOCFAILED);
+            return status;
         }
 
-        // back substitute
-        zgetri_(&n, a_c, &lda, ipiv, work, &lwork, &info);
-
-        delete [] work;
+        status = hwMathStatus();
     }
 
-    delete [] ipiv;
+    // the structured solvers report an exactly singular matrix as a failure,
+    // so the general solver is left to warn
+    hwSolverPath::Add("lu");
 
-    return status;
+    return LSolve(A, B);
 }
 
-//! Matrix exponential (not a matrix of exponentials)
+//! Factor a square real matrix for repeated solves, where the factors are *this.
+//! Cholesky is used when A is symmetric with a positive diagonal and the
+//! factorization succeeds, with pivots left empty. Otherwise LU is used, and
+//! pivots holds its row interchanges.
 template<>
-inline hwMathStatus hwTMatrix<double>::MatExp(const hwTMatrix<double>& power)
+inline hwMathStatus hwTMatrix<double>::Factor(const hwTMatrix<double>& A, hwTMatrix<int>& pivots)
 {
     hwMathStatus status;
 
-    if (this == &power)
+    if (this == &A)
         return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    hwTMatrix<double>& E = (*this);
+    if (!A.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 1);
 
-    if (!power.IsSquare())
+    if (A.m_nRows != A.m_nCols)
         return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
 
-    if (power.IsReal())
-        status = E.Dimension(power.m_nRows, power.m_nCols, REAL);
-    else
-        status = E.Dimension(power.m_nRows, power.m_nCols, COMPLEX);
+    if (A.IsEmpty())
+        return status(HW_MATH_ERR_EMPTYMATRIX, 1);
 
-    if (!status.IsOk())
-    {
-        if (status.GetArg1() == 0)
-            status.SetArg1(2);
-        else
-            status.ResetArgs();
+    int n = A.m_nCols;
+    int info;
+    char norm = '1';
+    double rcond;
+    hwTMatrix<double> work(4 * n, REAL);
+    hwTMatrix<int> iwork(n, hwTMatrix<int>::REAL);
 
-        return status;
-    }
+    if (!work.m_real || !iwork.GetRealData())
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-    //// scale A
-    // get mag of largest row
-    int n = power.m_nRows;
-    double max = 0.0;
-    double value;
+    double anorm = hwBlas::dlange_(&norm, &n, &n, A.m_real, &n, work.m_real);
 
-    for (int i = 0; i < n; ++i)
+    bool positiveDiag = A.IsSymmetric();
+
+    for (int i = 0; positiveDiag && i < n; ++i)
+        positiveDiag = A.m_real[i * (n + 1)] > 0.0;
+
+    pivots.Dimension(0, 0, hwTMatrix<int>::REAL);
+
+    if (positiveDiag)
     {
-        value = 0.0;
+        char uplo = 'L';
 
-        if (power.IsReal())
+        (*this) = A;
+
+        if (IsEmpty())
+            return status(HW_MATH_ERR_ALLOCFAILED);
+
+        hwBlas::dpotrf_(&uplo, &n, m_real, &n, &info);
+
+        if (info == 0)
         {
-            for (int j = 0; j < n; ++j)
-                value += fabs(power(i, j));
-        }
-        else
-        {
-            for (int j = 0; j < n; ++j)
-                value += power.z(i, j).Mag();
-        }
+            hwBlas::dpocon_(&uplo, &n, m_real, &n, &anorm, &rcond, work.m_real,
+                            iwork.GetRealData(), &info);
 
-        if (value > max)
-            max = value;
-    }
+            if (rcond < 1.0e-12)
+                status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-    // get scale and divide
-    int exponent;
-    double mantissa;
-    hwTMatrix<double> B;
+            return status;
+        }
+    }
 
-    mantissa = frexp(max, &exponent);
+    (*this) = A;
 
-    if (exponent + 1 > 0)
-        ++exponent;
-    else
-        exponent = 0;
+    if (IsEmpty())
+        return status(HW_MATH_ERR_ALLOCFAILED);
 
-    value = (double) (1 << exponent);
-    status = B.Divide(power, value);
+    status = pivots.Dimension(n, 1, hwTMatrix<int>::REAL);
 
     if (!status.IsOk())
-    {
-        status.ResetArgs();
         return status;
-    }
-
-    // Pade approximation for exp(A)
-    hwTMatrix<double> X(B);
-    hwTMatrix<double> I(n, n, REAL);
-    hwTMatrix<double> tempM;
-    hwTMatrix<double> D;
-    double c = 0.5;
-
-    I.Identity();
-    tempM = B * c;
-    E = I + tempM;
-    D = I - tempM;
-
-    int q = 6;
-    bool p = true;
-
-    for (int k = 2; k <= q; ++k)
-    {
-        c = c * (q-k+1.0) / (k*(2.0*q-k+1.0));
-        X = B * X;
-        tempM = X * c;
-        E = E + tempM;
-
-        if (p)
-            D = D + tempM;
-        else
-            D = D - tempM;
-
-        p = !p;
-    }
 
-    tempM = E;
-    status = E.DivideLeft(D, tempM);
+    hwBlas::dgetrf_(&n, &n, m_real, &n, pivots.GetRealData(), &info);
 
-    if (!status.IsOk())
-    {
-        if (status.GetArg1() == 2) { }
-        else
-            status.ResetArgs();
+    if (info != 0)
+        return status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
-        return status;
-    }
+    hwBlas::dgecon_(&norm, &n, m_real, &n, &anorm, &rcond, work.m_real,
+                    iwork.GetRealData(), &info);
 
-    // Undo scaling by repeated squaring
-    for (int k = 1; k <= exponent; ++k)
-        E = E * E;
+    if (rcond < 1.0e-12)
+        status(HW_MATH_WARN_SINGMATRIXDIV, 1);
 
     return status;
 }
 
-//! Solve tridigonal linear system AX=B with LU decomposition, where X = *this
+//! Solve linear system AX=B with the factors of A from Factor, where X = *this
 template<>
-inline hwMathStatus hwTMatrix<double>::LSolveT(const hwTMatrix<double>& D, const hwTMatrix<double>& DL,
-                                               const hwTMatrix<double>& DU, const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::SolveFactored(const hwTMatrix<double>& F, const hwTMatrix<int>& pivots,
+                                                     const hwTMatrix<double>& B)
 {
     hwMathStatus status;
 
-    if (!D.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 1);
+    if (this == &F)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+    if (this == &B)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    if (!D.IsVector())
-        return status(HW_MATH_ERR_VECTOR, 1);
+    int n = F.m_nCols;
 
-    if (!DL.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 2);
+    if (B.m_nRows != n)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 3);
 
-    if (!DL.IsVector())
-        return status(HW_MATH_ERR_VECTOR, 2);
+    if (!B.IsReal())
+    {
+        // the factors are real, so the real and imaginary parts are independent
+        hwTMatrix<double> re, im, xre, xim;
 
-    if (!DU.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 3);
+        status = B.UnpackComplex(&re, &im);
 
-    if (!DU.IsVector())
-        return status(HW_MATH_ERR_VECTOR, 3);
+        if (status.IsOk())
+            status = xre.SolveFactored(F, pivots, re);
 
-    if (!B.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 4);
+        if (status.IsOk())
+            status = xim.SolveFactored(F, pivots, im);
 
-    if (DL.Size() != D.Size() - 1)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+        if (status.IsOk())
+            status = PackComplex(xre, &xim);
 
-    if (DU.Size() != D.Size() - 1)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1, 3);
+        return status;
+    }
 
-    int n = D.Size();
     int nrhs = B.m_nCols;
     int info;
 
-    if (B.m_nRows != n)
-        return hwMathStatus(HW_MATH_ERR_ARRAYSIZE, 1, 4);
-
     *this = B;
 
     if (B.IsEmpty())
-        return status(HW_MATH_ERR_NONE);
+        return status;
 
     if (IsEmpty())
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    hwTMatrix<double> DC(D);
-    hwTMatrix<double> DLC(DL);
-    hwTMatrix<double> DUC(DU);
-    double* x = m_real;
-    double* d = DC.m_real;
-    double* dl = DLC.m_real;
-    double* du = DUC.m_real;
+    if (pivots.IsEmpty())
+    {
+        char uplo = 'L';
 
-    if (!x)
-        return status(HW_MATH_ERR_ALLOCFAILED);
+        hwBlas::dpotrs_(&uplo, &n, &nrhs, F.m_real, &n, m_real, &n, &info);
+    }
+    else
+    {
+        char trans = 'N';
+        int* ipiv = const_cast<int*>(pivots.GetRealData());     // not written by dgetrs_
 
-    dgtsv_(&n, &nrhs, dl, d, du, x, &n, &info);
+        hwBlas::dgetrs_(&trans, &n, &nrhs, F.m_real, &n, ipiv, m_real, &n, &info);
+    }
 
     if (info != 0)
         status(HW_MATH_ERR_DECOMPFAIL);
@@ -4008,313 +3705,1484 @@ inline hwMathStatus hwTMatrix<double>::LSolveT(const hwTMatrix<double>& D, const
     return status;
 }
 
-//! Solve band linear system AX=B with LU decomposition, where X = *this
+//! Add two matrices so that (*this) = A + B
 template<>
-inline hwMathStatus hwTMatrix<double>::LSolveB(const hwTMatrix<double>& A, int kl, int ku,
-                                               const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::Add(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
 {
-    // To format A see SizeBandMatrix() and SetBandMatrixElem()
     hwMathStatus status;
 
-    if (!A.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 1);
-
-    if (kl < 0 || kl > A.m_nCols - 1)
-        return status(HW_MATH_ERR_KLUD, 2);
-
-    if (ku < 0 || ku > A.m_nCols - 1)
-        return status(HW_MATH_ERR_KLUD, 3);
-
-    int ldab = 2*kl+ku+1;
+    if (this == &A)
+        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+    if (this == &B)
+        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
 
-    if (A.m_nRows != ldab)
-        return status(HW_MATH_ERR_ARRAYDIM, 2, 3);
+    // check dimensions
+    int m = A.m_nRows;
+    int n = A.m_nCols;
+    int64_t size = A.Size();
 
-    if (!B.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 4);
+    if (B.m_nRows != m || B.m_nCols != n)
+    {
+        if (size == 0 && B.Size() == 1)
+            status = Dimension(A.m_nRows, A.m_nCols, REAL);
+        else if (size == 1 && B.Size() == 0)
+            status = Dimension(B.m_nRows, B.m_nCols, REAL);
+        else
+            status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-    if (B.m_nRows != A.m_nCols)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1, 4);
+        return status;
+    }
 
-    int info;
-    int n = A.m_nCols;
-    int nrhs = B.m_nCols;
-    hwTMatrix<int> ipiv(n, hwTMatrix<int>::REAL);     // vector of pivots
-    hwTMatrix<double> decomp(A);
+    // prepare for LAPACK function call
+    int inc = 1;
+    double a[2] = {1.0, 0.0};   // real or complex
 
-    *this = B;
+    if (A.IsReal() && B.IsReal())
+        status = Dimension(m, n, REAL);
+    else
+        status = Dimension(m, n, COMPLEX);
 
-    if (B.IsEmpty())
-        return status(HW_MATH_ERR_NONE);
+    if (!status.IsOk())
+    {
+        status.SetArg1(0);
+        return status;
+    }
 
-    if (IsEmpty())
-        return status(HW_MATH_ERR_ALLOCFAILED);
+    if (A.IsReal() && B.IsReal())
+    {
+        if (size != 0)
+        {
+            double* t_r = m_real;
+            double* a_r = (double*) A.m_real;
+            double* b_r = (double*) B.m_real;
 
-    int* p = ipiv.GetRealData();
-    double* d = decomp.m_real;
-    double* x = m_real;
+            BlasBlocks(size, [&](int64_t k, int count)
+            {
+                hwBlas::dcopy_(&count, a_r + k, &inc, t_r + k, &inc);
+                hwBlas::daxpy_(&count, a, b_r + k, &inc, t_r + k, &inc);
+            });
+        }
+    }
+    else if (!A.IsReal() && !B.IsReal())
+    {
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
+        complexD* b_c = (complexD*) B.m_complex;
 
-    if (!d || !x)
-        return status(HW_MATH_ERR_ALLOCFAILED);
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zcopy_(&count, a_c + k, &inc, t_c + k, &inc);
+            hwBlas::zaxpy_(&count, (complexD*) a, b_c + k, &inc, t_c + k, &inc);
+        });
+    }
+    else if (A.IsReal() && !B.IsReal())
+    {
+        double* t_c = (double*) m_complex;
+        double* a_r = A.m_real;
+        double* b_c = (double*) B.m_complex;
 
-    dgbsv_(&n, &kl, &ku, &nrhs, d, &ldab, p, x, &n, &info);
+        int inc2 = 2;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            int count2 = count << 1;
+            hwBlas::dcopy_(&count2, b_c + 2 * k, &inc, t_c + 2 * k, &inc);
+            hwBlas::daxpy_(&count, a, a_r + k, &inc, t_c + 2 * k, &inc2);
+        });
+    }
+    else // if (!A.IsReal() && B.IsReal())
+    {
+        double* t_c = (double*) m_complex;
+        double* a_c = (double*) A.m_complex;
+        double* b_r = B.m_real;
 
-    if (info != 0)
-        status(HW_MATH_ERR_DECOMPFAIL);
+        int inc2 = 2;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            int count2 = count << 1;
+            hwBlas::dcopy_(&count2, a_c + 2 * k, &inc, t_c + 2 * k, &inc);
+            hwBlas::daxpy_(&count, a, b_r + k, &inc, t_c + 2 * k, &inc2);
+        });
+    }
 
     return status;
 }
 
-//! Solve symmetric positive definite linear system AX=B with Cholesky decomposition,
-//! where X = *this
+//! Add a matrix to the calling object so that (this) += A
 template<>
-inline hwMathStatus hwTMatrix<double>::LSolveSPD(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::AddEquals(const hwTMatrix<double>& A)
 {
     hwMathStatus status;
 
     if (this == &A)
         return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    if (this == &B)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
-
-    hwTMatrix<double>& X = (*this);
-    int m = A.m_nRows;
-    int n = A.m_nCols;
-
-    if (m < n)
-        return status(HW_MATH_ERR_NOTIMPLEMENT);
+    // check dimensions
+    int m = m_nRows;
+    int n = m_nCols;
+    int64_t size = Size();
 
-    if (B.m_nRows != m)
+    if (A.m_nRows != m || A.m_nCols != n)
         return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-    if (!A.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 1);
-
-    if (!B.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 2);
+    if (IsReal() && !A.IsReal())
+    {
+        status = MakeComplex();
 
-    hwTMatrix<double> AA(A);
+        if (!status.IsOk())
+        {
+            status.SetArg1(0);
+            return status;
+        }
+    }
 
-    X = B;
-
-    if (B.IsEmpty())
-        return status(HW_MATH_ERR_NONE);
-
-    if (X.IsEmpty())
-        return status(HW_MATH_ERR_ALLOCFAILED);
-
-    double* a = AA.m_real;
-    double* x = X.m_real;
+    // prepare for LAPACK function call
+    int inc = 1;
+    double a[2] = {1.0, 0.0};   // real or complex
 
-    if (!a || !x)
-        return status(HW_MATH_ERR_ALLOCFAILED);
+    if (IsReal() && A.IsReal())
+    {
+        if (size != 0)
+        {
+            double* t_r = m_real;
+            double* a_r = (double*) A.m_real;
 
-    // decompose the matrix and solve
-    int lda = m;
-    int ldb = m;
-    int info;
-    int bn = B.m_nCols;
-    char UPLO = 'L';
+            BlasBlocks(size, [&](int64_t k, int count)
+            {
+                hwBlas::daxpy_(&count, a, a_r + k, &inc, t_r + k, &inc);
+            });
+        }
+    }
+    else if (!IsReal() && !A.IsReal())
+    {
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
 
-    dposv_(&UPLO, &n, &bn, a, &lda, x, &ldb, &info);
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zaxpy_(&count, (complexD*) a, a_c + k, &inc, t_c + k, &inc);
+        });
+    }
+    else // if (!IsReal() && A.IsReal())
+    {
+        double* t_c = (double*) m_complex;
+        double* a_r = (double*) A.m_real;
 
-    if (info != 0)
-        status(HW_MATH_ERR_MTXNOTSPD, 1);
+        int inc2 = 2;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::daxpy_(&count, a, a_r + k, &inc, t_c + 2 * k, &inc2);
+        });
+    }
 
     return status;
 }
 
-//! Solve SPD tridigonal linear system AX=B with Cholesky decomposition,
-//! where X = *this
+//! Subtract one matrix from another so that (*this) = A - B
 template<>
-inline hwMathStatus hwTMatrix<double>::LSolveSPDT(const hwTMatrix<double>& D, const hwTMatrix<double>& E,
-                                                  const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::Subtr(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
 {
     hwMathStatus status;
 
-    if (!D.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 1);
-
-    if (!D.IsVector())
-        return status(HW_MATH_ERR_VECTOR, 1);
-
-    if (!E.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 2);
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+    if (this == &B)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    if (!E.IsVector())
-        return status(HW_MATH_ERR_VECTOR, 2);
+    // check dimensions
+    int m = A.m_nRows;
+    int n = A.m_nCols;
+    int64_t size = A.Size();
 
-    if (!B.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 3);
+    if (B.m_nRows != m || B.m_nCols != n)
+    {
+        if (size == 0 && B.Size() == 1)
+            status = Dimension(A.m_nRows, A.m_nCols, REAL);
+        else if (size == 1 && B.Size() == 0)
+            status = Dimension(B.m_nRows, B.m_nCols, REAL);
+        else
+            status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-    int n = D.Size();
+        return status;
+    }
 
-    if (E.Size() != n - 1)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+    // prepare for LAPACK function call
+    int inc = 1;
+    double a[2] = {-1.0, 0.0};   // real or complex
 
-    if (B.m_nRows != n)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1, 3);
+    if (A.IsReal() && B.IsReal())
+        status = Dimension(m, n, REAL);
+    else
+        status = Dimension(m, n, COMPLEX);
 
-    *this = B;
+    if (!status.IsOk())
+    {
+        status.SetArg1(0);
+        return status;
+    }
 
-    if (B.IsEmpty())
-        return status(HW_MATH_ERR_NONE);
+    if (A.IsReal() && B.IsReal())
+    {
+        if (size != 0)
+        {
+            double* t_r = m_real;
+            double* a_r = A.m_real;
+            double* b_r = B.m_real;
 
-    if (IsEmpty())
-        return status(HW_MATH_ERR_ALLOCFAILED);
+            BlasBlocks(size, [&](int64_t k, int count)
+            {
+                hwBlas::dcopy_(&count, a_r + k, &inc, t_r + k, &inc);
+                hwBlas::daxpy_(&count, a, b_r + k, &inc, t_r + k, &inc);
+            });
+        }
+    }
+    else if (!A.IsReal() && !B.IsReal())
+    {
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
+        complexD* b_c = (complexD*) B.m_complex;
 
-    hwTMatrix<double> DD(D);
-    hwTMatrix<double> EE(E);
-    double* d = DD.m_real;
-    double* e = EE.m_real;
-    double* x = m_real;
-    int info;
-    int nrhs = B.m_nCols;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zcopy_(&count, a_c + k, &inc, t_c + k, &inc);
+            hwBlas::zaxpy_(&count, (complexD*) a, b_c + k, &inc, t_c + k, &inc);
+        });
+    }
+    else if (A.IsReal() && !B.IsReal())
+    {
+        complexD* t_c = (complexD*) m_complex;
+        double* a_r = A.m_real;
+        complexD* b_c = (complexD*) B.m_complex;
 
-    if (!d || !e || !x)
-        return status(HW_MATH_ERR_ALLOCFAILED);
+        SetElements(0.0);
 
-    dptsv_(&n, &nrhs, d, e, x, &n, &info);
+        int inc2 = 2;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::dcopy_(&count, a_r + k, &inc, (double*) (t_c + k), &inc2);
+            hwBlas::zaxpy_(&count, (complexD*) a, b_c + k, &inc, t_c + k, &inc);
+        });
+    }
+    else // if (!A.IsReal() && B.IsReal())
+    {
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
+        double* b_r = B.m_real;
 
-    if (info != 0)
-        return status(HW_MATH_ERR_DECOMPFAIL);
+        int inc2 = 2;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zcopy_(&count, a_c + k, &inc, t_c + k, &inc);
+            hwBlas::daxpy_(&count, a, b_r + k, &inc, (double*) (t_c + k), &inc2);
+        });
+    }
 
     return status;
 }
 
-//! Solve SPD band linear system AX=B with Cholesky decomposition,
-//! where X = *this
+//! Subtract a matrix from the calling object so that (this) -= A
 template<>
-inline hwMathStatus hwTMatrix<double>::LSolveSPDB(const hwTMatrix<double>& A, int kd,
-                                       const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::SubtrEquals(const hwTMatrix<double>& A)
 {
-    // To format A see SizeSymBandMatrix() and SetSymBandMatrixElem()
     hwMathStatus status;
 
-    if (!A.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 1);
-
-    if (kd < 0 || kd > A.m_nCols - 1)
-        return hwMathStatus(HW_MATH_ERR_KLUD, 2);
-
-    int ldab = kd+1;
-
-    if (A.m_nRows != ldab)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1);
-
-    if (!B.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 3);
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    int n = A.m_nCols;
+    // check dimensions
+    int m = m_nRows;
+    int n = m_nCols;
+    int64_t size = Size();
 
-    if (B.m_nRows != n)
-        return hwMathStatus(HW_MATH_ERR_ARRAYSIZE, 1, 3);
+    if (A.m_nRows != m || A.m_nCols != n)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-    char uplo = 'L';
-    int info;
-    int nrhs = B.m_nCols;
-    hwTMatrix<double> decomp(A);
+    // prepare for LAPACK function call
+    int inc = 1;
+    double a[2] = {-1.0, 0.0};   // real or complex
 
-    *this = B;
+    if (IsReal() && A.IsReal())
+    {
+        if (size != 0)
+        {
+            double* t_r = m_real;
+            double* a_r = A.m_real;
 
-    if (B.IsEmpty())
-        return status(HW_MATH_ERR_NONE);
+            BlasBlocks(size, [&](int64_t k, int count)
+            {
+                hwBlas::daxpy_(&count, a, a_r + k, &inc, t_r + k, &inc);
+            });
+        }
+    }
+    else if (!IsReal() && !A.IsReal())
+    {
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
 
-    if (IsEmpty())
-        return status(HW_MATH_ERR_ALLOCFAILED);
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zaxpy_(&count, (complexD*) &a, a_c + k, &inc, t_c + k, &inc);
+        });
+    }
+    else if (IsReal() && !A.IsReal())
+    {
+        status = MakeComplex();
 
-    double* d = decomp.m_real;
-    double* x = m_real;
+        if (!status.IsOk())
+        {
+            status.SetArg1(0);
+            return status;
+        }
 
-    if (!d || !x)
-        return status(HW_MATH_ERR_ALLOCFAILED);
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
 
-    dpbsv_(&uplo, &n, &kd, &nrhs, d, &ldab, x, &n, &info);
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zaxpy_(&count, (complexD*) &a, a_c + k, &inc, t_c + k, &inc);
+        });
+    }
+    else // if (!IsReal() && A.IsReal())
+    {
+        double* t_c = (double*) m_complex;
+        double* a_r = A.m_real;
 
-    if (info != 0)
-        return status(HW_MATH_ERR_DECOMPFAIL);
+        int inc2 = 2;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::daxpy_(&count, a, a_r + k, &inc, t_c + 2 * k, &inc2);
+        });
+    }
 
     return status;
 }
 
-//! Solve symmetric indefinite linear system AX=B, where X = *this
+//! Multiply two matrices so that (*this) = A * B
 template<>
-inline hwMathStatus hwTMatrix<double>::LSolveSI(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
+inline hwMathStatus hwTMatrix<double>::Mult(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
 {
     hwMathStatus status;
 
-    // check dimensions
-    int m = A.m_nRows;
-    int n = A.m_nCols;
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    if (!A.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 1);
+    if (this == &B)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    if (!B.IsReal())
-        return status(HW_MATH_ERR_COMPLEX, 2);
+    // get dimensions info
+    int m = A.m_nRows;
+    int n = B.m_nCols;
+    int k = A.m_nCols;
 
-    if (A.m_nRows != n)
-        return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
+    if (B.m_nRows != k)
+    {
+        if (A.Size() == 0 && B.Size() == 1)
+            status = Dimension(A.m_nRows, A.m_nCols, REAL);
+        else if (A.Size() == 1 && B.Size() == 0)
+            status = Dimension(B.m_nRows, B.m_nCols, REAL);
+        else
+            status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
 
-    if (B.m_nRows != m)
-        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+        return status;
+    }
+
+    if (A.IsReal() && B.IsReal())
+        status = Dimension(m, n, REAL);
+    else if (A.IsReal() != B.IsReal() && (A.Size() == 0 || B.Size() == 0))
+        status = Dimension(m, n, REAL);
+    else
+        status = Dimension(m, n, COMPLEX);
+
+    if (!status.IsOk())
+    {
+        status.SetArg1(3);
+        return status;
+    }
+
+    if (IsReal() && (A.Size() == 0 || B.Size() == 0))
+    {
+        SetElements(0.0);
+        return status;
+    }
+
+    // small products, including those with an empty dimension, are
+    // computed directly to avoid the BLAS call overhead
+    if ((double) m * (double) n * (double) k <= (double) MULT_SMALL_SIZE)
+    {
+        MultBlocked(A, B);
+        return status;
+    }
+
+    // prepare for LAPACK function call
+    char TRANSA = 'N';
+    char TRANSB = 'N';
+    int LDA = A.m_nRows;
+    int LDB = B.m_nRows;
+    int LDC = A.m_nRows;    // = C.m_nRows
+    double ALPHA[2] = {1.0, 0.0};   // real or complex
+    double BETA[2] = {0.0, 0.0};    // real or complex
+
+    if (A.IsReal() && B.IsReal())
+    {
+        double* t_r = m_real;
+        double* a_r = A.m_real;
+        double* b_r = B.m_real;
+
+        hwBlas::dgemm_(&TRANSA, &TRANSB, &m, &n, &k, ALPHA, a_r, &LDA, b_r, &LDB, BETA, t_r, &LDC);
+    }
+    else if (!A.IsReal() && !B.IsReal())
+    {
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
+        complexD* b_c = (complexD*) B.m_complex;
+
+        hwBlas::zgemm_(&TRANSA, &TRANSB, &m, &n, &k, (complexD*) &ALPHA,
+               a_c, &LDA, b_c, &LDB, (complexD*) &BETA, t_c, &LDC);
+    }
+    else if (A.IsReal() && !B.IsReal())
+    {
+        // multiply A by the side by side real and imaginary parts of B,
+        // [Cr Ci] = A * [Br Bi], which is half the work of a complex product
+        hwTMatrix<double> BS;
+        hwTMatrix<double> CS;
+        int size = k * n;
+        int n2 = n << 1;
+
+        status = BS.Dimension(k, n2, REAL);
+
+        if (!status.IsOk())
+        {
+            status.ResetArgs();
+            return status;
+        }
+
+        status = CS.Dimension(m, n2, REAL);
+
+        if (!status.IsOk())
+        {
+            status.ResetArgs();
+            return status;
+        }
+
+        const double* b_c = (const double*) B.m_complex;
+        double* bs_r = BS.m_real;
+        double* bs_i = BS.m_real + size;
+
+        for (int i = 0; i < size; ++i)
+        {
+            bs_r[i] = b_c[i<<1];
+            bs_i[i] = b_c[(i<<1)+1];
+        }
+
+        hwBlas::dgemm_(&TRANSA, &TRANSB, &m, &n2, &k, ALPHA, A.m_real, &LDA,
+               BS.m_real, &LDB, BETA, CS.m_real, &LDC);
+
+        size = m * n;
+        double* t_c = (double*) m_complex;
+        const double* cs_r = CS.m_real;
+        const double* cs_i = CS.m_real + size;
+
+        for (int i = 0; i < size; ++i)
+        {
+            t_c[i<<1] = cs_r[i];
+            t_c[(i<<1)+1] = cs_i[i];
+        }
+    }
+    else // if (!A.IsReal() && B.IsReal())
+    {
+        // the interleaved complex data of A and C can be treated as real
+        // matrices with twice the number of rows, so that C = A * B
+        int m2 = m << 1;
+        int LDA2 = LDA << 1;
+        int LDC2 = LDC << 1;
+        double* t_c = (double*) m_complex;
+        double* a_c = (double*) A.m_complex;
+        double* b_r = B.m_real;
+
+        hwBlas::dgemm_(&TRANSA, &TRANSB, &m2, &n, &k, ALPHA, a_c, &LDA2, b_r, &LDB, BETA, t_c, &LDC2);
+    }
+
+    return status;
+}
+
+//! Multiply two matrices, using either one transposed, so that
+//! (*this) = op(A) * op(B)
+template<>
+inline hwMathStatus hwTMatrix<double>::MultTrans(const hwTMatrix<double>& A, bool transA,
+                                                 const hwTMatrix<double>& B, bool transB)
+{
+    hwMathStatus status;
+
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+
+    if (this == &B)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+
+    // complex data and scalar factors use the general product
+    if (!A.IsReal() || !B.IsReal() || A.Size() == 1 || B.Size() == 1)
+    {
+        hwTMatrix<double> AT;
+        hwTMatrix<double> BT;
+
+        if (transA)
+            status = AT.Transpose(A);
+
+        if (status.IsOk() && transB)
+            status = BT.Transpose(B);
+
+        if (!status.IsOk())
+        {
+            status.ResetArgs();
+            return status;
+        }
+
+        status = Mult(transA ? AT : A, transB ? BT : B);
+
+        if (status.GetArg2() == 2)
+            status.SetArg2(3);
+
+        return status;
+    }
+
+    // get dimensions info
+    int m = transA ? A.m_nCols : A.m_nRows;
+    int k = transA ? A.m_nRows : A.m_nCols;
+    int n = transB ? B.m_nRows : B.m_nCols;
+
+    if ((transB ? B.m_nCols : B.m_nRows) != k)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 3);
+
+    status = Dimension(m, n, REAL);
+
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
+    }
+
+    if (Size() == 0)
+        return status;
+
+    if (k == 0)
+    {
+        SetElements(0.0);
+        return status;
+    }
+
+    double* a_r = A.m_real;
+    double* b_r = B.m_real;
+    double* t_r = m_real;
+    int LDA = A.m_nRows;
+    int LDB = B.m_nRows;
+    int LDC = m;
+
+    // small products are computed directly to avoid the BLAS call overhead
+    if ((double) m * (double) n * (double) k <= (double) MULT_SMALL_SIZE)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int i = 0; i < m; ++i)
+            {
+                double sum = 0.0;
+
+                for (int p = 0; p < k; ++p)
+                {
+                    double a = transA ? a_r[p + i * LDA] : a_r[i + p * LDA];
+                    double b = transB ? b_r[j + p * LDB] : b_r[p + j * LDB];
+                    sum += a * b;
+                }
+
+                t_r[i + j * LDC] = sum;
+            }
+        }
+
+        return status;
+    }
+
+    double ALPHA = 1.0;
+    double BETA = 0.0;
+    int INC = 1;
+
+    if (a_r == b_r && transA != transB && A.m_nRows == B.m_nRows && A.m_nCols == B.m_nCols)
+    {
+        // A'*A and A*A' are symmetric, so only the upper triangle is
+        // computed and then mirrored
+        char UPLO = 'U';
+        char TRANS = transA ? 'T' : 'N';
+
+        hwBlas::dsyrk_(&UPLO, &TRANS, &m, &k, &ALPHA, a_r, &LDA, &BETA, t_r, &LDC);
+
+        for (int j = 0; j < m; ++j)
+        {
+            for (int i = j + 1; i < m; ++i)
+                t_r[i + j * LDC] = t_r[j + i * LDC];
+        }
+    }
+    else if (n == 1)
+    {
+        // op(A) * x, where the single column of op(B) is contiguous
+        char TRANS = transA ? 'T' : 'N';
+        int am = A.m_nRows;
+        int an = A.m_nCols;
+
+        hwBlas::dgemv_(&TRANS, &am, &an, &ALPHA, a_r, &LDA, b_r, &INC,
+                       &BETA, t_r, &INC);
+    }
+    else if (m == 1)
+    {
+        // x' * op(B) is computed as op(B)' * x
+        char TRANS = transB ? 'N' : 'T';
+        int bm = B.m_nRows;
+        int bn = B.m_nCols;
+
+        hwBlas::dgemv_(&TRANS, &bm, &bn, &ALPHA, b_r, &LDB, a_r, &INC,
+                       &BETA, t_r, &INC);
+    }
+    else
+    {
+        char TRANSA = transA ? 'T' : 'N';
+        char TRANSB = transB ? 'T' : 'N';
+
+        hwBlas::dgemm_(&TRANSA, &TRANSB, &m, &n, &k, &ALPHA, a_r, &LDA, b_r, &LDB,
+                       &BETA, t_r, &LDC);
+    }
+
+    return status;
+}
+
+//! Multiply two single precision matrices so that (*this) = A * B
+template<>
+inline hwMathStatus hwTMatrix<float>::Mult(const hwTMatrix<float>& A, const hwTMatrix<float>& B)
+{
+    hwMathStatus status;
+
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+
+    if (this == &B)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+
+    // get dimensions info
+    int m = A.m_nRows;
+    int n = B.m_nCols;
+    int k = A.m_nCols;
+
+    if (B.m_nRows != k)
+    {
+        if (A.Size() == 0 && B.Size() == 1)
+            status = Dimension(A.m_nRows, A.m_nCols, REAL);
+        else if (A.Size() == 1 && B.Size() == 0)
+            status = Dimension(B.m_nRows, B.m_nCols, REAL);
+        else
+            status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+        return status;
+    }
+
+    if (A.IsReal() && B.IsReal())
+        status = Dimension(m, n, REAL);
+    else if (A.IsReal() != B.IsReal() && (A.Size() == 0 || B.Size() == 0))
+        status = Dimension(m, n, REAL);
+    else
+        status = Dimension(m, n, COMPLEX);
+
+    if (!status.IsOk())
+    {
+        status.SetArg1(3);
+        return status;
+    }
+
+    if (IsReal() && (A.Size() == 0 || B.Size() == 0))
+    {
+        SetElements(0.0);
+        return status;
+    }
+
+    // small products, including those with an empty dimension, are
+    // computed directly to avoid the BLAS call overhead
+    if ((double) m * (double) n * (double) k <= (double) MULT_SMALL_SIZE)
+    {
+        MultBlocked(A, B);
+        return status;
+    }
+
+    // prepare for LAPACK function call
+    char TRANSA = 'N';
+    char TRANSB = 'N';
+    int LDA = A.m_nRows;
+    int LDB = B.m_nRows;
+    int LDC = A.m_nRows;    // = C.m_nRows
+    float ALPHA[2] = {1.0f, 0.0f};  // real or complex
+    float BETA[2] = {0.0f, 0.0f};   // real or complex
+
+    if (A.IsReal() && B.IsReal())
+    {
+        float* t_r = m_real;
+        float* a_r = A.m_real;
+        float* b_r = B.m_real;
+
+        hwBlas::sgemm_(&TRANSA, &TRANSB, &m, &n, &k, ALPHA, a_r, &LDA, b_r, &LDB, BETA, t_r, &LDC);
+    }
+    else if (!A.IsReal() && !B.IsReal())
+    {
+        complexF* t_c = (complexF*) m_complex;
+        complexF* a_c = (complexF*) A.m_complex;
+        complexF* b_c = (complexF*) B.m_complex;
+
+        hwBlas::cgemm_(&TRANSA, &TRANSB, &m, &n, &k, (complexF*) &ALPHA,
+               a_c, &LDA, b_c, &LDB, (complexF*) &BETA, t_c, &LDC);
+    }
+    else if (A.IsReal() && !B.IsReal())
+    {
+        // multiply A by the side by side real and imaginary parts of B,
+        // [Cr Ci] = A * [Br Bi], which is half the work of a complex product
+        hwTMatrix<float> BS;
+        hwTMatrix<float> CS;
+        int size = k * n;
+        int n2 = n << 1;
+
+        status = BS.Dimension(k, n2, REAL);
+
+        if (!status.IsOk())
+        {
+            status.ResetArgs();
+            return status;
+        }
+
+        status = CS.Dimension(m, n2, REAL);
+
+        if (!status.IsOk())
+        {
+            status.ResetArgs();
+            return status;
+        }
+
+        const float* b_c = (const float*) B.m_complex;
+        float* bs_r = BS.m_real;
+        float* bs_i = BS.m_real + size;
+
+        for (int i = 0; i < size; ++i)
+        {
+            bs_r[i] = b_c[i<<1];
+            bs_i[i] = b_c[(i<<1)+1];
+        }
+
+        hwBlas::sgemm_(&TRANSA, &TRANSB, &m, &n2, &k, ALPHA, A.m_real, &LDA,
+               BS.m_real, &LDB, BETA, CS.m_real, &LDC);
+
+        size = m * n;
+        float* t_c = (float*) m_complex;
+        const float* cs_r = CS.m_real;
+        const float* cs_i = CS.m_real + size;
+
+        for (int i = 0; i < size; ++i)
+        {
+            t_c[i<<1] = cs_r[i];
+            t_c[(i<<1)+1] = cs_i[i];
+        }
+    }
+    else // if (!A.IsReal() && B.IsReal())
+    {
+        // the interleaved complex data of A and C can be treated as real
+        // matrices with twice the number of rows, so that C = A * B
+        int m2 = m << 1;
+        int LDA2 = LDA << 1;
+        int LDC2 = LDC << 1;
+        float* t_c = (float*) m_complex;
+        float* a_c = (float*) A.m_complex;
+        float* b_r = B.m_real;
+
+        hwBlas::sgemm_(&TRANSA, &TRANSB, &m2, &n, &k, ALPHA, a_c, &LDA2, b_r, &LDB, BETA, t_c, &LDC2);
+    }
+
+    return status;
+}
+
+//! Multiply a matrix by a real number so that (*this) = A * x
+template<>
+inline hwMathStatus hwTMatrix<double>::Mult(const hwTMatrix<double>& A, double x)
+{
+    hwMathStatus status;
+
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+
+    // get dimensions info
+    int m = A.m_nRows;
+    int n = A.m_nCols;
+    int64_t size = A.Size();
+
+    // prepare for LAPACK function call
+    int inc = 1;
+
+    if (A.IsReal())
+    {
+        status = Dimension(m, n, REAL);
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(0);
+            return status;
+        }
+
+        if (size != 0)
+        {
+            double* t_r = m_real;
+            double* a_r = A.m_real;
+
+            BlasBlocks(size, [&](int64_t k, int count)
+            {
+                hwBlas::dcopy_(&count, a_r + k, &inc, t_r + k, &inc);
+                hwBlas::dscal_(&count, (double*) &x, t_r + k, &inc);
+            });
+        }
+    }
+    else
+    {
+        status = Dimension(m, n, COMPLEX);
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(0);
+            return status;
+        }
+
+        complexD* t_c = (complexD*) m_complex;
+        complexD* a_c = (complexD*) A.m_complex;
+
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            int count2 = count << 1;
+            hwBlas::zcopy_(&count, a_c + k, &inc, t_c + k, &inc);
+            hwBlas::dscal_(&count2, (double*) &x, (double*) (t_c + k), &inc);
+        });
+    }
+
+    return status;
+}
+
+//! Multiply a matrix by a complex number so that (*this) = A * z
+template<>
+inline hwMathStatus hwTMatrix<double>::Mult(const hwTMatrix<double>& A, const hwTComplex<double>& z)
+{
+    hwMathStatus status;    
+    
+    if (this == &A)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+
+    // get dimensions info
+    int m = A.m_nRows;
+    int n = A.m_nCols;
+    int64_t size = A.Size();
+    int inc = 1;
+
+    status = Dimension(m, n, COMPLEX);
+
+    if (!status.IsOk())
+    {
+        status.SetArg1(0);
+        return status;
+    }
+
+    complexD* t_c = (complexD*) m_complex;
+
+    if (A.IsReal())
+    {
+        if (size != 0)
+        {
+            hwTMatrix<double> AC(A);
+
+            AC.MakeComplex();
+            complexD* a_c = (complexD*) AC.m_complex;
+            BlasBlocks(size, [&](int64_t k, int count)
+            {
+                hwBlas::zcopy_(&count, a_c + k, &inc, t_c + k, &inc);
+                hwBlas::zscal_(&count, (complexD*) &z, t_c + k, &inc);
+            });
+        }
+    }
+    else
+    {
+        complexD* a_c = (complexD*) A.m_complex;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zcopy_(&count, a_c + k, &inc, t_c + k, &inc);
+            hwBlas::zscal_(&count, (complexD*) &z, t_c + k, &inc);
+        });
+    }
+
+    return status;
+}
+
+//! Multiply a matrix by a real number so that (*this)* = x
+template<>
+inline void hwTMatrix<double>::MultEquals(double x)
+{
+    int64_t size = Size();
+    int inc = 1;
+
+    if (IsReal())
+    {
+        if (size != 0)
+        {
+            double* t_r = m_real;
+            BlasBlocks(size, [&](int64_t k, int count)
+            {
+                hwBlas::dscal_(&count, (double*) &x, t_r + k, &inc);
+            });
+        }
+    }
+    else
+    {
+        double* t_c = (double*) m_complex;
+
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            int count2 = count << 1;
+            hwBlas::dscal_(&count2, (double*) &x, t_c + 2 * k, &inc);
+        });
+    }
+}
+
+//! Multiply a matrix by a complex number so that (*this)* = z
+template<>
+inline hwMathStatus hwTMatrix<double>::MultEquals(const hwTComplex<double>& z)
+{
+    int64_t size = Size();
+    int inc = 1;
+    hwMathStatus status;
+
+    if (IsReal())
+    {
+        status = MakeComplex();
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(0);
+            return status;
+        }
+    }
+
+    if (size != 0)
+    {
+        complexD* t_c = (complexD*) m_complex;
+        BlasBlocks(size, [&](int64_t k, int count)
+        {
+            hwBlas::zscal_(&count, (complexD*) &z, t_c + k, &inc);
+        });
+    }
+
+    return status;
+}
+
+//! Divide a matrix by a matrix so that (*this) = A \ B, or A(*this) = B
+template<>
+inline hwMathStatus hwTMatrix<double>::DivideLeft(const hwTMatrix<double>& A, const hwTMatrix<double>& B)
+{
+    hwMathStatus status;
+
+    hwSolverPath::Reset();
+
+    if (A.m_nRows == A.m_nCols)
+    {
+        if (B.IsEmpty() && A.Size() == 1)   // treat A as a scalar
+            return Dimension(B.m_nRows, B.m_nCols, hwTMatrix<double>::REAL);
+
+        status = LSolveStructured(A, B);
+    }
+    else
+    {
+        hwSolverPath::Add("qr");
+        status = QRSolve(A, B);
+    }
+
+    if (status == HW_MATH_WARN_MTXNOTFULLRANK || status == HW_MATH_WARN_SINGMATRIXDIV)
+    {
+        hwSolverPath::Add("pinv");
+
+        // status = SVDSolve(A, B);     - this will fail if B contains NaN
+        hwTMatrix<double> P;
+        hwMathStatus status2 = P.Pinv(A);
+
+        if (!status2.IsOk())
+            return status2;
+
+        (*this) = P * B;
+    }
+
+    return status;
+}
+
+//! Divide a matrix by a matrix so that (*this) = B / A, or (*this)A = B
+template<>
+inline hwMathStatus hwTMatrix<double>::DivideRight(const hwTMatrix<double>& B, const hwTMatrix<double>& A)
+{
+    if (this == &A)
+        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+    if (this == &B)
+        return hwMathStatus(HW_MATH_ERR_NOTIMPLEMENT);
+
+    hwTMatrix<double>& X = (*this);
+    hwMathStatus status;
+    hwTMatrix<double> AT;
+    hwTMatrix<double> BT;
+    hwTMatrix<double> XT;
+
+    status = AT.Transpose(A);
+
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
+    }
+
+    status = BT.Transpose(B);
+
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
+    }
+
+    status = XT.Transpose(X);
+
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
+    }
+
+    status = XT.DivideLeft(AT, BT);
+
+    if (!status.IsOk())
+    {
+        if (status.GetArg1() == 1)
+            status.SetArg1(2);
+        else if (status.GetArg1() == 2)
+            status.SetArg1(1);
+
+        if (status.GetArg2() == 2)
+            status.SetArg2(1);
+    }
+
+    hwMathStatus status2 = X.Transpose(XT);
+
+    if (!status2.IsOk())
+    {
+        status2.ResetArgs();
+        return status2;
+    }
+
+    return status;
+}
+
+//! Implement the /= operator with a matrix argument
+template<>
+inline hwMathStatus hwTMatrix<double>::DivideEquals(const hwTMatrix<double>& A)
+{
+    hwTMatrix<double> temp(*this);
+    hwMathStatus status;
+
+    status = DivideRight(A, temp);
+
+    if (!status.IsOk())
+        MakeEmpty();
+
+    return status;
+}
+
+//! Real determinant
+template<>
+inline hwMathStatus hwTMatrix<double>::Determinant(double& det) const
+{
+    const hwTMatrix<double>& A = (*this);
+    hwMathStatus status;
+    int n = A.m_nCols;
+
+    if (A.IsEmpty())
+    {
+        det = 1.0;
+        return status;
+    }
+
+    if (A.m_nRows != n)
+        return status(HW_MATH_ERR_MTXNOTSQUARE, 0);
+
+    if (!A.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 0);
+
+    hwTMatrix<double> B(A);
+    double* a = B.m_real;
+
+    // decompose the matrix
+    int lda = n;
+    int info;
+    int* ipiv;
+
+    try
+    {
+        ipiv = new int[n];
+    }
+    catch (std::bad_alloc&) 
+    {
+        return status(HW_MATH_ERR_ALLOCFAILED);
+    }
+
+    hwBlas::dgetrf_(&n, &n, a, &lda, ipiv, &info); 
+
+    if (info < 0)
+        return status(HW_MATH_ERR_NOTCONVERGE);
+
+    // compute determinant from trace
+    int pivSign = 1;
+
+    for (int i = 0; i < n-1; ++i)
+    {
+        if (i != ipiv[i]-1)
+            pivSign = -pivSign;
+    }
+
+    delete [] ipiv;
+
+    det = (double) pivSign * B(0, 0);
+
+    for (int i = 1; i < n; ++i)
+        det *= B(i, i);
+
+    return status;
+}
+
+//! Complex determinant
+template<>
+inline hwMathStatus hwTMatrix<double>::Determinant(hwTComplex<double>& det) const
+{
+    const hwTMatrix<double>& A = (*this);
+    hwMathStatus status;
+    int n = A.m_nCols;
+
+    if (A.IsEmpty())
+    {
+        det.Set(1.0, 0.0);
+        return status;
+    }
+
+    if (A.m_nRows != n)
+        return status(HW_MATH_ERR_MTXNOTSQUARE, 0);
+
+    if (A.IsReal())
+    {
+        double det_r;
+        status = Determinant(det_r);
+
+        if (!status.IsOk())
+            return status;
+
+        det.Set(det_r, 0.0);
+    }
+
+    hwTMatrix<double> B(A);
+    complexD* a_c = (complexD*) B.m_complex;
+
+    // decompose the matrix
+    int lda = n;
+    int info;
+    int* ipiv;
+
+    try
+    {
+        ipiv = new int[n];
+    }
+    catch (std::bad_alloc&) 
+    {
+        return status(HW_MATH_ERR_ALLOCFAILED);
+    }
+
+    hwBlas::zgetrf_(&n, &n, a_c, &lda, ipiv, &info); 
+
+    if (info < 0)
+        return status(HW_MATH_ERR_NOTCONVERGE);
+
+    // compute determinant from trace
+    int i;
+    int pivSign = 1;
+
+    for (i = 0; i < n-1; ++i)
+    {
+        if (i != ipiv[i]-1)
+            pivSign = -pivSign;
+    }
+
+    delete [] ipiv;
+
+    det = B.z(0, 0) * (double) pivSign;
+
+    for (i = 1; i < n; ++i)
+        det *= B.z(i, i);
+
+    return status;
+}
+
+//! Invert a matrix
+template<>
+inline hwMathStatus hwTMatrix<double>::Inverse(const hwTMatrix<double>& source)
+{
+    hwMathStatus status;
+
+    if (this == &source)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
 
-    // prepare for LAPACK function call
-    char uplo = 'L';
-    int info;
-    int lwork = -1;
-    int nrhs = B.m_nCols;
-    hwTMatrix<int> ipiv(n, hwTMatrix<int>::REAL);     // vector of pivots
-    hwTMatrix<double> decomp(A);
+    hwTMatrix<double>& inv = (*this);
 
-    *this = B;
+    // check dimensions
+    int n = source.m_nCols;
 
-    if (B.IsEmpty())
-        return status(HW_MATH_ERR_NONE);
+    if (source.m_nRows != n)
+        return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
 
-    if (IsEmpty())
-        return status(HW_MATH_ERR_ALLOCFAILED);
+    if (n == 0)
+        return inv.Dimension(0, 0, REAL);
 
-    double* d = decomp.m_real;
-    int* p = ipiv.GetRealData();
-    double* x = m_real;
-    double* work;
-    
-    if (!d || !p || !x)
-        return status(HW_MATH_ERR_ALLOCFAILED);
+    // prepare for LAPACK function call
+    inv = source;
+
+    int lda = n;
+    int info;
+    int lwork = -1;
+    int* ipiv;
 
-    // workspace query
     try
     {
-        work = new double[1];
+        ipiv = new int[n];
     }
     catch (std::bad_alloc&) 
     {
         return status(HW_MATH_ERR_ALLOCFAILED);
     }
 
-    dsysv_(&uplo, &n, &nrhs, d, &n, p, x, &n, work, &lwork, &info);
+    if (source.IsReal())
+    {
+        // decompose the matrix
+        double* a_r = inv.m_real;
+        double* work = NULL;
 
-    if (info != 0)
-        return hwMathStatus(HW_MATH_ERR_DECOMPFAIL, 0);
+        hwBlas::dgetrf_(&n, &n, a_r, &lda, ipiv, &info); 
 
-    lwork = static_cast<int>(work[0]);
-    delete [] work;
+        if (info != 0)
+        {
+            inv.SetElements(std::numeric_limits<double>::infinity());
+            return status(HW_MATH_WARN_SINGMATRIX, 1);
+        }
 
-    try
+        // workspace query
+        try
+        {
+            work = new double[1];
+        }
+        catch (std::bad_alloc&) 
+        {
+            if (ipiv)
+                delete [] ipiv;
+
+            return status(HW_MATH_ERR_ALLOCFAILED);
+        }
+
+        hwBlas::dgetri_(&n, a_r, &lda, ipiv, work, &lwork, &info);
+
+        lwork = static_cast<int>(work[0]);
+        delete [] work;
+
+        // back substitute
+        try
+        {
+            work = new double[lwork];
+        }
+        catch (std::bad_alloc&) 
+        {
+            if (ipiv)
+                delete [] ipiv;
+
+            return status(HW_MATH_ERR_ALLOCFAILED);
+        }
+
+        hwBlas::dgetri_(&n, a_r, &lda, ipiv, work, &lwork, &info);
+
+        delete [] work;
+    }
+    else
     {
-        work = new double[lwork];
+        // decompose the matrix
+        complexD* a_c = (complexD*) inv.m_complex;
+        complexD* work = NULL;
+
+        hwBlas::zgetrf_(&n, &n, a_c, &lda, ipiv, &info); 
+
+        if (info != 0)
+        {
+            inv.SetElements(std::numeric_limits<double>::infinity());
+            return status(HW_MATH_WARN_SINGMATRIX, 1);
+        }
+
+        // workspace query
+        try
+        {
+            work = new complexD[1];
+        }
+        catch (std::bad_alloc&) 
+        {
+            if (ipiv)
+                delete [] ipiv;
+
+            return status(HW_MATH_ERR_ALLOCFAILED);
+        }
+
+        hwBlas::zgetri_(&n, a_c, &lda, ipiv, work, &lwork, &info);
+
+        lwork = static_cast<int>(work[0].real());
+        delete [] work;
+
+        try
+        {
+            work = new complexD[lwork];
+        }
+        catch (std::bad_alloc&) 
+        {
+            if (ipiv)
+                delete [] ipiv;
+
+            return status(HW_MATH_ERR_ALLOCFAILED);
+        }
+
+        // back substitute
+        hwBlas::zgetri_(&n, a_c, &lda, ipiv, work, &lwork, &info);
+
+        delete [] work;
     }
-    catch (std::bad_alloc&) 
+
+    delete [] ipiv;
+
+    return status;
+}
+
+//! Matrix exponential (not a matrix of exponentials)
+template<>
+inline hwMathStatus hwTMatrix<double>::MatExp(const hwTMatrix<double>& power)
+{
+    hwMathStatus status;
+
+    if (this == &power)
+        return status(HW_MATH_ERR_NOTIMPLEMENT);
+
+    hwTMatrix<double>& E = (*this);
+
+    if (!power.IsSquare())
+        return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
+
+    if (power.IsReal())
+        status = E.Dimension(power.m_nRows, power.m_nCols, REAL);
+    else
+        status = E.Dimension(power.m_nRows, power.m_nCols, COMPLEX);
+
+    if (!status.IsOk())
     {
-        return status(HW_MATH_ERR_ALLOCFAILED);
+        if (status.GetArg1() == 0)
+            status.SetArg1(2);
+        else
+            status.ResetArgs();
+
+        return status;
     }
 
-    // solve the system
-    dsysv_(&uplo, &n, &nrhs, d, &n, p, x, &n, work, &lwork, &info);
+    //// scale A
+    // get mag of largest row
+    int n = power.m_nRows;
+    double max = 0.0;
+    double value;
 
-    delete [] work;
+    for (int i = 0; i < n; ++i)
+    {
+        value = 0.0;
+
+        if (power.IsReal())
+        {
+            for (int j = 0; j < n; ++j)
+                value += fabs(power(i, j));
+        }
+        else
+        {
+            for (int j = 0; j < n; ++j)
+                value += power.z(i, j).Mag();
+        }
+
+        if (value > max)
+            max = value;
+    }
+
+    // get scale and divide
+    int exponent;
+    double mantissa;
+    hwTMatrix<double> B;
+
+    mantissa = frexp(max, &exponent);
+
+    if (exponent + 1 > 0)
+        ++exponent;
+    else
+        exponent = 0;
+
+    value = (double) (1 << exponent);
+    status = B.Divide(power, value);
+
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
+    }
+
+    // Pade approximation for exp(A)
+    hwTMatrix<double> X(B);
+    hwTMatrix<double> I(n, n, REAL);
+    hwTMatrix<double> tempM;
+    hwTMatrix<double> D;
+    double c = 0.5;
+
+    I.Identity();
+    tempM = B * c;
+    E = I + tempM;
+    D = I - tempM;
+
+    int q = 6;
+    bool p = true;
+
+    for (int k = 2; k <= q; ++k)
+    {
+        c = c * (q-k+1.0) / (k*(2.0*q-k+1.0));
+        X = B * X;
+        tempM = X * c;
+        E = E + tempM;
+
+        if (p)
+            D = D + tempM;
+        else
+            D = D - tempM;
+
+        p = !p;
+    }
+
+    tempM = E;
+    status = E.DivideLeft(D, tempM);
+
+    if (!status.IsOk())
+    {
+        if (status.GetArg1() == 2) { }
+        else
+            status.ResetArgs();
+
+        return status;
+    }
+
+    // Undo scaling by repeated squaring
+    for (int k = 1; k <= exponent; ++k)
+        E = E * E;
 
     return status;
 }
@@ -4404,7 +5272,7 @@ inline hwMathStatus hwTMatrix<double>::SVDSolve(const hwTMatrix<double>& A, cons
         return status(HW_MATH_ERR_ALLOCFAILED);
     }
 
-    dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
+    hwBlas::dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
             work, &lwork, &info);
 
     lwork = static_cast<int>(work[0]);
@@ -4423,7 +5291,7 @@ inline hwMathStatus hwTMatrix<double>::SVDSolve(const hwTMatrix<double>& A, cons
     }
 
     // decompose the matrix and the solve system
-    dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
+    hwBlas::dgelss_(&m, &n, &nrhs, a_r, &lda, b_r, &ldb, s, &rcond, &rank,
             work, &lwork, &info);
 
     if (info != 0)
@@ -4513,7 +5381,7 @@ inline hwMathStatus hwTMatrix<double>::Csky(hwTMatrix<double>& T, bool upper) co
         else
             UPLO = 'L';
 
-        dpotrf_(&UPLO, &n, t, &lda, &info);
+        hwBlas::dpotrf_(&UPLO, &n, t, &lda, &info);
 
         if (info != 0)
         {
@@ -4635,7 +5503,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompRealSymmetric(hwTMatrix<double
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // workspace query
-    dsyev_(&JOBZ, &UPLO, &n, dVR, &LDA, dD, &WORKSZE, &LWORK, &INFO);
+    hwBlas::dsyev_(&JOBZ, &UPLO, &n, dVR, &LDA, dD, &WORKSZE, &LWORK, &INFO);
 
     if (INFO < 0)
         return status(HW_MATH_ERR_DECOMPFAIL);
@@ -4649,7 +5517,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompRealSymmetric(hwTMatrix<double
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // decompose the matrix
-    dsyev_(&JOBZ, &UPLO, &n, dVR, &LDA, dD, dWORK, &LWORK, &INFO);
+    hwBlas::dsyev_(&JOBZ, &UPLO, &n, dVR, &LDA, dD, dWORK, &LWORK, &INFO);
 
     if (INFO < 0)
         return status(HW_MATH_ERR_DECOMPFAIL);
@@ -4706,7 +5574,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompComplexHermitian(hwTMatrix<dou
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // workspace query
-    zheev_(&JOBZ, &UPLO, &n, dV, &LDA, dD, dWS, &LWORK, dRWK, &INFO);
+    hwBlas::zheev_(&JOBZ, &UPLO, &n, dV, &LDA, dD, dWS, &LWORK, dRWK, &INFO);
 
     if (INFO < 0)
         return status(HW_MATH_ERR_DECOMPFAIL);
@@ -4721,7 +5589,7 @@ inline hwMathStatus hwTMatrix<double>::EigenDecompComplexHermitian(hwTMatrix<dou
         return status(HW_MATH_ERR_ALLOCFAILED);
 
     // decompose the matrix
-    zheev_(&JOBZ, &UPLO, &n, dV, &LDA, dD, dW, &LWORK, dRWK, &INFO);
+    hwBlas::zheev_(&JOBZ, &UPLO, &n, dV, &LDA, dD, dW, &LWORK, dRWK, &INFO);
 
     if (INFO < 0)
         return status(HW_MATH_ERR_DECOMPFAIL);
@@ -4810,7 +5678,7 @@ inline hwMathStatus hwTMatrix<double>::EigenST(const hwTMatrix<double>& D, const
     if (!E.IsVector())
         return status(HW_MATH_ERR_VECTOR, 2);
 
-    int n = D.Size();
+    int n = static_cast<int>(D.Size());
 
     if (E.Size() != n - 1)
         return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
@@ -4835,7 +5703,7 @@ inline hwMathStatus hwTMatrix<double>::EigenST(const hwTMatrix<double>& D, const
 
     char jobz = 'V';
     int info;
-    hwTMatrix<double> work(2 * D.Size() - 2, REAL);
+    hwTMatrix<double> work(2 * n - 2, REAL);
 
     double* w = W.m_real;
     double* z = Z.m_real;
@@ -4845,7 +5713,7 @@ inline hwMathStatus hwTMatrix<double>::EigenST(const hwTMatrix<double>& D, const
     if (!w || !z || !wrk || !e)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    dstev_(&jobz, &n, w, e, z, &n, wrk, &info);
+    hwBlas::dstev_(&jobz, &n, w, e, z, &n, wrk, &info);
 
     if (info != 0)
         return status(HW_MATH_ERR_DECOMPFAIL);
@@ -4909,7 +5777,7 @@ inline hwMathStatus hwTMatrix<double>::EigenSB(int kd, hwTMatrix<double>& W, hwT
     if (!a || !w || !z || !wrk)
         return status(HW_MATH_ERR_ALLOCFAILED);
 
-    dsbev_(&jobz, &uplo, &n, &kd, a, &ldab, w, z, &n, wrk, &info);
+    hwBlas::dsbev_(&jobz, &uplo, &n, &kd, a, &ldab, w, z, &n, wrk, &info);
 
     if (info != 0)
         return status(HW_MATH_ERR_DECOMPFAIL);
@@ -5066,7 +5934,7 @@ inline hwMathStatus hwTMatrix<double>::Cond(double& condNum) const
     if (!status.IsOk())
         return status;
 
-    int nu = S.Size();
+    int nu = static_cast<int>(S.Size());
 
     if (nu)
     {
@@ -5166,10 +6034,10 @@ inline hwMathStatus hwTMatrix<double>::L2Norm(double& norm) const
             return status;
         }
 
-        int n = Size();
+        int n = static_cast<int>(Size());
         int inc = 1;
 
-        norm = dnrm2_(&n, m_real, &inc);
+        norm = hwBlas::dnrm2_(&n, m_real, &inc);
     }
     else
     {
@@ -5203,7 +6071,7 @@ inline hwMathStatus hwTMatrix<double>::Norm(double& norm, int p) const
         if (IsVector())
         {
             NORM = '1';
-            m = Size();
+            m = static_cast<int>(Size());
             n = 1;
         }
         else    //matrix
@@ -5214,9 +6082,9 @@ inline hwMathStatus hwTMatrix<double>::Norm(double& norm, int p) const
         }
 
         if (IsReal())
-            norm = dlange_(&NORM, &m, &n, m_real, &m, Work);
+            norm = hwBlas::dlange_(&NORM, &m, &n, m_real, &m, Work);
         else
-            norm = zlange_(&NORM, &m, &n, (complexD*) m_complex, &m, Work);
+            norm = hwBlas::zlange_(&NORM, &m, &n, (complexD*) m_complex, &m, Work);
     }
     else if (p == 2)
     {
@@ -5254,7 +6122,7 @@ inline hwMathStatus hwTMatrix<double>::Norm(double& norm, int p) const
             return status;
         }
             
-        int count = Size();
+        int64_t count = Size();
         norm = 0.0;
 
         if (IsReal())
@@ -5296,7 +6164,7 @@ inline hwMathStatus hwTMatrix<double>::Norm(double& norm, const char* type) cons
         if (!IsVector())
             return status(HW_MATH_ERR_INVALIDINPUT, 2);
 
-        int count = Size();
+        int64_t count = Size();
 
         if (IsReal())
         {
@@ -5346,7 +6214,7 @@ inline hwMathStatus hwTMatrix<double>::Norm(double& norm, const char* type) cons
 
     if (IsVector())
     {
-        m = Size();
+        m = static_cast<int>(Size());
         n = 1;
     }
     else
@@ -5380,9 +6248,9 @@ inline hwMathStatus hwTMatrix<double>::Norm(double& norm, const char* type) cons
     }
 
     if (IsReal())
-        norm = dlange_(&NORM, &m, &n, m_real, &m, Work);
+        norm = hwBlas::dlange_(&NORM, &m, &n, m_real, &m, Work);
     else    // complex
-        norm = zlange_(&NORM, &m, &n, (complexD*) m_complex, &m, Work);
+        norm = hwBlas::zlange_(&NORM, &m, &n, (complexD*) m_complex, &m, Work);
 
     if (Work)
         delete [] Work;
@@ -5394,7 +6262,7 @@ inline hwMathStatus hwTMatrix<double>::Norm(double& norm, const char* type) cons
 template<>
 inline hwMathStatus hwTMatrix<double>::Normalize()
 {
-    int count = Size();
+    int64_t count = Size();
     double norm;
     hwMathStatus status;
 
@@ -5430,7 +6298,7 @@ inline hwMathStatus hwTMatrix<double>::Dot(const hwTMatrix<double>& A, const hwT
     if (!B.IsEmptyOrVector())
         return hwMathStatus(HW_MATH_ERR_VECTOR, 2);
 
-    int count = A.Size();
+    int count = static_cast<int>(A.Size());
 
     if (B.Size() != count)
         return hwMathStatus(HW_MATH_ERR_ARRAYSIZE, 1, 2);
@@ -5445,7 +6313,7 @@ inline hwMathStatus hwTMatrix<double>::Dot(const hwTMatrix<double>& A, const hwT
         return hwMathStatus();
     }
 
-    dot = ddot_(&count, a_r, &inc, b_r, &inc);
+    dot = hwBlas::ddot_(&count, a_r, &inc, b_r, &inc);
 
     return hwMathStatus();
 }
@@ -5469,7 +6337,7 @@ inline hwMathStatus hwTMatrix<double>::Dot(const hwTMatrix<double>& A, const hwT
         return status;
     }
 
-    int count = A.Size();
+    int count = static_cast<int>(A.Size());
 
     if (B.Size() != count)
         return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
@@ -5514,7 +6382,7 @@ inline hwMathStatus hwTMatrix<double>::Dot(const hwTMatrix<double>& A, const hwT
             return status;
         }
 
-        zdotc_((complexD*) (&dot), &count, a_c, &inc, b_c, &inc);
+        hwBlas::zdotc_((complexD*) (&dot), &count, a_c, &inc, b_c, &inc);
     }
 
     return status;
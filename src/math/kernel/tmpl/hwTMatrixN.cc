@@ -22,8 +22,10 @@
 //:---------------------------------------------------------------------------
 
 #include <algorithm>
+#include <functional>
 #include <hwMathException.h>
 #include <hwSliceArg.h>
+#include <hwThreadPool.h>
 #include <tmpl/hwTComplex.h>
 
 // ****************************************************
@@ -126,6 +128,21 @@ hwTMatrixN<T1, T2>::hwTMatrixN(const hwTMatrixN<T1, T2>& source)
     }
 }
 
+//! Move constructor
+template<typename T1, typename T2>
+hwTMatrixN<T1, T2>::hwTMatrixN(hwTMatrixN<T1, T2>&& source)
+    : m_pos(-1), m_refCount(1)
+{
+    m_bits.ownData = 0;
+    MakeEmpty();
+
+    // shared data cannot be taken from the source
+    if (source.m_refCount > 1)
+        *this = static_cast<const hwTMatrixN<T1, T2>&>(source);
+    else
+        Transfer(source);
+}
+
 //! Destructor
 template<typename T1, typename T2>
 hwTMatrixN<T1, T2>::~hwTMatrixN()
@@ -164,6 +181,21 @@ hwTMatrixN<T1, T2>& hwTMatrixN<T1, T2>::operator=(const hwTMatrixN<T1, T2>& rhs)
     return *this;
 }
 
+//! Implement the move = operator
+template<typename T1, typename T2>
+hwTMatrixN<T1, T2>& hwTMatrixN<T1, T2>::operator=(hwTMatrixN<T1, T2>&& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    if (rhs.m_refCount > 1)
+        return *this = static_cast<const hwTMatrixN<T1, T2>&>(rhs);
+
+    Transfer(rhs);
+
+    return *this;
+}
+
 // ****************************************************
 //               Data Type, Ownership
 // ****************************************************
@@ -175,7 +207,7 @@ bool hwTMatrixN<T1, T2>::IsRealData() const
 {
     if (m_complex)
     {
-        for (int i = 0; i < Size(); ++i)
+        for (int64_t i = 0; i < Size(); ++i)
         {
             if (m_complex[i].Imag() != 0.0)
                 return false;
@@ -366,10 +398,8 @@ void hwTMatrixN<T1, T2>::Reshape(const std::vector<int>& dim)
     SetDimensions(dim);
 
     // check new size
-    int size = 1;
+    int64_t size = 1;
     int emptyDim = -1;
-    size_t maxSize = std::numeric_limits<int>::max();
-    
     for (int i = 0; i < m_dim.size(); ++i)
     {
         // a single element of dim can be set to -1 to allow the function
@@ -392,7 +422,7 @@ void hwTMatrixN<T1, T2>::Reshape(const std::vector<int>& dim)
     {
         if (size)
         {
-            m_dim[emptyDim] = m_size / size;
+            m_dim[emptyDim] = static_cast<int>(m_size / size);
             size *= m_dim[emptyDim];
         }
         else
@@ -411,6 +441,13 @@ void hwTMatrixN<T1, T2>::Permute(const hwTMatrixN<T1, T2>& source, const std::ve
 {
     PermuteCheck(permuteVec);
 
+    if (this == &source)
+    {
+        hwTMatrixN<T1, T2> temp(source);
+        Permute(temp, permuteVec);
+        return;
+    }
+
     // dimension permuted matrix
     MakeEmpty();
     int numDims = static_cast<int> (permuteVec.size());
@@ -431,66 +468,55 @@ void hwTMatrixN<T1, T2>::Permute(const hwTMatrixN<T1, T2>& source, const std::ve
 
     Allocate(source.Type());
 
-    // copy data
-    m_rhsMatrixIndex.clear();
-    m_rhsMatrixIndex.resize(numDims);
+    // describe the copy by the non-singleton dimensions in output order,
+    // with the source stride of each. Neighbors that are also neighbors
+    // in the source are merged, so a permutation that only moves singleton
+    // dimensions becomes a single contiguous block.
+    std::vector<int64_t> sourceStride(sourceDims);
+    std::vector<int64_t> len;
+    std::vector<int64_t> stride;
+    int64_t step = 1;
 
-    if (m_real)
+    for (int k = 0; k < sourceDims; ++k)
     {
-        if (m_size)
-            m_real[0] = source.m_real[0];
-
-        for (int i = 1; i < m_size; ++i)
-        {
-            // advance rhs matrix indices
-            for (int j = 0; j < numDims; ++j)
-            {
-                int k = permuteVec[j];
+        sourceStride[k] = step;
+        step *= source.m_dim[k];
+    }
 
-                // increment index k if possible
-                if (k < sourceDims)
-                {
-                    if (m_rhsMatrixIndex[k] < (int) source.m_dim[k]-1)
-                    {
-                        ++m_rhsMatrixIndex[k];
-                        break;
-                    }
+    for (int i = 0; i < numDims; ++i)
+    {
+        int k = permuteVec[i];
 
-                    // index k is maxed out, so reset and continue to k+1
-                    m_rhsMatrixIndex[k] = 0;
-                }
-            }
+        if (k >= sourceDims || source.m_dim[k] == 1)
+            continue;
 
-            m_real[i] = source(m_rhsMatrixIndex);
+        if (!len.empty() && stride.back() * len.back() == sourceStride[k])
+        {
+            len.back() *= source.m_dim[k];
+        }
+        else
+        {
+            len.push_back(source.m_dim[k]);
+            stride.push_back(sourceStride[k]);
         }
     }
-    else if (m_complex)
-    {
-        if (m_size)
-            m_complex[0] = source.m_complex[0];
 
-        for (int i = 1; i < m_size; ++i)
+    if (m_size)
+    {
+        if (len.size() < 2)
         {
-            // advance rhs matrix indices
-            for (int j = 0; j < numDims; ++j)
-            {
-                int k = permuteVec[j];
-
-                // increment index k if possible
-                if (k < sourceDims)
-                {
-                    if (m_rhsMatrixIndex[k] < (int) source.m_dim[k]-1)
-                    {
-                        ++m_rhsMatrixIndex[k];
-                        break;
-                    }
-
-                    // index k is maxed out, so reset and continue to k+1
-                    m_rhsMatrixIndex[k] = 0;
-                }
-            }
-
-            m_complex[i] = source.z(m_rhsMatrixIndex);
+            if (m_real)
+                CopyData(m_real, m_size, source.m_real, m_size);
+            else
+                CopyData(m_complex, m_size, source.m_complex, m_size);
+        }
+        else if (m_real)
+        {
+            PermuteData(source.m_real, m_real, len, stride);
+        }
+        else
+        {
+            PermuteData(source.m_complex, m_complex, len, stride);
         }
     }
 
@@ -1221,7 +1247,7 @@ void hwTMatrixN<T1, T2>::GrowLHSMatrix(const std::vector<hwSliceArg>& sliceArg,
 
 //! Return the index vector corresponding to a single index
 template<typename T1, typename T2>
-std::vector<int> hwTMatrixN<T1, T2>::IndexVector(int index) const
+std::vector<int> hwTMatrixN<T1, T2>::IndexVector(int64_t index) const
 {
     if (index < 0 || index >= m_size)
         throw hwMathException(HW_MATH_ERR_INVALIDINPUT);
@@ -1230,8 +1256,8 @@ std::vector<int> hwTMatrixN<T1, T2>::IndexVector(int index) const
 
     for (int i = 0; i < indexVec.size(); ++i)
     {
-        int numItems = index / m_dim[i];            // number of complete items in the dimension
-        indexVec[i] = index - numItems * m_dim[i];  // number of remaining items in the dimension
+        int64_t numItems = index / m_dim[i];                            // number of complete items in the dimension
+        indexVec[i] = static_cast<int>(index - numItems * m_dim[i]);  // number of remaining items in the dimension
         index = numItems;
     }
 
@@ -1240,7 +1266,7 @@ std::vector<int> hwTMatrixN<T1, T2>::IndexVector(int index) const
 
 //! Return the single index corresponding to an index vector
 template<typename T1, typename T2>
-int hwTMatrixN<T1, T2>::Index(const std::vector<int>& indexVec) const
+int64_t hwTMatrixN<T1, T2>::Index(const std::vector<int>& indexVec) const
 {
     int numDim = static_cast<int> (indexVec.size());
 
@@ -1252,7 +1278,7 @@ int hwTMatrixN<T1, T2>::Index(const std::vector<int>& indexVec) const
             --numDim;
     }
 
-    int pos = indexVec[numDim-1];
+    int64_t pos = indexVec[numDim-1];
 
     for (int i = numDim-2; i > -1; --i)
         pos = pos * m_dim[i] + indexVec[i];
@@ -1288,12 +1314,11 @@ const T1& hwTMatrixN<T1, T2>::operator()(const std::vector<int>& indexVec) const
 template<typename T1, typename T2>
 void hwTMatrixN<T1, T2>::SetElements(T1 real)
 {
-    int i;
-    int size = Size();
+    int64_t size = Size();
 
     if (m_real)
     {
-        for (i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             m_real[i] = real;
     }
 
@@ -1301,7 +1326,7 @@ void hwTMatrixN<T1, T2>::SetElements(T1 real)
     // the user must manage that if desired
     if (m_complex)
     {
-        for (i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             m_complex[i] = real;
     }
 }
@@ -1350,14 +1375,14 @@ void hwTMatrixN<T1, T2>::SetElements(const T2& cmplx)
         return;
     }
 
-    int size = Size();
+    int64_t size = Size();
 
     if (m_real)
         MakeComplex();
 
     if (m_complex)
     {
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
             m_complex[i] = cmplx;
     }
 }
@@ -1375,10 +1400,9 @@ void hwTMatrixN<T1, T2>::MakeComplex()
 
     Allocate(COMPLEX);
 
-    int i;
-    int size = Size();
+    int64_t size = Size();
 
-    for (i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
     {
         m_complex[i].Real() = m_real[i];
         m_complex[i].Imag() = (T1) 0;
@@ -1414,7 +1438,7 @@ void hwTMatrixN<T1, T2>::PackComplex(const hwTMatrixN<T1, T2>& real, const hwTMa
 
     Dimension(real.m_dim, COMPLEX);
 
-    int size = Size();
+    int64_t size = Size();
     T1* pReal = real.m_real;
     T1* pComplex = reinterpret_cast<T1*> (m_complex);
 
@@ -1473,7 +1497,7 @@ void hwTMatrixN<T1, T2>::UnpackComplex(hwTMatrixN<T1, T2>* real, hwTMatrixN<T1,
         }
     }
 
-    int size = Size();
+    int64_t size = Size();
     T1* pComplex = reinterpret_cast<T1*> (m_complex);
 
     if (real && imag)
@@ -1629,7 +1653,7 @@ void hwTMatrixN<T1, T2>::SliceRHS(const std::vector<hwSliceArg>& sliceArg,
         throw;
     }
 
-    int size = lhsMatrix.Size();
+    int64_t size = lhsMatrix.Size();
 
     if (m_size < size)
         throw hwMathException(HW_MATH_ERR_INVALIDINPUT);
@@ -1678,7 +1702,7 @@ void hwTMatrixN<T1, T2>::SliceRHS(const std::vector<hwSliceArg>& sliceArg,
     m_lhsMatrixIndex.clear();
     m_lhsMatrixIndex.resize(numSlices);
 
-    for (i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
     {
         // copy data up to discontguity
         if (discontiguity == 0)
@@ -2061,7 +2085,7 @@ void hwTMatrixN<T1, T2>::SliceLHS(const std::vector<hwSliceArg>& sliceArg,
 
     // simulate nested loops to iterate over the rhsMatrix elements
     // in order of contiguous memory location, copying blocks where possible
-    int size = rhsMatrix.Size();
+    int64_t size = rhsMatrix.Size();
 
     m_rhsMatrixIndex.clear();
     m_rhsMatrixIndex.resize(numSlices);
@@ -2075,7 +2099,7 @@ void hwTMatrixN<T1, T2>::SliceLHS(const std::vector<hwSliceArg>& sliceArg,
     if (!IsReal() && rhsMatrix.IsReal())
         discontiguity = 0;   // need dcopy to manage this
 
-    for (int i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
     {
         // copy data up to discontguity
         if (discontiguity == 0)
@@ -2325,7 +2349,7 @@ void hwTMatrixN<T1, T2>::SliceLHS(const std::vector<hwSliceArg>& sliceArg, T1 re
 
     // simulate nested loops to iterate over the rhsMatrix elements
     // in order of contiguous memory location, copying blocks where possible
-    int size = 1;    
+    int64_t size = 1;
 
     m_rhsMatrixIndex.clear();
     m_rhsMatrixIndex.resize(numSlices);
@@ -2342,7 +2366,7 @@ void hwTMatrixN<T1, T2>::SliceLHS(const std::vector<hwSliceArg>& sliceArg, T1 re
     if (m_size < size)
         throw hwMathException(HW_MATH_ERR_INVALIDINPUT);
 
-    for (i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
     {
         if (discontiguity == 0)
         {
@@ -2594,7 +2618,7 @@ void hwTMatrixN<T1, T2>::SliceLHS(const std::vector<hwSliceArg>& sliceArg, const
 
     // simulate nested loops to iterate over the rhsMatrix elements
     // in order of contiguous memory location, copying blocks where possible
-    int size = 1;    
+    int64_t size = 1;
 
     m_rhsMatrixIndex.clear();
     m_rhsMatrixIndex.resize(numSlices);
@@ -2611,7 +2635,7 @@ void hwTMatrixN<T1, T2>::SliceLHS(const std::vector<hwSliceArg>& sliceArg, const
     if (m_size < size)
         throw hwMathException(HW_MATH_ERR_INVALIDINPUT);
 
-    for (i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
     {
         if (discontiguity == 0)
         {
@@ -2671,22 +2695,21 @@ void hwTMatrixN<T1, T2>::SliceLHS(const std::vector<hwSliceArg>& sliceArg, const
 template<typename T1, typename T2>
 bool hwTMatrixN<T1, T2>::operator==(const hwTMatrixN<T1, T2>& A) const
 {
-    int i;
     int effDimSize = _min((int) m_dim.size(), (int) A.m_dim.size());
 
-    for (i = 0; i < effDimSize; ++i)
+    for (int i = 0; i < effDimSize; ++i)
     {
         if (m_dim[i] != A.m_dim[i])
             return false;
     }
 
-    for (i = effDimSize; i < m_dim.size(); ++i)
+    for (int i = effDimSize; i < m_dim.size(); ++i)
     {
         if (m_dim[i] != 1)
             return false;
     }
 
-    for (i = effDimSize; i < A.m_dim.size(); ++i)
+    for (int i = effDimSize; i < A.m_dim.size(); ++i)
     {
         if (A.m_dim[i] != 1)
             return false;
@@ -2696,7 +2719,7 @@ bool hwTMatrixN<T1, T2>::operator==(const hwTMatrixN<T1, T2>& A) const
     {
         if (A.IsReal())
         {
-            for (i = 0; i < m_size; ++i)
+            for (int64_t i = 0; i < m_size; ++i)
             {
                 if (m_real[i] != A.m_real[i])
                     return false;
@@ -2704,7 +2727,7 @@ bool hwTMatrixN<T1, T2>::operator==(const hwTMatrixN<T1, T2>& A) const
         }
         else
         {
-            for (i = 0; i < m_size; ++i)
+            for (int64_t i = 0; i < m_size; ++i)
             {
                 if (A.m_complex[i] != m_real[i])
                     return false;
@@ -2715,7 +2738,7 @@ bool hwTMatrixN<T1, T2>::operator==(const hwTMatrixN<T1, T2>& A) const
     {
         if (A.IsReal())
         {
-            for (i = 0; i < m_size; ++i)
+            for (int64_t i = 0; i < m_size; ++i)
             {
                 if (m_complex[i] != A.m_real[i])
                     return false;
@@ -2723,7 +2746,7 @@ bool hwTMatrixN<T1, T2>::operator==(const hwTMatrixN<T1, T2>& A) const
         }
         else
         {
-            for (i = 0; i < m_size; ++i)
+            for (int64_t i = 0; i < m_size; ++i)
             {
                 if (m_complex[i] != A.m_complex[i])
                     return false;
@@ -2741,10 +2764,478 @@ bool hwTMatrixN<T1, T2>::operator!=(const hwTMatrixN<T1, T2>& A) const
     return !((*this) == A);
 }
 
+// ****************************************************
+//            Reductions Along a Dimension
+// ****************************************************
+//  The elements along a dimension form lines whose
+//  entries are inner elements apart. The source is read
+//  once, contiguously, and each line is processed in
+//  increasing order, so the results match those of the
+//  same operation applied to each line as a vector.
+// ****************************************************
+
+//! Sum the elements of a source along a zero based dimension
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::Sum(const hwTMatrixN<T1, T2>& source, int dim)
+{
+    DimensionReduction(source, dim, source.Type());
+
+    int64_t inner, len, outer;
+    source.LineLayout(dim, inner, len, outer);
+
+    if (IsReal())
+        ReduceLines(source.m_real, m_real, inner, len, outer, (T1) 0, std::plus<T1>());
+    else
+        ReduceLines(source.m_complex, m_complex, inner, len, outer, T2(0, 0), std::plus<T2>());
+}
+
+//! Multiply the elements of a source along a zero based dimension
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::Prod(const hwTMatrixN<T1, T2>& source, int dim)
+{
+    DimensionReduction(source, dim, source.Type());
+
+    int64_t inner, len, outer;
+    source.LineLayout(dim, inner, len, outer);
+
+    if (IsReal())
+        ReduceLines(source.m_real, m_real, inner, len, outer, (T1) 1, std::multiplies<T1>());
+    else
+        ReduceLines(source.m_complex, m_complex, inner, len, outer, T2(1, 0), std::multiplies<T2>());
+}
+
+//! Cumulative sum of a source along a zero based dimension
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::CumSum(const hwTMatrixN<T1, T2>& source, int dim)
+{
+    if (this == &source)
+        throw hwMathException(HW_MATH_ERR_NOTIMPLEMENT);
+
+    if (dim < 0)
+        throw hwMathException(HW_MATH_ERR_INVALIDINPUT, 2);
+
+    Dimension(source.m_dim, source.Type());
+
+    int64_t inner, len, outer;
+    source.LineLayout(dim, inner, len, outer);
+
+    if (IsReal())
+        ScanLines(source.m_real, m_real, inner, len, outer, (T1) 0, std::plus<T1>());
+    else
+        ScanLines(source.m_complex, m_complex, inner, len, outer, T2(0, 0), std::plus<T2>());
+}
+
+//! Cumulative product of a source along a zero based dimension
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::CumProd(const hwTMatrixN<T1, T2>& source, int dim)
+{
+    if (this == &source)
+        throw hwMathException(HW_MATH_ERR_NOTIMPLEMENT);
+
+    if (dim < 0)
+        throw hwMathException(HW_MATH_ERR_INVALIDINPUT, 2);
+
+    Dimension(source.m_dim, source.Type());
+
+    int64_t inner, len, outer;
+    source.LineLayout(dim, inner, len, outer);
+
+    if (IsReal())
+        ScanLines(source.m_real, m_real, inner, len, outer, (T1) 1, std::multiplies<T1>());
+    else
+        ScanLines(source.m_complex, m_complex, inner, len, outer, T2(1, 0), std::multiplies<T2>());
+}
+
+//! Largest elements of a source along a zero based dimension, and
+//! optionally their zero based positions
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::Max(const hwTMatrixN<T1, T2>& source, int dim, hwTMatrixN<T1, T2>* index)
+{
+    // a leading NaN is kept, and NaN never replaces anything else
+    if (index == this || index == &source)
+        throw hwMathException(HW_MATH_ERR_NOTIMPLEMENT);
+
+    DimensionReduction(source, dim, source.Type());
+
+    if (index)
+        index->DimensionReduction(source, dim, REAL);
+
+    int64_t inner, len, outer;
+    source.LineLayout(dim, inner, len, outer);
+
+    if (!len)
+    {
+        // there are no elements to choose from
+        Dimension(source.m_dim, REAL);
+
+        if (index)
+            index->Dimension(source.m_dim, REAL);
+
+        return;
+    }
+
+    T1* pos = index ? index->m_real : nullptr;
+
+    if (IsReal())
+        ExtremeLines(source.m_real, m_real, pos, inner, len, outer, std::greater<T1>());
+    else
+        ExtremeLines(source.m_complex, m_complex, pos, inner, len, outer, &ComplexGreater);
+}
+
+//! Smallest elements of a source along a zero based dimension, and
+//! optionally their zero based positions
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::Min(const hwTMatrixN<T1, T2>& source, int dim, hwTMatrixN<T1, T2>* index)
+{
+    // a leading NaN is kept, and NaN never replaces anything else
+    if (index == this || index == &source)
+        throw hwMathException(HW_MATH_ERR_NOTIMPLEMENT);
+
+    DimensionReduction(source, dim, source.Type());
+
+    if (index)
+        index->DimensionReduction(source, dim, REAL);
+
+    int64_t inner, len, outer;
+    source.LineLayout(dim, inner, len, outer);
+
+    if (!len)
+    {
+        // there are no elements to choose from
+        Dimension(source.m_dim, REAL);
+
+        if (index)
+            index->Dimension(source.m_dim, REAL);
+
+        return;
+    }
+
+    T1* pos = index ? index->m_real : nullptr;
+
+    if (IsReal())
+        ExtremeLines(source.m_real, m_real, pos, inner, len, outer, std::less<T1>());
+    else
+        ExtremeLines(source.m_complex, m_complex, pos, inner, len, outer, &ComplexLess);
+}
+
 // ****************************************************
 //                 Private Utilities
 // ****************************************************
 
+//! Split the data into lines along a dimension, with inner elements
+//! between consecutive line entries and outer blocks of inner*len elements
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::LineLayout(int dim, int64_t& inner, int64_t& len, int64_t& outer) const
+{
+    int numDims = static_cast<int> (m_dim.size());
+
+    inner = 1;
+    len = (dim < numDims) ? m_dim[dim] : 1;
+    outer = 1;
+
+    for (int i = 0; i < numDims; ++i)
+    {
+        if (i < dim)
+            inner *= m_dim[i];
+        else if (i > dim)
+            outer *= m_dim[i];
+    }
+}
+
+//! Dimension the calling object for the result of a reduction
+template<typename T1, typename T2>
+void hwTMatrixN<T1, T2>::DimensionReduction(const hwTMatrixN<T1, T2>& source, int dim, DataType dataType)
+{
+    if (this == &source)
+        throw hwMathException(HW_MATH_ERR_NOTIMPLEMENT);
+
+    if (dim < 0)
+        throw hwMathException(HW_MATH_ERR_INVALIDINPUT, 2);
+
+    std::vector<int> dims(source.m_dim);
+
+    if (dim < static_cast<int> (dims.size()))
+        dims[dim] = 1;
+
+    Dimension(dims, dataType);
+}
+
+//! Call block(outer, begin, end) for the lines of each outer block, in
+//! parallel over the outer blocks, or over the inner range when there is one block
+template<typename T1, typename T2>
+template<typename Block>
+void hwTMatrixN<T1, T2>::ForEachLineBlock(int64_t inner, int64_t len, int64_t outer, const Block& block)
+{
+    if (!inner || !outer)
+        return;
+
+    if (outer > 1 || inner == 1)
+    {
+        hwThreadPool::ParallelFor(outer, [&](int64_t begin, int64_t end)
+        {
+            for (int64_t k = begin; k < end; ++k)
+                block(k, 0, inner);
+        }, inner * std::max<int64_t>(len, 1));
+    }
+    else
+    {
+        hwThreadPool::ParallelFor(inner, [&](int64_t begin, int64_t end)
+        {
+            block(0, begin, end);
+        }, std::max<int64_t>(len, 1));
+    }
+}
+
+//! Reduce each line with op, starting from init
+template<typename T1, typename T2>
+template<typename T, typename Op>
+void hwTMatrixN<T1, T2>::ReduceLines(const T* src, T* dest, int64_t inner, int64_t len, int64_t outer, T init, Op op)
+{
+    // for inner > 1 a tile of lines is reduced together, reading each
+    // line entry of the tile contiguously while the tile stays in cache
+    const int tile = 512;
+
+    ForEachLineBlock(inner, len, outer, [=](int64_t k, int64_t begin, int64_t end)
+    {
+        const T* s = src + k * len * inner;
+        T* d = dest + k * inner;
+
+        if (inner == 1)
+        {
+            T value = init;
+
+            for (int64_t j = 0; j < len; ++j)
+                value = op(value, s[j]);
+
+            d[0] = value;
+            return;
+        }
+
+        for (int64_t first = begin; first < end; first += tile)
+        {
+            int64_t last = std::min<int64_t>(first + tile, end);
+
+            for (int64_t i = first; i < last; ++i)
+                d[i] = init;
+
+            for (int64_t j = 0; j < len; ++j)
+            {
+                const T* sj = s + j * inner;
+
+                for (int64_t i = first; i < last; ++i)
+                    d[i] = op(d[i], sj[i]);
+            }
+        }
+    });
+}
+
+//! Compute the running op of each line, starting from init
+template<typename T1, typename T2>
+template<typename T, typename Op>
+void hwTMatrixN<T1, T2>::ScanLines(const T* src, T* dest, int64_t inner, int64_t len, int64_t outer, T init, Op op)
+{
+    ForEachLineBlock(inner, len, outer, [=](int64_t k, int64_t begin, int64_t end)
+    {
+        const T* s = src + k * len * inner;
+        T* d = dest + k * len * inner;
+
+        if (inner == 1)
+        {
+            T value = init;
+
+            for (int64_t j = 0; j < len; ++j)
+            {
+                value = op(value, s[j]);
+                d[j] = value;
+            }
+
+            return;
+        }
+
+        if (!len)
+            return;
+
+        for (int64_t i = begin; i < end; ++i)
+            d[i] = op(init, s[i]);
+
+        for (int64_t j = 1; j < len; ++j)
+        {
+            const T* sj = s + j * inner;
+            const T* dp = d + (j - 1) * inner;
+            T* dj = d + j * inner;
+
+            for (int64_t i = begin; i < end; ++i)
+                dj[i] = op(dp[i], sj[i]);
+        }
+    });
+}
+
+//! Find the first element of each line for which no later element is better
+template<typename T1, typename T2>
+template<typename T, typename Better>
+void hwTMatrixN<T1, T2>::ExtremeLines(const T* src, T* dest, T1* index, int64_t inner, int64_t len, int64_t outer, Better better)
+{
+    // the running extremes of a tile of lines are kept in dest and index
+    const int tile = 512;
+
+    ForEachLineBlock(inner, len, outer, [=](int64_t k, int64_t begin, int64_t end)
+    {
+        const T* s = src + k * len * inner;
+        T* d = dest + k * inner;
+        T1* p = index ? index + k * inner : nullptr;
+
+        for (int64_t first = begin; first < end; first += tile)
+        {
+            int64_t last = std::min<int64_t>(first + tile, end);
+
+            for (int64_t i = first; i < last; ++i)
+                d[i] = s[i];
+
+            if (p)
+            {
+                for (int64_t i = first; i < last; ++i)
+                    p[i] = (T1) 0;
+            }
+
+            for (int64_t j = 1; j < len; ++j)
+            {
+                const T* sj = s + j * inner;
+
+                for (int64_t i = first; i < last; ++i)
+                {
+                    if (better(sj[i], d[i]))
+                    {
+                        d[i] = sj[i];
+
+                        if (p)
+                            p[i] = static_cast<T1> (j);
+                    }
+                }
+            }
+        }
+    });
+}
+
+//! Order complex numbers by magnitude, and then by phase angle
+template<typename T1, typename T2>
+bool hwTMatrixN<T1, T2>::ComplexGreater(const T2& a, const T2& b)
+{
+    T1 diff = b.Mag() - a.Mag();
+
+    if (diff < (T1) 0)
+        return true;
+
+    if (diff > (T1) 0)
+        return false;
+
+    return b.Arg() - a.Arg() < (T1) 0;
+}
+
+//! Gather src into dest, which has dimensions len and column major order,
+//! where stride is the source stride of each dest dimension
+template<typename T1, typename T2>
+template<typename T>
+void hwTMatrixN<T1, T2>::PermuteData(const T* src, T* dest, const std::vector<int64_t>& len,
+                                     const std::vector<int64_t>& stride)
+{
+    int numDims = static_cast<int> (len.size());
+    std::vector<int64_t> destStride(numDims);
+    int64_t step = 1;
+
+    for (int i = 0; i < numDims; ++i)
+    {
+        destStride[i] = step;
+        step *= len[i];
+    }
+
+    // p is the dest dimension that is closest to contiguous in the source
+    int p = 1;
+
+    for (int i = 2; i < numDims; ++i)
+    {
+        if (stride[i] < stride[p])
+            p = i;
+    }
+
+    if (stride[0] == 1)
+    {
+        // dimension 0 is contiguous in both, so copy whole columns
+        int64_t numCols = destStride[numDims-1] * len[numDims-1] / len[0];
+        int64_t colLen  = len[0];
+
+        hwThreadPool::ParallelFor(numCols, [&](int64_t begin, int64_t end)
+        {
+            for (int64_t col = begin; col < end; ++col)
+            {
+                int64_t srcPos = 0;
+                int64_t rem = col;
+
+                for (int i = 1; i < numDims; ++i)
+                {
+                    srcPos += (rem % len[i]) * stride[i];
+                    rem /= len[i];
+                }
+
+                const T* s = src + srcPos;
+                T* d = dest + col * colLen;
+
+                for (int64_t j = 0; j < colLen; ++j)
+                    d[j] = s[j];
+            }
+        }, colLen);
+
+        return;
+    }
+
+    // transpose tiles of dimensions 0 and p, so that both the reads and
+    // the writes of a tile stay within a small set of cache lines
+    const int tile = sizeof(T) > 8 ? 16 : 32;
+    int64_t tiles0 = (len[0] + tile - 1) / tile;
+    int64_t tilesP = (len[p] + tile - 1) / tile;
+    int64_t numRest = destStride[numDims-1] * len[numDims-1] / (len[0] * len[p]);
+    int64_t stride0 = stride[0];
+    int64_t strideP = stride[p];
+    int64_t destStrideP = destStride[p];
+
+    hwThreadPool::ParallelFor(numRest * tilesP * tiles0, [&](int64_t begin, int64_t end)
+    {
+        for (int64_t item = begin; item < end; ++item)
+        {
+            int64_t t0   = item % tiles0;
+            int64_t tP   = (item / tiles0) % tilesP;
+            int64_t rest = item / tiles0 / tilesP;
+
+            int64_t srcPos  = 0;
+            int64_t destPos = 0;
+
+            for (int i = 1; i < numDims; ++i)
+            {
+                if (i == p)
+                    continue;
+
+                int64_t idx = rest % len[i];
+                rest /= len[i];
+                srcPos  += idx * stride[i];
+                destPos += idx * destStride[i];
+            }
+
+            int64_t first0 = t0 * tile;
+            int64_t last0  = std::min(first0 + tile, len[0]);
+            int64_t firstP = tP * tile;
+            int64_t lastP  = std::min(firstP + tile, len[p]);
+
+            for (int64_t jP = firstP; jP < lastP; ++jP)
+            {
+                const T* s = src + srcPos + jP * strideP;
+                T* d = dest + destPos + jP * destStrideP;
+
+                for (int64_t j0 = first0; j0 < last0; ++j0)
+                    d[j0] = s[j0 * stride0];
+            }
+        }
+    }, tile * tile);
+}
+
 //! Set Dimensions
 template<typename T1, typename T2>
 void hwTMatrixN<T1, T2>::SetDimensions(const std::vector<int>& dim)
@@ -2805,8 +3296,8 @@ void hwTMatrixN<T1, T2>::ComputeSize()
         return;
     }
 
-    size_t maxSize = std::numeric_limits<int>::max();
-    
+    int64_t maxSize = std::numeric_limits<int64_t>::max() / static_cast<int64_t>(sizeof(T2));
+
     m_size = m_dim[0];
 
     for (int i = 1; i < m_dim.size(); ++i)
@@ -2824,11 +3315,8 @@ void hwTMatrixN<T1, T2>::ComputeSize()
         }
 
         // detect overflow
-        if (m_dim[i] >= maxSize / (size_t) m_size)
-        {
-            m_size = -1;
-            return;
-        }
+        if (m_dim[i] > maxSize / m_size)
+            throw hwMathException(HW_MATH_ERR_ARRAYTOOLARGE);
 
         m_size *= m_dim[i];
     }
@@ -2840,7 +3328,12 @@ void hwTMatrixN<T1, T2>::SetCapacity(DataType dataType)
 {
     if (m_size > m_capacity)
     {
-        m_capacity = _max(2 * m_capacity, m_size);
+        int64_t maxSize = std::numeric_limits<int64_t>::max() / static_cast<int64_t>(sizeof(T2));
+
+        if (m_capacity > maxSize - m_capacity)
+            m_capacity = maxSize;
+        else
+            m_capacity = _max(2 * m_capacity, m_size);
     }
     else if (m_size < 0)
     {
@@ -2934,7 +3427,7 @@ void hwTMatrixN<T1, T2>::MakeEmpty()
 
 //! Set memory position corresponding to an index vector
 template<typename T1, typename T2>
-int hwTMatrixN<T1, T2>::SetMemoryPosition(const std::vector<int>& indexVec) const
+int64_t hwTMatrixN<T1, T2>::SetMemoryPosition(const std::vector<int>& indexVec) const
 {
     int numDim = _min((int) m_dim.size(), (int) indexVec.size());
 
@@ -3014,20 +3507,27 @@ void hwTMatrixN<T1, T2>::Copy(const hwTMatrixN<T1, T2>& source)
 //! Copy data
 #ifdef _BLAS_LAPACK_h
     template<>
-    inline void hwTMatrixN<double>::CopyData(void* dest, int arraySize, const void* src, int count) const
+    inline void hwTMatrixN<double>::CopyData(void* dest, int64_t arraySize, const void* src, int64_t count) const
     {
+        // the BLAS count is an int, so large arrays are copied in blocks
+        int64_t maxBlock = std::numeric_limits<int>::max();
         int inc = 1;
 
-        if (IsReal())
-            dcopy_((int*) &count, (double*) src, &inc, (double*) dest, &inc);
-        else
-            zcopy_((int*) &count, (complexD*) src, &inc, (complexD*) dest, &inc);
+        for (int64_t start = 0; start < count; start += maxBlock)
+        {
+            int n = static_cast<int>(_min(count - start, maxBlock));
+
+            if (IsReal())
+                hwBlas::dcopy_(&n, (double*) src + start, &inc, (double*) dest + start, &inc);
+            else
+                hwBlas::zcopy_(&n, (complexD*) src + start, &inc, (complexD*) dest + start, &inc);
+        }
     }
 #else
     #include <memory.h>
 
     template<>
-    inline void hwTMatrixN<double>::CopyData(void* dest, int arraySize, const void* src, int count) const
+    inline void hwTMatrixN<double>::CopyData(void* dest, int64_t arraySize, const void* src, int64_t count) const
     {
         if (IsReal())
             memcpy_s(dest, arraySize * sizeof(double), src, count * sizeof(double));
@@ -3037,7 +3537,7 @@ void hwTMatrixN<T1, T2>::Copy(const hwTMatrixN<T1, T2>& source)
 #endif
 
 template<typename T1, typename T2>
-void hwTMatrixN<T1, T2>::CopyData(void* dest, int arraySize, const void* src, int count) const
+void hwTMatrixN<T1, T2>::CopyData(void* dest, int64_t arraySize, const void* src, int64_t count) const
 {
     // memcpy cannot be used here
     if (m_real)
@@ -3045,7 +3545,7 @@ void hwTMatrixN<T1, T2>::CopyData(void* dest, int arraySize, const void* src, in
         T1* destTemp = reinterpret_cast<T1*>(dest);
         const T1* srcTemp = reinterpret_cast<T1*>(const_cast<void *>(src));
         
-        for (int i = 0; i < count; ++i)
+        for (int64_t i = 0; i < count; ++i)
             destTemp[i] = srcTemp[i];
     }
     else if (m_complex)
@@ -3053,7 +3553,7 @@ void hwTMatrixN<T1, T2>::CopyData(void* dest, int arraySize, const void* src, in
         T2* destTemp = reinterpret_cast<T2*>(dest);
         const T2* srcTemp = reinterpret_cast<T2*>(const_cast<void *>(src));
         
-        for (int i = 0; i < count; ++i)
+        for (int64_t i = 0; i < count; ++i)
             destTemp[i] = srcTemp[i];
     }
 }
@@ -3168,9 +3668,9 @@ void hwTMatrixN<T1, T2>::DeleteSlice(const std::vector<hwSliceArg>& sliceArg)
 //! Read a contiguous block from the calling object, as if the calling
 //! object is being sliced on the right hand side of an equals sign
 template<typename T1, typename T2>
-void hwTMatrixN<T1, T2>::CopyBlockRHS(int& pos, int sliceArg, hwTMatrixN<T1, T2>& lhsMatrix) const
+void hwTMatrixN<T1, T2>::CopyBlockRHS(int64_t& pos, int sliceArg, hwTMatrixN<T1, T2>& lhsMatrix) const
 {
-    int numVals = 1;
+    int64_t numVals = 1;
     int numArgs = _min(sliceArg, (int) lhsMatrix.m_dim.size());
 
     for (int i = 0; i < numArgs; ++i)
@@ -3193,9 +3693,9 @@ void hwTMatrixN<T1, T2>::CopyBlockRHS(int& pos, int sliceArg, hwTMatrixN<T1, T2>
 //! Write a contiguous block to the calling object, as if the calling
 //! object is being sliced on the left hand side of an equals sign
 template<typename T1, typename T2>
-void hwTMatrixN<T1, T2>::CopyBlockLHS(int& pos, int sliceArg, const hwTMatrixN<T1, T2>& rhsMatrix)
+void hwTMatrixN<T1, T2>::CopyBlockLHS(int64_t& pos, int sliceArg, const hwTMatrixN<T1, T2>& rhsMatrix)
 {
-    int numVals = 1;
+    int64_t numVals = 1;
     int numArgs = _min(sliceArg, (int) m_dim.size());
 
     for (int i = 0; i < numArgs; ++i)
@@ -3217,15 +3717,15 @@ void hwTMatrixN<T1, T2>::CopyBlockLHS(int& pos, int sliceArg, const hwTMatrixN<T
 //! Write a contiguous block to the calling object, as if the calling
 //! object is being sliced on the left hand side of an equals sign
 template<typename T1, typename T2>
-void hwTMatrixN<T1, T2>::CopyBlockLHS(int& pos, int sliceArg, T1 real)
+void hwTMatrixN<T1, T2>::CopyBlockLHS(int64_t& pos, int sliceArg, T1 real)
 {
-    int numVals = 1;
+    int64_t numVals = 1;
 
     for (int i = 0; i < sliceArg; ++i)
        numVals *= m_dim[i];
 
     // the lhsMatrix block begins at location m_pos, which must be set prior to the function call
-    for (int i = 0; i < numVals; ++i)
+    for (int64_t i = 0; i < numVals; ++i)
        (m_real+m_pos)[i] = real;
 
     pos += numVals;
@@ -3234,15 +3734,15 @@ void hwTMatrixN<T1, T2>::CopyBlockLHS(int& pos, int sliceArg, T1 real)
 //! Write a contiguous block to the calling object, as if the calling
 //! object is being sliced on the left hand side of an equals sign
 template<typename T1, typename T2>
-void hwTMatrixN<T1, T2>::CopyBlockLHS(int& pos, int sliceArg, const T2& cmplx)
+void hwTMatrixN<T1, T2>::CopyBlockLHS(int64_t& pos, int sliceArg, const T2& cmplx)
 {
-    int numVals = 1;
+    int64_t numVals = 1;
 
     for (int i = 0; i < sliceArg; ++i)
        numVals *= m_dim[i];
 
     // the lhsMatrix block begins at location m_pos, which must be set prior to the function call
-    for (int i = 0; i < numVals; ++i)
+    for (int64_t i = 0; i < numVals; ++i)
        (m_complex+m_pos)[i] = cmplx;
 
     pos += numVals;
@@ -3267,12 +3767,12 @@ void hwTMatrixN<T1, T2>::CopyMatrixLHS(const hwTMatrixN<T1, T2>& rhsMatrix)
 
     // simulate nested loops to iterate over the rhsMatrix elements
     // in order of contiguous memory location, copying blocks where possible
-    int size = rhsMatrix.Size();
+    int64_t size = rhsMatrix.Size();
 
     m_rhsMatrixIndex.clear();
     m_rhsMatrixIndex.resize(m_dim.size());
 
-    for (int i = 0; i < size; ++i)
+    for (int64_t i = 0; i < size; ++i)
     {
         if (discontiguity == 0)
         {
@@ -3312,7 +3812,7 @@ void hwTMatrixN<T1, T2>::Transfer(hwTMatrixN<T1, T2>& source)
 {
     Deallocate();
     m_bits = source.m_bits;
-    m_dim = source.m_dim;
+    m_dim.swap(source.m_dim);
     m_size = source.m_size;
     m_capacity = source.m_capacity;
     m_real = source.m_real;
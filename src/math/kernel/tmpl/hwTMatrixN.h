@@ -46,11 +46,19 @@ public:
     hwTMatrixN(const std::vector<int>& dim, void* data, DataType dataType);
     //! Copy constructor
     hwTMatrixN(const hwTMatrixN<T1, T2>& source);
+    //! Move constructor
+    hwTMatrixN(hwTMatrixN<T1, T2>&& source);
 
     //! Destructor
     ~hwTMatrixN();
     //! Implement the = operator
     hwTMatrixN<T1, T2>& operator=(const hwTMatrixN<T1, T2>& rhs);
+    //! Implement the move = operator
+    hwTMatrixN<T1, T2>& operator=(hwTMatrixN<T1, T2>&& rhs);
+    //! Allocate matrix objects from the memory pool
+    static void* operator new(size_t size) { return hwMemoryPool::Allocate(size); }
+    //! Return matrix objects to the memory pool
+    static void operator delete(void* ptr) { hwMemoryPool::Free(ptr); }
 
     // ****************************************************
     //           hwTMatrix conversions functions
@@ -98,7 +106,7 @@ public:
     //! Return a reference to the dimension vector
     const std::vector<int>& Dimensions() const { return m_dim; }
     //! Return the number of elements
-    int Size() const { return m_size; }
+    int64_t Size() const { return m_size; }
     //! Determine if the matrix is empty
     bool IsEmpty() const { return ((m_real || m_complex) ? false : true); }
     //! Determine if the matrix is a vector
@@ -128,9 +136,9 @@ public:
     // ****************************************************
 
     //! Return the index vector corresponding to a single index
-    std::vector<int> IndexVector(int index) const;
+    std::vector<int> IndexVector(int64_t index) const;
     //! Return the single index corresponding to an index vector
-    int Index(const std::vector<int>& indexVec) const;
+    int64_t Index(const std::vector<int>& indexVec) const;
 
     // ****************************************************
     //         Access Functions for Real Elements
@@ -141,9 +149,9 @@ public:
     //! Return the T1* data vector pointer
     T1* GetRealData() { return m_real; }
     //! Return a reference to the real data element at the specified single index
-    T1& operator()(int index) { return m_real[index]; }
+    T1& operator()(int64_t index) { return m_real[index]; }
     //! Return a const reference to the real data element at the specified single index
-    const T1& operator()(int index) const { return m_real[index]; }
+    const T1& operator()(int64_t index) const { return m_real[index]; }
     //! Return a reference to the real data element at the specified indices
     T1& operator()(const std::vector<int>& indexVec);
     //! Return a const reference to the real data element at the specified indices
@@ -160,9 +168,9 @@ public:
     //! Return the T2* data vector pointer
     T2* GetComplexData() { return m_complex; }
     //! Return a reference to the complex data element at the specified single index
-    T2& z(int index) { return m_complex[index]; }
+    T2& z(int64_t index) { return m_complex[index]; }
     //! Return a const reference to the complex data element at the specified single index
-    const T2& z(int index) const { return m_complex[index]; }
+    const T2& z(int64_t index) const { return m_complex[index]; }
     //! Return a reference to the complex data element at the specified indices
     T2& z(const std::vector<int>& indexVec);
     //! Return a const reference to the complex data element at the specified indices
@@ -207,6 +215,25 @@ public:
     //! Implement the != operator
     bool operator!=(const hwTMatrixN<T1, T2>& A) const;
 
+    // ****************************************************
+    //            Reductions Along a Dimension
+    // ****************************************************
+
+    //! Sum the elements of a source along a zero based dimension
+    void Sum(const hwTMatrixN<T1, T2>& source, int dim);
+    //! Multiply the elements of a source along a zero based dimension
+    void Prod(const hwTMatrixN<T1, T2>& source, int dim);
+    //! Cumulative sum of a source along a zero based dimension
+    void CumSum(const hwTMatrixN<T1, T2>& source, int dim);
+    //! Cumulative product of a source along a zero based dimension
+    void CumProd(const hwTMatrixN<T1, T2>& source, int dim);
+    //! Largest elements of a source along a zero based dimension, and
+    //! optionally their zero based positions
+    void Max(const hwTMatrixN<T1, T2>& source, int dim, hwTMatrixN<T1, T2>* index = nullptr);
+    //! Smallest elements of a source along a zero based dimension, and
+    //! optionally their zero based positions
+    void Min(const hwTMatrixN<T1, T2>& source, int dim, hwTMatrixN<T1, T2>* index = nullptr);
+
     // ****************************************************
     //              Copy on Write functions
     // ****************************************************
@@ -236,15 +263,15 @@ private:
     //! Vector of dimensions
     std::vector<int> m_dim;
     //! Utilized size
-    int m_size;
+    int64_t m_size;
     //! Allocated memory capacity (utilized memory may be smaller)
-    int m_capacity;
+    int64_t m_capacity;
     //! Contiguous block of memory to store data of type T1
     T1* m_real;
     //! Contiguous block of memory to store data of type T2, which is hwTComplex<T> by default
     T2* m_complex;
     //! The cached memory index of the last accessed data element
-    mutable int m_pos;
+    mutable int64_t m_pos;
     //! Copy On Write reference counter
     int m_refCount;
     //! Utility vector for left hand side indexing
@@ -269,11 +296,11 @@ private:
     //! Set matrix to empty condition
     void MakeEmpty();
     //! Set memory position corresponding to an index vector
-    int SetMemoryPosition(const std::vector<int>& indexVec) const;
+    int64_t SetMemoryPosition(const std::vector<int>& indexVec) const;
     //! Copy matrix data from a source
     void Copy(const hwTMatrixN<T1, T2>& source);
     //! Copy data
-    void CopyData(void* dest, int arraySize, const void* src, int count) const;
+    void CopyData(void* dest, int64_t arraySize, const void* src, int64_t count) const;
     //! Ignore high dimension singleton indices
     int RelevantNumberOfSlices(const std::vector<hwSliceArg>& sliceArg,
                                bool matrixAssignment) const;
@@ -281,21 +308,48 @@ private:
     void DeleteSlice(const std::vector<hwSliceArg>& sliceArg);
     //! Read a contiguous block from the calling object, as if the calling
     //! object is being sliced on the the right hand side of an equals sign
-    void CopyBlockRHS(int& pos, int sliceArg, hwTMatrixN<T1, T2>& lhsMatrix) const;
+    void CopyBlockRHS(int64_t& pos, int sliceArg, hwTMatrixN<T1, T2>& lhsMatrix) const;
     //! Write a contiguous block to the calling object, as if the calling
     //! object is being sliced on the the left hand side of an equals sign
-    void CopyBlockLHS(int& pos, int sliceArg, const hwTMatrixN<T1, T2>& rhsMatrix);
+    void CopyBlockLHS(int64_t& pos, int sliceArg, const hwTMatrixN<T1, T2>& rhsMatrix);
     //! Write a contiguous block to the calling object, as if the calling
     //! object is being sliced on the the left hand side of an equals sign
-    void CopyBlockLHS(int& pos, int sliceArg, T1 real);
+    void CopyBlockLHS(int64_t& pos, int sliceArg, T1 real);
     //! Write a contiguous block to the calling object, as if the calling
     //! object is being sliced on the the left hand side of an equals sign
-    void CopyBlockLHS(int& pos, int sliceArg, const T2& cmplx);
+    void CopyBlockLHS(int64_t& pos, int sliceArg, const T2& cmplx);
     //! Write a contiguous block to the calling object, as if the calling
     //! object is being sliced on the the left hand side of an equals sign
     void CopyMatrixLHS(const hwTMatrixN<T1, T2>& rhsMatrix);
     //! Transfer contents from another object
     void Transfer(hwTMatrixN<T1, T2>& source);
+    //! Split the data into lines along a dimension, with inner elements
+    //! between consecutive line entries and outer blocks of inner*len elements
+    void LineLayout(int dim, int64_t& inner, int64_t& len, int64_t& outer) const;
+    //! Dimension the calling object for the result of a reduction
+    void DimensionReduction(const hwTMatrixN<T1, T2>& source, int dim, DataType dataType);
+    //! Call block(outer, begin, end) for the lines of each outer block, in
+    //! parallel over the outer blocks, or over the inner range when there is one block
+    template <typename Block>
+    static void ForEachLineBlock(int64_t inner, int64_t len, int64_t outer, const Block& block);
+    //! Reduce each line with op, starting from init
+    template <typename T, typename Op>
+    static void ReduceLines(const T* src, T* dest, int64_t inner, int64_t len, int64_t outer, T init, Op op);
+    //! Compute the running op of each line, starting from init
+    template <typename T, typename Op>
+    static void ScanLines(const T* src, T* dest, int64_t inner, int64_t len, int64_t outer, T init, Op op);
+    //! Find the first element of each line for which no later element is better
+    template <typename T, typename Better>
+    static void ExtremeLines(const T* src, T* dest, T1* index, int64_t inner, int64_t len, int64_t outer, Better better);
+    //! Order complex numbers by magnitude, and then by phase angle
+    static bool ComplexGreater(const T2& a, const T2& b);
+    //! Order complex numbers by magnitude, and then by phase angle
+    static bool ComplexLess(const T2& a, const T2& b) { return ComplexGreater(b, a); }
+    //! Gather src into dest, which has dimensions len and column major order,
+    //! where stride is the source stride of each dest dimension
+    template <typename T>
+    static void PermuteData(const T* src, T* dest, const std::vector<int64_t>& len,
+                            const std::vector<int64_t>& stride);
 };
 
 //! template implementation file
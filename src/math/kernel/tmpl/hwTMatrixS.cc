@@ -0,0 +1,1686 @@
+/**
+* @file hwTMatrixS.cc
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+//:---------------------------------------------------------------------------
+//:Description
+//
+//  hwTMatrixS template function implementation file
+//
+//:---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Globals.h>
+#include <hwMathStatus.h>
+#include <hwMathException.h>
+#include <hwThreadPool.h>
+
+// ****************************************************
+//       Construction / Destruction / Assignment
+// ****************************************************
+
+//! Construct empty matrix
+template<typename T1>
+hwTMatrixS<T1>::hwTMatrixS()
+    : m_nRows(0), m_nCols(0), m_colPtr(1, 0), m_refCount(1)
+{
+}
+
+//! Construct an all zero matrix
+template<typename T1>
+hwTMatrixS<T1>::hwTMatrixS(int m, int n)
+    : m_nRows(m), m_nCols(n), m_refCount(1)
+{
+    if (m < 0 || n < 0)
+        throw hwMathException(HW_MATH_ERR_INVALIDINPUT);
+
+    m_colPtr.assign(n + 1, 0);
+}
+
+//! Construct from a real dense matrix
+template<typename T1>
+hwTMatrixS<T1>::hwTMatrixS(const hwTMatrix<T1>& source)
+    : m_nRows(0), m_nCols(0), m_colPtr(1, 0), m_refCount(1)
+{
+    hwMathStatus status = Convert(source);
+
+    if (!status.IsOk())
+        throw hwMathException(status.GetMsgCode());
+}
+
+//! Copy constructor
+template<typename T1>
+hwTMatrixS<T1>::hwTMatrixS(const hwTMatrixS<T1>& source)
+    : m_nRows(source.m_nRows), m_nCols(source.m_nCols), m_colPtr(source.m_colPtr),
+      m_rowIdx(source.m_rowIdx), m_values(source.m_values), m_refCount(1)
+{
+}
+
+//! Move constructor
+template<typename T1>
+hwTMatrixS<T1>::hwTMatrixS(hwTMatrixS<T1>&& source)
+    : m_nRows(source.m_nRows), m_nCols(source.m_nCols), m_colPtr(std::move(source.m_colPtr)),
+      m_rowIdx(std::move(source.m_rowIdx)), m_values(std::move(source.m_values)), m_refCount(1)
+{
+    source.m_nRows = 0;
+    source.m_nCols = 0;
+    source.m_colPtr.assign(1, 0);
+    source.m_rowIdx.clear();
+    source.m_values.clear();
+}
+
+//! Destructor
+template<typename T1>
+hwTMatrixS<T1>::~hwTMatrixS()
+{
+}
+
+//! Implement the = operator
+template<typename T1>
+hwTMatrixS<T1>& hwTMatrixS<T1>::operator=(const hwTMatrixS<T1>& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    m_nRows  = rhs.m_nRows;
+    m_nCols  = rhs.m_nCols;
+    m_colPtr = rhs.m_colPtr;
+    m_rowIdx = rhs.m_rowIdx;
+    m_values = rhs.m_values;
+
+    return *this;
+}
+
+//! Implement the move = operator
+template<typename T1>
+hwTMatrixS<T1>& hwTMatrixS<T1>::operator=(hwTMatrixS<T1>&& rhs)
+{
+    if (this == &rhs)
+        return *this;
+
+    // the reference count belongs to the object, not to its contents
+    m_nRows  = rhs.m_nRows;
+    m_nCols  = rhs.m_nCols;
+    m_colPtr = std::move(rhs.m_colPtr);
+    m_rowIdx = std::move(rhs.m_rowIdx);
+    m_values = std::move(rhs.m_values);
+
+    rhs.m_nRows = 0;
+    rhs.m_nCols = 0;
+    rhs.m_colPtr.assign(1, 0);
+    rhs.m_rowIdx.clear();
+    rhs.m_values.clear();
+
+    return *this;
+}
+
+// ****************************************************
+//                  Construction Helpers
+// ****************************************************
+
+//! Build from zero based (row, column, value) triplets, summing duplicates
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Assemble(int m, int n, const std::vector<int>& rows,
+                                      const std::vector<int>& cols, const std::vector<T1>& values)
+{
+    hwMathStatus status;
+
+    if (m < 0 || n < 0)
+        return status(HW_MATH_ERR_INVALIDINPUT, 1, 2);
+
+    if (rows.size() != cols.size() || rows.size() != values.size())
+        return status(HW_MATH_ERR_ARRAYSIZE, 3, 4);
+
+    int nz = static_cast<int>(values.size());
+
+    for (int k = 0; k < nz; ++k)
+    {
+        if (rows[k] < 0 || rows[k] >= m)
+            return status(HW_MATH_ERR_INVALIDINDEX, 3);
+        if (cols[k] < 0 || cols[k] >= n)
+            return status(HW_MATH_ERR_INVALIDINDEX, 4);
+    }
+
+    // bucket by row, then stably by column, so that rows end up sorted
+    // within each column without a comparison sort
+    std::vector<int> start(m + 1, 0);
+
+    for (int k = 0; k < nz; ++k)
+        ++start[rows[k] + 1];
+
+    for (int i = 0; i < m; ++i)
+        start[i + 1] += start[i];
+
+    std::vector<int> byRow(nz);
+
+    for (int k = 0; k < nz; ++k)
+        byRow[start[rows[k]]++] = k;
+
+    start.assign(n + 1, 0);
+
+    for (int k = 0; k < nz; ++k)
+        ++start[cols[k] + 1];
+
+    for (int j = 0; j < n; ++j)
+        start[j + 1] += start[j];
+
+    std::vector<int> colPtr(start);
+    std::vector<int> byCol(nz);
+
+    for (int p = 0; p < nz; ++p)
+    {
+        int k = byRow[p];
+        byCol[start[cols[k]]++] = k;
+    }
+
+    m_nRows = m;
+    m_nCols = n;
+    m_colPtr.assign(n + 1, 0);
+    m_rowIdx.clear();
+    m_values.clear();
+    m_rowIdx.reserve(nz);
+    m_values.reserve(nz);
+
+    for (int j = 0; j < n; ++j)
+    {
+        int begin = static_cast<int>(m_rowIdx.size());
+
+        for (int p = colPtr[j]; p < colPtr[j + 1]; ++p)
+        {
+            int k = byCol[p];
+
+            if (static_cast<int>(m_rowIdx.size()) > begin && m_rowIdx.back() == rows[k])
+            {
+                m_values.back() += values[k];
+            }
+            else
+            {
+                m_rowIdx.push_back(rows[k]);
+                m_values.push_back(values[k]);
+            }
+        }
+
+        // remove entries that are zero, including sums that cancelled
+        int end = begin;
+
+        for (int p = begin; p < static_cast<int>(m_rowIdx.size()); ++p)
+        {
+            if (m_values[p] != T1(0))
+            {
+                m_rowIdx[end] = m_rowIdx[p];
+                m_values[end] = m_values[p];
+                ++end;
+            }
+        }
+
+        m_rowIdx.resize(end);
+        m_values.resize(end);
+        m_colPtr[j + 1] = end;
+    }
+
+    return status;
+}
+
+//! Build from a real dense matrix
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Convert(const hwTMatrix<T1>& source)
+{
+    hwMathStatus status;
+
+    if (!source.IsReal())
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
+
+    int m = source.M();
+    int n = source.N();
+    const T1* data = source.GetRealData();
+
+    m_nRows = m;
+    m_nCols = n;
+    m_colPtr.assign(n + 1, 0);
+    m_rowIdx.clear();
+    m_values.clear();
+
+    for (int j = 0; j < n; ++j)
+    {
+        const T1* col = data + static_cast<size_t>(j) * m;
+
+        for (int i = 0; i < m; ++i)
+        {
+            if (col[i] != T1(0))
+            {
+                m_rowIdx.push_back(i);
+                m_values.push_back(col[i]);
+            }
+        }
+
+        m_colPtr[j + 1] = static_cast<int>(m_rowIdx.size());
+    }
+
+    return status;
+}
+
+//! Write the matrix into dense form
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Full(hwTMatrix<T1>& target) const
+{
+    hwMathStatus status = target.Dimension(m_nRows, m_nCols, hwTMatrix<T1>::REAL);
+
+    if (!status.IsOk())
+        return status;
+
+    target.SetElements(T1(0));
+    T1* data = target.GetRealData();
+
+    for (int j = 0; j < m_nCols; ++j)
+    {
+        T1* col = data + static_cast<size_t>(j) * m_nRows;
+
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+            col[m_rowIdx[p]] = m_values[p];
+    }
+
+    return status;
+}
+
+// ****************************************************
+//                 Access Functions
+// ****************************************************
+
+//! Determine if the matrix is symmetric
+template<typename T1>
+bool hwTMatrixS<T1>::IsSymmetric() const
+{
+    if (!IsSquare())
+        return false;
+
+    hwTMatrixS<T1> trans;
+    trans.Transpose(*this);
+
+    return trans.m_colPtr == m_colPtr && trans.m_rowIdx == m_rowIdx &&
+           trans.m_values == m_values;
+}
+
+//! Return an element, which is zero if it is not stored
+template<typename T1>
+T1 hwTMatrixS<T1>::operator()(int i, int j) const
+{
+    const int* begin = m_rowIdx.data() + m_colPtr[j];
+    const int* end   = m_rowIdx.data() + m_colPtr[j + 1];
+    const int* pos   = std::lower_bound(begin, end, i);
+
+    if (pos == end || *pos != i)
+        return T1(0);
+
+    return m_values[pos - m_rowIdx.data()];
+}
+
+// ****************************************************
+//               Arithmetic Operations
+// ****************************************************
+
+//! Transpose the matrix, A'
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Transpose(const hwTMatrixS<T1>& A)
+{
+    hwMathStatus status;
+
+    int m  = A.m_nRows;
+    int n  = A.m_nCols;
+    int nz = A.NNZ();
+
+    std::vector<int> colPtr(m + 1, 0);
+    std::vector<int> rowIdx(nz);
+    std::vector<T1>  values(nz);
+
+    for (int p = 0; p < nz; ++p)
+        ++colPtr[A.m_rowIdx[p] + 1];
+
+    for (int i = 0; i < m; ++i)
+        colPtr[i + 1] += colPtr[i];
+
+    std::vector<int> next(colPtr.begin(), colPtr.end() - 1);
+
+    // visiting the columns in order leaves the new rows sorted
+    for (int j = 0; j < n; ++j)
+    {
+        for (int p = A.m_colPtr[j]; p < A.m_colPtr[j + 1]; ++p)
+        {
+            int q = next[A.m_rowIdx[p]]++;
+            rowIdx[q] = j;
+            values[q] = A.m_values[p];
+        }
+    }
+
+    m_nRows = n;
+    m_nCols = m;
+    m_colPtr.swap(colPtr);
+    m_rowIdx.swap(rowIdx);
+    m_values.swap(values);
+
+    return status;
+}
+
+//! Combine two matrices column by column with a binary operation
+template<typename T1>
+template<typename Op>
+hwMathStatus hwTMatrixS<T1>::Merge(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B,
+                                   bool intersect, Op op)
+{
+    hwMathStatus status;
+
+    if (A.m_nRows != B.m_nRows || A.m_nCols != B.m_nCols)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+    int n = A.m_nCols;
+
+    std::vector<int> colPtr(n + 1, 0);
+    std::vector<int> rowIdx;
+    std::vector<T1>  values;
+
+    rowIdx.reserve(intersect ? std::min(A.NNZ(), B.NNZ()) : A.NNZ() + B.NNZ());
+    values.reserve(rowIdx.capacity());
+
+    for (int j = 0; j < n; ++j)
+    {
+        int pa = A.m_colPtr[j];
+        int pb = B.m_colPtr[j];
+        int ea = A.m_colPtr[j + 1];
+        int eb = B.m_colPtr[j + 1];
+
+        while (pa < ea || pb < eb)
+        {
+            int ra = (pa < ea) ? A.m_rowIdx[pa] : A.m_nRows;
+            int rb = (pb < eb) ? B.m_rowIdx[pb] : B.m_nRows;
+            int row;
+            T1  value;
+
+            if (ra == rb)
+            {
+                row   = ra;
+                value = op(A.m_values[pa++], B.m_values[pb++]);
+            }
+            else if (ra < rb)
+            {
+                row   = ra;
+                value = op(A.m_values[pa++], T1(0));
+
+                if (intersect)
+                    continue;
+            }
+            else
+            {
+                row   = rb;
+                value = op(T1(0), B.m_values[pb++]);
+
+                if (intersect)
+                    continue;
+            }
+
+            if (value != T1(0))
+            {
+                rowIdx.push_back(row);
+                values.push_back(value);
+            }
+        }
+
+        colPtr[j + 1] = static_cast<int>(rowIdx.size());
+    }
+
+    m_nRows = A.m_nRows;
+    m_nCols = n;
+    m_colPtr.swap(colPtr);
+    m_rowIdx.swap(rowIdx);
+    m_values.swap(values);
+
+    return status;
+}
+
+//! Add two matrices, A+B
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Add(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B)
+{
+    return Merge(A, B, false, [](T1 a, T1 b) { return a + b; });
+}
+
+//! Subtract two matrices, A-B
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Subtr(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B)
+{
+    return Merge(A, B, false, [](T1 a, T1 b) { return a - b; });
+}
+
+//! Multiply two matrices element by element, A.*B
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::MultByElems(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B)
+{
+    return Merge(A, B, true, [](T1 a, T1 b) { return a * b; });
+}
+
+//! Multiply two matrices, A*B
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Mult(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B)
+{
+    hwMathStatus status;
+
+    if (A.m_nCols != B.m_nRows)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+    int m = A.m_nRows;
+    int n = B.m_nCols;
+
+    std::vector<int> colPtr(n + 1, 0);
+    std::vector<int> rowIdx;
+    std::vector<T1>  values;
+    std::vector<int> mark(m, -1);
+    std::vector<T1>  work(m, T1(0));
+    std::vector<int> pattern;
+
+    // Gustavson's algorithm: column j of the result is a combination of the
+    // columns of A selected by the nonzeros in column j of B
+    for (int j = 0; j < n; ++j)
+    {
+        pattern.clear();
+
+        for (int pb = B.m_colPtr[j]; pb < B.m_colPtr[j + 1]; ++pb)
+        {
+            int k = B.m_rowIdx[pb];
+            T1  b = B.m_values[pb];
+
+            for (int pa = A.m_colPtr[k]; pa < A.m_colPtr[k + 1]; ++pa)
+            {
+                int i = A.m_rowIdx[pa];
+
+                if (mark[i] != j)
+                {
+                    mark[i] = j;
+                    work[i] = A.m_values[pa] * b;
+                    pattern.push_back(i);
+                }
+                else
+                {
+                    work[i] += A.m_values[pa] * b;
+                }
+            }
+        }
+
+        std::sort(pattern.begin(), pattern.end());
+
+        for (size_t q = 0; q < pattern.size(); ++q)
+        {
+            int i = pattern[q];
+
+            if (work[i] != T1(0))
+            {
+                rowIdx.push_back(i);
+                values.push_back(work[i]);
+            }
+        }
+
+        colPtr[j + 1] = static_cast<int>(rowIdx.size());
+    }
+
+    m_nRows = m;
+    m_nCols = n;
+    m_colPtr.swap(colPtr);
+    m_rowIdx.swap(rowIdx);
+    m_values.swap(values);
+
+    return status;
+}
+
+//! Multiply a matrix by a real number, A*s
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Mult(const hwTMatrixS<T1>& A, T1 s)
+{
+    if (this != &A)
+        *this = A;
+
+    MultEquals(s);
+
+    return hwMathStatus();
+}
+
+//! Multiply the calling object by a real number
+template<typename T1>
+void hwTMatrixS<T1>::MultEquals(T1 s)
+{
+    if (s == T1(0))
+    {
+        m_colPtr.assign(m_nCols + 1, 0);
+        m_rowIdx.clear();
+        m_values.clear();
+        return;
+    }
+
+    for (size_t p = 0; p < m_values.size(); ++p)
+        m_values[p] *= s;
+}
+
+//! Multiply a sparse and a dense matrix element by element, A.*B
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::MultByElems(const hwTMatrixS<T1>& A, const hwTMatrix<T1>& B)
+{
+    hwMathStatus status;
+
+    if (A.m_nRows != B.M() || A.m_nCols != B.N())
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 2);
+
+    if (this != &A)
+        *this = A;
+
+    int end = 0;
+
+    for (int j = 0; j < m_nCols; ++j)
+    {
+        int begin = m_colPtr[j];
+        m_colPtr[j] = end;
+
+        for (int p = begin; p < m_colPtr[j + 1]; ++p)
+        {
+            T1 value = m_values[p] * B(m_rowIdx[p], j);
+
+            if (value != T1(0))
+            {
+                m_rowIdx[end] = m_rowIdx[p];
+                m_values[end] = value;
+                ++end;
+            }
+        }
+    }
+
+    m_colPtr[m_nCols] = end;
+    m_rowIdx.resize(end);
+    m_values.resize(end);
+
+    return status;
+}
+
+//! Multiply the calling object by a dense matrix, C = this*B
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::MultRight(const hwTMatrix<T1>& B, hwTMatrix<T1>& C) const
+{
+    hwMathStatus status;
+
+    if (m_nCols != B.M())
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 2);
+
+    int m = m_nRows;
+    int k = B.N();
+
+    status = C.Dimension(m, k, hwTMatrix<T1>::REAL);
+
+    if (!status.IsOk())
+        return status;
+
+    C.SetElements(T1(0));
+
+    const T1* b = B.GetRealData();
+    T1*       c = C.GetRealData();
+    int       n = m_nCols;
+
+    // the columns of the result are independent
+    hwThreadPool::ParallelFor(k, [=](int64_t begin, int64_t end)
+    {
+        for (int64_t q = begin; q < end; ++q)
+        {
+            const T1* bq = b + static_cast<size_t>(q) * n;
+            T1*       cq = c + static_cast<size_t>(q) * m;
+
+            for (int j = 0; j < n; ++j)
+            {
+                T1 bj = bq[j];
+
+                if (bj == T1(0))
+                    continue;
+
+                for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+                    cq[m_rowIdx[p]] += m_values[p] * bj;
+            }
+        }
+    }, NNZ());
+
+    return status;
+}
+
+//! Multiply a dense matrix by the calling object, C = A*this
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::MultLeft(const hwTMatrix<T1>& A, hwTMatrix<T1>& C) const
+{
+    hwMathStatus status;
+
+    if (A.N() != m_nRows)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+    if (!A.IsReal())
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
+
+    int m = A.M();
+    int n = m_nCols;
+
+    status = C.Dimension(m, n, hwTMatrix<T1>::REAL);
+
+    if (!status.IsOk())
+        return status;
+
+    C.SetElements(T1(0));
+
+    const T1* a = A.GetRealData();
+    T1*       c = C.GetRealData();
+
+    // column j of the result combines the columns of A selected by column j
+    hwThreadPool::ParallelFor(n, [=](int64_t begin, int64_t end)
+    {
+        for (int64_t j = begin; j < end; ++j)
+        {
+            T1* cj = c + static_cast<size_t>(j) * m;
+
+            for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+            {
+                const T1* ai = a + static_cast<size_t>(m_rowIdx[p]) * m;
+                T1        v  = m_values[p];
+
+                for (int i = 0; i < m; ++i)
+                    cj[i] += ai[i] * v;
+            }
+        }
+    }, m);
+
+    return status;
+}
+
+// ****************************************************
+//                  Linear Algebra
+// ****************************************************
+
+//! Solve the system this*X = B with a sparse direct factorization
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::LSolve(const hwTMatrix<T1>& B, hwTMatrix<T1>& X) const
+{
+    hwMathStatus status;
+
+    if (B.M() != m_nRows)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+    if (&X == &B)
+    {
+        hwTMatrix<T1> copy(B);
+        return LSolve(copy, X);
+    }
+
+    if (!B.IsReal())
+    {
+        // the matrix is real, so the real and imaginary parts are independent
+        hwTMatrix<T1> re, im, xre, xim;
+
+        status = B.UnpackComplex(&re, &im);
+
+        if (status.IsOk())
+            status = LSolve(re, xre);
+
+        if (status.IsOk())
+            status = LSolve(im, xim);
+
+        if (status.IsOk())
+            status = X.PackComplex(xre, &xim);
+
+        return status;
+    }
+
+    if (!IsSquare())
+        return LeastSquares(B, X);
+
+    X = B;
+
+    if (IsEmpty())
+        return status;
+
+    hwTMatrixS<T1>   L;
+    hwTMatrixS<T1>   U;
+    std::vector<int> rowPerm;
+    std::vector<int> colPerm;
+
+    status = Factor(L, U, rowPerm, colPerm);
+
+    if (!status.IsOk() && !status.IsWarning())
+        return status;
+
+    // keep a singular matrix warning from the factorization
+    hwMathStatus solveStatus = SolveFactored(L, U, rowPerm, colPerm, X);
+
+    if (!solveStatus.IsOk())
+        return solveStatus;
+
+    return status;
+}
+
+//! Solve the non-square system this*X = B in the least squares sense
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::LeastSquares(const hwTMatrix<T1>& B, hwTMatrix<T1>& X) const
+{
+    hwMathStatus status;
+
+    // A full rank overdetermined system is solved with the semi-normal
+    // equations R'*R*X = A'*B, where R'*R is the sparse Cholesky factor of
+    // A'*A, followed by one step of iterative refinement. This keeps memory
+    // proportional to the nonzeros of A and R, and is accurate while
+    // cond(A) is well below 1/sqrt(eps), which the Cholesky pivots check.
+    if (m_nRows > m_nCols && m_nCols > 0)
+    {
+        hwTMatrixS<T1>   At;
+        hwTMatrixS<T1>   AtA;
+        hwTMatrixS<T1>   L;
+        hwTMatrixS<T1>   U;
+        std::vector<int> rowPerm;
+        std::vector<int> colPerm;
+
+        status = At.Transpose(*this);
+
+        if (status.IsOk())
+            status = AtA.Mult(At, *this);
+
+        if (status.IsOk())
+            status = AtA.Factor(L, U, rowPerm, colPerm);
+
+        if (status.IsOk() && U.IsEmpty())
+        {
+            hwTMatrix<T1> AX;
+            hwTMatrix<T1> R;
+            hwTMatrix<T1> D;
+
+            status = At.MultRight(B, X);
+
+            if (status.IsOk())
+                status = SolveFactored(L, U, rowPerm, colPerm, X);
+
+            if (status.IsOk())
+                status = MultRight(X, AX);
+
+            if (status.IsOk())
+                status = R.Subtr(B, AX);
+
+            if (status.IsOk())
+                status = At.MultRight(R, D);
+
+            if (status.IsOk())
+                status = SolveFactored(L, U, rowPerm, colPerm, D);
+
+            if (status.IsOk())
+                status = X.AddEquals(D);
+
+            return status;
+        }
+
+        if (status.GetMsgCode() == HW_MATH_ERR_ALLOCFAILED)
+            return status;
+
+        status = hwMathStatus();
+    }
+
+    // Underdetermined and rank deficient systems are expanded and solved
+    // as A\B is for full matrices, with QR and a pseudoinverse fallback. The
+    // expansion needs M()*N() values, which limits these cases to sizes that
+    // fit in memory as dense matrices.
+    hwTMatrix<T1> A;
+
+    status = Full(A);
+
+    if (!status.IsOk())
+        return status;
+
+    return X.DivideLeft(A, B);
+}
+
+//! Factor the matrix for repeated solves with SolveFactored
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::Factor(hwTMatrixS<T1>&   L,
+                                    hwTMatrixS<T1>&   U,
+                                    std::vector<int>& rowPerm,
+                                    std::vector<int>& colPerm) const
+{
+    hwMathStatus status;
+
+    if (!IsSquare())
+        return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
+
+    OrderMinDegree(colPerm);
+
+    bool positiveDiag = IsSymmetric();
+
+    for (int j = 0; positiveDiag && j < m_nCols; ++j)
+        positiveDiag = (*this)(j, j) > T1(0);
+
+    // Cholesky needs half the storage and no pivoting, and is attempted on
+    // any symmetric matrix with a positive diagonal. If it breaks down the
+    // matrix is indefinite, and LU with a strong preference for diagonal
+    // pivots keeps the symmetric ordering.
+    if (positiveDiag)
+    {
+        status = FactorCholesky(colPerm, L);
+
+        if (status.IsOk() || status.IsWarning())
+        {
+            U = hwTMatrixS<T1>();
+            rowPerm.resize(m_nCols);
+
+            for (int k = 0; k < m_nCols; ++k)
+                rowPerm[colPerm[k]] = k;
+
+            return status;
+        }
+
+        return FactorLU(colPerm, T1(0.001), L, U, rowPerm);
+    }
+
+    return FactorLU(colPerm, T1(0.1), L, U, rowPerm);
+}
+
+//! Solve L*U*Y = B(rowPerm,:), or L*L'*Y = B(rowPerm,:) if U is empty,
+//! and return X(colPerm,:) = Y
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::SolveFactored(const hwTMatrixS<T1>&   L,
+                                           const hwTMatrixS<T1>&   U,
+                                           const std::vector<int>& rowPerm,
+                                           const std::vector<int>& colPerm,
+                                           hwTMatrix<T1>&          X)
+{
+    hwMathStatus status;
+
+    int n = L.N();
+
+    if (X.M() != n)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 5);
+
+    if (!X.IsReal())
+        return status(HW_MATH_ERR_COMPLEX, 5);
+
+    const int* lp = L.ColPointers();
+    const int* li = L.RowIndices();
+    const T1*  lx = L.Values();
+    bool       cholesky = U.IsEmpty();
+    const int* up = U.ColPointers();
+    const int* ui = U.RowIndices();
+    const T1*  ux = U.Values();
+
+    std::vector<T1> y(n);
+
+    for (int c = 0; c < X.N(); ++c)
+    {
+        T1* b = X.GetRealData() + static_cast<size_t>(c) * n;
+
+        for (int i = 0; i < n; ++i)
+            y[rowPerm[i]] = b[i];
+
+        // L has its diagonal stored first in each column, which is one
+        // for LU
+        for (int j = 0; j < n; ++j)
+        {
+            if (cholesky)
+                y[j] /= lx[lp[j]];
+
+            for (int p = lp[j] + 1; p < lp[j + 1]; ++p)
+                y[li[p]] -= lx[p] * y[j];
+        }
+
+        if (cholesky)
+        {
+            // L'*z = y
+            for (int j = n - 1; j >= 0; --j)
+            {
+                for (int p = lp[j] + 1; p < lp[j + 1]; ++p)
+                    y[j] -= lx[p] * y[li[p]];
+
+                y[j] /= lx[lp[j]];
+            }
+        }
+        else
+        {
+            // U has its diagonal stored last in each column
+            for (int j = n - 1; j >= 0; --j)
+            {
+                y[j] /= ux[up[j + 1] - 1];
+
+                for (int p = up[j]; p < up[j + 1] - 1; ++p)
+                    y[ui[p]] -= ux[p] * y[j];
+            }
+        }
+
+        for (int k = 0; k < n; ++k)
+            b[colPerm[k]] = y[k];
+    }
+
+    return status;
+}
+
+//! Incomplete LU factorization of A with no fill, where the unit lower
+//! and upper factors share the pattern of A, LU = *this
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::ILU0(const hwTMatrixS<T1>& A)
+{
+    hwMathStatus status;
+
+    if (!A.IsSquare())
+        return status(HW_MATH_ERR_MTXNOTSQUARE, 1);
+
+    if (this != &A)
+        *this = A;
+
+    int n = m_nCols;
+    std::vector<int> pos(n, -1);
+
+    // left-looking by columns. The entries of column j above the diagonal
+    // are final in increasing row order, and each one, u(k,j), removes
+    // u(k,j)*L(:,k) from the entries of column j that are in the pattern.
+    for (int j = 0; j < n; ++j)
+    {
+        int diag = -1;
+
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+        {
+            pos[m_rowIdx[p]] = p;
+
+            if (m_rowIdx[p] == j)
+                diag = p;
+        }
+
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1] && m_rowIdx[p] < j; ++p)
+        {
+            int k   = m_rowIdx[p];
+            T1  ukj = m_values[p];
+
+            if (ukj == T1(0))
+                continue;
+
+            for (int q = m_colPtr[k + 1] - 1; q >= m_colPtr[k] && m_rowIdx[q] > k; --q)
+            {
+                int dest = pos[m_rowIdx[q]];
+
+                if (dest >= 0)
+                    m_values[dest] -= m_values[q] * ukj;
+            }
+        }
+
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+            pos[m_rowIdx[p]] = -1;
+
+        if (diag < 0 || m_values[diag] == T1(0))
+            return status(HW_MATH_ERR_DIVIDEZERO);
+
+        T1 pivot = m_values[diag];
+
+        for (int p = diag + 1; p < m_colPtr[j + 1]; ++p)
+            m_values[p] /= pivot;
+    }
+
+    return status;
+}
+
+//! Solve L*U*X = B with the factors from ILU0
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::ILUSolve(const hwTMatrix<T1>& B, hwTMatrix<T1>& X) const
+{
+    hwMathStatus status;
+
+    if (B.M() != m_nRows)
+        return status(HW_MATH_ERR_ARRAYSIZE, 1, 2);
+
+    if (!B.IsReal())
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 1);
+
+    if (&X != &B)
+        X = B;
+
+    int n = m_nCols;
+
+    for (int c = 0; c < X.N(); ++c)
+    {
+        T1* y = X.GetRealData() + static_cast<size_t>(c) * n;
+
+        // L has a unit diagonal and is stored below it
+        for (int j = 0; j < n; ++j)
+        {
+            for (int p = m_colPtr[j + 1] - 1; p >= m_colPtr[j] && m_rowIdx[p] > j; --p)
+                y[m_rowIdx[p]] -= m_values[p] * y[j];
+        }
+
+        // U is stored on and above the diagonal
+        for (int j = n - 1; j >= 0; --j)
+        {
+            int p = m_colPtr[j];
+
+            for (; m_rowIdx[p] < j; ++p)
+                ;
+
+            y[j] /= m_values[p];
+
+            for (p = m_colPtr[j]; m_rowIdx[p] < j; ++p)
+                y[m_rowIdx[p]] -= m_values[p] * y[j];
+        }
+    }
+
+    return status;
+}
+
+//! Approximate minimum degree ordering of the pattern of A+A'
+template<typename T1>
+void hwTMatrixS<T1>::OrderMinDegree(std::vector<int>& perm) const
+{
+    int n = m_nCols;
+
+    std::vector<int> count(n, 0);
+
+    for (int j = 0; j < n; ++j)
+    {
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+        {
+            if (m_rowIdx[p] != j)
+            {
+                ++count[m_rowIdx[p]];
+                ++count[j];
+            }
+        }
+    }
+
+    // nodes coupled to a large part of the matrix would make every update
+    // expensive, so they are ordered last
+    int dense = std::max(16, static_cast<int>(10.0 * sqrt(static_cast<double>(n))));
+
+    // quotient graph: each variable keeps its remaining variable neighbors
+    // and the elements (eliminated nodes) it belongs to
+    enum { VARIABLE, ELEMENT, ABSORBED };
+
+    std::vector<char> state(n, VARIABLE);
+    std::vector<std::vector<int> > vars(n);
+    std::vector<std::vector<int> > elems(n);
+    std::vector<std::vector<int> > members(n);
+    std::vector<int> last;
+
+    for (int j = 0; j < n; ++j)
+    {
+        if (count[j] > dense)
+        {
+            state[j] = ABSORBED;
+            last.push_back(j);
+        }
+    }
+
+    for (int j = 0; j < n; ++j)
+    {
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+        {
+            int i = m_rowIdx[p];
+
+            if (i != j && state[i] == VARIABLE && state[j] == VARIABLE)
+            {
+                vars[i].push_back(j);
+                vars[j].push_back(i);
+            }
+        }
+    }
+
+    // degree lists
+    std::vector<int> degree(n), head(n + 1, -1), next(n, -1), prev(n, -1);
+    int live   = 0;
+    int mindeg = 0;
+
+    auto insert = [&](int i)
+    {
+        int d   = degree[i];
+        next[i] = head[d];
+        prev[i] = -1;
+
+        if (head[d] != -1)
+            prev[head[d]] = i;
+
+        head[d] = i;
+    };
+
+    auto remove = [&](int i)
+    {
+        if (prev[i] != -1)
+            next[prev[i]] = next[i];
+        else
+            head[degree[i]] = next[i];
+
+        if (next[i] != -1)
+            prev[next[i]] = prev[i];
+    };
+
+    for (int j = 0; j < n; ++j)
+    {
+        if (state[j] != VARIABLE)
+            continue;
+
+        std::vector<int>& v = vars[j];
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+
+        degree[j] = static_cast<int>(v.size());
+        insert(j);
+        ++live;
+    }
+
+    perm.clear();
+    perm.reserve(n);
+
+    std::vector<int> mark(n, -1);
+    std::vector<int> wflag(n, -1);
+    std::vector<int> wsize(n, 0);
+    std::vector<int> lp;
+
+    for (int k = 0; k < live; ++k)
+    {
+        while (head[mindeg] == -1)
+            ++mindeg;
+
+        int pivot = head[mindeg];
+        remove(pivot);
+        perm.push_back(pivot);
+
+        // the new element is the union of the pivot's neighbors and of the
+        // elements it belongs to, which it absorbs
+        lp.clear();
+        mark[pivot] = k;
+
+        for (size_t q = 0; q < vars[pivot].size(); ++q)
+        {
+            int i = vars[pivot][q];
+
+            if (state[i] == VARIABLE && mark[i] != k)
+            {
+                mark[i] = k;
+                lp.push_back(i);
+            }
+        }
+
+        for (size_t q = 0; q < elems[pivot].size(); ++q)
+        {
+            int e = elems[pivot][q];
+
+            if (state[e] != ELEMENT)
+                continue;
+
+            for (size_t r = 0; r < members[e].size(); ++r)
+            {
+                int i = members[e][r];
+
+                if (state[i] == VARIABLE && mark[i] != k)
+                {
+                    mark[i] = k;
+                    lp.push_back(i);
+                }
+            }
+
+            state[e] = ABSORBED;
+            std::vector<int>().swap(members[e]);
+        }
+
+        state[pivot] = ELEMENT;
+        std::vector<int>().swap(vars[pivot]);
+        std::vector<int>().swap(elems[pivot]);
+        members[pivot] = lp;
+
+        // |Le \ Lp| for every other element adjacent to the new one
+        for (size_t q = 0; q < lp.size(); ++q)
+        {
+            const std::vector<int>& el = elems[lp[q]];
+
+            for (size_t r = 0; r < el.size(); ++r)
+            {
+                int e = el[r];
+
+                if (state[e] != ELEMENT)
+                    continue;
+
+                if (wflag[e] != k)
+                {
+                    wflag[e] = k;
+                    wsize[e] = static_cast<int>(members[e].size());
+                }
+
+                --wsize[e];
+            }
+        }
+
+        int lsize = static_cast<int>(lp.size());
+
+        for (size_t q = 0; q < lp.size(); ++q)
+        {
+            int i = lp[q];
+
+            // neighbors inside the new element are reached through it
+            std::vector<int>& v = vars[i];
+            size_t keep = 0;
+
+            for (size_t r = 0; r < v.size(); ++r)
+            {
+                if (state[v[r]] == VARIABLE && mark[v[r]] != k)
+                    v[keep++] = v[r];
+            }
+
+            v.resize(keep);
+
+            // elements contained in the new one are absorbed as well
+            std::vector<int>& el = elems[i];
+            long long d = static_cast<long long>(keep) + lsize - 1;
+            keep = 0;
+
+            for (size_t r = 0; r < el.size(); ++r)
+            {
+                int e = el[r];
+
+                if (state[e] != ELEMENT)
+                    continue;
+
+                if (wsize[e] <= 0)
+                {
+                    state[e] = ABSORBED;
+                    std::vector<int>().swap(members[e]);
+                    continue;
+                }
+
+                d += wsize[e];
+                el[keep++] = e;
+            }
+
+            el.resize(keep);
+            el.push_back(pivot);
+
+            remove(i);
+            degree[i] = static_cast<int>(std::min(d, static_cast<long long>(live - k - 1)));
+            insert(i);
+            mindeg = std::min(mindeg, degree[i]);
+        }
+    }
+
+    perm.insert(perm.end(), last.begin(), last.end());
+}
+
+//! Cholesky factorization of the symmetrically permuted matrix
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::FactorCholesky(const std::vector<int>& perm, hwTMatrixS<T1>& L) const
+{
+    hwMathStatus status;
+
+    int n = m_nCols;
+    std::vector<int> pinv(n);
+
+    for (int k = 0; k < n; ++k)
+        pinv[perm[k]] = k;
+
+    // upper triangle of C = P*A*P'
+    std::vector<int> cp(n + 1, 0);
+
+    for (int j = 0; j < n; ++j)
+    {
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+        {
+            if (pinv[m_rowIdx[p]] <= pinv[j])
+                ++cp[pinv[j] + 1];
+        }
+    }
+
+    for (int j = 0; j < n; ++j)
+        cp[j + 1] += cp[j];
+
+    std::vector<int> ci(cp[n]);
+    std::vector<T1>  cx(cp[n]);
+    std::vector<int> next(cp.begin(), cp.end() - 1);
+
+    for (int j = 0; j < n; ++j)
+    {
+        for (int p = m_colPtr[j]; p < m_colPtr[j + 1]; ++p)
+        {
+            int i2 = pinv[m_rowIdx[p]];
+            int j2 = pinv[j];
+
+            if (i2 <= j2)
+            {
+                int q = next[j2]++;
+                ci[q] = i2;
+                cx[q] = m_values[p];
+            }
+        }
+    }
+
+    // elimination tree of C
+    std::vector<int> parent(n, -1);
+    std::vector<int> ancestor(n, -1);
+
+    for (int k = 0; k < n; ++k)
+    {
+        for (int p = cp[k]; p < cp[k + 1]; ++p)
+        {
+            int inext;
+
+            for (int i = ci[p]; i != -1 && i < k; i = inext)
+            {
+                inext       = ancestor[i];
+                ancestor[i] = k;
+
+                if (inext == -1)
+                    parent[i] = k;
+            }
+        }
+    }
+
+    // up-looking factorization; row k of L comes from a sparse triangular
+    // solve whose pattern is the set of etree paths from the entries of C(:,k)
+    std::vector<std::vector<int> > li(n);
+    std::vector<std::vector<T1> >  lx(n);
+    std::vector<T1>  x(n, T1(0));
+    std::vector<int> s(n);
+    std::vector<int> w(n, -1);
+    T1               dmin = T1(0);
+    T1               dmax = T1(0);
+
+    for (int k = 0; k < n; ++k)
+    {
+        int top = n;
+        w[k] = k;
+
+        for (int p = cp[k]; p < cp[k + 1]; ++p)
+        {
+            int i   = ci[p];
+            int len = 0;
+
+            x[i] = cx[p];
+
+            for (; w[i] != k; i = parent[i])
+            {
+                s[len++] = i;
+                w[i]     = k;
+            }
+
+            while (len > 0)
+                s[--top] = s[--len];
+        }
+
+        T1 d = x[k];
+        x[k] = T1(0);
+
+        for (; top < n; ++top)
+        {
+            int i   = s[top];
+            T1  lki = x[i] / lx[i][0];
+            x[i]    = T1(0);
+
+            for (size_t q = 1; q < li[i].size(); ++q)
+                x[li[i][q]] -= lx[i][q] * lki;
+
+            d -= lki * lki;
+            li[i].push_back(k);
+            lx[i].push_back(lki);
+        }
+
+        if (d <= T1(0))
+            return status(HW_MATH_ERR_MTXNOTSPD, 1);
+
+        li[k].push_back(k);
+        lx[k].push_back(sqrt(d));
+
+        dmin = (k == 0) ? d : std::min(dmin, d);
+        dmax = std::max(dmax, d);
+    }
+
+    // the squared diagonal of L scales like the pivots of LU
+    if (dmin <= dmax * std::numeric_limits<T1>::epsilon())
+        status(HW_MATH_WARN_SINGMATRIX, 1);
+
+    // the rows of each column are in increasing order, diagonal first
+    L.m_nRows = n;
+    L.m_nCols = n;
+    L.m_colPtr.assign(n + 1, 0);
+
+    for (int j = 0; j < n; ++j)
+        L.m_colPtr[j + 1] = L.m_colPtr[j] + static_cast<int>(li[j].size());
+
+    L.m_rowIdx.resize(L.m_colPtr[n]);
+    L.m_values.resize(L.m_colPtr[n]);
+
+    for (int j = 0; j < n; ++j)
+    {
+        std::copy(li[j].begin(), li[j].end(), L.m_rowIdx.begin() + L.m_colPtr[j]);
+        std::copy(lx[j].begin(), lx[j].end(), L.m_values.begin() + L.m_colPtr[j]);
+    }
+
+    return status;
+}
+
+//! LU factorization with threshold partial pivoting
+template<typename T1>
+hwMathStatus hwTMatrixS<T1>::FactorLU(const std::vector<int>& perm, T1 tol, hwTMatrixS<T1>& L,
+                                      hwTMatrixS<T1>& U, std::vector<int>& pinv) const
+{
+    hwMathStatus status;
+
+    int n = m_nCols;
+
+    std::vector<int> lp(n + 1), up(n + 1);
+    std::vector<int> li, ui;
+    std::vector<T1>  lx, ux;
+
+    li.reserve(2 * NNZ() + n);
+    lx.reserve(2 * NNZ() + n);
+    ui.reserve(2 * NNZ() + n);
+    ux.reserve(2 * NNZ() + n);
+
+    pinv.assign(n, -1);
+
+    std::vector<T1>   x(n, T1(0));
+    std::vector<int>  xi(n);
+    std::vector<int>  pstack(n);
+    std::vector<char> marked(n, 0);
+    T1                umin = T1(0);
+    T1                umax = T1(0);
+
+    // left-looking (Gilbert-Peierls) factorization of A(:,perm). Each column
+    // is a sparse triangular solve with the columns of L computed so far,
+    // whose pattern is found by a depth first search in the graph of L.
+    for (int k = 0; k < n; ++k)
+    {
+        lp[k] = static_cast<int>(li.size());
+        up[k] = static_cast<int>(ui.size());
+
+        int col = perm[k];
+        int top = n;
+
+        for (int p0 = m_colPtr[col]; p0 < m_colPtr[col + 1]; ++p0)
+        {
+            if (marked[m_rowIdx[p0]])
+                continue;
+
+            int head = 0;
+            xi[0] = m_rowIdx[p0];
+
+            while (head >= 0)
+            {
+                int j    = xi[head];
+                int jnew = pinv[j];
+
+                if (!marked[j])
+                {
+                    marked[j]    = 1;
+                    pstack[head] = (jnew < 0) ? 0 : lp[jnew] + 1;
+                }
+
+                bool done = true;
+                int  end  = (jnew < 0) ? 0 : lp[jnew + 1];
+
+                for (int p = pstack[head]; p < end; ++p)
+                {
+                    int i = li[p];
+
+                    if (marked[i])
+                        continue;
+
+                    pstack[head] = p;
+                    xi[++head]   = i;
+                    done         = false;
+                    break;
+                }
+
+                if (done)
+                {
+                    --head;
+                    xi[--top] = j;
+                }
+            }
+        }
+
+        for (int p = top; p < n; ++p)
+            marked[xi[p]] = 0;
+
+        for (int p = m_colPtr[col]; p < m_colPtr[col + 1]; ++p)
+            x[m_rowIdx[p]] = m_values[p];
+
+        for (int px = top; px < n; ++px)
+        {
+            int j = xi[px];
+            int J = pinv[j];
+
+            if (J < 0)
+                continue;
+
+            T1 xj = x[j];
+
+            for (int p = lp[J] + 1; p < lp[J + 1]; ++p)
+                x[li[p]] -= lx[p] * xj;
+        }
+
+        // choose the largest candidate, unless the diagonal is close enough
+        int ipiv = -1;
+        T1  a    = T1(-1);
+
+        for (int px = top; px < n; ++px)
+        {
+            int i = xi[px];
+
+            if (pinv[i] < 0)
+            {
+                T1 t = std::abs(x[i]);
+
+                if (t > a)
+                {
+                    a    = t;
+                    ipiv = i;
+                }
+            }
+            else
+            {
+                ui.push_back(pinv[i]);
+                ux.push_back(x[i]);
+            }
+        }
+
+        if (ipiv == -1 || a <= T1(0))
+            return status(HW_MATH_ERR_MTXNOTFULLRANK, 1);
+
+        if (pinv[col] < 0 && std::abs(x[col]) >= a * tol)
+            ipiv = col;
+
+        T1 pivot = x[ipiv];
+
+        umin = (k == 0) ? std::abs(pivot) : std::min(umin, std::abs(pivot));
+        umax = std::max(umax, std::abs(pivot));
+
+        ui.push_back(k);
+        ux.push_back(pivot);
+        pinv[ipiv] = k;
+        li.push_back(ipiv);
+        lx.push_back(T1(1));
+
+        for (int px = top; px < n; ++px)
+        {
+            int i = xi[px];
+
+            if (pinv[i] < 0)
+            {
+                li.push_back(i);
+                lx.push_back(x[i] / pivot);
+            }
+
+            x[i] = T1(0);
+        }
+    }
+
+    lp[n] = static_cast<int>(li.size());
+    up[n] = static_cast<int>(ui.size());
+
+    for (size_t p = 0; p < li.size(); ++p)
+        li[p] = pinv[li[p]];
+
+    // the factors are still returned when the matrix is nearly singular
+    if (umin <= umax * std::numeric_limits<T1>::epsilon())
+        status(HW_MATH_WARN_SINGMATRIX, 1);
+
+    L.m_nRows = n;
+    L.m_nCols = n;
+    L.m_colPtr.swap(lp);
+    L.m_rowIdx.swap(li);
+    L.m_values.swap(lx);
+    L.SortColumns();
+
+    U.m_nRows = n;
+    U.m_nCols = n;
+    U.m_colPtr.swap(up);
+    U.m_rowIdx.swap(ui);
+    U.m_values.swap(ux);
+    U.SortColumns();
+
+    return status;
+}
+
+//! Sort the row indices of each column, along with their values
+template<typename T1>
+void hwTMatrixS<T1>::SortColumns()
+{
+    std::vector<std::pair<int, T1> > entries;
+
+    for (int j = 0; j < m_nCols; ++j)
+    {
+        int  begin  = m_colPtr[j];
+        int  end    = m_colPtr[j + 1];
+        bool sorted = true;
+
+        for (int p = begin + 1; p < end && sorted; ++p)
+            sorted = m_rowIdx[p - 1] < m_rowIdx[p];
+
+        if (sorted)
+            continue;
+
+        entries.clear();
+
+        for (int p = begin; p < end; ++p)
+            entries.push_back(std::make_pair(m_rowIdx[p], m_values[p]));
+
+        std::sort(entries.begin(), entries.end(),
+                  [](const std::pair<int, T1>& a, const std::pair<int, T1>& b)
+                  { return a.first < b.first; });
+
+        for (int p = begin; p < end; ++p)
+        {
+            m_rowIdx[p] = entries[p - begin].first;
+            m_values[p] = entries[p - begin].second;
+        }
+    }
+}
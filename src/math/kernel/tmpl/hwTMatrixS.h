@@ -0,0 +1,184 @@
+/**
+* @file hwTMatrixS.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+#ifndef _hwTMatrixS_h
+#define _hwTMatrixS_h
+
+#include <vector>
+#include <tmpl/hwTMatrix.h>
+
+// -------------------------------------------------------------------
+//! hwTMatrixS is a real sparse matrix in compressed sparse column (CSC)
+//! form. The storage is
+//! 1. m_colPtr, with N()+1 offsets into the row index and value arrays
+//! 2. m_rowIdx, the row of each nonzero, sorted within each column
+//! 3. m_values, the value of each nonzero
+//!
+//! Explicit zeros are not stored, so memory scales with the number of
+//! nonzeros and not with M()*N().
+// -------------------------------------------------------------------
+
+//! hwTMatrixS class definition
+template <typename T1> class hwTMatrixS
+{
+public:
+    // ****************************************************
+    //       Construction / Destruction / Assignment
+    // ****************************************************
+
+    //! Construct empty matrix
+    hwTMatrixS();
+    //! Construct an all zero matrix
+    hwTMatrixS(int m, int n);
+    //! Construct from a real dense matrix
+    hwTMatrixS(const hwTMatrix<T1>& source);
+    //! Copy constructor
+    hwTMatrixS(const hwTMatrixS<T1>& source);
+    //! Move constructor
+    hwTMatrixS(hwTMatrixS<T1>&& source);
+    //! Destructor
+    ~hwTMatrixS();
+    //! Implement the = operator
+    hwTMatrixS<T1>& operator=(const hwTMatrixS<T1>& rhs);
+    //! Implement the move = operator
+    hwTMatrixS<T1>& operator=(hwTMatrixS<T1>&& rhs);
+    //! Allocate matrix objects from the memory pool
+    static void* operator new(size_t size) { return hwMemoryPool::Allocate(size); }
+    //! Return matrix objects to the memory pool
+    static void operator delete(void* ptr) { hwMemoryPool::Free(ptr); }
+
+    // ****************************************************
+    //                  Construction Helpers
+    // ****************************************************
+
+    //! Build from zero based (row, column, value) triplets, summing duplicates
+    hwMathStatus Assemble(int m, int n, const std::vector<int>& rows,
+                          const std::vector<int>& cols, const std::vector<T1>& values);
+    //! Build from a real dense matrix
+    hwMathStatus Convert(const hwTMatrix<T1>& source);
+    //! Write the matrix into dense form
+    hwMathStatus Full(hwTMatrix<T1>& target) const;
+
+    // ****************************************************
+    //                 Access Functions
+    // ****************************************************
+
+    //! Return the number of rows
+    int M() const { return m_nRows; }
+    //! Return the number of columns
+    int N() const { return m_nCols; }
+    //! Return the number of stored nonzeros
+    int NNZ() const { return static_cast<int>(m_values.size()); }
+    //! Determine if the matrix is empty
+    bool IsEmpty() const { return m_nRows == 0 || m_nCols == 0; }
+    //! Determine if the matrix is square
+    bool IsSquare() const { return m_nRows == m_nCols; }
+    //! Determine if the matrix is symmetric
+    bool IsSymmetric() const;
+    //! Return the column offsets
+    const int* ColPointers() const { return m_colPtr.data(); }
+    //! Return the row indices
+    const int* RowIndices() const { return m_rowIdx.data(); }
+    //! Return the nonzero values
+    const T1* Values() const { return m_values.data(); }
+    //! Return an element, which is zero if it is not stored
+    T1 operator()(int i, int j) const;
+
+    // ****************************************************
+    //               Arithmetic Operations
+    // ****************************************************
+
+    //! Transpose the matrix, A'
+    hwMathStatus Transpose(const hwTMatrixS<T1>& A);
+    //! Add two matrices, A+B
+    hwMathStatus Add(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B);
+    //! Subtract two matrices, A-B
+    hwMathStatus Subtr(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B);
+    //! Multiply two matrices, A*B
+    hwMathStatus Mult(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B);
+    //! Multiply a matrix by a real number, A*s
+    hwMathStatus Mult(const hwTMatrixS<T1>& A, T1 s);
+    //! Multiply the calling object by a real number
+    void MultEquals(T1 s);
+    //! Multiply two matrices element by element, A.*B
+    hwMathStatus MultByElems(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B);
+    //! Multiply a sparse and a dense matrix element by element, A.*B
+    hwMathStatus MultByElems(const hwTMatrixS<T1>& A, const hwTMatrix<T1>& B);
+    //! Multiply the calling object by a dense matrix, C = this*B
+    hwMathStatus MultRight(const hwTMatrix<T1>& B, hwTMatrix<T1>& C) const;
+    //! Multiply a dense matrix by the calling object, C = A*this
+    hwMathStatus MultLeft(const hwTMatrix<T1>& A, hwTMatrix<T1>& C) const;
+
+    // ****************************************************
+    //                  Linear Algebra
+    // ****************************************************
+
+    //! Solve the system this*X = B with a sparse direct factorization, or in
+    //! the least squares sense when the matrix is not square
+    hwMathStatus LSolve(const hwTMatrix<T1>& B, hwTMatrix<T1>& X) const;
+    //! Factor the matrix once for repeated solves with SolveFactored. A
+    //! Cholesky factorization L*L' = P*this*P' returns an empty U, and an LU
+    //! factorization L*U = P*this*Q with unit lower L returns both.
+    hwMathStatus Factor(hwTMatrixS<T1>& L, hwTMatrixS<T1>& U,
+                        std::vector<int>& rowPerm, std::vector<int>& colPerm) const;
+    //! Solve in place with the factors from Factor, where X is B on input
+    static hwMathStatus SolveFactored(const hwTMatrixS<T1>& L, const hwTMatrixS<T1>& U,
+                                      const std::vector<int>& rowPerm,
+                                      const std::vector<int>& colPerm, hwTMatrix<T1>& X);
+    //! Incomplete LU factorization of A with no fill, where the unit lower
+    //! and upper factors share the pattern of A, LU = *this
+    hwMathStatus ILU0(const hwTMatrixS<T1>& A);
+    //! Solve L*U*X = B with the factors from ILU0
+    hwMathStatus ILUSolve(const hwTMatrix<T1>& B, hwTMatrix<T1>& X) const;
+
+    // ****************************************************
+    //                 Reference Counting
+    // ****************************************************
+
+    void IncrRefCount() { m_refCount++; }
+    void DecrRefCount() { m_refCount--; }
+    void ResetRefCount() { m_refCount = 1; }
+    unsigned int GetRefCount() const { return m_refCount; }
+    bool IsMatrixShared() const { return m_refCount != 1; }
+
+private:
+    int m_nRows;                    //!< number of rows
+    int m_nCols;                    //!< number of columns
+    std::vector<int> m_colPtr;      //!< column offsets, size N()+1
+    std::vector<int> m_rowIdx;      //!< row index of each nonzero
+    std::vector<T1> m_values;       //!< value of each nonzero
+    int m_refCount;                 //!< reference counter
+
+    //! Combine two matrices column by column with a binary operation
+    template <typename Op>
+    hwMathStatus Merge(const hwTMatrixS<T1>& A, const hwTMatrixS<T1>& B, bool intersect, Op op);
+    //! Least squares solution of a non-square system
+    hwMathStatus LeastSquares(const hwTMatrix<T1>& B, hwTMatrix<T1>& X) const;
+    //! Approximate minimum degree ordering of the pattern of A+A'
+    void OrderMinDegree(std::vector<int>& perm) const;
+    //! Cholesky factorization of the symmetrically permuted matrix
+    hwMathStatus FactorCholesky(const std::vector<int>& perm, hwTMatrixS<T1>& L) const;
+    //! LU factorization with threshold partial pivoting
+    hwMathStatus FactorLU(const std::vector<int>& perm, T1 tol, hwTMatrixS<T1>& L,
+                          hwTMatrixS<T1>& U, std::vector<int>& pinv) const;
+    //! Sort the row indices of each column, along with their values
+    void SortColumns();
+};
+
+//! template implementation file
+#include <tmpl/hwTMatrixS.cc>
+
+#endif // _hwTMatrixS_h
@@ -0,0 +1,128 @@
+/**
+* @file KrylovSolvers.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+#ifndef _MathUtils_KrylovSolvers_h
+#define _MathUtils_KrylovSolvers_h
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Iterative Krylov subspace solvers for large linear systems
+//!
+//! The system matrix and the preconditioner are only accessed through
+//! callbacks that apply them to a vector, so they can be dense, sparse or
+//! matrix free. Apart from the GMRES basis, the work space is a few vectors.
+//!
+//! Each solver reports its outcome in flag
+//! 0 - converged to the tolerance
+//! 1 - reached the maximum number of iterations without converging
+//! 2 - the preconditioner returned a vector that is not finite
+//! 3 - stagnated, with consecutive iterates that are the same
+//! 4 - broke down, because a scalar quantity became zero or not finite
+//!
+//! When flag is nonzero x is the iterate with the smallest residual.
+//!
+//------------------------------------------------------------------------------
+
+#include "hwMatrix.h"
+#include "MathUtilsExports.h"
+
+//!
+//! Callback that applies an operator to a column vector, y = A*x for a
+//! system matrix or y = M\x for a preconditioner
+//!
+typedef hwMathStatus (*KrylovFunc)(const hwMatrix& x, hwMatrix& y);
+
+//!
+//! Returns the status after solving the symmetric positive definite system
+//! A*x = b with the preconditioned conjugate gradient method
+//! \param A       System operator
+//! \param M       Preconditioner, or NULL for none
+//! \param b       Right hand side
+//! \param x       Initial estimate on input, solution on output
+//! \param tol     Tolerance of the relative residual, norm(b-A*x)/norm(b)
+//! \param maxIter Maximum number of iterations
+//! \param flag    Outcome
+//! \param relres  Relative residual
+//! \param iter    Iteration of x
+//! \param resvec  Optional residual norms, starting with the initial residual
+//!
+MATHUTILS_DECLS hwMathStatus PCG(const KrylovFunc A,
+                                 const KrylovFunc M,
+                                 const hwMatrix&  b,
+                                 hwMatrix&        x,
+                                 double           tol,
+                                 int              maxIter,
+                                 int&             flag,
+                                 double&          relres,
+                                 int&             iter,
+                                 hwMatrix*        resvec = NULL);
+//!
+//! Returns the status after solving the system A*x = b with the stabilized
+//! biconjugate gradient method
+//! \param A       System operator
+//! \param M       Preconditioner, or NULL for none
+//! \param b       Right hand side
+//! \param x       Initial estimate on input, solution on output
+//! \param tol     Tolerance of the relative residual, norm(b-A*x)/norm(b)
+//! \param maxIter Maximum number of iterations
+//! \param flag    Outcome
+//! \param relres  Relative residual
+//! \param iter    Iteration of x, which can end in a half iteration
+//! \param resvec  Optional residual norms, starting with the initial residual
+//!                and with one entry per half iteration
+//!
+MATHUTILS_DECLS hwMathStatus BiCGStab(const KrylovFunc A,
+                                      const KrylovFunc M,
+                                      const hwMatrix&  b,
+                                      hwMatrix&        x,
+                                      double           tol,
+                                      int              maxIter,
+                                      int&             flag,
+                                      double&          relres,
+                                      double&          iter,
+                                      hwMatrix*        resvec = NULL);
+//!
+//! Returns the status after solving the system A*x = b with the restarted
+//! generalized minimum residual method. The preconditioner is applied on
+//! the right, so the residuals are those of the original system.
+//! \param A        System operator
+//! \param M        Preconditioner, or NULL for none
+//! \param b        Right hand side
+//! \param x        Initial estimate on input, solution on output
+//! \param restart  Number of inner iterations between restarts
+//! \param tol      Tolerance of the relative residual, norm(b-A*x)/norm(b)
+//! \param maxOuter Maximum number of outer iterations
+//! \param flag     Outcome
+//! \param relres   Relative residual
+//! \param outer    Outer iteration of x
+//! \param inner    Inner iteration of x
+//! \param resvec   Optional residual norms, starting with the initial residual
+//!                 and with one entry per inner iteration
+//!
+MATHUTILS_DECLS hwMathStatus GMRES(const KrylovFunc A,
+                                   const KrylovFunc M,
+                                   const hwMatrix&  b,
+                                   hwMatrix&        x,
+                                   int              restart,
+                                   double           tol,
+                                   int              maxOuter,
+                                   int&             flag,
+                                   double&          relres,
+                                   int&             outer,
+                                   int&             inner,
+                                   hwMatrix*        resvec = NULL);
+
+#endif // _MathUtils_KrylovSolvers_h
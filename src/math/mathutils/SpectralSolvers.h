@@ -0,0 +1,139 @@
+/**
+* @file SpectralSolvers.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+
+#ifndef _MathUtils_SpectralSolvers_h
+#define _MathUtils_SpectralSolvers_h
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Partial eigenvalue and singular value solvers for large matrices
+//!
+//! Eigs and Svds use the Krylov-Schur method, which is an implicitly
+//! restarted Arnoldi iteration that becomes the thick restart Lanczos method
+//! for symmetric operators. Only a few wanted pairs are computed, and the
+//! work space is a basis of ncv vectors. The operator is accessed through a
+//! callback, so a shift-invert operator (A-sigma*I)\x finds the eigenvalues
+//! closest to sigma as those of largest magnitude.
+//!
+//! RandomizedSVD projects the matrix onto a randomized range estimate, so
+//! that it is applied to blocks of vectors with matrix products.
+//!
+//! The iterative solvers report their outcome in flag
+//! 0 - all wanted pairs converged to the tolerance
+//! 1 - reached the maximum number of restarts, with the best estimates
+//!     returned
+//!
+//------------------------------------------------------------------------------
+
+#include "KrylovSolvers.h"
+
+//!
+//! Eigenvalues that are wanted
+//!
+enum EigsWhich
+{
+    EIGS_LARGEST_MAG,   //!< largest magnitude
+    EIGS_LARGEST_REAL,  //!< largest real part, or largest algebraic
+    EIGS_SMALLEST_REAL  //!< smallest real part, or smallest algebraic
+};
+
+//!
+//! Returns the status after computing k eigenvalues and eigenvectors of an
+//! n x n operator, wanted first. They are real for a symmetric operator.
+//! \param A          Operator, which is also applied to n x 1 vectors
+//! \param n          Order of the operator
+//! \param k          Number of eigenvalues, with 0 < k < n
+//! \param which      Eigenvalues that are wanted
+//! \param symmetric  True if the operator is symmetric
+//! \param ncv        Number of basis vectors, with k < ncv <= n
+//! \param tol        Tolerance of the residual relative to the eigenvalue
+//! \param maxRestart Maximum number of restarts
+//! \param v0         Optional starting vector
+//! \param V          Optional eigenvectors, n x k
+//! \param D          Eigenvalues, k x 1
+//! \param flag       Outcome
+//!
+MATHUTILS_DECLS hwMathStatus Eigs(const KrylovFunc A,
+                                  int              n,
+                                  int              k,
+                                  EigsWhich        which,
+                                  bool             symmetric,
+                                  int              ncv,
+                                  double           tol,
+                                  int              maxRestart,
+                                  const hwMatrix*  v0,
+                                  hwMatrix*        V,
+                                  hwMatrix&        D,
+                                  int&             flag);
+//!
+//! Returns the status after computing the k largest singular values and
+//! vectors of an m x n operator, with the thick restarted Lanczos
+//! bidiagonalization method
+//! \param A          Operator
+//! \param At         Transpose of the operator
+//! \param m          Number of rows of the operator
+//! \param n          Number of columns of the operator
+//! \param k          Number of singular values, with 0 < k < min(m,n)
+//! \param ncv        Number of basis vectors, with k < ncv <= min(m,n)
+//! \param tol        Tolerance of the residual relative to the largest
+//!                   singular value
+//! \param maxRestart Maximum number of restarts
+//! \param U          Optional left singular vectors, m x k
+//! \param S          Singular values in decreasing order, k x 1
+//! \param V          Optional right singular vectors, n x k
+//! \param flag       Outcome
+//!
+MATHUTILS_DECLS hwMathStatus Svds(const KrylovFunc A,
+                                  const KrylovFunc At,
+                                  int              m,
+                                  int              n,
+                                  int              k,
+                                  int              ncv,
+                                  double           tol,
+                                  int              maxRestart,
+                                  hwMatrix*        U,
+                                  hwMatrix&        S,
+                                  hwMatrix*        V,
+                                  int&             flag);
+//!
+//! Returns the status after computing an approximation of the k largest
+//! singular values and vectors of an m x n operator with a randomized range
+//! finder. The callbacks are applied to blocks of k+oversample columns.
+//! \param A          Operator
+//! \param At         Transpose of the operator
+//! \param m          Number of rows of the operator
+//! \param n          Number of columns of the operator
+//! \param k          Number of singular values, with 0 < k <= min(m,n)
+//! \param oversample Number of extra samples of the range
+//! \param powerIter  Number of power iterations, which improve the accuracy
+//!                   when the singular values decay slowly
+//! \param U          Optional left singular vectors, m x k
+//! \param S          Singular values in decreasing order, k x 1
+//! \param V          Optional right singular vectors, n x k
+//!
+MATHUTILS_DECLS hwMathStatus RandomizedSVD(const KrylovFunc A,
+                                           const KrylovFunc At,
+                                           int              m,
+                                           int              n,
+                                           int              k,
+                                           int              oversample,
+                                           int              powerIter,
+                                           hwMatrix*        U,
+                                           hwMatrix&        S,
+                                           hwMatrix*        V);
+
+#endif // _MathUtils_SpectralSolvers_h
@@ -0,0 +1,896 @@
+/**
+* @file KrylovSolvers.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+#include <KrylovSolvers.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <GeneralFuncs.h>
+#include <hwBlasBackend.h>
+#include <hwMathStatus.h>
+
+//------------------------------------------------------------------------------
+// Returns the dot product of two real vectors
+//------------------------------------------------------------------------------
+static double Dot(const hwMatrix& x, const hwMatrix& y)
+{
+    int n   = x.Size();
+    int inc = 1;
+
+    return hwBlas::ddot_(&n, const_cast<double*>(x.GetRealData()), &inc,
+                         const_cast<double*>(y.GetRealData()), &inc);
+}
+//------------------------------------------------------------------------------
+// Returns the 2-norm of a real vector
+//------------------------------------------------------------------------------
+static double Norm(const hwMatrix& x)
+{
+    return sqrt(Dot(x, x));
+}
+//------------------------------------------------------------------------------
+// Adds a multiple of one real vector to another, y += a*x
+//------------------------------------------------------------------------------
+static void Axpy(double a, const hwMatrix& x, hwMatrix& y)
+{
+    int n   = x.Size();
+    int inc = 1;
+
+    hwBlas::daxpy_(&n, &a, const_cast<double*>(x.GetRealData()), &inc,
+                   y.GetRealData(), &inc);
+}
+//------------------------------------------------------------------------------
+// Applies an operator callback and checks that it returns a real vector with
+// the length of x, which is then stored as a column. argNum is the argument
+// position of the callback.
+//------------------------------------------------------------------------------
+static hwMathStatus Apply(const KrylovFunc func, const hwMatrix& x, hwMatrix& y, int argNum)
+{
+    hwMathStatus status = func(x, y);
+
+    if (!status.IsOk())
+    {
+        if (status.IsWarning())
+            status.ResetArgs();
+        else
+            return status;
+    }
+
+    if (y.Size() != x.Size())
+        return status(HW_MATH_ERR_USERFUNCSIZE, argNum);
+
+    if (!y.IsReal())
+        return status(HW_MATH_ERR_USERFUNCREAL, argNum);
+
+    if (y.N() != 1)
+        y.Reshape(x.Size(), 1);
+
+    return hwMathStatus();
+}
+//------------------------------------------------------------------------------
+// Applies the preconditioner, or copies x if there is none. Returns false in
+// ok if the result is not finite.
+//------------------------------------------------------------------------------
+static hwMathStatus Precondition(const KrylovFunc M, const hwMatrix& x, hwMatrix& y, bool& ok)
+{
+    ok = true;
+
+    if (!M)
+    {
+        y = x;
+        return hwMathStatus();
+    }
+
+    hwMathStatus status = Apply(M, x, y, 2);
+
+    if (status.IsOk())
+    {
+        const double* data = y.GetRealData();
+
+        for (int i = 0; i < y.Size() && ok; ++i)
+            ok = IsFinite_T(data[i]);
+    }
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Computes the residual r = b - A*x and its norm
+//------------------------------------------------------------------------------
+static hwMathStatus Residual(const KrylovFunc A,
+                             const hwMatrix&  b,
+                             const hwMatrix&  x,
+                             hwMatrix&        r,
+                             double&          normr)
+{
+    hwMathStatus status = Apply(A, x, r, 1);
+
+    if (!status.IsOk())
+        return status;
+
+    r.MultEquals(-1.0);
+    Axpy(1.0, b, r);
+    normr = Norm(r);
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Checks the common arguments, and prepares a column copy of b, the initial
+// x and the initial residual. For b = 0 the solution is x = 0.
+//------------------------------------------------------------------------------
+static hwMathStatus Prepare(const KrylovFunc A,
+                            const hwMatrix&  b,
+                            hwMatrix&        x,
+                            hwMatrix&        bcol,
+                            hwMatrix&        r,
+                            double&          normb,
+                            double&          normr)
+{
+    hwMathStatus status;
+
+    if (!A)
+        return status(HW_MATH_ERR_NULLPOINTER, 1);
+
+    if (!b.IsReal())
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 3);
+
+    if (!b.IsEmptyOrVector())
+        return status(HW_MATH_ERR_VECTOR, 3);
+
+    int n = b.Size();
+
+    if (x.IsEmpty() && n)
+    {
+        status = x.Dimension(n, 1, hwMatrix::REAL);
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(4);
+            return status;
+        }
+
+        x.SetElements(0.0);
+    }
+    else if (x.Size() != n)
+    {
+        return status(HW_MATH_ERR_ARRAYSIZE, 3, 4);
+    }
+    else if (!x.IsReal())
+    {
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 4);
+    }
+    else if (x.N() != 1)
+    {
+        x.Reshape(n, 1);
+    }
+
+    bcol = b;
+
+    if (bcol.N() != 1)
+        bcol.Reshape(n, 1);
+
+    normb = Norm(bcol);
+
+    if (normb == 0.0)
+    {
+        x.SetElements(0.0);
+        r     = bcol;
+        normr = 0.0;
+        return status;
+    }
+
+    return Residual(A, bcol, x, r, normr);
+}
+//------------------------------------------------------------------------------
+// Records a residual norm
+//------------------------------------------------------------------------------
+static void Record(std::vector<double>& history, hwMatrix* resvec, double normr)
+{
+    if (resvec)
+        history.push_back(normr);
+}
+//------------------------------------------------------------------------------
+// Copies the residual history to the output
+//------------------------------------------------------------------------------
+static hwMathStatus WriteHistory(const std::vector<double>& history, hwMatrix* resvec)
+{
+    if (!resvec)
+        return hwMathStatus();
+
+    int          size   = static_cast<int>(history.size());
+    hwMathStatus status = resvec->Dimension(size, 1, hwMatrix::REAL);
+
+    if (!status.IsOk())
+        return status;
+
+    for (int i = 0; i < size; ++i)
+        (*resvec)(i) = history[i];
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Returns the status after solving A*x = b with the preconditioned conjugate
+// gradient method
+//------------------------------------------------------------------------------
+hwMathStatus PCG(const KrylovFunc A,
+                 const KrylovFunc M,
+                 const hwMatrix&  b,
+                 hwMatrix&        x,
+                 double           tol,
+                 int              maxIter,
+                 int&             flag,
+                 double&          relres,
+                 int&             iter,
+                 hwMatrix*        resvec)
+{
+    hwMathStatus status;
+
+    if (IsNaN_T(tol) || tol < 0.0)
+        return status(HW_MATH_ERR_NEGATIVE, 5);
+
+    if (maxIter < 0)
+        return status(HW_MATH_ERR_NEGATIVE, 6);
+
+    std::vector<double> history;
+    hwMatrix bcol;
+    hwMatrix r;
+    double   normb;
+    double   normr;
+
+    status = Prepare(A, b, x, bcol, r, normb, normr);
+
+    if (!status.IsOk())
+        return status;
+
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    flag   = 1;
+    iter   = 0;
+    relres = normb == 0.0 ? 0.0 : normr / normb;
+    Record(history, resvec, normr);
+
+    if (normr <= tol * normb)
+    {
+        flag = 0;
+        return WriteHistory(history, resvec);
+    }
+
+    hwMatrix z;
+    hwMatrix p;
+    hwMatrix q;
+    hwMatrix xmin(x);
+    double   normrmin = normr;
+    int      imin     = 0;
+    double   rho      = 1.0;
+    int      stag     = 0;
+
+    for (int i = 1; i <= maxIter; ++i)
+    {
+        bool ok;
+
+        status = Precondition(M, r, z, ok);
+
+        if (!status.IsOk())
+            return status;
+
+        if (!ok)
+        {
+            flag = 2;
+            break;
+        }
+
+        double rho1 = rho;
+        rho = Dot(r, z);
+
+        if (rho == 0.0 || !IsFinite_T(rho))
+        {
+            flag = 4;
+            break;
+        }
+
+        if (i == 1)
+        {
+            p = z;
+        }
+        else
+        {
+            double beta = rho / rho1;
+
+            if (beta == 0.0 || !IsFinite_T(beta))
+            {
+                flag = 4;
+                break;
+            }
+
+            // p = z + beta*p
+            p.MultEquals(beta);
+            Axpy(1.0, z, p);
+        }
+
+        status = Apply(A, p, q, 1);
+
+        if (!status.IsOk())
+            return status;
+
+        double pq = Dot(p, q);
+
+        // A must be positive definite
+        if (pq <= 0.0 || !IsFinite_T(pq))
+        {
+            flag = 4;
+            break;
+        }
+
+        double alpha = rho / pq;
+
+        if (!IsFinite_T(alpha))
+        {
+            flag = 4;
+            break;
+        }
+
+        if (fabs(alpha) * Norm(p) < eps * Norm(x))
+            ++stag;
+        else
+            stag = 0;
+
+        Axpy(alpha, p, x);
+        Axpy(-alpha, q, r);
+        normr = Norm(r);
+        iter  = i;
+        Record(history, resvec, normr);
+
+        if (normr <= tol * normb)
+        {
+            // confirm with the true residual, since r drifts from b - A*x
+            status = Residual(A, bcol, x, r, normr);
+
+            if (!status.IsOk())
+                return status;
+
+            if (normr <= tol * normb)
+            {
+                flag = 0;
+                break;
+            }
+        }
+
+        if (stag >= 3)
+        {
+            flag = 3;
+            break;
+        }
+
+        if (normr < normrmin)
+        {
+            normrmin = normr;
+            xmin     = x;
+            imin     = i;
+        }
+    }
+
+    if (flag && normrmin < normr)
+    {
+        x      = xmin;
+        iter   = imin;
+        normr  = normrmin;
+    }
+
+    relres = normr / normb;
+
+    return WriteHistory(history, resvec);
+}
+//------------------------------------------------------------------------------
+// Returns the status after solving A*x = b with the stabilized biconjugate
+// gradient method
+//------------------------------------------------------------------------------
+hwMathStatus BiCGStab(const KrylovFunc A,
+                      const KrylovFunc M,
+                      const hwMatrix&  b,
+                      hwMatrix&        x,
+                      double           tol,
+                      int              maxIter,
+                      int&             flag,
+                      double&          relres,
+                      double&          iter,
+                      hwMatrix*        resvec)
+{
+    hwMathStatus status;
+
+    if (IsNaN_T(tol) || tol < 0.0)
+        return status(HW_MATH_ERR_NEGATIVE, 5);
+
+    if (maxIter < 0)
+        return status(HW_MATH_ERR_NEGATIVE, 6);
+
+    std::vector<double> history;
+    hwMatrix bcol;
+    hwMatrix r;
+    double   normb;
+    double   normr;
+
+    status = Prepare(A, b, x, bcol, r, normb, normr);
+
+    if (!status.IsOk())
+        return status;
+
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    flag   = 1;
+    iter   = 0.0;
+    relres = normb == 0.0 ? 0.0 : normr / normb;
+    Record(history, resvec, normr);
+
+    if (normr <= tol * normb)
+    {
+        flag = 0;
+        return WriteHistory(history, resvec);
+    }
+
+    hwMatrix rt(r);     // shadow residual
+    hwMatrix p;
+    hwMatrix ph;
+    hwMatrix v;
+    hwMatrix sh;
+    hwMatrix t;
+    hwMatrix xmin(x);
+    double   normrmin = normr;
+    double   imin     = 0.0;
+    double   rho      = 1.0;
+    double   alpha    = 1.0;
+    double   omega    = 1.0;
+    int      stag     = 0;
+
+    for (int i = 1; i <= maxIter; ++i)
+    {
+        bool ok;
+
+        double rho1 = rho;
+        rho = Dot(rt, r);
+
+        if (rho == 0.0 || !IsFinite_T(rho))
+        {
+            flag = 4;
+            break;
+        }
+
+        if (i == 1)
+        {
+            p = r;
+        }
+        else
+        {
+            double beta = (rho / rho1) * (alpha / omega);
+
+            if (beta == 0.0 || !IsFinite_T(beta))
+            {
+                flag = 4;
+                break;
+            }
+
+            // p = r + beta*(p - omega*v)
+            Axpy(-omega, v, p);
+            p.MultEquals(beta);
+            Axpy(1.0, r, p);
+        }
+
+        status = Precondition(M, p, ph, ok);
+
+        if (!status.IsOk())
+            return status;
+
+        if (!ok)
+        {
+            flag = 2;
+            break;
+        }
+
+        status = Apply(A, ph, v, 1);
+
+        if (!status.IsOk())
+            return status;
+
+        double rtv = Dot(rt, v);
+
+        if (rtv == 0.0 || !IsFinite_T(rtv))
+        {
+            flag = 4;
+            break;
+        }
+
+        alpha = rho / rtv;
+
+        if (!IsFinite_T(alpha))
+        {
+            flag = 4;
+            break;
+        }
+
+        bool small = fabs(alpha) * Norm(ph) < eps * Norm(x);
+
+        // half step, where r becomes s = r - alpha*v
+        Axpy(alpha, ph, x);
+        Axpy(-alpha, v, r);
+        normr = Norm(r);
+        iter  = i - 0.5;
+        Record(history, resvec, normr);
+
+        if (normr <= tol * normb)
+        {
+            status = Residual(A, bcol, x, r, normr);
+
+            if (!status.IsOk())
+                return status;
+
+            if (normr <= tol * normb)
+            {
+                flag = 0;
+                break;
+            }
+        }
+
+        if (normr < normrmin)
+        {
+            normrmin = normr;
+            xmin     = x;
+            imin     = iter;
+        }
+
+        status = Precondition(M, r, sh, ok);
+
+        if (!status.IsOk())
+            return status;
+
+        if (!ok)
+        {
+            flag = 2;
+            break;
+        }
+
+        status = Apply(A, sh, t, 1);
+
+        if (!status.IsOk())
+            return status;
+
+        double tt = Dot(t, t);
+
+        if (tt == 0.0 || !IsFinite_T(tt))
+        {
+            flag = 4;
+            break;
+        }
+
+        omega = Dot(t, r) / tt;
+
+        if (omega == 0.0 || !IsFinite_T(omega))
+        {
+            flag = 4;
+            break;
+        }
+
+        if (small && fabs(omega) * Norm(sh) < eps * Norm(x))
+            ++stag;
+        else
+            stag = 0;
+
+        Axpy(omega, sh, x);
+        Axpy(-omega, t, r);
+        normr = Norm(r);
+        iter  = i;
+        Record(history, resvec, normr);
+
+        if (normr <= tol * normb)
+        {
+            status = Residual(A, bcol, x, r, normr);
+
+            if (!status.IsOk())
+                return status;
+
+            if (normr <= tol * normb)
+            {
+                flag = 0;
+                break;
+            }
+        }
+
+        if (stag >= 3)
+        {
+            flag = 3;
+            break;
+        }
+
+        if (normr < normrmin)
+        {
+            normrmin = normr;
+            xmin     = x;
+            imin     = iter;
+        }
+    }
+
+    if (flag && normrmin < normr)
+    {
+        x     = xmin;
+        iter  = imin;
+        normr = normrmin;
+    }
+
+    relres = normr / normb;
+
+    return WriteHistory(history, resvec);
+}
+//------------------------------------------------------------------------------
+// Returns the status after solving A*x = b with the restarted generalized
+// minimum residual method
+//------------------------------------------------------------------------------
+hwMathStatus GMRES(const KrylovFunc A,
+                   const KrylovFunc M,
+                   const hwMatrix&  b,
+                   hwMatrix&        x,
+                   int              restart,
+                   double           tol,
+                   int              maxOuter,
+                   int&             flag,
+                   double&          relres,
+                   int&             outer,
+                   int&             inner,
+                   hwMatrix*        resvec)
+{
+    hwMathStatus status;
+
+    if (restart < 1)
+        return status(HW_MATH_ERR_NONPOSINT, 5);
+
+    if (IsNaN_T(tol) || tol < 0.0)
+        return status(HW_MATH_ERR_NEGATIVE, 6);
+
+    if (maxOuter < 0)
+        return status(HW_MATH_ERR_NEGATIVE, 7);
+
+    std::vector<double> history;
+    hwMatrix bcol;
+    hwMatrix r;
+    double   normb;
+    double   normr;
+
+    status = Prepare(A, b, x, bcol, r, normb, normr);
+
+    if (!status.IsOk())
+        return status;
+
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    flag   = 1;
+    outer  = 0;
+    inner  = 0;
+    relres = normb == 0.0 ? 0.0 : normr / normb;
+    Record(history, resvec, normr);
+
+    if (normr <= tol * normb)
+    {
+        flag = 0;
+        return WriteHistory(history, resvec);
+    }
+
+    int n  = bcol.Size();
+    int m  = _min(restart, n);
+    int ld = m + 1;
+
+    // the Krylov basis is the only storage that grows with restart
+    hwMatrix V;
+
+    status = V.Dimension(n, m + 1, hwMatrix::REAL);
+
+    if (!status.IsOk())
+    {
+        status.ResetArgs();
+        return status;
+    }
+
+    std::vector<double> H(static_cast<size_t>(ld) * m);   // Hessenberg matrix, reduced to triangular
+    std::vector<double> cs(m);
+    std::vector<double> sn(m);
+    std::vector<double> g(m + 1);
+    std::vector<double> h(m + 1);
+
+    hwMatrix w;
+    hwMatrix z;
+    hwMatrix xmin(x);
+    double   normrmin = normr;
+    int      omin     = 0;
+    int      imin     = 0;
+    double*  v        = V.GetRealData();
+    int      inc      = 1;
+
+    for (int o = 1; o <= maxOuter; ++o)
+    {
+        double normr0 = normr;
+
+        for (int i = 0; i < n; ++i)
+            v[i] = r(i) / normr;
+
+        g.assign(m + 1, 0.0);
+        g[0] = normr;
+
+        int k = 0;
+
+        for (int j = 0; j < m; ++j)
+        {
+            bool     ok;
+            hwMatrix vj(n, 1, v + static_cast<size_t>(j) * n, hwMatrix::REAL);
+
+            status = Precondition(M, vj, z, ok);
+
+            if (!status.IsOk())
+                return status;
+
+            if (!ok)
+            {
+                flag = 2;
+                break;
+            }
+
+            status = Apply(A, z, w, 1);
+
+            if (!status.IsOk())
+                return status;
+
+            // classical Gram-Schmidt against the basis, repeated once to
+            // restore orthogonality, with both passes in BLAS
+            double* hj  = &H[static_cast<size_t>(j) * ld];
+            int     nj  = j + 1;
+            double  one = 1.0;
+            double  mone = -1.0;
+            double  zero = 0.0;
+            char    trans = 'T';
+            char    notrans = 'N';
+
+            for (int i = 0; i <= j; ++i)
+                hj[i] = 0.0;
+
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                hwBlas::dgemv_(&trans, &n, &nj, &one, v, &n, w.GetRealData(), &inc,
+                               &zero, &h[0], &inc);
+                hwBlas::dgemv_(&notrans, &n, &nj, &mone, v, &n, &h[0], &inc,
+                               &one, w.GetRealData(), &inc);
+
+                for (int i = 0; i <= j; ++i)
+                    hj[i] += h[i];
+            }
+
+            double hnext = Norm(w);
+            hj[j + 1] = hnext;
+
+            // apply the earlier rotations, then eliminate hj[j+1]
+            for (int i = 0; i < j; ++i)
+            {
+                double temp = cs[i] * hj[i] + sn[i] * hj[i + 1];
+                hj[i + 1]   = -sn[i] * hj[i] + cs[i] * hj[i + 1];
+                hj[i]       = temp;
+            }
+
+            double denom = sqrt(hj[j] * hj[j] + hj[j + 1] * hj[j + 1]);
+
+            if (denom == 0.0 || !IsFinite_T(denom))
+            {
+                flag = 4;
+                break;
+            }
+
+            cs[j]     = hj[j] / denom;
+            sn[j]     = hj[j + 1] / denom;
+            hj[j]     = denom;
+            hj[j + 1] = 0.0;
+            g[j + 1]  = -sn[j] * g[j];
+            g[j]      = cs[j] * g[j];
+
+            k     = j + 1;
+            outer = o;
+            inner = k;
+            Record(history, resvec, fabs(g[j + 1]));
+
+            // a zero hnext means the Krylov space is invariant, and the
+            // solution is exact in it
+            if (fabs(g[j + 1]) <= tol * normb || hnext == 0.0)
+                break;
+
+            if (j + 1 < m)
+            {
+                double* vnext = v + static_cast<size_t>(j + 1) * n;
+                const double* wdata = w.GetRealData();
+
+                for (int i = 0; i < n; ++i)
+                    vnext[i] = wdata[i] / hnext;
+            }
+        }
+
+        if (k > 0)
+        {
+            // solve the triangular system for the basis coefficients
+            std::vector<double> y(k);
+
+            for (int i = k - 1; i >= 0; --i)
+            {
+                double sum = g[i];
+
+                for (int l = i + 1; l < k; ++l)
+                    sum -= H[static_cast<size_t>(l) * ld + i] * y[l];
+
+                y[i] = sum / H[static_cast<size_t>(i) * ld + i];
+            }
+
+            // x += M\(V*y)
+            double one  = 1.0;
+            double zero = 0.0;
+            char   notrans = 'N';
+            bool   ok;
+
+            hwBlas::dgemv_(&notrans, &n, &k, &one, v, &n, &y[0], &inc,
+                           &zero, w.GetRealData(), &inc);
+
+            status = Precondition(M, w, z, ok);
+
+            if (!status.IsOk())
+                return status;
+
+            if (ok)
+                Axpy(1.0, z, x);
+            else
+                flag = 2;
+        }
+
+        status = Residual(A, bcol, x, r, normr);
+
+        if (!status.IsOk())
+            return status;
+
+        if (normr <= tol * normb)
+        {
+            flag = 0;
+            break;
+        }
+
+        if (normr < normrmin)
+        {
+            normrmin = normr;
+            xmin     = x;
+            omin     = outer;
+            imin     = inner;
+        }
+
+        if (flag != 1)
+            break;
+
+        // a cycle that makes no progress will not make any after a restart
+        if (normr >= normr0 * (1.0 - eps))
+        {
+            flag = 3;
+            break;
+        }
+    }
+
+    if (flag && normrmin < normr)
+    {
+        x     = xmin;
+        outer = omin;
+        inner = imin;
+        normr = normrmin;
+    }
+
+    relres = normr / normb;
+
+    return WriteHistory(history, resvec);
+}
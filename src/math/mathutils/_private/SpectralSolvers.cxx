@@ -0,0 +1,978 @@
+/**
+* @file SpectralSolvers.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+
+#include <SpectralSolvers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <GeneralFuncs.h>
+#include <hwBlasBackend.h>
+#include <hwMathStatus.h>
+
+// File scope variables for the selection function of dgees
+static EigsWhich EIGS_which     = EIGS_LARGEST_MAG;
+static double    EIGS_threshold = 0.0;
+
+//------------------------------------------------------------------------------
+// Applies an operator callback to the columns of x and checks that it returns
+// a real matrix with the given number of rows and the columns of x. argNum is
+// the argument position of the callback.
+//------------------------------------------------------------------------------
+static hwMathStatus Apply(const KrylovFunc func,
+                          const hwMatrix&  x,
+                          int              rows,
+                          hwMatrix&        y,
+                          int              argNum)
+{
+    hwMathStatus status = func(x, y);
+
+    if (!status.IsOk())
+    {
+        if (status.IsWarning())
+            status.ResetArgs();
+        else
+            return status;
+    }
+
+    if (y.Size() != rows * x.N())
+        return status(HW_MATH_ERR_USERFUNCSIZE, argNum);
+
+    if (!y.IsReal())
+        return status(HW_MATH_ERR_USERFUNCREAL, argNum);
+
+    if (y.M() != rows)
+        y.Reshape(rows, x.N());
+
+    return hwMathStatus();
+}
+//------------------------------------------------------------------------------
+// Returns the 2-norm of n values
+//------------------------------------------------------------------------------
+static double Norm(int n, const double* x)
+{
+    int inc = 1;
+
+    return sqrt(hwBlas::ddot_(&n, const_cast<double*>(x), &inc,
+                              const_cast<double*>(x), &inc));
+}
+//------------------------------------------------------------------------------
+// Returns the score of an eigenvalue, which is larger when it is more wanted
+//------------------------------------------------------------------------------
+static double Score(double re, double im, EigsWhich which)
+{
+    switch (which)
+    {
+        case EIGS_LARGEST_REAL:  return re;
+        case EIGS_SMALLEST_REAL: return -re;
+        default:                 return sqrt(re * re + im * im);
+    }
+}
+//------------------------------------------------------------------------------
+// Selection function of dgees, which moves the wanted eigenvalues to the
+// leading block of the Schur form
+//------------------------------------------------------------------------------
+static int SelectWanted(double* wr, double* wi)
+{
+    return (Score(*wr, *wi, EIGS_which) >= EIGS_threshold) ? 1 : 0;
+}
+//------------------------------------------------------------------------------
+// Orthogonalizes w against the first cols columns of the basis V with two
+// passes of classical Gram-Schmidt, and adds the coefficients to h if it is
+// not NULL
+//------------------------------------------------------------------------------
+static void Orthogonalize(hwMatrix& V, int cols, double* w, double* h)
+{
+    if (cols == 0)
+        return;
+
+    int    n     = V.M();
+    int    inc   = 1;
+    double one   = 1.0;
+    double zero  = 0.0;
+    double minus = -1.0;
+    char   trans = 'T';
+    char   notr  = 'N';
+
+    std::vector<double> c(cols);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        hwBlas::dgemv_(&trans, &n, &cols, &one, V.GetRealData(), &n, w, &inc,
+                       &zero, c.data(), &inc);
+        hwBlas::dgemv_(&notr, &n, &cols, &minus, V.GetRealData(), &n, c.data(),
+                       &inc, &one, w, &inc);
+
+        if (h)
+        {
+            for (int i = 0; i < cols; ++i)
+                h[i] += c[i];
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Sets w to a random unit vector that is orthogonal to the first cols columns
+// of V. Returns false if there is no such vector.
+//------------------------------------------------------------------------------
+static bool RandomVector(std::mt19937& gen, hwMatrix& V, int cols, double* w)
+{
+    int n = V.M();
+
+    if (cols >= n)
+        return false;
+
+    std::normal_distribution<double> normal;
+
+    for (int i = 0; i < n; ++i)
+        w[i] = normal(gen);
+
+    double norm0 = Norm(n, w);
+
+    Orthogonalize(V, cols, w, NULL);
+
+    double norm = Norm(n, w);
+
+    if (norm <= 1.0e-8 * norm0)
+        return false;
+
+    for (int i = 0; i < n; ++i)
+        w[i] /= norm;
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Computes C = A(:,0:k-1)*B(0:k-1,0:cols-1) for column major arrays
+//------------------------------------------------------------------------------
+static void Gemm(int m, int k, int cols, const double* A, int lda,
+                 const double* B, int ldb, double* C)
+{
+    if (m == 0 || cols == 0)
+        return;
+
+    char   notr = 'N';
+    double one  = 1.0;
+    double zero = 0.0;
+
+    hwBlas::dgemm_(&notr, &notr, &m, &cols, &k, &one, const_cast<double*>(A),
+                   &lda, const_cast<double*>(B), &ldb, &zero, C, &m);
+}
+//------------------------------------------------------------------------------
+// Computes an orthonormal basis of the columns of the m x l matrix Y in
+// place, with l <= m
+//------------------------------------------------------------------------------
+static hwMathStatus Orthonormalize(hwMatrix& Y)
+{
+    hwMathStatus status;
+
+    int    m     = Y.M();
+    int    l     = Y.N();
+    int    info  = 0;
+    int    lwork = -1;
+    double query = 0.0;
+
+    if (l == 0)
+        return status;
+
+    std::vector<double> tau(l);
+
+    hwBlas::dgeqrf_(&m, &l, Y.GetRealData(), &m, tau.data(), &query, &lwork, &info);
+
+    lwork = _max(static_cast<int>(query), l);
+
+    std::vector<double> work(lwork);
+
+    hwBlas::dgeqrf_(&m, &l, Y.GetRealData(), &m, tau.data(), work.data(), &lwork, &info);
+
+    if (info == 0)
+    {
+        lwork = -1;
+        hwBlas::dorgqr_(&m, &l, &l, Y.GetRealData(), &m, tau.data(), &query, &lwork, &info);
+        lwork = _max(static_cast<int>(query), l);
+        work.resize(lwork);
+        hwBlas::dorgqr_(&m, &l, &l, Y.GetRealData(), &m, tau.data(), work.data(), &lwork, &info);
+    }
+
+    if (info != 0)
+        return status(HW_MATH_ERR_DECOMPFAIL);
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Computes the eigenvalues and eigenvectors of the m x m projection H, with
+// the order of the wanted ones first. The vectors are in Yr and Yi.
+//------------------------------------------------------------------------------
+static hwMathStatus RitzPairs(const hwMatrix&      H,
+                              bool                 symmetric,
+                              EigsWhich            which,
+                              std::vector<double>& re,
+                              std::vector<double>& im,
+                              hwMatrix&            Yr,
+                              hwMatrix&            Yi,
+                              std::vector<int>&    order)
+{
+    hwMathStatus status;
+
+    int m = H.M();
+
+    re.assign(m, 0.0);
+    im.assign(m, 0.0);
+
+    if (symmetric)
+    {
+        // the Lanczos projection is symmetric up to rounding
+        status = Yr.Dimension(m, m, hwMatrix::REAL);
+
+        if (!status.IsOk())
+            return status;
+
+        for (int j = 0; j < m; ++j)
+        {
+            for (int i = 0; i < m; ++i)
+                Yr(i, j) = 0.5 * (H(i, j) + H(j, i));
+        }
+
+        char   jobz  = 'V';
+        char   uplo  = 'U';
+        int    info  = 0;
+        int    lwork = -1;
+        double query = 0.0;
+
+        hwBlas::dsyev_(&jobz, &uplo, &m, Yr.GetRealData(), &m, re.data(), &query, &lwork, &info);
+
+        lwork = _max(static_cast<int>(query), 3 * m);
+
+        std::vector<double> work(lwork);
+
+        hwBlas::dsyev_(&jobz, &uplo, &m, Yr.GetRealData(), &m, re.data(), work.data(), &lwork, &info);
+
+        if (info != 0)
+            return status(HW_MATH_ERR_DECOMPFAIL);
+
+        Yi.Dimension(0, 0, hwMatrix::REAL);
+    }
+    else
+    {
+        hwMatrix D;
+        hwMatrix Y;
+
+        status = H.Eigen(false, &Y, D);
+
+        if (!status.IsOk())
+            return status;
+
+        for (int i = 0; i < m; ++i)
+        {
+            re[i] = D.IsReal() ? D(i) : D.z(i).Real();
+            im[i] = D.IsReal() ? 0.0  : D.z(i).Imag();
+        }
+
+        if (Y.IsReal())
+        {
+            Yr = Y;
+            Yi.Dimension(0, 0, hwMatrix::REAL);
+        }
+        else
+        {
+            status = Y.UnpackComplex(&Yr, &Yi);
+
+            if (!status.IsOk())
+                return status;
+        }
+    }
+
+    std::vector<double> score(m);
+
+    for (int i = 0; i < m; ++i)
+        score[i] = Score(re[i], im[i], which);
+
+    order.resize(m);
+
+    for (int i = 0; i < m; ++i)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(),
+                     [&score](int a, int b) { return score[a] > score[b]; });
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Returns the status after computing k eigenvalues and eigenvectors of an
+// n x n operator, wanted first
+//------------------------------------------------------------------------------
+hwMathStatus Eigs(const KrylovFunc A,
+                  int              n,
+                  int              k,
+                  EigsWhich        which,
+                  bool             symmetric,
+                  int              ncv,
+                  double           tol,
+                  int              maxRestart,
+                  const hwMatrix*  v0,
+                  hwMatrix*        V,
+                  hwMatrix&        D,
+                  int&             flag)
+{
+    hwMathStatus status;
+
+    flag = 0;
+
+    if (!A)
+        return status(HW_MATH_ERR_NULLPOINTER, 1);
+
+    if (n < 2)
+        return status(HW_MATH_ERR_INVALIDINPUT, 2);
+
+    if (k < 1 || k >= n)
+        return status(HW_MATH_ERR_INVALIDINPUT, 3);
+
+    if (ncv <= k || ncv > n)
+        return status(HW_MATH_ERR_INVALIDINPUT, 6);
+
+    if (tol <= 0.0)
+        return status(HW_MATH_ERR_NONPOSITIVE, 7);
+
+    if (maxRestart < 0)
+        return status(HW_MATH_ERR_NEGATIVE, 8);
+
+    if (v0 && v0->Size() != n)
+        return status(HW_MATH_ERR_ARRAYSIZE, 2, 9);
+
+    if (v0 && !v0->IsReal())
+        return status(HW_MATH_ERR_COMPLEXSUPPORT, 9);
+
+    int m = ncv;
+
+    // the basis has m+1 columns, and A*V(:,0:m-1) = V(:,0:m-1)*H + V(:,m)*b'
+    // where b = beta*e(m-1) after an expansion
+    hwMatrix     basis(n, m + 1, hwMatrix::REAL);
+    hwMatrix     H(m, m, hwMatrix::REAL);
+    hwMatrix     w;
+    std::mt19937 gen;
+
+    double* v = basis.GetRealData();
+
+    H.SetElements(0.0);
+
+    if (v0 && Norm(n, v0->GetRealData()) > 0.0)
+    {
+        double norm = Norm(n, v0->GetRealData());
+
+        for (int i = 0; i < n; ++i)
+            v[i] = (*v0)(i) / norm;
+    }
+    else
+    {
+        RandomVector(gen, basis, 0, v);
+    }
+
+    // the eigenvalues closest to zero use an absolute tolerance
+    double eps23 = pow(std::numeric_limits<double>::epsilon(), 2.0 / 3.0);
+
+    std::vector<double> re;
+    std::vector<double> im;
+    std::vector<int>    order;
+    std::vector<double> h(m);
+    hwMatrix            Yr;
+    hwMatrix            Yi;
+    double              beta  = 0.0;
+    int                 start = 0;
+
+    for (int restart = 0; ; ++restart)
+    {
+        // expand the Arnoldi factorization from column start
+        for (int j = start; j < m; ++j)
+        {
+            hwMatrix vj(n, 1, v + static_cast<size_t>(j) * n, hwMatrix::REAL);
+
+            status = Apply(A, vj, n, w, 1);
+
+            if (!status.IsOk())
+                return status;
+
+            std::fill(h.begin(), h.end(), 0.0);
+
+            double  normw = Norm(n, w.GetRealData());
+            double* next  = v + static_cast<size_t>(j + 1) * n;
+
+            Orthogonalize(basis, j + 1, w.GetRealData(), h.data());
+
+            for (int i = 0; i <= j; ++i)
+                H(i, j) = h[i];
+
+            beta = Norm(n, w.GetRealData());
+
+            if (beta > 1.0e-12 * normw)
+            {
+                for (int i = 0; i < n; ++i)
+                    next[i] = w(i) / beta;
+            }
+            else
+            {
+                // the basis spans an invariant subspace, and is continued
+                // with any orthogonal vector
+                beta = 0.0;
+
+                if (!RandomVector(gen, basis, j + 1, next))
+                    std::fill(next, next + n, 0.0);
+            }
+
+            if (j + 1 < m)
+                H(j + 1, j) = beta;
+        }
+
+        status = RitzPairs(H, symmetric, which, re, im, Yr, Yi, order);
+
+        if (!status.IsOk())
+            return status;
+
+        // the residual norm of a Ritz pair is beta times the magnitude of
+        // the last component of its vector
+        int nconv = 0;
+
+        for (int i = 0; i < k; ++i)
+        {
+            int    c     = order[i];
+            double last  = Yr(m - 1, c);
+            double lasti = Yi.IsEmpty() ? 0.0 : Yi(m - 1, c);
+            double resid = beta * sqrt(last * last + lasti * lasti);
+            double scale = _max(sqrt(re[c] * re[c] + im[c] * im[c]), eps23);
+
+            if (resid <= tol * scale)
+                ++nconv;
+        }
+
+        if (nconv == k || beta == 0.0 || restart >= maxRestart)
+        {
+            if (nconv < k && beta != 0.0)
+                flag = 1;
+
+            break;
+        }
+
+        // keep the wanted part and half of the rest, which speeds up the
+        // convergence of the wanted pairs
+        int    keep = _min(k + (m - k) / 2, m - 1);
+        double ref  = Score(re[order[keep - 1]], im[order[keep - 1]], which);
+        double span = Score(re[order[0]], im[order[0]], which) -
+                      Score(re[order[m - 1]], im[order[m - 1]], which);
+
+        hwMatrix Q;
+        hwMatrix T;
+
+        if (symmetric)
+        {
+            status = Q.Dimension(m, keep, hwMatrix::REAL);
+
+            if (!status.IsOk())
+                return status;
+
+            status = T.Dimension(keep, keep, hwMatrix::REAL);
+
+            if (!status.IsOk())
+                return status;
+
+            T.SetElements(0.0);
+
+            for (int j = 0; j < keep; ++j)
+            {
+                for (int i = 0; i < m; ++i)
+                    Q(i, j) = Yr(i, order[j]);
+
+                T(j, j) = re[order[j]];
+            }
+        }
+        else
+        {
+            // reorder the real Schur form of H so the wanted eigenvalues lead,
+            // with a threshold that includes ties and the rounding of dgees
+            EigsWhich prevWhich     = EIGS_which;
+            double    prevThreshold = EIGS_threshold;
+
+            EIGS_which     = which;
+            EIGS_threshold = ref - 1.0e-10 * _max(std::abs(span), std::abs(ref));
+
+            char   jobvs = 'V';
+            char   sort  = 'S';
+            int    sdim  = 0;
+            int    info  = 0;
+            int    lwork = -1;
+            double query = 0.0;
+
+            hwMatrix         S(H);
+            hwMatrix         U(m, m, hwMatrix::REAL);
+            std::vector<double> wr(m);
+            std::vector<double> wi(m);
+            std::vector<int>    bwork(m, 0);
+
+            hwBlas::dgees_(&jobvs, &sort, (void*) SelectWanted, &m, S.GetRealData(), &m,
+                           &sdim, wr.data(), wi.data(), U.GetRealData(), &m, &query,
+                           &lwork, bwork.data(), &info);
+
+            lwork = _max(static_cast<int>(query), 3 * m);
+
+            std::vector<double> work(lwork);
+
+            hwBlas::dgees_(&jobvs, &sort, (void*) SelectWanted, &m, S.GetRealData(), &m,
+                           &sdim, wr.data(), wi.data(), U.GetRealData(), &m, work.data(),
+                           &lwork, bwork.data(), &info);
+
+            EIGS_which     = prevWhich;
+            EIGS_threshold = prevThreshold;
+
+            // info of m+1 or m+2 only reports that the reordered eigenvalues
+            // changed slightly, and any leading block is still invariant
+            if (info != 0 && info <= m)
+                return status(HW_MATH_ERR_DECOMPFAIL);
+
+            keep = _min(_max(sdim, keep), m - 1);
+
+            // a 2x2 block of a complex pair is not split
+            if (S(keep, keep - 1) != 0.0)
+                ++keep;
+
+            if (keep >= m)
+                keep -= 2;
+
+            status = Q.Dimension(m, keep, hwMatrix::REAL);
+
+            if (!status.IsOk())
+                return status;
+
+            status = T.Dimension(keep, keep, hwMatrix::REAL);
+
+            if (!status.IsOk())
+                return status;
+
+            for (int j = 0; j < keep; ++j)
+            {
+                for (int i = 0; i < m; ++i)
+                    Q(i, j) = U(i, j);
+
+                for (int i = 0; i < keep; ++i)
+                    T(i, j) = S(i, j);
+            }
+        }
+
+        // restart with A*V(:,0:keep-1) = V(:,0:keep-1)*T + V(:,keep)*b'
+        hwMatrix Vq(n, keep, hwMatrix::REAL);
+
+        Gemm(n, m, keep, v, n, Q.GetRealData(), m, Vq.GetRealData());
+
+        std::copy(Vq.GetRealData(), Vq.GetRealData() + static_cast<size_t>(n) * keep, v);
+        std::copy(v + static_cast<size_t>(m) * n, v + static_cast<size_t>(m + 1) * n,
+                  v + static_cast<size_t>(keep) * n);
+
+        H.SetElements(0.0);
+
+        for (int j = 0; j < keep; ++j)
+        {
+            for (int i = 0; i < keep; ++i)
+                H(i, j) = T(i, j);
+
+            H(keep, j) = beta * Q(m - 1, j);
+        }
+
+        start = keep;
+    }
+
+    // eigenvalues and the Ritz vectors V(:,0:m-1)*Y
+    bool isReal = true;
+
+    for (int i = 0; i < k && isReal; ++i)
+        isReal = (im[order[i]] == 0.0);
+
+    status = D.Dimension(k, 1, isReal ? hwMatrix::REAL : hwMatrix::COMPLEX);
+
+    if (!status.IsOk())
+        return status;
+
+    for (int i = 0; i < k; ++i)
+    {
+        if (isReal)
+            D(i) = re[order[i]];
+        else
+            D.z(i) = hwComplex(re[order[i]], im[order[i]]);
+    }
+
+    if (V)
+    {
+        hwMatrix Ywr(m, k, hwMatrix::REAL);
+        hwMatrix Ywi(m, k, hwMatrix::REAL);
+        hwMatrix Xr(n, k, hwMatrix::REAL);
+        hwMatrix Xi(n, k, hwMatrix::REAL);
+
+        for (int j = 0; j < k; ++j)
+        {
+            for (int i = 0; i < m; ++i)
+            {
+                Ywr(i, j) = Yr(i, order[j]);
+                Ywi(i, j) = Yi.IsEmpty() ? 0.0 : Yi(i, order[j]);
+            }
+        }
+
+        Gemm(n, m, k, v, n, Ywr.GetRealData(), m, Xr.GetRealData());
+
+        if (isReal)
+        {
+            *V = Xr;
+        }
+        else
+        {
+            Gemm(n, m, k, v, n, Ywi.GetRealData(), m, Xi.GetRealData());
+            status = V->PackComplex(Xr, &Xi);
+        }
+    }
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Sets column j of the basis W to w/norm, or to a random vector orthogonal to
+// the previous columns if w has vanished. Returns the norm, which is zero in
+// the second case.
+//------------------------------------------------------------------------------
+static double NextBasisVector(std::mt19937& gen,
+                              hwMatrix&     W,
+                              int           j,
+                              double*       w,
+                              double        norm0)
+{
+    int     rows = W.M();
+    double* next = W.GetRealData() + static_cast<size_t>(j) * rows;
+    double  norm = Norm(rows, w);
+
+    if (norm > 1.0e-12 * norm0)
+    {
+        for (int i = 0; i < rows; ++i)
+            next[i] = w[i] / norm;
+
+        return norm;
+    }
+
+    if (!RandomVector(gen, W, j, next))
+        std::fill(next, next + rows, 0.0);
+
+    return 0.0;
+}
+//------------------------------------------------------------------------------
+// Returns the status after computing the k largest singular values and
+// vectors of an m x n operator with the Lanczos bidiagonalization method
+//------------------------------------------------------------------------------
+hwMathStatus Svds(const KrylovFunc A,
+                  const KrylovFunc At,
+                  int              m,
+                  int              n,
+                  int              k,
+                  int              ncv,
+                  double           tol,
+                  int              maxRestart,
+                  hwMatrix*        U,
+                  hwMatrix&        S,
+                  hwMatrix*        V,
+                  int&             flag)
+{
+    hwMathStatus status;
+
+    flag = 0;
+
+    if (!A)
+        return status(HW_MATH_ERR_NULLPOINTER, 1);
+
+    if (!At)
+        return status(HW_MATH_ERR_NULLPOINTER, 2);
+
+    if (m < 1)
+        return status(HW_MATH_ERR_NONPOSINT, 3);
+
+    if (n < 1)
+        return status(HW_MATH_ERR_NONPOSINT, 4);
+
+    int order = _min(m, n);
+
+    if (k < 1 || k >= order)
+        return status(HW_MATH_ERR_INVALIDINPUT, 5);
+
+    if (ncv <= k || ncv > order)
+        return status(HW_MATH_ERR_INVALIDINPUT, 6);
+
+    if (tol <= 0.0)
+        return status(HW_MATH_ERR_NONPOSITIVE, 7);
+
+    if (maxRestart < 0)
+        return status(HW_MATH_ERR_NEGATIVE, 8);
+
+    // A*P(:,0:c-1) = Q*B and A'*Q = P(:,0:c-1)*B' + P(:,c)*b' where c = ncv
+    // and b = beta*e(c-1). B is upper bidiagonal after the first expansion,
+    // and has a column of coupling terms after the kept part on a restart.
+    // Both bases are orthogonalized in full, so the small singular values
+    // keep the accuracy of A rather than that of A'*A.
+    int          c = ncv;
+    hwMatrix     P(n, c + 1, hwMatrix::REAL);
+    hwMatrix     Q(m, c, hwMatrix::REAL);
+    hwMatrix     B(c, c, hwMatrix::REAL);
+    hwMatrix     Ub;
+    hwMatrix     Sb;
+    hwMatrix     Vb;
+    hwMatrix     t;
+    hwMatrix     r;
+    std::mt19937 gen;
+
+    RandomVector(gen, P, 0, P.GetRealData());
+    B.SetElements(0.0);
+
+    std::vector<double> h(c);
+    double              beta  = 0.0;
+    int                 start = 0;
+
+    for (int restart = 0; ; ++restart)
+    {
+        for (int j = start; j < c; ++j)
+        {
+            hwMatrix pj(n, 1, P.GetRealData() + static_cast<size_t>(j) * n, hwMatrix::REAL);
+
+            status = Apply(A, pj, m, t, 1);
+
+            if (!status.IsOk())
+                return status;
+
+            std::fill(h.begin(), h.end(), 0.0);
+
+            double norm0 = Norm(m, t.GetRealData());
+
+            Orthogonalize(Q, j, t.GetRealData(), h.data());
+
+            for (int i = 0; i < j; ++i)
+                B(i, j) = h[i];
+
+            B(j, j) = NextBasisVector(gen, Q, j, t.GetRealData(), norm0);
+
+            hwMatrix qj(m, 1, Q.GetRealData() + static_cast<size_t>(j) * m, hwMatrix::REAL);
+
+            status = Apply(At, qj, n, r, 2);
+
+            if (!status.IsOk())
+                return status;
+
+            norm0 = Norm(n, r.GetRealData());
+
+            Orthogonalize(P, j + 1, r.GetRealData(), NULL);
+
+            beta = NextBasisVector(gen, P, j + 1, r.GetRealData(), norm0);
+        }
+
+        status = B.SVD(2, &Ub, Sb, &Vb);
+
+        if (!status.IsOk())
+            return status;
+
+        // the residual of a Ritz triplet is |A'*u - s*v| = beta*|Ub(c-1,i)|,
+        // taken relative to the largest singular value
+        int nconv = 0;
+
+        for (int i = 0; i < k; ++i)
+        {
+            if (beta * std::abs(Ub(c - 1, i)) <= tol * Sb(0))
+                ++nconv;
+        }
+
+        if (nconv == k || beta == 0.0 || restart >= maxRestart)
+        {
+            if (nconv < k && beta != 0.0)
+                flag = 1;
+
+            break;
+        }
+
+        // keep the wanted triplets and half of the rest, followed by the
+        // residual direction, which is already the last column of P
+        int keep = _min(k + (c - k) / 2, c - 1);
+
+        hwMatrix Pk(n, keep, hwMatrix::REAL);
+        hwMatrix Qk(m, keep, hwMatrix::REAL);
+
+        Gemm(n, c, keep, P.GetRealData(), n, Vb.GetRealData(), c, Pk.GetRealData());
+        Gemm(m, c, keep, Q.GetRealData(), m, Ub.GetRealData(), c, Qk.GetRealData());
+
+        double* p = P.GetRealData();
+
+        std::copy(Pk.GetRealData(), Pk.GetRealData() + static_cast<size_t>(n) * keep, p);
+        std::copy(p + static_cast<size_t>(c) * n, p + static_cast<size_t>(c + 1) * n,
+                  p + static_cast<size_t>(keep) * n);
+        std::copy(Qk.GetRealData(), Qk.GetRealData() + static_cast<size_t>(m) * keep,
+                  Q.GetRealData());
+
+        B.SetElements(0.0);
+
+        for (int i = 0; i < keep; ++i)
+            B(i, i) = Sb(i);
+
+        start = keep;
+    }
+
+    status = S.Dimension(k, 1, hwMatrix::REAL);
+
+    if (!status.IsOk())
+        return status;
+
+    for (int i = 0; i < k; ++i)
+        S(i) = Sb(i);
+
+    if (U)
+    {
+        status = U->Dimension(m, k, hwMatrix::REAL);
+
+        if (!status.IsOk())
+            return status;
+
+        Gemm(m, c, k, Q.GetRealData(), m, Ub.GetRealData(), c, U->GetRealData());
+    }
+
+    if (V)
+    {
+        status = V->Dimension(n, k, hwMatrix::REAL);
+
+        if (!status.IsOk())
+            return status;
+
+        Gemm(n, c, k, P.GetRealData(), n, Vb.GetRealData(), c, V->GetRealData());
+    }
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Returns the status after computing an approximation of the k largest
+// singular values and vectors of an m x n operator with a randomized range
+// finder
+//------------------------------------------------------------------------------
+hwMathStatus RandomizedSVD(const KrylovFunc A,
+                           const KrylovFunc At,
+                           int              m,
+                           int              n,
+                           int              k,
+                           int              oversample,
+                           int              powerIter,
+                           hwMatrix*        U,
+                           hwMatrix&        S,
+                           hwMatrix*        V)
+{
+    hwMathStatus status;
+
+    if (!A)
+        return status(HW_MATH_ERR_NULLPOINTER, 1);
+
+    if (!At)
+        return status(HW_MATH_ERR_NULLPOINTER, 2);
+
+    if (m < 1)
+        return status(HW_MATH_ERR_NONPOSINT, 3);
+
+    if (n < 1)
+        return status(HW_MATH_ERR_NONPOSINT, 4);
+
+    if (k < 1 || k > _min(m, n))
+        return status(HW_MATH_ERR_INVALIDINPUT, 5);
+
+    if (oversample < 0)
+        return status(HW_MATH_ERR_NEGATIVE, 6);
+
+    if (powerIter < 0)
+        return status(HW_MATH_ERR_NEGATIVE, 7);
+
+    int l = _min(k + oversample, _min(m, n));
+
+    // Gaussian test matrix, with a fixed seed so results are repeatable
+    hwMatrix                         Omega(n, l, hwMatrix::REAL);
+    std::mt19937                     gen;
+    std::normal_distribution<double> normal;
+
+    for (int i = 0; i < Omega.Size(); ++i)
+        Omega(i) = normal(gen);
+
+    // range of A*Omega, refined with power iterations on A*A'
+    hwMatrix Y;
+    hwMatrix Z;
+
+    status = Apply(A, Omega, m, Y, 1);
+
+    if (status.IsOk())
+        status = Orthonormalize(Y);
+
+    for (int q = 0; q < powerIter && status.IsOk(); ++q)
+    {
+        status = Apply(At, Y, n, Z, 2);
+
+        if (status.IsOk())
+            status = Orthonormalize(Z);
+
+        if (status.IsOk())
+            status = Apply(A, Z, m, Y, 1);
+
+        if (status.IsOk())
+            status = Orthonormalize(Y);
+    }
+
+    if (!status.IsOk())
+        return status;
+
+    // B = Y'*A is l x n, and its SVD comes from that of B' = W*S*Zb'
+    hwMatrix Bt;
+    hwMatrix W;
+    hwMatrix Sl;
+    hwMatrix Zb;
+
+    status = Apply(At, Y, n, Bt, 2);
+
+    if (status.IsOk())
+        status = Bt.SVD(2, &W, Sl, &Zb);
+
+    if (!status.IsOk())
+        return status;
+
+    status = S.Dimension(k, 1, hwMatrix::REAL);
+
+    if (!status.IsOk())
+        return status;
+
+    for (int i = 0; i < k; ++i)
+        S(i) = Sl(i);
+
+    if (U)
+    {
+        // U = Y*Zb, where only the first k columns of Zb are needed
+        status = U->Dimension(m, k, hwMatrix::REAL);
+
+        if (!status.IsOk())
+            return status;
+
+        Gemm(m, l, k, Y.GetRealData(), m, Zb.GetRealData(), l, U->GetRealData());
+    }
+
+    if (V)
+    {
+        status = V->Dimension(n, k, hwMatrix::REAL);
+
+        if (!status.IsOk())
+            return status;
+
+        std::copy(W.GetRealData(), W.GetRealData() + static_cast<size_t>(n) * k,
+                  V->GetRealData());
+    }
+
+    return status;
+}
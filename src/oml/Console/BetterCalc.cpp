@@ -19,6 +19,7 @@
 #include "../Runtime/Interpreter.h"
 #include "../Runtime/EvaluatorDebug.h"
 #include "../Runtime/StructData.h"	// hml2 for now 
+#include "hwBlasBackend.h"
 
 #include <cassert>
 #include <clocale>
@@ -130,6 +131,13 @@ int main(int argc, char* argv[])
 
 
 	interp = new Interpreter;
+
+    // Select the BLAS/LAPACK backend given by OML_BLAS, if any
+    if (!hwBlasBackend::Initialize())
+    {
+        std::cout << "Warning: cannot load BLAS library '" << getenv("OML_BLAS")
+                  << "'; using reference BLAS" << std::endl;
+    }
     
     char* cdir = getenv("OML_APPDIR");
     if (cdir)
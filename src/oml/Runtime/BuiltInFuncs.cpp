@@ -52,6 +52,13 @@
 #include "hwComplex.h"
 #include "StructData.h"
 #include "MatrixNUtils.h"
+#include "hwThreadPool.h"
+#include "hwVectorMath.h"
+#include "hwMatrixS.h"
+#include "hwMatrixFixed.h"
+#include "IntegerArithmetic.h"
+#include "LogicalArray.h"
+#include "Decomposition.h"
 
 #include <cmath>
 #include <time.h>
@@ -114,8 +121,9 @@ struct Precision
     size_t numBytes;
     int blockSize;
     DataType dtype;
+    int outType;        // currency type of the values read: double matrix, single or an integer class
     Precision (bool issigned, size_t numOfBytes, int mult, DataType type) : 
-              sign(issigned), numBytes(numOfBytes), blockSize(mult), dtype(type) {} 
+              sign(issigned), numBytes(numOfBytes), blockSize(mult), dtype(type), outType(Currency::TYPE_MATRIX) {} 
 };
 
 enum FormatType
@@ -240,6 +248,16 @@ void mapBuiltInFuncs(std::map<std::string, BuiltinFunc>* std_functions)
     (*std_functions)["intersect"]          = BuiltinFunc(oml_intersect, FunctionMetaData(-1, -1, ELEM));
     (*std_functions)["setxor"]             = BuiltinFunc(oml_setxor, FunctionMetaData(-1, -1, ELEM));
     (*std_functions)["double"]             = BuiltinFunc(oml_double, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["single"]             = BuiltinFunc(oml_single, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["int8"]               = BuiltinFunc(oml_int8, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["int16"]              = BuiltinFunc(oml_int16, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["int32"]              = BuiltinFunc(oml_int32, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["int64"]              = BuiltinFunc(oml_int64, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["uint8"]              = BuiltinFunc(oml_uint8, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["uint16"]             = BuiltinFunc(oml_uint16, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["uint32"]             = BuiltinFunc(oml_uint32, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["uint64"]             = BuiltinFunc(oml_uint64, FunctionMetaData(1, 1, ELEM));
+    (*std_functions)["isinteger"]          = BuiltinFunc(oml_isinteger, FunctionMetaData(1, 1, CORE));
     (*std_functions)["regexp"]             = BuiltinFunc(oml_regexp, FunctionMetaData(-1, -1, STNG));
     (*std_functions)["cell2struct"]        = BuiltinFunc(oml_cell2struct, FunctionMetaData(3, 1, DATA));
     (*std_functions)["cplxpair"]           = BuiltinFunc(oml_cplxpair, FunctionMetaData(3, 1, ELEM));
@@ -376,6 +394,11 @@ void mapBuiltInFuncs(std::map<std::string, BuiltinFunc>* std_functions)
     (*std_functions)["chol"]               = BuiltinFunc(oml_chol, FunctionMetaData(2, 2, LINA));
     (*std_functions)["complex"]            = BuiltinFunc(oml_complex, FunctionMetaData(2, 1, ELEM));
     (*std_functions)["transpose"]          = BuiltinFunc(oml_transpose, FunctionMetaData(1, 1, LINA));
+    (*std_functions)["sparse"]             = BuiltinFunc(oml_sparse, FunctionMetaData(5, 1, LINA));
+    (*std_functions)["full"]               = BuiltinFunc(oml_full, FunctionMetaData(1, 1, LINA));
+    (*std_functions)["nnz"]                = BuiltinFunc(oml_nnz, FunctionMetaData(1, 1, LINA));
+    (*std_functions)["issparse"]           = BuiltinFunc(oml_issparse, FunctionMetaData(1, 1, LINA));
+    (*std_functions)["decomposition"]      = BuiltinFunc(oml_decomposition, FunctionMetaData(1, 1, LINA));
     (*std_functions)["eye"]                = BuiltinFunc(oml_eye, FunctionMetaData(-1, 1, ELEM));
     (*std_functions)["sign"]               = BuiltinFunc(oml_sign, FunctionMetaData(1, 1, ELEM));
     (*std_functions)["pow2"]               = BuiltinFunc(oml_pow2, FunctionMetaData(2, 1, ELEM));
@@ -390,6 +413,9 @@ void mapBuiltInFuncs(std::map<std::string, BuiltinFunc>* std_functions)
     (*std_functions)["zeros"]              = BuiltinFunc(oml_zeros, FunctionMetaData(-1, 1, ELEM));
     (*std_functions)["trace"]              = BuiltinFunc(oml_trace, FunctionMetaData(1, 2, LINA));
     (*std_functions)["det"]                = BuiltinFunc(oml_det, FunctionMetaData(1, 2, LINA));
+    (*std_functions)["pagedet"]            = BuiltinFunc(oml_pagedet, FunctionMetaData(1, 1, LINA));
+    (*std_functions)["pageinv"]            = BuiltinFunc(oml_pageinv, FunctionMetaData(1, 1, LINA));
+    (*std_functions)["pageeig"]            = BuiltinFunc(oml_pageeig, FunctionMetaData(1, 2, LINA));
     (*std_functions)["rcond"]              = BuiltinFunc(oml_rcond, FunctionMetaData(1, 1, LINA));
     (*std_functions)["mod"]                = BuiltinFunc(oml_mod, FunctionMetaData(2, 2, ELEM));
     (*std_functions)["exp"]                = BuiltinFunc(oml_exp, FunctionMetaData(1, 1, ELEM));
@@ -455,6 +481,8 @@ void mapBuiltInFuncs(std::map<std::string, BuiltinFunc>* std_functions)
     (*std_functions)["subsref"]            = BuiltinFunc(oml_subsref, FunctionMetaData(2, 1, CORE));
     (*std_functions)["subsasgn"]           = BuiltinFunc(oml_subsasgn, FunctionMetaData(3, 1, DATA));
     (*std_functions)["flintmax"]           = BuiltinFunc(oml_flintmax, FunctionMetaData(1, 1, CORE));
+    (*std_functions)["intmax"]             = BuiltinFunc(oml_intmax, FunctionMetaData(1, 1, CORE));
+    (*std_functions)["intmin"]             = BuiltinFunc(oml_intmin, FunctionMetaData(1, 1, CORE));
     (*std_functions)["mislocked"]          = BuiltinFunc(oml_mislocked, FunctionMetaData(1, 1, CORE));
     (*std_functions)["mlock"]              = BuiltinFunc(oml_mlock, FunctionMetaData(0, 0, CORE));
     (*std_functions)["munlock"]            = BuiltinFunc(oml_munlock, FunctionMetaData(1, 0, CORE));
@@ -546,6 +574,11 @@ void mapBuiltInFuncs(std::map<std::string, BuiltinFunc>* std_functions)
     (*std_functions)["dos"]      = BuiltinFunc(BuiltInFuncsSystem::System, FunctionMetaData(-2, -2, SYSTEM));
     (*std_functions)["unix"]     = BuiltinFunc(BuiltInFuncsSystem::Unix,   FunctionMetaData(2, 2, SYSTEM));
     (*std_functions)["delete"]   = BuiltinFunc(BuiltInFuncsSystem::Delete, FunctionMetaData(-1, 0, SYSTEM));
+    (*std_functions)["blas"]        = BuiltinFunc(BuiltInFuncsSystem::Blas,        FunctionMetaData(1, 2, SYSTEM));
+    (*std_functions)["blasthreads"] = BuiltinFunc(BuiltInFuncsSystem::BlasThreads, FunctionMetaData(1, 1, SYSTEM));
+    (*std_functions)["mempoolstats"] = BuiltinFunc(BuiltInFuncsSystem::MemPoolStats, FunctionMetaData(1, 1, SYSTEM));
+    (*std_functions)["maththreads"]  = BuiltinFunc(BuiltInFuncsSystem::MathThreads,  FunctionMetaData(3, 3, SYSTEM));
+    (*std_functions)["solverpath"]   = BuiltinFunc(BuiltInFuncsSystem::SolverPath,   FunctionMetaData(0, 1, SYSTEM));
 
     // Client specific environment related functions
     (*std_functions)["getbaseenv"]    = BuiltinFunc(BuiltInFuncsSystem::GetBaseEnv, 
@@ -725,6 +758,87 @@ bool oml_flintmax(EvaluatorInterface eval, const std::vector<Currency>& inputs,
     return true;
 }
 //------------------------------------------------------------------------------
+// Returns the currency type of an integer class name, or -1 if it is not one
+//------------------------------------------------------------------------------
+static int getIntegerType(const std::string& name)
+{
+    if (name == "int8")   return Currency::TYPE_INT8;
+    if (name == "int16")  return Currency::TYPE_INT16;
+    if (name == "int32")  return Currency::TYPE_INT32;
+    if (name == "int64")  return Currency::TYPE_INT64;
+    if (name == "uint8")  return Currency::TYPE_UINT8;
+    if (name == "uint16") return Currency::TYPE_UINT16;
+    if (name == "uint32") return Currency::TYPE_UINT32;
+    if (name == "uint64") return Currency::TYPE_UINT64;
+
+    return -1;
+}
+//------------------------------------------------------------------------------
+// Creates the largest or smallest value of an integer class
+//------------------------------------------------------------------------------
+struct IntegerLimit
+{
+    explicit IntegerLimit(bool max) : largest(max) {}
+
+    template <typename T>
+    void Apply()
+    {
+        hwTMatrix<T, hwTComplex<T> >* mtx = new hwTMatrix<T, hwTComplex<T> >(1, 1, hwTMatrix<T, hwTComplex<T> >::REAL);
+        result = mtx;
+        (*mtx)(0) = largest ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+    }
+
+    bool     largest;
+    Currency result;
+};
+//------------------------------------------------------------------------------
+// Helper for intmax and intmin
+//------------------------------------------------------------------------------
+static bool integerLimit(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs, bool largest)
+{
+    size_t nargin = inputs.size();
+
+    if (nargin > 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    int int_type = Currency::TYPE_INT32;
+
+    if (nargin)
+    {
+        if (inputs[0].IsString())
+        {
+            std::string opt = readOption(eval, inputs[0]);
+            int_type = getIntegerType(opt);
+            if (int_type < 0)
+                throw OML_Error(HW_ERROR_INVALIDOPTION(opt));
+        }
+        else if (inputs[0].IsIntegerType())
+            int_type = inputs[0].GetType();
+        else
+            throw OML_Error(HW_ERROR_INPUTSTRING);
+    }
+
+    IntegerLimit functor(largest);
+    DispatchInteger(int_type, functor);
+    outputs.push_back(functor.result);
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns the largest value of an integer class [intmax]
+//------------------------------------------------------------------------------
+bool oml_intmax(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return integerLimit(eval, inputs, outputs, true);
+}
+//------------------------------------------------------------------------------
+// Returns the smallest value of an integer class [intmin]
+//------------------------------------------------------------------------------
+bool oml_intmin(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return integerLimit(eval, inputs, outputs, false);
+}
+//------------------------------------------------------------------------------
 // Verifies field names
 //------------------------------------------------------------------------------
 static void VerifySubsStructFields(const StructData* sd)
@@ -798,7 +912,7 @@ bool oml_subsasgn(EvaluatorInterface eval, const std::vector<Currency>& inputs,
             else if (subs.IsCellArray())
             {
                 HML_CELLARRAY* cell = subs.CellArray();
-                for (int i = 0; i < cell->Size(); ++i)
+                for (int64_t i = 0; i < cell->Size(); ++i)
                 {
                     const Currency& idx = (*cell)(i);
                     if (idx.IsString() && idx.StringVal() == ":")
@@ -886,7 +1000,7 @@ bool oml_subsref(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
             else if (subs.IsCellArray())
             {
                 HML_CELLARRAY* cell = subs.CellArray();
-                for (int i = 0; i < cell->Size(); ++i)
+                for (int64_t i = 0; i < cell->Size(); ++i)
                 {
                     const Currency& idx = (*cell)(i);
                     if (idx.IsString() && idx.StringVal() == ":")
@@ -1130,14 +1244,14 @@ bool oml_atan2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 
             if (x->IsReal())
             {
-                for (int i = 0; i < x->Size(); ++i)
+                for (int64_t i = 0; i < x->Size(); ++i)
                 {
                     (*result)(i) = std::atan2(y, (*x)(i));
                 }
             }
             else
             {
-                for (int i = 0; i < x->Size(); ++i)
+                for (int64_t i = 0; i < x->Size(); ++i)
                 {
                     (*result)(i) = std::atan2(y, x->z(i).Real());
                 }
@@ -1161,14 +1275,14 @@ bool oml_atan2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 
             if (y->IsReal())
             {
-                for (int i = 0; i < y->Size(); ++i)
+                for (int64_t i = 0; i < y->Size(); ++i)
                 {
                     (*result)(i) = std::atan2((*y)(i), inputs[1].Scalar());
                 }
             }
             else
             {
-                for (int i = 0; i < y->Size(); ++i)
+                for (int64_t i = 0; i < y->Size(); ++i)
                 {
                     (*result)(i) = std::atan2(y->z(i).Real(), inputs[1].Scalar());
                 }
@@ -1184,9 +1298,16 @@ bool oml_atan2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 
             hwMatrix* result = EvaluatorInterface::allocateMatrix(y->M(), y->N(), hwMatrix::REAL);
 
-            for (int i = 0; i < y->Size(); ++i)
+            if (y->IsReal() && x->IsReal())
+            {
+                hwVectorMath::Atan2(y->Size(), y->GetRealData(), x->GetRealData(), result->GetRealData());
+            }
+            else
             {
-                (*result)(i) = std::atan2(realval(y,i), realval(x,i));
+                for (int64_t i = 0; i < y->Size(); ++i)
+                {
+                    (*result)(i) = std::atan2(realval(y,i), realval(x,i));
+                }
             }
             outputs.push_back(result);
         }
@@ -1352,7 +1473,7 @@ bool oml_cart2sph(EvaluatorInterface eval, const std::vector<Currency>& inputs,
             const hwMatrix* x = results[0].Matrix();
             const hwMatrix* y = results[1].Matrix();
             const hwMatrix* z = results[2].Matrix();
-            hwMatrix* outmtx = EvaluatorInterface::allocateMatrix(x->Size(), (int)nargin, x->Type());
+            hwMatrix* outmtx = EvaluatorInterface::allocateMatrix(static_cast<int>(x->Size()), (int)nargin, x->Type());
             
             if (x->IsReal())
             {
@@ -1445,7 +1566,7 @@ bool oml_sph2cart(EvaluatorInterface eval, const std::vector<Currency>& inputs,
             const hwMatrix* x = results[0].Matrix();
             const hwMatrix* y = results[1].Matrix();
             const hwMatrix* z = results[2].Matrix();
-            hwMatrix* outmtx = EvaluatorInterface::allocateMatrix(x->Size(), (int)nargin, x->Type());
+            hwMatrix* outmtx = EvaluatorInterface::allocateMatrix(static_cast<int>(x->Size()), (int)nargin, x->Type());
             
             if (x->IsReal())
             {
@@ -1565,7 +1686,7 @@ bool oml_cart2pol(EvaluatorInterface eval, const std::vector<Currency>& inputs,
             const hwMatrix* z;
             if (usez)
                 z = results[2].Matrix();
-            hwMatrix* outmtx = EvaluatorInterface::allocateMatrix(x->Size(), ignorez ? (int)(nargin - 1) : (int)nargin, x->Type());
+            hwMatrix* outmtx = EvaluatorInterface::allocateMatrix(static_cast<int>(x->Size()), ignorez ? (int)(nargin - 1) : (int)nargin, x->Type());
 
             if (x->IsReal())
             {
@@ -2010,7 +2131,7 @@ bool oml_rmfield(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         if (!isstr(cell))
             throw OML_Error(HW_ERROR_INPUTSTRINGCELLARRAY);
 
-        for (int i = 0; i < cell->Size(); ++i)
+        for (int64_t i = 0; i < cell->Size(); ++i)
             removeFields(eval, strct, (*cell)(i).Matrix());
     }
     else
@@ -2883,7 +3004,7 @@ bool oml_sort(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
         else
             out = oml_Matrix_sort(eval, cell, dim, &sort<false>, &index_data);
         cell = out.CellArray();
-        for (int i = 0; i < cell->Size(); ++i)
+        for (int64_t i = 0; i < cell->Size(); ++i)
             (*cell)(i).SetMask(Currency::MASK_STRING);
         outputs.push_back(out);
         outputs.push_back(indices.release());
@@ -2951,7 +3072,8 @@ bool oml_isnumeric(EvaluatorInterface eval, const std::vector<Currency>& inputs,
 
     const Currency& in1 = inputs[0];
     outputs.push_back(HW_MAKE_BOOL_CURRENCY(!in1.IsLogical() && (in1.IsScalar() || in1.IsComplex() ||
-                                                                 in1.IsMatrix() || in1.IsNDMatrix())));
+                                                                 in1.IsMatrix() || in1.IsNDMatrix() ||
+                                                                 in1.IsSingle() || in1.IsIntegerType())));
     return true;
 }
 //------------------------------------------------------------------------------
@@ -2961,6 +3083,25 @@ bool oml_all(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 {
     size_t nargin = inputs.size();
 
+    if (nargin == 1 && inputs[0].IsPackedLogical())
+    {
+        const hwMatrixB* flags = inputs[0].MatrixB();
+
+        if (flags->M() == 1 || flags->N() == 1)
+        {
+            int64_t count = LogicalArray::Count(*flags);
+            outputs.push_back((count == flags->Size()));
+        }
+        else
+        {
+            Currency result(LogicalArray::Reduce(*flags, 1, LogicalArray::RED_ALL));
+            result.SetMask(Currency::MASK_LOGICAL);
+            outputs.push_back(result);
+        }
+
+        return true;
+    }
+
     if (nargin == 1 && inputs[0].IsMatrix())
 	{
 		const hwMatrix* matrix = inputs[0].Matrix();
@@ -3006,6 +3147,25 @@ bool oml_any(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 {
     size_t nargin = inputs.size();
 
+    if (nargin == 1 && inputs[0].IsPackedLogical())
+    {
+        const hwMatrixB* flags = inputs[0].MatrixB();
+
+        if (flags->M() == 1 || flags->N() == 1)
+        {
+            int64_t count = LogicalArray::Count(*flags);
+            outputs.push_back((count > 0));
+        }
+        else
+        {
+            Currency result(LogicalArray::Reduce(*flags, 1, LogicalArray::RED_ANY));
+            result.SetMask(Currency::MASK_LOGICAL);
+            outputs.push_back(result);
+        }
+
+        return true;
+    }
+
     if (nargin == 1 && inputs[0].IsMatrix())
 	{
 		const hwMatrix* matrix = inputs[0].Matrix();
@@ -3466,14 +3626,14 @@ bool oml_sub2ind(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
     else if (in1.IsMatrix())
     {
         const hwMatrix *mtx = in1.Matrix();
-        int size = mtx->Size();
+        int64_t size = mtx->Size();
         if (!size)
             throw OML_Error(OML_ERR_POSINTEGER, 1, OML_VAR_DIMS);
 
         if (!mtx->IsRealData())
             throw OML_Error(OML_ERR_POSINTEGER, 1, OML_VAR_DIM);
 
-        for (int i = 0; i < size; ++i)
+        for (int64_t i = 0; i < size; ++i)
         {
             int ii = posIntFromDouble(realval(mtx,i));
             if (!ii)
@@ -3518,7 +3678,7 @@ bool oml_sub2ind(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         else if (input.IsMatrix())
         {
             const hwMatrix *mtx = input.Matrix();
-            int mtxsize = mtx->Size();
+            int64_t mtxsize = mtx->Size();
 
             if (!mtx->IsRealData())
                 throw OML_Error(OML_ERR_POSINTEGER, i+1, OML_VAR_INDEX);
@@ -3531,7 +3691,7 @@ bool oml_sub2ind(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
             else if (!(m == mtx->M() && n == mtx->N()))
                 throw OML_Error(HW_ERROR_INDINPSAMESIZE);
 
-            for (int j = 0; j < mtxsize; ++j)
+            for (int64_t j = 0; j < mtxsize; ++j)
             {
                 int ii = posIntFromDouble(realval(mtx, j));
                 if (!ii)
@@ -3632,6 +3792,10 @@ bool oml_double(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
 		ret.SetMask(Currency::MASK_DOUBLE);
         outputs.push_back(ret);
 	}
+    else if (ret.IsSingle() || ret.IsIntegerType())
+    {
+        outputs.push_back(ret.ToDouble());
+    }
     else
 	{
         throw OML_Error(HW_ERROR_NOTCONVINPTODOUBLE);
@@ -3640,6 +3804,107 @@ bool oml_double(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
     return true;
 }
 //------------------------------------------------------------------------------
+// Converts input to single precision [single]
+//------------------------------------------------------------------------------
+bool oml_single(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    const Currency& in = inputs[0];
+
+    if (in.IsScalar() || in.IsComplex() || in.IsMatrix() || in.IsString() || in.IsSingle() || in.IsIntegerType())
+        outputs.push_back(in.ToSingle());
+    else
+        throw OML_Error(HW_ERROR_NOTCONVINPTOSINGLE);
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Converts input to an integer class, rounding and saturating the values
+//------------------------------------------------------------------------------
+static bool convertToInteger(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, int int_type)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    const Currency& in = inputs[0];
+
+    if (in.IsScalar() || in.IsComplex() || in.IsMatrix() || in.IsString() || in.IsSingle() || in.IsIntegerType())
+        outputs.push_back(in.ToInteger(int_type));
+    else
+        throw OML_Error(HW_ERROR_NOTCONVINPTOINT);
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Converts input to int8 [int8]
+//------------------------------------------------------------------------------
+bool oml_int8(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_INT8);
+}
+//------------------------------------------------------------------------------
+// Converts input to int16 [int16]
+//------------------------------------------------------------------------------
+bool oml_int16(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_INT16);
+}
+//------------------------------------------------------------------------------
+// Converts input to int32 [int32]
+//------------------------------------------------------------------------------
+bool oml_int32(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_INT32);
+}
+//------------------------------------------------------------------------------
+// Converts input to int64 [int64]
+//------------------------------------------------------------------------------
+bool oml_int64(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_INT64);
+}
+//------------------------------------------------------------------------------
+// Converts input to uint8 [uint8]
+//------------------------------------------------------------------------------
+bool oml_uint8(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_UINT8);
+}
+//------------------------------------------------------------------------------
+// Converts input to uint16 [uint16]
+//------------------------------------------------------------------------------
+bool oml_uint16(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_UINT16);
+}
+//------------------------------------------------------------------------------
+// Converts input to uint32 [uint32]
+//------------------------------------------------------------------------------
+bool oml_uint32(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_UINT32);
+}
+//------------------------------------------------------------------------------
+// Converts input to uint64 [uint64]
+//------------------------------------------------------------------------------
+bool oml_uint64(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    return convertToInteger(inputs, outputs, Currency::TYPE_UINT64);
+}
+//------------------------------------------------------------------------------
+// Returns true if input is of an integer class [isinteger]
+//------------------------------------------------------------------------------
+bool oml_isinteger(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    outputs.push_back(HW_MAKE_BOOL_CURRENCY(inputs[0].IsIntegerType()));
+    return true;
+}
+//------------------------------------------------------------------------------
 // Returns true if successul in string matching for regular expressions [regexp]
 //------------------------------------------------------------------------------
 bool oml_regexp(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
@@ -3706,14 +3971,14 @@ bool oml_cell2struct(EvaluatorInterface eval, const std::vector<Currency>& input
     else if (fieldcur.IsCellArray())
     {
         HML_CELLARRAY *fcell = fieldcur.CellArray();
-        int size = fcell->Size();
+        int64_t size = fcell->Size();
         if (size != size_along_dim)
             throw OML_Error(HW_ERROR_FIELDNAMEDIMINPCELL);
 
         if (!isstr(fcell))
             throw OML_Error(HW_ERROR_FIELDNAMECELLSTR);
 
-        for (int i = 0; i < size; i++)
+        for (int64_t i = 0; i < size; i++)
         {
             std::string f = readString((*fcell)(i));
             if (f.empty())
@@ -3819,7 +4084,7 @@ bool oml_cplxpair(EvaluatorInterface eval, const std::vector<Currency>& inputs,
     }
     else
     {
-        for (int i = 0; i < mtx->Size(); i++)
+        for (int64_t i = 0; i < mtx->Size(); i++)
         {
             hwComplex c = mtx->z(i);
             if (c.IsReal(tol))
@@ -3890,7 +4155,7 @@ bool oml_ind2sub(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         if (!mtx->Size())
             throw OML_Error(OML_ERR_POSINTEGER, 1);
 
-        for (int i = 0 ; i < mtx->Size(); i++)
+        for (int64_t i = 0 ; i < mtx->Size(); i++)
         {
             double d = realval(mtx, i);
             if (!isposint(d))
@@ -3928,7 +4193,7 @@ bool oml_ind2sub(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         dim_out.second = mtx->N();
         if (mtx->IsRealData())
         {
-            for (int i = 0; i < mtx->Size(); i++)
+            for (int64_t i = 0; i < mtx->Size(); i++)
             {
                 double d = realval(mtx, i);
                 if (!isposint(d))
@@ -4004,7 +4269,7 @@ bool oml_isprime(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
 
         hwMatrix *out = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
 
-        for (int i = 0; i < mtx->Size(); i++)
+        for (int64_t i = 0; i < mtx->Size(); i++)
         {
             Currency k = (*mtx)(i);
 
@@ -4052,8 +4317,8 @@ bool oml_conv2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
     if (!inputs[1].IsMatrix() && !inputs[1].IsScalar() && !inputs[1].IsComplex())
         throw OML_Error(OML_ERR_MATRIX, 2, OML_VAR_DATA);
 
-    hwMatrix a(*inputs[0].ConvertToMatrix());
-    hwMatrix b(*inputs[1].ConvertToMatrix());
+    const hwMatrix& a = *inputs[0].ConvertToMatrix();
+    const hwMatrix& b = *inputs[1].ConvertToMatrix();
     std::unique_ptr<hwMatrix> mtx;
 
     hwMatrix *result = EvaluatorInterface::allocateMatrix();
@@ -4104,12 +4369,13 @@ bool oml_conv2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
         return true;
     }
 
+    // only the requested part of the convolution is computed
     int top, left, m, n;
 
     if (mtx.get())
     {
-        int bs = b.Size();
-        int as = a.Size();
+        int bs = static_cast<int>(b.Size());
+        int as = static_cast<int>(a.Size());
         int mm = mtx->M();
         int nn = mtx->N();
 
@@ -4119,21 +4385,6 @@ bool oml_conv2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
             return true;
         }
 
-        m = max(as, mm);
-        n = max(bs, nn);
-        if (a.N() != 1)
-            safeResizeMatrix(eval, 1, m, a, true);
-        else
-            safeResizeMatrix(eval, m, 1, a, true);
-
-        if (b.M() != 1)
-            safeResizeMatrix(eval, n, 1, b, true);
-        else
-            safeResizeMatrix(eval, 1, n, b, true);
-
-        safeResizeMatrix(eval, m, n, *mtx, true);
-        BuiltInFuncsUtils::CheckMathStatus(eval, result->Conv2D(a, b, *mtx));
-
         if (shapeCode == Same)
         {
             top = as / 2;
@@ -4143,10 +4394,10 @@ bool oml_conv2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
         }
         else if (shapeCode == Valid)
         {
-            top = m / 2 - 1;
-            left = n / 2 - 1;
-            m = mm - as + 1;
-            n = nn - bs + 1;
+            top = as - 1;
+            left = bs - 1;
+            m = max(mm - as + 1, 0);
+            n = max(nn - bs + 1, 0);
         }
         else
         {
@@ -4154,6 +4405,8 @@ bool oml_conv2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
             m = mm + as - 1;
             n = nn + bs - 1;
         }
+
+        BuiltInFuncsUtils::CheckMathStatus(eval, result->Conv2D(a, b, *mtx, top, left, m, n));
     }
     else
     {
@@ -4161,23 +4414,20 @@ bool oml_conv2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
         int an = a.N();
         int bm = b.M();
         int bn = b.N();
-        m = max(am, bm);
-        n = max(an, bn);
-        safeResizeMatrix(eval, m, n, a, true);
-        safeResizeMatrix(eval, m, n, b, true);
-        BuiltInFuncsUtils::CheckMathStatus(eval, result->Conv2D(a, b));
-
-        top = bm / 2;
-        left = bn / 2;
+
         if (shapeCode == Same)
         {
+            top = bm / 2;
+            left = bn / 2;
             m = am;
             n = an;
         }
         else if (shapeCode == Valid)
         {
-            m = am - bm + 1;
-            n = an - bn + 1;
+            top = bm - 1;
+            left = bn - 1;
+            m = max(am - bm + 1, 0);
+            n = max(an - bn + 1, 0);
         }
         else
         {
@@ -4185,11 +4435,10 @@ bool oml_conv2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
             m = am + bm - 1;
             n = an + bn - 1;
         }
+
+        BuiltInFuncsUtils::CheckMathStatus(eval, result->Conv2D(a, b, top, left, m, n));
     }
 
-    hwMatrix *temp = getInnerMatrix(result, top, top + m, left, left + n);
-    result = temp;
-    rcur = Currency(result);
     outputs.push_back(rcur);
     return true;
 }
@@ -4223,7 +4472,7 @@ static hwTMatrix<T1, T2>* concat(const hwTMatrix<T1, T2> *m1, const hwTMatrix<T1
         for (i = 0; i < m1->Size(); i++)
             (*newmtx)(i) = (*m1)(i);
 
-        for (int j = i; j < newmtx->Size(); j++)
+        for (int64_t j = i; j < newmtx->Size(); j++)
             (*newmtx)(j) = (*m2)(j - i);
 
         return newmtx;
@@ -4236,7 +4485,7 @@ static hwTMatrix<T1, T2>* concat(const hwTMatrix<T1, T2> *m1, const hwTMatrix<T1
     for (i = 0; i < m1->Size(); i++)
         newmtx->z(i) = m1->z(i);
 
-    for (int j = i; j < newmtx->Size(); j++)
+    for (int64_t j = i; j < newmtx->Size(); j++)
         newmtx->z(j) = m2->z(j - i);
 
     return newmtx;
@@ -4294,7 +4543,7 @@ static HML_CELLARRAY* concat(EvaluatorInterface& eval, Currency left, const HML_
 
         (*newcell)(0) = left;
 
-        for (int i = 0; i < cell->Size(); i++)
+        for (int64_t i = 0; i < cell->Size(); i++)
             (*newcell)(i + 1) = (*cell)(i);
 
         return newcell;
@@ -4667,7 +4916,7 @@ bool oml_gcd(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                     usemtx = true;
                 }
 
-                for (int j = 0; j < gcds->Size(); j++)
+                for (int64_t j = 0; j < gcds->Size(); j++)
                 {
                     hwComplex s, t;
                     gcds->z(j) = gcd(gcds->z(j), usemtx ? mtx->IsReal() ? hwComplex((*mtx)(j), 0.0) : mtx->z(j) : c, &s, &t);
@@ -4690,7 +4939,7 @@ bool oml_gcd(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                     usemtx = true;
                     mtx = input.Matrix();
                 }
-                for (int j = 0; j < gcds->Size(); j++)
+                for (int64_t j = 0; j < gcds->Size(); j++)
                 {
                     int s, t;
                     (*gcds)(j) = gcd((int) (*gcds)(j), (int) (usemtx ? (*mtx)(j) : d), &s, &t);
@@ -4916,7 +5165,7 @@ bool oml_cellfun(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
             HML_CELLARRAY* cell;
             cell = EvaluatorInterface::allocateCellArray(cellm, celln);
 
-            for (int j = 0; j < cell->Size(); j++)
+            for (int64_t j = 0; j < cell->Size(); j++)
                 (*cell)(j) = in;
             args.push_back(cell);
         }
@@ -4978,7 +5227,7 @@ bool oml_cellfun(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
                 {
                     HML_CELLARRAY *cell = EvaluatorInterface::allocateCellArray(cellm, celln);
                     // in case nargout is different than in other calls
-                    for (int i = 0; i < cell->Size(); i++)
+                    for (int64_t i = 0; i < cell->Size(); i++)
                         (*cell)(i) = Currency();
                     outputs.push_back(cell);
                 }
@@ -5161,7 +5410,7 @@ bool oml_issorted(EvaluatorInterface eval, const std::vector<Currency>& inputs,
                 if (mtx->IsReal())
                 {
                     double last = (*mtx)(0);
-                    for (int i = 1; i < mtx->Size(); i++)
+                    for (int64_t i = 1; i < mtx->Size(); i++)
                     {
                         double current = (*mtx)(i);
                         if (sortedAscending && last > current)
@@ -5182,7 +5431,7 @@ bool oml_issorted(EvaluatorInterface eval, const std::vector<Currency>& inputs,
                 else // mtx is complex
                 {
                     hwComplex last = mtx->z(0);
-                    for (int i = 1; i < mtx->Size(); i++)
+                    for (int64_t i = 1; i < mtx->Size(); i++)
                     {
                         hwComplex current = mtx->z(i);
                         if (sortedAscending && complexGreaterThan(last, current))
@@ -5233,7 +5482,7 @@ bool oml_issorted(EvaluatorInterface eval, const std::vector<Currency>& inputs,
                     throw OML_Error(HW_ERROR_INPVECSORTROW);
 
                 std::string last = readString((*cell)(0));
-                for (int i = 1; i < cell->Size(); i++)
+                for (int64_t i = 1; i < cell->Size(); i++)
                 {
                     const Currency &currentCur = (*cell)(i);
                     if (!currentCur.IsString())
@@ -5509,7 +5758,7 @@ bool oml_ismember(EvaluatorInterface eval, const std::vector<Currency>& inputs,
         {
             const hwMatrix* in1 = input1.Matrix();
 
-            for (int i=0; i < in1->Size(); i++)
+            for (int64_t i=0; i < in1->Size(); i++)
             {
                 if (in1->IsReal())
                     searchfor.push_back((*in1)(i));
@@ -5521,7 +5770,7 @@ bool oml_ismember(EvaluatorInterface eval, const std::vector<Currency>& inputs,
         {
             const hwMatrixN* in1 = input1.MatrixN();
 
-            for (int i=0; i < in1->Size(); i++)
+            for (int64_t i=0; i < in1->Size(); i++)
             {
                 if (in1->IsReal())
                     searchfor.push_back((*in1)(i));
@@ -5538,7 +5787,7 @@ bool oml_ismember(EvaluatorInterface eval, const std::vector<Currency>& inputs,
         {
             const hwMatrix* in2 = input2.Matrix();
 
-            for (int j=0; j < in2->Size(); j++)
+            for (int64_t j=0; j < in2->Size(); j++)
             {
                 if (in2->IsReal())
                     searchin.push_back((*in2)(j));
@@ -5558,7 +5807,7 @@ bool oml_ismember(EvaluatorInterface eval, const std::vector<Currency>& inputs,
         {
             const hwMatrixN* in2 = input2.MatrixN();
 
-            for (int j=0; j < in2->Size(); j++)
+            for (int64_t j=0; j < in2->Size(); j++)
             {
                 if (in2->IsReal())
                     searchin.push_back((*in2)(j));
@@ -5674,14 +5923,14 @@ bool oml_angle(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 
         if (mtx->IsReal())
         {
-            for (int i = 0; i < out->Size(); i++)
+            for (int64_t i = 0; i < out->Size(); i++)
             {
                 (*out)(i) = hwComplex((*mtx)(i), 0.0).Arg();
             }
         }
         else
         {
-            for (int i = 0; i < out->Size(); i++)
+            for (int64_t i = 0; i < out->Size(); i++)
             {
                 (*out)(i) = mtx->z(i).Arg();
             }
@@ -5726,7 +5975,7 @@ bool oml_isfield(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         HML_CELLARRAY *cell = in2.CellArray();
         hwMatrix *result = EvaluatorInterface::allocateMatrix(cell->M(), cell->N(), hwMatrix::REAL);
 
-        for (int i = 0; i < cell->Size(); i++)
+        for (int64_t i = 0; i < cell->Size(); i++)
         {
             (*result)(i) = isField(eval, fieldNames, (*cell)(i));
         }
@@ -5974,7 +6223,7 @@ bool oml_linspace(EvaluatorInterface eval, const std::vector<Currency>& inputs,
                 throw OML_Error(OML_ERR_ARRAYSIZE, 1, 2, OML_VAR_DIMS);
 
             complex = checkMakeComplex(eval, m1, m2);
-            hwMatrix *result = EvaluatorInterface::allocateMatrix(m1->Size(), numElems, m1->Type());
+            hwMatrix *result = EvaluatorInterface::allocateMatrix(static_cast<int>(m1->Size()), numElems, m1->Type());
             Currency out(result);
             if (complex)
             {
@@ -6017,7 +6266,7 @@ bool oml_linspace(EvaluatorInterface eval, const std::vector<Currency>& inputs,
             s1 = s2;
         }
 
-        hwMatrix *result = EvaluatorInterface::allocateMatrix(m1->Size(), numElems, m1->Type());
+        hwMatrix *result = EvaluatorInterface::allocateMatrix(static_cast<int>(m1->Size()), numElems, m1->Type());
         Currency out(result);
         hwMatrix *row = nullptr;
         Currency temp(row);
@@ -6493,7 +6742,7 @@ static double getDoubleForSprintf(std::vector<Currency>::const_iterator &inputIt
     {
         double           val   = 0.0;
         const hwMatrixN* m     = inputIter->MatrixN();
-        int              msize = m ? m->Size() : 0;      
+        int64_t          msize = m ? m->Size() : 0;      
         if (m && m->IsReal() && *indexInInput < msize)
             val = (*m)((*indexInInput)++);
         
@@ -6525,13 +6774,23 @@ static std::string getWriteStrForSprintf(EvaluatorInterface& eval, std::vector<C
         towrite[0] = BuiltInFuncsUtils::GetValidChar(eval, val, false);
         towrite[1] = 0;
     }
+    else if (inputIter->IsPackedString())
+    {
+        // the bytes are written as is, up to the first null character
+        const hwMatrixC* chars = (*inputIter++).MatrixC();
+        const char*      start = chars->GetRealData() + *indexInInput;
+        const char*      end   = chars->GetRealData() + chars->Size();
+
+        *indexInInput = 0;
+        return std::string(start, std::find(start, end, '\0'));
+    }
     else if (inputIter->IsMatrix() || inputIter->IsString())
     {
         const hwMatrix *m = (*inputIter++).Matrix();
         towrite = new char[m->Size() - *indexInInput + 1];
         if (m->IsReal())
         {
-            for (int i = *indexInInput; i < m->Size(); i++)
+            for (int64_t i = *indexInInput; i < m->Size(); i++)
             {
                 char temp = BuiltInFuncsUtils::GetValidChar(eval, (*m)(i), false);
                 towrite[i - *indexInInput] = temp;
@@ -6541,7 +6800,7 @@ static std::string getWriteStrForSprintf(EvaluatorInterface& eval, std::vector<C
         }
         else
         {
-            for (int i = *indexInInput; i < m->Size(); i++)
+            for (int64_t i = *indexInInput; i < m->Size(); i++)
             {
                 char temp = BuiltInFuncsUtils::GetValidChar(eval, m->z(i).Real(), false);
                 towrite[i - *indexInInput] = temp;
@@ -6644,7 +6903,7 @@ static bool hasElements(const Currency &cur)
     if (cur.IsNDMatrix())
     {
         const hwMatrixN* mtx = cur.MatrixN();
-        int   matsize        = mtx ? mtx->Size() : 0;
+        int64_t matsize        = mtx ? mtx->Size() : 0;
         return (matsize > 0);
     }
     return false;
@@ -7040,7 +7299,7 @@ bool oml_addpath2(EvaluatorInterface eval, const std::vector<Currency>& inputs,
 	else if (func_names.IsCellArray())
 	{
 		HML_CELLARRAY* cells = func_names.CellArray();
-		int size = cells->Size();
+		int64_t size = cells->Size();
 
 		for (int j=0; j<size; j++)
 		{
@@ -7117,12 +7376,12 @@ bool oml_repmat(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
         else if (input2.IsMatrix())
         {
             const hwMatrix* mat = input2.Matrix();
-            int numDim = mat->Size();
+            int64_t numDim = mat->Size();
 
             if (!mat->IsReal())
                 throw OML_Error(OML_ERR_NATURALNUM, 2, OML_VAR_DATA);
 
-            for (int i = 0; i < numDim; ++i)
+            for (int64_t i = 0; i < numDim; ++i)
             {
                 if (!IsInteger((*mat)(i)).IsOk())
                     throw OML_Error(OML_ERR_NATURALNUM, 2, OML_VAR_DATA);
@@ -7197,7 +7456,7 @@ bool oml_repmat(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
             std::vector<int> base_index(dim1.size());
 
             // copy base matrix
-            for (int ii = 0; ii < base.Size(); ++ii)
+            for (int64_t ii = 0; ii < base.Size(); ++ii)
             {
                 if (result->IsReal())
                     (*result)(result_index) = base(ii);
@@ -7313,7 +7572,7 @@ bool oml_repmat(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
         else if (input2.IsMatrix())
         {
             const hwMatrix *dimMtx = input2.Matrix();
-            int size = dimMtx->Size();
+            int64_t size = dimMtx->Size();
             if (dimMtx->IsReal())
             {
                 if (size == 2)
@@ -7480,12 +7739,12 @@ bool oml_deg2rad(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
 
         if (mtx->IsReal())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
                 (*result)(k) = (*mtx)(k) * scale;
         }
         else if (mtx->IsRealData())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
                 (*result)(k) = mtx->z(k).Real() * scale;
         }
         else
@@ -7529,12 +7788,12 @@ bool oml_rad2deg(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
 
         if (mtx->IsReal())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
                 (*result)(k) = (*mtx)(k) * scale;
         }
         else if (mtx->IsRealData())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
                 (*result)(k) = mtx->z(k).Real() * scale;
         }
         else
@@ -8283,30 +8542,10 @@ bool oml_frewind(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
     return true;
 }
 //------------------------------------------------------------------------------
-// Gets precision from string
+// Gets precision from the name of a type
 //------------------------------------------------------------------------------
-static Precision getPrecision(std::string str)
+static Precision getPrecisionType(const std::string& str, int blockSize)
 {
-    // no support yet for conversion types
-    int blockSize = 1;
-    size_t index = str.find('*');
-    if (index != std::string::npos)
-    {
-        std::string left = str.substr(0, index);
-        const char* cleft = left.c_str();
-        char* end;
-        double temp = strtod(cleft, &end);
-        if (end && end > cleft)
-        {
-            if (!isint(temp) || temp < 1.0)
-                throw OML_Error(HW_ERROR_PRECBLOCKPOSINT);
-
-            blockSize = (int) temp;
-            str.erase(0, index + 1);
-        }
-    }
-    str = convertToLower(str);
-
     if (str == "float")
         return Precision(true, sizeof(float), blockSize, Float);
     else if (str == "ulong" || str == "unsigned long")
@@ -8351,6 +8590,80 @@ static Precision getPrecision(std::string str)
 //------------------------------------------------------------------------------
 // Gets precision from string
 //------------------------------------------------------------------------------
+static Precision getPrecision(std::string str)
+{
+    // conversion types are supported for double, single and integer outputs
+    int blockSize = 1;
+    size_t index = str.find('*');
+    if (index != std::string::npos)
+    {
+        std::string left = str.substr(0, index);
+        const char* cleft = left.c_str();
+        char* end;
+        double temp = strtod(cleft, &end);
+        if (end && end > cleft)
+        {
+            if (!isint(temp) || temp < 1.0)
+                throw OML_Error(HW_ERROR_PRECBLOCKPOSINT);
+
+            blockSize = (int) temp;
+            str.erase(0, index + 1);
+        }
+    }
+    str = convertToLower(str);
+
+    // '*type' keeps the input class and 'type=>class' converts to class
+    bool keepClass = false;
+    int  outType   = Currency::TYPE_MATRIX;
+
+    if (!str.empty() && str[0] == '*')
+    {
+        keepClass = true;
+        str.erase(0, 1);
+    }
+    else
+    {
+        index = str.find("=>");
+        if (index != std::string::npos)
+        {
+            std::string outClass = str.substr(index + 2);
+            if (outClass == "single" || outClass == "float" || outClass == "float32" || outClass == "real*4")
+                outType = Currency::TYPE_SINGLE;
+            else if (getIntegerType(outClass) >= 0)
+                outType = getIntegerType(outClass);
+            else if (outClass != "double" && outClass != "float64" && outClass != "real*8")
+                throw OML_Error(HW_ERROR_INVPRECTYPE);
+
+            str.erase(index);
+        }
+    }
+
+    Precision p (getPrecisionType(str, blockSize));
+
+    if (keepClass && p.dtype == Float)
+    {
+        p.outType = Currency::TYPE_SINGLE;
+    }
+    else if (keepClass && p.dtype != Double && p.dtype != Char)
+    {
+        // integer types keep the class with the same sign and width
+        static const Currency::CurrencyType signedTypes[]   = { Currency::TYPE_INT8,  Currency::TYPE_INT16,
+                                                                Currency::TYPE_INT32, Currency::TYPE_INT64 };
+        static const Currency::CurrencyType unsignedTypes[] = { Currency::TYPE_UINT8,  Currency::TYPE_UINT16,
+                                                                Currency::TYPE_UINT32, Currency::TYPE_UINT64 };
+        int width = (p.numBytes == 1) ? 0 : (p.numBytes == 2) ? 1 : (p.numBytes == 4) ? 2 : 3;
+        p.outType = p.sign ? signedTypes[width] : unsignedTypes[width];
+    }
+    else if (!keepClass)
+    {
+        p.outType = outType;
+    }
+
+    return p;
+}
+//------------------------------------------------------------------------------
+// Gets precision from string
+//------------------------------------------------------------------------------
 static Precision getPrecision(EvaluatorInterface& eval, Currency input)
 {
     return getPrecision(readOption(eval, unnest(input, HW_ERROR_INVPRECTYPE)));
@@ -8379,15 +8692,59 @@ static void checkBounds(T *writeTo, double value)
     }
 }
 //------------------------------------------------------------------------------
+// Converts a value to type U, saturating if U is an integer type
+//------------------------------------------------------------------------------
+template <typename U, typename T>
+static U saturateValue(T value)
+{
+    if (!std::numeric_limits<U>::is_integer)
+        return static_cast<U>(value);
+    if (!std::numeric_limits<T>::is_integer)
+        return SaturateCast<U>(static_cast<double>(value));
+
+    const U lo = (std::numeric_limits<U>::min)();
+    const U hi = (std::numeric_limits<U>::max)();
+
+    // integer to integer conversions are exact, including 64 bit values
+    if (value < 0)
+    {
+        if (!std::numeric_limits<U>::is_signed)
+            return 0;
+        return (static_cast<int64_t>(value) < static_cast<int64_t>(lo)) ? lo : static_cast<U>(value);
+    }
+
+    return (static_cast<uint64_t>(value) > static_cast<uint64_t>(hi)) ? hi : static_cast<U>(value);
+}
+//------------------------------------------------------------------------------
+// Copies an integer matrix into a write buffer
+//------------------------------------------------------------------------------
+template <typename T>
+struct IntegerToWrite
+{
+    IntegerToWrite(const Currency& in, T* buffer) : input(in), towrite(buffer) {}
+
+    template <typename U>
+    void Apply()
+    {
+        const hwTMatrix<U, hwTComplex<U> >* m = input.MatrixInt<U>();
+
+        for (int64_t i = 0; i < m->Size(); i++)
+            towrite[i] = saturateValue<T>((*m)(i));
+    }
+
+    const Currency& input;
+    T*              towrite;
+};
+//------------------------------------------------------------------------------
 // 
 //------------------------------------------------------------------------------
 template<typename T>
-static int doWrite(EvaluatorInterface &eval, const std::vector<Currency> &inputs, int blockSize, size_t dataSize)
+static int64_t doWrite(EvaluatorInterface &eval, const std::vector<Currency> &inputs, int blockSize, size_t dataSize)
 {
     T *towrite;
     size_t nargin = inputs.size();
     int skip = 0;
-    int numItems;
+    int64_t numItems;
     int fileID = getFileFromInput(eval, inputs[0]);
     checkFileIndex(eval, fileID, true);
     std::FILE* file = eval.GetFile(fileID);
@@ -8431,14 +8788,14 @@ static int doWrite(EvaluatorInterface &eval, const std::vector<Currency> &inputs
             towrite = new T[numItems];
             if (m->IsReal())
             {
-                for (int i = 0; i < numItems; i++)
+                for (int64_t i = 0; i < numItems; i++)
                 {
                     checkBounds(towrite + i, (*m)(i));
                 }
             }
             else
             {
-                for (int i = 0; i < m->Size(); i++)
+                for (int64_t i = 0; i < m->Size(); i++)
                 {
                     checkBounds(towrite + i, m->z(i).Real());
                 }
@@ -8449,40 +8806,73 @@ static int doWrite(EvaluatorInterface &eval, const std::vector<Currency> &inputs
             return 0;
         }
     }
-    else if (input2.IsString())
+    else if (input2.IsSingle())
     {
-        std::string str = orderedStringVal(input2);
-        numItems = (int)str.length();
-        towrite = new T[numItems];
-        for (int i = 0; i < numItems; i++)
+        const hwMatrixF *m = input2.MatrixF();
+        numItems = m->Size();
+        if (numItems)
         {
-            checkBounds(towrite + i, str[i]);
+            towrite = new T[numItems];
+            for (int64_t i = 0; i < numItems; i++)
+            {
+                checkBounds(towrite + i, m->IsReal() ? (*m)(i) : m->z(i).Real());
+            }
+        }
+        else
+        {
+            return 0;
         }
     }
-    else
+    else if (input2.IsIntegerType())
     {
-        if (ftype != Other)
-            fclose(file);
-
-        throw OML_Error(HW_ERROR_INPUTSCALARCOMPLEXMTXSTRING);
-    }
+        int m, n;
+        input2.IntegerDims(m, n);
+        numItems = static_cast<int64_t>(m) * n;
+        if (numItems)
+        {
+            towrite = new T[numItems];
+            IntegerToWrite<T> functor(input2, towrite);
+            DispatchInteger(input2.GetType(), functor);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (input2.IsString())
+    {
+        std::string str = orderedStringVal(input2);
+        numItems = (int)str.length();
+        towrite = new T[numItems];
+        for (int64_t i = 0; i < numItems; i++)
+        {
+            checkBounds(towrite + i, str[i]);
+        }
+    }
+    else
+    {
+        if (ftype != Other)
+            fclose(file);
+
+        throw OML_Error(HW_ERROR_INPUTSCALARCOMPLEXMTXSTRING);
+    }
 
-    int numWritten = 0;
+    int64_t numWritten = 0;
 
     if (skip)
     {
-        int numLoops = (int)ceil(numItems / (double) blockSize);
-        for (int i = 0; i < numLoops; i++)
+        int64_t numLoops = (int64_t)ceil(numItems / (double) blockSize);
+        for (int64_t i = 0; i < numLoops; i++)
         {
             fseek(file, skip, SEEK_CUR);
             // don't write extra
-            numWritten += (int)fwrite(towrite + i * blockSize, dataSize,
+            numWritten += (int64_t)fwrite(towrite + i * blockSize, dataSize,
                 i == numLoops - 1 ? ((numItems - 1) % blockSize) + 1 : blockSize, file);
         }
     }
     else
     {
-        numWritten = (int)fwrite(towrite, dataSize, numItems, file);
+        numWritten = (int64_t)fwrite(towrite, dataSize, numItems, file);
     }
 
     delete [] towrite;
@@ -8530,7 +8920,7 @@ bool oml_fwrite(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
         dataSize = p.numBytes;
     }
 
-    int numWritten;
+    int64_t numWritten;
 
     if (signedInput)
     {
@@ -8608,7 +8998,7 @@ bool oml_fwrite(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
             throw OML_Error(HW_MATH_MSG_INTERNALERROR);
         }
     }
-    outputs.push_back(numWritten);
+    outputs.push_back(static_cast<double>(numWritten));
     return true;
 }
 //------------------------------------------------------------------------------
@@ -8628,6 +9018,94 @@ bool oml_nan(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 //------------------------------------------------------------------------------
 // 
 //------------------------------------------------------------------------------
+static void getContainerDims(int containerSize, int& nrows, int& ncols)
+{
+    // sized as in containerToMatrix
+    if (nrows < 0 && ncols < 0)
+    {
+        nrows = containerSize;
+        ncols = 1;
+    }
+    else if (nrows < 0)
+    {
+        nrows = (int)(ceil(containerSize / (double) ncols));
+    }
+    else if (ncols < 0)
+    {
+        ncols = (int)(ceil(containerSize / (double) nrows));
+    }
+}
+//------------------------------------------------------------------------------
+// 
+//------------------------------------------------------------------------------
+template<typename T>
+static hwMatrixF* containerToSingleMatrix(const T& container, int nrows, int ncols)
+{
+    int containerSize = static_cast<int>(container.size());
+
+    getContainerDims(containerSize, nrows, ncols);
+
+    hwMatrixF* ret = new hwMatrixF(nrows, ncols, hwMatrixF::REAL);
+    int64_t matrixSize = ret->Size();
+    int i = 0;
+
+    for (; i < matrixSize && i < containerSize; i++)
+        (*ret)(i) = static_cast<float>(container[i]);
+
+    while (i < matrixSize)
+        (*ret)(i++) = 0.0f;
+
+    return ret;
+}
+//------------------------------------------------------------------------------
+// Creates an integer matrix from the values in a container
+//------------------------------------------------------------------------------
+template<typename T>
+struct ContainerToInteger
+{
+    ContainerToInteger(const T& values, int m, int n) : container(values), nrows(m), ncols(n) {}
+
+    template <typename U>
+    void Apply()
+    {
+        int containerSize = static_cast<int>(container.size());
+
+        getContainerDims(containerSize, nrows, ncols);
+
+        hwTMatrix<U, hwTComplex<U> >* ret = new hwTMatrix<U, hwTComplex<U> >(nrows, ncols, hwTMatrix<U, hwTComplex<U> >::REAL);
+        result = ret;
+
+        int64_t matrixSize = ret->Size();
+        U*  dst        = ret->GetRealData();
+        int i          = 0;
+
+        for (; i < matrixSize && i < containerSize; i++)
+            dst[i] = saturateValue<U>(container[i]);
+
+        while (i < matrixSize)
+            dst[i++] = 0;
+    }
+
+    const T& container;
+    int      nrows;
+    int      ncols;
+    Currency result;
+};
+//------------------------------------------------------------------------------
+// Creates an empty output of the given type for fread
+//------------------------------------------------------------------------------
+static Currency emptyReadOutput(int outType)
+{
+    if (outType == Currency::TYPE_SINGLE)
+        return new hwMatrixF;
+
+    Currency empty (EvaluatorInterface::allocateMatrix());
+
+    return (outType == Currency::TYPE_MATRIX) ? empty : empty.ToInteger(outType);
+}
+//------------------------------------------------------------------------------
+// 
+//------------------------------------------------------------------------------
 template<typename T>
 static void doRead(int maxLoops, 
                    size_t size, 
@@ -8636,11 +9114,12 @@ static void doRead(int maxLoops,
                    std::FILE* file, 
                    int nrows, 
                    int ncols, 
-                   std::vector<Currency>& outputs)
+                   std::vector<Currency>& outputs,
+                   int outType)
 {
     if (!(nrows && ncols && blockSize))
     {
-        outputs.push_back(EvaluatorInterface::allocateMatrix());
+        outputs.push_back(emptyReadOutput(outType));
         outputs.push_back(0);
         return;
     }
@@ -8678,7 +9157,7 @@ static void doRead(int maxLoops,
 
     if (ferror(file))
     {
-        outputs.push_back(EvaluatorInterface::allocateMatrix());
+        outputs.push_back(emptyReadOutput(outType));
         outputs.push_back(-1);
         return;
     }
@@ -8687,7 +9166,20 @@ static void doRead(int maxLoops,
     if (nrows > -1)
       ncols = (int)min((double) ncols, ceil((double)(nums.size() / (double) nrows)));
 
-    outputs.push_back(containerToMatrix(nums, nrows, ncols));
+    if (outType == Currency::TYPE_SINGLE)
+    {
+        outputs.push_back(containerToSingleMatrix(nums, nrows, ncols));
+    }
+    else if (outType != Currency::TYPE_MATRIX)
+    {
+        ContainerToInteger<std::vector<T> > functor(nums, nrows, ncols);
+        DispatchInteger(outType, functor);
+        outputs.push_back(functor.result);
+    }
+    else
+    {
+        outputs.push_back(containerToMatrix(nums, nrows, ncols));
+    }
     outputs.push_back(static_cast<int>(count));
 }
 //------------------------------------------------------------------------------
@@ -8707,6 +9199,7 @@ bool oml_fread(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
     int ncols = -1;
     int blockSize = 1;
     bool signedOutput = false;
+    int outType = Currency::TYPE_MATRIX;
     DataType dtype = Char;
     size_t size = sizeof(unsigned char);
 
@@ -8722,6 +9215,7 @@ bool oml_fread(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
             blockSize = p.blockSize;
             size = p.numBytes;
             dtype = p.dtype;
+            outType = p.outType;
         }
         else
         {
@@ -8773,6 +9267,7 @@ bool oml_fread(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
             blockSize = p.blockSize;
             size = p.numBytes;
             dtype = p.dtype;
+            outType = p.outType;
 
             if (nargin > 3)
             {
@@ -8802,38 +9297,38 @@ bool oml_fread(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
         switch (dtype)
         {
         case Double: 
-            doRead<double>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<double>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Int:
-            doRead<signed int>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<signed int>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Short:
-            doRead<signed short>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<signed short>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Long:
-            doRead<signed long>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<signed long>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Char:
-            doRead<signed char>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<signed char>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Float:
-            doRead<float>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<float>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case LongLong:
             doRead<signed long long>(maxLoops, size, blockSize, skip, file, nrows,
-                ncols, outputs);
+                ncols, outputs, outType);
             break;
         case Int8:
-            doRead<int8_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<int8_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Int16:
-            doRead<int16_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<int16_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Int32:
-            doRead<int32_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<int32_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Int64:
-            doRead<int64_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<int64_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         default: throw OML_Error(HW_MATH_MSG_INTERNALERROR); break;
         }
@@ -8844,35 +9339,35 @@ bool oml_fread(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
         {
         case Int:
             doRead<unsigned int>(maxLoops, size, blockSize, skip, file, nrows,
-                ncols, outputs);
+                ncols, outputs, outType);
             break;
         case Short:
             doRead<unsigned short>(maxLoops, size, blockSize, skip, file, nrows,
-                ncols, outputs);
+                ncols, outputs, outType);
             break;
         case Long:
             doRead<unsigned long>(maxLoops, size, blockSize, skip, file, nrows,
-                ncols, outputs);
+                ncols, outputs, outType);
             break;
         case Char:
             doRead<unsigned char>(maxLoops, size, blockSize, skip, file, nrows,
-                ncols, outputs);
+                ncols, outputs, outType);
             break;
         case LongLong:
             doRead<unsigned long long>(maxLoops, size, blockSize, skip, file, nrows,
-                ncols, outputs);
+                ncols, outputs, outType);
             break;
         case Int8:
-            doRead<uint8_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<uint8_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Int16:
-            doRead<uint16_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<uint16_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Int32:
-            doRead<uint32_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<uint32_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         case Int64:
-            doRead<uint64_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs);
+            doRead<uint64_t>(maxLoops, size, blockSize, skip, file, nrows, ncols, outputs, outType);
             break;
         default:
             throw OML_Error(HW_MATH_MSG_INTERNALERROR); break;
@@ -9328,7 +9823,7 @@ bool oml_strsplit(EvaluatorInterface eval, const std::vector<Currency>& inputs,
                     throw OML_Error(OML_ERR_FLAG_01, 3, OML_VAR_VALUE);
             }
             HML_CELLARRAY *cell = input2.CellArray();
-            for (int i = 0; i < cell->Size(); i++)
+            for (int64_t i = 0; i < cell->Size(); i++)
             {
                 Currency c = (*cell)(i);
                 if (c.IsString())
@@ -9471,7 +9966,7 @@ bool oml_strjoin(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
     if (input1.IsCellArray())
     {
         HML_CELLARRAY *cell = input1.CellArray();
-        int cellsize = cell->Size();
+        int cellsize = static_cast<int>(cell->Size());
         if (!isstr(cell))
             throw OML_Error(HW_ERROR_INPUTSTRINGCELLARRAY);
 
@@ -9800,7 +10295,7 @@ bool oml_strfind(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         if (!isstr(cell))
             throw OML_Error(HW_ERROR_CELLELEMSTR);
 
-        for (int i = 0; i < cell->Size(); i++)
+        for (int64_t i = 0; i < cell->Size(); i++)
             tosearch.push_back(orderedStringVal((*cell)(i)));
 
         delete cellidxs;
@@ -9826,7 +10321,7 @@ bool oml_strfind(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         if (!isstr(cell))
             throw OML_Error(HW_ERROR_CELLELEMSTR);
 
-        for (int i = 0; i < cell->Size(); i++)
+        for (int64_t i = 0; i < cell->Size(); i++)
             patterns.push_back(orderedStringVal((*cell)(i)));
     }
 
@@ -10256,7 +10751,7 @@ bool oml_polyval(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
     else
         complex = checkMakeComplex(eval, m1, &m2);
 
-    int numCoefs = m1->Size();
+    int64_t numCoefs = m1->Size();
 
     if (input1.IsMatrix() && !m1->IsVector())
         throw OML_Error(OML_ERR_VECTOR, 1, OML_VAR_DATA);
@@ -10270,7 +10765,7 @@ bool oml_polyval(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         {
             hwComplex c1 = mu->z(0);
             hwComplex c2 = mu->z(1);
-            for (int i = 0; i < m2.Size(); i++)
+            for (int64_t i = 0; i < m2.Size(); i++)
             {
                 hwComplex &xval = m2.z(i);
                 xval = (xval - c1) / c2;
@@ -10280,7 +10775,7 @@ bool oml_polyval(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         {
             double d1 = (*mu)(0);
             double d2 = (*mu)(1);
-            for (int i = 0; i < m2.Size(); i++)
+            for (int64_t i = 0; i < m2.Size(); i++)
             {
                 double &xval = m2(i);
                 xval = (xval - d1) / d2;
@@ -10292,7 +10787,7 @@ bool oml_polyval(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
     if (complex)
     {
         hwComplex xx, yy;
-        for (int i = 0; i < m2.Size(); i++)
+        for (int64_t i = 0; i < m2.Size(); i++)
         {
             xx = m2.z(i);
             int j = 0;
@@ -10308,7 +10803,7 @@ bool oml_polyval(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
     else
     {
         double xx, yy;
-        for (int i = 0; i < m2.Size(); i++)
+        for (int64_t i = 0; i < m2.Size(); i++)
         {
             xx = m2(i);
             int j = 0;
@@ -10502,7 +10997,7 @@ bool oml_poly(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
         {
             // convert to real
             hwMatrix *temp = EvaluatorInterface::allocateMatrix(e->M(), e->N(), hwMatrix::REAL);
-            for (int i = 0; i < e->Size(); i++)
+            for (int64_t i = 0; i < e->Size(); i++)
             {
                 (*temp)(i) = e->z(i).Real();
             }
@@ -10521,7 +11016,7 @@ bool oml_poly(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
     if (e->IsReal())
     {
         std::vector<double> nonzeros;
-        for (int i = 0; i < idx->Size(); i++)
+        for (int64_t i = 0; i < idx->Size(); i++)
         {
             if (!iszero((*idx)(i)))
                 nonzeros.push_back((*e)(i));
@@ -10537,7 +11032,7 @@ bool oml_poly(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
     else
     {
         std::vector<hwComplex> nonzeros;
-        for (int i = 0; i < idx->Size(); i++)
+        for (int64_t i = 0; i < idx->Size(); i++)
         {
             if (!iszero((*idx)(i)))
                 nonzeros.push_back(e->z(i));
@@ -10605,7 +11100,7 @@ bool oml_poly(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
         std::deque<hwComplex> posimag;
         std::deque<hwComplex> negimag;
 
-        for (int i = 0; i < e->Size(); i++)
+        for (int64_t i = 0; i < e->Size(); i++)
         {
             hwComplex c = e->z(i);
             hwComplex c2 = c.Conjugate();
@@ -10631,7 +11126,7 @@ bool oml_poly(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
             if (!p->IsReal() && i == posimag.size())
             {
                 hwMatrix *newp = EvaluatorInterface::allocateMatrix(p->M(), p->N(), hwMatrix::REAL);
-                for (int j = 0; j < newp->Size(); j++)
+                for (int64_t j = 0; j < newp->Size(); j++)
                 {
                     (*newp)(j) = p->z(j).Real();
                 }
@@ -10669,14 +11164,14 @@ bool oml_fix(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
         hwMatrix *result = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), mtx->Type());
         if (mtx->IsReal())
         {
-            for (int i = 0; i < result->Size(); i++)
+            for (int64_t i = 0; i < result->Size(); i++)
             {
                 (*result)(i) = (int) (*mtx)(i);
             }
         }
         else
         {
-            for (int i = 0; i < result->Size(); i++)
+            for (int64_t i = 0; i < result->Size(); i++)
             {
                 hwComplex cplx = mtx->z(i);
                 cplx.Set((int) cplx.Real(), (int) cplx.Imag());
@@ -10720,7 +11215,7 @@ bool oml_rem(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
         {
             const hwMatrix *mtx = input2.Matrix();
             hwMatrix *result = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
-            for (int i = 0; i < result->Size(); i++)
+            for (int64_t i = 0; i < result->Size(); i++)
             {
                 (*result)(i) = doubleMod(val1, (*mtx)(i));
             }
@@ -10744,7 +11239,7 @@ bool oml_rem(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             {
                 double val = input2.Scalar();
                 hwMatrix *result = EvaluatorInterface::allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
-                for (int i = 0; i < result->Size(); i++)
+                for (int64_t i = 0; i < result->Size(); i++)
                 {
                     (*result)(i) = doubleMod(realval(m1, i), val);
                 }
@@ -10760,7 +11255,7 @@ bool oml_rem(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                         throw OML_Error(OML_ERR_ARRAYSIZE, 1, 2, OML_VAR_DIMS);
 
                     hwMatrix *result = EvaluatorInterface::allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
-                    for (int i = 0; i < result->Size(); i++)
+                    for (int64_t i = 0; i < result->Size(); i++)
                     {
                         (*result)(i) = doubleMod(realval(m1, i), realval(m2, i));
                     }
@@ -10870,6 +11365,25 @@ bool oml_reshape(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
             BuiltInFuncsUtils::CheckMathStatus(eval, strct->Reshape(m, n));
             outputs.push_back(strct.release());
         }
+        else if (input1.IsNDMatrix() && input1.MatrixN()->Size() >= Currency::MIN_VIEW_SIZE &&
+                 input1.MatrixN()->Size() <= std::numeric_limits<int>::max())
+        {
+            // the result shares the data, which is copied when either is
+            // written
+            const hwMatrixN* mtxN   = input1.MatrixN();
+            hwMatrix*        view   = Currency::CreateView(mtxN, static_cast<int>(mtxN->Size()), 1);
+            Currency         out(view);
+            hwMathStatus     status = view->Reshape(m, n);
+
+            if (!status.IsOk())
+            {
+                status.ResetArgs();
+            }
+
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+            out.SetMask(input1.GetMask());
+            outputs.push_back(out);
+        }
         else if (input1.IsNDMatrix())
         {
             std::unique_ptr<hwMatrixN> mtxN(EvaluatorInterface::allocateMatrixN(input1.MatrixN()));
@@ -10893,6 +11407,23 @@ bool oml_reshape(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
             out.SetMask(input1.GetMask());
             outputs.push_back(out);
         }
+        else if (input1.GetType() == Currency::TYPE_MATRIX && input1.Matrix() &&
+                 input1.Matrix()->Size() >= Currency::MIN_VIEW_SIZE)
+        {
+            const hwMatrix* src    = input1.Matrix();
+            hwMatrix*       view   = Currency::CreateView(src, 0, src->M(), src->N());
+            Currency        out(view);
+            hwMathStatus    status = view->Reshape(m, n);
+
+            if (!status.IsOk())
+            {
+                status.ResetArgs();
+            }
+
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+            out.SetMask(input1.GetMask());
+            outputs.push_back(out);
+        }
         else    // hwMatrix, including string
         {
             std::unique_ptr<hwMatrix> mtx(EvaluatorInterface::allocateMatrix(input1.ConvertToMatrix()));
@@ -10917,7 +11448,7 @@ bool oml_reshape(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         {
             const hwMatrix* indx = input2.Matrix();
 
-            for (int i = 0; i < indx->Size(); ++i)
+            for (int64_t i = 0; i < indx->Size(); ++i)
             {
                 if (IsInteger((*indx)(i)).IsOk())
                     dims.push_back(static_cast<int>((*indx)(i)));
@@ -11007,7 +11538,7 @@ bool oml_permute(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
 
     std::vector<int> permvec(pvec->Size());
 
-    for (int i = 0; i < pvec->Size(); ++i)
+    for (int64_t i = 0; i < pvec->Size(); ++i)
     {
         double dim = realval(pvec, i);
 
@@ -11069,11 +11600,22 @@ bool oml_permute(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
 
         if (input1.IsMatrix())
         {
-            hwMatrixN temp;
-
-            temp.Convert2DtoND(*input1.ConvertToMatrix());
+            // view the 2D data as ND instead of copying it
+            const hwMatrix* matrix = input1.ConvertToMatrix();
+            std::vector<int> dims(2);
+            dims[0] = matrix->M();
+            dims[1] = matrix->N();
 
-            result->Permute(temp, permvec);
+            if (matrix->IsReal())
+            {
+                hwMatrixN view(dims, const_cast<double*>(matrix->GetRealData()), hwMatrixN::REAL);
+                result->Permute(view, permvec);
+            }
+            else
+            {
+                hwMatrixN view(dims, const_cast<hwComplex*>(matrix->GetComplexData()), hwMatrixN::COMPLEX);
+                result->Permute(view, permvec);
+            }
         }
         else if (input1.IsNDMatrix())
         {
@@ -11121,6 +11663,15 @@ bool oml_squeeze(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
         {
             outputs.push_back(input1);
         }
+        else if (newDims.size() <= 2 && mtxN->Size() >= Currency::MIN_VIEW_SIZE)
+        {
+            // a 2D result shares the data, which is copied when either is
+            // written
+            int m = newDims[0];
+            int n = (newDims.size() == 2) ? newDims[1] : 1;
+
+            outputs.push_back(Currency::CreateView(mtxN, m, n));
+        }
         else
         {
             if (newDims.size() == 1)
@@ -11147,12 +11698,12 @@ static double normForVector(const hwMatrix* vec, double p)
     double sum = 0.0;
     if (vec->IsReal())
     {
-        for (int i = 0; i < vec->Size(); ++i)
+        for (int64_t i = 0; i < vec->Size(); ++i)
             sum += pow(abs((*vec)(i)), p); 
     }
     else
     {
-        for (int i = 0; i < vec->Size(); ++i)
+        for (int64_t i = 0; i < vec->Size(); ++i)
             sum += pow(vec->z(i).Mag(), p); 
     }
     return pow(sum, 1/p);
@@ -11267,12 +11818,12 @@ bool oml_norm(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                     {
                         if ((int) p == 0)
                         {
-                            int size = mtx->Size();
+                            int64_t size = mtx->Size();
                             int count = 0;
 
                             if (mtx->IsReal())
                             {
-                                for (int i = 0; i < size; ++i)
+                                for (int64_t i = 0; i < size; ++i)
                                 {
                                     if ((*mtx)(i) != 0.0)
                                         ++count;
@@ -11280,7 +11831,7 @@ bool oml_norm(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                             }
                             else
                             {
-                                for (int i = 0; i < size; ++i)
+                                for (int64_t i = 0; i < size; ++i)
                                 {
                                     if (mtx->z(i) != 0.0)
                                         ++count;
@@ -11330,12 +11881,12 @@ bool oml_norm(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                     {
                         if ((int) p == 0)
                         {
-                            int size = row.get()->Size();
+                            int64_t size = row.get()->Size();
                             int count = 0;
 
                             if (mtx->IsReal())
                             {
-                                for (int i = 0; i < size; ++i)
+                                for (int64_t i = 0; i < size; ++i)
                                 {
                                     if ((*row.get())(i) != 0.0)
                                         ++count;
@@ -11343,7 +11894,7 @@ bool oml_norm(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                             }
                             else
                             {
-                                for (int i = 0; i < size; ++i)
+                                for (int64_t i = 0; i < size; ++i)
                                 {
                                     if (row.get()->z(i) != 0.0)
                                         ++count;
@@ -11383,12 +11934,12 @@ bool oml_norm(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                     {
                         if ((int) p == 0)
                         {
-                            int size = col.get()->Size();
+                            int64_t size = col.get()->Size();
                             int count = 0;
 
                             if (mtx->IsReal())
                             {
-                                for (int i = 0; i < size; ++i)
+                                for (int64_t i = 0; i < size; ++i)
                                 {
                                     if ((*col.get())(i) != 0.0)
                                         ++count;
@@ -11396,7 +11947,7 @@ bool oml_norm(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                             }
                             else
                             {
-                                for (int i = 0; i < size; ++i)
+                                for (int64_t i = 0; i < size; ++i)
                                 {
                                     if (col.get()->z(i) != 0.0)
                                         ++count;
@@ -11450,8 +12001,13 @@ bool oml_find(EvaluatorInterface           eval,
 
     const Currency &input1 = inputs[0];
     const hwMatrix* findin = 0;   
+    const hwMatrixB* flags = 0;   // packed logical input, searched without unpacking
+
+    int nargout = getNumOutputs(eval);
 
-    if (input1.IsMatrix() || input1.IsScalar() || input1.IsComplex() || input1.IsString())
+    if (input1.IsPackedLogical() && nargout <= 1)
+        flags = input1.MatrixB();
+    else if (input1.IsMatrix() || input1.IsScalar() || input1.IsComplex() || input1.IsString())
         findin = input1.ConvertToMatrix();
     else if (input1.IsNDMatrix())
     {
@@ -11477,7 +12033,6 @@ bool oml_find(EvaluatorInterface           eval,
     else
         throw OML_Error(OML_ERR_SCALARCOMPLEXMTX);
 
-    int nargout = getNumOutputs(eval);
     int incr = 1;
     double stopAt = 0;
 
@@ -11502,11 +12057,16 @@ bool oml_find(EvaluatorInterface           eval,
         }
     }
 
-    std::vector<int> ivec; // Vector of indices
+    std::vector<int64_t> ivec; // Vector of indices
 
-    if (findin->IsReal())
+    if (flags)
+    {
+        int limit = (size > 1) ? static_cast<int>(std::min(stopAt, static_cast<double>(flags->Size()))) : -1;
+        LogicalArray::Find(*flags, limit, incr == -1, ivec);
+    }
+    else if (findin->IsReal())
     {
-        for (int i = (incr == 1 ? 0 : findin->Size() - 1); incr == 1 ? i < findin->Size() : i >= 0;
+        for (int64_t i = (incr == 1 ? 0 : findin->Size() - 1); incr == 1 ? i < findin->Size() : i >= 0;
             i += incr)
         {
             if ((*findin)(i) != 0.0)
@@ -11519,7 +12079,7 @@ bool oml_find(EvaluatorInterface           eval,
     }
     else
     {
-        for (int i = (incr == 1 ? 0 : findin->Size() - 1); incr == 1 ? i < findin->Size() : i >= 0;
+        for (int64_t i = (incr == 1 ? 0 : findin->Size() - 1); incr == 1 ? i < findin->Size() : i >= 0;
             i += incr)
         {
             if (findin->z(i) != hwComplex(0.0, 0.0))
@@ -11535,7 +12095,7 @@ bool oml_find(EvaluatorInterface           eval,
     {
 		int output_rows = 1;
 
-		if ((findin->M() == 0) && (findin->N() == 0))
+		if (findin && (findin->M() == 0) && (findin->N() == 0))
 			output_rows = 0;
 
 		if (nargout)
@@ -11552,18 +12112,20 @@ bool oml_find(EvaluatorInterface           eval,
     }
 
     size_t vecsize = ivec.size();
+    if (vecsize > static_cast<size_t>(std::numeric_limits<int>::max()))
+        throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
 
     if (nargout == 1 || !nargout)
     {
         hwMatrix *indices;
-        if (findin->M() == 1)
+        if ((flags ? flags->M() : findin->M()) == 1)
             indices = EvaluatorInterface::allocateMatrix(1, (int)vecsize, hwMatrix::REAL);
         else
             indices = EvaluatorInterface::allocateMatrix((int)vecsize, 1, hwMatrix::REAL);
 
         for (int i = 0; i < vecsize; i++)
         {
-            int idx = ivec[incr == 1 ? i : vecsize-i-1];
+            int64_t idx = ivec[incr == 1 ? i : vecsize-i-1];
             (*indices)(i) = static_cast<double>(idx + 1);
         }
         outputs.push_back(indices);
@@ -11589,7 +12151,7 @@ bool oml_find(EvaluatorInterface           eval,
         {
             for (int i = 0; i < vecsize; i++)
             {
-                int idx;
+                int64_t idx;
                 if (incr == -1)
                     idx = ivec[vecsize - i - 1];
                 else
@@ -11604,7 +12166,7 @@ bool oml_find(EvaluatorInterface           eval,
         {
             for (int i = 0; i < vecsize; i++)
             {
-                int idx;
+                int64_t idx;
                 if (incr == -1)
                     idx = ivec[vecsize - i - 1];
                 else
@@ -11772,6 +12334,19 @@ bool oml_length(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
 		else
 		   outputs.push_back(max(cells->M(), cells->N()));
     }
+    else if (input.IsPackedLogical())
+    {
+        outputs.push_back(max(input.MatrixB()->M(), input.MatrixB()->N()));
+    }
+    else if (input.IsPackedString())
+    {
+        const hwMatrixC *chars = input.MatrixC();
+
+        if (chars->IsEmpty())
+            outputs.push_back(0.0);
+        else
+            outputs.push_back(max(chars->M(), chars->N()));
+    }
     else if (input.IsMatrix())
     {
         const hwMatrix *mtx = input.Matrix();
@@ -11781,6 +12356,25 @@ bool oml_length(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
         else
             outputs.push_back(max(mtx->M(), mtx->N()));
     }
+    else if (input.IsSingle())
+    {
+        const hwMatrixF *mtx = input.MatrixF();
+
+        if (mtx->IsEmpty())
+            outputs.push_back(0.0);
+        else
+            outputs.push_back(max(mtx->M(), mtx->N()));
+    }
+    else if (input.IsIntegerType())
+    {
+        int m, n;
+        input.IntegerDims(m, n);
+
+        if (m == 0 || n == 0)
+            outputs.push_back(0.0);
+        else
+            outputs.push_back(max(m, n));
+    }
     else if (input.IsNDMatrix())
     {
         const hwMatrixN *mtx = input.MatrixN();
@@ -11833,6 +12427,17 @@ bool oml_length(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
     return true;
 }
 //------------------------------------------------------------------------------
+// Dimensions of an integer matrix, for dosize
+//------------------------------------------------------------------------------
+struct IntegerShape
+{
+    int M() const { return m; }
+    int N() const { return n; }
+
+    int m;
+    int n;
+};
+//------------------------------------------------------------------------------
 // 
 //------------------------------------------------------------------------------
 template <typename T>
@@ -11985,12 +12590,26 @@ bool oml_size(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                 outputs.push_back(1.0);
         }
 	}
+    else if (input1.IsPackedLogical())
+        dosize(input1.MatrixB(), dim, (int) size, nargout, outputs);
+    else if (input1.IsPackedString())
+        dosize(input1.MatrixC(), dim, (int) size, nargout, outputs);
     else if (input1.IsMatrix() || input1.IsString())
         dosize(input1.Matrix(), dim, (int) size, nargout, outputs);
     else if (input1.IsCellArray())
         dosize(input1.CellArray(), dim, (int) size, nargout, outputs);
     else if (input1.IsStruct())
         dosize(input1.Struct(), dim, (int) size, nargout, outputs);
+    else if (input1.IsSparse())
+        dosize(input1.MatrixS(), dim, (int) size, nargout, outputs);
+    else if (input1.IsSingle())
+        dosize(input1.MatrixF(), dim, (int) size, nargout, outputs);
+    else if (input1.IsIntegerType())
+    {
+        IntegerShape shape;
+        input1.IntegerDims(shape.m, shape.n);
+        dosize(&shape, dim, (int) size, nargout, outputs);
+    }
     else
         throw OML_Error(HW_ERROR_INPUTSTRCELLMTX);
 
@@ -12444,14 +13063,14 @@ bool oml_hypot(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
         result = EvaluatorInterface::allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
         if (m1->IsReal())
         {
-            for (int i = 0; i < m1->Size(); i++)
+            for (int64_t i = 0; i < m1->Size(); i++)
             {
                 result->SetElement(i, hypot(singleton, (*m1)(i)));
             }
         }
         else
         {
-            for (int i = 0; i < m1->Size(); i++)
+            for (int64_t i = 0; i < m1->Size(); i++)
             {
                 result->SetElement(i, hypot(singleton, m1->z(i).Mag()));
             }
@@ -12466,14 +13085,11 @@ bool oml_hypot(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
             {
                 if (m2->IsReal())
                 {
-                    for (int i = 0; i < m1->Size(); i++)
-                    {
-                        result->SetElement(i, hypot((*m1)(i), (*m2)(i)));
-                    }
+                    hwVectorMath::Hypot(m1->Size(), m1->GetRealData(), m2->GetRealData(), result->GetRealData());
                 }
                 else
                 {
-                    for (int i = 0; i < m1->Size(); i++)
+                    for (int64_t i = 0; i < m1->Size(); i++)
                     {
                         result->SetElement(i, hypot((*m1)(i), m2->z(i).Mag()));
                     }
@@ -12483,14 +13099,14 @@ bool oml_hypot(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
             {
                 if (m2->IsReal())
                 {
-                    for (int i = 0; i < m1->Size(); i++)
+                    for (int64_t i = 0; i < m1->Size(); i++)
                     {
                         result->SetElement(i, hypot(m1->z(i).Mag(), (*m2)(i)));
                     }
                 }
                 else
                 {
-                    for (int i = 0; i < m1->Size(); i++)
+                    for (int64_t i = 0; i < m1->Size(); i++)
                     {
                         result->SetElement(i, hypot(m1->z(i).Mag(), m2->z(i).Mag()));
                     }
@@ -12705,6 +13321,105 @@ bool oml_zeros(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 	return createCommonMatrix(eval, inputs, outputs, Currency(0.0));
 }
 //------------------------------------------------------------------------------
+// Returns the index of the first extreme value of a real vector, as found by a
+// serial scan that replaces the current value when better(value, current)
+//------------------------------------------------------------------------------
+template <typename Compare>
+static int realExtremeIndex(const double* data, int n, Compare better)
+{
+    // a leading NaN is never replaced, and NaN never replaces anything else
+    if (IsNaN_T(data[0]))
+        return 0;
+
+    return hwThreadPool::Reduce<int>(n,
+        [=](int64_t begin, int64_t end)
+        {
+            int index = -1;
+            for (int k = begin; k < end; ++k)
+            {
+                if (!IsNaN_T(data[k]) && (index < 0 || better(data[k], data[index])))
+                    index = k;
+            }
+            return index;
+        },
+        [=](int first, int second)
+        {
+            if (first < 0)
+                return second;
+            if (second < 0 || !better(data[second], data[first]))
+                return first;
+            return second;
+        });
+}
+//------------------------------------------------------------------------------
+// Returns the sum of a real vector
+//------------------------------------------------------------------------------
+static double realSum(const double* data, int n)
+{
+    return hwThreadPool::Reduce<double>(n,
+        [=](int64_t begin, int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t k = begin; k < end; ++k)
+                sum += data[k];
+            return sum;
+        },
+        [](double first, double second) { return first + second; });
+}
+//------------------------------------------------------------------------------
+// Returns the product of a real vector
+//------------------------------------------------------------------------------
+static double realProd(const double* data, int n)
+{
+    return hwThreadPool::Reduce<double>(n,
+        [=](int64_t begin, int64_t end)
+        {
+            double prod = 1.0;
+            for (int64_t k = begin; k < end; ++k)
+                prod *= data[k];
+            return prod;
+        },
+        [](double first, double second) { return first * second; });
+}
+//------------------------------------------------------------------------------
+// Computes the cumulative sum of a real vector
+//------------------------------------------------------------------------------
+static void realCumSum(const double* data, double* result, int n)
+{
+    int numChunks = hwThreadPool::ReductionChunks(n);
+    std::vector<double> offset(numChunks, 0.0);
+
+    // sum each chunk, then turn the sums into starting offsets
+    if (numChunks > 1)
+    {
+        hwThreadPool::ParallelChunks(n, numChunks, [&](int chunk, int64_t begin, int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t k = begin; k < end; ++k)
+                sum += data[k];
+            offset[chunk] = sum;
+        });
+
+        double total = 0.0;
+        for (int chunk = 0; chunk < numChunks; ++chunk)
+        {
+            double sum = offset[chunk];
+            offset[chunk] = total;
+            total += sum;
+        }
+    }
+
+    hwThreadPool::ParallelChunks(n, numChunks, [&](int chunk, int64_t begin, int64_t end)
+    {
+        double sum = offset[chunk];
+        for (int64_t k = begin; k < end; ++k)
+        {
+            sum += data[k];
+            result[k] = sum;
+        }
+    });
+}
+//------------------------------------------------------------------------------
 // Returns the min value in the given input [min]
 //------------------------------------------------------------------------------
 bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
@@ -12753,17 +13468,8 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             {
                 if (mtx->IsReal())
                 {
-                    double loc_min = (*mtx)(0);
-                    for (int k = 1; k < mtx->Size(); k++)
-                    {
-                        double temp = (*mtx)(k);
-                        if (temp < loc_min)
-                        {
-                            loc_min = temp;
-                            index = k;
-                        }
-                    }
-                    outputs.push_back(loc_min);
+                    index = realExtremeIndex(mtx->GetRealData(), static_cast<int>(mtx->Size()), std::less<double>());
+                    outputs.push_back((*mtx)(index));
                     outputs.push_back(index + 1);
                 }
                 else
@@ -12796,23 +13502,25 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 
                     if (mtx->IsReal())
                     {
-                        double loc_min;
-                        for (int i = 0; i < mtx->N(); ++i)
+                        hwThreadPool::ParallelFor(mtx->N(), [&](int64_t begin, int64_t end)
                         {
-                            loc_min = (*mtx)(0, i);
-                            index = 0;
-                            for (int j = 1; j < mtx->M(); ++j)
+                            for (int i = begin; i < end; ++i)
                             {
-                                double temp = (*mtx)(j, i);
-                                if (temp < loc_min)
+                                double loc_min = (*mtx)(0, i);
+                                int loc_index = 0;
+                                for (int j = 1; j < mtx->M(); ++j)
                                 {
-                                    loc_min = temp;
-                                    index = j;
+                                    double temp = (*mtx)(j, i);
+                                    if (temp < loc_min)
+                                    {
+                                        loc_min = temp;
+                                        loc_index = j;
+                                    }
                                 }
+                                result->SetElement(i, loc_min);
+                                indices->SetElement(i, loc_index + 1);
                             }
-                            result->SetElement(i, loc_min);
-                            indices->SetElement(i, index + 1);
-                        }
+                        }, mtx->M());
                     }
                     else
                     {
@@ -12841,14 +13549,14 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
         }
         else if (input1.IsNDMatrix())
         {
-            return oml_MatrixNUtil3(eval, inputs, outputs, oml_min);
+            return oml_MatrixN_Extreme(eval, inputs, outputs, &hwMatrixN::Min);
         }
         else
             throw OML_Error(HW_ERROR_INPUTSCALARCOMPLEXMATRIX);
     }
     else if (input1.IsNDMatrix() && size == 3)
     {
-        return oml_MatrixNUtil3(eval, inputs, outputs, oml_min, 3);
+        return oml_MatrixN_Extreme(eval, inputs, outputs, &hwMatrixN::Min, 3);
     }
     else if (input1.IsNDMatrix() || input2.IsNDMatrix())
     {
@@ -13011,14 +13719,14 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                 {
                     if (i2->IsReal())
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             result->SetElement(k, min((*i1)(k), (*i2)(k)));
                         }
                     }
                     else
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             double v1 = (*i1)(k);
                             hwComplex val1 = hwComplex(v1, 0.0);
@@ -13034,7 +13742,7 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                 {
                     if (i2->IsReal())
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             hwComplex val1 = i1->z(k);
                             double v2 = (*i2)(k);
@@ -13047,7 +13755,7 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                     }
                     else
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             hwComplex val1 = i1->z(k);
                             hwComplex val2 = i2->z(k);
@@ -13107,7 +13815,7 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             double val;
             if (scalar)
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = (*mtx)(k);
                     result->SetElement(k, min(dbl, val));
@@ -13115,7 +13823,7 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             }
             else
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = (*mtx)(k);
                     if (complexLessThan(hwComplex(val, 0.0), cplx))
@@ -13130,7 +13838,7 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             hwComplex val;
             if (scalar)
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = mtx->z(k);
                     if (complexLessThan(hwComplex(dbl, 0.0), val))
@@ -13141,7 +13849,7 @@ bool oml_min(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             }
             else
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = mtx->z(k);
                     if (complexLessThan(cplx, val))
@@ -13205,17 +13913,8 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             {
                 if (mtx->IsReal())
                 {
-                    double max = (*mtx)(0);
-                    for (int k = 1; k < mtx->Size(); k++)
-                    {
-                        double temp = (*mtx)(k);
-                        if (temp > max)
-                        {
-                            max = temp;
-                            index = k;
-                        }
-                    }
-                    outputs.push_back(max);
+                    index = realExtremeIndex(mtx->GetRealData(), static_cast<int>(mtx->Size()), std::greater<double>());
+                    outputs.push_back((*mtx)(index));
                     outputs.push_back(index + 1);
                 }
                 else
@@ -13248,23 +13947,25 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 
                     if (mtx->IsReal())
                     {
-                        double loc_max;
-                        for (int i = 0; i < mtx->N(); ++i)
+                        hwThreadPool::ParallelFor(mtx->N(), [&](int64_t begin, int64_t end)
                         {
-                            loc_max = (*mtx)(0, i);
-                            index = 0;
-                            for (int j = 1; j < mtx->M(); ++j)
+                            for (int i = begin; i < end; ++i)
                             {
-                                double temp = (*mtx)(j, i);
-                                if (temp > loc_max)
+                                double loc_max = (*mtx)(0, i);
+                                int loc_index = 0;
+                                for (int j = 1; j < mtx->M(); ++j)
                                 {
-                                    loc_max = temp;
-                                    index = j;
+                                    double temp = (*mtx)(j, i);
+                                    if (temp > loc_max)
+                                    {
+                                        loc_max = temp;
+                                        loc_index = j;
+                                    }
                                 }
+                                result->SetElement(i, loc_max);
+                                indices->SetElement(i, loc_index + 1);
                             }
-                            result->SetElement(i, loc_max);
-                            indices->SetElement(i, index + 1);
-                        }
+                        }, mtx->M());
                     }
                     else
                     {
@@ -13293,14 +13994,14 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
         }
         else if (input1.IsNDMatrix())
         {
-            return oml_MatrixNUtil3(eval, inputs, outputs, oml_max);
+            return oml_MatrixN_Extreme(eval, inputs, outputs, &hwMatrixN::Max);
         }
         else
             throw OML_Error(HW_ERROR_INPUTSCALARCOMPLEXMATRIX);
     }
     else if (input1.IsNDMatrix() && size == 3)
     {
-        return oml_MatrixNUtil3(eval, inputs, outputs, oml_max, 3);
+        return oml_MatrixN_Extreme(eval, inputs, outputs, &hwMatrixN::Max, 3);
     }
     else if (input1.IsNDMatrix() || input2.IsNDMatrix())
     {
@@ -13463,14 +14164,14 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                 {
                     if (i2->IsReal())
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             result->SetElement(k, max((*i1)(k), (*i2)(k)));
                         }
                     }
                     else
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             double v1 = (*i1)(k);
                             hwComplex val1 = hwComplex(v1, 0.0);
@@ -13486,7 +14187,7 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                 {
                     if (i2->IsReal())
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             hwComplex val1 = i1->z(k);
                             double v2 = (*i2)(k);
@@ -13499,7 +14200,7 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
                     }
                     else
                     {
-                        for (int k = 0; k < i1->Size(); k++)
+                        for (int64_t k = 0; k < i1->Size(); k++)
                         {
                             hwComplex val1 = i1->z(k);
                             hwComplex val2 = i2->z(k);
@@ -13559,7 +14260,7 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             double val;
             if (scalar)
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = (*mtx)(k);
                     result->SetElement(k, max(dbl, val));
@@ -13567,7 +14268,7 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             }
             else
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = (*mtx)(k);
                     if (complexGreaterThan(hwComplex(val, 0.0), cplx))
@@ -13582,7 +14283,7 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             hwComplex val;
             if (scalar)
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = mtx->z(k);
                     if (complexGreaterThan(hwComplex(dbl, 0.0), val))
@@ -13593,7 +14294,7 @@ bool oml_max(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             }
             else
             {
-                for (int k = 0; k < mtx->Size(); ++k)
+                for (int64_t k = 0; k < mtx->Size(); ++k)
                 {
                     val = mtx->z(k);
                     if (complexGreaterThan(cplx, val))
@@ -13964,7 +14665,7 @@ bool oml_rank(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
         //		if (tolerances->IsVector())
         //		{
         //			rank = 0;
-        //			for (int i=0; i<tolerances->Size(); ++i)
+        //			for (int64_t i=0; i<tolerances->Size(); ++i)
         //			{
         //				if (tolerances->IsReal())
         //					tol = (*tolerances)(i);
@@ -14889,54 +15590,326 @@ bool oml_transpose(EvaluatorInterface eval, const std::vector<Currency>& inputs,
     const Currency &input1 = inputs[0];
     if (input1.IsScalar() || input1.IsComplex() || input1.IsMatrix() || input1.IsCellArray() || input1.IsStruct())
         outputs.push_back(transpose(eval, input1));
+    else if (input1.IsSparse())
+    {
+        hwMatrixS* result = new hwMatrixS;
+        outputs.push_back(result);
+        result->Transpose(*input1.MatrixS());
+    }
     else
         throw OML_Error(HW_ERROR_INVINPTYPE);
 
     return true;
 }
 //------------------------------------------------------------------------------
-// Returns convolution of input vectors [conv]
+// Returns a sparse matrix [sparse]
 //------------------------------------------------------------------------------
-bool oml_conv(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+bool oml_sparse(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
 {
-    if (inputs.size() != 2)
+    size_t nargin = inputs.size();
+
+    if (nargin != 1 && nargin != 2 && nargin != 3 && nargin != 5)
         throw OML_Error(OML_ERR_NUMARGIN);
 
-    if (!inputs[0].IsMatrix() && !inputs[0].IsScalar() && !inputs[0].IsComplex() && !inputs[0].IsString())
-        throw OML_Error(OML_ERR_MATRIX, 1, OML_VAR_DATA);
+    hwMatrixS*   result = new hwMatrixS;
+    Currency     out(result);
+    hwMathStatus status;
 
-    if (!inputs[1].IsMatrix() && !inputs[1].IsScalar() && !inputs[1].IsComplex() && !inputs[1].IsString())
-        throw OML_Error(OML_ERR_MATRIX, 2, OML_VAR_DATA);
+    if (nargin == 1)
+    {
+        // sparse(A)
+        const Currency& input1 = inputs[0];
 
-    const hwMatrix* m1 = inputs[0].ConvertToMatrix();
-    const hwMatrix* m2 = inputs[1].ConvertToMatrix();
-    hwMatrix *result = EvaluatorInterface::allocateMatrix();
-    Currency out(result);
+        if (input1.IsSparse())
+        {
+            outputs.push_back(input1);
+            return true;
+        }
 
-    if (!(m1->IsVector() && m2->IsVector()))
-        throw OML_Error(HW_ERROR_MATINPMUSTVEC);
+        if (!input1.IsScalar() && !input1.IsMatrix())
+            throw OML_Error(OML_ERR_REAL, 1, OML_VAR_MATRIX);
 
-    BuiltInFuncsUtils::CheckMathStatus(eval, result->ConvLin(*m2, *m1));
-    outputs.push_back(out);
-    return true;
-}
-//------------------------------------------------------------------------------
-// Computes the trace of the input matrix [trace]
-//------------------------------------------------------------------------------
-bool oml_trace(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
-{
-    if (inputs.size() != 1)
-        throw OML_Error(OML_ERR_NUMARGIN);
+        const hwMatrix* mtx = input1.ConvertToMatrix();
 
-    const Currency &input = inputs[0];
+        if (!mtx->IsReal())
+            throw OML_Error(OML_ERR_REAL, 1, OML_VAR_MATRIX);
 
-    if (input.IsScalar())
-    {
-        outputs.push_back(input.Scalar());
+        status = result->Convert(*mtx);
     }
-    else if (input.IsComplex())
+    else if (nargin == 2)
     {
-        outputs.push_back(input.Complex());
+        // sparse(m, n)
+        if (!inputs[0].IsPositiveInteger() && !(inputs[0].IsScalar() && inputs[0].Scalar() == 0.0))
+            throw OML_Error(OML_ERR_NATURALNUM, 1, OML_VAR_DIM);
+
+        if (!inputs[1].IsPositiveInteger() && !(inputs[1].IsScalar() && inputs[1].Scalar() == 0.0))
+            throw OML_Error(OML_ERR_NATURALNUM, 2, OML_VAR_DIM);
+
+        *result = hwMatrixS(static_cast<int>(inputs[0].Scalar()), static_cast<int>(inputs[1].Scalar()));
+    }
+    else
+    {
+        // sparse(i, j, v) or sparse(i, j, v, m, n)
+        for (int k = 0; k < 3; ++k)
+        {
+            if (!inputs[k].IsScalar() && !(inputs[k].IsMatrix() && inputs[k].Matrix()->IsReal()))
+                throw OML_Error(OML_ERR_REAL, k+1, OML_VAR_DATA);
+        }
+
+        const hwMatrix* rowMtx = inputs[0].ConvertToMatrix();
+        const hwMatrix* colMtx = inputs[1].ConvertToMatrix();
+        const hwMatrix* valMtx = inputs[2].ConvertToMatrix();
+
+        // scalars are expanded to the length of the other inputs
+        int64_t nnz = std::max(rowMtx->Size(), std::max(colMtx->Size(), valMtx->Size()));
+
+        if ((rowMtx->Size() != 1 && rowMtx->Size() != nnz) ||
+            (colMtx->Size() != 1 && colMtx->Size() != nnz) ||
+            (valMtx->Size() != 1 && valMtx->Size() != nnz))
+        {
+            throw OML_Error(HW_ERROR_INPMUSTSAMESIZE);
+        }
+
+        std::vector<int>    rows(nnz);
+        std::vector<int>    cols(nnz);
+        std::vector<double> values(nnz);
+        int m = 0;
+        int n = 0;
+
+        for (int64_t k = 0; k < nnz; ++k)
+        {
+            double i = (*rowMtx)(rowMtx->Size() == 1 ? 0 : k);
+            double j = (*colMtx)(colMtx->Size() == 1 ? 0 : k);
+
+            if (i < 1.0 || i != floor(i))
+                throw OML_Error(OML_ERR_POSINTEGER, 1, OML_VAR_INDEX);
+
+            if (j < 1.0 || j != floor(j))
+                throw OML_Error(OML_ERR_POSINTEGER, 2, OML_VAR_INDEX);
+
+            rows[k]   = static_cast<int>(i) - 1;
+            cols[k]   = static_cast<int>(j) - 1;
+            values[k] = (*valMtx)(valMtx->Size() == 1 ? 0 : k);
+            m = std::max(m, rows[k] + 1);
+            n = std::max(n, cols[k] + 1);
+        }
+
+        if (nargin == 5)
+        {
+            if (!inputs[3].IsPositiveInteger() && !(inputs[3].IsScalar() && inputs[3].Scalar() == 0.0))
+                throw OML_Error(OML_ERR_NATURALNUM, 4, OML_VAR_DIM);
+
+            if (!inputs[4].IsPositiveInteger() && !(inputs[4].IsScalar() && inputs[4].Scalar() == 0.0))
+                throw OML_Error(OML_ERR_NATURALNUM, 5, OML_VAR_DIM);
+
+            if (inputs[3].Scalar() < m || inputs[4].Scalar() < n)
+                throw OML_Error(HW_ERROR_INDEXRANGE);
+
+            m = static_cast<int>(inputs[3].Scalar());
+            n = static_cast<int>(inputs[4].Scalar());
+        }
+
+        status = result->Assemble(m, n, rows, cols, values);
+    }
+
+    BuiltInFuncsUtils::CheckMathStatus(eval, status);
+
+    outputs.push_back(out);
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns a dense matrix [full]
+//------------------------------------------------------------------------------
+bool oml_full(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    const Currency& input1 = inputs[0];
+
+    if (!input1.IsSparse())
+    {
+        outputs.push_back(input1);
+        return true;
+    }
+
+    hwMatrix* result = EvaluatorInterface::allocateMatrix();
+    Currency  out(result);
+
+    BuiltInFuncsUtils::CheckMathStatus(eval, input1.MatrixS()->Full(*result));
+
+    outputs.push_back(out);
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns the number of nonzero elements [nnz]
+//------------------------------------------------------------------------------
+bool oml_nnz(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    const Currency& input1 = inputs[0];
+
+    if (input1.IsSparse())
+    {
+        outputs.push_back(input1.MatrixS()->NNZ());
+    }
+    else if (input1.IsPackedLogical())
+    {
+        outputs.push_back(static_cast<double>(LogicalArray::Count(*input1.MatrixB())));
+    }
+    else if (input1.IsScalar())
+    {
+        outputs.push_back(input1.Scalar() != 0.0 ? 1.0 : 0.0);
+    }
+    else if (input1.IsComplex())
+    {
+        outputs.push_back(input1.Complex() != 0.0 ? 1.0 : 0.0);
+    }
+    else if (input1.IsMatrix() || input1.IsString())
+    {
+        const hwMatrix* mtx = input1.Matrix();
+        int64_t size  = mtx->Size();
+        int count = 0;
+
+        if (mtx->IsReal())
+        {
+            const double* data = mtx->GetRealData();
+
+            for (int64_t k = 0; k < size; ++k)
+            {
+                if (data[k] != 0.0)
+                    ++count;
+            }
+        }
+        else
+        {
+            const hwComplex* data = mtx->GetComplexData();
+
+            for (int64_t k = 0; k < size; ++k)
+            {
+                if (data[k] != 0.0)
+                    ++count;
+            }
+        }
+
+        outputs.push_back(count);
+    }
+    else
+    {
+        throw OML_Error(OML_ERR_NUMERIC, 1, OML_VAR_DATA);
+    }
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns true if the input is a sparse matrix [issparse]
+//------------------------------------------------------------------------------
+bool oml_issparse(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    outputs.push_back(HW_MAKE_BOOL_CURRENCY(inputs[0].IsSparse()));
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns the factors of a matrix, for repeated solves with mldivide [decomposition]
+//------------------------------------------------------------------------------
+bool oml_decomposition(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    const Currency& input1 = inputs[0];
+
+    if (input1.IsDecomposition())
+    {
+        outputs.push_back(input1);
+        return true;
+    }
+
+    if (!input1.IsScalar() && !input1.IsComplex() && !input1.IsMatrix())
+        throw OML_Error(OML_ERR_SCALARCOMPLEXMTX, 1, OML_VAR_MATRIX);
+
+    input1.ConvertToMatrix();
+
+    outputs.push_back(Currency(new Decomposition(input1)));
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns convolution of input vectors [conv]
+//------------------------------------------------------------------------------
+bool oml_conv(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    size_t nargin = inputs.size();
+
+    if (nargin != 2 && nargin != 3)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    if (!inputs[0].IsMatrix() && !inputs[0].IsScalar() && !inputs[0].IsComplex() && !inputs[0].IsString())
+        throw OML_Error(OML_ERR_MATRIX, 1, OML_VAR_DATA);
+
+    if (!inputs[1].IsMatrix() && !inputs[1].IsScalar() && !inputs[1].IsComplex() && !inputs[1].IsString())
+        throw OML_Error(OML_ERR_MATRIX, 2, OML_VAR_DATA);
+
+    const hwMatrix* m1 = inputs[0].ConvertToMatrix();
+    const hwMatrix* m2 = inputs[1].ConvertToMatrix();
+    hwMatrix *result = EvaluatorInterface::allocateMatrix();
+    Currency out(result);
+
+    if (!(m1->IsVector() && m2->IsVector()))
+        throw OML_Error(HW_ERROR_MATINPMUSTVEC);
+
+    // only the requested part of the convolution is computed
+    int na = static_cast<int>(m1->Size());
+    int nb = static_cast<int>(m2->Size());
+    int start = 0;
+    int count = max(na + nb - 1, 0);
+
+    if (nargin == 3)
+    {
+        std::string shape = readOption(eval, inputs[2]);
+
+        if (shape == "same")
+        {
+            start = nb / 2;
+            count = na;
+        }
+        else if (shape == "valid")
+        {
+            start = max(nb - 1, 0);
+            count = max(na - nb + 1, 0);
+        }
+        else if (shape != "full")
+        {
+            throw OML_Error(HW_ERROR_INVSHAPEFULLSAMEVALID);
+        }
+    }
+
+    BuiltInFuncsUtils::CheckMathStatus(eval, result->ConvLin(*m2, *m1, start, count));
+    outputs.push_back(out);
+    return true;
+}
+//------------------------------------------------------------------------------
+// Computes the trace of the input matrix [trace]
+//------------------------------------------------------------------------------
+bool oml_trace(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    const Currency &input = inputs[0];
+
+    if (input.IsScalar())
+    {
+        outputs.push_back(input.Scalar());
+    }
+    else if (input.IsComplex())
+    {
+        outputs.push_back(input.Complex());
     }
     else if (input.IsMatrix())
     {
@@ -15042,6 +16015,317 @@ bool oml_det(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
     return true;
 }
 //------------------------------------------------------------------------------
+// Gets the pages of a square matrix or n x n x ... array [pagedet/pageinv/pageeig]
+//------------------------------------------------------------------------------
+static void GetMatrixPages(const Currency&    input,
+                           int&               n,
+                           int&               count,
+                           std::vector<int>&  dims,
+                           const double*&     real,
+                           const hwComplex*&  cplx)
+{
+    if (input.IsNDMatrix())
+    {
+        const hwMatrixN* mtxN = input.MatrixN();
+        dims = mtxN->Dimensions();
+        real = mtxN->IsReal() ? mtxN->GetRealData() : nullptr;
+        cplx = mtxN->IsReal() ? nullptr : mtxN->GetComplexData();
+    }
+    else if (input.IsMatrix() || input.IsScalar() || input.IsComplex())
+    {
+        const hwMatrix* mtx = input.ConvertToMatrix();
+        dims.clear();
+        dims.push_back(mtx->M());
+        dims.push_back(mtx->N());
+        real = mtx->IsReal() ? mtx->GetRealData() : nullptr;
+        cplx = mtx->IsReal() ? nullptr : mtx->GetComplexData();
+    }
+    else
+    {
+        throw OML_Error(OML_ERR_MATRIX, 1, OML_VAR_DATA);
+    }
+
+    if (dims[0] != dims[1])
+        throw OML_Error(HW_MATH_MSG_MTXNOTSQUARE);
+
+    n     = dims[0];
+    count = 1;
+
+    for (size_t i = 2; i < dims.size(); ++i)
+        count *= dims[i];
+}
+//------------------------------------------------------------------------------
+// Allocates the m x n x ... result of a page function [pagedet/pageinv/pageeig]
+//------------------------------------------------------------------------------
+static hwMatrixN* AllocatePages(const std::vector<int>& dims, int m, int n,
+                                hwMatrixN::DataType type)
+{
+    std::vector<int> resultDims(dims);
+    resultDims[0] = m;
+    resultDims[1] = n;
+
+    hwMatrixN* result = EvaluatorInterface::allocateMatrixN();
+    result->Dimension(resultDims, type);
+
+    return result;
+}
+//------------------------------------------------------------------------------
+// Returns the determinant of each page of an n x n x ... array [pagedet]
+//------------------------------------------------------------------------------
+bool oml_pagedet(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    int n;
+    int count;
+    std::vector<int> dims;
+    const double*    real;
+    const hwComplex* cplx;
+
+    GetMatrixPages(inputs[0], n, count, dims, real, cplx);
+
+    std::unique_ptr<hwMatrixN> result(AllocatePages(dims, 1, 1,
+        real ? hwMatrixN::REAL : hwMatrixN::COMPLEX));
+
+    if (real)
+    {
+        double* det = result->GetRealData();
+
+        switch (n)
+        {
+        case 2:  hwMatrix2::Determinant(real, count, det); break;
+        case 3:  hwMatrix3::Determinant(real, count, det); break;
+        case 4:  hwMatrix4::Determinant(real, count, det); break;
+        default:
+            for (int k = 0; k < count; ++k)
+            {
+                if (n == 0)
+                {
+                    det[k] = 1.0;
+                    continue;
+                }
+
+                hwMatrix page(n, n, (void*) (real + k * n * n), hwMatrix::REAL);
+                BuiltInFuncsUtils::CheckMathStatus(eval, page.Determinant(det[k]));
+            }
+        }
+    }
+    else
+    {
+        hwComplex* det = result->GetComplexData();
+
+        for (int k = 0; k < count; ++k)
+        {
+            hwMatrix page(n, n, (void*) (cplx + k * n * n), hwMatrix::COMPLEX);
+            BuiltInFuncsUtils::CheckMathStatus(eval, page.Determinant(det[k]));
+        }
+    }
+
+    outputs.push_back(result.release());
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns the inverse of each page of an n x n x ... array [pageinv]
+//------------------------------------------------------------------------------
+bool oml_pageinv(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    int n;
+    int count;
+    std::vector<int> dims;
+    const double*    real;
+    const hwComplex* cplx;
+
+    GetMatrixPages(inputs[0], n, count, dims, real, cplx);
+
+    std::unique_ptr<hwMatrixN> result(AllocatePages(dims, n, n,
+        real ? hwMatrixN::REAL : hwMatrixN::COMPLEX));
+
+    int numSingular = 0;
+
+    if (real && n >= 2 && n <= 4)
+    {
+        double* inv = result->GetRealData();
+
+        switch (n)
+        {
+        case 2:  numSingular = hwMatrix2::Inverse(real, count, inv); break;
+        case 3:  numSingular = hwMatrix3::Inverse(real, count, inv); break;
+        case 4:  numSingular = hwMatrix4::Inverse(real, count, inv); break;
+        }
+    }
+    else if (n > 0)
+    {
+        hwMatrix::DataType type = real ? hwMatrix::REAL : hwMatrix::COMPLEX;
+
+        for (int k = 0; k < count; ++k)
+        {
+            void* data = real ? (void*) (real + k * n * n) : (void*) (cplx + k * n * n);
+            hwMatrix page(n, n, data, type);
+            hwMatrix inv;
+            hwMathStatus stat = inv.Inverse(page);
+
+            if (stat.IsWarning())
+                ++numSingular;
+            else
+                BuiltInFuncsUtils::CheckMathStatus(eval, stat);
+
+            if (real)
+                std::copy(inv.GetRealData(), inv.GetRealData() + n * n, result->GetRealData() + k * n * n);
+            else
+                std::copy(inv.GetComplexData(), inv.GetComplexData() + n * n, result->GetComplexData() + k * n * n);
+        }
+    }
+
+    if (numSingular)
+        BuiltInFuncsUtils::CheckMathStatus(eval, hwMathStatus(HW_MATH_WARN_SINGMATRIX));
+
+    outputs.push_back(result.release());
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns the eigenvalues, or eigenvectors and eigenvalues, of each page of an
+// n x n x ... array [pageeig]
+//------------------------------------------------------------------------------
+bool oml_pageeig(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
+{
+    if (inputs.size() != 1)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    int n;
+    int count;
+    std::vector<int> dims;
+    const double*    real;
+    const hwComplex* cplx;
+
+    GetMatrixPages(inputs[0], n, count, dims, real, cplx);
+
+    bool vectors = getNumOutputs(eval) > 1;
+    bool fixed   = real && n >= 2 && n <= 4;
+
+    switch (fixed ? n : 0)
+    {
+    case 2:  fixed = hwMatrix2::IsSymmetric(real, count); break;
+    case 3:  fixed = hwMatrix3::IsSymmetric(real, count); break;
+    case 4:  fixed = hwMatrix4::IsSymmetric(real, count); break;
+    }
+
+    std::unique_ptr<hwMatrixN> V;
+    std::unique_ptr<hwMatrixN> D;
+
+    if (fixed)
+    {
+        // real symmetric pages have real eigenvalues, computed in one call
+        D.reset(AllocatePages(dims, n, 1, hwMatrixN::REAL));
+
+        if (vectors)
+            V.reset(AllocatePages(dims, n, n, hwMatrixN::REAL));
+
+        double* values = D->GetRealData();
+        double* vecs   = vectors ? V->GetRealData() : nullptr;
+
+        switch (n)
+        {
+        case 2:  hwMatrix2::EigenSym(real, count, values, vecs); break;
+        case 3:  hwMatrix3::EigenSym(real, count, values, vecs); break;
+        case 4:  hwMatrix4::EigenSym(real, count, values, vecs); break;
+        }
+    }
+    else
+    {
+        // general pages, whose results are complex if any page has complex
+        // eigenvalues
+        std::vector<hwMatrix> pageV(count);
+        std::vector<hwMatrix> pageD(count);
+        bool isReal = true;
+        hwMatrix::DataType type = real ? hwMatrix::REAL : hwMatrix::COMPLEX;
+
+        for (int k = 0; k < count && n > 0; ++k)
+        {
+            void* data = real ? (void*) (real + k * n * n) : (void*) (cplx + k * n * n);
+            hwMatrix page(n, n, data, type);
+            hwMathStatus stat;
+
+            if (page.IsHermitian())
+                stat = page.EigenSH(&pageV[k], pageD[k]);
+            else
+                stat = page.Eigen(true, &pageV[k], pageD[k]);
+
+            BuiltInFuncsUtils::CheckMathStatus(eval, stat);
+
+            if (!pageD[k].IsReal() || !pageV[k].IsReal())
+                isReal = false;
+        }
+
+        hwMatrixN::DataType resultType = isReal ? hwMatrixN::REAL : hwMatrixN::COMPLEX;
+        D.reset(AllocatePages(dims, n, 1, resultType));
+
+        if (vectors)
+            V.reset(AllocatePages(dims, n, n, resultType));
+
+        for (int k = 0; k < count && n > 0; ++k)
+        {
+            if (!isReal)
+            {
+                pageD[k].MakeComplex();
+                pageV[k].MakeComplex();
+            }
+
+            for (int i = 0; i < n; ++i)
+            {
+                if (isReal)
+                    D->GetRealData()[k * n + i] = pageD[k](i);
+                else
+                    D->GetComplexData()[k * n + i] = pageD[k].z(i);
+            }
+
+            if (!vectors)
+                continue;
+
+            for (int i = 0; i < n * n; ++i)
+            {
+                if (isReal)
+                    V->GetRealData()[k * n * n + i] = pageV[k](i);
+                else
+                    V->GetComplexData()[k * n * n + i] = pageV[k].z(i);
+            }
+        }
+    }
+
+    if (!vectors)
+    {
+        outputs.push_back(D.release());
+        return true;
+    }
+
+    // spread the eigenvalues along the diagonals of the pages of D
+    std::unique_ptr<hwMatrixN> diagD(AllocatePages(dims, n, n,
+        D->IsReal() ? hwMatrixN::REAL : hwMatrixN::COMPLEX));
+
+    for (int k = 0; k < count; ++k)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                int index = k * n * n + j * n + i;
+
+                if (diagD->IsReal())
+                    diagD->GetRealData()[index] = (i == j) ? D->GetRealData()[k * n + i] : 0.0;
+                else
+                    diagD->GetComplexData()[index] = (i == j) ? D->GetComplexData()[k * n + i] : hwComplex(0.0, 0.0);
+            }
+        }
+    }
+
+    outputs.push_back(V.release());
+    outputs.push_back(diagD.release());
+    return true;
+}
+//------------------------------------------------------------------------------
 // Compute the 1-norm estimate of the reciprocal condition number [rcond]
 //------------------------------------------------------------------------------
 bool oml_rcond(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
@@ -15114,7 +16398,7 @@ bool oml_mod(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             //hwMatrix* result = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), mtx->Type());
             hwMatrix* result = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
 
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 double divisor = realval(mtx, k);
                 result->SetElement(k, mod(dividend, divisor));
@@ -15145,7 +16429,7 @@ bool oml_mod(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
         {
             double divisor = input2.Scalar();
 
-            for (int k = 0; k < mtx1->Size(); k++)
+            for (int64_t k = 0; k < mtx1->Size(); k++)
             {
                 double dividend = realval(mtx1, k);
                 result->SetElement(k, mod(dividend, divisor));
@@ -15161,7 +16445,7 @@ bool oml_mod(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
             if (!sameSize(mtx1, mtx2))
                 throw OML_Error(OML_ERR_ARRAYSIZE, 1, 2, OML_VAR_DIMS);
 
-            for (int k = 0; k < mtx1->Size(); k++)
+            for (int64_t k = 0; k < mtx1->Size(); k++)
             {
                 double divisor  = realval(mtx1, k);
                 double dividend = realval(mtx2, k);
@@ -15217,7 +16501,7 @@ bool oml_real(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
         {
             result = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
 
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 hwComplex cplx = mtx->z(k);
                 result->SetElement(k, cplx.Real());
@@ -15267,12 +16551,12 @@ bool oml_imag(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
 
         if (mtx->IsReal())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
                 result->SetElement(k, 0.0);
         }
         else
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 hwComplex cplx = mtx->z(k);
                 result->SetElement(k, cplx.Imag());
@@ -15482,7 +16766,7 @@ bool oml_sign(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
 //------------------------------------------------------------------------------
 bool oml_exp(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
 {
-    if (!noConditionFunc(inputs, outputs, exp, hwComplex::exp))
+    if (!noConditionFunc(inputs, outputs, exp, hwComplex::exp, hwVectorMath::Exp, hwVectorMath::Exp))
     {
         return oml_MatrixNUtil1(eval, inputs, outputs, oml_exp);
     }
@@ -15515,14 +16799,14 @@ bool oml_conj(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
 
         if (mtx->IsReal())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 result->SetElement(k, (*mtx)(k));
             }
         }
         else
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 hwComplex cplx = mtx->z(k);
                 result->SetElement(k, cplx.Conjugate());
@@ -15602,18 +16886,30 @@ bool oml_prod(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
 
             if (mtx->IsReal())
             {
-                double prod;
-                for (int i = 0; i < (dim == 1 ? n : m); ++i)
+                int numOut = (dim == 1 ? n : m);
+                int len    = (dim == 1 ? m : n);
+
+                if (numOut == 1)
                 {
-                    prod = 1.0;
-                    for (int j = 0; j < (dim == 1 ? m : n); ++j)
+                    result->SetElement(0, realProd(mtx->GetRealData(), len));
+                }
+                else
+                {
+                    hwThreadPool::ParallelFor(numOut, [&](int64_t begin, int64_t end)
                     {
-                        if (dim == 1)
-                            prod *= (*mtx)(j, i);
-                        else
-                            prod *= (*mtx)(i, j);
-                    }
-                    result->SetElement(i, prod);
+                        for (int i = begin; i < end; ++i)
+                        {
+                            double prod = 1.0;
+                            for (int j = 0; j < len; ++j)
+                            {
+                                if (dim == 1)
+                                    prod *= (*mtx)(j, i);
+                                else
+                                    prod *= (*mtx)(i, j);
+                            }
+                            result->SetElement(i, prod);
+                        }
+                    }, len);
                 }
             }
             else
@@ -15639,11 +16935,11 @@ bool oml_prod(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
     {
         if (size == 1)
         {
-            oml_MatrixNUtil3(eval, inputs, outputs, oml_prod);
+            oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::Prod);
         }
         else
         {
-            oml_MatrixNUtil3(eval, inputs, outputs, oml_prod, 2);
+            oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::Prod, 2);
         }
     }
     else
@@ -15674,7 +16970,16 @@ bool oml_sum(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 
     const Currency &input1 = inputs[0];
 
-    if (input1.IsScalar())
+    if (input1.IsPackedLogical() && dim <= 2)
+    {
+        const hwMatrixB* flags = input1.MatrixB();
+
+        if (!dim)
+            dim = (flags->M() > 1 ? 1 : 2);
+
+        outputs.push_back(LogicalArray::Reduce(*flags, dim, LogicalArray::RED_SUM));
+    }
+    else if (input1.IsScalar())
         outputs.push_back(input1.Scalar());
     else if (input1.IsComplex())
         outputs.push_back(input1.Complex());
@@ -15703,18 +17008,30 @@ bool oml_sum(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 
             if (mtx->IsReal())
             {
-                double sum;
-                for (int i = 0; i < (dim == 1 ? n : m); ++i)
+                int numOut = (dim == 1 ? n : m);
+                int len    = (dim == 1 ? m : n);
+
+                if (numOut == 1)
                 {
-                    sum = 0.0;
-                    for (int j = 0; j < (dim == 1 ? m : n); ++j)
+                    result->SetElement(0, realSum(mtx->GetRealData(), len));
+                }
+                else
+                {
+                    hwThreadPool::ParallelFor(numOut, [&](int64_t begin, int64_t end)
                     {
-                        if (dim == 1)
-                            sum += (*mtx)(j, i);
-                        else
-                            sum += (*mtx)(i, j);
-                    }
-                    result->SetElement(i, sum);
+                        for (int i = begin; i < end; ++i)
+                        {
+                            double sum = 0.0;
+                            for (int j = 0; j < len; ++j)
+                            {
+                                if (dim == 1)
+                                    sum += (*mtx)(j, i);
+                                else
+                                    sum += (*mtx)(i, j);
+                            }
+                            result->SetElement(i, sum);
+                        }
+                    }, len);
                 }
             }
             else
@@ -15740,11 +17057,11 @@ bool oml_sum(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
     {
         if (size == 1)
         {
-            oml_MatrixNUtil3(eval, inputs, outputs, oml_sum);
+            oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::Sum);
         }
         else
         {
-            oml_MatrixNUtil3(eval, inputs, outputs, oml_sum, 2);
+            oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::Sum, 2);
         }
     }
     else
@@ -15810,23 +17127,35 @@ bool oml_cumsum(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
 
             if (mtx->IsReal())
             {
-                double sum;
-                for (int i = 0; i < (dim == 1 ? n : m); ++i)
+                int numOut = (dim == 1 ? n : m);
+                int len    = (dim == 1 ? m : n);
+
+                if (numOut == 1)
                 {
-                    sum = 0.0;
-                    for (int j = 0; j < (dim == 1 ? m : n); ++j)
+                    realCumSum(mtx->GetRealData(), result->GetRealData(), len);
+                }
+                else
+                {
+                    hwThreadPool::ParallelFor(numOut, [&](int64_t begin, int64_t end)
                     {
-                        if (dim == 1)
-                        {
-                            sum += (*mtx)(j, i);
-                            result->SetElement(j, i, sum);
-                        }
-                        else
+                        for (int i = begin; i < end; ++i)
                         {
-                            sum += (*mtx)(i, j);
-                            result->SetElement(i, j, sum);
+                            double sum = 0.0;
+                            for (int j = 0; j < len; ++j)
+                            {
+                                if (dim == 1)
+                                {
+                                    sum += (*mtx)(j, i);
+                                    result->SetElement(j, i, sum);
+                                }
+                                else
+                                {
+                                    sum += (*mtx)(i, j);
+                                    result->SetElement(i, j, sum);
+                                }
+                            }
                         }
-                    }
+                    }, len);
                 }
             }
             else
@@ -15857,11 +17186,11 @@ bool oml_cumsum(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
     {
         if (nargin == 1)
         {
-            return oml_MatrixNUtil4(eval, inputs, outputs, oml_cumsum);
+            return oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::CumSum);
         }
         else
         {
-            return oml_MatrixNUtil4(eval, inputs, outputs, oml_cumsum, 2);
+            return oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::CumSum, 2);
         }
     }
     else
@@ -15974,11 +17303,11 @@ bool oml_cumprod(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
     {
         if (nargin == 1)
         {
-            return oml_MatrixNUtil4(eval, inputs, outputs, oml_cumprod);
+            return oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::CumProd);
         }
         else
         {
-            return oml_MatrixNUtil4(eval, inputs, outputs, oml_cumprod, 2);
+            return oml_MatrixN_Reduce(eval, inputs, outputs, &hwMatrixN::CumProd, 2);
         }
     }
     else
@@ -16029,7 +17358,7 @@ bool oml_round(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 //------------------------------------------------------------------------------
 bool oml_sin(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
 {
-    if (!noConditionFunc(inputs, outputs, sin, hwComplex::sin))
+    if (!noConditionFunc(inputs, outputs, sin, hwComplex::sin, hwVectorMath::Sin))
     {
         return oml_MatrixNUtil1(eval, inputs, outputs, oml_sin);
     }
@@ -16041,7 +17370,7 @@ bool oml_sin(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 //------------------------------------------------------------------------------
 bool oml_cos(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
 {
-    if (!noConditionFunc(inputs, outputs, cos, hwComplex::cos))
+    if (!noConditionFunc(inputs, outputs, cos, hwComplex::cos, hwVectorMath::Cos))
     {
         return oml_MatrixNUtil1(eval, inputs, outputs, oml_cos);
     }
@@ -16202,7 +17531,7 @@ bool oml_log2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                 hwMatrix* fmtx = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
                 hwMatrix* emtx = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
                 int exp;
-                for (int i = 0; i < mtx->Size(); ++i)
+                for (int64_t i = 0; i < mtx->Size(); ++i)
                 {
                     (*fmtx)(i) = std::frexp(realval(mtx,i), &exp);
                     (*emtx)(i) = static_cast<double>(exp);
@@ -16215,7 +17544,7 @@ bool oml_log2(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
                 hwMatrix* fmtx = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::COMPLEX);
                 hwMatrix* emtx = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
                 int exp;
-                for (int i = 0; i < mtx->Size(); ++i)
+                for (int64_t i = 0; i < mtx->Size(); ++i)
                 {
                     const hwComplex& cplx = mtx->z(i);
                     int exp;
@@ -16261,7 +17590,7 @@ bool oml_log10(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 //------------------------------------------------------------------------------
 bool oml_log(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
 {
-    if (!conditionFunc(inputs, outputs, log, hwComplex::log, hwComplex::log_c, nonnegative))
+    if (!conditionFunc(inputs, outputs, log, hwComplex::log, hwComplex::log_c, nonnegative, hwVectorMath::Log))
     {
         return oml_MatrixNUtil1(eval, inputs, outputs, oml_log);
     }
@@ -16273,7 +17602,7 @@ bool oml_log(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::
 //------------------------------------------------------------------------------
 bool oml_sqrt(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
 {
-    if (!conditionFunc(inputs, outputs, sqrt, hwComplex::sqrt, hwComplex::sqrt_c, nonnegative))
+    if (!conditionFunc(inputs, outputs, sqrt, hwComplex::sqrt, hwComplex::sqrt_c, nonnegative, hwVectorMath::Sqrt))
     {
         return oml_MatrixNUtil1(eval, inputs, outputs, oml_sqrt);
     }
@@ -16526,7 +17855,7 @@ bool oml_clear(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 }
 bool oml_end(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs)
 {
-    outputs.push_back(eval.GetContextEndValue());
+    outputs.push_back(static_cast<double>(eval.GetContextEndValue()));
     return true;
 }
 //------------------------------------------------------------------------------
@@ -16888,8 +18217,8 @@ bool oml_meshgrid(EvaluatorInterface eval, const std::vector<Currency>& inputs,
             y = x_cur.ConvertToMatrix();
         }
 
-        int size1 = y->Size();
-        int size2 = x->Size();
+        int size1 = static_cast<int>(y->Size());
+        int size2 = static_cast<int>(x->Size());
 
         hwMatrix* result1 = EvaluatorInterface::allocateMatrix(size1, size2, hwMatrix::REAL);
         hwMatrix* result2 = EvaluatorInterface::allocateMatrix(size1, size2, hwMatrix::REAL);
@@ -17049,8 +18378,8 @@ bool oml_ndgrid(EvaluatorInterface eval, const std::vector<Currency>& inputs, st
             y = x_cur.ConvertToMatrix();
         }
 
-        int size1 = x->Size();
-        int size2 = y->Size();
+        int size1 = static_cast<int>(x->Size());
+        int size2 = static_cast<int>(y->Size());
 
         hwMatrix* result1 = EvaluatorInterface::allocateMatrix(size1, size2, hwMatrix::REAL);
         hwMatrix* result2 = EvaluatorInterface::allocateMatrix(size1, size2, hwMatrix::REAL);
@@ -17209,15 +18538,35 @@ bool oml_numel(EvaluatorInterface           eval,
     {
 		outputs.push_back(1);
     }
+    else if (input.IsPackedLogical())
+    {
+        outputs.push_back(static_cast<double>(input.MatrixB()->Size()));
+    }
     else if (input.IsMatrix())
     {
         const hwMatrix* mtx = input.Matrix();
-        outputs.push_back(mtx->Size());
+        outputs.push_back(static_cast<double>(mtx->Size()));
     }
     else if (input.IsNDMatrix())
     {
         const hwMatrixN* mtx = input.MatrixN();
-        outputs.push_back(mtx->Size());
+        outputs.push_back(static_cast<double>(mtx->Size()));
+    }
+    else if (input.IsSparse())
+    {
+        const hwMatrixS* mtx = input.MatrixS();
+        outputs.push_back(static_cast<double>(mtx->M()) * mtx->N());
+    }
+    else if (input.IsSingle())
+    {
+        const hwMatrixF* mtx = input.MatrixF();
+        outputs.push_back(static_cast<double>(mtx->Size()));
+    }
+    else if (input.IsIntegerType())
+    {
+        int m, n;
+        input.IntegerDims(m, n);
+        outputs.push_back(static_cast<double>(m) * n);
     }
 	else if (input.IsString())
 	{
@@ -17250,7 +18599,7 @@ bool oml_numel(EvaluatorInterface           eval,
 	else if (input.IsCellArray())
     {
         HML_CELLARRAY* cells = input.CellArray();
-        outputs.push_back(cells->Size());
+        outputs.push_back(static_cast<double>(cells->Size()));
     }
 	else if (input.IsStruct())
     {
@@ -17493,7 +18842,7 @@ void analyze_helper(EvaluatorInterface eval, const std::vector<std::string>& tar
 		HML_CELLARRAY* cells = result.CellArray();
 		std::vector<std::string> new_targets;
 
-		for (int k=0; k<cells->Size(); k++)
+		for (int64_t k=0; k<cells->Size(); k++)
 		{
 			std::string target = (*cells)(k).StringVal();
 
@@ -17924,7 +19273,8 @@ bool keywordFunc(const std::vector<Currency>& inputs, std::vector<Currency>& out
 // 
 //------------------------------------------------------------------------------
 bool noConditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, double (*realFunc)(double),
-    hwComplex (*cplxFunc)(const hwComplex&))
+    hwComplex (*cplxFunc)(const hwComplex&), void (*realArrayFunc)(int64_t, const double*, double*),
+    void (*cplxArrayFunc)(int64_t, const hwComplex*, hwComplex*))
 {
     if (inputs.size() != 1)
         throw OML_Error(OML_ERR_NUMARGIN);
@@ -17949,14 +19299,25 @@ bool noConditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>&
 
         if (mtx->IsReal())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            if (realArrayFunc)
             {
-                result->SetElement(k, (*realFunc)((*mtx)(k)));
+                (*realArrayFunc)(mtx->Size(), mtx->GetRealData(), result->GetRealData());
             }
+            else
+            {
+                for (int64_t k = 0; k < mtx->Size(); k++)
+                {
+                    result->SetElement(k, (*realFunc)((*mtx)(k)));
+                }
+            }
+        }
+        else if (cplxArrayFunc)
+        {
+            (*cplxArrayFunc)(mtx->Size(), mtx->GetComplexData(), result->GetComplexData());
         }
         else
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 hwComplex cplx = mtx->z(k);
                 result->SetElement(k, (*cplxFunc)(cplx));
@@ -17980,7 +19341,8 @@ bool noConditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>&
 // 
 //------------------------------------------------------------------------------
 bool conditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, double (*realFunc)(double),
-    hwTComplex<double> (*cplxFunc)(const hwComplex&), hwComplex (*cnvrtFunc)(double), bool (*conditionFunc)(double))
+    hwTComplex<double> (*cplxFunc)(const hwComplex&), hwComplex (*cnvrtFunc)(double), bool (*conditionFunc)(double),
+    void (*realArrayFunc)(int64_t, const double*, double*))
 {
     if (inputs.size() != 1)
         throw OML_Error(OML_ERR_NUMARGIN);
@@ -18015,9 +19377,24 @@ bool conditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& o
         const hwMatrix* mtx = input.Matrix();
         hwMatrix* result = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), mtx->Type());
 
-        if (mtx->IsReal())
+        bool realResult = mtx->IsReal() && realArrayFunc;
+
+        // the array function applies only if no element needs conversion
+        for (int k = 0; realResult && k < mtx->Size(); k++)
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            double dbl = (*mtx)(k);
+
+            if (!IsNaN_T(dbl) && !(*conditionFunc)(dbl))
+                realResult = false;
+        }
+
+        if (realResult)
+        {
+            (*realArrayFunc)(mtx->Size(), mtx->GetRealData(), result->GetRealData());
+        }
+        else if (mtx->IsReal())
+        {
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 double dbl = (*mtx)(k);
                 if (IsNaN_T(dbl))
@@ -18035,7 +19412,7 @@ bool conditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& o
         }
         else
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 hwComplex cplx = mtx->z(k);
                 if (IsNaN_T(cplx))
@@ -18090,14 +19467,14 @@ bool roundingFunc(const std::vector<Currency>& inputs, std::vector<Currency>& ou
 
         if (mtx->IsReal())
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 result->SetElement(k, (*roundFunc)((*mtx)(k)));
             }
         }
         else
         {
-            for (int k = 0; k < mtx->Size(); k++)
+            for (int64_t k = 0; k < mtx->Size(); k++)
             {
                 hwComplex cplx = mtx->z(k);
                 double real = (*roundFunc)(cplx.Real());
@@ -18174,7 +19551,7 @@ bool createCommonMatrix(EvaluatorInterface& eval, const std::vector<Currency>& i
             else if (input1.IsMatrix())
             {
                 const hwMatrix *mtx = input1.Matrix();
-                int matrixSize = mtx->Size();
+                int64_t matrixSize = mtx->Size();
                 if (!matrixSize)
                 {
                     throw OML_Error(OML_ERR_NATURALNUM, 1, OML_VAR_DIMS);
@@ -18231,6 +19608,19 @@ bool createCommonMatrix(EvaluatorInterface& eval, const std::vector<Currency>& i
         if (n < 0)
             n = 0;
 
+        if (m > std::numeric_limits<int>::max() || n > std::numeric_limits<int>::max() ||
+            m * n > static_cast<double>(std::numeric_limits<int64_t>::max() / sizeof(hwComplex)))
+            throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+        // logical values are stored as packed flags, one byte per element
+        if (newval.IsLogical())
+        {
+            hwMatrixB* flags = new hwMatrixB((int) m, (int) n, hwMatrixB::REAL);
+            flags->SetElements(newval.Scalar() != 0.0);
+            outputs.push_back(LogicalArray::FromFlags(flags));
+            return true;
+        }
+
         // now set all elements in new matrix
         hwMatrix *result;
         if (newval.IsScalar())
@@ -18258,7 +19648,7 @@ bool createCommonMatrix(EvaluatorInterface& eval, const std::vector<Currency>& i
         if (size == 1)
         {
             const hwMatrix* dimens = input1.Matrix();
-            int numDim = dimens->Size();
+            int numDim = static_cast<int>(dimens->Size());
 
             for (int j = 0; j < numDim; ++j)
             {
@@ -18506,7 +19896,7 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
         std::deque<std::string> avals, bvals, vals;
         if (acell)
         {
-            for (int i = 0; i < acell->Size(); ++i)
+            for (int64_t i = 0; i < acell->Size(); ++i)
             {
                 std::string str = readString((*acell)(i));
                 avals.push_back(str);
@@ -18524,7 +19914,7 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
 
         if (bcell)
         {
-            for (int i = 0; i < bcell->Size(); ++i)
+            for (int64_t i = 0; i < bcell->Size(); ++i)
             {
                 std::string str = readString((*bcell)(i));
                 bvals.push_back(str);
@@ -18667,12 +20057,12 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
         {
             std::deque<hwComplex> avals, bvals, vals;
 
-            for (int i = 0; i < a->Size(); i++)
+            for (int64_t i = 0; i < a->Size(); i++)
             {
                 avals.push_back(a->z(i));
             }
 
-            for (int i = 0; i < b->Size(); i++)
+            for (int64_t i = 0; i < b->Size(); i++)
             {
                 bvals.push_back(b->z(i));
             }
@@ -18691,7 +20081,7 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
                 {
                     hwComplex tofind = vals[i];
                     int j;
-                    for (j = b->Size() - 1; j >= 0; --j)
+                    for (j = static_cast<int>(b->Size()) - 1; j >= 0; --j)
                     {
                         if (b->z(j) == tofind)
                         {
@@ -18702,7 +20092,7 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
 
                     if (allowRepeatIndices || j == -1)
                     {
-                        for (j = a->Size() - 1; j >= 0; --j)
+                        for (j = static_cast<int>(a->Size()) - 1; j >= 0; --j)
                         {
                             if (a->z(j) == tofind)
                             {
@@ -18721,12 +20111,12 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
         {
             std::deque<double> avals, bvals, vals;
 
-            for (int i = 0; i < a->Size(); i++)
+            for (int64_t i = 0; i < a->Size(); i++)
             {
                 avals.push_back((*a)(i));
             }
 
-            for (int i = 0; i < b->Size(); i++)
+            for (int64_t i = 0; i < b->Size(); i++)
             {
                 bvals.push_back((*b)(i));
             }
@@ -18747,7 +20137,7 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
                 {
                     double tofind = vals[i];
                     int j;
-                    for (j = b->Size() - 1; j >= 0; --j)
+                    for (j = static_cast<int>(b->Size()) - 1; j >= 0; --j)
                     {
                         if ((*b)(j) == tofind)
                         {
@@ -18758,7 +20148,7 @@ bool sortBasedOperation(EvaluatorInterface &eval, const std::vector<Currency>& i
 
                     if (allowRepeatIndices || j == -1)
                     {
-                        for (j = a->Size() - 1; j >= 0; --j)
+                        for (j = static_cast<int>(a->Size()) - 1; j >= 0; --j)
                         {
                             if ((*a)(j) == tofind)
                             {
@@ -18806,14 +20196,14 @@ bool allowComplexToLogical(const std::vector<Currency>& inputs, std::vector<Curr
 
         if (mtx->IsRealData())
         {
-            for (int i = 0; i < mtx->Size(); ++i)
+            for (int64_t i = 0; i < mtx->Size(); ++i)
             {
                 (*out)(i) = (*checker)(realval(mtx, i));
             }
         }
         else
         {
-            for (int i = 0; i < mtx->Size(); ++i)
+            for (int64_t i = 0; i < mtx->Size(); ++i)
             {
                 const hwComplex& cplx = mtx->z(i);
                 if (complexBoth)
@@ -18836,14 +20226,14 @@ bool allowComplexToLogical(const std::vector<Currency>& inputs, std::vector<Curr
 
         if (mtx->IsRealData())
         {
-            for (int i = 0; i < mtx->Size(); ++i)
+            for (int64_t i = 0; i < mtx->Size(); ++i)
             {
                 (*out)(i) = (*checker)((*mtx)(i));
             }
         }
         else
         {
-            for (int i = 0; i < mtx->Size(); ++i)
+            for (int64_t i = 0; i < mtx->Size(); ++i)
             {
                 const hwComplex& cplx = mtx->z(i);
                 if (complexBoth)
@@ -19271,7 +20661,7 @@ void get1DStringsFromInput(const Currency& cur, std::vector<std::string>& vec)
         HML_CELLARRAY* cell = cur.CellArray();
         if (!isstr(cell))
             throw OML_Error(HW_ERROR_CELLELEMSTR);
-        for (int i = 0; i < cell->Size(); ++i)
+        for (int64_t i = 0; i < cell->Size(); ++i)
         {
             const Currency &elem = (*cell)(i);
             if (elem.Matrix()->M() != 1)
@@ -19296,7 +20686,7 @@ int getNumOutputs(const EvaluatorInterface &eval)
 //------------------------------------------------------------------------------
 hwMatrix* vectorToDiag(hwMatrix *mtx)
 {
-    int size = mtx->Size();
+    int size = static_cast<int>(mtx->Size());
     hwMatrix *result;
 
     if (mtx->IsReal())
@@ -19686,7 +21076,7 @@ bool rowVecLessThan(const hwMatrix *mtx1, const hwMatrix *mtx2)
 
     if (cplx1 || cplx2)
     {
-        for (int i = 0; i < mtx1->Size(); i++)
+        for (int64_t i = 0; i < mtx1->Size(); i++)
         {
             const hwComplex c1 = cplx1 ? mtx1->z(i) : hwComplex((*mtx1)(i), 0.0);
             const hwComplex c2 = cplx2 ? mtx2->z(i) : hwComplex((*mtx2)(i), 0.0);
@@ -19700,7 +21090,7 @@ bool rowVecLessThan(const hwMatrix *mtx1, const hwMatrix *mtx2)
     }
     else
     {
-        for (int i = 0; i < mtx1->Size(); i++)
+        for (int64_t i = 0; i < mtx1->Size(); i++)
         {
             double d1 = (*mtx1)(i), d2 = (*mtx2)(i);
             if (d1 == d2)
@@ -19784,7 +21174,7 @@ char escapeChar(char c)
 //------------------------------------------------------------------------------
 bool isstr(HML_CELLARRAY *cell)
 {
-    for (int i = 0; i < cell->Size(); i++)
+    for (int64_t i = 0; i < cell->Size(); i++)
         if (!(*cell)(i).IsString())
             return false;
     return true;
@@ -19802,7 +21192,7 @@ hwMatrix* tostr(EvaluatorInterface& eval, const hwMatrix *m, bool throwError)
     {
         if (m->IsRealData())
         {
-            for (int i = 0; i < m->Size(); i++)
+            for (int64_t i = 0; i < m->Size(); i++)
                 (*newm)(i) = (double) BuiltInFuncsUtils::GetValidChar(eval, realval(m, i), throwError);
         }
         else
@@ -19822,7 +21212,7 @@ hwMatrix* tostr(EvaluatorInterface& eval, HML_CELLARRAY *cell, bool throwError)
 {
     int m = 0, n = 0;
     std::vector<Currency> curVec;
-    for (int i = 0; i < cell->Size(); i++)
+    for (int64_t i = 0; i < cell->Size(); i++)
     {
         Currency &elem = (*cell)(i);
         elem = toCurrencyStr(eval, elem, throwError, false);
@@ -19844,7 +21234,7 @@ HML_CELLARRAY* tocellstr(EvaluatorInterface& eval, HML_CELLARRAY *c, bool throwE
     HML_CELLARRAY *strcell = EvaluatorInterface::allocateCellArray(c->M(), c->N());
     try
     {
-        for (int i = 0; i < c->Size(); i++)
+        for (int64_t i = 0; i < c->Size(); i++)
             (*strcell)(i) = toCurrencyStr(eval, (*c)(i), throwError, true);
     }
     catch (OML_Error& e)
@@ -19861,7 +21251,9 @@ HML_CELLARRAY* tocellstr(EvaluatorInterface& eval, HML_CELLARRAY *c, bool throwE
 Currency toCurrencyStr(EvaluatorInterface& eval, const Currency &c, bool throwError, bool keepcell)
 {
     hwMatrix *toreturn;
-    if (c.IsScalar())
+    if (c.IsPackedString())
+        return c;
+    else if (c.IsScalar())
         toreturn = EvaluatorInterface::allocateMatrix(1, 1, (double) BuiltInFuncsUtils::GetValidChar(eval, c.Scalar(), throwError));
     else if (c.IsMatrix())
         toreturn = tostr(eval, c.Matrix(), throwError);
@@ -19891,7 +21283,7 @@ std::string convertToLower(std::string str)
 hwMatrix* convertToLower(const hwMatrix *str)
 {
     hwMatrix *newstr = EvaluatorInterface::allocateMatrix(str->M(), str->N(), hwMatrix::REAL);
-    for (int i = 0; i < str->Size(); i++)
+    for (int64_t i = 0; i < str->Size(); i++)
         (*newstr)(i) = tolower((int) (*str)(i));
     return newstr;
 }
@@ -19901,7 +21293,7 @@ hwMatrix* convertToLower(const hwMatrix *str)
 hwMatrix* convertToUpper(const hwMatrix *str)
 {
     hwMatrix *newstr = EvaluatorInterface::allocateMatrix(str->M(), str->N(), hwMatrix::REAL);
-    for (int i = 0; i < str->Size(); i++)
+    for (int64_t i = 0; i < str->Size(); i++)
         (*newstr)(i) = toupper((int) (*str)(i));
     return newstr;
 }
@@ -19911,7 +21303,7 @@ hwMatrix* convertToUpper(const hwMatrix *str)
 HML_CELLARRAY* convertToUpper(const HML_CELLARRAY *cell)
 {
     HML_CELLARRAY *returnval = EvaluatorInterface::allocateCellArray(cell->M(), cell->N());
-    for (int i = 0; i < cell->Size(); i++)
+    for (int64_t i = 0; i < cell->Size(); i++)
     {
         (*returnval)(i) = convertToUpper((*cell)(i));
     }
@@ -19923,18 +21315,34 @@ HML_CELLARRAY* convertToUpper(const HML_CELLARRAY *cell)
 HML_CELLARRAY* convertToLower(const HML_CELLARRAY *cell)
 {
     HML_CELLARRAY *returnval = EvaluatorInterface::allocateCellArray(cell->M(), cell->N());
-    for (int i = 0; i < cell->Size(); i++)
+    for (int64_t i = 0; i < cell->Size(); i++)
     {
         (*returnval)(i) = convertToLower((*cell)(i));
     }
     return returnval;
 }
+//------------------------------------------------------------------------------
+// Converts the case of packed characters, giving a packed string
+//------------------------------------------------------------------------------
+static Currency convertCase(const hwMatrixC* chars, int (*convert)(int))
+{
+    hwMatrixC*  newstr = new hwMatrixC(chars->M(), chars->N(), hwMatrixC::REAL);
+    const char* src    = chars->GetRealData();
+    char*       dst    = newstr->GetRealData();
+
+    for (int64_t i = 0; i < chars->Size(); i++)
+        dst[i] = static_cast<char>(convert(static_cast<unsigned char>(src[i])));
+
+    return newstr;
+}
 //-----------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 Currency convertToUpper(const Currency &cur)
 {
-    if (cur.IsString())
+    if (cur.IsPackedString())
+        return convertCase(cur.MatrixC(), toupper);
+    else if (cur.IsString())
         return addStringMask(convertToUpper(cur.Matrix()));
     else if (cur.IsCellArray())
         return convertToUpper(cur.CellArray());
@@ -19946,7 +21354,9 @@ Currency convertToUpper(const Currency &cur)
 //------------------------------------------------------------------------------
 Currency convertToLower(const Currency &cur)
 {
-    if (cur.IsString())
+    if (cur.IsPackedString())
+        return convertCase(cur.MatrixC(), tolower);
+    else if (cur.IsString())
         return addStringMask(convertToLower(cur.Matrix()));
     else if (cur.IsCellArray())
         return convertToLower(cur.CellArray());
@@ -19972,7 +21382,7 @@ void cellAppendStr(EvaluatorInterface& eval, HML_CELLARRAY *outcell, const hwMat
 
     if (newstr->Size())
     {
-        for (int j = 0; j < outcell->Size(); j++)
+        for (int64_t j = 0; j < outcell->Size(); j++)
         {
             Currency &toappend = (*outcell)(j);
             toappend = hconcat(eval, toappend, holder);
@@ -20019,11 +21429,11 @@ hwMatrix* trimright(const hwMatrix *totrim)
 //------------------------------------------------------------------------------
 // returns whether the input was valid
 //------------------------------------------------------------------------------
-bool getSingularStringOrCell(Currency input, hwMatrix *&outstr, HML_CELLARRAY *&outcell, bool &usecell)
+bool getSingularStringOrCell(const Currency& input, const Currency *&outstr, HML_CELLARRAY *&outcell, bool &usecell)
 {
     if (input.IsString())
     {
-        outstr = input.GetWritableMatrix();
+        outstr = &input;
         usecell = false;
     }
     else if (input.IsCellArray())
@@ -20031,10 +21441,10 @@ bool getSingularStringOrCell(Currency input, hwMatrix *&outstr, HML_CELLARRAY *&
         HML_CELLARRAY *temp = input.CellArray();
         if (temp->Size() == 1)
         {
-            Currency c = (*temp)(0);
+            const Currency& c = (*temp)(0);
             if (c.IsString())
             {
-                outstr = c.GetWritableMatrix();
+                outstr = &c;
                 usecell = false;
             }
             else
@@ -20090,6 +21500,9 @@ void buildString(std::vector<Currency> vec, hwMatrix *str)
 //------------------------------------------------------------------------------
 std::string orderedStringVal(const Currency &cur)
 {
+    if (cur.IsPackedString())
+        return std::string(cur.MatrixC()->GetRealData(), cur.MatrixC()->Size());
+
     return orderedStringVal(cur.Matrix());
 }
 //------------------------------------------------------------------------------
@@ -20098,7 +21511,7 @@ std::string orderedStringVal(const Currency &cur)
 std::string orderedStringVal(const hwMatrix *strmtx)
 {
     std::string returnval;
-    for (int i = 0; i < strmtx->Size(); i++)
+    for (int64_t i = 0; i < strmtx->Size(); i++)
         returnval += (unsigned char) (*strmtx)(i);
     return returnval;
 }
@@ -20165,7 +21578,7 @@ Currency deblankHelper(EvaluatorInterface& eval, const Currency& cur)
         HML_CELLARRAY* cell = cur.CellArray();
         HML_CELLARRAY* result = EvaluatorInterface::allocateCellArray(cell->M(), cell->N());
         Currency out(result);
-        for (int i = 0; i < cell->Size(); ++i)
+        for (int64_t i = 0; i < cell->Size(); ++i)
         {
             (*result)(i) = deblankHelper(eval, (*cell)(i));
         }
@@ -20239,6 +21652,31 @@ bool _strncmpHelper(const hwMatrix *s1, const hwMatrix *s2, int n)
     return *s1 == *s2;
 }
 //------------------------------------------------------------------------------
+// if n is 0, a full comparison of the strings is used. Packed strings are
+// compared byte by byte.
+//------------------------------------------------------------------------------
+bool _strncmpHelper(const Currency& s1, const Currency& s2, int n)
+{
+    if (!s1.IsPackedString() || !s2.IsPackedString())
+        return _strncmpHelper(s1.Matrix(), s2.Matrix(), n);
+
+    const hwMatrixC* c1 = s1.MatrixC();
+    const hwMatrixC* c2 = s2.MatrixC();
+
+    if (n)
+    {
+        if (c1->Size() < n || c2->Size() < n)
+            return false;
+
+        return memcmp(c1->GetRealData(), c2->GetRealData(), n) == 0;
+    }
+
+    if (c1->M() != c2->M() || c1->N() != c2->N())
+        return false;
+
+    return memcmp(c1->GetRealData(), c2->GetRealData(), c1->Size()) == 0;
+}
+//------------------------------------------------------------------------------
 // if n is 0, does a full comparison
 //------------------------------------------------------------------------------
 bool dostrcmp(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, int n)
@@ -20249,7 +21687,7 @@ bool dostrcmp(const std::vector<Currency>& inputs, std::vector<Currency>& output
     bool cellInput1 = false;
     bool cellInput2 = false;
     HML_CELLARRAY *cell1, *cell2;
-    hwMatrix *str1, *str2;
+    const Currency *str1, *str2;
     if (!getSingularStringOrCell(input1, str1, cell1, cellInput1) || !getSingularStringOrCell(input2, str2, cell2, cellInput2))
     {
         outputs.push_back(getFalse());
@@ -20263,13 +21701,13 @@ bool dostrcmp(const std::vector<Currency>& inputs, std::vector<Currency>& output
             if (sameSize(cell1, cell2))
             {
                 hwMatrix *outmtx = EvaluatorInterface::allocateMatrix(cell1->M(), cell1->N(), hwMatrix::REAL);
-                for (int i = 0; i < outmtx->Size(); i++)
+                for (int64_t i = 0; i < outmtx->Size(); i++)
                 {
                     Currency cur1 = (*cell1)(i);
                     Currency cur2 = (*cell2)(i);
                     if (cur1.IsString() && cur2.IsString())
                     {
-                        (*outmtx)(i) = _strncmpHelper(cur1.Matrix(), cur2.Matrix(), n);
+                        (*outmtx)(i) = _strncmpHelper(cur1, cur2, n);
                     }
                     else
                     {
@@ -20287,12 +21725,12 @@ bool dostrcmp(const std::vector<Currency>& inputs, std::vector<Currency>& output
         else
         {
             hwMatrix *outmtx = EvaluatorInterface::allocateMatrix(cell1->M(), cell1->N(), hwMatrix::REAL);
-            for (int i = 0; i < outmtx->Size(); i++)
+            for (int64_t i = 0; i < outmtx->Size(); i++)
             {
                 Currency cur1 = (*cell1)(i);
                 if (cur1.IsString())
                 {
-                    (*outmtx)(i) = _strncmpHelper(cur1.Matrix(), str2, n);
+                    (*outmtx)(i) = _strncmpHelper(cur1, *str2, n);
                 }
                 else
                 {
@@ -20310,12 +21748,12 @@ bool dostrcmp(const std::vector<Currency>& inputs, std::vector<Currency>& output
         if (cellInput2)
         {
             hwMatrix *outmtx = EvaluatorInterface::allocateMatrix(cell2->M(), cell2->N(), hwMatrix::REAL);
-            for (int i = 0; i < outmtx->Size(); i++)
+            for (int64_t i = 0; i < outmtx->Size(); i++)
             {
                 Currency cur2 = (*cell2)(i);
                 if (cur2.IsString())
                 {
-                    (*outmtx)(i) = _strncmpHelper(str1, cur2.Matrix(), n);
+                    (*outmtx)(i) = _strncmpHelper(*str1, cur2, n);
                 }
                 else
                 {
@@ -20329,7 +21767,7 @@ bool dostrcmp(const std::vector<Currency>& inputs, std::vector<Currency>& output
         }
         else
         {
-            Currency out(_strncmpHelper(str1, str2, n));
+            Currency out(_strncmpHelper(*str1, *str2, n));
             out.SetMask(Currency::MASK_LOGICAL);
             outputs.push_back(out);
         }
@@ -20418,43 +21856,43 @@ Currency tripleCurrencyFunc(EvaluatorInterface& eval, const Currency &cur1, cons
         case 0:
             // no singular inputs
             output = EvaluatorInterface::allocateCellArray(searchCell->M(), searchCell->N());
-            for (int i = 0; i < output->Size(); i++)
+            for (int64_t i = 0; i < output->Size(); i++)
                 (*output)(i) = tripleCurrencyFunc(eval, (*searchCell)(i), (*patternCell)(i), (*replaceCell)(i), overlap, func);
             return output;
         case 1:
             // only first input is singular
             output = EvaluatorInterface::allocateCellArray(patternCell->M(), patternCell->N());
-            for (int i = 0; i < output->Size(); i++)
+            for (int64_t i = 0; i < output->Size(); i++)
                 (*output)(i) = tripleCurrencyFunc(eval, *firstSearch, (*patternCell)(i), (*replaceCell)(i), overlap, func);
             return output;
         case 2:
             // only second input is singular
             output = EvaluatorInterface::allocateCellArray(searchCell->M(), searchCell->N());
-            for (int i = 0; i < output->Size(); i++)
+            for (int64_t i = 0; i < output->Size(); i++)
                 (*output)(i) = tripleCurrencyFunc(eval, (*searchCell)(i), *firstPattern, (*replaceCell)(i), overlap, func);
             return output;
         case 3:
             // first and second inputs are singular
             output = EvaluatorInterface::allocateCellArray(replaceCell->M(), replaceCell->N());
-            for (int i = 0; i < output->Size(); i++)
+            for (int64_t i = 0; i < output->Size(); i++)
                 (*output)(i) = tripleCurrencyFunc(eval, *firstSearch, *firstPattern, (*replaceCell)(i), overlap, func);
             return output;
         case 4:
             // only third input is singular
             output = EvaluatorInterface::allocateCellArray(searchCell->M(), searchCell->N());
-            for (int i = 0; i < output->Size(); i++)
+            for (int64_t i = 0; i < output->Size(); i++)
                 (*output)(i) = tripleCurrencyFunc(eval, (*searchCell)(i), (*patternCell)(i), *firstReplace, overlap, func);
             return output;
         case 5:
             // first and third inputs are singular
             output = EvaluatorInterface::allocateCellArray(patternCell->M(), patternCell->N());
-            for (int i = 0; i < output->Size(); i++)
+            for (int64_t i = 0; i < output->Size(); i++)
                 (*output)(i) = tripleCurrencyFunc(eval, *firstSearch, (*patternCell)(i), *firstReplace, overlap, func);
             return output;
         case 6:
             // second and third inputs are singular
             output = EvaluatorInterface::allocateCellArray(searchCell->M(), searchCell->N());
-            for (int i = 0; i < output->Size(); i++)
+            for (int64_t i = 0; i < output->Size(); i++)
                 (*output)(i) = tripleCurrencyFunc(eval, (*searchCell)(i), *firstPattern, *firstReplace, overlap, func);
             return output;
         case 7:
@@ -20561,7 +21999,7 @@ void dostrcat(EvaluatorInterface& eval, Currency &out, HML_CELLARRAY *cell)
         HML_CELLARRAY *outcell = out.CellArray();
         if (sameSize(cell, outcell))
         {
-            for (int j = 0; j < cell->Size(); j++)
+            for (int64_t j = 0; j < cell->Size(); j++)
             {
                 Currency &newc = (*cell)(j);
                 Currency &oldc = (*outcell)(j);
@@ -20576,7 +22014,7 @@ void dostrcat(EvaluatorInterface& eval, Currency &out, HML_CELLARRAY *cell)
         const hwMatrix *strout = out.Matrix();
         HML_CELLARRAY *outcell = EvaluatorInterface::allocateCellArray(cell->M(), cell->N());
         Currency temp(outcell);
-        for (int j = 0; j < cell->Size(); j++)
+        for (int64_t j = 0; j < cell->Size(); j++)
         {
             Currency &toappend = (*cell)(j);
             if (toappend.IsCellArray())
@@ -20739,8 +22177,8 @@ void celldisp(EvaluatorInterface& eval,
 {
     if (cell->IsVector())
     {
-        int cellsize = cell->Size();
-        for (int i = 0; i < cellsize; ++i)
+        int64_t cellsize = cell->Size();
+        for (int64_t i = 0; i < cellsize; ++i)
         {
             std::string index("{");
             index += std::to_string(static_cast<long long>(i + 1)) + "}";
@@ -20803,7 +22241,7 @@ Currency doScalarToLogical(const Currency &cur, double (*checker)(double))
         {
             hwMatrix *m = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
 
-            for (int i = 0; i < mtx->Size(); i++)
+            for (int64_t i = 0; i < mtx->Size(); i++)
             {
                 (*m)(i) = (*checker)(realval(mtx, i));
             }
@@ -20821,7 +22259,7 @@ Currency doScalarToLogical(const Currency &cur, double (*checker)(double))
         HML_CELLARRAY *outcell = EvaluatorInterface::allocateCellArray(cell->M(), cell->N());
         Currency out(outcell);
 
-        for (int i = 0; i < outcell->Size(); i++)
+        for (int64_t i = 0; i < outcell->Size(); i++)
         {
             (*outcell)(i) = doScalarToLogical((*cell)(i), checker);
         }
@@ -20857,6 +22295,14 @@ bool isempty(const Currency &input)
     {
         return false;
     }
+    else if (input.IsPackedLogical())
+    {
+        return input.MatrixB()->IsEmpty();
+    }
+    else if (input.IsPackedString())
+    {
+        return input.MatrixC()->IsEmpty();
+    }
     else if (input.IsMatrix() || input.IsString())
     {
         if (input.Matrix())
@@ -21090,7 +22536,7 @@ void sleep(double sec)
 hwMatrix* makeRealCopy(const hwMatrix* cplxMtx)
 {
     hwMatrix *copy = EvaluatorInterface::allocateMatrix(cplxMtx->M(), cplxMtx->N(), hwMatrix::REAL);
-    for (int i = 0; i < cplxMtx->Size(); i++)
+    for (int64_t i = 0; i < cplxMtx->Size(); i++)
         (*copy)(i) = cplxMtx->z(i).Real();
     return copy;
 }
@@ -21120,6 +22566,10 @@ bool isActuallyReal(const Currency& cur)
         return cur.MatrixN()->IsRealData();
     else if (cur.IsComplex())
         return cur.Complex().Imag() == 0.0;
+    else if (cur.IsSingle())
+        return cur.MatrixF()->IsRealData();
+    else if (cur.IsIntegerType())
+        return true;
     return false;
 }
 //------------------------------------------------------------------------------
@@ -21127,7 +22577,28 @@ bool isActuallyReal(const Currency& cur)
 //------------------------------------------------------------------------------
 std::string readString(const Currency& str, int index)
 {
-    if (str.IsString())
+    if (str.IsPackedString())
+    {
+        const hwMatrixC* chars = str.MatrixC();
+        const char*      data  = chars->GetRealData();
+        int              m     = chars->M();
+
+        if (m == 1)
+            return (index == 0) ? std::string(data, chars->N()) : std::string();
+
+        std::string row;
+
+        if (index < m)
+        {
+            row.reserve(chars->N());
+
+            for (int i = 0; i < chars->N(); ++i)
+                row += data[i * m + index];
+        }
+
+        return row;
+    }
+    else if (str.IsString())
     {
         std::stringstream ss;
         const hwMatrix* mat = str.Matrix();
@@ -21447,7 +22918,7 @@ void getDimensionsFromInput(const std::vector<Currency> &inputs, int *m, int *n)
             else if (input1.IsMatrix())
             {
                 const hwMatrix *mtx = input1.Matrix();
-                int matrixSize = mtx->Size();
+                int64_t matrixSize = mtx->Size();
                 if (!matrixSize)
                 {
                     throw OML_Error(OML_ERR_NATURALNUM, 1, OML_VAR_DIMS);
@@ -21592,7 +23063,7 @@ bool isequal(const Currency &observed, const Currency &expected, const Currency&
                     {
                         if (o->IsReal())
                         {
-                            for (int i = 0; i < e->Size(); ++i)
+                            for (int64_t i = 0; i < e->Size(); ++i)
                             {
                                 if (tol_singular)
                                 {
@@ -21609,7 +23080,7 @@ bool isequal(const Currency &observed, const Currency &expected, const Currency&
                         }
                         else
                         {
-                            for (int i = 0; i < e->Size(); ++i)
+                            for (int64_t i = 0; i < e->Size(); ++i)
                             {
                                 if (tol_singular)
                                 {
@@ -21629,7 +23100,7 @@ bool isequal(const Currency &observed, const Currency &expected, const Currency&
                     {
                         if (o->IsReal())
                         {
-                            for (int i = 0; i < e->Size(); ++i)
+                            for (int64_t i = 0; i < e->Size(); ++i)
                             {
                                 if (tol_singular)
                                 {
@@ -21646,7 +23117,7 @@ bool isequal(const Currency &observed, const Currency &expected, const Currency&
                         }
                         else
                         {
-                            for (int i = 0; i < e->Size(); ++i)
+                            for (int64_t i = 0; i < e->Size(); ++i)
                             {
                                 if (tol_singular)
                                 {
@@ -22153,7 +23624,7 @@ Currency findUnsorted(std::deque<double> vals, const hwMatrix *searchin, bool fo
         for (int i = 0; i < valsize; i++)
         {
             double tofind = vals[i];
-            for (int j = 0; j < searchin->Size(); j++)
+            for (int64_t j = 0; j < searchin->Size(); j++)
             {
                 double temp = (*searchin)(j);
                 if (temp == tofind)
@@ -22169,7 +23640,7 @@ Currency findUnsorted(std::deque<double> vals, const hwMatrix *searchin, bool fo
         for (int i = 0; i < valsize; i++)
         {
             double tofind = vals[i];
-            for (int j = searchin->Size() - 1; j >= 0; j--)
+            for (int j = static_cast<int>(searchin->Size()) - 1; j >= 0; j--)
             {
                 double temp = (*searchin)(j);
                 if (temp == tofind)
@@ -22201,7 +23672,7 @@ Currency findUnsorted(std::deque<hwComplex> vals, const hwMatrix *searchin, bool
         for (int i = 0; i < valsize; i++)
         {
             hwComplex tofind = vals[i];
-            for (int j = 0; j < searchin->Size(); j++)
+            for (int64_t j = 0; j < searchin->Size(); j++)
             {
                 hwComplex temp = searchin->z(j);
                 if (temp == tofind)
@@ -22217,7 +23688,7 @@ Currency findUnsorted(std::deque<hwComplex> vals, const hwMatrix *searchin, bool
         for (int i = 0; i < valsize; i++)
         {
             hwComplex tofind = vals[i];
-            for (int j = searchin->Size() - 1; j >= 0; j--)
+            for (int j = static_cast<int>(searchin->Size()) - 1; j >= 0; j--)
             {
                 hwComplex temp = searchin->z(j);
                 if (temp == tofind)
@@ -22249,7 +23720,7 @@ Currency findUnsorted(EvaluatorInterface& eval, std::deque<std::string> vals, co
         for (int i = 0; i < valsize; i++)
         {
             std::string tofind = vals[i];
-            for (int j = 0; j < searchin->Size(); j++)
+            for (int64_t j = 0; j < searchin->Size(); j++)
             {
                 std::string temp = readString((*searchin)(j));
                 if (temp == tofind)
@@ -22265,7 +23736,7 @@ Currency findUnsorted(EvaluatorInterface& eval, std::deque<std::string> vals, co
         for (int i = 0; i < valsize; i++)
         {
             std::string tofind = vals[i];
-            for (int j = searchin->Size() - 1; j >= 0; j--)
+            for (int j = static_cast<int>(searchin->Size()) - 1; j >= 0; j--)
             {
                 std::string temp = readString((*searchin)(j));
                 if (temp == tofind)
@@ -22301,13 +23772,13 @@ Currency findSorted(std::deque<double> vals, const hwMatrix *searchin)
 {
     hwMatrix *outIndices;
     if (searchin->M() == 1)
-        outIndices = EvaluatorInterface::allocateMatrix(1, searchin->Size(), hwMatrix::REAL);
+        outIndices = EvaluatorInterface::allocateMatrix(1, static_cast<int>(searchin->Size()), hwMatrix::REAL);
     else
-        outIndices = EvaluatorInterface::allocateMatrix(searchin->Size(), 1, hwMatrix::REAL);
+        outIndices = EvaluatorInterface::allocateMatrix(static_cast<int>(searchin->Size()), 1, hwMatrix::REAL);
 
     Currency ret(outIndices);
 
-    for (int i = 0; i < searchin->Size(); i++)
+    for (int64_t i = 0; i < searchin->Size(); i++)
         (*outIndices)(i) = indexOf(vals, (*searchin)(i), false, true) + 1;
     return ret;
 }
@@ -22318,13 +23789,13 @@ Currency findSorted(std::deque<hwComplex> vals, const hwMatrix *searchin)
 {
     hwMatrix *outIndices;
     if (searchin->M() == 1)
-        outIndices = EvaluatorInterface::allocateMatrix(1, searchin->Size(), hwMatrix::REAL);
+        outIndices = EvaluatorInterface::allocateMatrix(1, static_cast<int>(searchin->Size()), hwMatrix::REAL);
     else
-        outIndices = EvaluatorInterface::allocateMatrix(searchin->Size(), 1, hwMatrix::REAL);
+        outIndices = EvaluatorInterface::allocateMatrix(static_cast<int>(searchin->Size()), 1, hwMatrix::REAL);
 
     Currency ret(outIndices);
 
-    for (int i = 0; i < searchin->Size(); i++)
+    for (int64_t i = 0; i < searchin->Size(); i++)
         (*outIndices)(i) = indexOf(vals, searchin->z(i), false, true) + 1;
     return ret;
 }
@@ -22335,13 +23806,13 @@ Currency findSorted(EvaluatorInterface& eval, std::deque<std::string> vals, cons
 {
     hwMatrix *outIndices;
     if (searchin->M() == 1)
-        outIndices = EvaluatorInterface::allocateMatrix(1, searchin->Size(), hwMatrix::REAL);
+        outIndices = EvaluatorInterface::allocateMatrix(1, static_cast<int>(searchin->Size()), hwMatrix::REAL);
     else
-        outIndices = EvaluatorInterface::allocateMatrix(searchin->Size(), 1, hwMatrix::REAL);
+        outIndices = EvaluatorInterface::allocateMatrix(static_cast<int>(searchin->Size()), 1, hwMatrix::REAL);
 
     Currency ret(outIndices);
 
-    for (int i = 0; i < searchin->Size(); i++)
+    for (int64_t i = 0; i < searchin->Size(); i++)
         (*outIndices)(i) = indexOf(vals, readString((*searchin)(i)), false, true) + 1;
     return ret;
 }
@@ -22461,7 +23932,7 @@ bool isfinite(hwMatrix *m)
 {
     if (m->IsReal())
     {
-        for (int i = 0; i < m->Size(); i++)
+        for (int64_t i = 0; i < m->Size(); i++)
         {
             if (!checkisfinite((*m)(i)))
                 return false;
@@ -22469,7 +23940,7 @@ bool isfinite(hwMatrix *m)
     }
     else
     {
-        for (int i = 0; i < m->Size(); i++)
+        for (int64_t i = 0; i < m->Size(); i++)
         {
             if (!isfinite(m->z(i)))
                 return false;
@@ -22505,7 +23976,7 @@ bool isint(const hwMatrix *mtx)
 {
     if (mtx->IsReal())
     {
-        for (int i = 0; i < mtx->Size(); i++)
+        for (int64_t i = 0; i < mtx->Size(); i++)
         {
             if (!isint((*mtx)(i)))
                 return false;
@@ -22514,7 +23985,7 @@ bool isint(const hwMatrix *mtx)
     }
     else
     {
-        for (int i = 0; i < mtx->Size(); i++)
+        for (int64_t i = 0; i < mtx->Size(); i++)
         {
             if (!isint(mtx->z(i)))
                 return false;
@@ -22546,7 +24017,7 @@ double realval(const hwMatrix* mtx, int i, int j)
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-double realval(const hwMatrix* mtx, int index)
+double realval(const hwMatrix* mtx, int64_t index)
 {
     return mtx->IsReal() ? (*mtx)(index) : mtx->z(index).Real();
 }
@@ -22562,7 +24033,7 @@ double realvalorscalar(const hwMatrix* mtx, int i, int j)
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-double realvalorscalar(const hwMatrix* mtx, int index)
+double realvalorscalar(const hwMatrix* mtx, int64_t index)
 {
     if (mtx->Size() == 1)
         return mtx->IsReal() ? (*mtx)(0) : mtx->z(0).Real();
@@ -22688,7 +24159,7 @@ hwMatrix* checkMatrixFinite(hwMatrix *m)
     hwMatrix *returnVal = EvaluatorInterface::allocateMatrix(m->M(), m->N(), hwMatrix::REAL);
     if (m->IsReal())
     {
-        for (int i = 0; i < m->Size(); i++)
+        for (int64_t i = 0; i < m->Size(); i++)
         {
             if (checkisfinite((*m)(i)))
                 (*returnVal)(i) = 1.0;
@@ -22698,7 +24169,7 @@ hwMatrix* checkMatrixFinite(hwMatrix *m)
     }
     else
     {
-        for (int i = 0; i < m->Size(); i++)
+        for (int64_t i = 0; i < m->Size(); i++)
         {
             if (isfinite(m->z(i)))
                 (*returnVal)(i) = 1.0;
@@ -22718,7 +24189,7 @@ bool cellArraysEqual(const HML_CELLARRAY *c1, const HML_CELLARRAY *c2, const Cur
 
     if (tol)
     {
-        for (int i = 0; i < c1->Size(); i++)
+        for (int64_t i = 0; i < c1->Size(); i++)
         {
             if (!isequal((*c1)(i), (*c2)(i), *tol))
                 return false;
@@ -22726,7 +24197,7 @@ bool cellArraysEqual(const HML_CELLARRAY *c1, const HML_CELLARRAY *c2, const Cur
     }
     else
     {
-        for (int i = 0; i < c1->Size(); i++)
+        for (int64_t i = 0; i < c1->Size(); i++)
         {
             if (!isequal((*c1)(i), (*c2)(i)))
                 return false;
@@ -22920,7 +24391,7 @@ void stringVecFromCurrency(EvaluatorInterface& eval, const Currency &input1, con
             tryPushBackStringByRows(eval, mtx, searchfor);
 
             HML_CELLARRAY *cell = input2.CellArray();
-            for (int i = 0; i < cell->Size(); i++)
+            for (int64_t i = 0; i < cell->Size(); i++)
             {
                 const Currency &elem = (*cell)(i);
                 if (elem.IsString())
@@ -22972,7 +24443,7 @@ void stringVecFromCurrency(EvaluatorInterface& eval, const Currency &input1, con
 //------------------------------------------------------------------------------
 void tryPushBackString(const HML_CELLARRAY *cell, std::vector<Currency> &topush)
 {
-    for (int i = 0; i < cell->Size(); i++)
+    for (int64_t i = 0; i < cell->Size(); i++)
     {
         const Currency &cur = (*cell)(i);
         if (cur.IsString())
@@ -22994,7 +24465,7 @@ void tryPushBackStringByRows(EvaluatorInterface& eval, const hwMatrix *mtx, std:
 //------------------------------------------------------------------------------
 void tryPushBackString(const hwMatrix *mtx, std::vector<Currency> &topush)
 {
-    for (int i = 0; i < mtx->Size(); i++)
+    for (int64_t i = 0; i < mtx->Size(); i++)
         topush.push_back((*mtx)(i));
 }
 //------------------------------------------------------------------------------
@@ -23082,7 +24553,7 @@ double all(EvaluatorInterface& eval, const hwMatrix* mtx)
 {
     if (mtx->IsReal())
     {
-        for (int i = 0; i < mtx->Size(); ++i)
+        for (int64_t i = 0; i < mtx->Size(); ++i)
         {
             if (iszero((*mtx)(i)))
                 return 0.0;
@@ -23091,7 +24562,7 @@ double all(EvaluatorInterface& eval, const hwMatrix* mtx)
     }
     else
     {
-        for (int i = 0; i < mtx->Size(); ++i)
+        for (int64_t i = 0; i < mtx->Size(); ++i)
         {
             if (iszero(mtx->z(i)))
                 return 0.0;
@@ -23106,7 +24577,7 @@ double any(EvaluatorInterface& eval, const hwMatrix* mtx)
 {
     if (mtx->IsReal())
     {
-        for (int i = 0; i < mtx->Size(); ++i)
+        for (int64_t i = 0; i < mtx->Size(); ++i)
         {
             if (!iszero((*mtx)(i)))
                 return 1.0;
@@ -23115,7 +24586,7 @@ double any(EvaluatorInterface& eval, const hwMatrix* mtx)
     }
     else
     {
-        for (int i = 0; i < mtx->Size(); ++i)
+        for (int64_t i = 0; i < mtx->Size(); ++i)
         {
             if (!iszero(mtx->z(i)))
                 return 1.0;
@@ -23135,7 +24606,7 @@ hwMatrix* sort(EvaluatorInterface& eval, const hwMatrix* vec, std::pair<int&, hw
 
     if (vec->IsReal())
     {
-        for (int i = 0; i < vec->Size(); ++i)
+        for (int64_t i = 0; i < vec->Size(); ++i)
         {
             if (IsNaN_T((*vec)(i)))
             {
@@ -23145,7 +24616,7 @@ hwMatrix* sort(EvaluatorInterface& eval, const hwMatrix* vec, std::pair<int&, hw
     }
     else
     {
-        for (int i = 0; i < vec->Size(); ++i)
+        for (int64_t i = 0; i < vec->Size(); ++i)
         {
             if (IsNaN_T(vec->z(i)))
             {
@@ -23173,7 +24644,7 @@ hwMatrix* sort(EvaluatorInterface& eval, const hwMatrix* vec, std::pair<int&, hw
 
     // create index vector
     std::vector<int> indexvec(vec->Size());
-    for (int i = 0 ; i < vec->Size(); ++i)
+    for (int64_t i = 0 ; i < vec->Size(); ++i)
         indexvec[i] = i;
 
     bool row = vec->M() == 1;
@@ -23415,7 +24886,7 @@ template <bool ASCEND>
 HML_CELLARRAY* sort(EvaluatorInterface& eval, const HML_CELLARRAY* cell, std::pair<int&, hwMatrix*>* index_data)
 {
     std::vector<hwMatrix*> rowvec;
-    for (int i = 0; i < cell->Size(); ++i)
+    for (int64_t i = 0; i < cell->Size(); ++i)
         rowvec.push_back(readRow(eval, (*cell)(i).Matrix()));
 
     std::vector<int> indexvec(rowvec.size());
@@ -24161,7 +25632,7 @@ bool GetRegExpOutput( EvaluatorInterface              eval,
             if (!sameSize(cell1, cell2))
                 throw OML_Error(HW_ERROR_CELLARRAYSSAMESIZE);
 
-            for (int i = 0; i < cell1->Size(); i++)
+            for (int64_t i = 0; i < cell1->Size(); i++)
             {
                 Currency elem1 = unnest((*cell1)(i), HW_ERROR_INPUTSTRINGCELLARRAY);
                 Currency elem2 = unnest((*cell2)(i), HW_ERROR_INPUTSTRINGCELLARRAY);
@@ -24185,7 +25656,7 @@ bool GetRegExpOutput( EvaluatorInterface              eval,
         }
         else
         {
-            for (int i = 0; i < cell1->Size(); i++)
+            for (int64_t i = 0; i < cell1->Size(); i++)
             {
                 Currency elem1 = unnest((*cell1)(i), HW_ERROR_INPUTSTRINGCELLARRAY);
                 if (!elem1.IsString())
@@ -24208,7 +25679,7 @@ bool GetRegExpOutput( EvaluatorInterface              eval,
     }
     else if (cell2)
     {
-        for (int i = 0; i < cell2->Size(); i++)
+        for (int64_t i = 0; i < cell2->Size(); i++)
         {
             Currency elem2 = unnest((*cell2)(i), HW_ERROR_INPUTSTRINGCELLARRAY);
             if (!elem2.IsString())
@@ -24648,11 +26119,11 @@ void UniqueHelperFuncCell(EvaluatorInterface&    eval,
         return;
     }
 
-    int cellsize = cell->Size();
+    int64_t cellsize = cell->Size();
     if (!isstr(cell)) throw OML_Error(HW_ERROR_FIELDNAMECELLSTR);
 
     std::deque<std::string> vals;
-    for (int i = 0; i < cellsize; ++i)
+    for (int64_t i = 0; i < cellsize; ++i)
         vals.push_back(readString((*cell)(i)));
     
     dounique(vals);
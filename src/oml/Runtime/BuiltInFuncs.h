@@ -38,6 +38,8 @@ bool oml_mlock(EvaluatorInterface eval, const std::vector<Currency>& inputs, std
 bool oml_munlock(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_mislocked(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_flintmax(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_intmax(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_intmin(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_subsasgn(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_subsref(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_fileparts(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
@@ -121,6 +123,16 @@ bool oml_sub2ind(EvaluatorInterface eval, const std::vector<Currency>& inputs, s
 bool oml_intersect(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_setdiff(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_setxor(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_single(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_int8(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_int16(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_int32(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_int64(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_uint8(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_uint16(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_uint32(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_uint64(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_isinteger(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_double(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_regexp(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_cell2struct(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
@@ -255,6 +267,11 @@ bool oml_eig(EvaluatorInterface, const std::vector<Currency>& inputs, std::vecto
 bool oml_chol(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_complex(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_transpose(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_sparse(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_full(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_nnz(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_issparse(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_decomposition(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_eye(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_sign(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_dot(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
@@ -269,6 +286,9 @@ bool oml_ones(EvaluatorInterface, const std::vector<Currency>& inputs, std::vect
 bool oml_zeros(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_trace(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_det(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_pagedet(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_pageinv(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
+bool oml_pageeig(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_rcond(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_mod(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
 bool oml_imag(EvaluatorInterface, const std::vector<Currency>& inputs, std::vector<Currency>& outputs);
@@ -349,8 +369,10 @@ bool dummycell(EvaluatorInterface,   const std::vector<Currency>&, std::vector<C
 // function replacement methods
 HML2DLL_DECLS void _OML_Error(EvaluatorInterface& eval, std::vector<Currency>::const_iterator start, std::vector<Currency>::const_iterator end);
 bool keywordFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, Currency val);
-HML2DLL_DECLS bool noConditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, double (*realFunc) (double), hwComplex (*cplxFunc)(const hwComplex&));
-bool conditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, double (*realFunc) (double), hwComplex (*cplxFunc)(const hwComplex&), hwComplex (*cnvrtFunc)(double), bool (*conditionFunc)(double));
+HML2DLL_DECLS bool noConditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, double (*realFunc) (double), hwComplex (*cplxFunc)(const hwComplex&),
+    void (*realArrayFunc)(int64_t, const double*, double*) = nullptr, void (*cplxArrayFunc)(int64_t, const hwComplex*, hwComplex*) = nullptr);
+bool conditionFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, double (*realFunc) (double), hwComplex (*cplxFunc)(const hwComplex&), hwComplex (*cnvrtFunc)(double), bool (*conditionFunc)(double),
+    void (*realArrayFunc)(int64_t, const double*, double*) = nullptr);
 bool roundingFunc(const std::vector<Currency>& inputs, std::vector<Currency>& outputs, double (*roundFunc) (double));
 bool createCommonMatrix(EvaluatorInterface& eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs, Currency newval);
 bool createCommonNDMatrix(EvaluatorInterface& eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs, Currency newval);
@@ -558,7 +580,7 @@ Currency convertToLower(const Currency &cur);
 std::vector<Currency> convertToLower(const std::vector<Currency>::const_iterator start, const std::vector<Currency>::const_iterator end);
 void cellAppendStr(EvaluatorInterface& eval, HML_CELLARRAY *outcell, const hwMatrix *newstr, bool throwError);
 hwMatrix* trimright(const hwMatrix *totrim);
-bool getSingularStringOrCell(Currency input, hwMatrix *&outstr, HML_CELLARRAY *&outcell, bool &usecell);
+bool getSingularStringOrCell(const Currency& input, const Currency *&outstr, HML_CELLARRAY *&outcell, bool &usecell);
 void buildString(std::vector<Currency> vec, hwMatrix *str);
 std::string orderedStringVal(const Currency &cur);
 std::string orderedStringVal(const hwMatrix *strmtx);
@@ -650,9 +672,9 @@ HML2DLL_DECLS bool isint(const hwMatrix *mtx);
 HML2DLL_DECLS bool isinfinity(double d);
 HML2DLL_DECLS bool isfinite(double d);
 HML2DLL_DECLS double realval(const hwMatrix*, int i, int j);
-HML2DLL_DECLS double realval(const hwMatrix*, int index);
+HML2DLL_DECLS double realval(const hwMatrix*, int64_t index);
 HML2DLL_DECLS double realvalorscalar(const hwMatrix* mtx, int i, int j);
-HML2DLL_DECLS double realvalorscalar(const hwMatrix* mtx, int index);
+HML2DLL_DECLS double realvalorscalar(const hwMatrix* mtx, int64_t index);
 
 // path-related helpers
 //!
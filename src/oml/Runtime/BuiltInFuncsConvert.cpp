@@ -132,7 +132,7 @@ std::vector<std::string> BuiltInFuncsConvert::Dec2HexHelper(const hwMatrix* mtx,
 //------------------------------------------------------------------------------
 std::vector<std::string> BuiltInFuncsConvert::Dec2HexHelper(HML_CELLARRAY* cell, int width)
 {
-    int numelem = cell ? cell->Size() : 0;
+    int64_t numelem = cell ? cell->Size() : 0;
 
     std::vector <std::string> hexstrings;
     if (numelem == 0)
@@ -142,7 +142,7 @@ std::vector<std::string> BuiltInFuncsConvert::Dec2HexHelper(HML_CELLARRAY* cell,
     }
     
     hexstrings.reserve(numelem);
-    for (int i = 0; i < numelem; ++i)
+    for (int64_t i = 0; i < numelem; ++i)
     {
         Currency    cur ((*cell)(i));
         
@@ -221,10 +221,10 @@ Currency BuiltInFuncsConvert::Hex2DecHelper(EvaluatorInterface& eval,
     else if (input.IsCellArray())
     {
         HML_CELLARRAY* cell = input.CellArray();
-        int            rows = cell ? cell->Size() : 0;
+        int64_t        rows = cell ? cell->Size() : 0;
         hexStr.reserve(rows);
 
-        for (int i = 0; i < rows; ++i)
+        for (int64_t i = 0; i < rows; ++i)
         {
             Currency cur ((*cell)(i));
         
@@ -361,13 +361,13 @@ std::vector<std::string> BuiltInFuncsConvert::Dec2BinHelper(const hwMatrix* mtx,
 //------------------------------------------------------------------------------
 std::vector<std::string> BuiltInFuncsConvert::Dec2BinHelper(HML_CELLARRAY* cell, int width)
 {
-    int numelem = cell ? cell->Size() : 0;
+    int64_t numelem = cell ? cell->Size() : 0;
 
     std::vector <std::string> outstr;
     if (numelem == 0) return outstr; // Should never get into this situation
     
     outstr.reserve(numelem);
-    for (int i = 0; i < numelem; ++i)
+    for (int64_t i = 0; i < numelem; ++i)
     {
         Currency    cur ((*cell)(i));
         
@@ -444,10 +444,10 @@ Currency BuiltInFuncsConvert::Bin2DecHelper(EvaluatorInterface& eval,
     else if (input.IsCellArray())
     {
         HML_CELLARRAY* cell = input.CellArray();
-        int            rows = cell ? cell->Size() : 0;
+        int64_t        rows = cell ? cell->Size() : 0;
         outstr.reserve(rows);
 
-        for (int i = 0; i < rows; ++i)
+        for (int64_t i = 0; i < rows; ++i)
         {
             Currency cur ((*cell)(i));
         
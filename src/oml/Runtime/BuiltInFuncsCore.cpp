@@ -244,9 +244,9 @@ int BuiltInFuncsCore::GetsBytesUsed(const Currency& cur) const
         HML_CELLARRAY *cell = cur.CellArray();
         if (!cell) return 0;
 
-        int sz    = cell->Size();
+        int64_t sz    = cell->Size();
         int bytes = 0;
-        for (int i = 0; i < sz; ++i)
+        for (int64_t i = 0; i < sz; ++i)
             bytes += funcs.GetsBytesUsed((*cell)(i));
         
         return bytes;
@@ -519,12 +519,24 @@ std::string BuiltInFuncsCore::GetCurrencyClass(const Currency& cur) const
     else if (cur.IsComplex())
         return "double";
 
+    else if (cur.IsPackedLogical())
+        return "logical";
+
     else if (cur.IsMatrix())
         return (cur.IsLogical() ? "logical" : "double");
 
     else if  (cur.IsNDMatrix())
         return (cur.IsLogical() ? "logical" : "double");
 
+    else if (cur.IsSingle())
+        return "single";
+
+    else if (cur.IsDecomposition())
+        return "decomposition";
+
+    else if (cur.IsIntegerType())
+        return cur.IntegerClass();
+
     else if (cur.IsFunctionHandle())
         return "function_handle";
     
@@ -572,6 +584,16 @@ bool BuiltInFuncsCore::IsA(EvaluatorInterface eval, const std::vector<Currency>&
 		if ((target_class == "numeric") || (target_class == "float"))
 			val.ReplaceScalar(1.0);
 	}
+	else if (obj.IsSingle())
+	{
+		if ((target_class == "numeric") || (target_class == "float") || (target_class == "single"))
+			val.ReplaceScalar(1.0);
+	}
+	else if (obj.IsIntegerType())
+	{
+		if ((target_class == "numeric") || (target_class == "integer") || (target_class == obj.IntegerClass()))
+			val.ReplaceScalar(1.0);
+	}
 		
 	outputs.push_back(val);
 
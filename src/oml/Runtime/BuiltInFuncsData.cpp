@@ -213,7 +213,7 @@ std::pair<int, int> BuiltInFuncsData::GetFieldIndex(const Currency& in, int idx)
     HML_CELLARRAY* cell = in.CellArray();
     assert(cell);
 
-    int cellsize = cell->Size();
+    int64_t cellsize = cell->Size();
     if (cellsize == 0 || cellsize > 2)
         throw OML_Error(OML_ERR_INVALIDSTRUCTINDEX, idx + 1, OML_VAR_TYPE);
 
@@ -123,12 +123,12 @@ void BuiltInFuncsString::StrvcatHelperCellArray(EvaluatorInterface        eval,
                                                 int                       index,
                                                 std::vector<std::string>& out)
 {
-    int numelem = cell ? cell->Size() : 0;
+    int64_t numelem = cell ? cell->Size() : 0;
 
     std::vector <std::string> outstr;
     if (numelem == 0) return; // Should never get into this situation
 
-    for (int i = 0; i < numelem; ++i)
+    for (int64_t i = 0; i < numelem; ++i)
     {
         Currency cur ((*cell)(i));
         StrvcatHelper(eval, cur, index, out);
@@ -183,11 +183,21 @@ bool BuiltInFuncsString::hml_strtok(EvaluatorInterface           eval,
     const Currency& input1 = inputs[0];
     if (!input1.IsString()) throw OML_Error(OML_ERR_STRING, 1, OML_VAR_TYPE);
 
-    const hwMatrix* strmtx = input1.Matrix();
-    if (!strmtx || !strmtx->IsVector()) 
-        throw OML_Error(OML_ERR_STRING_ONEDIMENSION, 1, OML_VAR_TYPE);
-
-    bool horiz = (strmtx->M() == 1); // Determines dimensions of outputs
+    bool horiz = false; // Determines dimensions of outputs
+    if (input1.IsPackedString())
+    {
+        const hwMatrixC* chars = input1.MatrixC();
+        if (!chars->IsVector())
+            throw OML_Error(OML_ERR_STRING_ONEDIMENSION, 1, OML_VAR_TYPE);
+        horiz = (chars->M() == 1);
+    }
+    else
+    {
+        const hwMatrix* strmtx = input1.Matrix();
+        if (!strmtx || !strmtx->IsVector()) 
+            throw OML_Error(OML_ERR_STRING_ONEDIMENSION, 1, OML_VAR_TYPE);
+        horiz = (strmtx->M() == 1);
+    }
     
     // Get the delimiter
     std::string delim;
@@ -210,10 +220,10 @@ bool BuiltInFuncsString::hml_strtok(EvaluatorInterface           eval,
         {
             const hwMatrix *m = input2.Matrix();
             assert(m);
-            int numelem = m->Size();
+            int64_t numelem = m->Size();
             bool isreal = m->IsReal();
 
-            for (int i = 0; i < numelem; ++i)
+            for (int64_t i = 0; i < numelem; ++i)
             {
                 if (isreal)
                     delim += BuiltInFuncsUtils::GetValidChar(eval, (*m)(i));
@@ -266,38 +276,33 @@ bool BuiltInFuncsString::hml_strtok(EvaluatorInterface           eval,
         str.erase(str.begin());
     }
 
-    Currency tmp(str);
-    const hwMatrix* mtx = tmp.Matrix();
-        
     size_t i = str.find_first_of(delim);
     if (i == std::string::npos)
     {
-        outputs.push_back(tmp);
+        outputs.push_back(str);
         outputs.push_back(std::string());
         return true;
     }
 
-    int len     = static_cast<int>(str.length());
-    int rowsTok = 1;
-    int rowsRem = 1;
-    int colsTok = static_cast<int>(i);
-    int colsRem = len - static_cast<int>(i);
-    if (!horiz)
+    if (horiz)  // Row vector tokens are stored one byte per character
     {
-        rowsTok = static_cast<int>(i);
-        rowsRem = len - static_cast<int>(i);
-        colsTok = 1;
-        colsRem = 1;
+        outputs.push_back(str.substr(0, i));
+        outputs.push_back(str.substr(i));
+        return true;
     }
 
-    hwMatrix* tok = EvaluatorInterface::allocateMatrix(rowsTok, colsTok, hwMatrix::REAL);
-    hwMatrix* rem = EvaluatorInterface::allocateMatrix(rowsRem, colsRem, hwMatrix::REAL);   
+    int len     = static_cast<int>(str.length());
+    int rowsTok = static_cast<int>(i);
+    int rowsRem = len - static_cast<int>(i);
+
+    hwMatrix* tok = EvaluatorInterface::allocateMatrix(rowsTok, 1, hwMatrix::REAL);
+    hwMatrix* rem = EvaluatorInterface::allocateMatrix(rowsRem, 1, hwMatrix::REAL);   
 
-    for (int j = 0; j < i; ++j)
-        (*tok)(j) = (double) (*mtx)(j);
+    for (int j = 0; j < rowsTok; ++j)
+        (*tok)(j) = static_cast<unsigned char>(str[j]);
 
-    for (int j = static_cast<int>(i); j < mtx->Size(); ++j)
-        (*rem)(j - (const int)i) = (double) (*mtx)(j);
+    for (int j = 0; j < rowsRem; ++j)
+        (*rem)(j) = static_cast<unsigned char>(str[j + rowsTok]);
 
     Currency out1(tok);
     out1.SetMask(Currency::MASK_STRING);
@@ -405,6 +410,21 @@ bool BuiltInFuncsString::ToAscii(EvaluatorInterface           eval,
         return true;
     }
 
+    if (input.IsPackedString())
+    {
+        const hwMatrixC* chars = input.MatrixC();
+        const char*      src   = chars->GetRealData();
+        int64_t          size  = chars->Size();
+
+        hwMatrix* out = EvaluatorInterface::allocateMatrix(chars->M(), chars->N(), hwMatrix::REAL);
+        double*   dst = out->GetRealData();
+        for (int64_t i = 0; i < size; ++i)
+            dst[i] = static_cast<unsigned char>(src[i]);
+
+        outputs.push_back(out);
+        return true;
+    }
+
 	const hwMatrix* in_mat = input.Matrix();
     assert(in_mat);
     int m = in_mat->M();
@@ -446,12 +466,34 @@ Currency BuiltInFuncsString::StrtrimHelper(EvaluatorInterface& eval,
     {
         HML_CELLARRAY* cell     = cur.CellArray();
         HML_CELLARRAY* result   = EvaluatorInterface::allocateCellArray(cell->M(), cell->N());
-        int            cellsize = cell->Size();
-        for (int i = 0; i < cellsize; ++i)
+        int64_t        cellsize = cell->Size();
+        for (int64_t i = 0; i < cellsize; ++i)
             (*result)(i) = BuiltInFuncsString::StrtrimHelper(eval, (*cell)(i));
         return Currency(result);
     }
     
+    // Single row strings are trimmed without leaving byte storage
+    if (cur.IsPackedString() && cur.MatrixC()->M() == 1)
+    {
+        const hwMatrixC* chars = cur.MatrixC();
+        const char*      src   = chars->GetRealData();
+        int              first = 0;
+        int              last  = chars->N();
+
+        while (first < last && isspace(static_cast<unsigned char>(src[first])))
+            ++first;
+        while (last > first && isspace(static_cast<unsigned char>(src[last - 1])))
+            --last;
+
+        if (first == last)
+        {
+            Currency out(EvaluatorInterface::allocateMatrix());
+            out.SetMask(Currency::MASK_STRING);
+            return out;
+        }
+        return Currency(std::string(src + first, last - first));
+    }
+
     // Process strings
     const hwMatrix* str = cur.Matrix();
     int minpos = str->N() - 1;
@@ -821,7 +863,7 @@ std::vector<std::string> BuiltInFuncsString::Currency2StringVec(const Currency&
 
     HML_CELLARRAY *cell = cur.CellArray();
     assert(cell);
-    int numelem = cell->Size();
+    int64_t numelem = cell->Size();
     out.reserve(numelem);
     int numrows = cell->M();
     int numcols = cell->N();
@@ -39,6 +39,11 @@
 #include "OML_Error.h"
 #include "StructData.h"
 
+#include "hwBlasBackend.h"
+#include "hwMemoryPool.h"
+#include "hwSolverPath.h"
+#include "hwThreadPool.h"
+
 // End defines/includes
 
 //------------------------------------------------------------------------------
@@ -652,3 +657,167 @@ bool BuiltInFuncsSystem::CloneEnv(EvaluatorInterface           eval,
     outputs.push_back(newenv);
 	return true;
 }
+//------------------------------------------------------------------------------
+// Returns true after getting or loading the BLAS/LAPACK backend [blas]
+//------------------------------------------------------------------------------
+bool BuiltInFuncsSystem::Blas(EvaluatorInterface           eval,
+                              const std::vector<Currency>& inputs, 
+                              std::vector<Currency>&       outputs)
+{
+    if (inputs.size() > 1)
+    {
+        throw OML_Error(OML_ERR_NUMARGIN);
+    }
+
+    if (!inputs.empty())
+    {
+        if (!inputs[0].IsString())
+        {
+            throw OML_Error(OML_ERR_STRING, 1, OML_VAR_TYPE);
+        }
+        std::string lib (inputs[0].StringVal());
+        if (!hwBlasBackend::Load(lib))
+        {
+            throw OML_Error("Error: cannot load BLAS library '" + lib + "'");
+        }
+    }
+
+    outputs.push_back(hwBlasBackend::GetName());
+    outputs.push_back(hwBlasBackend::GetLibrary());
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns true after getting or setting BLAS/LAPACK threads [blasthreads]
+//------------------------------------------------------------------------------
+bool BuiltInFuncsSystem::BlasThreads(EvaluatorInterface           eval,
+                                     const std::vector<Currency>& inputs, 
+                                     std::vector<Currency>&       outputs)
+{
+    if (inputs.size() > 1)
+    {
+        throw OML_Error(OML_ERR_NUMARGIN);
+    }
+
+    if (!inputs.empty())
+    {
+        if (!inputs[0].IsPositiveInteger())
+        {
+            throw OML_Error(OML_ERR_POSINTEGER, 1, OML_VAR_VALUE);
+        }
+        int numThreads = static_cast<int>(inputs[0].Scalar());
+        if (!hwBlasBackend::SetNumThreads(numThreads))
+        {
+            BuiltInFuncsUtils::SetWarning(eval, "Warning: BLAS backend '" +
+                hwBlasBackend::GetName() + "' does not support multiple threads");
+        }
+    }
+
+    outputs.push_back(hwBlasBackend::GetNumThreads());
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns true and gets matrix memory pool counters [mempoolstats]
+//------------------------------------------------------------------------------
+bool BuiltInFuncsSystem::MemPoolStats(EvaluatorInterface           eval,
+                                      const std::vector<Currency>& inputs, 
+                                      std::vector<Currency>&       outputs)
+{
+    if (inputs.size() > 1)
+    {
+        throw OML_Error(OML_ERR_NUMARGIN);
+    }
+
+    if (!inputs.empty())
+    {
+        if (!inputs[0].IsString())
+        {
+            throw OML_Error(OML_ERR_STRING, 1, OML_VAR_TYPE);
+        }
+        std::string opt (inputs[0].StringVal());
+        if (opt != "trim")
+        {
+            throw OML_Error(OML_ERR_OPTION, 1, OML_VAR_VALUE);
+        }
+        hwMemoryPool::Trim();
+    }
+
+    hwMemoryPool::Stats stats = hwMemoryPool::GetStats();
+
+    StructData* sd = new StructData();
+    sd->SetValue(0, 0, "allocations",  static_cast<double>(stats.allocations));
+    sd->SetValue(0, 0, "poolhits",     static_cast<double>(stats.poolHits));
+    sd->SetValue(0, 0, "systemallocs", static_cast<double>(stats.systemAllocs));
+    sd->SetValue(0, 0, "frees",        static_cast<double>(stats.frees));
+    sd->SetValue(0, 0, "bytesinuse",   static_cast<double>(stats.bytesInUse));
+    sd->SetValue(0, 0, "peakbytes",    static_cast<double>(stats.peakBytesInUse));
+    sd->SetValue(0, 0, "bytescached",  static_cast<double>(stats.bytesCached));
+
+    outputs.push_back(sd);
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns true after getting or setting elementwise math threads [maththreads]
+//------------------------------------------------------------------------------
+bool BuiltInFuncsSystem::MathThreads(EvaluatorInterface           eval,
+                                     const std::vector<Currency>& inputs, 
+                                     std::vector<Currency>&       outputs)
+{
+    size_t nargin = inputs.size();
+    if (nargin > 3)
+    {
+        throw OML_Error(OML_ERR_NUMARGIN);
+    }
+
+    // An empty matrix leaves a setting unchanged
+    for (size_t i = 0; i < nargin && i < 2; ++i)
+    {
+        const Currency& cur = inputs[i];
+        if (cur.IsEmpty())
+        {
+            continue;
+        }
+        if (!cur.IsScalar() || !(cur.Scalar() == 0.0 || cur.IsPositiveInteger()))
+        {
+            throw OML_Error(OML_ERR_NATURALNUM, static_cast<int>(i + 1), OML_VAR_VALUE);
+        }
+    }
+    if (nargin > 2 && !inputs[2].IsEmpty())
+    {
+        const Currency& cur = inputs[2];
+        if (!cur.IsScalar() || (cur.Scalar() != 0.0 && cur.Scalar() != 1.0))
+        {
+            throw OML_Error(OML_ERR_FLAG_01, 3, OML_VAR_VALUE);
+        }
+        hwThreadPool::SetDeterministic(cur.Scalar() == 1.0);
+    }
+    if (nargin > 1 && !inputs[1].IsEmpty())
+    {
+        double threshold = inputs[1].Scalar();
+        hwThreadPool::SetThreshold(threshold < INT_MAX ?
+            static_cast<int>(threshold) : INT_MAX);
+    }
+    if (nargin > 0 && !inputs[0].IsEmpty())
+    {
+        hwThreadPool::SetNumThreads(static_cast<int>(inputs[0].Scalar()));
+    }
+
+    outputs.push_back(hwThreadPool::GetNumThreads());
+    outputs.push_back(hwThreadPool::GetThreshold());
+    outputs.push_back(hwThreadPool::IsDeterministic());
+    return true;
+}
+//------------------------------------------------------------------------------
+// Returns true and gets the solvers used by the last matrix division [solverpath]
+//------------------------------------------------------------------------------
+bool BuiltInFuncsSystem::SolverPath(EvaluatorInterface           eval,
+                                    const std::vector<Currency>& inputs, 
+                                    std::vector<Currency>&       outputs)
+{
+    if (!inputs.empty())
+    {
+        throw OML_Error(OML_ERR_NUMARGIN);
+    }
+
+    outputs.push_back(hwSolverPath::Get());
+    return true;
+}
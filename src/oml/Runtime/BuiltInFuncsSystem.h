@@ -76,6 +76,51 @@ public:
     static bool Delete(EvaluatorInterface           eval,
                        const std::vector<Currency>& inputs, 
                        std::vector<Currency>&       outputs);    
+    //!
+    //! Returns true after getting or loading the BLAS/LAPACK backend [blas]
+    //! \param eval    Evaluator interface
+    //! \param inputs  Vector of inputs
+    //! \param outputs Vector of outputs
+    //!
+    static bool Blas(EvaluatorInterface           eval,
+                     const std::vector<Currency>& inputs, 
+                     std::vector<Currency>&       outputs);    
+    //!
+    //! Returns true after getting or setting BLAS/LAPACK threads [blasthreads]
+    //! \param eval    Evaluator interface
+    //! \param inputs  Vector of inputs
+    //! \param outputs Vector of outputs
+    //!
+    static bool BlasThreads(EvaluatorInterface           eval,
+                            const std::vector<Currency>& inputs, 
+                            std::vector<Currency>&       outputs);    
+    //!
+    //! Returns true and gets matrix memory pool counters [mempoolstats]
+    //! \param eval    Evaluator interface
+    //! \param inputs  Vector of inputs
+    //! \param outputs Vector of outputs
+    //!
+    static bool MemPoolStats(EvaluatorInterface           eval,
+                             const std::vector<Currency>& inputs, 
+                             std::vector<Currency>&       outputs);    
+    //!
+    //! Returns true after getting or setting elementwise math threads [maththreads]
+    //! \param eval    Evaluator interface
+    //! \param inputs  Vector of inputs
+    //! \param outputs Vector of outputs
+    //!
+    static bool MathThreads(EvaluatorInterface           eval,
+                            const std::vector<Currency>& inputs, 
+                            std::vector<Currency>&       outputs);    
+    //!
+    //! Returns true and gets the solvers used by the last matrix division [solverpath]
+    //! \param eval    Evaluator interface
+    //! \param inputs  Vector of inputs
+    //! \param outputs Vector of outputs
+    //!
+    static bool SolverPath(EvaluatorInterface           eval,
+                           const std::vector<Currency>& inputs, 
+                           std::vector<Currency>&       outputs);    
 
     // Client specific environment functions
     //!
@@ -207,6 +207,12 @@ unsigned char BuiltInFuncsUtils::GetValidChar(EvaluatorInterface& eval,
 //------------------------------------------------------------------------------
 std::string BuiltInFuncsUtils::GetOrderedStringVal(const Currency& cur)
 {
+    if (cur.IsPackedString())
+    {
+        const hwMatrixC* chars = cur.MatrixC();
+        return std::string(chars->GetRealData(), chars->Size());
+    }
+
     const hwMatrix* strmtx = cur.Matrix();
     if (!strmtx) return "";
 
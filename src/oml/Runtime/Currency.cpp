@@ -19,6 +19,7 @@
 #include "FunctionInfo.h"
 #include "CellDisplay.h"
 #include "CurrencyDisplay.h"
+#include "Decomposition.h"
 #include "MatrixDisplay.h"
 #include "MatrixNDisplay.h"
 #include "OutputFormat.h"
@@ -28,15 +29,56 @@
 #include "GeneralFuncs.h"
 
 #include "hwMatrixN.h"
+#include "hwMatrixS.h"
+#include "hwMatrix.h"
+#include "IntegerArithmetic.h"
 
 #include <cassert>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
+#include <unordered_map>
 
 #ifndef OS_WIN
 #define sprintf_s sprintf
 #endif
 
+//------------------------------------------------------------------------------
+//! Adds or releases a reference to an integer matrix, deleting it when the
+//! last reference is released
+//------------------------------------------------------------------------------
+struct IntegerRefCount
+{
+	IntegerRefCount(void* mtx, bool incr) : matrix(mtx), increment(incr), deleted(false) {}
+
+	template <typename T>
+	void Apply()
+	{
+		hwTMatrix<T, hwTComplex<T> >* mtx = static_cast<hwTMatrix<T, hwTComplex<T> >*>(matrix);
+
+		if (!mtx)
+			return;
+
+		if (increment)
+		{
+			mtx->IncrRefCount();
+		}
+		else if (!mtx->IsMatrixShared())
+		{
+			delete mtx;
+			deleted = true;
+		}
+		else
+		{
+			mtx->DecrRefCount();
+		}
+	}
+
+	void* matrix;
+	bool  increment;
+	bool  deleted;
+};
+
 StringManager Currency::vm;
 StringManager Currency::pm;
 bool Currency::_experimental = false;
@@ -89,19 +131,29 @@ Currency::Currency(const char* in_str): type(TYPE_MATRIX), mask(MASK_STRING), ou
     , _display (0)
     , _outputType (OUTPUT_TYPE_DEFAULT)
 {
-	std::string str = in_str;
-    data.mtx = ExprTreeEvaluator::allocateMatrix(str.length() ? 1 : 0, (int)str.length(), hwMatrix::REAL);
-	for (unsigned int i = 0; i < str.length(); i++) 
-		(*data.mtx)(i) = (unsigned char) str[i];
+	InitString(in_str);
 }
 
 Currency::Currency(const std::string& str): type(TYPE_MATRIX), mask(MASK_STRING), out_name(NULL)
     , _display (0)
     , _outputType (OUTPUT_TYPE_DEFAULT)
 {
-    data.mtx = ExprTreeEvaluator::allocateMatrix(str.length() ? 1 : 0, (int)str.length(), hwMatrix::REAL);
-	for (unsigned int i = 0; i < str.length(); i++) 
-		(*data.mtx)(i) = (unsigned char) str[i];
+	InitString(str);
+}
+//------------------------------------------------------------------------------
+//! Stores a string as packed character bytes, or as an empty matrix
+//------------------------------------------------------------------------------
+void Currency::InitString(const std::string& str)
+{
+	if (str.empty())
+	{
+		data.mtx = ExprTreeEvaluator::allocateMatrix(0, 0, hwMatrix::REAL);
+		return;
+	}
+
+	type      = TYPE_CHAR;
+	data.mtxc = new hwMatrixC(1, (int)str.length(), hwMatrixC::REAL);
+	memcpy(data.mtxc->GetRealData(), str.data(), str.length());
 }
 
 Currency::Currency(const std::vector<double>& in_data): type(TYPE_MATRIX), mask(MASK_DOUBLE), out_name(NULL)
@@ -136,11 +188,103 @@ Currency::Currency(hwMatrixN* in_data): type (TYPE_ND_MATRIX), mask(MASK_DOUBLE)
 	}
 }
 
+Currency::Currency(hwMatrixS* in_data): type (TYPE_SPARSE), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxs = in_data;
+}
+
+Currency::Currency(Decomposition* in_data): type (TYPE_DECOMPOSITION), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.decomp = in_data;
+}
+
+Currency::Currency(hwMatrixF* in_data): type (TYPE_SINGLE), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxf = in_data;
+}
+
+Currency::Currency(hwMatrixI8* in_data): type (TYPE_INT8), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixI16* in_data): type (TYPE_INT16), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixI32* in_data): type (TYPE_INT32), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixI64* in_data): type (TYPE_INT64), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixU8* in_data): type (TYPE_UINT8), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixU16* in_data): type (TYPE_UINT16), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixU32* in_data): type (TYPE_UINT32), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixU64* in_data): type (TYPE_UINT64), mask(MASK_DOUBLE), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxint = in_data;
+}
+
+Currency::Currency(hwMatrixB* in_data): type (TYPE_LOGICAL), mask(MASK_LOGICAL), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxb = in_data;
+}
+
+Currency::Currency(hwMatrixC* in_data): type (TYPE_CHAR), mask(MASK_STRING), out_name(NULL)
+    , _display (0)
+    , _outputType (OUTPUT_TYPE_DEFAULT)
+{
+	data.mtxc = in_data;
+}
+
 Currency::Currency(const hwComplex& cplx): type (TYPE_COMPLEX), mask(MASK_DOUBLE), out_name(NULL)
     , _display (0)
     , _outputType (OUTPUT_TYPE_DEFAULT)
 {
-	data.complex = new hwComplex(cplx);
+	data.complex.real = cplx.Real();
+	data.complex.imag = cplx.Imag();
 }
 
 Currency::Currency(): type(TYPE_MATRIX), mask(MASK_DOUBLE), out_name(NULL)
@@ -210,9 +354,15 @@ void Currency::Copy(const Currency& cur)
 {
 	hwMatrix*      old_matrix   = NULL;
 	hwMatrixN*     old_matrix_n = NULL;
+	hwMatrixS*     old_matrix_s = NULL;
+	hwMatrixF*     old_matrix_f = NULL;
+	void*          old_matrix_i = NULL;
+	hwMatrixB*     old_matrix_b = NULL;
+	hwMatrixC*     old_matrix_c = NULL;
+	Decomposition* old_decomp   = NULL;
+	CurrencyType   old_type     = type;
 	HML_CELLARRAY* old_cells    = NULL;
 	StructData*    old_sd       = NULL;
-	hwComplex*     old_complex  = NULL;
 	bool           was_scalar   = false;
 	FunctionInfo*  old_fi       = NULL;
 
@@ -222,12 +372,22 @@ void Currency::Copy(const Currency& cur)
 		old_matrix = data.mtx;
 	else if (type == TYPE_ND_MATRIX)
 			old_matrix_n = data.mtxn;
+	else if (type == TYPE_SPARSE)
+		old_matrix_s = data.mtxs;
+	else if (type == TYPE_SINGLE)
+		old_matrix_f = data.mtxf;
+	else if (IsIntegerType())
+		old_matrix_i = data.mtxint;
+	else if (type == TYPE_LOGICAL)
+		old_matrix_b = data.mtxb;
+	else if (type == TYPE_CHAR)
+		old_matrix_c = data.mtxc;
+	else if (type == TYPE_DECOMPOSITION)
+		old_decomp = data.decomp;
 	else if (type == TYPE_CELLARRAY)
 		old_cells = data.cells;
 	else if ((type == TYPE_STRUCT) || (type == TYPE_OBJECT))
 		old_sd = data.sd;
-	else if (type == TYPE_COMPLEX)
-		old_complex = data.complex;
 	else if (type == TYPE_FUNCHANDLE)
 		old_fi = data.func;
 
@@ -255,9 +415,51 @@ void Currency::Copy(const Currency& cur)
 		if (data.mtxn)
 			data.mtxn->IncrRefCount();
 	}
+	else if (type == TYPE_SPARSE)
+	{
+		data.mtxs = cur.data.mtxs;
+
+		if (data.mtxs)
+			data.mtxs->IncrRefCount();
+	}
+	else if (type == TYPE_SINGLE)
+	{
+		data.mtxf = cur.data.mtxf;
+
+		if (data.mtxf)
+			data.mtxf->IncrRefCount();
+	}
+	else if (IsIntegerType())
+	{
+		data.mtxint = cur.data.mtxint;
+
+		IntegerRefCount incr(data.mtxint, true);
+		DispatchInteger(type, incr);
+	}
+	else if (type == TYPE_LOGICAL)
+	{
+		data.mtxb = cur.data.mtxb;
+
+		if (data.mtxb)
+			data.mtxb->IncrRefCount();
+	}
+	else if (type == TYPE_CHAR)
+	{
+		data.mtxc = cur.data.mtxc;
+
+		if (data.mtxc)
+			data.mtxc->IncrRefCount();
+	}
+	else if (type == TYPE_DECOMPOSITION)
+	{
+		data.decomp = cur.data.decomp;
+
+		if (data.decomp)
+			data.decomp->IncrRefCount();
+	}
 	else if (type == TYPE_COMPLEX)
 	{
-		data.complex = new hwComplex(cur.Real(), cur.Imag());
+		data.complex = cur.data.complex;
 	}
 	else if (type == TYPE_CELLARRAY)
 	{
@@ -311,26 +513,202 @@ void Currency::Copy(const Currency& cur)
 		DeleteMatrix(old_matrix);
 	else if (old_matrix_n && (type != TYPE_POINTER))
 		DeleteMatrixN(old_matrix_n);
+	else if (old_matrix_s && (type != TYPE_POINTER))
+		DeleteMatrixS(old_matrix_s);
+	else if (old_matrix_f && (type != TYPE_POINTER))
+		DeleteMatrixF(old_matrix_f);
+	else if (old_matrix_i && (type != TYPE_POINTER))
+		DeleteMatrixInt(old_matrix_i, old_type);
+	else if (old_matrix_b && (type != TYPE_POINTER))
+		DeleteMatrixB(old_matrix_b);
+	else if (old_matrix_c && (type != TYPE_POINTER))
+		DeleteMatrixC(old_matrix_c);
+	else if (old_decomp && (type != TYPE_POINTER))
+		DeleteDecomposition(old_decomp);
 	else if (old_cells && (type != TYPE_POINTER))
 		DeleteCells(old_cells);
 	else if (old_sd && (type != TYPE_POINTER))
 		DeleteStruct(old_sd);
-	else if (old_complex && (type != TYPE_POINTER))
-		delete old_complex;
 	else if (old_fi && (type != TYPE_POINTER))
 		delete old_fi;
 }
 
+void Currency::Move(Currency& cur)
+{
+	type        = cur.type;
+	mask        = cur.mask;
+	data        = cur.data;
+	out_name    = cur.out_name;
+    _display    = NULL; // Do not copy display, it will be set later
+    _outputType = cur._outputType;
+
+	if (type == TYPE_ERROR)
+	{
+		message     = cur.message;
+		cur.message = NULL;
+	}
+	else if ((type == TYPE_OBJECT) || (type == TYPE_BOUNDOBJECT))
+	{
+		classname = cur.classname;
+	}
+
+	// leave cur as a scalar so it no longer owns the data
+	cur.type       = TYPE_SCALAR;
+	cur.data.value = 0.0;
+}
+
+//------------------------------------------------------------------------------
+// A view shares the data of its parent matrix and holds a reference to it, so
+// the parent's data stays in place while the view exists. These map each view
+// to its parent and each parent to its views, and each view of an ND matrix
+// to its parent. An ND parent is copied before it is written while a view
+// holds a reference, so it needs no map of its views.
+//------------------------------------------------------------------------------
+static std::unordered_map<const hwMatrix*, hwMatrix*>      view_parents;
+static std::unordered_multimap<const hwMatrix*, hwMatrix*> parent_views;
+static std::unordered_map<const hwMatrix*, hwMatrixN*>     view_parents_n;
+
+//------------------------------------------------------------------------------
+//! Removes a view from the maps and returns its parent, or NULL if the matrix
+//! is not a view
+//------------------------------------------------------------------------------
+static hwMatrix* UnregisterView(const hwMatrix* view)
+{
+	std::unordered_map<const hwMatrix*, hwMatrix*>::iterator iter = view_parents.find(view);
+
+	if (iter == view_parents.end())
+		return NULL;
+
+	hwMatrix* parent = iter->second;
+	view_parents.erase(iter);
+
+	typedef std::unordered_multimap<const hwMatrix*, hwMatrix*>::iterator ViewIter;
+	std::pair<ViewIter, ViewIter> range = parent_views.equal_range(parent);
+
+	for (ViewIter it = range.first; it != range.second; ++it)
+	{
+		if (it->second == view)
+		{
+			parent_views.erase(it);
+			break;
+		}
+	}
+
+	return parent;
+}
+
+//------------------------------------------------------------------------------
+//! Removes a view of an ND matrix from its map and returns its parent, or NULL
+//! if the matrix is not such a view
+//------------------------------------------------------------------------------
+static hwMatrixN* UnregisterViewN(const hwMatrix* view)
+{
+	std::unordered_map<const hwMatrix*, hwMatrixN*>::iterator iter = view_parents_n.find(view);
+
+	if (iter == view_parents_n.end())
+		return NULL;
+
+	hwMatrixN* parent = iter->second;
+	view_parents_n.erase(iter);
+
+	return parent;
+}
+
+hwMatrix* Currency::CreateView(const hwMatrix* parent, int64_t offset, int m, int n)
+{
+	hwMatrix* view;
+
+	if (parent->IsReal())
+		view = new hwMatrix(m, n, (void*) (parent->GetRealData() + offset), hwMatrix::REAL);
+	else
+		view = new hwMatrix(m, n, (void*) (parent->GetComplexData() + offset), hwMatrix::COMPLEX);
+
+	hwMatrix* owner = const_cast<hwMatrix*>(parent);
+	owner->IncrRefCount();
+
+	view_parents[view] = owner;
+	parent_views.insert(std::make_pair(parent, view));
+
+	return view;
+}
+
+hwMatrix* Currency::CreateView(const hwMatrixN* parent, int m, int n)
+{
+	hwMatrix* view;
+
+	if (parent->IsReal())
+		view = new hwMatrix(m, n, (void*) parent->GetRealData(), hwMatrix::REAL);
+	else
+		view = new hwMatrix(m, n, (void*) parent->GetComplexData(), hwMatrix::COMPLEX);
+
+	hwMatrixN* owner = const_cast<hwMatrixN*>(parent);
+	owner->IncrRefCount();
+
+	view_parents_n[view] = owner;
+
+	return view;
+}
+
+void Currency::DetachView(hwMatrix* view)
+{
+	hwMatrix*  parent   = UnregisterView(view);
+	hwMatrixN* parent_n = parent ? NULL : UnregisterViewN(view);
+
+	if (!parent && !parent_n)
+		return;
+
+	// copy the data while the parent still holds it, then let the view
+	// take over the copy's storage
+	hwMatrix copy(*view);
+	view->Dimension(0, 0, hwMatrix::REAL);
+	*view = std::move(copy);
+
+	if (parent)
+		DeleteMatrix(parent);
+	else
+		DeleteMatrixN(parent_n);
+}
+
+void Currency::DetachViews(hwMatrix* parent)
+{
+	int num_views = static_cast<int>(parent_views.count(parent));
+
+	// when views hold the only other references, giving them copies of
+	// their data lets the parent be written in place
+	if (!num_views || parent->GetRefCount() != num_views + 1)
+		return;
+
+	std::vector<hwMatrix*> views;
+	views.reserve(num_views);
+
+	typedef std::unordered_multimap<const hwMatrix*, hwMatrix*>::iterator ViewIter;
+	std::pair<ViewIter, ViewIter> range = parent_views.equal_range(parent);
+
+	for (ViewIter it = range.first; it != range.second; ++it)
+		views.push_back(it->second);
+
+	for (size_t i = 0; i < views.size(); ++i)
+		DetachView(views[i]);
+}
+
 void Currency::DeleteMatrix(hwMatrix* matrix)
 {
 	if (matrix)
 	{
 		if (!matrix->IsMatrixShared())
 		{
+			hwMatrix*  parent   = UnregisterView(matrix);
+			hwMatrixN* parent_n = parent ? NULL : UnregisterViewN(matrix);
+
 			delete matrix;
 
 			if (matrix == data.mtx)
 				data.mtx = NULL;
+
+			if (parent)
+				DeleteMatrix(parent);
+			else if (parent_n)
+				DeleteMatrixN(parent_n);
 		}
 		else
 		{
@@ -357,6 +735,139 @@ void Currency::DeleteMatrixN(hwMatrixN* matrix)
 	}
 }
 
+void Currency::DeleteMatrixS(hwMatrixS* matrix)
+{
+	if (matrix)
+	{
+		if (!matrix->IsMatrixShared())
+		{
+			delete matrix;
+
+			if (matrix == data.mtxs)
+				data.mtxs = NULL;
+		}
+		else
+		{
+			matrix->DecrRefCount();
+		}
+	}
+}
+
+void Currency::DeleteMatrixF(hwMatrixF* matrix)
+{
+	if (matrix)
+	{
+		if (!matrix->IsMatrixShared())
+		{
+			delete matrix;
+
+			if (matrix == data.mtxf)
+				data.mtxf = NULL;
+		}
+		else
+		{
+			matrix->DecrRefCount();
+		}
+	}
+}
+
+void Currency::DeleteMatrixInt(void* matrix, CurrencyType int_type)
+{
+	IntegerRefCount decr(matrix, false);
+	DispatchInteger(int_type, decr);
+
+	if (decr.deleted && matrix == data.mtxint)
+		data.mtxint = NULL;
+}
+
+void Currency::DeleteMatrixB(hwMatrixB* matrix)
+{
+	if (matrix)
+	{
+		if (!matrix->IsMatrixShared())
+		{
+			delete matrix;
+
+			if (matrix == data.mtxb)
+				data.mtxb = NULL;
+		}
+		else
+		{
+			matrix->DecrRefCount();
+		}
+	}
+}
+void Currency::DeleteMatrixC(hwMatrixC* matrix)
+{
+	if (matrix)
+	{
+		if (!matrix->IsMatrixShared())
+		{
+			delete matrix;
+
+			if (matrix == data.mtxc)
+				data.mtxc = NULL;
+		}
+		else
+		{
+			matrix->DecrRefCount();
+		}
+	}
+}
+//------------------------------------------------------------------------------
+//! Releases a packed matrix, deleting it when the last reference is released
+//------------------------------------------------------------------------------
+template <typename T>
+static void ReleasePacked(T* packed)
+{
+	if (packed->IsMatrixShared())
+		packed->DecrRefCount();
+	else
+		delete packed;
+}
+//------------------------------------------------------------------------------
+//! Replaces packed logical flags or character bytes with a double matrix of
+//! the same values, for code that needs them as numbers. The mask is kept.
+//! Other currencies are unchanged.
+//------------------------------------------------------------------------------
+void Currency::Unpack() const
+{
+	if (type == TYPE_LOGICAL)
+	{
+		hwMatrixB* flags = data.mtxb;
+		hwMatrix*  mtx   = ExprTreeEvaluator::allocateMatrix(flags->M(), flags->N(), hwMatrix::REAL);
+
+		const bool* src  = flags->GetRealData();
+		double*     dst  = mtx->GetRealData();
+		int64_t     size = flags->Size();
+
+		for (int64_t i = 0; i < size; ++i)
+			dst[i] = src[i] ? 1.0 : 0.0;
+
+		ReleasePacked(flags);
+
+		type     = TYPE_MATRIX;
+		data.mtx = mtx;
+	}
+	else if (type == TYPE_CHAR)
+	{
+		hwMatrixC* chars = data.mtxc;
+		hwMatrix*  mtx   = ExprTreeEvaluator::allocateMatrix(chars->M(), chars->N(), hwMatrix::REAL);
+
+		const char* src  = chars->GetRealData();
+		double*     dst  = mtx->GetRealData();
+		int64_t     size = chars->Size();
+
+		for (int64_t i = 0; i < size; ++i)
+			dst[i] = static_cast<unsigned char>(src[i]);
+
+		ReleasePacked(chars);
+
+		type     = TYPE_MATRIX;
+		data.mtx = mtx;
+	}
+}
+
 void Currency::DeleteCells(HML_CELLARRAY* cells)
 {
 	if (cells)
@@ -375,6 +886,24 @@ void Currency::DeleteCells(HML_CELLARRAY* cells)
 	}
 }
 
+void Currency::DeleteDecomposition(Decomposition* decomp)
+{
+	if (decomp)
+	{
+		if (decomp->GetRefCount() == 1)
+		{
+			delete decomp;
+
+			if (decomp == data.decomp)
+				data.decomp = NULL;
+		}
+		else
+		{
+			decomp->DecrRefCount();
+		}
+	}
+}
+
 void Currency::DeleteStruct(StructData* sd)
 {
 	if (sd)
@@ -399,12 +928,28 @@ Currency::Currency(const Currency& cur)
 	Copy(cur);
 }
 
+Currency::Currency(Currency&& cur) noexcept
+{
+	Move(cur);
+}
+
 Currency& Currency::operator=(const Currency& in)
 {
 	Copy(in);
 	return *this;
 }
 
+Currency& Currency::operator=(Currency&& in) noexcept
+{
+	if (this != &in)
+	{
+		// release the old data after taking the new, in case in is held by it
+		Currency old(std::move(*this));
+		Move(in);
+	}
+	return *this;
+}
+
 Currency::~Currency()
 {	
 	if (type == TYPE_MATRIX)
@@ -413,8 +958,18 @@ Currency::~Currency()
 		;
 	else if (type == TYPE_ND_MATRIX)
 		DeleteMatrixN(data.mtxn);
-	else if (type == TYPE_COMPLEX)
-        delete data.complex;
+	else if (type == TYPE_SPARSE)
+		DeleteMatrixS(data.mtxs);
+	else if (type == TYPE_SINGLE)
+		DeleteMatrixF(data.mtxf);
+	else if (IsIntegerType())
+		DeleteMatrixInt(data.mtxint, type);
+	else if (type == TYPE_LOGICAL)
+		DeleteMatrixB(data.mtxb);
+	else if (type == TYPE_CHAR)
+		DeleteMatrixC(data.mtxc);
+	else if (type == TYPE_DECOMPOSITION)
+		DeleteDecomposition(data.decomp);
 	else if ((type == TYPE_STRUCT) || (type == TYPE_OBJECT))
 		DeleteStruct(data.sd);
     else if (type == TYPE_FORMAT)
@@ -429,11 +984,8 @@ Currency::~Currency()
 
 void Currency::ReplaceComplex(hwComplex new_value)
 {
-	if (!data.complex)
-		data.complex = new hwComplex;
-
-	data.complex->Real(new_value.Real());
-	data.complex->Imag(new_value.Imag());
+	data.complex.real = new_value.Real();
+	data.complex.imag = new_value.Imag();
 
 	type = TYPE_COMPLEX;
 }
@@ -458,6 +1010,12 @@ std::string Currency::GetTypeString() const
 	{
 		output = "complex";
 	}
+	else if (IsPackedLogical())
+	{
+		char buffer[1024];
+		sprintf_s(buffer, "matrix [%d x %d]", data.mtxb->M(), data.mtxb->N());
+		output = buffer;
+	}
 	else if (IsMatrix())
 	{
 		int rows = 0;
@@ -510,6 +1068,35 @@ std::string Currency::GetTypeString() const
         strstream << "]" << std::ends;
         output = strstream.str();
     }
+    else if (IsSparse())
+    {
+        const hwMatrixS* mtxs = MatrixS();
+        char buffer[1024];
+        sprintf_s(buffer, "sparse [%d x %d]", mtxs->M(), mtxs->N());
+        output = buffer;
+    }
+    else if (IsDecomposition())
+    {
+        const hwMatrix* mtx = GetDecomposition()->GetMatrix().Matrix();
+        char buffer[1024];
+        sprintf_s(buffer, "decomposition [%d x %d]", mtx->M(), mtx->N());
+        output = buffer;
+    }
+    else if (IsSingle())
+    {
+        const hwMatrixF* mtxf = MatrixF();
+        char buffer[1024];
+        sprintf_s(buffer, "single [%d x %d]", mtxf->M(), mtxf->N());
+        output = buffer;
+    }
+    else if (IsIntegerType())
+    {
+        int m, n;
+        IntegerDims(m, n);
+        char buffer[1024];
+        sprintf_s(buffer, "%s [%d x %d]", IntegerClass().c_str(), m, n);
+        output = buffer;
+    }
     else if (IsBoundObject())
         return GetClassname();
 
@@ -520,6 +1107,9 @@ std::string Currency::GetTypeString() const
 //------------------------------------------------------------------------------
 bool Currency::IsString()    const
 {
+	if (type == TYPE_CHAR)
+		return mask == MASK_STRING;
+
 	return (mask == MASK_STRING && data.mtx);
 }
 
@@ -529,9 +1119,9 @@ bool Currency::IsMultilineString() const
 
 	if (ret_val)
 	{
-		hwMatrix* mtx = data.mtx;
+		int rows = (type == TYPE_CHAR) ? data.mtxc->M() : data.mtx->M();
 
-		if (mtx->M() == 1)
+		if (rows == 1)
 			ret_val = false;
 	}
 	return ret_val;
@@ -541,6 +1131,36 @@ bool Currency::IsMultilineString() const
 //------------------------------------------------------------------------------
 std::string Currency::StringVal() const
 {
+	if (type == TYPE_CHAR)
+	{
+		const hwMatrixC* chars = data.mtxc;
+		const char*      src   = chars->GetRealData();
+		int              rows  = chars->M();
+		int              cols  = chars->N();
+		std::string      st;
+
+		st.reserve(chars->Size() + rows);
+
+		if (rows > 1) 
+			st += "\n";  // Add newline if there are multiple rows
+
+		for (int i = 0; i < rows; ++i)
+		{
+			for (int j = 0; j < cols; ++j)
+			{
+				char c = src[j * rows + i];
+
+				if (c != 0x00)
+					st += c;
+			}
+
+			if (i+1 < rows)
+				st += "\n";
+		}
+
+		return st;
+	}
+
     if (!data.mtx) return "";
 
 	std::string st;
@@ -574,6 +1194,9 @@ bool Currency::IsVector() const
 
 	// not sure if this should return true or not for scalar.  Technically,
 	// a scalar is a vector of size 1
+	if (type == TYPE_LOGICAL)
+		return (data.mtxb->M() == 1) || (data.mtxb->N() == 1);
+
 	if (type == TYPE_MATRIX && data.mtx && mask != MASK_STRING)
 	{
 		if ((data.mtx->M() == 1) || (data.mtx->N() == 1))
@@ -587,6 +1210,9 @@ bool Currency::IsRealVector() const
 {
 	bool ret_val = false;
 
+	if (type == TYPE_LOGICAL)
+		return (data.mtxb->M() == 1) || (data.mtxb->N() == 1);
+
 	if (type == TYPE_MATRIX && data.mtx && mask != MASK_STRING)
 	{
 		if ((data.mtx->M() == 1) || (data.mtx->N() == 1))
@@ -603,6 +1229,8 @@ std::vector<double> Currency::Vector() const
 { 
 	std::vector<double> v;
 
+	Unpack();
+
 	if (data.mtx->M() == 1)
 	{
 		for (int i=0; i < data.mtx->N(); i++)
@@ -624,6 +1252,10 @@ void Currency::MakeStruct()
 			DeleteCells(data.cells);
 		else if (type == TYPE_MATRIX)
 			DeleteMatrix(data.mtx);
+		else if (type == TYPE_LOGICAL)
+			DeleteMatrixB(data.mtxb);
+		else if (type == TYPE_CHAR)
+			DeleteMatrixC(data.mtxc);
 
 		type = TYPE_STRUCT;
 		mask = MASK_NONE;
@@ -646,7 +1278,7 @@ bool Currency::IsScalar() const
 	if (type == TYPE_SCALAR)
 		return true;
 
-	if ((type == TYPE_COMPLEX) && (data.complex->Imag() == 0.0))
+	if ((type == TYPE_COMPLEX) && (data.complex.imag == 0.0))
 		return true;
 
 	if (type == TYPE_MATRIX && mask != MASK_STRING)
@@ -663,8 +1295,8 @@ double Currency::Scalar() const
 	if (type == TYPE_SCALAR)
 		return data.value;
 
-	if ((type == TYPE_COMPLEX) && (data.complex->Imag() == 0.0))
-		return data.complex->Real();
+	if ((type == TYPE_COMPLEX) && (data.complex.imag == 0.0))
+		return data.complex.real;
 
 	if ((type == TYPE_MATRIX) && data.mtx && (data.mtx->Size() == 1) && (data.mtx->IsReal()))
 		return (*data.mtx)(0);
@@ -689,7 +1321,7 @@ bool Currency::IsComplex() const
 hwComplex Currency::Complex() const
 {
 	if (type == TYPE_COMPLEX)
-		return *data.complex;
+		return hwComplex(data.complex.real, data.complex.imag);
 
 	if ((type == TYPE_MATRIX) && data.mtx && (data.mtx->Size() == 1) && (!data.mtx->IsReal()))
 		return data.mtx->z(0);
@@ -718,7 +1350,7 @@ bool Currency::IsPositiveInteger() const
 
 		if (temp > 0.0)
 		{
-			if (abs(temp - (int(temp+1.0e-15)) < 1.0e-15))
+			if (abs(temp - (static_cast<int64_t>(temp+1.0e-15)) < 1.0e-15))
 				return true;
 		}
 	}
@@ -767,13 +1399,31 @@ bool Currency::IsPositiveVector() const
 
 bool Currency::IsEmpty() const
 {
-	if (IsMatrix())
+	if (IsPackedLogical())
+	{
+		return data.mtxb->IsEmpty();
+	}
+	else if (IsMatrix())
 	{
 		if (data.mtx)
 			return data.mtx->IsEmpty();
 		else
 			return true;
 	}
+	else if (IsSparse())
+	{
+		return data.mtxs->IsEmpty();
+	}
+	else if (IsSingle())
+	{
+		return data.mtxf->IsEmpty();
+	}
+	else if (IsIntegerType())
+	{
+		int m, n;
+		IntegerDims(m, n);
+		return m == 0 || n == 0;
+	}
 
 	return false;
 }
@@ -782,8 +1432,9 @@ bool  Currency::IsMatrix() const
 { 
 	if (mask == MASK_STRING)
 		return false;
-	else
-		return type == TYPE_MATRIX; 
+
+	// packed flags are only unpacked when Matrix() asks for their values
+	return type == TYPE_MATRIX || type == TYPE_LOGICAL; 
 }
 
 bool  Currency::IsNDMatrix() const 
@@ -796,7 +1447,9 @@ bool Currency::IsCharacter() const
 {
 	if (IsString())
 	{
-		if (data.mtx->Size() == 1)
+		int64_t size = (type == TYPE_CHAR) ? data.mtxc->Size() : data.mtx->Size();
+
+		if (size == 1)
 			return true;
 	}
 
@@ -805,6 +1458,8 @@ bool Currency::IsCharacter() const
 
 const hwMatrix* Currency::Matrix() const
 {
+	Unpack();
+
 	if (type == TYPE_MATRIX && !data.mtx)
 		data.mtx = new hwMatrix();
 
@@ -818,8 +1473,23 @@ const hwMatrixN* Currency::MatrixN() const
 
 hwMatrix* Currency::GetWritableMatrix() 
 {
+	Unpack();
+
 	if (!data.mtx)
+	{
 		data.mtx = ExprTreeEvaluator::allocateMatrix();
+	}
+	else
+	{
+		// views of this matrix get their own copies first, since a view
+		// can itself have views and only then be left unshared
+		DetachViews(data.mtx);
+
+		// an unshared view takes its own copy before it can be written;
+		// a shared one is copied by the caller like any shared matrix
+		if (!data.mtx->OwnData() && !data.mtx->IsMatrixShared())
+			DetachView(data.mtx);
+	}
 
 	return data.mtx;
 }
@@ -834,6 +1504,8 @@ hwMatrixN* Currency::GetWritableMatrixN()
 
 void Currency::ReplaceMatrix(hwMatrix* new_mtx)
 {
+	Unpack();
+
 	if (type == TYPE_MATRIX)
 	{
 		if (new_mtx != data.mtx)
@@ -902,8 +1574,235 @@ bool Currency::IsCellList() const
 	return false;
 }
 
+Currency Currency::ToSingle() const
+{
+	hwMatrixF* ret = NULL;
+
+	if (IsIntegerType())
+		return ToDouble().ToSingle();
+
+	Unpack();
+
+	if (type == TYPE_SCALAR)
+	{
+		ret = new hwMatrixF(1, 1, hwMatrixF::REAL);
+		(*ret)(0) = static_cast<float>(data.value);
+	}
+	else if (type == TYPE_COMPLEX)
+	{
+		ret = new hwMatrixF(1, 1, hwMatrixF::COMPLEX);
+		ret->z(0) = hwTComplex<float>(static_cast<float>(data.complex.real),
+		                              static_cast<float>(data.complex.imag));
+	}
+	else if (type == TYPE_MATRIX)
+	{
+		// includes strings and logicals, which become numeric
+		const hwMatrix* mtx  = data.mtx;
+		int64_t         size = mtx->Size();
+
+		if (mtx->IsReal())
+		{
+			ret = new hwMatrixF(mtx->M(), mtx->N(), hwMatrixF::REAL);
+
+			const double* src = mtx->GetRealData();
+			float*        dst = ret->GetRealData();
+
+			for (int64_t i = 0; i < size; ++i)
+				dst[i] = static_cast<float>(src[i]);
+		}
+		else
+		{
+			ret = new hwMatrixF(mtx->M(), mtx->N(), hwMatrixF::COMPLEX);
+
+			const double* src = reinterpret_cast<const double*>(mtx->GetComplexData());
+			float*        dst = reinterpret_cast<float*>(ret->GetComplexData());
+
+			for (int i = 0; i < 2 * size; ++i)
+				dst[i] = static_cast<float>(src[i]);
+		}
+	}
+	else
+	{
+		return *this;
+	}
+
+	return ret;
+}
+
+//------------------------------------------------------------------------------
+//! Converts integer data to double
+//------------------------------------------------------------------------------
+struct IntegerToDouble
+{
+	explicit IntegerToDouble(const Currency& in) : input(in) {}
+
+	template <typename T>
+	void Apply()
+	{
+		const hwTMatrix<T, hwTComplex<T> >* mtx = input.MatrixInt<T>();
+		int64_t size = mtx->Size();
+
+		if (size == 1)
+		{
+			result = static_cast<double>((*mtx)(0));
+			return;
+		}
+
+		hwMatrix* ret = ExprTreeEvaluator::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
+		result = ret;
+
+		const T* src = mtx->GetRealData();
+		double*  dst = ret->GetRealData();
+
+		for (int64_t i = 0; i < size; ++i)
+			dst[i] = static_cast<double>(src[i]);
+	}
+
+	const Currency& input;
+	Currency        result;
+};
+//------------------------------------------------------------------------------
+//! Converts real numeric data to an integer type, rounding and saturating
+//------------------------------------------------------------------------------
+struct ToIntegerFunctor
+{
+	ToIntegerFunctor(const double* src, int m, int n) : data(src), rows(m), cols(n) {}
+
+	template <typename T>
+	void Apply()
+	{
+		hwTMatrix<T, hwTComplex<T> >* ret = new hwTMatrix<T, hwTComplex<T> >(rows, cols, hwTMatrix<T, hwTComplex<T> >::REAL);
+		result = ret;
+
+		T*  dst  = ret->GetRealData();
+		int size = rows * cols;
+
+		for (int i = 0; i < size; ++i)
+			dst[i] = SaturateCast<T>(data[i]);
+	}
+
+	const double* data;
+	int           rows;
+	int           cols;
+	Currency      result;
+};
+//------------------------------------------------------------------------------
+//! Gets the dimensions of integer data
+//------------------------------------------------------------------------------
+struct IntegerDimsFunctor
+{
+	explicit IntegerDimsFunctor(const Currency& in) : input(in), m(0), n(0), name(NULL) {}
+
+	template <typename T>
+	void Apply()
+	{
+		m    = input.MatrixInt<T>()->M();
+		n    = input.MatrixInt<T>()->N();
+		name = IntegerTraits<T>::Name();
+	}
+
+	const Currency& input;
+	int             m;
+	int             n;
+	const char*     name;
+};
+
+void Currency::IntegerDims(int& m, int& n) const
+{
+	IntegerDimsFunctor functor(*this);
+	DispatchInteger(type, functor);
+
+	m = functor.m;
+	n = functor.n;
+}
+
+std::string Currency::IntegerClass() const
+{
+	IntegerDimsFunctor functor(*this);
+	DispatchInteger(type, functor);
+
+	return functor.name ? functor.name : "";
+}
+
+Currency Currency::ToInteger(int int_type) const
+{
+	if (type == int_type)
+		return *this;
+
+	// complex values keep their real part
+	Currency dbl (ToDouble());
+
+	if (dbl.IsScalar() || dbl.IsComplex())
+	{
+		double value = dbl.IsScalar() ? dbl.Scalar() : dbl.Real();
+		ToIntegerFunctor functor(&value, 1, 1);
+		DispatchInteger(int_type, functor);
+		return functor.result;
+	}
+	else if (dbl.IsMatrix() && dbl.Matrix())
+	{
+		const hwMatrix* mtx = dbl.Matrix();
+		hwMatrix        re;
+
+		if (!mtx->IsReal())
+			mtx->UnpackComplex(&re, NULL);
+
+		const hwMatrix* src = mtx->IsReal() ? mtx : &re;
+
+		ToIntegerFunctor functor(src->GetRealData(), src->M(), src->N());
+		DispatchInteger(int_type, functor);
+		return functor.result;
+	}
+
+	return *this;
+}
+
+Currency Currency::ToDouble() const
+{
+	if (IsIntegerType())
+	{
+		IntegerToDouble functor(*this);
+		DispatchInteger(type, functor);
+		return functor.result;
+	}
+
+	if (type != TYPE_SINGLE)
+		return *this;
+
+	const hwMatrixF* mtx  = data.mtxf;
+	int64_t          size = mtx->Size();
+
+	if (size == 1 && mtx->IsReal())
+		return static_cast<double>((*mtx)(0));
+	else if (size == 1)
+		return hwComplex(mtx->z(0).Real(), mtx->z(0).Imag());
+
+	hwMatrix* ret = ExprTreeEvaluator::allocateMatrix(mtx->M(), mtx->N(), mtx->IsReal() ? hwMatrix::REAL : hwMatrix::COMPLEX);
+
+	if (mtx->IsReal())
+	{
+		const float* src = mtx->GetRealData();
+		double*      dst = ret->GetRealData();
+
+		for (int64_t i = 0; i < size; ++i)
+			dst[i] = src[i];
+	}
+	else
+	{
+		const float* src = reinterpret_cast<const float*>(mtx->GetComplexData());
+		double*      dst = reinterpret_cast<double*>(ret->GetComplexData());
+
+		for (int i = 0; i < 2 * size; ++i)
+			dst[i] = src[i];
+	}
+
+	return ret;
+}
+
 const hwMatrix* Currency::ConvertToMatrix() const
 {
+	Unpack();
+
 	if (type == TYPE_SCALAR)
 	{
 		double old_val = data.value;
@@ -912,9 +1811,9 @@ const hwMatrix* Currency::ConvertToMatrix() const
 	}
 	else if (type == TYPE_COMPLEX)
 	{
-		hwComplex* old_complex = data.complex;
+		hwComplex old_complex = Complex();
 		data.mtx = ExprTreeEvaluator::allocateMatrix(1,1, hwMatrix::COMPLEX);
-		data.mtx->z(0) = *old_complex;
+		data.mtx->z(0) = old_complex;
 	}
 	else if (type == TYPE_MATRIX)
 	{
@@ -924,7 +1823,7 @@ const hwMatrix* Currency::ConvertToMatrix() const
 		HML_CELLARRAY* cells   = CellArray();
 		bool           is_real = true;
 
-		int size = cells->Size();
+		int64_t size = cells->Size();
 
 		int size_needed = 0;
 
@@ -1004,6 +1903,8 @@ HML_CELLARRAY* Currency::ConvertToCellArray()
 {
 	bool ret_val = true;
 
+	Unpack();
+
 	if (type == TYPE_SCALAR)
 	{
 		double old_val = data.value;
@@ -1012,9 +1913,9 @@ HML_CELLARRAY* Currency::ConvertToCellArray()
 	}
 	else if (type == TYPE_COMPLEX)
 	{
-		hwComplex* old_complex = data.complex;
+		hwComplex old_complex = Complex();
 		data.cells = ExprTreeEvaluator::allocateCellArray(1,1);
-		(*data.cells)(0) = *old_complex;
+		(*data.cells)(0) = old_complex;
 	}
 	else if (type == TYPE_MATRIX)
 	{
@@ -1060,6 +1961,7 @@ void Currency::ConvertToStruct()
 	}
 	else if (IsMatrix())
 	{
+		Unpack();
 		hwMatrix* mtx = data.mtx;
 
 	    if (mtx && mtx->Size() == 0)
@@ -1169,6 +2071,45 @@ std::string Currency::GetOutputString(const OutputFormat* fmt) const
 	{
         return (GetDisplay()->GetOutput(fmt, os));
 	}
+	else if (IsSparse())
+	{
+		// Only the nonzeros are listed, as (row,col) value in column order
+		const hwMatrixS* mtxs = MatrixS();
+		const int*       cp   = mtxs->ColPointers();
+		const int*       ri   = mtxs->RowIndices();
+		const double*    vals = mtxs->Values();
+
+		os << "[Sparse] " << mtxs->M() << " x " << mtxs->N() << ", nnz = " << mtxs->NNZ();
+
+		for (int j = 0; j < mtxs->N(); ++j)
+		{
+			for (int p = cp[j]; p < cp[j + 1]; ++p)
+			{
+				std::ostringstream entry;
+				entry << "(" << ri[p] + 1 << "," << j + 1 << ") ";
+				os << "\n" << CurrencyDisplay::ScalarToString(fmt, vals[p], entry);
+			}
+		}
+	}
+	else if (IsDecomposition())
+	{
+		const Decomposition* decomp = GetDecomposition();
+		const hwMatrix*      mtx    = decomp->GetMatrix().Matrix();
+
+		os << "[Decomposition] " << mtx->M() << " x " << mtx->N() << ", " << decomp->GetType();
+	}
+	else if (IsSingle() || IsIntegerType())
+	{
+		// Displayed with the double precision formats
+		Currency dbl (ToDouble());
+
+		if (dbl.IsScalar())
+			return CurrencyDisplay::ScalarToString(fmt, dbl.Scalar(), os);
+		else if (dbl.IsComplex())
+			return CurrencyDisplay::ComplexToString(fmt, dbl.Complex(), os);
+
+		os << dbl.GetOutputString(fmt);
+	}
     else if (IsFunctionHandle())
 	{
 		// This should never happen, but there's some weird UI cases that actually do trigger it
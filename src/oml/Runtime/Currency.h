@@ -22,18 +22,34 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <cstdint>
 
 #include "hwComplex.h"
 
 template <typename T1, typename T2> class hwTMatrix;
 typedef hwTMatrix<double, hwTComplex<double> > hwMatrix;
+typedef hwTMatrix<float, hwTComplex<float> > hwMatrixF;
+typedef hwTMatrix<int8_t, hwTComplex<int8_t> > hwMatrixI8;
+typedef hwTMatrix<int16_t, hwTComplex<int16_t> > hwMatrixI16;
+typedef hwTMatrix<int32_t, hwTComplex<int32_t> > hwMatrixI32;
+typedef hwTMatrix<int64_t, hwTComplex<int64_t> > hwMatrixI64;
+typedef hwTMatrix<uint8_t, hwTComplex<uint8_t> > hwMatrixU8;
+typedef hwTMatrix<uint16_t, hwTComplex<uint16_t> > hwMatrixU16;
+typedef hwTMatrix<uint32_t, hwTComplex<uint32_t> > hwMatrixU32;
+typedef hwTMatrix<uint64_t, hwTComplex<uint64_t> > hwMatrixU64;
+typedef hwTMatrix<bool, hwTComplex<bool> > hwMatrixB;
+typedef hwTMatrix<char, hwTComplex<char> > hwMatrixC;
 
 template <typename T1, typename T2> class hwTMatrixN;
 typedef hwTMatrixN<double, hwTComplex<double> > hwMatrixN;
 
+template <typename T1> class hwTMatrixS;
+typedef hwTMatrixS<double> hwMatrixS;
+
 class HML2DLL_DECLS Currency;
 class HML2DLL_DECLS CurrencyDisplay;
 class OutputFormat;
+class Decomposition;
 class FunctionInfo;
 class StructData;
 
@@ -79,9 +95,23 @@ public:
 	Currency(bool logical_val);
 	Currency(hwMatrix* data);
 	Currency(hwMatrixN* data);
+	Currency(hwMatrixS* data);
+	Currency(Decomposition* data);
+	Currency(hwMatrixF* data);
+	Currency(hwMatrixI8* data);
+	Currency(hwMatrixI16* data);
+	Currency(hwMatrixI32* data);
+	Currency(hwMatrixI64* data);
+	Currency(hwMatrixU8* data);
+	Currency(hwMatrixU16* data);
+	Currency(hwMatrixU32* data);
+	Currency(hwMatrixU64* data);
+	Currency(hwMatrixB* data);
+	Currency(hwMatrixC* data);
 	Currency(const hwComplex& cplx);
 	Currency(); // Microsoft STL forces this 
 	Currency(const Currency& cur);
+	Currency(Currency&& cur) noexcept;
 	Currency(HML_CELLARRAY* cells);
 	Currency(FunctionInfo* fi);
 	Currency(StructData* sd);
@@ -95,6 +125,7 @@ public:
 
 	~Currency();
 	Currency& operator= (const Currency&);
+	Currency& operator= (Currency&&) noexcept;
     
     //! Gets output as a string for printing
     //! \param[in] fmt Output format
@@ -111,8 +142,14 @@ public:
 	bool  IsRealVector() const;
 	bool  IsMatrix()    const;
 	bool  IsNDMatrix()    const;
+	bool  IsSparse()    const      { return type == TYPE_SPARSE; }
+	bool  IsSingle()    const      { return type == TYPE_SINGLE; }
+	bool  IsDecomposition() const  { return type == TYPE_DECOMPOSITION; }
+	bool  IsIntegerType() const    { return type >= TYPE_INT8 && type <= TYPE_UINT64; }
+	bool  IsPackedLogical() const  { return type == TYPE_LOGICAL; }
+	bool  IsPackedString() const   { return type == TYPE_CHAR; }
 	bool  IsComplex()   const;
-	bool  IsMatrixOrString() const { return type == TYPE_MATRIX; }
+	bool  IsMatrixOrString() const { return type == TYPE_MATRIX || type == TYPE_LOGICAL || type == TYPE_CHAR; }
 	bool  IsColon()     const      { return type == TYPE_COLON; }
 	bool  IsBreak()      const     { return type == TYPE_BREAK; }
 	bool  IsContinue()      const  { return type == TYPE_CONTINUE; }
@@ -151,9 +188,20 @@ public:
 	hwMatrix*           GetWritableMatrix();
 	const hwMatrixN*    MatrixN() const;
 	hwMatrixN*          GetWritableMatrixN();
+	const hwMatrixS*    MatrixS() const        { return data.mtxs; }
+	const hwMatrixF*    MatrixF() const        { return data.mtxf; }
+	//! Factors of a matrix, used as the left operand of mldivide
+	const Decomposition* GetDecomposition() const { return data.decomp; }
+	//! Integer matrix, where T must be the element type of the currency type
+	template <typename T>
+	const hwTMatrix<T, hwTComplex<T> >* MatrixInt() const { return static_cast<const hwTMatrix<T, hwTComplex<T> >*>(data.mtxint); }
+	//! Logical flags, one byte per element, of a packed logical array
+	const hwMatrixB*    MatrixB() const        { return data.mtxb; }
+	//! Character bytes, one per element, of a packed string
+	const hwMatrixC*    MatrixC() const        { return data.mtxc; }
 	hwComplex           Complex() const;
-	double              Real() const           { return data.complex->Real(); }
-	double              Imag() const           { return data.complex->Imag(); }
+	double              Real() const           { return data.complex.real; }
+	double              Imag() const           { return data.complex.imag; }
 	HML_CELLARRAY*      CellArray() const      { return data.cells; }
 	FunctionInfo*       FunctionHandle() const { return data.func; }
 	StructData*         Struct() const         { return data.sd; }
@@ -161,7 +209,7 @@ public:
 	Currency*           Pointer() const        { return data.cur_ptr; }
     void*               BoundObject() const    { return data.boundobj; }
 
-	void                SetMask(int new_mask)  { mask = MaskType(new_mask); }
+	void                SetMask(int new_mask)  { if (new_mask != mask) Unpack(); mask = MaskType(new_mask); }
 	int                 GetMask() const        { return mask; }
 	void                SetOutputName(const std::string& name) const; // the const is a mistake and needs to be fixed -- JDS
 	void                SetOutputName(const std::string* name) const; // the const is a mistake and needs to be fixed -- JDS
@@ -175,11 +223,27 @@ public:
 	void                ReplaceComplex(hwComplex new_value);
 
 	const hwMatrix*     ConvertToMatrix() const;
+	//! Creates an m x n matrix sharing the contiguous data of parent from the
+	//! given element offset. The view keeps the parent referenced until it is
+	//! deleted or takes a copy of its data when written.
+	static hwMatrix*    CreateView(const hwMatrix* parent, int64_t offset, int m, int n);
+	//! Creates an m x n matrix sharing all of the data of an ND matrix
+	static hwMatrix*    CreateView(const hwMatrixN* parent, int m, int n);
+	//! Results with fewer elements are copied, which is cheaper than tracking
+	//! a view
+	static const int    MIN_VIEW_SIZE = 64;
+	Currency            ToSingle() const;   // numeric values only, others are returned as is
+	Currency            ToDouble() const;   // single and integer values only, others are returned as is
+	Currency            ToInteger(int int_type) const; // rounds and saturates numeric values
+	void                IntegerDims(int& m, int& n) const;
+	std::string         IntegerClass() const;
 	HML_CELLARRAY*      ConvertToCellArray();
 
 	void                ConvertToStruct();
 
-	enum CurrencyType { TYPE_SCALAR, TYPE_STRING, TYPE_MATRIX, TYPE_COLON, TYPE_COMPLEX, TYPE_CELLARRAY, TYPE_ERROR, TYPE_BREAK, TYPE_RETURN, TYPE_FUNCHANDLE, TYPE_STRUCT, TYPE_NOTHING, TYPE_FORMAT, TYPE_BREAKPOINT, TYPE_POINTER, TYPE_CONTINUE, TYPE_ND_MATRIX, TYPE_OBJECT, TYPE_BOUNDOBJECT };
+	enum CurrencyType { TYPE_SCALAR, TYPE_STRING, TYPE_MATRIX, TYPE_COLON, TYPE_COMPLEX, TYPE_CELLARRAY, TYPE_ERROR, TYPE_BREAK, TYPE_RETURN, TYPE_FUNCHANDLE, TYPE_STRUCT, TYPE_NOTHING, TYPE_FORMAT, TYPE_BREAKPOINT, TYPE_POINTER, TYPE_CONTINUE, TYPE_ND_MATRIX, TYPE_OBJECT, TYPE_BOUNDOBJECT, TYPE_SPARSE, TYPE_SINGLE,
+	                    TYPE_INT8, TYPE_INT16, TYPE_INT32, TYPE_INT64, TYPE_UINT8, TYPE_UINT16, TYPE_UINT32, TYPE_UINT64,
+	                    TYPE_LOGICAL, TYPE_CHAR, TYPE_DECOMPOSITION };
 	enum MaskType { MASK_NONE, MASK_DOUBLE, MASK_STRING, MASK_LOGICAL, MASK_CELL_LIST, MASK_EXPLICIT_COMPLEX };
 
 	static StringManager vm;
@@ -226,8 +290,19 @@ private:
 	Currency(const hwMatrix* data); // stubbed
 
 	void  Copy(const Currency&);
+	void  Move(Currency&);
 	void  DeleteMatrix(hwMatrix*);
+	void  DetachView(hwMatrix*);    // gives a view its own copy of the data
+	void  DetachViews(hwMatrix*);   // detaches views holding the only other references
 	void  DeleteMatrixN(hwMatrixN*);
+	void  DeleteMatrixS(hwMatrixS*);
+	void  DeleteMatrixF(hwMatrixF*);
+	void  DeleteMatrixInt(void*, CurrencyType);
+	void  DeleteMatrixB(hwMatrixB*);
+	void  DeleteMatrixC(hwMatrixC*);
+	void  DeleteDecomposition(Decomposition*);
+	void  Unpack() const;   // replaces packed logicals or chars with a double matrix
+	void  InitString(const std::string&);
 	void  DeleteCells(HML_CELLARRAY*);
 	void  DeleteStruct(StructData*);
 
@@ -237,9 +312,19 @@ private:
 	union DataStorage
 	{
 		double               value;
-		hwComplex*           complex;
+		struct
+		{
+			double real;
+			double imag;
+		}                    complex;   //! Complex scalar, stored inline
 		hwMatrix*            mtx;
 		hwMatrixN*           mtxn;
+		hwMatrixS*           mtxs;
+		hwMatrixF*           mtxf;
+		void*                mtxint;    //! Integer matrix, typed by the currency type
+		hwMatrixB*           mtxb;      //! Packed logical flags
+		hwMatrixC*           mtxc;      //! Packed character bytes
+		Decomposition*       decomp;    //! Matrix factors
 		HML_CELLARRAY*       cells;
 		FunctionInfo*        func;
 		StructData*          sd;
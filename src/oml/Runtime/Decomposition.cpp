@@ -0,0 +1,75 @@
+/**
+* @file Decomposition.cpp
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+// Begin defines/includes
+#include "Decomposition.h"
+
+// End defines/includes
+
+//------------------------------------------------------------------------------
+// Constructor, which factors the matrix
+//------------------------------------------------------------------------------
+Decomposition::Decomposition(const Currency& matrix)
+    : _matrix   (matrix)
+    , _factored (false)
+    , _refcount (1)
+{
+    const hwMatrix* mtx = _matrix.Matrix();
+
+    if (!mtx->IsReal() || !mtx->IsSquare() || mtx->IsEmpty())
+        return;
+
+    // singular and ill-conditioned matrices are left to DivideLeft
+    hwMathStatus status = _factors.Factor(*mtx, _pivots);
+
+    if (status.IsOk())
+    {
+        _factored = true;
+    }
+    else
+    {
+        _factors.Dimension(0, 0, hwMatrix::REAL);
+        _pivots.Dimension(0, 0, hwMatrixI::REAL);
+    }
+}
+//------------------------------------------------------------------------------
+// Solves matrix * X = B
+//------------------------------------------------------------------------------
+hwMathStatus Decomposition::Solve(const hwMatrix& B, hwMatrix& X) const
+{
+    if (_factored)
+        return X.SolveFactored(_factors, _pivots, B);
+
+    return X.DivideLeft(*_matrix.Matrix(), B);
+}
+//------------------------------------------------------------------------------
+// Returns the factorization: cholesky, lu, or none if not factored
+//------------------------------------------------------------------------------
+std::string Decomposition::GetType() const
+{
+    if (!_factored)
+        return "none";
+
+    return (_pivots.IsEmpty() ? "cholesky" : "lu");
+}
+//------------------------------------------------------------------------------
+// Returns the number of bytes held by the factors
+//------------------------------------------------------------------------------
+size_t Decomposition::GetBytes() const
+{
+    return static_cast<size_t>(_factors.Size()) * sizeof(double) +
+           static_cast<size_t>(_pivots.Size()) * sizeof(int);
+}
@@ -0,0 +1,85 @@
+/**
+* @file Decomposition.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+#ifndef __DECOMPOSITION_H__
+#define __DECOMPOSITION_H__
+
+// Begin defines/includes
+#include <string>
+
+#include "Currency.h"
+#include "hwMatrix.h"
+
+// End defines/includes
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Factors of a matrix used as the left operand of mldivide
+//!
+//! A real square matrix is factored once, with Cholesky when it is symmetric
+//! positive definite and LU otherwise, and each solve reuses the factors. Any
+//! other matrix, and a matrix that is singular or ill-conditioned, is kept
+//! unfactored and solved with DivideLeft, which warns and falls back to the
+//! least squares or pseudoinverse solution. The decomposition holds a
+//! reference to the matrix, so the matrix is copied before it can be written
+//! and the factors stay valid. Decompositions are reference counted like the
+//! other currency data.
+//!
+//------------------------------------------------------------------------------
+class HML2DLL_DECLS Decomposition
+{
+public:
+    //!
+    //! Constructor, which factors the matrix
+    //! \param matrix Matrix, which must be a TYPE_MATRIX currency
+    //!
+    explicit Decomposition(const Currency& matrix);
+    //!
+    //! Solves matrix * X = B
+    //! \param B Right hand side
+    //! \param X Solution
+    //!
+    hwMathStatus Solve(const hwMatrix& B, hwMatrix& X) const;
+
+    //! Returns the factored matrix
+    const Currency& GetMatrix() const { return _matrix; }
+    //! Returns true if the solves use the factors
+    bool IsFactored() const { return _factored; }
+    //! Returns the factorization: cholesky, lu, or none if not factored
+    std::string GetType() const;
+    //! Returns the number of bytes held by the factors
+    size_t GetBytes() const;
+
+    //! Increments the reference count
+    void IncrRefCount() { ++_refcount; }
+    //! Decrements the reference count
+    void DecrRefCount() { --_refcount; }
+    //! Returns the reference count
+    int  GetRefCount() const { return _refcount; }
+
+private:
+    Currency  _matrix;    //! Factored matrix
+    hwMatrix  _factors;   //! Cholesky or LU factors
+    hwMatrixI _pivots;    //! LU row interchanges, empty for Cholesky
+    bool      _factored;  //! True if the factors are valid
+    int       _refcount;  //! Reference count
+
+    // Stubbed, decompositions are shared by reference counting
+    Decomposition(const Decomposition&);
+    Decomposition& operator=(const Decomposition&);
+};
+
+#endif
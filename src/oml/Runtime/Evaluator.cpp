@@ -33,9 +33,16 @@
 #include "ANTLRData.h"
 #include "OMLInterface.h"
 #include "OMLTree.h"
+#include "FusedElementwise.h"
+#include "IntegerArithmetic.h"
+#include "LogicalArray.h"
+#include "Decomposition.h"
+#include "hwMatrixS.h"
+#include "hwSolverPath.h"
 #include <sys/stat.h>
 
 #include <cassert>
+#include <limits>
 #include <sstream>
 
 #undef GetMessage // need to undefine this because Microsoft defines it somewhere in windows headers to GetMessageA
@@ -45,6 +52,13 @@ std::string ExprTreeEvaluator::lastwarning;
 
 UserFunc::~UserFunc()  { if (fi) delete fi; }
 
+// Number of matrices whose factors are kept
+static const size_t FACTOR_CACHE_SIZE = 4;
+// Total bytes of the kept factors, larger factors are not kept
+static const size_t FACTOR_CACHE_BYTES = 256 * 1024 * 1024;
+// Smaller matrices are refactored on each solve
+static const int FACTOR_CACHE_MIN_SIZE = 64;
+
 #define RUN(tree) (this->*(tree->func_ptr))(tree)
 
 inline const char* getText(pANTLR3_BASE_TREE tree)
@@ -82,6 +96,7 @@ ExprTreeEvaluator::ExprTreeEvaluator() : nested_function_marker(0), assignment_n
 	class_info_map          = new std::map<std::string, ClassInfo*>;
 	not_found_functions     = new std::vector<std::string>;
 	preregistered_functions = new std::vector<std::string>;
+	_factor_cache           = new std::list<Currency>;
 
 	mapBuiltInFuncs(std_functions);
 
@@ -151,6 +166,8 @@ ExprTreeEvaluator::~ExprTreeEvaluator()
 	{
 		delete format;
 	}
+
+	delete _factor_cache;
 }
 //------------------------------------------------------------------------------
 //! Copy constructor
@@ -169,6 +186,8 @@ ExprTreeEvaluator::ExprTreeEvaluator(const ExprTreeEvaluator* source) : format(s
 	ImportFunctionList(source);
 	ImportPathNames(source);
 
+	_factor_cache = new std::list<Currency>;
+
 	// We don't want debug listener chaining
 	debug_listener       = NULL; 
 	_interrupt           = false;
@@ -477,7 +496,7 @@ Currency ExprTreeEvaluator::CallBuiltinFunction(FUNCPTR fptr, const std::string&
 		PopNargValues();
 
 	if (ret.size() > 0)
-		return ret[0];
+		return std::move(ret[0]);
 	else
 		return Currency(-1.0, Currency::TYPE_NOTHING);
 }
@@ -566,33 +585,329 @@ Currency ExprTreeEvaluator::VariableIndex(const std::string* var_name, const std
 	return VariableIndex(target, params);
 }
 
+// Returns a view of m x n contiguous elements of data from offset, or NULL if
+// the slice is small enough to copy
+static hwMatrix* ContiguousView(const hwMatrix* data, int64_t offset, int m, int n)
+{
+	if (m * n < Currency::MIN_VIEW_SIZE)
+		return NULL;
+
+	return Currency::CreateView(data, offset, m, n);
+}
+
+// Returns true if a real index vector is a range with unit stride, setting
+// first to the zero based start of the range
+static bool IsUnitRange(const hwMatrix* idx, int64_t& first)
+{
+	const double* vals = idx->GetRealData();
+	int64_t       size = idx->Size();
+
+	if (!vals || !size || vals[0] < 1.0 || vals[0] != floor(vals[0]))
+		return false;
+
+	for (int64_t j = 1; j < size; ++j)
+	{
+		if (vals[j] != vals[0] + j)
+			return false;
+	}
+
+	first = static_cast<int64_t>(vals[0]) - 1;
+	return true;
+}
+
+// Collects the zero based indices that one subscript selects from count
+// elements. Returns false for subscripts left to the general indexing code.
+static bool PackedSubscript(const Currency& param, int64_t count, std::vector<int64_t>& indices)
+{
+	indices.clear();
+
+	if (param.IsColon())
+	{
+		indices.resize(count);
+
+		for (int64_t j = 0; j < count; ++j)
+			indices[j] = j;
+
+		return true;
+	}
+
+	if (param.IsPackedLogical())
+	{
+		if (!param.IsVector())
+			return false;
+
+		LogicalArray::Find(*param.MatrixB(), -1, false, indices);
+	}
+	else if (param.IsLogical() && param.IsVector())
+	{
+		const hwMatrix* mtx = param.Matrix();
+
+		if (!mtx->IsReal())
+			return false;
+
+		for (int64_t j = 0; j < mtx->Size(); ++j)
+		{
+			if ((*mtx)(j))
+				indices.push_back(j);
+		}
+	}
+	else if (param.IsPositiveInteger())
+	{
+		indices.push_back(static_cast<int64_t>(param.Scalar()) - 1);
+	}
+	else if (param.IsPositiveVector())
+	{
+		const hwMatrix* mtx  = param.Matrix();
+		const double*   vals = mtx->GetRealData();
+
+		indices.resize(mtx->Size());
+
+		for (int64_t j = 0; j < mtx->Size(); ++j)
+			indices[j] = static_cast<int64_t>(vals[j]) - 1;
+	}
+	else
+	{
+		return false;
+	}
+
+	for (size_t j = 0; j < indices.size(); ++j)
+	{
+		if (indices[j] >= count)
+			throw OML_Error(HW_ERROR_INDEXRANGE);
+	}
+
+	return true;
+}
+
+// Indexes packed logical flags or character bytes with one or two vector or
+// colon subscripts, without unpacking them. A single subscript gives a row
+// if as_row is set, and otherwise follows the shape rules of double
+// matrices. Returns NULL for subscripts left to the general indexing code.
+template <typename T>
+static hwTMatrix<T>* IndexPacked(const hwTMatrix<T>& data, const std::vector<Currency>& params, bool as_row)
+{
+	std::vector<int64_t> rows;
+	std::vector<int64_t> cols;
+	int                  m;
+	int                  n;
+
+	if (params.size() == 1)
+	{
+		if (!PackedSubscript(params[0], data.Size(), rows))
+			return NULL;
+
+		if (rows.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+			throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+		int  count = static_cast<int>(rows.size());
+		bool row   = as_row;
+
+		if (params[0].IsColon())
+		{
+			row = false;
+		}
+		else if (as_row || params[0].IsScalar())
+		{
+			row = true;
+		}
+		else if (params[0].IsLogical())
+		{
+			row = (data.M() == 1) || (data.N() != 1);
+		}
+		else
+		{
+			// an index vector keeps its shape, unless it is a row and the
+			// data is a column
+			row = (params[0].Matrix()->M() == 1) && !(data.IsVector() && data.N() == 1);
+		}
+
+		m = row ? 1 : count;
+		n = row ? count : 1;
+	}
+	else if (params.size() == 2)
+	{
+		if (!PackedSubscript(params[0], data.M(), rows) ||
+			!PackedSubscript(params[1], data.N(), cols))
+			return NULL;
+
+		m = static_cast<int>(rows.size());
+		n = static_cast<int>(cols.size());
+	}
+	else
+	{
+		return NULL;
+	}
+
+	hwTMatrix<T>* ret = new hwTMatrix<T>(m, n, hwTMatrix<T>::REAL);
+	const T*      src = data.GetRealData();
+	T*            dst = ret->GetRealData();
+
+	if (params.size() == 1)
+	{
+		for (size_t j = 0; j < rows.size(); ++j)
+			dst[j] = src[rows[j]];
+	}
+	else
+	{
+		int ld = data.M();
+
+		for (int k = 0; k < n; ++k)
+		{
+			const T* col = src + static_cast<size_t>(cols[k]) * ld;
+
+			for (int j = 0; j < m; ++j)
+				*dst++ = col[rows[j]];
+		}
+	}
+
+	return ret;
+}
+
 Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vector<Currency>& params)
 {
+	if (target.IsSingle())
+	{
+		const hwMatrixF* data = target.MatrixF();
+
+		// a single element is read directly
+		if ((params.size() == 1 && params[0].IsPositiveInteger()) ||
+			(params.size() == 2 && params[0].IsPositiveInteger() && params[1].IsPositiveInteger()))
+		{
+			int64_t row   = static_cast<int64_t>(params[0].Scalar()) - 1;
+			int     col   = (params.size() == 2) ? static_cast<int>(params[1].Scalar()) - 1 : 0;
+			int64_t index = (params.size() == 2) ? static_cast<int64_t>(col) * data->M() + row : row;
+
+			if (row >= data->Size() || (params.size() == 2 && (row >= data->M() || col >= data->N())))
+				throw OML_Error(HW_ERROR_INDEXRANGE);
+
+			hwMatrixF* ret = new hwMatrixF(1, 1, data->Type());
+
+			if (data->IsReal())
+				(*ret)(0) = (*data)(index);
+			else
+				ret->z(0) = data->z(index);
+
+			return ret;
+		}
+
+		// other indexing is done in double precision, which represents
+		// every single precision value exactly
+		Currency ret = VariableIndex(target.ToDouble(), params);
+		return ret.ToSingle();
+	}
+	else if (target.IsIntegerType())
+	{
+		int m, n;
+		target.IntegerDims(m, n);
+
+		// a single element is read directly, which keeps 64 bit values exact
+		if ((params.size() == 1 && params[0].IsPositiveInteger()) ||
+			(params.size() == 2 && params[0].IsPositiveInteger() && params[1].IsPositiveInteger()))
+		{
+			int64_t row = static_cast<int64_t>(params[0].Scalar()) - 1;
+			int     col = (params.size() == 2) ? static_cast<int>(params[1].Scalar()) - 1 : 0;
+
+			if (row >= static_cast<int64_t>(m) * n || (params.size() == 2 && (row >= m || col >= n)))
+				throw OML_Error(HW_ERROR_INDEXRANGE);
+
+			return IntegerArithmetic::Element(target, (params.size() == 2) ? static_cast<int64_t>(col) * m + row : row);
+		}
+
+		Currency ret = VariableIndex(target.ToDouble(), params);
+		return ret.ToInteger(target.GetType());
+	}
+	else if (target.IsPackedLogical())
+	{
+		const hwMatrixB* flags = target.MatrixB();
+
+		// a single element is read directly
+		if ((params.size() == 1 && params[0].IsPositiveInteger()) ||
+			(params.size() == 2 && params[0].IsPositiveInteger() && params[1].IsPositiveInteger()))
+		{
+			int64_t row = static_cast<int64_t>(params[0].Scalar()) - 1;
+			int     col = (params.size() == 2) ? static_cast<int>(params[1].Scalar()) - 1 : 0;
+
+			if (row >= flags->Size() || (params.size() == 2 && (row >= flags->M() || col >= flags->N())))
+				throw OML_Error(HW_ERROR_INDEXRANGE);
+
+			return Currency((*flags)((params.size() == 2) ? static_cast<int64_t>(col) * flags->M() + row : row));
+		}
+
+		// ranges, vectors, masks and colons select from the flags directly
+		hwMatrixB* selected = IndexPacked(*flags, params, false);
+
+		if (selected)
+			return LogicalArray::FromFlags(selected);
+	}
+	else if (target.IsPackedString())
+	{
+		const hwMatrixC* chars = target.MatrixC();
+
+		// a single subscript gives a row, as for unpacked strings
+		hwMatrixC* selected = IndexPacked(*chars, params, true);
+
+		if (selected)
+		{
+			if (!selected->IsEmpty())
+				return selected;
+
+			Currency empty(params.size() == 1 ? allocateMatrix() :
+						   allocateMatrix(selected->M(), selected->N(), hwMatrix::REAL));
+			empty.SetMask(Currency::MASK_STRING);
+			delete selected;
+			return empty;
+		}
+	}
+
 	if (target.IsMatrix() && (params.size() == 1))
 	{
-		int index;
+		int64_t index;
 
 		const hwMatrix* data = target.Matrix();
 
+		// a packed logical mask selects without being unpacked
+		if (params[0].IsPackedLogical() && data->IsReal())
+		{
+			Currency selected;
+			if (LogicalArray::Select(*data, *params[0].MatrixB(), selected))
+				return selected;
+		}
+
 		if (params[0].IsPositiveInteger())
 		{
-			index = static_cast<int>(params[0].Scalar());
+			index = static_cast<int64_t>(params[0].Scalar());
 		}
 		else if (params[0].IsPositiveVector())
 		{
 			if (params[0].GetMask() == Currency::MASK_DOUBLE)
 			{
 				const hwMatrix* mtx = params[0].Matrix(); // this must be real
+				int64_t         first;
+
+				// a unit stride range shares the data of the target
+				if (IsUnitRange(mtx, first) && (first + mtx->Size() <= data->Size()))
+				{
+					hwMatrix* view = NULL;
+
+					if (data->IsVector() && (data->N() == 1) && (mtx->M() == 1))
+						view = ContiguousView(data, first, mtx->N(), 1);
+					else
+						view = ContiguousView(data, first, mtx->M(), mtx->N());
+
+					if (view)
+						return view;
+				}
+
 				hwMatrix* ret = allocateMatrix(mtx->M(), mtx->N(), data->Type());
 
 				if (data->IsVector() && (data->N() == 1) && (mtx->M() == 1))
 					ret->Transpose();
 
-				int max_index = data->Size();
+				int64_t max_index = data->Size();
 
-				for (int j=0; j<(int)mtx->Size(); j++)
+				for (int64_t j=0; j<(int)mtx->Size(); j++)
 				{
-					int mtx_index = (int)((*mtx)(j)-1);
+					int64_t mtx_index = (int64_t)((*mtx)(j)-1);
 
 					if ((mtx_index < 0) || (mtx_index >= max_index))
 					{
@@ -601,9 +916,9 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 					}
 
 					if (data->IsReal())
-						(*ret)(j) = (*data)((int)((*mtx)(j)-1));
+						(*ret)(j) = (*data)(mtx_index);
 					else
-						ret->z(j) = data->z((int)((*mtx)(j)-1));
+						ret->z(j) = data->z(mtx_index);
 				}
 				
 				return ret;
@@ -612,14 +927,14 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 		else if (params[0].IsVector() && params[0].IsLogical())
 		{
 			const hwMatrix* mtx = params[0].Matrix(); // this must be real
-			int mtx_size = mtx->Size();
+			int64_t mtx_size = mtx->Size();
 
 			if (data->IsReal())
 			{
 				std::vector<double> ret;
 				ret.reserve(mtx_size);
 
-				for (int j=0; j<mtx_size; j++)
+				for (int64_t j=0; j<mtx_size; j++)
 				{
 					if ((*mtx)(j))
 						ret.push_back((*data)(j));
@@ -645,7 +960,7 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 				std::vector<hwComplex> ret;
 				ret.reserve(mtx_size);
 
-				for (int j=0; j<mtx_size; j++)
+				for (int64_t j=0; j<mtx_size; j++)
 				{
 					if ((*mtx)(j))
 						ret.push_back(data->z(j));
@@ -683,7 +998,7 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 					std::vector<double> temp_vec;
 					temp_vec.reserve(data->Size());
 
-					for (int j=0; j<data->Size(); j++)
+					for (int64_t j=0; j<data->Size(); j++)
 					{
 						if ((*val)(j) == 1.0)
 							temp_vec.push_back((*data)(j));
@@ -707,12 +1022,18 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 		else if (params[0].IsColon())
 		{
 			hwMatrix* ret = NULL;
-			
+
+			if (data && data->Size() > std::numeric_limits<int>::max())
+				throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
 			if (data)
+				ret = ContiguousView(data, 0, static_cast<int>(data->Size()), 1);
+
+			if (data && !ret)
 			{
-				ret = allocateMatrix(data->Size(), 1, data->Type());
+				ret = allocateMatrix(static_cast<int>(data->Size()), 1, data->Type());
 
-				for (int j=0; j<data->Size(); j++)
+				for (int64_t j=0; j<data->Size(); j++)
 				{
 					if (data->IsReal())
 						(*ret)(j) = (*data)(j);
@@ -736,13 +1057,13 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
             else
                 ret->Dimension(idxm->Dimensions(), hwMatrixN::COMPLEX);
 
-            int size_idx = idxm->Size();
-            int size_tgt = data->Size();
+            int64_t size_idx = idxm->Size();
+            int64_t size_tgt = data->Size();
 
-            for (int i = 0; i < size_idx; ++i)
+            for (int64_t i = 0; i < size_idx; ++i)
             {
                 double idxd = (*idxm)(i);
-                int idx = static_cast<int>(idxd) - 1;
+                int64_t idx = static_cast<int64_t>(idxd) - 1;
 
                 if (idx < 0 || idx >= size_tgt)
                     throw OML_Error(OML_ERR_INVALID_RANGE);
@@ -855,9 +1176,16 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 				throw OML_Error(HW_ERROR_INDEXPOSINT);
 
 
-			hwMatrix* ret = allocateMatrix(data->M(),1,data->Type());
 			ValidateColumnIndex(*data, idx-1);
-			data->ReadColumn(idx-1, *ret);
+
+			// a column is contiguous, so it shares the data of the target
+			hwMatrix* ret = ContiguousView(data, static_cast<int64_t>(idx-1) * data->M(), data->M(), 1);
+
+			if (!ret)
+			{
+				ret = allocateMatrix(data->M(),1,data->Type());
+				data->ReadColumn(idx-1, *ret);
+			}
 
 			Currency ret_val(ret);
 
@@ -868,6 +1196,43 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 		}
 		else if (params[0].IsVector() || params[1].IsVector())
 		{
+			int64_t first    = 0;
+			int64_t col      = 0;
+			bool    is_range = false;
+			int     rows     = data->M();
+			int     cols     = 1;
+
+			// a range of whole columns, or a unit stride range of rows
+			// within one column, is contiguous and shares the target data
+			if (params[0].IsColon() && params[1].IsPositiveVector() &&
+				params[1].GetMask() == Currency::MASK_DOUBLE)
+			{
+				const hwMatrix* idx = params[1].Matrix();
+				is_range = IsUnitRange(idx, col) && (col + idx->Size() <= data->N());
+				cols     = static_cast<int>(idx->Size());
+			}
+			else if (params[0].IsPositiveVector() && params[0].GetMask() == Currency::MASK_DOUBLE &&
+				     params[1].IsPositiveInteger())
+			{
+				const hwMatrix* idx = params[0].Matrix();
+				col      = static_cast<int>(params[1].Scalar()) - 1;
+				is_range = IsUnitRange(idx, first) && (first + idx->Size() <= data->M()) &&
+					       (col < data->N());
+				rows     = static_cast<int>(idx->Size());
+			}
+
+			if (is_range)
+			{
+				hwMatrix* view = ContiguousView(data, col * data->M() + first, rows, cols);
+
+				if (view)
+				{
+					Currency out(view);
+					out.SetMask(target.GetMask());
+					return out;
+				}
+			}
+
 			std::vector<double> first_range;
 			std::vector<double> second_range;
 
@@ -1049,10 +1414,10 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
                 else
     			    retm = allocateMatrix(idxm->M(), idxm->N(), hwMatrix::COMPLEX);
 
-                int size_idx = idxm->Size();
-                int size_tgt = mat_n->Size();
+                int64_t size_idx = idxm->Size();
+                int64_t size_tgt = mat_n->Size();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -1082,10 +1447,10 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 
    			    retm->Dimension(idxm->Dimensions(), mat_n->Type());
 
-                int size_idx = idxm->Size();
-                int size_tgt = mat_n->Size();
+                int64_t size_idx = idxm->Size();
+                int64_t size_tgt = mat_n->Size();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -1265,7 +1630,7 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 			{
 				HML_CELLARRAY* cells = param.CellArray();
 
-				for (int k=0; k<cells->Size(); k++)
+				for (int64_t k=0; k<cells->Size(); k++)
 					expanded_params.push_back((*cells)(k));
 			}
 			else
@@ -1587,7 +1952,7 @@ Currency ExprTreeEvaluator::VariableIndex(const Currency& target, const std::vec
 				HML_CELLARRAY* cells = target.CellArray();
 				HML_CELLARRAY* ret = allocateCellArray((int)cells->Size(), 1);
 				
-				for (int j=0; j<cells->Size(); j++)
+				for (int64_t j=0; j<cells->Size(); j++)
 					(*ret)(j) = (*cells)(j);
 
 				return ret;
@@ -1994,104 +2359,760 @@ void ExprTreeEvaluator::ImportFunctionList(const ExprTreeEvaluator *source)
 	_owns_functions = false;
 	class_info_map  = source->class_info_map;
 
-	not_found_functions     = source->not_found_functions;
-	preregistered_functions = source->preregistered_functions;
-}
+	not_found_functions     = source->not_found_functions;
+	preregistered_functions = source->preregistered_functions;
+}
+
+Currency ExprTreeEvaluator::UnaryOperator(OMLTree* tree)
+{
+	int	op = tree->GetType();
+
+	OMLTree* child = tree->GetChild(0);
+	Currency operand = RUN(child);
+
+	return UnaryOperator(operand, op);
+}
+
+Currency ExprTreeEvaluator::UnaryOperator(const Currency& operand, int op)
+{
+	switch(op) 
+	{
+		case UMINUS:
+			{
+				return NegateOperator(operand);
+			}
+		case NEGATE:
+			{
+				Currency ret = NotOperator(operand);
+				ret.SetMask(Currency::MASK_LOGICAL);
+				return ret;
+			}
+		default:
+			{
+				return 0.0;
+			}
+	}
+}
+
+// Returns true if the node is a transpose, A' or A.'
+static bool IsTransposeNode(OMLTree* tree)
+{
+	int type = tree->GetType();
+	return type == TRANSP || type == CTRANSP;
+}
+
+// Returns true if a transpose of the operand can be left to the multiply; for
+// real data the conjugate transpose is the same as the transpose
+static bool IsLazyTransposable(const Currency& op)
+{
+	return op.IsMatrix() && !op.IsScalar() && !op.IsComplex() && op.Matrix()->IsReal();
+}
+
+Currency ExprTreeEvaluator::BinaryOperator(OMLTree* tree)
+{
+	int	oper = tree->GetType();
+
+	int goo = tree->ChildCount();
+
+	// Chains of elementwise operators are evaluated in a single pass
+	if (IsFusableOperator(tree) && (IsFusableOperator(tree->GetChild(0)) || IsFusableOperator(tree->GetChild(1))))
+		return FusedElementwiseOperator(tree);
+
+	// A product with a transposed factor passes the transpose to the multiply
+	if (oper == TIMES && tree->ChildCount() == 2 &&
+		(IsTransposeNode(tree->GetChild(0)) || IsTransposeNode(tree->GetChild(1))))
+	{
+		return TransposedProduct(tree);
+	}
+
+	OMLTree* child = tree->GetChild(0);
+
+	Currency op1 = RUN(child);
+	Currency op2;
+
+	// Handle a parsing irregularity
+	if (tree->ChildCount() == 3)
+	{
+		OMLTree* extra_node = tree->GetChild(1);
+		OMLTree* child2 = tree->GetChild(2);
+		op2 = RUN(child2);
+
+		if (extra_node->GetType() == MINUS)
+			op2 = NegateOperator(op2);
+	}
+	else
+	{
+		OMLTree* child1 = tree->GetChild(1);
+		op2 = RUN(child1);
+	}
+
+	if (op1.GetMask() == Currency::MASK_STRING)
+		op1.SetMask(Currency::MASK_NONE);
+
+	if (op2.GetMask() == Currency::MASK_STRING)
+		op2.SetMask(Currency::MASK_NONE);
+
+	return TemporaryBinaryOperator(op1, op2, oper);
+}
+
+Currency ExprTreeEvaluator::TransposedProduct(OMLTree* tree)
+{
+	OMLTree* left   = tree->GetChild(0);
+	OMLTree* right  = tree->GetChild(1);
+	bool     trans1 = IsTransposeNode(left);
+	bool     trans2 = IsTransposeNode(right);
+
+	OMLTree* factor1 = trans1 ? left->GetChild(0) : left;
+	OMLTree* factor2 = trans2 ? right->GetChild(0) : right;
+
+	Currency op1 = RUN(factor1);
+	Currency op2 = RUN(factor2);
+
+	if (!IsLazyTransposable(op1) || !IsLazyTransposable(op2))
+	{
+		// other operands are transposed first, as for any other product
+		if (trans1)
+			op1 = (left->GetType() == TRANSP) ? TransposeOperator(op1) : ConjTransposeOperator(op1);
+
+		if (trans2)
+			op2 = (right->GetType() == TRANSP) ? TransposeOperator(op2) : ConjTransposeOperator(op2);
+
+		if (op1.GetMask() == Currency::MASK_STRING)
+			op1.SetMask(Currency::MASK_NONE);
+
+		if (op2.GetMask() == Currency::MASK_STRING)
+			op2.SetMask(Currency::MASK_NONE);
+
+		return TemporaryBinaryOperator(op1, op2, TIMES);
+	}
+
+	const hwMatrix* m1 = op1.Matrix();
+	const hwMatrix* m2 = op2.Matrix();
+
+	if ((trans1 ? m1->M() : m1->N()) != (trans2 ? m2->N() : m2->M()))
+		throw OML_Error(HW_ERROR_INCOMPDIM);
+
+	hwMatrix* ret = allocateMatrix();
+	Currency  result(ret);
+
+	hwMathStatus stat = ret->MultTrans(*m1, trans1, *m2, trans2);
+
+	if (!stat.IsOk())
+		throw OML_Error(stat);
+
+	return result;
+}
+
+// Returns the matrix of an operand which is not referenced anywhere else, so
+// it can be overwritten with the result of an operation
+static hwMatrix* GetTemporaryMatrix(Currency& op)
+{
+	if (!op.IsMatrix() || op.IsScalar() || op.IsComplex())
+		return NULL;
+
+	// a shared matrix or a view is checked before asking for write access,
+	// which would detach views and copy data that is not reused here
+	const hwMatrix* mtx = op.Matrix();
+
+	if (mtx->IsMatrixShared() || !mtx->OwnData())
+		return NULL;
+
+	return op.GetWritableMatrix();
+}
+
+static bool IsSameSize(const hwMatrix* m1, const hwMatrix* m2)
+{
+	return m1->M() == m2->M() && m1->N() == m2->N();
+}
+
+Currency ExprTreeEvaluator::TemporaryBinaryOperator(Currency& op1, Currency& op2, int oper)
+{
+	// op1 and op2 are owned by the caller, so a matrix with no other
+	// references is a temporary whose storage can hold the result
+	hwMatrix* tmp1 = GetTemporaryMatrix(op1);
+	hwMatrix* tmp2 = tmp1 ? NULL : GetTemporaryMatrix(op2);
+
+	// Addition and multiplication are commutative, so either side can be reused
+	bool      commutes = (oper == PLUS || oper == TIMES || oper == ETIMES);
+	hwMatrix* target   = (tmp1 || !commutes) ? tmp1 : tmp2;
+	Currency& other    = (target == tmp1) ? op2 : op1;
+	hwMatrix* ret      = NULL;
+
+	hwMathStatus stat;
+
+	if (target)
+	{
+		switch (oper)
+		{
+			case PLUS:
+				if (other.IsScalar())
+				{
+					target->AddEquals(other.Scalar());
+					ret = target;
+				}
+				else if (other.IsComplex())
+				{
+					stat = target->AddEquals(other.Complex());
+					ret  = target;
+				}
+				else if (other.IsMatrix() && IsSameSize(target, other.Matrix()))
+				{
+					stat = target->AddEquals(*other.Matrix());
+					ret  = target;
+				}
+				break;
+			case MINUS:
+				if (other.IsScalar())
+				{
+					target->SubtrEquals(other.Scalar());
+					ret = target;
+				}
+				else if (other.IsComplex())
+				{
+					stat = target->SubtrEquals(other.Complex());
+					ret  = target;
+				}
+				else if (other.IsMatrix() && IsSameSize(target, other.Matrix()))
+				{
+					stat = target->SubtrEquals(*other.Matrix());
+					ret  = target;
+				}
+				break;
+			case TIMES:
+			case ETIMES:
+				if (other.IsScalar())
+				{
+					target->MultEquals(other.Scalar());
+					ret = target;
+				}
+				else if (other.IsComplex())
+				{
+					stat = target->MultEquals(other.Complex());
+					ret  = target;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	if (!ret)
+		return BinaryOperator(op1, op2, oper);
+
+	if (!stat.IsOk())
+		throw OML_Error(stat);
+
+	ret->IncrRefCount();
+	return ret;
+}
+
+bool ExprTreeEvaluator::IsFusableOperator(OMLTree* tree) const
+{
+	switch (tree->GetType())
+	{
+		case TIMES:
+			// A product with a transposed factor is left to TransposedProduct
+			return tree->ChildCount() == 2 && !IsTransposeNode(tree->GetChild(0)) &&
+				   !IsTransposeNode(tree->GetChild(1));
+		case PLUS:
+		case MINUS:
+		case ETIMES:
+		case DIV:
+		case EDIV:
+			return tree->ChildCount() == 2;
+		case UMINUS:
+			return tree->ChildCount() == 1;
+		default:
+			return false;
+	}
+}
+
+Currency ExprTreeEvaluator::FusedElementwiseOperator(OMLTree* tree)
+{
+	// Operands are evaluated in the same order as the unfused operators would
+	std::vector<Currency> operands;
+	GatherFusedOperands(tree, operands, true);
+
+	FusedElementwise expr;
+	size_t           index = 0;
+	int              m     = -1;
+	int              n     = -1;
+	int              root  = BuildFusedExpression(tree, operands, index, expr, m, n);
+
+	if (root >= 0)
+	{
+		if (expr.IsScalar(root))
+			return expr.ScalarValue(root);
+
+		hwMatrix* ret = allocateMatrix(m, n, hwMatrix::REAL);
+		expr.Evaluate(root, ret->GetRealData(), ret->Size());
+		return ret;
+	}
+
+	// Anything else (complex data, ND matrices, objects, mismatched
+	// dimensions, matrix products) goes through the regular operators
+	index = 0;
+	return EvaluateFusedOperands(tree, operands, index);
+}
+
+void ExprTreeEvaluator::GatherFusedOperands(OMLTree* tree, std::vector<Currency>& operands, bool numeric)
+{
+	if (IsFusableOperator(tree))
+	{
+		// Binary operators treat strings as numbers, unary minus does not
+		bool binary = (tree->GetType() != UMINUS);
+
+		for (int j = 0; j < tree->ChildCount(); ++j)
+			GatherFusedOperands(tree->GetChild(j), operands, binary);
+
+		return;
+	}
+
+	Currency op = RUN(tree);
+
+	if (numeric && op.GetMask() == Currency::MASK_STRING)
+		op.SetMask(Currency::MASK_NONE);
+
+	operands.push_back(op);
+}
+
+int ExprTreeEvaluator::BuildFusedExpression(OMLTree* tree, const std::vector<Currency>& operands, size_t& index,
+	                                        FusedElementwise& expr, int& m, int& n) const
+{
+	if (!IsFusableOperator(tree))
+	{
+		const Currency& op = operands[index++];
+
+		if (op.IsScalar())
+			return expr.AddScalar(op.Scalar());
+
+		if (!op.IsMatrix() || !op.Matrix()->IsReal())
+			return -1;
+
+		const hwMatrix* mtx = op.Matrix();
+
+		if (m < 0)
+		{
+			m = mtx->M();
+			n = mtx->N();
+		}
+		else if (mtx->M() != m || mtx->N() != n)
+		{
+			return -1;
+		}
+
+		return expr.AddArray(mtx->GetRealData());
+	}
+
+	int type = tree->GetType();
+	int lhs  = BuildFusedExpression(tree->GetChild(0), operands, index, expr, m, n);
+
+	if (lhs < 0)
+		return -1;
+
+	if (type == UMINUS)
+		return expr.AddOperation(FusedElementwise::OP_NEGATE, lhs);
+
+	int rhs = BuildFusedExpression(tree->GetChild(1), operands, index, expr, m, n);
+
+	if (rhs < 0)
+		return -1;
+
+	switch (type)
+	{
+		case PLUS:
+			return expr.AddOperation(FusedElementwise::OP_ADD, lhs, rhs);
+		case MINUS:
+			return expr.AddOperation(FusedElementwise::OP_SUBTRACT, lhs, rhs);
+		case ETIMES:
+			return expr.AddOperation(FusedElementwise::OP_MULTIPLY, lhs, rhs);
+		case EDIV:
+			return expr.AddOperation(FusedElementwise::OP_DIVIDE, lhs, rhs);
+		case TIMES:
+			// Elementwise only if one side is a scalar
+			if (!expr.IsScalar(lhs) && !expr.IsScalar(rhs))
+				return -1;
+			return expr.AddOperation(FusedElementwise::OP_MULTIPLY, lhs, rhs);
+		case DIV:
+			if (!expr.IsScalar(rhs))
+				return -1;
+			return expr.AddOperation(FusedElementwise::OP_DIVIDE, lhs, rhs);
+		default:
+			return -1;
+	}
+}
+
+Currency ExprTreeEvaluator::EvaluateFusedOperands(OMLTree* tree, std::vector<Currency>& operands, size_t& index)
+{
+	// Operands are moved out so the operators can reuse their storage
+	if (!IsFusableOperator(tree))
+		return std::move(operands[index++]);
+
+	if (tree->GetType() == UMINUS)
+		return UnaryOperator(EvaluateFusedOperands(tree->GetChild(0), operands, index), UMINUS);
+
+	Currency op1 = EvaluateFusedOperands(tree->GetChild(0), operands, index);
+	Currency op2 = EvaluateFusedOperands(tree->GetChild(1), operands, index);
+
+	return TemporaryBinaryOperator(op1, op2, tree->GetType());
+}
+
+Currency ExprTreeEvaluator::BinaryOperator(const Currency& lhs, const Currency& rhs, int oper)
+{
+	if (lhs.IsSparse() || rhs.IsSparse())
+		return SparseBinaryOperator(lhs, rhs, oper);
+
+	if (lhs.IsIntegerType() || rhs.IsIntegerType())
+		return IntegerBinaryOperator(lhs, rhs, oper);
+
+	if (lhs.IsSingle() || rhs.IsSingle())
+		return SingleBinaryOperator(lhs, rhs, oper);
+
+	switch(oper) 
+	{
+		case PLUS:
+			return AddOperator(lhs, rhs);
+		case MINUS:
+			return SubtractOperator(lhs, rhs);
+		case TIMES:
+			return MultiplyOperator(lhs, rhs);
+		case ETIMES:
+			return EntrywiseMultiplyOperator(lhs, rhs);
+		case DIV:		
+			return DivideOperator(lhs, rhs);
+		case EDIV:
+			return EntrywiseDivideOperator(lhs, rhs);
+		case LDIV:					
+			return LeftDivideOperator(lhs, rhs);
+		case ELDIV:
+			return EntrywiseLeftDivideOperator(lhs, rhs);
+		case POW:
+			return PowOperator(lhs, rhs);
+		case DOTPOW:
+			return EntrywisePowOperator(lhs, rhs);
+		default:
+			return Currency();
+	}
+}
+
+// Expands a sparse matrix into a dense one
+static Currency SparseToFull(const hwMatrixS* mtxs)
+{
+	hwMatrix* full = ExprTreeEvaluator::allocateMatrix();
+	Currency  ret(full);
+
+	hwMathStatus stat = mtxs->Full(*full);
+
+	if (!stat.IsOk())
+		throw OML_Error(stat);
+
+	return ret;
+}
+
+Currency ExprTreeEvaluator::SparseBinaryOperator(const Currency& op1, const Currency& op2, int oper)
+{
+	const hwMatrixS* s1 = op1.IsSparse() ? op1.MatrixS() : NULL;
+	const hwMatrixS* s2 = op2.IsSparse() ? op2.MatrixS() : NULL;
+
+	// real dense operands, which can be combined with sparse ones directly
+	const hwMatrix* d1 = (op1.IsMatrix() && op1.Matrix()->IsReal()) ? op1.Matrix() : NULL;
+	const hwMatrix* d2 = (op2.IsMatrix() && op2.Matrix()->IsReal()) ? op2.Matrix() : NULL;
+
+	// a nonzero finite scalar keeps the zeros of a sparse matrix zero
+	bool scale1 = op1.IsScalar() && op1.Scalar() != 0.0 && IsFinite_T(op1.Scalar());
+	bool scale2 = op2.IsScalar() && op2.Scalar() != 0.0 && IsFinite_T(op2.Scalar());
+
+	hwMatrixS*   sparse = NULL;
+	hwMatrix*    dense  = NULL;
+	Currency     ret;
+	hwMathStatus stat;
+
+	switch (oper)
+	{
+		case PLUS:
+		case MINUS:
+			if (s1 && s2)
+			{
+				ret  = sparse = new hwMatrixS;
+				stat = (oper == PLUS) ? sparse->Add(*s1, *s2) : sparse->Subtr(*s1, *s2);
+			}
+			break;
+		case TIMES:
+		case ETIMES:
+			if (s1 && s2)
+			{
+				ret  = sparse = new hwMatrixS;
+				stat = (oper == TIMES) ? sparse->Mult(*s1, *s2) : sparse->MultByElems(*s1, *s2);
+			}
+			else if (s1 && op2.IsScalar())
+			{
+				ret  = sparse = new hwMatrixS;
+				stat = sparse->Mult(*s1, op2.Scalar());
+			}
+			else if (op1.IsScalar() && s2)
+			{
+				ret  = sparse = new hwMatrixS;
+				stat = sparse->Mult(*s2, op1.Scalar());
+			}
+			else if (s1 && d2)
+			{
+				if (oper == TIMES)
+				{
+					ret  = dense = allocateMatrix();
+					stat = s1->MultRight(*d2, *dense);
+				}
+				else
+				{
+					ret  = sparse = new hwMatrixS;
+					stat = sparse->MultByElems(*s1, *d2);
+				}
+			}
+			else if (d1 && s2)
+			{
+				if (oper == TIMES)
+				{
+					ret  = dense = allocateMatrix();
+					stat = s2->MultLeft(*d1, *dense);
+				}
+				else
+				{
+					ret  = sparse = new hwMatrixS;
+					stat = sparse->MultByElems(*s2, *d1);
+				}
+			}
+			break;
+		case DIV:
+		case EDIV:
+			if (s1 && scale2)
+			{
+				ret  = sparse = new hwMatrixS;
+				stat = sparse->Mult(*s1, 1.0 / op2.Scalar());
+			}
+			break;
+		case LDIV:
+			if (s1 && (op2.IsMatrix() || s2))
+			{
+				Currency rhs = s2 ? SparseToFull(s2) : op2;
+
+				ret  = dense = allocateMatrix();
+				stat = s1->LSolve(*rhs.Matrix(), *dense);
+			}
+			else if (scale1 && s2)
+			{
+				ret  = sparse = new hwMatrixS;
+				stat = sparse->Mult(*s2, 1.0 / op1.Scalar());
+			}
+			break;
+		case ELDIV:
+			if (scale1 && s2)
+			{
+				ret  = sparse = new hwMatrixS;
+				stat = sparse->Mult(*s2, 1.0 / op1.Scalar());
+			}
+			break;
+		default:
+			break;
+	}
+
+	if (sparse || dense)
+	{
+		if (stat.IsWarning())
+		{
+			stat.ResetArgs();   // suppress argument numbers because operators have no argument list
+			EvaluatorInterface eval(this);
+			BuiltInFuncsUtils::SetWarning(eval, stat.GetMessage());
+		}
+		else if (stat.GetMsgCode() == HW_MATH_ERR_ARRAYSIZE)
+		{
+			throw OML_Error(HW_ERROR_INCOMPDIM);
+		}
+		else if (!stat.IsOk())
+		{
+			throw OML_Error(stat);
+		}
+
+		return ret;
+	}
+
+	// Any other combination has a dense result, so the sparse operands are
+	// expanded and the dense operators are used
+	Currency full1 = s1 ? SparseToFull(s1) : op1;
+	Currency full2 = s2 ? SparseToFull(s2) : op2;
+
+	return BinaryOperator(full1, full2, oper);
+}
+
+Currency ExprTreeEvaluator::SingleBinaryOperator(const Currency& op1, const Currency& op2, int oper)
+{
+	// Operations mixing single and double values are done in single precision
+	bool numeric1 = op1.IsSingle() || op1.IsScalar() || op1.IsComplex() || op1.IsMatrix() || op1.IsString();
+	bool numeric2 = op2.IsSingle() || op2.IsScalar() || op2.IsComplex() || op2.IsMatrix() || op2.IsString();
+
+	if (!numeric1 || !numeric2)
+		throw OML_Error(HW_ERROR_UNSUPOP);
+
+	Currency cur1 = op1.ToSingle();
+	Currency cur2 = op2.ToSingle();
+
+	const hwMatrixF* A = cur1.MatrixF();
+	const hwMatrixF* B = cur2.MatrixF();
+
+	bool scalar1  = A->Size() == 1;
+	bool scalar2  = B->Size() == 1;
+	bool sameSize = A->M() == B->M() && A->N() == B->N();
+
+	hwMatrixF*   result = new hwMatrixF;
+	Currency     ret(result);
+	hwMathStatus stat;
+	bool         done = true;
+
+	switch (oper)
+	{
+		case PLUS:
+			if (scalar1 && !scalar2)
+				stat = A->IsReal() ? result->Add(*B, (*A)(0)) : result->Add(*B, A->z(0));
+			else if (scalar2)
+				stat = B->IsReal() ? result->Add(*A, (*B)(0)) : result->Add(*A, B->z(0));
+			else if (sameSize)
+				stat = result->Add(*A, *B);
+			else
+				done = false;
+			break;
+		case MINUS:
+			if (scalar1 && !scalar2)
+				stat = A->IsReal() ? result->Subtr((*A)(0), *B) : result->Subtr(A->z(0), *B);
+			else if (scalar2)
+				stat = B->IsReal() ? result->Subtr(*A, (*B)(0)) : result->Subtr(*A, B->z(0));
+			else if (sameSize)
+				stat = result->Subtr(*A, *B);
+			else
+				done = false;
+			break;
+		case TIMES:
+		case ETIMES:
+			if (scalar1 && !scalar2)
+				stat = A->IsReal() ? result->Mult(*B, (*A)(0)) : result->Mult(*B, A->z(0));
+			else if (scalar2)
+				stat = B->IsReal() ? result->Mult(*A, (*B)(0)) : result->Mult(*A, B->z(0));
+			else if (oper == TIMES)
+				stat = result->Mult(*A, *B);
+			else if (sameSize)
+				stat = result->MultByElems(*A, *B);
+			else
+				done = false;
+			break;
+		case DIV:
+		case EDIV:
+			if (scalar2)
+				stat = B->IsReal() ? result->Divide(*A, (*B)(0)) : result->Divide(*A, B->z(0));
+			else if (oper == EDIV && scalar1)
+				stat = A->IsReal() ? result->Divide((*A)(0), *B) : result->Divide(A->z(0), *B);
+			else if (oper == EDIV && sameSize)
+				stat = result->DivideByElems(*A, *B);
+			else
+				done = false;
+			break;
+		default:
+			done = false;
+			break;
+	}
+
+	if (done)
+	{
+		if (stat.GetMsgCode() == HW_MATH_ERR_ARRAYSIZE)
+			throw OML_Error(HW_ERROR_INCOMPDIM);
+		else if (!stat.IsOk() && !stat.IsWarning())
+			throw OML_Error(stat);
 
-Currency ExprTreeEvaluator::UnaryOperator(OMLTree* tree)
-{
-	int	op = tree->GetType();
+		return ret;
+	}
 
-	OMLTree* child = tree->GetChild(0);
-	Currency operand = RUN(child);
+	// Any other operation, such as a solve or an expansion of mismatched
+	// dimensions, is done in double precision and rounded to single
+	Currency dbl = BinaryOperator(op1.ToDouble(), op2.ToDouble(), oper);
 
-	return UnaryOperator(operand, op);
+	return dbl.IsNDMatrix() ? dbl : dbl.ToSingle();
 }
 
-Currency ExprTreeEvaluator::UnaryOperator(const Currency& operand, int op)
+// Returns true if an integer or double operand has a single element
+static bool IsScalarOperand(const Currency& cur)
 {
-	switch(op) 
+	if (cur.IsIntegerType())
 	{
-		case UMINUS:
-			{
-				return NegateOperator(operand);
-			}
-		case NEGATE:
-			{
-				Currency ret = NotOperator(operand);
-				ret.SetMask(Currency::MASK_LOGICAL);
-				return ret;
-			}
-		default:
-			{
-				return 0.0;
-			}
+		int m, n;
+		cur.IntegerDims(m, n);
+		return m * n == 1;
 	}
+
+	return cur.IsScalar() || (cur.IsMatrix() && cur.Matrix()->Size() == 1);
 }
 
-Currency ExprTreeEvaluator::BinaryOperator(OMLTree* tree)
+Currency ExprTreeEvaluator::IntegerBinaryOperator(const Currency& op1, const Currency& op2, int oper)
 {
-	int	oper = tree->GetType();
+	// Integers combine with integers of the same class and with real double
+	// or single values; the result keeps the integer class
+	int int_type = op1.IsIntegerType() ? op1.GetType() : op2.GetType();
 
-	int goo = tree->ChildCount();
+	if (op1.IsIntegerType() && op2.IsIntegerType() && op1.GetType() != op2.GetType())
+		throw OML_Error(HW_ERROR_INTEGERCLASS);
 
-	OMLTree* child = tree->GetChild(0);
+	Currency cur1 = op1.IsSingle() ? op1.ToDouble() : op1;
+	Currency cur2 = op2.IsSingle() ? op2.ToDouble() : op2;
 
-	Currency op1 = RUN(child);
-	Currency op2;
+	// N-D operands are only supported through the double precision path
+	bool elementwise = true;
 
-	// Handle a parsing irregularity
-	if (tree->ChildCount() == 3)
+	for (int k = 0; k < 2; ++k)
 	{
-		OMLTree* extra_node = tree->GetChild(1);
-		OMLTree* child2 = tree->GetChild(2);
-		op2 = RUN(child2);
+		const Currency& cur = k ? cur2 : cur1;
 
-		if (extra_node->GetType() == MINUS)
-			op2 = NegateOperator(op2);
+		if (cur.IsNDMatrix())
+			elementwise = false;
+		else if (!cur.IsIntegerType() && !cur.IsScalar() && !(cur.IsMatrix() && cur.Matrix()->IsReal()))
+			throw OML_Error(HW_ERROR_INTEGERCLASS);
 	}
-	else
+
+	Currency ret;
+	bool     done = false;
+
+	if (elementwise)
 	{
-		OMLTree* child1 = tree->GetChild(1);
-		op2 = RUN(child1);
+		switch (oper)
+		{
+			case PLUS:
+				done = IntegerArithmetic::Elementwise(cur1, cur2, IntegerArithmetic::OP_ADD, ret);
+				break;
+			case MINUS:
+				done = IntegerArithmetic::Elementwise(cur1, cur2, IntegerArithmetic::OP_SUBTRACT, ret);
+				break;
+			case ETIMES:
+				done = IntegerArithmetic::Elementwise(cur1, cur2, IntegerArithmetic::OP_MULTIPLY, ret);
+				break;
+			case TIMES:
+				// matrix products are done in double precision below
+				if (IsScalarOperand(cur1) || IsScalarOperand(cur2))
+					done = IntegerArithmetic::Elementwise(cur1, cur2, IntegerArithmetic::OP_MULTIPLY, ret);
+				break;
+			case EDIV:
+				done = IntegerArithmetic::Elementwise(cur1, cur2, IntegerArithmetic::OP_DIVIDE, ret);
+				break;
+			case DIV:
+				if (IsScalarOperand(cur2))
+					done = IntegerArithmetic::Elementwise(cur1, cur2, IntegerArithmetic::OP_DIVIDE, ret);
+				break;
+			default:
+				break;
+		}
 	}
 
-	if (op1.GetMask() == Currency::MASK_STRING)
-		op1.SetMask(Currency::MASK_NONE);
-
-	if (op2.GetMask() == Currency::MASK_STRING)
-		op2.SetMask(Currency::MASK_NONE);
+	if (done)
+		return ret;
 
-	return BinaryOperator(op1, op2, oper);
-}
+	// Any other operation, such as a power or an expansion of mismatched
+	// dimensions, is done in double precision, then rounded and saturated
+	Currency dbl = BinaryOperator(cur1.ToDouble(), cur2.ToDouble(), oper);
 
-Currency ExprTreeEvaluator::BinaryOperator(const Currency& lhs, const Currency& rhs, int oper)
-{
-	switch(oper) 
-	{
-		case PLUS:
-			return AddOperator(lhs, rhs);
-		case MINUS:
-			return SubtractOperator(lhs, rhs);
-		case TIMES:
-			return MultiplyOperator(lhs, rhs);
-		case ETIMES:
-			return EntrywiseMultiplyOperator(lhs, rhs);
-		case DIV:		
-			return DivideOperator(lhs, rhs);
-		case EDIV:
-			return EntrywiseDivideOperator(lhs, rhs);
-		case LDIV:					
-			return LeftDivideOperator(lhs, rhs);
-		case ELDIV:
-			return EntrywiseLeftDivideOperator(lhs, rhs);
-		case POW:
-			return PowOperator(lhs, rhs);
-		case DOTPOW:
-			return EntrywisePowOperator(lhs, rhs);
-		default:
-			return Currency();
-	}
+	return dbl.IsNDMatrix() ? dbl : dbl.ToInteger(int_type);
 }
 
 Currency ExprTreeEvaluator::AddOperator(const Currency& op1,const Currency& op2)
@@ -2722,6 +3743,10 @@ Currency ExprTreeEvaluator::LeftDivideOperator(const Currency& op1, const Curren
 		const hwMatrix* m2 = op2.Matrix();
 
 		hwMatrix* ret = allocateMatrix();
+
+		if (CachedLeftDivide(op1, *m2, *ret))
+			return ret;
+
 		stat = ret->DivideLeft(*m1,*m2);
 
 		if (stat.IsOk())
@@ -2738,6 +3763,33 @@ Currency ExprTreeEvaluator::LeftDivideOperator(const Currency& op1, const Curren
 		else
 			throw OML_Error(HW_ERROR_INCOMPDIM);
 	}
+	else if (op1.IsDecomposition() && (op2.IsScalar() || op2.IsComplex() || op2.IsMatrix()))
+	{
+		const Decomposition* decomp = op1.GetDecomposition();
+		const hwMatrix*      m2     = op2.ConvertToMatrix();
+
+		hwMatrix* ret = allocateMatrix();
+		Currency  out(ret);
+
+		hwSolverPath::Reset();
+		hwSolverPath::Add(("decomposition " + decomp->GetType()).c_str());
+
+		stat = decomp->Solve(*m2, *ret);
+
+		if (stat.IsOk())
+		{
+			return out;
+		}
+		else if (stat.IsWarning())
+		{
+			stat.ResetArgs();   // suppress argument numbers because A\b has no argument list
+			EvaluatorInterface eval(this);
+			BuiltInFuncsUtils::SetWarning(eval, stat.GetMessage());
+			return out;
+		}
+		else
+			throw OML_Error(HW_ERROR_INCOMPDIM);
+	}
 	else if (!op1.IsNDMatrix() && op2.IsNDMatrix())
 	{
 		return oml_MatrixNUtil7(op1, op2, &ExprTreeEvaluator::LeftDivideOperator);
@@ -2752,6 +3804,91 @@ Currency ExprTreeEvaluator::LeftDivideOperator(const Currency& op1, const Curren
 	}
 }
 
+bool ExprTreeEvaluator::CachedLeftDivide(const Currency& A, const hwMatrix& B, hwMatrix& X)
+{
+	const hwMatrix* mtx = A.Matrix();
+	int             n   = mtx->M();
+
+	if (n < FACTOR_CACHE_MIN_SIZE || mtx->N() != n || !mtx->IsReal() || B.M() != n)
+		return false;
+
+	// the factors take as many bytes as the matrix
+	if (static_cast<size_t>(n) * n * sizeof(double) > FACTOR_CACHE_BYTES)
+		return false;
+
+	ReleaseUnusedFactors();
+
+	std::list<Currency>::iterator hit = _factor_cache->begin();
+
+	while (hit != _factor_cache->end() && hit->GetDecomposition()->GetMatrix().Matrix() != mtx)
+		++hit;
+
+	hwSolverPath::Reset();
+
+	if (hit == _factor_cache->end())
+	{
+		int kl;
+		int ku;
+
+		// triangular and banded systems are solved without factoring the
+		// full matrix
+		mtx->Bandwidth(kl, ku);
+
+		if (kl == 0 || ku == 0 || hwMatrix::IsNarrowBand(n, kl, ku))
+			return false;
+
+		Decomposition* decomp = new Decomposition(A);
+		Currency       factors(decomp);
+
+		// singular and ill-conditioned matrices are left to DivideLeft, which
+		// warns and falls back to the pseudoinverse
+		if (!decomp->IsFactored())
+			return false;
+
+		_factor_cache->push_front(factors);
+
+		size_t bytes = 0;
+
+		for (std::list<Currency>::iterator iter = _factor_cache->begin(); iter != _factor_cache->end(); ++iter)
+			bytes += iter->GetDecomposition()->GetBytes();
+
+		while (_factor_cache->size() > FACTOR_CACHE_SIZE || bytes > FACTOR_CACHE_BYTES)
+		{
+			bytes -= _factor_cache->back().GetDecomposition()->GetBytes();
+			_factor_cache->pop_back();
+		}
+
+		hwSolverPath::Add(decomp->GetType().c_str());
+	}
+	else
+	{
+		_factor_cache->splice(_factor_cache->begin(), *_factor_cache, hit);
+		hwSolverPath::Add(("cached " + hit->GetDecomposition()->GetType()).c_str());
+	}
+
+	hwMathStatus stat = _factor_cache->front().GetDecomposition()->Solve(B, X);
+
+	if (!stat.IsOk())
+		throw OML_Error(stat);
+
+	return true;
+}
+
+void ExprTreeEvaluator::ReleaseUnusedFactors()
+{
+	// an entry whose matrix is referenced only by the cache can never match
+	// an operand again
+	std::list<Currency>::iterator iter = _factor_cache->begin();
+
+	while (iter != _factor_cache->end())
+	{
+		if (iter->GetDecomposition()->GetMatrix().Matrix()->GetRefCount() == 1)
+			iter = _factor_cache->erase(iter);
+		else
+			++iter;
+	}
+}
+
 Currency ExprTreeEvaluator::EntrywiseLeftDivideOperator(const Currency& op1, const Currency& op2)
 {
 	hwMathStatus stat;
@@ -2874,6 +4011,13 @@ bool ExprTreeEvaluator::EqualityHelper(const Currency& lhs, const Currency& rhs)
 
 Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Currency& op2)
 {
+	if (op1.IsSingle() || op2.IsSingle() || op1.IsIntegerType() || op2.IsIntegerType())
+		return EqualityOperatorEx(op1.ToDouble(), op2.ToDouble());
+
+	Currency packed;
+	if (LogicalArray::Compare(op1, op2, LogicalArray::CMP_EQ, packed))
+		return packed;
+
 	if (op1.IsScalar() && op2.IsScalar())
 	{
 		return op1.Scalar() == op2.Scalar();
@@ -2893,12 +4037,12 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 
 		if (m2->IsReal())
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = (op1.Scalar() == (*m2)(j));
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = EqualityHelper(op1, m2->z(j));
 		}
 
@@ -2909,7 +4053,7 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 		const hwMatrix* m2 = op2.Matrix();
 		hwMatrix* result = allocateMatrix(m2->M(), m2->N(), hwMatrix::REAL);
 
-		for (int j=0; j<m2->Size(); j++)
+		for (int64_t j=0; j<m2->Size(); j++)
 		{
 			if (m2->IsReal())
 				(*result)(j) = EqualityHelper(op1, (*m2)(j));
@@ -2928,7 +4072,7 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 
 		hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-		int max_idx = m1->Size();
+		int64_t max_idx = m1->Size();
 		double oper2  = op2.Scalar();
 
 		if (m1->IsReal())
@@ -2953,7 +4097,7 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 
 		hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-		for (int j=0; j<m1->Size(); j++)
+		for (int64_t j=0; j<m1->Size(); j++)
 		{
 			if (m1->IsReal())
 				(*result)(j) = EqualityHelper((*m1)(j), op2);
@@ -2974,22 +4118,22 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 
 			if (m1->IsReal() && m2->IsReal())
 			{
-				for (int j=0; j<m1->Size(); j++)
+				for (int64_t j=0; j<m1->Size(); j++)
 					(*result)(j) = ((*m1)(j) == (*m2)(j));
 			}
 			else if (m1->IsReal() && !m2->IsReal())
 			{
-				for (int j=0; j<m1->Size(); j++)			
+				for (int64_t j=0; j<m1->Size(); j++)			
 					(*result)(j) = EqualityHelper((*m1)(j), m2->z(j));
 			}
 			else if (!m1->IsReal() && m2->IsReal())
 			{
-				for (int j=0; j<m1->Size(); j++)			
+				for (int64_t j=0; j<m1->Size(); j++)			
 					(*result)(j) = EqualityHelper((*m2)(j), m1->z(j));
 			}
 			else if (!m1->IsReal() && !m2->IsReal())
 			{
-				for (int j=0; j<m1->Size(); j++)			
+				for (int64_t j=0; j<m1->Size(); j++)			
 					(*result)(j) = EqualityHelper(m1->z(j), m2->z(j));
 			}
 
@@ -3020,7 +4164,7 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 		{
 			hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 			{
 				Currency lhs;
 				Currency rhs;
@@ -3044,7 +4188,7 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 		{
 			hwMatrix* result = allocateMatrix(m2->M(), m2->N(), hwMatrix::REAL);
 
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = EqualityHelper((*m1)(0), (*m2)(j));
 
 			return result;
@@ -3053,7 +4197,7 @@ Currency ExprTreeEvaluator::EqualityOperatorEx(const Currency& op1, const Curren
 		{
 			hwMatrix* result = allocateMatrix(m1->M(), m1->N(), m1->Type());
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = EqualityHelper((*m1)(j), (*m2)(0));
 
 			return result;
@@ -3101,6 +4245,10 @@ Currency ExprTreeEvaluator::EqualityOperator(const Currency& lhs, const Currency
 	if (op == NEQUAL)
 		opposite = true;
 
+	Currency packed;
+	if (LogicalArray::Compare(lhs, rhs, opposite ? LogicalArray::CMP_NE : LogicalArray::CMP_EQ, packed))
+		return packed;
+
 	Currency result = EqualityOperatorEx(lhs, rhs);
 
 	if (opposite)
@@ -3131,6 +4279,13 @@ Currency ExprTreeEvaluator::LessThanOperator(OMLTree* tree)
 
 Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency& op2)
 {
+	if (op1.IsSingle() || op2.IsSingle() || op1.IsIntegerType() || op2.IsIntegerType())
+		return LessThanOperator(op1.ToDouble(), op2.ToDouble());
+
+	Currency packed;
+	if (LogicalArray::Compare(op1, op2, LogicalArray::CMP_LT, packed))
+		return packed;
+
 	if (op1.IsScalar() && op2.IsScalar())
 	{
 		return op1.Scalar() < op2.Scalar();
@@ -3152,12 +4307,12 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 
 		if (m2->IsReal())
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs < (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs < m2->z(j).Mag();
 		}
 
@@ -3172,12 +4327,12 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 
 		if (m2->IsReal())		
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs < (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs < m2->z(j).Mag();
 		}
 
@@ -3192,12 +4347,12 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) < rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() < rhs;
 		}
 
@@ -3212,12 +4367,12 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) < rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() < rhs;
 		}
 
@@ -3236,12 +4391,12 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) < (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) < m2->z(j).Mag();
 				}
 			}
@@ -3249,12 +4404,12 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() < (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() < m2->z(j).Mag();
 				}
 			}
@@ -3286,7 +4441,7 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 		{
 			hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) < (*m2)(j);
 
 			return result;
@@ -3297,7 +4452,7 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 
 			double lhs = (*m1)(0);
 
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs < (*m2)(j);
 
 			return result;
@@ -3308,7 +4463,7 @@ Currency ExprTreeEvaluator::LessThanOperator(const Currency& op1, const Currency
 
 			double rhs = (*m2)(0);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) < rhs;
 
 			return result;
@@ -3345,6 +4500,13 @@ Currency ExprTreeEvaluator::GreaterThanOperator(OMLTree* tree)
 
 Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Currency& op2)
 {
+	if (op1.IsSingle() || op2.IsSingle() || op1.IsIntegerType() || op2.IsIntegerType())
+		return GreaterThanOperator(op1.ToDouble(), op2.ToDouble());
+
+	Currency packed;
+	if (LogicalArray::Compare(op1, op2, LogicalArray::CMP_GT, packed))
+		return packed;
+
 	if (op1.IsScalar() && op2.IsScalar())
 	{
 		return op1.Scalar() > op2.Scalar();
@@ -3366,12 +4528,12 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 
 		if (m2->IsReal())
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs > (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs > m2->z(j).Mag();
 		}
 
@@ -3386,12 +4548,12 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 
 		if (m2->IsReal())		
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs > (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs > m2->z(j).Mag();
 		}
 
@@ -3406,12 +4568,12 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) > rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() > rhs;
 		}
 
@@ -3426,12 +4588,12 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) > rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() > rhs;
 		}
 
@@ -3450,12 +4612,12 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) > (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) > m2->z(j).Mag();
 				}
 			}
@@ -3463,12 +4625,12 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() > (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() > m2->z(j).Mag();
 				}
 			}
@@ -3500,7 +4662,7 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 		{
 			hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) > (*m2)(j);
 
 			return result;
@@ -3511,7 +4673,7 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 
 			double lhs = (*m1)(0);
 
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs > (*m2)(j);
 
 			return result;
@@ -3522,7 +4684,7 @@ Currency ExprTreeEvaluator::GreaterThanOperator(const Currency& op1, const Curre
 
 			double rhs = (*m2)(0);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) > rhs;
 
 			return result;
@@ -3560,6 +4722,13 @@ Currency ExprTreeEvaluator::LessEqualOperator(OMLTree* tree)
 
 Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currency& op2)
 {
+	if (op1.IsSingle() || op2.IsSingle() || op1.IsIntegerType() || op2.IsIntegerType())
+		return LessEqualOperator(op1.ToDouble(), op2.ToDouble());
+
+	Currency packed;
+	if (LogicalArray::Compare(op1, op2, LogicalArray::CMP_LE, packed))
+		return packed;
+
 	if (op1.IsScalar() && op2.IsScalar())
 	{
 		return op1.Scalar() <= op2.Scalar();
@@ -3581,12 +4750,12 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 
 		if (m2->IsReal())
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs <= (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs <= m2->z(j).Mag();
 		}
 
@@ -3601,12 +4770,12 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 
 		if (m2->IsReal())		
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs <= (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs <= m2->z(j).Mag();
 		}
 
@@ -3621,12 +4790,12 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) <= rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() <= rhs;
 		}
 
@@ -3641,12 +4810,12 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) <= rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() <= rhs;
 		}
 
@@ -3665,12 +4834,12 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) <= (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) <= m2->z(j).Mag();
 				}
 			}
@@ -3678,12 +4847,12 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() <= (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() <= m2->z(j).Mag();
 				}
 			}
@@ -3715,7 +4884,7 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 		{
 			hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) <= (*m2)(j);
 
 			return result;
@@ -3726,7 +4895,7 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 
 			double lhs = (*m1)(0);
 
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs <= (*m2)(j);
 
 			return result;
@@ -3737,7 +4906,7 @@ Currency ExprTreeEvaluator::LessEqualOperator(const Currency& op1, const Currenc
 
 			double rhs = (*m2)(0);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) <= rhs;
 
 			return result;
@@ -3774,6 +4943,13 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(OMLTree* tree)
 
 Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Currency& op2)
 {
+	if (op1.IsSingle() || op2.IsSingle() || op1.IsIntegerType() || op2.IsIntegerType())
+		return GreaterEqualOperator(op1.ToDouble(), op2.ToDouble());
+
+	Currency packed;
+	if (LogicalArray::Compare(op1, op2, LogicalArray::CMP_GE, packed))
+		return packed;
+
 	if (op1.IsScalar() && op2.IsScalar())
 	{
 		return op1.Scalar() >= op2.Scalar();
@@ -3795,12 +4971,12 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 
 		if (m2->IsReal())
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs >= (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs >= m2->z(j).Mag();
 		}
 
@@ -3815,12 +4991,12 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 
 		if (m2->IsReal())		
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs >= (*m2)(j);
 		}
 		else
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs >= m2->z(j).Mag();
 		}
 
@@ -3835,12 +5011,12 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) >= rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() >= rhs;
 		}
 
@@ -3855,12 +5031,12 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) >= rhs;
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = m1->z(j).Mag() >= rhs;
 		}
 
@@ -3879,12 +5055,12 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) >= (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = (*m1)(j) >= m2->z(j).Mag();
 				}
 			}
@@ -3892,12 +5068,12 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 			{
 				if (m2->IsReal())
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() >= (*m2)(j);
 				}
 				else
 				{
-					for (int j=0; j<m1->Size(); j++)
+					for (int64_t j=0; j<m1->Size(); j++)
 						(*result)(j) = m1->z(j).Mag() >= m2->z(j).Mag();
 				}
 			}
@@ -3929,7 +5105,7 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 		{
 			hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) >= (*m2)(j);
 
 			return result;
@@ -3940,7 +5116,7 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 
 			double lhs = (*m1)(0);
 
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = lhs >= (*m2)(j);
 
 			return result;
@@ -3951,7 +5127,7 @@ Currency ExprTreeEvaluator::GreaterEqualOperator(const Currency& op1, const Curr
 
 			double rhs = (*m2)(0);
 
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = (*m1)(j) >= rhs;
 
 			return result;
@@ -4009,6 +5185,14 @@ Currency ExprTreeEvaluator::LogicalOperator(const Currency& lhs, const Currency&
 
 Currency ExprTreeEvaluator::LogicalOperatorEx(const Currency& lhs, const Currency& rhs, int op)
 {
+	if (lhs.IsSingle() || rhs.IsSingle() || lhs.IsIntegerType() || rhs.IsIntegerType())
+		return LogicalOperatorEx(lhs.ToDouble(), rhs.ToDouble(), op);
+
+	Currency packed;
+	if ((op == AND || op == OR || op == LAND || op == LOR) &&
+		LogicalArray::Combine(lhs, rhs, (op == AND || op == LAND), packed))
+		return packed;
+
 	if (lhs.IsScalar() && rhs.IsScalar())
 	{
 		return LogicalHelper(lhs.Scalar(), rhs.Scalar(), op);
@@ -4018,7 +5202,7 @@ Currency ExprTreeEvaluator::LogicalOperatorEx(const Currency& lhs, const Currenc
 		const hwMatrix* m2 = rhs.Matrix();
 		hwMatrix* result = allocateMatrix(m2->M(), m2->N(), hwMatrix::REAL);
 
-		for (int j=0; j<m2->Size(); j++)
+		for (int64_t j=0; j<m2->Size(); j++)
 		{
 			if (m2->IsReal())
 				(*result)(j) = LogicalHelper(lhs.Scalar(), (*m2)(j), op);
@@ -4033,7 +5217,7 @@ Currency ExprTreeEvaluator::LogicalOperatorEx(const Currency& lhs, const Currenc
 		const hwMatrix* m1 = lhs.Matrix();
 		hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-		for (int j=0; j<m1->Size(); j++)
+		for (int64_t j=0; j<m1->Size(); j++)
 		{
 			if (m1->IsReal())
 				(*result)(j) = LogicalHelper((*m1)(j), rhs.Scalar(), op);
@@ -4058,7 +5242,7 @@ Currency ExprTreeEvaluator::LogicalOperatorEx(const Currency& lhs, const Currenc
 			{
 				hwMatrix* result = allocateMatrix(m1->M(), m1->N(), hwMatrix::REAL);
 
-				for (int j=0; j<m1->Size(); j++)
+				for (int64_t j=0; j<m1->Size(); j++)
 				{
 					double lhs;
 					double rhs;
@@ -4111,7 +5295,7 @@ Currency ExprTreeEvaluator::LogicalOperatorEx(const Currency& lhs, const Currenc
 
 		if (m2->IsReal())
 		{
-			for (int j=0; j<m2->Size(); j++)
+			for (int64_t j=0; j<m2->Size(); j++)
 				(*result)(j) = LogicalHelper(c1.Mag(), (*m2)(j), op);
 		}
 		else
@@ -4129,7 +5313,7 @@ Currency ExprTreeEvaluator::LogicalOperatorEx(const Currency& lhs, const Currenc
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = LogicalHelper((*m1)(j), c2.Mag(), op);
 		}
 		else
@@ -4173,7 +5357,7 @@ bool ExprTreeEvaluator::ShortCircuitHelper(OMLTree* tree)
 		}
 		else if (mtx->IsReal())
 		{
-			for (int j=0; j<mtx->Size(); j++)
+			for (int64_t j=0; j<mtx->Size(); j++)
 			{
 				if ((*mtx)(j) == 0.0)
 					return false;
@@ -4181,7 +5365,7 @@ bool ExprTreeEvaluator::ShortCircuitHelper(OMLTree* tree)
 		}
 		else
 		{
-			for (int j=0; j<mtx->Size(); j++)
+			for (int64_t j=0; j<mtx->Size(); j++)
 			{
 				if (mtx->z(0).Mag() == 0.0)
 					return false;
@@ -4327,12 +5511,12 @@ Currency ExprTreeEvaluator::EntrywisePowOperator(const Currency& op1, const Curr
 
 		if (m1->IsReal())
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				(*result)(j) = pow(op1.Scalar(), (*m1)(j));
 		}
 		else
 		{
-			for (int j=0; j<m1->Size(); j++)
+			for (int64_t j=0; j<m1->Size(); j++)
 				result->z(j) = hwComplex::pow(op1.Scalar(), m1->z(j));
 		}
 
@@ -4344,7 +5528,7 @@ Currency ExprTreeEvaluator::EntrywisePowOperator(const Currency& op1, const Curr
 		hwMatrix* result = allocateMatrix (m1->M(), m1->N(), m1->Type());
 		result->MakeComplex();
 
-		for (int j=0; j<m1->Size(); j++)
+		for (int64_t j=0; j<m1->Size(); j++)
 		{
 			if (m1->IsReal())
 				result->z(j) = hwComplex::pow(op1.Complex(), (*m1)(j));
@@ -4403,6 +5587,23 @@ Currency ExprTreeEvaluator::NegateOperator(const Currency& op)
 	{
 		return oml_MatrixNUtil6(op, &ExprTreeEvaluator::NegateOperator);
 	}
+	else if (op.IsSparse())
+	{
+		hwMatrixS* ret = new hwMatrixS(*op.MatrixS());
+		ret->MultEquals(-1.0);
+		return ret;
+	}
+	else if (op.IsSingle())
+	{
+		hwMatrixF* ret = new hwMatrixF;
+		Currency   cur(ret);
+		ret->Negate(*op.MatrixF());
+		return cur;
+	}
+	else if (op.IsIntegerType())
+	{
+		return IntegerArithmetic::Negate(op);
+	}
 	else if (op.IsObject())
 	{
 		return CallOverloadedOperator("uminus", op);
@@ -4413,6 +5614,10 @@ Currency ExprTreeEvaluator::NegateOperator(const Currency& op)
 
 Currency ExprTreeEvaluator::NotOperator(const Currency& op)
 {
+	Currency packed;
+	if (LogicalArray::Not(op, packed))
+		return packed;
+
 	if (op.IsScalar())
 	{
 		if (op.Scalar())
@@ -4432,7 +5637,7 @@ Currency ExprTreeEvaluator::NotOperator(const Currency& op)
 
 		if (mtx->IsReal())
 		{
-			for (int j=0; j<ret->Size(); j++)
+			for (int64_t j=0; j<ret->Size(); j++)
 			{
 				if ((*mtx)(j))
 					(*ret)(j) = 0.0;
@@ -4442,7 +5647,7 @@ Currency ExprTreeEvaluator::NotOperator(const Currency& op)
 		}
 		else
 		{
-			for (int j=0; j<ret->Size(); j++)
+			for (int64_t j=0; j<ret->Size(); j++)
 			{
 				if (mtx->z(j).Imag() == 0.0)
 				{
@@ -4464,6 +5669,10 @@ Currency ExprTreeEvaluator::NotOperator(const Currency& op)
 	{
 		return oml_MatrixNUtil6(op, &ExprTreeEvaluator::NotOperator);
 	}
+	else if (op.IsSingle() || op.IsIntegerType())
+	{
+		return NotOperator(op.ToDouble());
+	}
 
 	return 0.0;
 }
@@ -4593,7 +5802,7 @@ Currency ExprTreeEvaluator::FunctionCall(OMLTree* tree)
 						{
 							HML_CELLARRAY* cells = param.CellArray();
 
-							for (int k=0; k<cells->Size(); k++)
+							for (int64_t k=0; k<cells->Size(); k++)
 								param_vals.push_back((*cells)(k));
 						}
 						else
@@ -4658,7 +5867,7 @@ Currency ExprTreeEvaluator::FunctionCall(OMLTree* tree)
 					{
 						HML_CELLARRAY* cells = param.CellArray();
 
-						for (int k=0; k<cells->Size(); k++)
+						for (int64_t k=0; k<cells->Size(); k++)
 							param_vals.push_back((*cells)(k));
 					}
 					else
@@ -4954,7 +6163,7 @@ std::vector<Currency> ExprTreeEvaluator::DoMultiReturnFunctionCall(FUNCPTR fptr,
 
 	for (int j=0; j<num_rets; j++)
 	{
-		Currency loop_cur = ret[j];
+		const Currency& loop_cur = ret[j];
 
 		if (j >= out_vars->size())
 			break;
@@ -4995,7 +6204,7 @@ void ExprTreeEvaluator::DoMultiReturnFunctionCall(FUNCPTR fptr, const std::strin
 
 	for (int j=0; j<num_rets; j++)
 	{
-		Currency loop_cur = ret[j];
+		const Currency& loop_cur = ret[j];
 
 		std::string* output_name = NULL;
 
@@ -5487,7 +6696,7 @@ Currency ExprTreeEvaluator::MultiReturnFunctionCall(OMLTree* tree)
 				{
 					HML_CELLARRAY* cells = param.CellArray();
 
-					for (int k=0; k<cells->Size(); k++)
+					for (int64_t k=0; k<cells->Size(); k++)
 						vararg_params.push_back((*cells)(k));
 				}
 				else
@@ -5612,7 +6821,7 @@ double GetTestVal(Currency cond_value)
 
 		if (mtx->IsReal() && !mtx->IsEmpty())
 		{
-			for (int j=0; j<mtx->Size(); j++)
+			for (int64_t j=0; j<mtx->Size(); j++)
 			{
 				if ((*mtx)(j) == 0.0)
 				{
@@ -6693,11 +7902,11 @@ Currency ExprTreeEvaluator::MatrixCreation(OMLTree* tree)
 				}
 			}
 
-			temp.push_back(temp_cur);
+			temp.push_back(std::move(temp_cur));
 		}
 
 		if (temp.size())
-			currencies.push_back(temp);
+			currencies.push_back(std::move(temp));
 	}
 
 	if (currencies.size() == 1)
@@ -7177,25 +8386,30 @@ Currency ExprTreeEvaluator::AssignOperator(OMLTree* tree)
 	return 0.0;
 }
 
-hwMatrix* AdjustMatrixSize(hwMatrix* temp_mtx, int index1)
+hwMatrix* AdjustMatrixSize(hwMatrix* temp_mtx, int64_t index1)
 {
 	if (temp_mtx->GetRefCount() != 1)
 		assert(0); // detach the matrix before calling this function
 
 	if (index1 >= temp_mtx->Size())
 	{
+		if (index1 >= std::numeric_limits<int>::max())
+			throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+		int new_size = static_cast<int>(index1)+1;
+
 		if (temp_mtx->IsEmpty())
 		{
-			temp_mtx->Dimension(1, index1+1, hwMatrix::REAL);
+			temp_mtx->Dimension(1, new_size, hwMatrix::REAL);
 			temp_mtx->SetElements(0.0);
 		}
 		else if (temp_mtx->M() == 1)
 		{
-			temp_mtx->Resize(1, index1+1, true); // make all the newly-created elements 0
+			temp_mtx->Resize(1, new_size, true); // make all the newly-created elements 0
 		}
 		else if (temp_mtx->N() == 1)
 		{
-			temp_mtx->Resize(index1+1, 1, true); // make all the newly-created elements 0
+			temp_mtx->Resize(new_size, 1, true); // make all the newly-created elements 0
 		}
 		else
 		{
@@ -7281,15 +8495,15 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
 			Currency idx1 = indices[0];
 			Currency idx2;
 
-			int index1 = 0;
-			int index2 = 0;
+			int64_t index1 = 0;
+			int     index2 = 0;
 
 			if (idx1.IsLogical())
 				idx1.ConvertToMatrix();
 			
 			if (idx1.IsPositiveInteger())
 			{
-				index1 = static_cast<int>(idx1.Scalar() - 1);
+				index1 = static_cast<int64_t>(idx1.Scalar() - 1);
 			}
 			else if (idx1.IsMatrix())
 			{
@@ -7322,6 +8536,9 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
 
 				if (idx2.IsPositiveInteger())
 				{
+					if (index1 >= std::numeric_limits<int>::max())
+						throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
 					index2 = static_cast<int>(idx2.Scalar() - 1); // remember we want to be 1-based
 				}
 				else if (idx2.IsMatrix())
@@ -7428,26 +8645,28 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
 
 				if (num_indices == 2)
 				{
+					int row = static_cast<int>(index1);
+
 					if (value.IsScalar())
 					{
-						new_matrix = AdjustMatrixSize(new_matrix, idx1, idx2, index1, index2);
+						new_matrix = AdjustMatrixSize(new_matrix, idx1, idx2, row, index2);
 
 						if (new_matrix->IsReal())
-							(*new_matrix)(index1, index2) = value.Scalar();
+							(*new_matrix)(row, index2) = value.Scalar();
 						else
-							new_matrix->z(index1, index2) = value.Scalar();
+							new_matrix->z(row, index2) = value.Scalar();
 					}
 					else if (value.IsComplex())
 					{
-						new_matrix = AdjustMatrixSize(new_matrix, idx1, idx2, index1, index2);
+						new_matrix = AdjustMatrixSize(new_matrix, idx1, idx2, row, index2);
 						new_matrix->MakeComplex();
-						new_matrix->z(index1, index2) = value.Complex();
+						new_matrix->z(row, index2) = value.Complex();
 					}
 					else if (value.IsCharacter())
 					{
 						std::string str = value.StringVal();
-						new_matrix = AdjustMatrixSize(new_matrix, idx1, idx2, index1, index2);
-						(*new_matrix)(index1, index2) = (unsigned int)str[0];
+						new_matrix = AdjustMatrixSize(new_matrix, idx1, idx2, row, index2);
+						(*new_matrix)(row, index2) = (unsigned int)str[0];
 					}
 					else
 					{
@@ -7473,18 +8692,24 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
 					}
 					else if (value.IsEmpty())
 					{
+						if (new_matrix->Size() > std::numeric_limits<int>::max())
+							throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+						// an index past the end is rejected by the kernel
+						int elem = static_cast<int>(std::min(index1, new_matrix->Size()));
+
 						if (new_matrix->M() == 1)
 						{
-							new_matrix->DeleteColumns(index1, 1);
+							new_matrix->DeleteColumns(elem, 1);
 						}
 						else if (new_matrix->N() == 1)
 						{
-							new_matrix->DeleteRows(index1, 1);
+							new_matrix->DeleteRows(elem, 1);
 						}
 						else
 						{
-							new_matrix->Reshape(1, new_matrix->Size());
-							new_matrix->DeleteColumns(index1, 1);
+							new_matrix->Reshape(1, static_cast<int>(new_matrix->Size()));
+							new_matrix->DeleteColumns(elem, 1);
 						}
 					}
 					else if (value.IsString())
@@ -7492,7 +8717,10 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
                         const hwMatrix* mtx = value.Matrix();
                         if (!mtx || mtx->IsEmpty())
                         {
-                            new_matrix->DeleteElements(index1);
+                            if (new_matrix->Size() > std::numeric_limits<int>::max())
+                                throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+                            new_matrix->DeleteElements(static_cast<int>(std::min(index1, new_matrix->Size())));
                         }
                         else if (mtx->Size() == 1)
                         {
@@ -7884,7 +9112,7 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
 				 }
 				 else if (indices[0].IsPositiveInteger())
 				 {
-					 int idx = (int)indices[0].Scalar();
+					 int64_t idx = (int64_t)indices[0].Scalar();
 
 					 if (value.IsComplex())
 					 {
@@ -7908,7 +9136,7 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
 				 }
 				 else if (indices[0].IsLogical())
 				 {
-					 int idx = (int)indices[0].Scalar();
+					 int64_t idx = (int64_t)indices[0].Scalar();
 
 					 if (!idx)
 						 return;
@@ -7940,13 +9168,13 @@ void ExprTreeEvaluator::AssignHelper(Currency& target, const std::vector<Currenc
 						 {
 							 if (vals->IsReal())
 							 {
-								 for (int j=0; j<vals->Size(); j++)
-									 ReplaceMatrixElementHelper(mtx, (int)(ind[j]-1), (*vals)(j));
+								 for (int64_t j=0; j<vals->Size(); j++)
+									 ReplaceMatrixElementHelper(mtx, (int64_t)(ind[j]-1), (*vals)(j));
 							 }
 							 else
 							 {
-								 for (int j=0; j<vals->Size(); j++)
-									 ReplaceMatrixElementHelper(mtx, (int)(ind[j]-1), vals->z(j));
+								 for (int64_t j=0; j<vals->Size(); j++)
+									 ReplaceMatrixElementHelper(mtx, (int64_t)(ind[j]-1), vals->z(j));
 							 }
 
 							 target.ReplaceMatrix(mtx);
@@ -8091,7 +9319,7 @@ hwMatrixN* ExprTreeEvaluator::Convert2DtoND(const hwMatrix* mtx_in)
 		dims.push_back(mtx_in->M());
 		dims.push_back(mtx_in->N());
 
-		int size = mtx_in->Size();
+		int64_t size = mtx_in->Size();
 
 		if (mtx_in->IsReal())
 		{
@@ -8159,8 +9387,8 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
         if (params[0].IsMatrix())
         {
             const hwMatrix* idxm = params[0].Matrix();  // indices
-            int size_idx = idxm->Size();
-            int size_lhs = LHS->Size();
+            int64_t size_idx = idxm->Size();
+            int64_t size_lhs = LHS->Size();
 
             if (!idxm->IsReal())
                 throw OML_Error(HW_ERROR_INDEXPOSINT);
@@ -8175,7 +9403,7 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
                 if (!RHS->IsReal() && LHS->IsReal())
                     LHS->MakeComplex();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -8193,7 +9421,7 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
             {
                 double rhs = value.Scalar();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -8214,7 +9442,7 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
                 if (LHS->IsReal())
                     LHS->MakeComplex();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -8238,8 +9466,8 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
         else if (params[0].IsNDMatrix())
         {
             const hwMatrixN* idxm = params[0].MatrixN();  // indices
-            int size_idx = idxm->Size();
-            int size_lhs = LHS->Size();
+            int64_t size_idx = idxm->Size();
+            int64_t size_lhs = LHS->Size();
 
             if (!idxm->IsReal())
                 throw OML_Error(HW_ERROR_INDEXPOSINT);
@@ -8254,7 +9482,7 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
                 if (!RHS->IsReal() && LHS->IsReal())
                     LHS->MakeComplex();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -8272,7 +9500,7 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
             {
                 double rhs = value.Scalar();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -8293,7 +9521,7 @@ void ExprTreeEvaluator::NDAssignmetHelper(Currency& target, const std::vector<Cu
                 if (LHS->IsReal())
                     LHS->MakeComplex();
 
-                for (int i = 0; i < size_idx; ++i)
+                for (int64_t i = 0; i < size_idx; ++i)
                 {
                     double idxd = (*idxm)(i);
                     int idx = static_cast<int>(idxd) - 1;
@@ -8574,18 +9802,21 @@ Currency ExprTreeEvaluator::PersistentReference(OMLTree* tree)
 Currency ExprTreeEvaluator::TransposeOperator(OMLTree* tree)
 {
 	OMLTree* child_0 = tree->GetChild(0);
-	Currency ret = RUN(child_0);
+	return TransposeOperator(RUN(child_0));
+}
 
+Currency ExprTreeEvaluator::TransposeOperator(const Currency& ret)
+{
 	if (ret.IsScalar() || ret.IsComplex())
 	{
 		return ret;
 	}
 	else if (ret.IsMatrix())
 	{
-		const hwMatrix* old_mtx = ret.Matrix();
-		hwMatrix* new_mtx = allocateMatrix(old_mtx);
-		new_mtx->Transpose();
-		return new_mtx;
+		hwMatrix* new_mtx = allocateMatrix();
+		Currency  cur(new_mtx);
+		new_mtx->Transpose(*ret.Matrix());
+		return cur;
 	}
 	else if (ret.IsString())
 	{
@@ -8596,6 +9827,23 @@ Currency ExprTreeEvaluator::TransposeOperator(OMLTree* tree)
 		cur.SetMask(Currency::MASK_STRING);
 		return cur;
 	}
+	else if (ret.IsSparse())
+	{
+		hwMatrixS* new_mtx = new hwMatrixS;
+		new_mtx->Transpose(*ret.MatrixS());
+		return new_mtx;
+	}
+	else if (ret.IsSingle())
+	{
+		hwMatrixF* new_mtx = new hwMatrixF;
+		Currency   cur(new_mtx);
+		new_mtx->Transpose(*ret.MatrixF());
+		return cur;
+	}
+	else if (ret.IsIntegerType())
+	{
+		return IntegerArithmetic::Transpose(ret);
+	}
 	else
 	{
 		throw OML_Error(HW_ERROR_UNSUPOP);
@@ -8607,8 +9855,11 @@ Currency ExprTreeEvaluator::TransposeOperator(OMLTree* tree)
 Currency ExprTreeEvaluator::ConjTransposeOperator(OMLTree* tree)
 {
 	OMLTree* child_0 = tree->GetChild(0);
-	Currency ret = RUN(child_0);
+	return ConjTransposeOperator(RUN(child_0));
+}
 
+Currency ExprTreeEvaluator::ConjTransposeOperator(const Currency& ret)
+{
 	if (ret.IsScalar())
 	{
 		return ret;
@@ -8621,11 +9872,11 @@ Currency ExprTreeEvaluator::ConjTransposeOperator(OMLTree* tree)
 	}
 	else if (ret.IsMatrix())
 	{
-		const hwMatrix* old_mtx = ret.Matrix();
-		hwMatrix* new_mtx = allocateMatrix(old_mtx);
-		new_mtx->Transpose();
+		hwMatrix* new_mtx = allocateMatrix();
+		Currency  cur(new_mtx);
+		new_mtx->Transpose(*ret.Matrix());
 		new_mtx->Conjugate();
-		return new_mtx;
+		return cur;
 	}
 	else if (ret.IsString())
 	{
@@ -8643,6 +9894,24 @@ Currency ExprTreeEvaluator::ConjTransposeOperator(OMLTree* tree)
 		new_mtx->Transpose(*old_mtx);
 		return new_mtx;
 	}
+	else if (ret.IsSparse())
+	{
+		hwMatrixS* new_mtx = new hwMatrixS;
+		new_mtx->Transpose(*ret.MatrixS());
+		return new_mtx;
+	}
+	else if (ret.IsSingle())
+	{
+		hwMatrixF* new_mtx = new hwMatrixF;
+		Currency   cur(new_mtx);
+		new_mtx->Transpose(*ret.MatrixF());
+		new_mtx->Conjugate();
+		return cur;
+	}
+	else if (ret.IsIntegerType())
+	{
+		return IntegerArithmetic::Transpose(ret);
+	}
 	else
 	{
 		throw OML_Error(HW_ERROR_UNSUPOP);
@@ -8850,7 +10119,7 @@ Currency ExprTreeEvaluator::CellValue(OMLTree* tree)
 
 				int max_index = temp->Size();
 
-				for (int j=0; j<mtx->Size(); j++)
+				for (int64_t j=0; j<mtx->Size(); j++)
 				{
 					int mtx_index = (int)((*mtx)(j)-1);
 
@@ -9044,7 +10313,7 @@ Currency  ExprTreeEvaluator::CellValueHelper(const Currency& target, const std::
 
 					int max_index = temp->Size();
 
-					for (int j=0; j<mtx->Size(); j++)
+					for (int64_t j=0; j<mtx->Size(); j++)
 					{
 						int mtx_index = (int)((*mtx)(j)-1);
 
@@ -9448,7 +10717,7 @@ void ExprTreeEvaluator::CellAssignmentHelper(Currency& target, const std::vector
 					target.ReplaceCellArray(temp);
 				}
 
-				for (int j=0; j<index->Size(); j++)
+				for (int64_t j=0; j<index->Size(); j++)
 				{
 					int target_index = (int)((*index)(j)-1);
 
@@ -9495,7 +10764,7 @@ void ExprTreeEvaluator::CellAssignmentHelper(Currency& target, const std::vector
 
 			value.SetOutputName("");
 
-			for (int j=0; j<temp->Size(); j++)
+			for (int64_t j=0; j<temp->Size(); j++)
 				(*temp)(j) = value;
 
 			//(*temp)(index_1).ClearOutputName();
@@ -10939,6 +12208,7 @@ bool ExprTreeEvaluator::ClearFromGlobals(const std::string& name)
 	if (msm->IsGlobal(name))
 	{
         msm->ClearFromGlobals(name);
+		ReleaseUnusedFactors();
 		return true;
 	}
 	return false;
@@ -10946,7 +12216,9 @@ bool ExprTreeEvaluator::ClearFromGlobals(const std::string& name)
 
 bool ExprTreeEvaluator::ClearFromGlobals(const std::regex& name)
 {
-    return msm->ClearFromGlobals(name);
+    bool rv = msm->ClearFromGlobals(name);
+	ReleaseUnusedFactors();
+	return rv;
 }
 
 bool ExprTreeEvaluator::ClearFromVariables(const std::string& name)
@@ -10957,6 +12229,7 @@ bool ExprTreeEvaluator::ClearFromVariables(const std::string& name)
 	{
 		msm->Remove(name);
 		msm->HideGlobal(name);
+		ReleaseUnusedFactors();
 		return true;
 	}
 	return false;
@@ -10964,7 +12237,9 @@ bool ExprTreeEvaluator::ClearFromVariables(const std::string& name)
 
 bool ExprTreeEvaluator::ClearFromVariables(const std::regex& name)
 {
-    return msm->Remove(name);
+    bool rv = msm->Remove(name);
+	ReleaseUnusedFactors();
+	return rv;
 }
 
 void ExprTreeEvaluator::ClearFunctions()
@@ -10989,11 +12264,13 @@ void ExprTreeEvaluator::ClearFunctions()
 void ExprTreeEvaluator::ClearGlobals()
 {
 	msm->ClearGlobals();
+	ReleaseUnusedFactors();
 }
 
 void ExprTreeEvaluator::ClearVariables()
 {
 	msm->ClearLocals();
+	ReleaseUnusedFactors();
 }
 
 int ExprTreeEvaluator::RenameVariable(std::string old_name, std::string new_name)
@@ -11222,7 +12499,7 @@ void ExprTreeEvaluator::PopNargValues()
 		nargin_values.pop_back();
 }
 
-int ExprTreeEvaluator::GetContextEndValue() const
+int64_t ExprTreeEvaluator::GetContextEndValue() const
 {
 	Currency context;
 
@@ -11233,6 +12510,20 @@ int ExprTreeEvaluator::GetContextEndValue() const
 	else
 		throw OML_Error(HW_ERROR_NOCONTEXTENDFUNC);
 
+	// packed flags and characters are measured without unpacking them
+	if (context.IsPackedLogical() || context.IsPackedString())
+	{
+		int m = context.IsPackedLogical() ? context.MatrixB()->M() : context.MatrixC()->M();
+		int n = context.IsPackedLogical() ? context.MatrixB()->N() : context.MatrixC()->N();
+
+		if (end_context_index == -1)
+			return static_cast<int64_t>(m) * n;
+		else if (end_context_index == 0)
+			return m;
+		else if (end_context_index == 1)
+			return n;
+	}
+
 	if (context.IsMatrixOrString())
 	{
 		const hwMatrix* mtx = context.Matrix();
@@ -11258,6 +12549,29 @@ int ExprTreeEvaluator::GetContextEndValue() const
 			return dims[end_context_index];
 		}
 	}
+	else if (context.IsSingle())
+	{
+		const hwMatrixF* mtx = context.MatrixF();
+
+		if (end_context_index == -1)
+			return mtx->Size();
+		else if (end_context_index == 0)
+			return mtx->M();
+		else if (end_context_index == 1)
+			return mtx->N();
+	}
+	else if (context.IsIntegerType())
+	{
+		int m, n;
+		context.IntegerDims(m, n);
+
+		if (end_context_index == -1)
+			return static_cast<int64_t>(m) * n;
+		else if (end_context_index == 0)
+			return m;
+		else if (end_context_index == 1)
+			return n;
+	}
 	else if (context.IsScalar() || context.IsComplex())
 	{
 		return 1;
@@ -12072,7 +13386,7 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 
 			if (data->Size() == val_mtx->Size())
 			{
-				for (int j=0; j< data->Size(); j++)
+				for (int64_t j=0; j< data->Size(); j++)
 				{
 					if (val_mtx->IsReal())
 					{
@@ -12097,15 +13411,26 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 		{
 			std::vector<int> to_delete;
 
-			for (int j=0; j<index->Size(); j++)
-				to_delete.push_back((int)((*index)(j)));
+			// the elements are deleted from a vector reshape of the matrix
+			if (new_matrix->Size() > std::numeric_limits<int>::max())
+				throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+			for (int64_t j=0; j<index->Size(); j++)
+			{
+				double idx = (*index)(j);
+
+				if (idx > new_matrix->Size())
+					throw OML_Error(HW_ERROR_INDEXRANGE);
+
+				to_delete.push_back((int)idx);
+			}
 
 			std::sort(to_delete.begin(), to_delete.end());
 
 			if (new_matrix->M() == 1)
-				new_matrix->Reshape(1, new_matrix->Size());		
+				new_matrix->Reshape(1, static_cast<int>(new_matrix->Size()));		
 			else
-				new_matrix->Reshape(new_matrix->Size(), 1);
+				new_matrix->Reshape(static_cast<int>(new_matrix->Size()), 1);
 
 			if (new_matrix->M() ==1 )
 			{
@@ -12181,22 +13506,28 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 			if (is_scalar)
 				scalar_val = value.Scalar();
 
-			for (int j=0; j<index->Size(); j++)
+			for (int64_t j=0; j<index->Size(); j++)
 			{
-				int target_index = (int)((*index)(j)-1);
+				int64_t target_index = (int64_t)((*index)(j)-1);
 
 				if (target_index < 0)
 					throw OML_Error(HW_ERROR_INVIND);
 
 				if (target_index >= new_matrix->Size())
 				{
+					// only vectors grow, and their length is an int
+					if (target_index >= std::numeric_limits<int>::max())
+						throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+					int new_size = static_cast<int>(target_index)+1;
+
 					if (new_matrix->IsEmpty())
-						new_matrix->Dimension(1, target_index+1, hwMatrix::REAL);
+						new_matrix->Dimension(1, new_size, hwMatrix::REAL);
 
 					if (new_matrix->M() == 1)
-						new_matrix->Resize(1, target_index+1, true);
+						new_matrix->Resize(1, new_size, true);
 					else if (new_matrix->N() == 1)
-						new_matrix->Resize(target_index+1, 1, true);
+						new_matrix->Resize(new_size, 1, true);
 					else
 						throw OML_Error(HW_ERROR_UNSUPOP);
 				}
@@ -12271,7 +13602,7 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 		{
 			const hwMatrix* values = value.Matrix();
 
-			for (int j=0; j<index->Size(); j++)
+			for (int64_t j=0; j<index->Size(); j++)
 			{
 				if ((*index)(j) == 1.0)
 					(*new_matrix)(j) = (*values)(0);
@@ -12283,9 +13614,9 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 
 			if (values->IsReal())
 			{
-				int next_index = 0;
+				int64_t next_index = 0;
 
-				for (int j=0; j<index->Size(); j++)
+				for (int64_t j=0; j<index->Size(); j++)
 				{
 					if ((*index)(j) == 1.0)
 					{
@@ -12299,13 +13630,13 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 			}
 			else
 			{
-				int next_index = 0;
+				int64_t next_index = 0;
 
 				if (new_matrix->IsReal())
 					new_matrix->MakeComplex();
 
 
-				for (int j=0; j<index->Size(); j++)
+				for (int64_t j=0; j<index->Size(); j++)
 				{
 					if ((*index)(j) == 1.0)
 					{
@@ -12320,7 +13651,7 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 		}
 		else if (value.IsScalar())
 		{
-			for (int j=0; j<index->Size(); j++)
+			for (int64_t j=0; j<index->Size(); j++)
 			{
 				if ((*index)(j) == 1.0)
 					ReplaceMatrixElementHelper(new_matrix, j, value.Scalar());
@@ -12331,7 +13662,7 @@ hwMatrix* ExprTreeEvaluator::SubmatrixSingleIndexHelper(Currency& target, const
 			if (new_matrix->IsReal())
 				new_matrix->MakeComplex();
 
-			for (int j=0; j<index->Size(); j++)
+			for (int64_t j=0; j<index->Size(); j++)
 			{
 				if ((*index)(j) == 1.0)
 					ReplaceMatrixElementHelper(new_matrix, j, value.Complex());
@@ -12844,19 +14175,23 @@ void ExprTreeEvaluator::ReplaceMatrixElementHelper(hwMatrix*& target, int index1
 	target->z(index1, index2) = value;
 }
 
-void ExprTreeEvaluator::ReplaceMatrixElementHelper(hwMatrix*& target, int index1, double value)
+void ExprTreeEvaluator::ReplaceMatrixElementHelper(hwMatrix*& target, int64_t index1, double value)
 {
 	if (index1 < 0)
 		throw OML_Error(HW_ERROR_INDEXRANGE);
 
+	// growing makes a row, which cannot hold more than INT_MAX elements
+	if (index1 >= target->Size() && index1 >= std::numeric_limits<int>::max())
+		throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
 	if (target->IsEmpty())
 	{
-		target->Dimension(1, index1+1, hwMatrix::REAL);
+		target->Dimension(1, static_cast<int>(index1)+1, hwMatrix::REAL);
 		target->SetElements(0.0);
 	}
 
 	if (index1 >= target->Size())
-		target->Resize(1, index1+1, true); // make all the newly-created elements 0
+		target->Resize(1, static_cast<int>(index1)+1, true); // make all the newly-created elements 0
 
 	if (target->IsReal())
 		(*target)(index1) = value;
@@ -12864,19 +14199,23 @@ void ExprTreeEvaluator::ReplaceMatrixElementHelper(hwMatrix*& target, int index1
 		target->z(index1) = value;
 }
 
-void ExprTreeEvaluator::ReplaceMatrixElementHelper(hwMatrix*& target, int index1, const hwComplex& value)
+void ExprTreeEvaluator::ReplaceMatrixElementHelper(hwMatrix*& target, int64_t index1, const hwComplex& value)
 {
 	if (index1 < 0)
 		throw OML_Error(HW_ERROR_INDEXRANGE);
 
+	// growing makes a row, which cannot hold more than INT_MAX elements
+	if (index1 >= target->Size() && index1 >= std::numeric_limits<int>::max())
+		throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
 	if (target->IsEmpty())
 	{
-		target->Dimension(1, index1+1, hwMatrix::COMPLEX);
+		target->Dimension(1, static_cast<int>(index1)+1, hwMatrix::COMPLEX);
 		target->SetElements(0.0);
 	}
 
 	if (index1 >= target->Size())
-		target->Resize(1, index1+1, true); // make all the newly-created elements 0
+		target->Resize(1, static_cast<int>(index1)+1, true); // make all the newly-created elements 0
 
 	if (target->IsReal())
 		target->MakeComplex();
@@ -12966,7 +14305,7 @@ void ExprTreeEvaluator::PushResult(const Currency& cur, bool to_output)
 		{
 			HML_CELLARRAY* cells = cur.CellArray();
 
-			for (int k=0; k<cells->Size(); ++k)
+			for (int64_t k=0; k<cells->Size(); ++k)
 			{
 				Currency temp = (*cells)(k);
 				
@@ -13370,7 +14709,7 @@ static void CheckDims(int m, int n)
 }
 
 template <typename T1, typename T2>
-static void CheckSize(const hwTMatrix<T1, T2>* mtx, int expected_size)
+static void CheckSize(const hwTMatrix<T1, T2>* mtx, int64_t expected_size)
 {
     if (mtx->Size() != expected_size)
     {
@@ -13398,7 +14737,7 @@ hwMatrix* ExprTreeEvaluator::allocateMatrix(int m, int n, void* data, hwMatrix::
 {
     CheckDims(m,n);
 	hwMatrix* mtx = new hwMatrix(m, n, data, type);
-    CheckSize(mtx, m*n);
+    CheckSize(mtx, static_cast<int64_t>(m)*n);
 	return mtx;
 }
 
@@ -13406,7 +14745,7 @@ hwMatrix* ExprTreeEvaluator::allocateMatrix(int m, int n, hwMatrix::DataType typ
 {
     CheckDims(m,n);
 	hwMatrix* mtx = new hwMatrix(m, n, type);
-    CheckSize(mtx, m*n);
+    CheckSize(mtx, static_cast<int64_t>(m)*n);
 	return mtx;
 }
 
@@ -13414,7 +14753,7 @@ hwMatrix* ExprTreeEvaluator::allocateMatrix(int m, int n, double value)
 {
     CheckDims(m,n);
 	hwMatrix* mtx = ExprTreeEvaluator::allocateMatrix(m, n, hwMatrix::REAL);
-    CheckSize(mtx, m*n);
+    CheckSize(mtx, static_cast<int64_t>(m)*n);
 	mtx->SetElements(value);
 	return mtx;
 }
@@ -13423,7 +14762,7 @@ hwMatrix* ExprTreeEvaluator::allocateMatrix(int m, int n, hwComplex& value)
 {
     CheckDims(m,n);
 	hwMatrix* mtx = ExprTreeEvaluator::allocateMatrix(m, n, hwMatrix::COMPLEX);
-    CheckSize(mtx, m*n);
+    CheckSize(mtx, static_cast<int64_t>(m)*n);
 	mtx->SetElements(value);
 	return mtx;
 }
@@ -13432,7 +14771,7 @@ hwMatrixI* ExprTreeEvaluator::allocateMatrix(int m, int n, hwMatrixI::DataType t
 {
     CheckDims(m,n);
 	hwMatrixI* mtx = new hwMatrixI(m, n, type);
-    CheckSize(mtx, m*n);
+    CheckSize(mtx, static_cast<int64_t>(m)*n);
 	return mtx;
 }
 
@@ -13440,7 +14779,7 @@ hwMatrixI* ExprTreeEvaluator::allocateMatrix(int m, int n, int val)
 {
     CheckDims(m,n);
 	hwMatrixI* mtx = ExprTreeEvaluator::allocateMatrix(m, n, hwMatrixI::REAL);
-    CheckSize(mtx, m*n);
+    CheckSize(mtx, static_cast<int64_t>(m)*n);
 	mtx->SetElements(val);
 	return mtx;
 }
@@ -13487,7 +14826,7 @@ HML_CELLARRAY* ExprTreeEvaluator::allocateCellArray(int m, int n)
 {
     CheckDims(m,n);
 	HML_CELLARRAY* cell = new HML_CELLARRAY(m, n, HML_CELLARRAY::REAL);
-    CheckSize(cell, m*n);
+    CheckSize(cell, static_cast<int64_t>(m)*n);
 	return cell;
 }
 
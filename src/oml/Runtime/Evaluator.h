@@ -28,6 +28,7 @@
 #include "MemoryScope.h"
 #include "OutputFormat.h"
 
+#include <list>
 #include <map>
 #include <iostream>
 #include <fstream>
@@ -40,6 +41,7 @@ class ClassInfo;              // Interface for external classes in OML language
 class ExprTreeEvaluator;
 class EvaluatorDebugInterface;
 class FunctionInfo;
+class FusedElementwise;
 class SignalHandlerBase;      // Base implementation for handling client signals
 class OMLTree;
 
@@ -146,7 +148,7 @@ public:
 	std::vector<std::string> GetKeywords() const;
 	std::vector<std::string> GetOperators() const;
 
-	int   GetContextEndValue() const;
+	int64_t GetContextEndValue() const;
 	int   GetNargoutValue() const;
 	int   GetNarginValue() const;
 	void  PushNargValues(int argsin, int argsout);
@@ -408,6 +410,10 @@ private:
 	Currency EntrywiseDivideOperator(const Currency&, const Currency&);
 	Currency LeftDivideOperator(const Currency&, const Currency&);
 	Currency EntrywiseLeftDivideOperator(const Currency&, const Currency&);
+	//! Solves A\B with cached factors of A, returns false if A is not worth factoring
+	bool CachedLeftDivide(const Currency& A, const hwMatrix& B, hwMatrix& X);
+	//! Releases cached factors of matrices that are no longer referenced outside the cache
+	void ReleaseUnusedFactors();
 
 	Currency PowOperator(const Currency&, const Currency&);
 	Currency EntrywisePowOperator(const Currency&, const Currency&);
@@ -424,6 +430,16 @@ private:
 	Currency CellAssignOperator(OMLTree* tree);
 	Currency UnaryOperator(OMLTree* tree);
 	Currency BinaryOperator(OMLTree* tree);
+	Currency FusedElementwiseOperator(OMLTree* tree);
+	bool     IsFusableOperator(OMLTree* tree) const;
+	void     GatherFusedOperands(OMLTree* tree, std::vector<Currency>& operands, bool numeric);
+	int      BuildFusedExpression(OMLTree* tree, const std::vector<Currency>& operands, size_t& index,
+	                              FusedElementwise& expr, int& m, int& n) const;
+	Currency EvaluateFusedOperands(OMLTree* tree, std::vector<Currency>& operands, size_t& index);
+	Currency TemporaryBinaryOperator(Currency& op1, Currency& op2, int op);
+	Currency SparseBinaryOperator(const Currency& op1, const Currency& op2, int op);
+	Currency SingleBinaryOperator(const Currency& op1, const Currency& op2, int op);
+	Currency IntegerBinaryOperator(const Currency& op1, const Currency& op2, int op);
     Currency EqualityOperator(OMLTree* tree);
 	Currency EqualityOperatorEx(const Currency& lhs, const Currency& rhs);
 	bool     EqualityHelper(const Currency& lhs, const Currency& rhs);
@@ -451,7 +467,10 @@ private:
 	Currency GlobalReference(OMLTree* tree);
 	Currency PersistentReference(OMLTree* tree);
 	Currency TransposeOperator(OMLTree* tree);
+	Currency TransposeOperator(const Currency& op);
 	Currency ConjTransposeOperator(OMLTree* tree);
+	Currency ConjTransposeOperator(const Currency& op);
+	Currency TransposedProduct(OMLTree* tree);
 	Currency AnonymousFunctionDefinition(OMLTree* tree);
 	Currency CellArrayCreation(OMLTree* tree);
 	Currency CellValue(OMLTree* tree);
@@ -475,8 +494,8 @@ private:
 	hwMatrix* SubmatrixDoubleIndexHelper(Currency& target, const Currency& index1, const Currency& index2, const Currency& value);
 	void      ReplaceMatrixElementHelper(hwMatrix*& target, const int index1, const int index2, const double value);
 	void      ReplaceMatrixElementHelper(hwMatrix*& target, int index1, int index2, const hwComplex& value);
-	void      ReplaceMatrixElementHelper(hwMatrix*& target, int index1, double value);
-	void      ReplaceMatrixElementHelper(hwMatrix*& target, int index1, const hwComplex& value);
+	void      ReplaceMatrixElementHelper(hwMatrix*& target, int64_t index1, double value);
+	void      ReplaceMatrixElementHelper(hwMatrix*& target, int64_t index1, const hwComplex& value);
 	Currency  VariableIndex(const std::string*, const std::vector<Currency>&);
 
 	Currency  CallOverloadedOperator(const std::string&, const Currency& op);	
@@ -608,6 +627,8 @@ private:
 
     OutputFormat* format;
 
+	std::list<Currency>* _factor_cache;  //! Decompositions of recent left operands of mldivide, most recently used first
+
 	std::vector<MemoryScope*> marks;
 	int          mark_narg_size;
 	
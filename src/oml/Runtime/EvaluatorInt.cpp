@@ -263,7 +263,7 @@ bool EvaluatorInterface::Contains(const std::string& varname) const
     return eval->Contains(varname);
 }
 
-int EvaluatorInterface::GetContextEndValue() const
+int64_t EvaluatorInterface::GetContextEndValue() const
 {
     return eval->GetContextEndValue();
 }
@@ -114,7 +114,7 @@ public:
     void ClearGlobals();
     void ClearVariables();
 
-    int GetContextEndValue() const;
+    int64_t GetContextEndValue() const;
 	int GetNargoutValue() const;
 	int GetNarginValue() const;
     int	GetNumFiles();
@@ -0,0 +1,195 @@
+/**
+* @file FusedElementwise.cpp
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+
+// Begin defines/includes
+#include "FusedElementwise.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+// End defines/includes
+
+// Number of elements evaluated per pass over the expression. Each
+// intermediate node needs one block, so the working set stays in cache.
+static const int BLOCK_SIZE = 512;
+
+struct AddOp      { static double Apply(double a, double b) { return a + b; } };
+struct SubtractOp { static double Apply(double a, double b) { return a - b; } };
+struct MultiplyOp { static double Apply(double a, double b) { return a * b; } };
+struct DivideOp   { static double Apply(double a, double b) { return a / b; } };
+
+template <typename OP>
+static void ApplyArrays(const double* a, const double* b, double* out, int n)
+{
+    for (int i = 0; i < n; ++i)
+        out[i] = OP::Apply(a[i], b[i]);
+}
+
+template <typename OP>
+static void ApplyArrayScalar(const double* a, double b, double* out, int n)
+{
+    for (int i = 0; i < n; ++i)
+        out[i] = OP::Apply(a[i], b);
+}
+
+template <typename OP>
+static void ApplyScalarArray(double a, const double* b, double* out, int n)
+{
+    for (int i = 0; i < n; ++i)
+        out[i] = OP::Apply(a, b[i]);
+}
+
+template <typename OP>
+static void Apply(const double* a, double a_val, const double* b, double b_val,
+                  double* out, int n)
+{
+    if (!a)
+        ApplyScalarArray<OP>(a_val, b, out, n);
+    else if (!b)
+        ApplyArrayScalar<OP>(a, b_val, out, n);
+    else
+        ApplyArrays<OP>(a, b, out, n);
+}
+//------------------------------------------------------------------------------
+// Adds a scalar operand and returns its node index
+//------------------------------------------------------------------------------
+int FusedElementwise::AddScalar(double value)
+{
+    Node node = { OP_ADD, -1, -1, nullptr, value, true };
+    _nodes.push_back(node);
+    return static_cast<int>(_nodes.size()) - 1;
+}
+//------------------------------------------------------------------------------
+// Adds an array operand and returns its node index
+//------------------------------------------------------------------------------
+int FusedElementwise::AddArray(const double* data)
+{
+    Node node = { OP_ADD, -1, -1, data, 0.0, false };
+    _nodes.push_back(node);
+    return static_cast<int>(_nodes.size()) - 1;
+}
+//------------------------------------------------------------------------------
+// Adds an operation and returns its node index
+//------------------------------------------------------------------------------
+int FusedElementwise::AddOperation(Operation op, int lhs, int rhs)
+{
+    assert(lhs >= 0 && lhs < static_cast<int>(_nodes.size()));
+
+    if (op == OP_NEGATE)
+        rhs = lhs;
+
+    assert(rhs >= 0 && rhs < static_cast<int>(_nodes.size()));
+
+    if (_nodes[lhs].scalar && _nodes[rhs].scalar)
+    {
+        double a = _nodes[lhs].value;
+        double b = _nodes[rhs].value;
+
+        switch (op)
+        {
+            case OP_ADD:      return AddScalar(a + b);
+            case OP_SUBTRACT: return AddScalar(a - b);
+            case OP_MULTIPLY: return AddScalar(a * b);
+            case OP_DIVIDE:   return AddScalar(a / b);
+            case OP_NEGATE:   return AddScalar(-a);
+        }
+    }
+
+    Node node = { op, lhs, rhs, nullptr, 0.0, false };
+    _nodes.push_back(node);
+    return static_cast<int>(_nodes.size()) - 1;
+}
+//------------------------------------------------------------------------------
+// Evaluates the expression rooted at the given node into result
+//------------------------------------------------------------------------------
+void FusedElementwise::Evaluate(int root, double* result, int64_t size) const
+{
+    assert(root >= 0 && root < static_cast<int>(_nodes.size()));
+
+    const Node& top = _nodes[root];
+
+    if (top.scalar)
+    {
+        std::fill(result, result + size, top.value);
+        return;
+    }
+
+    if (top.data)
+    {
+        if (size > 0)
+            memcpy(result, top.data, size * sizeof(double));
+        return;
+    }
+
+    int block_size = static_cast<int>(std::min<int64_t>(BLOCK_SIZE, size));
+
+    std::vector<double>        blocks((root + 1) * block_size);
+    std::vector<const double*> inputs(root + 1, nullptr);
+
+    for (int64_t start = 0; start < size; start += block_size)
+    {
+        int count = static_cast<int>(std::min<int64_t>(block_size, size - start));
+
+        for (int i = 0; i <= root; ++i)
+        {
+            const Node& node = _nodes[i];
+
+            if (node.scalar)
+                continue;
+
+            if (node.data)
+            {
+                inputs[i] = node.data + start;
+                continue;
+            }
+
+            double* out = (i == root) ? result + start : &blocks[i * block_size];
+
+            const double* a     = inputs[node.lhs];
+            const double* b     = inputs[node.rhs];
+            double        a_val = _nodes[node.lhs].value;
+            double        b_val = _nodes[node.rhs].value;
+
+            switch (node.op)
+            {
+                case OP_ADD:
+                    Apply<AddOp>(a, a_val, b, b_val, out, count);
+                    break;
+                case OP_SUBTRACT:
+                    Apply<SubtractOp>(a, a_val, b, b_val, out, count);
+                    break;
+                case OP_MULTIPLY:
+                    Apply<MultiplyOp>(a, a_val, b, b_val, out, count);
+                    break;
+                case OP_DIVIDE:
+                    // Dividing by a scalar multiplies by its reciprocal, as
+                    // hwMatrix::DivideEquals does, so results are identical
+                    if (!b)
+                        ApplyArrayScalar<MultiplyOp>(a, 1.0 / b_val, out, count);
+                    else
+                        Apply<DivideOp>(a, a_val, b, b_val, out, count);
+                    break;
+                case OP_NEGATE:
+                    ApplyArrayScalar<MultiplyOp>(a, -1.0, out, count);
+                    break;
+            }
+
+            inputs[i] = out;
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/**
+* @file FusedElementwise.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+
+#ifndef __FUSED_ELEMENTWISE_H__
+#define __FUSED_ELEMENTWISE_H__
+
+// Begin defines/includes
+#include <cstdint>
+#include <vector>
+
+// End defines/includes
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Single pass evaluation of an elementwise arithmetic expression
+//!
+//! The expression is built bottom up from real operands of a common size and
+//! real scalars. Scalar subexpressions are folded as they are added. Evaluate
+//! walks the operands in cache sized blocks, so intermediate results never
+//! leave the block buffers and only the final result is written to memory.
+//!
+//------------------------------------------------------------------------------
+class FusedElementwise
+{
+public:
+    //!
+    //! Operations which can be fused
+    //!
+    enum Operation
+    {
+        OP_ADD,
+        OP_SUBTRACT,
+        OP_MULTIPLY,
+        OP_DIVIDE,
+        OP_NEGATE
+    };
+    //!
+    //! Constructor
+    //!
+    FusedElementwise() {}
+    //!
+    //! Destructor
+    //!
+    ~FusedElementwise() {}
+
+    //!
+    //! Adds a scalar operand and returns its node index
+    //! \param value Scalar value
+    //!
+    int AddScalar(double value);
+    //!
+    //! Adds an array operand and returns its node index
+    //! \param data Real data, which must stay valid until Evaluate returns
+    //!
+    int AddArray(const double* data);
+    //!
+    //! Adds an operation on previously added nodes and returns its node index
+    //! \param op  Operation
+    //! \param lhs Node index of the first operand
+    //! \param rhs Node index of the second operand, ignored for OP_NEGATE
+    //!
+    int AddOperation(Operation op, int lhs, int rhs = -1);
+    //!
+    //! Returns true if the node is a scalar
+    //! \param node Node index
+    //!
+    bool IsScalar(int node) const { return _nodes[node].scalar; }
+    //!
+    //! Returns the value of a scalar node
+    //! \param node Node index
+    //!
+    double ScalarValue(int node) const { return _nodes[node].value; }
+    //!
+    //! Evaluates the expression rooted at the given node into result
+    //! \param root   Node index of the expression
+    //! \param result Output buffer
+    //! \param size   Number of elements of the array operands and result
+    //!
+    void Evaluate(int root, double* result, int64_t size) const;
+
+private:
+    //!
+    //! Expression node
+    //!
+    struct Node
+    {
+        Operation     op;      //!< Operation, if this is neither an operand nor a scalar
+        int           lhs;     //!< First operand node
+        int           rhs;     //!< Second operand node
+        const double* data;    //!< Array operand data
+        double        value;   //!< Scalar value
+        bool          scalar;  //!< True if this is a scalar
+    };
+
+    std::vector<Node> _nodes;  //!< Nodes, children always precede parents
+};
+
+#endif
@@ -0,0 +1,343 @@
+/**
+* @file IntegerArithmetic.cpp
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+// Begin defines/includes
+#include "IntegerArithmetic.h"
+
+// End defines/includes
+
+//------------------------------------------------------------------------------
+// Returns the magnitude of an integer as an unsigned 64 bit value, which holds
+// the magnitude of the minimum of every signed type
+//------------------------------------------------------------------------------
+template <typename T>
+static uint64_t Magnitude(T value)
+{
+    return (value < 0) ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+}
+
+struct SaturatingAdd
+{
+    template <typename T>
+    static T Apply(T a, T b)
+    {
+        const T lo = std::numeric_limits<T>::min();
+        const T hi = std::numeric_limits<T>::max();
+
+        if (b > 0 && a > hi - b)
+            return hi;
+        if (std::numeric_limits<T>::is_signed && b < 0 && a < lo - b)
+            return lo;
+
+        return static_cast<T>(a + b);
+    }
+    static double Apply(double a, double b) { return a + b; }
+};
+
+struct SaturatingSubtract
+{
+    template <typename T>
+    static T Apply(T a, T b)
+    {
+        const T lo = std::numeric_limits<T>::min();
+        const T hi = std::numeric_limits<T>::max();
+
+        if (std::numeric_limits<T>::is_signed)
+        {
+            if (b < 0 && a > hi + b)
+                return hi;
+            if (b > 0 && a < lo + b)
+                return lo;
+        }
+        else if (a < b)
+        {
+            return 0;
+        }
+
+        return static_cast<T>(a - b);
+    }
+    static double Apply(double a, double b) { return a - b; }
+};
+
+struct SaturatingMultiply
+{
+    template <typename T>
+    static T Apply(T a, T b)
+    {
+        if (a == 0 || b == 0)
+            return 0;
+
+        const T  lo       = std::numeric_limits<T>::min();
+        const T  hi       = std::numeric_limits<T>::max();
+        bool     negative = std::numeric_limits<T>::is_signed && ((a < 0) != (b < 0));
+        uint64_t ua       = Magnitude(a);
+        uint64_t ub       = Magnitude(b);
+        uint64_t limit    = negative ? Magnitude(lo) : static_cast<uint64_t>(hi);
+
+        if (ua > limit / ub)
+            return negative ? lo : hi;
+
+        uint64_t product = ua * ub;
+
+        return negative ? static_cast<T>(0 - product) : static_cast<T>(product);
+    }
+    static double Apply(double a, double b) { return a * b; }
+};
+
+struct SaturatingDivide
+{
+    template <typename T>
+    static T Apply(T a, T b)
+    {
+        const T lo = std::numeric_limits<T>::min();
+        const T hi = std::numeric_limits<T>::max();
+
+        if (b == 0)
+            return (a == 0) ? 0 : ((a > 0) ? hi : lo);
+        if (std::numeric_limits<T>::is_signed && a == lo && b == static_cast<T>(-1))
+            return hi;
+
+        T    quotient  = static_cast<T>(a / b);
+        T    remainder = static_cast<T>(a % b);
+        bool negative  = std::numeric_limits<T>::is_signed && ((a < 0) != (b < 0));
+
+        // round half away from zero
+        uint64_t ur = Magnitude(remainder);
+        uint64_t ub = Magnitude(b);
+
+        if (ur >= ub - ur)
+            quotient = negative ? static_cast<T>(quotient - 1) : static_cast<T>(quotient + 1);
+
+        return quotient;
+    }
+    static double Apply(double a, double b) { return a / b; }
+};
+
+//------------------------------------------------------------------------------
+// Elementwise operand, either integer data of the result class or real doubles
+//------------------------------------------------------------------------------
+template <typename T>
+struct IntegerOperand
+{
+    explicit IntegerOperand(const Currency& cur)
+        : ints(NULL), dbls(NULL), m(1), n(1), value(0.0)
+    {
+        if (cur.IsIntegerType())
+        {
+            const hwTMatrix<T, hwTComplex<T> >* mtx = cur.MatrixInt<T>();
+            ints = mtx->GetRealData();
+            m    = mtx->M();
+            n    = mtx->N();
+        }
+        else if (cur.IsScalar())
+        {
+            value = cur.Scalar();
+            dbls  = &value;
+        }
+        else
+        {
+            const hwMatrix* mtx = cur.Matrix();
+            dbls = mtx->GetRealData();
+            m    = mtx->M();
+            n    = mtx->N();
+        }
+    }
+
+    int64_t Size() const            { return static_cast<int64_t>(m) * n; }
+    double  Get(int64_t index) const { return ints ? static_cast<double>(ints[index]) : dbls[index]; }
+
+    const T*      ints;   //!< Integer data, if the operand is an integer
+    const double* dbls;   //!< Double data, if the operand is a double
+    int           m;      //!< Number of rows
+    int           n;      //!< Number of columns
+    double        value;  //!< Storage for a double scalar
+
+private:
+    IntegerOperand(const IntegerOperand&);
+};
+
+template <typename T, typename Op>
+static void ApplyElementwise(const IntegerOperand<T>& a, const IntegerOperand<T>& b, T* out, int64_t size)
+{
+    int64_t stepA = (a.Size() == 1) ? 0 : 1;
+    int64_t stepB = (b.Size() == 1) ? 0 : 1;
+
+    if (a.ints && b.ints)
+    {
+        for (int64_t i = 0; i < size; ++i)
+            out[i] = Op::Apply(a.ints[i * stepA], b.ints[i * stepB]);
+    }
+    else
+    {
+        for (int64_t i = 0; i < size; ++i)
+            out[i] = SaturateCast<T>(Op::Apply(a.Get(i * stepA), b.Get(i * stepB)));
+    }
+}
+
+struct ElementwiseFunctor
+{
+    ElementwiseFunctor(const Currency& l, const Currency& r, IntegerArithmetic::Operation o)
+        : lhs(l), rhs(r), op(o), done(false) {}
+
+    template <typename T>
+    void Apply()
+    {
+        typedef hwTMatrix<T, hwTComplex<T> > MatrixT;
+
+        IntegerOperand<T> a(lhs);
+        IntegerOperand<T> b(rhs);
+
+        bool scalarA = a.Size() == 1;
+        bool scalarB = b.Size() == 1;
+
+        if (!scalarA && !scalarB && (a.m != b.m || a.n != b.n))
+            return;
+
+        int      m   = scalarA ? b.m : a.m;
+        int      n   = scalarA ? b.n : a.n;
+        MatrixT* out = new MatrixT(m, n, MatrixT::REAL);
+
+        result = out;
+
+        switch (op)
+        {
+            case IntegerArithmetic::OP_ADD:
+                ApplyElementwise<T, SaturatingAdd>(a, b, out->GetRealData(), out->Size());
+                break;
+            case IntegerArithmetic::OP_SUBTRACT:
+                ApplyElementwise<T, SaturatingSubtract>(a, b, out->GetRealData(), out->Size());
+                break;
+            case IntegerArithmetic::OP_MULTIPLY:
+                ApplyElementwise<T, SaturatingMultiply>(a, b, out->GetRealData(), out->Size());
+                break;
+            case IntegerArithmetic::OP_DIVIDE:
+                ApplyElementwise<T, SaturatingDivide>(a, b, out->GetRealData(), out->Size());
+                break;
+        }
+
+        done = true;
+    }
+
+    const Currency&              lhs;
+    const Currency&              rhs;
+    IntegerArithmetic::Operation op;
+    Currency                     result;
+    bool                         done;
+};
+
+struct NegateFunctor
+{
+    explicit NegateFunctor(const Currency& in) : input(in) {}
+
+    template <typename T>
+    void Apply()
+    {
+        typedef hwTMatrix<T, hwTComplex<T> > MatrixT;
+
+        const MatrixT* src  = input.MatrixInt<T>();
+        MatrixT*       out  = new MatrixT(src->M(), src->N(), MatrixT::REAL);
+        int64_t        size = src->Size();
+
+        result = out;
+
+        const T* a = src->GetRealData();
+        T*       b = out->GetRealData();
+
+        for (int64_t i = 0; i < size; ++i)
+            b[i] = SaturatingSubtract::Apply<T>(0, a[i]);
+    }
+
+    const Currency& input;
+    Currency        result;
+};
+
+struct TransposeFunctor
+{
+    explicit TransposeFunctor(const Currency& in) : input(in) {}
+
+    template <typename T>
+    void Apply()
+    {
+        typedef hwTMatrix<T, hwTComplex<T> > MatrixT;
+
+        MatrixT* out = new MatrixT;
+        result = out;
+        out->Transpose(*input.MatrixInt<T>());
+    }
+
+    const Currency& input;
+    Currency        result;
+};
+
+struct ElementFunctor
+{
+    ElementFunctor(const Currency& in, int64_t idx) : input(in), index(idx) {}
+
+    template <typename T>
+    void Apply()
+    {
+        typedef hwTMatrix<T, hwTComplex<T> > MatrixT;
+
+        MatrixT* out = new MatrixT(1, 1, MatrixT::REAL);
+        result = out;
+        (*out)(0) = (*input.MatrixInt<T>())(index);
+    }
+
+    const Currency& input;
+    int64_t         index;
+    Currency        result;
+};
+//------------------------------------------------------------------------------
+// Applies an elementwise operation
+//------------------------------------------------------------------------------
+bool IntegerArithmetic::Elementwise(const Currency& lhs, const Currency& rhs, Operation op, Currency& result)
+{
+    ElementwiseFunctor functor(lhs, rhs, op);
+
+    DispatchInteger(lhs.IsIntegerType() ? lhs.GetType() : rhs.GetType(), functor);
+
+    if (functor.done)
+        result = functor.result;
+
+    return functor.done;
+}
+//------------------------------------------------------------------------------
+// Returns the negation of an integer value
+//------------------------------------------------------------------------------
+Currency IntegerArithmetic::Negate(const Currency& op)
+{
+    NegateFunctor functor(op);
+    DispatchInteger(op.GetType(), functor);
+    return functor.result;
+}
+//------------------------------------------------------------------------------
+// Returns the transpose of an integer value
+//------------------------------------------------------------------------------
+Currency IntegerArithmetic::Transpose(const Currency& op)
+{
+    TransposeFunctor functor(op);
+    DispatchInteger(op.GetType(), functor);
+    return functor.result;
+}
+//------------------------------------------------------------------------------
+// Returns the given element of an integer value
+//------------------------------------------------------------------------------
+Currency IntegerArithmetic::Element(const Currency& op, int64_t index)
+{
+    ElementFunctor functor(op, index);
+    DispatchInteger(op.GetType(), functor);
+    return functor.result;
+}
@@ -0,0 +1,174 @@
+/**
+* @file IntegerArithmetic.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+#ifndef __INTEGER_ARITHMETIC_H__
+#define __INTEGER_ARITHMETIC_H__
+
+// Begin defines/includes
+#include <cmath>
+#include <limits>
+
+#include "Currency.h"
+#include "hwMatrix.h"
+
+// End defines/includes
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Class names and currency types of the integer element types
+//!
+//------------------------------------------------------------------------------
+template <typename T> struct IntegerTraits;
+
+template <> struct IntegerTraits<int8_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_INT8; }
+    static const char* Name() { return "int8"; }
+};
+template <> struct IntegerTraits<int16_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_INT16; }
+    static const char* Name() { return "int16"; }
+};
+template <> struct IntegerTraits<int32_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_INT32; }
+    static const char* Name() { return "int32"; }
+};
+template <> struct IntegerTraits<int64_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_INT64; }
+    static const char* Name() { return "int64"; }
+};
+template <> struct IntegerTraits<uint8_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_UINT8; }
+    static const char* Name() { return "uint8"; }
+};
+template <> struct IntegerTraits<uint16_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_UINT16; }
+    static const char* Name() { return "uint16"; }
+};
+template <> struct IntegerTraits<uint32_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_UINT32; }
+    static const char* Name() { return "uint32"; }
+};
+template <> struct IntegerTraits<uint64_t>
+{
+    static Currency::CurrencyType Type() { return Currency::TYPE_UINT64; }
+    static const char* Name() { return "uint64"; }
+};
+
+//!
+//! Calls op.template Apply<T>() with the element type of an integer currency
+//! type. Returns false if the type is not an integer type.
+//! \param type Currency type
+//! \param op   Functor with a templated Apply member
+//!
+template <typename Op>
+bool DispatchInteger(int type, Op& op)
+{
+    switch (type)
+    {
+        case Currency::TYPE_INT8:   op.template Apply<int8_t>();   return true;
+        case Currency::TYPE_INT16:  op.template Apply<int16_t>();  return true;
+        case Currency::TYPE_INT32:  op.template Apply<int32_t>();  return true;
+        case Currency::TYPE_INT64:  op.template Apply<int64_t>();  return true;
+        case Currency::TYPE_UINT8:  op.template Apply<uint8_t>();  return true;
+        case Currency::TYPE_UINT16: op.template Apply<uint16_t>(); return true;
+        case Currency::TYPE_UINT32: op.template Apply<uint32_t>(); return true;
+        case Currency::TYPE_UINT64: op.template Apply<uint64_t>(); return true;
+        default:                                                   return false;
+    }
+}
+
+//!
+//! Converts a double to an integer type, rounding half away from zero and
+//! saturating at the limits of the type. NaN converts to zero.
+//! \param value Value to convert
+//!
+template <typename T>
+T SaturateCast(double value)
+{
+    if (value != value)
+        return 0;
+
+    double rounded = std::round(value);
+
+    // the 64 bit limits round up to a power of two, which is still a safe bound
+    if (rounded <= static_cast<double>(std::numeric_limits<T>::min()))
+        return std::numeric_limits<T>::min();
+    if (rounded >= static_cast<double>(std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+
+    return static_cast<T>(rounded);
+}
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Saturating elementwise arithmetic on integer matrices
+//!
+//! Operands of the same integer class are combined exactly, with results
+//! outside the range of the class clamped to its limits. An integer and a
+//! double are combined in double precision and the result is rounded and
+//! saturated back to the integer class. Division rounds to the nearest
+//! integer; a nonzero value divided by zero saturates and 0/0 is zero.
+//!
+//------------------------------------------------------------------------------
+class IntegerArithmetic
+{
+public:
+    //!
+    //! Supported operations
+    //!
+    enum Operation
+    {
+        OP_ADD,
+        OP_SUBTRACT,
+        OP_MULTIPLY,
+        OP_DIVIDE
+    };
+
+    //!
+    //! Applies an elementwise operation. Returns false, leaving result
+    //! unchanged, if neither operand is a scalar and their sizes differ.
+    //! \param lhs    First operand, an integer or a real double
+    //! \param rhs    Second operand, an integer or a real double
+    //! \param op     Operation
+    //! \param result Integer result, of the class of the integer operand
+    //!
+    static bool Elementwise(const Currency& lhs, const Currency& rhs, Operation op, Currency& result);
+    //!
+    //! Returns the negation of an integer value
+    //! \param op Integer operand
+    //!
+    static Currency Negate(const Currency& op);
+    //!
+    //! Returns the transpose of an integer value
+    //! \param op Integer operand
+    //!
+    static Currency Transpose(const Currency& op);
+    //!
+    //! Returns the given element of an integer value as a 1x1 integer value
+    //! \param op    Integer operand
+    //! \param index Zero based linear index, which must be in range
+    //!
+    static Currency Element(const Currency& op, int64_t index);
+};
+
+#endif
@@ -0,0 +1,383 @@
+/**
+* @file LogicalArray.cpp
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+// Begin defines/includes
+#include "LogicalArray.h"
+
+#include "EvaluatorInt.h"
+#include "OML_Error.h"
+#include "hwThreadPool.h"
+
+#include <limits>
+
+// End defines/includes
+
+//------------------------------------------------------------------------------
+// An operand of a logical kernel: packed flags, real doubles or a real scalar
+//------------------------------------------------------------------------------
+struct LogicalOperand
+{
+    LogicalOperand() : flags(NULL), values(NULL), scalar(0.0), m(1), n(1) {}
+
+    // Returns false if the currency is not supported. Packed arrays are read
+    // without being unpacked.
+    bool Read(const Currency& cur)
+    {
+        if (cur.IsPackedLogical())
+        {
+            const hwMatrixB* mtx = cur.MatrixB();
+            flags = mtx->GetRealData();
+            m     = mtx->M();
+            n     = mtx->N();
+            return true;
+        }
+
+        if (cur.GetType() == Currency::TYPE_SCALAR)
+        {
+            scalar = cur.Scalar();
+            return true;
+        }
+
+        if (cur.GetType() != Currency::TYPE_MATRIX || cur.GetMask() == Currency::MASK_STRING)
+            return false;
+
+        const hwMatrix* mtx = cur.Matrix();
+
+        if (!mtx->IsReal() || mtx->IsEmpty())
+            return false;
+
+        if (mtx->Size() == 1)
+        {
+            scalar = (*mtx)(0);
+            return true;
+        }
+
+        values = mtx->GetRealData();
+        m      = mtx->M();
+        n      = mtx->N();
+        return true;
+    }
+
+    bool IsArray() const { return flags || values; }
+
+    const bool*   flags;
+    const double* values;
+    double        scalar;
+    int           m;
+    int           n;
+};
+
+struct ScalarValues
+{
+    explicit ScalarValues(double v) : value(v) {}
+    double operator[](int64_t) const { return value; }
+    double value;
+};
+
+struct DoubleValues
+{
+    explicit DoubleValues(const double* v) : values(v) {}
+    double operator[](int64_t i) const { return values[i]; }
+    const double* values;
+};
+
+struct FlagValues
+{
+    explicit FlagValues(const bool* v) : flags(v) {}
+    double operator[](int64_t i) const { return flags[i] ? 1.0 : 0.0; }
+    const bool* flags;
+};
+
+struct LessThan     { static bool Apply(double a, double b) { return a < b; } };
+struct GreaterThan  { static bool Apply(double a, double b) { return a > b; } };
+struct LessEqual    { static bool Apply(double a, double b) { return a <= b; } };
+struct GreaterEqual { static bool Apply(double a, double b) { return a >= b; } };
+struct Equal        { static bool Apply(double a, double b) { return a == b; } };
+struct NotEqual     { static bool Apply(double a, double b) { return a != b; } };
+// NaN is true, as in the double precision path
+struct LogicalAnd   { static bool Apply(double a, double b) { return (a != 0.0) && (b != 0.0); } };
+struct LogicalOr    { static bool Apply(double a, double b) { return (a != 0.0) || (b != 0.0); } };
+
+//------------------------------------------------------------------------------
+// Applies a binary predicate elementwise
+//------------------------------------------------------------------------------
+template <typename Pred, typename L, typename R>
+static void ApplyLoop(const L& lhs, const R& rhs, bool* out, int64_t size)
+{
+    hwThreadPool::ParallelFor(size, [=](int64_t begin, int64_t end)
+    {
+        for (int64_t i = begin; i < end; ++i)
+            out[i] = Pred::Apply(lhs[i], rhs[i]);
+    });
+}
+
+template <typename Pred, typename L>
+static void ApplyRhs(const L& lhs, const LogicalOperand& rhs, bool* out, int64_t size)
+{
+    if (rhs.flags)
+        ApplyLoop<Pred>(lhs, FlagValues(rhs.flags), out, size);
+    else if (rhs.values)
+        ApplyLoop<Pred>(lhs, DoubleValues(rhs.values), out, size);
+    else
+        ApplyLoop<Pred>(lhs, ScalarValues(rhs.scalar), out, size);
+}
+
+template <typename Pred>
+static void ApplyOperands(const LogicalOperand& lhs, const LogicalOperand& rhs, bool* out, int64_t size)
+{
+    if (lhs.flags)
+        ApplyRhs<Pred>(FlagValues(lhs.flags), rhs, out, size);
+    else if (lhs.values)
+        ApplyRhs<Pred>(DoubleValues(lhs.values), rhs, out, size);
+    else
+        ApplyRhs<Pred>(ScalarValues(lhs.scalar), rhs, out, size);
+}
+
+//------------------------------------------------------------------------------
+// Reads two operands and allocates flags of the result size. Returns NULL if
+// the operands are not supported, if neither is an array, or if both are
+// arrays of different sizes.
+//------------------------------------------------------------------------------
+static hwMatrixB* BinaryResult(const Currency& lhs, const Currency& rhs,
+                               LogicalOperand& l, LogicalOperand& r)
+{
+    if (!l.Read(lhs) || !r.Read(rhs))
+        return NULL;
+
+    if (l.IsArray() && r.IsArray())
+    {
+        if (l.m != r.m || l.n != r.n)
+            return NULL;
+    }
+    else if (!l.IsArray() && !r.IsArray())
+    {
+        return NULL;
+    }
+
+    const LogicalOperand& shape = l.IsArray() ? l : r;
+
+    return new hwMatrixB(shape.m, shape.n, hwMatrixB::REAL);
+}
+//------------------------------------------------------------------------------
+// Compares elementwise
+//------------------------------------------------------------------------------
+bool LogicalArray::Compare(const Currency& lhs, const Currency& rhs, Comparison cmp, Currency& result)
+{
+    LogicalOperand l;
+    LogicalOperand r;
+    hwMatrixB*     flags = BinaryResult(lhs, rhs, l, r);
+
+    if (!flags)
+        return false;
+
+    bool* out  = flags->GetRealData();
+    int64_t size = flags->Size();
+
+    switch (cmp)
+    {
+        case CMP_LT: ApplyOperands<LessThan>(l, r, out, size);     break;
+        case CMP_GT: ApplyOperands<GreaterThan>(l, r, out, size);  break;
+        case CMP_LE: ApplyOperands<LessEqual>(l, r, out, size);    break;
+        case CMP_GE: ApplyOperands<GreaterEqual>(l, r, out, size); break;
+        case CMP_EQ: ApplyOperands<Equal>(l, r, out, size);        break;
+        case CMP_NE: ApplyOperands<NotEqual>(l, r, out, size);     break;
+    }
+
+    result = FromFlags(flags);
+    return true;
+}
+//------------------------------------------------------------------------------
+// Applies elementwise & or |
+//------------------------------------------------------------------------------
+bool LogicalArray::Combine(const Currency& lhs, const Currency& rhs, bool is_and, Currency& result)
+{
+    LogicalOperand l;
+    LogicalOperand r;
+    hwMatrixB*     flags = BinaryResult(lhs, rhs, l, r);
+
+    if (!flags)
+        return false;
+
+    if (is_and)
+        ApplyOperands<LogicalAnd>(l, r, flags->GetRealData(), flags->Size());
+    else
+        ApplyOperands<LogicalOr>(l, r, flags->GetRealData(), flags->Size());
+
+    result = FromFlags(flags);
+    return true;
+}
+//------------------------------------------------------------------------------
+// Applies !
+//------------------------------------------------------------------------------
+bool LogicalArray::Not(const Currency& op, Currency& result)
+{
+    LogicalOperand o;
+
+    if (!o.Read(op) || !o.IsArray())
+        return false;
+
+    hwMatrixB* flags = new hwMatrixB(o.m, o.n, hwMatrixB::REAL);
+
+    // !x is x == 0, which is false for NaN
+    ApplyOperands<Equal>(o, LogicalOperand(), flags->GetRealData(), flags->Size());
+
+    result = FromFlags(flags);
+    return true;
+}
+//------------------------------------------------------------------------------
+// Selects the elements of a real matrix where a mask is set
+//------------------------------------------------------------------------------
+bool LogicalArray::Select(const hwMatrix& data, const hwMatrixB& mask, Currency& result)
+{
+    bool is_vector = (mask.M() == 1 || mask.N() == 1);
+
+    if (mask.Size() > data.Size())
+        return false;
+
+    if (!is_vector && (mask.M() != data.M() || mask.N() != data.N()))
+        return false;
+
+    const bool*   flags  = mask.GetRealData();
+    const double* values = data.GetRealData();
+    int64_t       size   = mask.Size();
+    int64_t       count  = Count(mask);
+
+    if (count > std::numeric_limits<int>::max())
+        throw OML_Error(HW_MATH_MSG_ARRAYTOOLARGE);
+
+    hwMatrix* ret;
+
+    if (is_vector && data.M() != 1 && data.N() == 1)
+        ret = EvaluatorInterface::allocateMatrix(static_cast<int>(count), 1, hwMatrix::REAL);
+    else
+        ret = EvaluatorInterface::allocateMatrix(1, static_cast<int>(count), hwMatrix::REAL);
+
+    double* out = ret->GetRealData();
+
+    for (int64_t i = 0; i < size; ++i)
+    {
+        if (flags[i])
+            *out++ = values[i];
+    }
+
+    result = ret;
+    return true;
+}
+//------------------------------------------------------------------------------
+// Collects the indices of the set flags
+//------------------------------------------------------------------------------
+void LogicalArray::Find(const hwMatrixB& mask, int limit, bool from_end, std::vector<int64_t>& indices)
+{
+    const bool* flags = mask.GetRealData();
+    int64_t     size  = mask.Size();
+
+    if (limit < 0)
+        indices.reserve(Count(mask));
+
+    int     incr  = from_end ? -1 : 1;
+    int64_t first = from_end ? size - 1 : 0;
+
+    for (int64_t i = first; i >= 0 && i < size; i += incr)
+    {
+        if (!flags[i])
+            continue;
+
+        if (limit >= 0 && static_cast<int>(indices.size()) >= limit)
+            break;
+
+        indices.push_back(i);
+    }
+}
+//------------------------------------------------------------------------------
+// Returns the number of set flags
+//------------------------------------------------------------------------------
+int64_t LogicalArray::Count(const hwMatrixB& mask)
+{
+    const bool* flags = mask.GetRealData();
+
+    return hwThreadPool::Reduce<int64_t>(mask.Size(),
+        [=](int64_t begin, int64_t end)
+        {
+            int64_t count = 0;
+
+            for (int64_t i = begin; i < end; ++i)
+                count += flags[i] ? 1 : 0;
+
+            return count;
+        },
+        [](int64_t a, int64_t b) { return a + b; });
+}
+//------------------------------------------------------------------------------
+// Reduces the flags along a dimension
+//------------------------------------------------------------------------------
+hwMatrix* LogicalArray::Reduce(const hwMatrixB& mask, int dim, Reduction red)
+{
+    int         m     = mask.M();
+    int         n     = mask.N();
+    const bool* flags = mask.GetRealData();
+
+    int       count  = (dim == 1) ? n : m;   // number of results
+    int       length = (dim == 1) ? m : n;   // elements reduced into each
+    int       stride = (dim == 1) ? 1 : m;   // distance between them
+    int       step   = (dim == 1) ? m : 1;   // distance between the results
+    hwMatrix* ret    = (dim == 1) ? EvaluatorInterface::allocateMatrix(1, n, hwMatrix::REAL)
+                                  : EvaluatorInterface::allocateMatrix(m, 1, hwMatrix::REAL);
+    double*   out    = ret->GetRealData();
+
+    hwThreadPool::ParallelFor(count, [=](int64_t begin, int64_t end)
+    {
+        for (int64_t k = begin; k < end; ++k)
+        {
+            const bool* src = flags + k * step;
+            int         set = 0;
+
+            for (int i = 0; i < length; ++i)
+                set += src[i * stride] ? 1 : 0;
+
+            if (red == RED_SUM)
+                out[k] = set;
+            else if (red == RED_ANY)
+                out[k] = (set > 0) ? 1.0 : 0.0;
+            else
+                out[k] = (set == length) ? 1.0 : 0.0;
+        }
+    }, length);
+
+    return ret;
+}
+//------------------------------------------------------------------------------
+// Returns a currency for logical flags
+//------------------------------------------------------------------------------
+Currency LogicalArray::FromFlags(hwMatrixB* flags)
+{
+    if (flags->Size() >= 2)
+        return flags;
+
+    Currency ret;
+
+    if (flags->Size() == 1)
+    {
+        ret = Currency((*flags)(0));
+    }
+    else
+    {
+        ret = EvaluatorInterface::allocateMatrix(flags->M(), flags->N(), hwMatrix::REAL);
+        ret.SetMask(Currency::MASK_LOGICAL);
+    }
+
+    delete flags;
+    return ret;
+}
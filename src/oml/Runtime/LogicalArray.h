@@ -0,0 +1,125 @@
+/**
+* @file LogicalArray.h
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+#ifndef __LOGICAL_ARRAY_H__
+#define __LOGICAL_ARRAY_H__
+
+// Begin defines/includes
+#include <vector>
+
+#include "Currency.h"
+#include "hwMatrix.h"
+
+// End defines/includes
+
+//------------------------------------------------------------------------------
+//!
+//! \brief Kernels on logical arrays packed with one byte per element
+//!
+//! Comparisons, elementwise & and |, and ! of real double arrays produce
+//! packed logical arrays. Packed arrays always have at least two elements;
+//! results with fewer are returned as before, as logical scalars or empty
+//! matrices. Each kernel returns false, leaving its result unchanged, if an
+//! operand is not a real scalar, a real double matrix or a packed logical
+//! array, so that the caller can fall back to the double precision path.
+//!
+//------------------------------------------------------------------------------
+class LogicalArray
+{
+public:
+    //!
+    //! Supported comparisons
+    //!
+    enum Comparison
+    {
+        CMP_LT,
+        CMP_GT,
+        CMP_LE,
+        CMP_GE,
+        CMP_EQ,
+        CMP_NE
+    };
+    //!
+    //! Supported reductions, which are done along a dimension
+    //!
+    enum Reduction
+    {
+        RED_SUM,
+        RED_ANY,
+        RED_ALL
+    };
+
+    //!
+    //! Compares elementwise. Array operands must have the same size.
+    //! \param lhs    First operand
+    //! \param rhs    Second operand
+    //! \param cmp    Comparison
+    //! \param result Packed logical result
+    //!
+    static bool Compare(const Currency& lhs, const Currency& rhs, Comparison cmp, Currency& result);
+    //!
+    //! Applies elementwise & or |. Array operands must have the same size.
+    //! \param lhs    First operand
+    //! \param rhs    Second operand
+    //! \param is_and True for &, false for |
+    //! \param result Packed logical result
+    //!
+    static bool Combine(const Currency& lhs, const Currency& rhs, bool is_and, Currency& result);
+    //!
+    //! Applies !
+    //! \param op     Operand, which must be an array
+    //! \param result Packed logical result
+    //!
+    static bool Not(const Currency& op, Currency& result);
+    //!
+    //! Selects the elements of a real matrix where a mask is set, as a column
+    //! if data is a column vector and as a row otherwise. Returns false if the
+    //! mask has more elements than data, or if it is not a vector and its
+    //! dimensions differ from those of data.
+    //! \param data   Real matrix
+    //! \param mask   Logical flags
+    //! \param result Selected elements
+    //!
+    static bool Select(const hwMatrix& data, const hwMatrixB& mask, Currency& result);
+    //!
+    //! Collects the zero based indices of the set flags, in search order
+    //! \param mask     Logical flags
+    //! \param limit    Maximum number of indices, or -1 for no limit
+    //! \param from_end True to search from the last element
+    //! \param indices  Indices
+    //!
+    static void Find(const hwMatrixB& mask, int limit, bool from_end, std::vector<int64_t>& indices);
+    //!
+    //! Returns the number of set flags
+    //! \param mask Logical flags
+    //!
+    static int64_t Count(const hwMatrixB& mask);
+    //!
+    //! Reduces the flags along a dimension, giving a 1 x n result for
+    //! dimension 1 and an m x 1 result for dimension 2
+    //! \param mask Logical flags
+    //! \param dim  Dimension, 1 or 2
+    //! \param red  Reduction
+    //!
+    static hwMatrix* Reduce(const hwMatrixB& mask, int dim, Reduction red);
+    //!
+    //! Returns a currency for logical flags, packed if there are at least two
+    //! \param flags Logical flags, which are owned by the result
+    //!
+    static Currency FromFlags(hwMatrixB* flags);
+};
+
+#endif
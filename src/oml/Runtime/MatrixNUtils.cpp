@@ -270,14 +270,14 @@ bool oml_MatrixNUtil3(EvaluatorInterface eval, const std::vector<Currency>& inpu
 
     sliceDims2D[0] = -1;
     sliceDims2D[1] = 1;
-    int numVecs;
+    int64_t numVecs;
     
     if (dim < dims.size())
         numVecs = matrix->Size() / dims[dim];
     else
         numVecs = matrix->Size();
 
-    for (int i = 0; i < numVecs; ++i)
+    for (int64_t i = 0; i < numVecs; ++i)
     {
         // slice matrix to retrieve vector
         hwMatrixN slice;
@@ -412,14 +412,14 @@ bool oml_MatrixNUtil4(EvaluatorInterface eval, const std::vector<Currency>& inpu
 
     sliceDims2D[0] = -1;
     sliceDims2D[1] = 1;
-    int numVecs;
+    int64_t numVecs;
 
     if (dim < dims.size())
         numVecs = matrix->Size() / dims[dim];
     else
         numVecs = matrix->Size();
 
-    for (int i = 0; i < numVecs; ++i)
+    for (int64_t i = 0; i < numVecs; ++i)
     {
         // slice matrix to retrieve vector
         hwMatrixN slice;
@@ -534,6 +534,84 @@ bool oml_MatrixNUtil4(EvaluatorInterface eval, const std::vector<Currency>& inpu
     return true;
 }
 
+// Get the zero based dimension of a reduction from the optional argument at
+// position dimArg. The default is the first non-singleton dimension, which is
+// also used when the argument is [].
+static int reductionDim(const std::vector<Currency>& inputs, const std::vector<int>& dims, int dimArg)
+{
+    if (dimArg > 0 && static_cast<int>(inputs.size()) >= dimArg)
+    {
+        const Currency& arg = inputs[dimArg-1];
+
+        if (arg.IsPositiveInteger())
+            return static_cast<int>(arg.Scalar()) - 1;
+
+        if (!arg.IsMatrix() || arg.Matrix()->M() || arg.Matrix()->N())
+            throw OML_Error(OML_ERR_POSINTEGER, dimArg, OML_VAR_VARIABLE);
+    }
+
+    int numDim = static_cast<int>(dims.size());
+
+    for (int i = 0; i < numDim; ++i)
+    {
+        if (dims[i] != 1)
+            return i;
+    }
+
+    return 0;
+}
+
+// Apply a native hwMatrixN reduction or scan to each vector of an ND matrix in the
+// specified dimension, without copying the vectors to 2D matrices. The syntax is
+// func(ND, dim).
+bool oml_MatrixN_Reduce(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs,
+                        const MatrixN_reduce func, int dimArg)
+{
+    const hwMatrixN* matrix = inputs[0].MatrixN();
+    int dim = reductionDim(inputs, matrix->Dimensions(), dimArg);
+
+    std::unique_ptr<hwMatrixN> result(new hwMatrixN);
+
+    (result.get()->*func)(*matrix, dim);
+
+    outputs.push_back(result.release());
+    return true;
+}
+
+// Apply a native hwMatrixN extreme value function to each vector of an ND matrix in
+// the specified dimension, returning the 1-based indices as a second output. The
+// syntax is func(ND, [], dim).
+bool oml_MatrixN_Extreme(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs,
+                         const MatrixN_extreme func, int dimArg)
+{
+    size_t nargout = eval.GetNargoutValue();
+    const hwMatrixN* matrix = inputs[0].MatrixN();
+    int dim = reductionDim(inputs, matrix->Dimensions(), dimArg);
+
+    std::unique_ptr<hwMatrixN> result(new hwMatrixN);
+    std::unique_ptr<hwMatrixN> index;
+
+    if (nargout == 2)
+        index.reset(new hwMatrixN);
+
+    (result.get()->*func)(*matrix, dim, index.get());
+
+    outputs.push_back(result.release());
+
+    if (index)
+    {
+        int64_t size = index->Size();
+        double* data = index->GetRealData();
+
+        for (int64_t i = 0; i < size; ++i)
+            data[i] += 1.0;
+
+        outputs.push_back(index.release());
+    }
+
+    return true;
+}
+
 // ND support for dot and cross functions
 bool oml_MatrixN_VecProd(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs,
                          const OML_func1 oml_func, int vecLength)
@@ -613,14 +691,14 @@ bool oml_MatrixN_VecProd(EvaluatorInterface eval, const std::vector<Currency>& i
 
     sliceDims2D[0] = -1;
     sliceDims2D[1] = 1;
-    int numVecs;
+    int64_t numVecs;
     
     if (dim < dims1.size())
         numVecs = matrix1->Size() / dims1[dim];
     else
         numVecs = matrix1->Size();
 
-    for (int i = 0; i < numVecs; ++i)
+    for (int64_t i = 0; i < numVecs; ++i)
     {
         // slice matrix to retrieve vector
         hwMatrixN slice;
@@ -783,14 +861,14 @@ bool oml_MatrixN_diff(EvaluatorInterface eval, const std::vector<Currency>& inpu
 
     sliceDims2D[0] = -1;
     sliceDims2D[1] = 1;
-    int numVecs;
+    int64_t numVecs;
     
     if (dim < dims.size())
         numVecs = matrix->Size() / dims[dim];
     else
         numVecs = 0;    // actually matrix->Size(), but each yields []
 
-    for (int i = 0; i < numVecs; ++i)
+    for (int64_t i = 0; i < numVecs; ++i)
     {
         // slice matrix to retrieve vector
         hwMatrixN slice;
@@ -872,14 +950,14 @@ bool oml_MatrixN_circshift(EvaluatorInterface eval, const std::vector<Currency>&
 
     // shift each element
     const hwMatrix* shift = inputs[1].Matrix();
-    int numShifts = shift->Size();
-    int numElems = matrix->Size();
+    int64_t numShifts = shift->Size();
+    int64_t numElems = matrix->Size();
     int numDim = static_cast<int> (dims.size());
 
     std::vector<int> rhsMatrixIndex(numDim);
     std::vector<int> lhsMatrixIndex(numDim);
 
-    for (int i = 0; i < numShifts; ++i)
+    for (int64_t i = 0; i < numShifts; ++i)
     {
         int offset = static_cast<int>((*shift)(i)) % dims[i];
 
@@ -889,7 +967,7 @@ bool oml_MatrixN_circshift(EvaluatorInterface eval, const std::vector<Currency>&
         lhsMatrixIndex[i] = offset;
     }
 
-    for (int i = 0; i < numElems; ++i)
+    for (int64_t i = 0; i < numElems; ++i)
     {
         if (matrix->IsReal())
             (*outMatrix)(lhsMatrixIndex) = (*matrix)(i);
@@ -1289,7 +1367,7 @@ Currency oml_MatrixUtil(EvaluatorInterface& eval, const hwMatrix* mtx, int dim,
             result = EvaluatorInterface::allocateMatrix(mtx->M(), mtx->N(), hwMatrix::REAL);
             std::unique_ptr<hwMatrix> holder(EvaluatorInterface::allocateMatrix(1, 1, mtx->Type()));
             rescur = result;
-            for (int i = 0; i < mtx->Size(); ++i)
+            for (int64_t i = 0; i < mtx->Size(); ++i)
             {
                 if (holder->IsReal())
                     (*holder)(0) = (*mtx)(i);
@@ -30,6 +30,8 @@ typedef Currency (ExprTreeEvaluator::*OML_func3)(const Currency& op1, const Curr
 typedef Currency (ExprTreeEvaluator::*OML_func4)(const Currency& op1, const Currency& op2, int op);
 typedef bool (*OML_func5)(const Currency& op1, const Currency& op2);
 typedef bool (*OML_func6)(const Currency& op1, const Currency& op2, const Currency& tol);
+typedef void (hwMatrixN::*MatrixN_reduce)(const hwMatrixN& source, int dim);
+typedef void (hwMatrixN::*MatrixN_extreme)(const hwMatrixN& source, int dim, hwMatrixN* index);
 
 // Apply a function to each element of an ND matrix. The syntax is oml_func(ND).
 // Examples: cos(ND), assert(ND)
@@ -57,6 +59,22 @@ HML2DLL_DECLS
 bool oml_MatrixNUtil4(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs,
                       const OML_func1 oml_func, int dimArg = 0, int ndArg = 1);
 
+// Apply a native hwMatrixN reduction or scan to each vector of an ND matrix in the
+// specified dimension, without copying the vectors to 2D matrices. The syntax is
+// func(ND, dim).
+// Examples: sum(ND, dim), cumprod(ND, dim)
+HML2DLL_DECLS
+bool oml_MatrixN_Reduce(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs,
+                        const MatrixN_reduce func, int dimArg = 0);
+
+// Apply a native hwMatrixN extreme value function to each vector of an ND matrix in
+// the specified dimension, returning the 1-based indices as a second output. The
+// syntax is func(ND, [], dim).
+// Examples: max(ND), min(ND, [], dim)
+HML2DLL_DECLS
+bool oml_MatrixN_Extreme(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs,
+                         const MatrixN_extreme func, int dimArg = 0);
+
 // ND support for dot and cross functions
 bool oml_MatrixN_VecProd(EvaluatorInterface eval, const std::vector<Currency>& inputs, std::vector<Currency>& outputs,
                          const OML_func1 oml_func, int vecLength);
@@ -453,6 +453,9 @@ std::string GetComposeVarStr(omlMathVarCode varCode);
 #define HW_ERROR_NOTEMPSUBEXPNAME "Error: cannot have an empty sub-expression name"
 #define HW_ERROR_SUBEXPNAMNOCLOSINGGR "Error: sub-expression name in regular expression pattern did not have a closing '>'"
 #define HW_ERROR_NOTCONVINPTODOUBLE "Error: cannot convert input to double"
+#define HW_ERROR_NOTCONVINPTOSINGLE "Error: cannot convert input to single"
+#define HW_ERROR_NOTCONVINPTOINT "Error: cannot convert input to an integer class"
+#define HW_ERROR_INTEGERCLASS "Error: integers can only be combined with integers of the same class or real double and single values"
 #define HW_ERROR_LENNOTNEG "Error: length cannot be negative"
 #define HW_ERROR_SCALOUTCHARRANGE "Error: scalar outside of character range"
 #define HW_ERROR_INVINPSTRUCTANDCOMPNOTCONVSTR "Error: invalid input type: structs and complex values cannot be converted to strings"
@@ -0,0 +1,1279 @@
+/**
+* @file KrylovTboxFuncs.cxx
+* @date October 2026
+* Copyright (C) 2026 Altair Engineering, Inc.  
+* This file is part of the OpenMatrix Language (OpenMatrix) software.
+* Open Source License Information:
+* OpenMatrix is free software. You can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+* OpenMatrix is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public License for more details.
+* You should have received a copy of the GNU Affero General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+* 
+* Commercial License Information: 
+* For a copy of the commercial license terms and conditions, contact the Altair Legal Department at Legal@altair.com and in the subject line, use the following wording: Request for Commercial License Terms for OpenMatrix.
+* Altairs dual-license business model allows companies, individuals, and organizations to create proprietary derivative works of OpenMatrix and distribute them - whether embedded or bundled with other software - under a commercial license agreement.
+* Use of Altairs trademarks and logos is subject to Altair's trademark licensing policies.  To request a copy, email Legal@altair.com and in the subject line, enter: Request copy of trademark and logo usage policy.
+*/
+
+
+#include "MathUtilsTboxFuncs.h"
+
+#include <algorithm>
+#include <memory>  // For std::unique_ptr
+
+#include "BuiltInFuncsUtils.h"
+#include "FunctionInfo.h"
+#include "OML_Error.h"
+#include "KrylovSolvers.h"
+#include "SpectralSolvers.h"
+#include "StructData.h"
+#include "hwMatrixS.h"
+
+//------------------------------------------------------------------------------
+// An operand of a Krylov method, which is applied as A*x for a system and as
+// M\x for a preconditioner or a shift-invert operator
+//------------------------------------------------------------------------------
+struct KrylovOperand
+{
+    enum Kind { NONE, DENSE, SPARSE, FUNCTION, JACOBI, ILU };
+
+    KrylovOperand()
+        : kind(NONE), dense(nullptr), sparse(nullptr), funcInfo(nullptr),
+          funcPntr(nullptr), isAnon(false) {}
+
+    Kind             kind;
+    const hwMatrix*  dense;      //!< dense matrix
+    const hwMatrixS* sparse;     //!< sparse matrix
+    hwMatrix         factors;    //!< factors of a dense matrix to solve with
+    hwMatrixI        pivots;     //!< pivots of a dense matrix to solve with
+    hwMatrixS        lower;      //!< lower factor of a sparse matrix to solve with
+    hwMatrixS        upper;      //!< upper factor of a sparse matrix to solve with
+    std::vector<int> rowPerm;    //!< row permutation of the sparse factors
+    std::vector<int> colPerm;    //!< column permutation of the sparse factors
+    hwMatrixS        ilu;        //!< incomplete LU factors
+    hwMatrix         diag;       //!< diagonal of a Jacobi preconditioner
+    FunctionInfo*    funcInfo;   //!< function of a handle
+    FUNCPTR          funcPntr;   //!< built in function of a handle
+    bool             isAnon;     //!< true for an anonymous function
+};
+
+// File scope variables and functions
+static EvaluatorInterface* KRYLOV_eval_ptr = nullptr;
+static KrylovOperand*      KRYLOV_A        = nullptr;
+static KrylovOperand*      KRYLOV_M1       = nullptr;
+static KrylovOperand*      KRYLOV_M2       = nullptr;
+
+//------------------------------------------------------------------------------
+// Sets the file scope variables for the callbacks, and restores the previous
+// ones when it goes out of scope, since an operator function can itself call
+// a Krylov method
+//------------------------------------------------------------------------------
+class KrylovScope
+{
+public:
+    KrylovScope(EvaluatorInterface* eval,
+                KrylovOperand*      A,
+                KrylovOperand*      M1 = nullptr,
+                KrylovOperand*      M2 = nullptr)
+        : m_eval(KRYLOV_eval_ptr), m_A(KRYLOV_A), m_M1(KRYLOV_M1), m_M2(KRYLOV_M2)
+    {
+        KRYLOV_eval_ptr = eval;
+        KRYLOV_A        = A;
+        KRYLOV_M1       = M1;
+        KRYLOV_M2       = M2;
+    }
+    ~KrylovScope()
+    {
+        KRYLOV_eval_ptr = m_eval;
+        KRYLOV_A        = m_A;
+        KRYLOV_M1       = m_M1;
+        KRYLOV_M2       = m_M2;
+    }
+
+private:
+    EvaluatorInterface* m_eval;
+    KrylovOperand*      m_A;
+    KrylovOperand*      m_M1;
+    KrylovOperand*      m_M2;
+};
+
+//------------------------------------------------------------------------------
+// Calls the function of a handle operand with x and returns its result in y
+//------------------------------------------------------------------------------
+static hwMathStatus CallKrylovFunc(const KrylovOperand& op,
+                                   const hwMatrix&      x,
+                                   hwMatrix&            y)
+{
+    std::vector<Currency> outputs;
+    std::vector<Currency> inputs;
+
+    inputs.push_back(EvaluatorInterface::allocateMatrix(&x));
+    int numinputs = static_cast<int>(inputs.size());
+
+    if (op.isAnon)
+    {
+        outputs.push_back(KRYLOV_eval_ptr->CallInternalFunction(op.funcInfo, inputs));
+    }
+    else if (op.funcInfo)
+    {
+        outputs = KRYLOV_eval_ptr->DoMultiReturnFunctionCall(op.funcInfo,
+                  inputs, numinputs, 1, true);
+    }
+    else if (op.funcPntr)
+    {
+        outputs = KRYLOV_eval_ptr->DoMultiReturnFunctionCall(op.funcPntr,
+                  inputs, numinputs, 1, true);
+    }
+
+    if (outputs.empty())
+        return hwMathStatus(HW_MATH_ERR_USERFUNCFAIL);
+
+    const Currency& result = outputs[0];
+
+    if (result.IsScalar() || result.IsMatrix())
+    {
+        y = *result.ConvertToMatrix();
+        return hwMathStatus();
+    }
+
+    if (result.IsSparse())
+        return result.MatrixS()->Full(y);
+
+    return hwMathStatus(HW_MATH_ERR_USERFUNCMATRIX);
+}
+//------------------------------------------------------------------------------
+// Applies an operand to x, as y = op*x, or as y = op\x if solve is true
+//------------------------------------------------------------------------------
+static hwMathStatus ApplyKrylovOperand(const KrylovOperand& op,
+                                       const hwMatrix&      x,
+                                       hwMatrix&            y,
+                                       bool                 solve)
+{
+    switch (op.kind)
+    {
+        case KrylovOperand::DENSE:
+            if (solve)
+                return y.SolveFactored(op.factors, op.pivots, x);
+            return y.Mult(*op.dense, x);
+
+        case KrylovOperand::SPARSE:
+            if (solve)
+            {
+                y = x;
+                return hwMatrixS::SolveFactored(op.lower, op.upper, op.rowPerm,
+                                                op.colPerm, y);
+            }
+            return op.sparse->MultRight(x, y);
+
+        case KrylovOperand::FUNCTION:
+            return CallKrylovFunc(op, x, y);
+
+        case KrylovOperand::JACOBI:
+        {
+            y = x;
+
+            for (int i = 0; i < y.Size(); ++i)
+                y(i) /= op.diag(i);
+
+            return hwMathStatus();
+        }
+
+        case KrylovOperand::ILU:
+            return op.ilu.ILUSolve(x, y);
+
+        default:
+            y = x;
+            return hwMathStatus();
+    }
+}
+//------------------------------------------------------------------------------
+// Callback for the system operator
+//------------------------------------------------------------------------------
+static hwMathStatus KrylovSystem(const hwMatrix& x, hwMatrix& y)
+{
+    return ApplyKrylovOperand(*KRYLOV_A, x, y, false);
+}
+//------------------------------------------------------------------------------
+// Callback for the preconditioner, M = M1*M2
+//------------------------------------------------------------------------------
+static hwMathStatus KrylovPrecond(const hwMatrix& x, hwMatrix& y)
+{
+    if (KRYLOV_M2->kind == KrylovOperand::NONE)
+        return ApplyKrylovOperand(*KRYLOV_M1, x, y, true);
+
+    hwMatrix     temp;
+    hwMathStatus status = ApplyKrylovOperand(*KRYLOV_M1, x, temp, true);
+
+    if (!status.IsOk())
+        return status;
+
+    return ApplyKrylovOperand(*KRYLOV_M2, temp, y, true);
+}
+//------------------------------------------------------------------------------
+// Callback for the transpose of a system matrix
+//------------------------------------------------------------------------------
+static hwMathStatus KrylovSystemTrans(const hwMatrix& x, hwMatrix& y)
+{
+    const KrylovOperand& op = *KRYLOV_A;
+
+    if (op.kind == KrylovOperand::DENSE)
+        return y.MultTrans(*op.dense, true, x, false);
+
+    // A'*x = (x'*A)'
+    hwMatrix     xt;
+    hwMatrix     yt;
+    hwMathStatus status = xt.Transpose(x);
+
+    if (status.IsOk())
+        status = op.sparse->MultLeft(xt, yt);
+
+    if (status.IsOk())
+        status = y.Transpose(yt);
+
+    return status;
+}
+//------------------------------------------------------------------------------
+// Callback for a shift-invert operator, y = (A-sigma*I)\x, where A holds the
+// factors of the shifted matrix
+//------------------------------------------------------------------------------
+static hwMathStatus KrylovShiftInvert(const hwMatrix& x, hwMatrix& y)
+{
+    return ApplyKrylovOperand(*KRYLOV_A, x, y, true);
+}
+//------------------------------------------------------------------------------
+// Sets an operand from a matrix, sparse matrix or function handle argument,
+// and checks that a matrix is n x n
+//------------------------------------------------------------------------------
+static void SetKrylovOperand(EvaluatorInterface& eval,
+                             const Currency&     input,
+                             int                 argNum,
+                             int                 n,
+                             bool                precond,
+                             KrylovOperand&      op)
+{
+    if (input.IsFunctionHandle())
+    {
+        std::string funcName = input.FunctionHandle()->FunctionName();
+
+        if (funcName == "anonymous")
+        {
+            op.funcInfo = input.FunctionHandle();
+            op.isAnon   = op.funcInfo->RedirectedFunction().empty();
+        }
+        else if (!eval.FindFunctionByName(funcName, &op.funcInfo, &op.funcPntr))
+        {
+            throw OML_Error(OML_ERR_FUNCNAME, argNum);
+        }
+
+        op.kind = KrylovOperand::FUNCTION;
+        return;
+    }
+
+    if (input.IsSparse())
+    {
+        op.sparse = input.MatrixS();
+
+        if (op.sparse->M() != n || op.sparse->N() != n)
+            throw OML_Error(OML_ERR_ARRAYSIZE, argNum, 2);
+
+        op.kind = KrylovOperand::SPARSE;
+
+        if (precond)
+        {
+            // factor once, so that each application is a pair of sparse
+            // triangular solves
+            hwMathStatus status = op.sparse->Factor(op.lower, op.upper,
+                                                    op.rowPerm, op.colPerm);
+
+            if (!status.IsOk())
+            {
+                status.SetArg1(argNum);
+                BuiltInFuncsUtils::CheckMathStatus(eval, status);
+            }
+        }
+        return;
+    }
+
+    if (!input.IsScalar() && !input.IsMatrix())
+        throw OML_Error(OML_ERR_MATRIX, argNum, OML_VAR_TYPE);
+
+    const hwMatrix* mtx = input.ConvertToMatrix();
+
+    if (precond && mtx->IsEmpty())
+        return;
+
+    if (!mtx->IsReal())
+        throw OML_Error(OML_ERR_REAL, argNum, OML_VAR_TYPE);
+
+    if (mtx->M() != n || mtx->N() != n)
+        throw OML_Error(OML_ERR_ARRAYSIZE, argNum, 2);
+
+    op.dense = mtx;
+    op.kind  = KrylovOperand::DENSE;
+
+    if (precond)
+    {
+        // factor once, so that each application is a pair of triangular solves
+        hwMathStatus status = op.factors.Factor(*mtx, op.pivots);
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(argNum);
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Sets a 'jacobi' or 'ilu' preconditioner built from the system matrix
+//------------------------------------------------------------------------------
+static void SetKrylovPrecondOption(EvaluatorInterface&  eval,
+                                   const std::string&   option,
+                                   int                  argNum,
+                                   const KrylovOperand& A,
+                                   KrylovOperand&       op)
+{
+    if (A.kind != KrylovOperand::DENSE && A.kind != KrylovOperand::SPARSE)
+        throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_VALUE);
+
+    hwMathStatus status;
+
+    if (option == "jacobi")
+    {
+        int n = A.dense ? A.dense->M() : A.sparse->M();
+
+        status = op.diag.Dimension(n, 1, hwMatrix::REAL);
+
+        for (int i = 0; status.IsOk() && i < n; ++i)
+        {
+            op.diag(i) = A.dense ? (*A.dense)(i, i) : (*A.sparse)(i, i);
+
+            if (op.diag(i) == 0.0)
+                status(HW_MATH_ERR_DIVIDEZERO);
+        }
+
+        op.kind = KrylovOperand::JACOBI;
+    }
+    else if (option == "ilu")
+    {
+        // the factors keep the nonzero pattern of A
+        if (A.sparse)
+        {
+            status = op.ilu.ILU0(*A.sparse);
+        }
+        else
+        {
+            hwMatrixS sparse;
+            status = sparse.Convert(*A.dense);
+
+            if (status.IsOk())
+                status = op.ilu.ILU0(sparse);
+        }
+
+        op.kind = KrylovOperand::ILU;
+    }
+    else
+    {
+        throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_VALUE);
+    }
+
+    if (!status.IsOk())
+    {
+        status.SetArg1(argNum);
+        BuiltInFuncsUtils::CheckMathStatus(eval, status);
+    }
+}
+//------------------------------------------------------------------------------
+// Solves a linear system with a Krylov method. The arguments are
+// (A, b, [restart,] tol, maxit, M1, M2, x0), where restart is only for gmres.
+//------------------------------------------------------------------------------
+static bool OmlKrylovSolve(EvaluatorInterface           eval,
+                           const std::vector<Currency>& inputs,
+                           std::vector<Currency>&       outputs,
+                           const std::string&           method)
+{
+    bool   gmres  = (method == "gmres");
+    int    offset = gmres ? 1 : 0;
+    size_t nargin = inputs.size();
+
+    if (nargin < 2 || nargin > static_cast<size_t>(7 + offset))
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    // right hand side
+    const Currency& input2 = inputs[1];
+
+    if (!input2.IsScalar() && !input2.IsMatrix())
+        throw OML_Error(OML_ERR_REALVECTOR, 2, OML_VAR_TYPE);
+
+    const hwMatrix* b = input2.ConvertToMatrix();
+
+    if (!b->IsReal() || !b->IsEmptyOrVector())
+        throw OML_Error(OML_ERR_REALVECTOR, 2, OML_VAR_TYPE);
+
+    int n = b->Size();
+
+    // optional scalar arguments, where [] selects the default
+    int  restart    = n;
+    bool hasRestart = false;
+
+    if (gmres && nargin > 2 && !inputs[2].IsEmpty())
+    {
+        if (!inputs[2].IsPositiveInteger())
+            throw OML_Error(OML_ERR_POSINTEGER, 3, OML_VAR_VALUE);
+
+        restart    = _min(static_cast<int>(inputs[2].Scalar()), n);
+        hasRestart = true;
+    }
+
+    double tol    = 1.0e-6;
+    int    tolArg = 3 + offset;
+
+    if (nargin >= static_cast<size_t>(tolArg) && !inputs[tolArg - 1].IsEmpty())
+    {
+        const Currency& cur = inputs[tolArg - 1];
+
+        if (!cur.IsScalar() || cur.Scalar() <= 0.0 || !IsFinite_T(cur.Scalar()))
+            throw OML_Error(OML_ERR_POSITIVE_SCALAR, tolArg, OML_VAR_VALUE);
+
+        tol = cur.Scalar();
+    }
+
+    int maxIter = gmres && hasRestart ? _min((n + restart - 1) / _max(restart, 1), 10) :
+                  _min(n, gmres ? 10 : 20);
+    int maxArg  = 4 + offset;
+
+    if (nargin >= static_cast<size_t>(maxArg) && !inputs[maxArg - 1].IsEmpty())
+    {
+        if (!inputs[maxArg - 1].IsPositiveInteger())
+            throw OML_Error(OML_ERR_POSINTEGER, maxArg, OML_VAR_MAXITER);
+
+        maxIter = static_cast<int>(inputs[maxArg - 1].Scalar());
+    }
+
+    // without a restart, gmres takes up to maxit inner iterations in a single
+    // cycle, so the basis only grows as large as the iterations need
+    if (gmres && !hasRestart)
+    {
+        restart = _min(n, maxIter);
+        maxIter = 1;
+    }
+
+    // operator and preconditioners
+    KrylovOperand A;
+    KrylovOperand M1;
+    KrylovOperand M2;
+
+    SetKrylovOperand(eval, inputs[0], 1, n, false, A);
+
+    int m1Arg = 5 + offset;
+
+    if (nargin >= static_cast<size_t>(m1Arg))
+    {
+        const Currency& cur = inputs[m1Arg - 1];
+
+        if (cur.IsString())
+            SetKrylovPrecondOption(eval, cur.StringVal(), m1Arg, A, M1);
+        else
+            SetKrylovOperand(eval, cur, m1Arg, n, true, M1);
+    }
+
+    if (nargin >= static_cast<size_t>(m1Arg + 1))
+        SetKrylovOperand(eval, inputs[m1Arg], m1Arg + 1, n, true, M2);
+
+    // initial estimate
+    std::unique_ptr<hwMatrix> x(EvaluatorInterface::allocateMatrix());
+    int x0Arg = 7 + offset;
+
+    if (nargin >= static_cast<size_t>(x0Arg) && !inputs[x0Arg - 1].IsEmpty())
+    {
+        const Currency& cur = inputs[x0Arg - 1];
+
+        if (!cur.IsScalar() && !cur.IsMatrix())
+            throw OML_Error(OML_ERR_REALVECTOR, x0Arg, OML_VAR_TYPE);
+
+        const hwMatrix* x0 = cur.ConvertToMatrix();
+
+        if (!x0->IsReal() || !x0->IsEmptyOrVector())
+            throw OML_Error(OML_ERR_REALVECTOR, x0Arg, OML_VAR_TYPE);
+
+        if (x0->Size() != n)
+            throw OML_Error(OML_ERR_ARRAYSIZE, 2, x0Arg);
+
+        *x = *x0;
+    }
+
+    KrylovFunc precond = (M1.kind == KrylovOperand::NONE &&
+                          M2.kind == KrylovOperand::NONE) ? NULL : KrylovPrecond;
+
+    int                       nargout = eval.GetNargoutValue();
+    std::unique_ptr<hwMatrix> resvec(nargout > 4 ? EvaluatorInterface::allocateMatrix() : nullptr);
+    std::unique_ptr<hwMatrix> iter(EvaluatorInterface::allocateMatrix(1, gmres ? 2 : 1, hwMatrix::REAL));
+    hwMathStatus              status;
+    int                       flag = 0;
+    double                    relres = 0.0;
+
+    // the file scope variables are set while solving
+    {
+        KrylovScope scope(&eval, &A, &M1, &M2);
+
+        if (method == "pcg")
+        {
+            int it = 0;
+            status = PCG(KrylovSystem, precond, *b, *x, tol, maxIter, flag, relres, it, resvec.get());
+            (*iter)(0) = it;
+        }
+        else if (method == "bicgstab")
+        {
+            double it = 0.0;
+            status = BiCGStab(KrylovSystem, precond, *b, *x, tol, maxIter, flag, relres, it, resvec.get());
+            (*iter)(0) = it;
+        }
+        else
+        {
+            int outer = 0;
+            int inner = 0;
+            status = GMRES(KrylovSystem, precond, *b, *x, restart, tol, maxIter, flag, relres,
+                           outer, inner, resvec.get());
+            (*iter)(0) = outer;
+            (*iter)(1) = inner;
+        }
+    }
+
+    if (!status.IsOk())
+    {
+        // map the argument positions of the solvers to the builtin
+        switch (status.GetArg1())
+        {
+            case 2:  status.SetArg1(m1Arg);  break;
+            case 3:  status.SetArg1(2);      break;
+            case 4:  status.SetArg1(x0Arg);  break;
+            default: break;
+        }
+
+        BuiltInFuncsUtils::CheckMathStatus(eval, status);
+    }
+
+    if (flag && nargout < 2)
+    {
+        char msg[128];
+#ifdef OS_WIN  // sprintf_s is a safer option
+        sprintf_s(msg, sizeof(msg), "Warning: %s stopped with flag %d before converging; "
+                  "relative residual is %g", method.c_str(), flag, relres);
+#else
+        sprintf(msg, "Warning: %s stopped with flag %d before converging; "
+                "relative residual is %g", method.c_str(), flag, relres);
+#endif
+        BuiltInFuncsUtils::SetWarning(eval, msg);
+    }
+
+    outputs.push_back(x.release());
+
+    if (nargout > 1)
+        outputs.push_back(static_cast<double>(flag));
+
+    if (nargout > 2)
+        outputs.push_back(relres);
+
+    if (nargout > 3)
+        outputs.push_back(iter.release());
+
+    if (nargout > 4)
+        outputs.push_back(resvec.release());
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Solves a symmetric positive definite system with the preconditioned
+// conjugate gradient method [pcg]
+//------------------------------------------------------------------------------
+bool OmlPcg(EvaluatorInterface           eval,
+            const std::vector<Currency>& inputs,
+            std::vector<Currency>&       outputs)
+{
+    return OmlKrylovSolve(eval, inputs, outputs, "pcg");
+}
+//------------------------------------------------------------------------------
+// Solves a linear system with the stabilized biconjugate gradient method
+// [bicgstab]
+//------------------------------------------------------------------------------
+bool OmlBicgstab(EvaluatorInterface           eval,
+                 const std::vector<Currency>& inputs,
+                 std::vector<Currency>&       outputs)
+{
+    return OmlKrylovSolve(eval, inputs, outputs, "bicgstab");
+}
+//------------------------------------------------------------------------------
+// Solves a linear system with the restarted generalized minimum residual
+// method [gmres]
+//------------------------------------------------------------------------------
+bool OmlGmres(EvaluatorInterface           eval,
+              const std::vector<Currency>& inputs,
+              std::vector<Currency>&       outputs)
+{
+    return OmlKrylovSolve(eval, inputs, outputs, "gmres");
+}
+//------------------------------------------------------------------------------
+// Sets an operand from a real matrix or sparse matrix argument, and returns
+// its dimensions
+//------------------------------------------------------------------------------
+static void SetSpectralMatrix(const Currency& input,
+                              int             argNum,
+                              KrylovOperand&  op,
+                              int&            m,
+                              int&            n)
+{
+    if (input.IsSparse())
+    {
+        op.sparse = input.MatrixS();
+        op.kind   = KrylovOperand::SPARSE;
+        m         = op.sparse->M();
+        n         = op.sparse->N();
+        return;
+    }
+
+    if (!input.IsScalar() && !input.IsMatrix())
+        throw OML_Error(OML_ERR_MATRIX, argNum, OML_VAR_TYPE);
+
+    op.dense = input.ConvertToMatrix();
+
+    if (!op.dense->IsReal())
+        throw OML_Error(OML_ERR_REAL, argNum, OML_VAR_TYPE);
+
+    op.kind = KrylovOperand::DENSE;
+    m       = op.dense->M();
+    n       = op.dense->N();
+}
+//------------------------------------------------------------------------------
+// Reads the tol, maxit and p fields of an options structure, and the issym
+// and v0 fields if they are requested
+//------------------------------------------------------------------------------
+static void GetSpectralOptions(const Currency&  input,
+                               int              argNum,
+                               double&          tol,
+                               int&             maxIter,
+                               int&             ncv,
+                               bool*            isSym = nullptr,
+                               const hwMatrix** v0    = nullptr)
+{
+    if (!input.IsStruct())
+        throw OML_Error(OML_ERR_STRUCT, argNum, OML_VAR_TYPE);
+
+    StructData* opt = input.Struct();
+
+    if (opt->N() != 1)
+        throw OML_Error(OML_ERR_OPTION, argNum);
+
+    const Currency& tolC = opt->GetValue(0, -1, "tol");
+
+    if (!tolC.IsEmpty())
+    {
+        if (!tolC.IsScalar() || tolC.Scalar() <= 0.0)
+            throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_RELTOL);
+
+        tol = tolC.Scalar();
+    }
+
+    const Currency& maxIterC = opt->GetValue(0, -1, "maxit");
+
+    if (!maxIterC.IsEmpty())
+    {
+        if (!maxIterC.IsPositiveInteger())
+            throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_MAXITER);
+
+        maxIter = static_cast<int>(maxIterC.Scalar());
+    }
+
+    const Currency& ncvC = opt->GetValue(0, -1, "p");
+
+    if (!ncvC.IsEmpty())
+    {
+        if (!ncvC.IsPositiveInteger())
+            throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_VALUE);
+
+        ncv = static_cast<int>(ncvC.Scalar());
+    }
+
+    if (isSym)
+    {
+        const Currency& isSymC = opt->GetValue(0, -1, "issym");
+
+        if (!isSymC.IsEmpty())
+        {
+            if (!isSymC.IsScalar())
+                throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_VALUE);
+
+            *isSym = (isSymC.Scalar() != 0.0);
+        }
+    }
+
+    if (v0)
+    {
+        const Currency& v0C = opt->GetValue(0, -1, "v0");
+
+        if (!v0C.IsEmpty())
+        {
+            if (!v0C.IsScalar() && !v0C.IsMatrix())
+                throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_VALUE);
+
+            *v0 = v0C.ConvertToMatrix();
+
+            if (!(*v0)->IsReal() || !(*v0)->IsEmptyOrVector())
+                throw OML_Error(OML_ERR_OPTIONVAL, argNum, OML_VAR_VALUE);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Returns a diagonal matrix with the elements of a vector
+//------------------------------------------------------------------------------
+static hwMatrix* DiagonalMatrix(const hwMatrix& d)
+{
+    int       k    = d.Size();
+    hwMatrix* diag = EvaluatorInterface::allocateMatrix(k, k, d.IsReal() ?
+                     hwMatrix::REAL : hwMatrix::COMPLEX);
+
+    diag->SetElements(0.0);
+
+    for (int i = 0; i < k; ++i)
+    {
+        if (d.IsReal())
+            (*diag)(i, i) = d(i);
+        else
+            diag->z(i, i) = d.z(i);
+    }
+
+    return diag;
+}
+//------------------------------------------------------------------------------
+// Computes k wanted eigenvalues of a matrix from its full decomposition, which
+// is used when the Krylov basis would span the whole space
+//------------------------------------------------------------------------------
+static void FullEigs(EvaluatorInterface&  eval,
+                     const KrylovOperand& A,
+                     int                  k,
+                     EigsWhich            which,
+                     bool                 shift,
+                     double               sigma,
+                     bool                 symmetric,
+                     hwMatrix&            V,
+                     hwMatrix&            D)
+{
+    hwMatrix     full;
+    hwMatrix     Vf;
+    hwMatrix     Df;
+    hwMathStatus status;
+
+    if (A.sparse)
+        status = A.sparse->Full(full);
+    else
+        full = *A.dense;
+
+    if (status.IsOk())
+        status = symmetric ? full.EigenSH(&Vf, Df) : full.Eigen(true, &Vf, Df);
+
+    if (!status.IsOk())
+    {
+        status.SetArg1(1);
+        BuiltInFuncsUtils::CheckMathStatus(eval, status);
+    }
+
+    int                 n = Df.Size();
+    std::vector<double> score(n);
+    std::vector<int>    order(n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        double re = Df.IsReal() ? Df(i) : Df.z(i).Real();
+        double im = Df.IsReal() ? 0.0   : Df.z(i).Imag();
+
+        if (shift)
+            score[i] = -sqrt((re - sigma) * (re - sigma) + im * im);
+        else if (which == EIGS_LARGEST_REAL)
+            score[i] = re;
+        else if (which == EIGS_SMALLEST_REAL)
+            score[i] = -re;
+        else
+            score[i] = sqrt(re * re + im * im);
+
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(),
+                     [&score](int a, int b) { return score[a] > score[b]; });
+
+    D.Dimension(k, 1, Df.IsReal() ? hwMatrix::REAL : hwMatrix::COMPLEX);
+    V.Dimension(n, k, Vf.IsReal() ? hwMatrix::REAL : hwMatrix::COMPLEX);
+
+    for (int j = 0; j < k; ++j)
+    {
+        int c = order[j];
+
+        if (Df.IsReal())
+            D(j) = Df(c);
+        else
+            D.z(j) = Df.z(c);
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (Vf.IsReal())
+                V(i, j) = Vf(i, c);
+            else
+                V.z(i, j) = Vf.z(i, c);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+// Computes a few eigenvalues and eigenvectors of a large matrix [eigs]
+//------------------------------------------------------------------------------
+bool OmlEigs(EvaluatorInterface           eval,
+             const std::vector<Currency>& inputs,
+             std::vector<Currency>&       outputs)
+{
+    size_t nargin = inputs.size();
+
+    if (nargin < 1 || nargin > 5)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    // operator, where a function handle is followed by its order
+    KrylovOperand A;
+    int           n      = 0;
+    int           offset = 0;
+
+    if (inputs[0].IsFunctionHandle())
+    {
+        if (nargin < 2)
+            throw OML_Error(OML_ERR_NUMARGIN);
+
+        if (!inputs[1].IsPositiveInteger())
+            throw OML_Error(OML_ERR_POSINTEGER, 2, OML_VAR_VALUE);
+
+        n      = static_cast<int>(inputs[1].Scalar());
+        offset = 1;
+
+        SetKrylovOperand(eval, inputs[0], 1, n, false, A);
+    }
+    else
+    {
+        int m = 0;
+
+        if (nargin > 4)
+            throw OML_Error(OML_ERR_NUMARGIN);
+
+        SetSpectralMatrix(inputs[0], 1, A, m, n);
+
+        if (m != n)
+            BuiltInFuncsUtils::CheckMathStatus(eval, hwMathStatus(HW_MATH_ERR_MTXNOTSQUARE, 1));
+    }
+
+    int kArg     = 2 + offset;
+    int sigmaArg = 3 + offset;
+    int optsArg  = 4 + offset;
+    int k        = _min(6, n);
+
+    if (nargin >= static_cast<size_t>(kArg) && !inputs[kArg - 1].IsEmpty())
+    {
+        if (!inputs[kArg - 1].IsPositiveInteger())
+            throw OML_Error(OML_ERR_POSINTEGER, kArg, OML_VAR_VALUE);
+
+        k = static_cast<int>(inputs[kArg - 1].Scalar());
+
+        if (k > n || (A.kind == KrylovOperand::FUNCTION && k >= n))
+            throw OML_Error(OML_ERR_INVALID_RANGE, kArg, OML_VAR_VALUE);
+    }
+
+    // wanted eigenvalues, or the shift of a shift-invert operator
+    EigsWhich which = EIGS_LARGEST_MAG;
+    bool      shift = false;
+    double    sigma = 0.0;
+
+    if (nargin >= static_cast<size_t>(sigmaArg) && !inputs[sigmaArg - 1].IsEmpty())
+    {
+        const Currency& cur = inputs[sigmaArg - 1];
+
+        if (cur.IsString())
+        {
+            std::string opt = cur.StringVal();
+            std::transform(opt.begin(), opt.end(), opt.begin(), ::tolower);
+
+            if (opt == "lm")
+                which = EIGS_LARGEST_MAG;
+            else if (opt == "la" || opt == "lr")
+                which = EIGS_LARGEST_REAL;
+            else if (opt == "sa" || opt == "sr")
+                which = EIGS_SMALLEST_REAL;
+            else if (opt == "sm")
+                shift = true;
+            else
+                throw OML_Error(OML_ERR_OPTIONVAL, sigmaArg, OML_VAR_VALUE);
+        }
+        else if (cur.IsScalar())
+        {
+            shift = true;
+            sigma = cur.Scalar();
+
+            if (!IsFinite_T(sigma))
+                throw OML_Error(OML_ERR_FINITE, sigmaArg, OML_VAR_VALUE);
+        }
+        else
+        {
+            throw OML_Error(OML_ERR_OPTIONVAL, sigmaArg, OML_VAR_VALUE);
+        }
+    }
+
+    double          tol       = 1.0e-10;
+    int             maxIter   = 300;
+    int             ncv       = _max(2 * k + 1, 20);
+    bool            symmetric = false;
+    const hwMatrix* v0        = nullptr;
+
+    if (A.kind == KrylovOperand::DENSE)
+        symmetric = A.dense->IsSymmetric();
+    else if (A.kind == KrylovOperand::SPARSE)
+        symmetric = A.sparse->IsSymmetric();
+
+    if (nargin >= static_cast<size_t>(optsArg))
+    {
+        GetSpectralOptions(inputs[optsArg - 1], optsArg, tol, maxIter, ncv,
+                           A.kind == KrylovOperand::FUNCTION ? &symmetric : nullptr, &v0);
+
+        if (ncv <= k)
+            throw OML_Error(OML_ERR_OPTIONVAL, optsArg, OML_VAR_VALUE);
+
+        if (v0 && v0->Size() != n)
+            throw OML_Error(OML_ERR_OPTIONVAL, optsArg, OML_VAR_VALUE);
+    }
+
+    ncv = _min(ncv, n);
+
+    int                       nargout = eval.GetNargoutValue();
+    std::unique_ptr<hwMatrix> V(EvaluatorInterface::allocateMatrix());
+    std::unique_ptr<hwMatrix> D(EvaluatorInterface::allocateMatrix());
+    int                       flag = 0;
+
+    if (A.kind != KrylovOperand::FUNCTION && ncv >= n)
+    {
+        // the Krylov basis would span the whole space
+        FullEigs(eval, A, k, which, shift, sigma, symmetric, *V, *D);
+    }
+    else
+    {
+        KrylovFunc   op = KrylovSystem;
+        hwMathStatus status;
+
+        if (shift && A.kind == KrylovOperand::DENSE)
+        {
+            hwMatrix shifted(*A.dense);
+
+            for (int i = 0; i < n; ++i)
+                shifted(i, i) -= sigma;
+
+            status = A.factors.Factor(shifted, A.pivots);
+            op     = KrylovShiftInvert;
+        }
+        else if (shift && A.kind == KrylovOperand::SPARSE)
+        {
+            std::vector<int>    diagIdx(n);
+            std::vector<double> diagVal(n, sigma);
+            hwMatrixS           sigmaI;
+            hwMatrixS           shifted;
+
+            for (int i = 0; i < n; ++i)
+                diagIdx[i] = i;
+
+            status = sigmaI.Assemble(n, n, diagIdx, diagIdx, diagVal);
+
+            if (status.IsOk())
+                status = shifted.Subtr(*A.sparse, sigmaI);
+
+            if (status.IsOk())
+                status = shifted.Factor(A.lower, A.upper, A.rowPerm, A.colPerm);
+
+            op = KrylovShiftInvert;
+        }
+
+        // a singular shifted matrix means sigma is an eigenvalue
+        if (!status.IsOk())
+        {
+            status.SetArg1(1);
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+        }
+
+        {
+            // the file scope variables are set while solving
+            KrylovScope scope(&eval, &A);
+
+            status = Eigs(op, n, k, shift ? EIGS_LARGEST_MAG : which, symmetric, ncv,
+                          tol, maxIter, v0, nargout > 1 ? V.get() : nullptr, *D, flag);
+        }
+
+        if (!status.IsOk())
+        {
+            if (status.GetArg1() == 9)
+                status.SetArg1(optsArg);
+
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+        }
+
+        // the eigenvalues of the shift-invert operator are 1/(lambda-sigma)
+        if (shift)
+        {
+            for (int i = 0; i < k; ++i)
+            {
+                if (D->IsReal())
+                    (*D)(i) = sigma + 1.0 / (*D)(i);
+                else
+                    D->z(i) = hwComplex(sigma, 0.0) + hwComplex(1.0, 0.0) / D->z(i);
+            }
+        }
+
+        if (flag && nargout < 3)
+            BuiltInFuncsUtils::SetWarning(eval, "Warning: eigs stopped before all "
+                                          "eigenvalues converged");
+    }
+
+    if (nargout < 2)
+    {
+        outputs.push_back(D.release());
+        return true;
+    }
+
+    outputs.push_back(V.release());
+    outputs.push_back(DiagonalMatrix(*D));
+
+    if (nargout > 2)
+        outputs.push_back(static_cast<double>(flag));
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Reads the matrix and the number of singular values of svds and rsvd
+//------------------------------------------------------------------------------
+static void GetSingularArgs(const std::vector<Currency>& inputs,
+                            KrylovOperand&               A,
+                            int&                         m,
+                            int&                         n,
+                            int&                         k)
+{
+    SetSpectralMatrix(inputs[0], 1, A, m, n);
+
+    k = _min(6, _min(m, n));
+
+    if (inputs.size() > 1 && !inputs[1].IsEmpty())
+    {
+        if (!inputs[1].IsPositiveInteger())
+            throw OML_Error(OML_ERR_POSINTEGER, 2, OML_VAR_VALUE);
+
+        k = static_cast<int>(inputs[1].Scalar());
+
+        if (k > _min(m, n))
+            throw OML_Error(OML_ERR_INVALID_RANGE, 2, OML_VAR_VALUE);
+    }
+}
+//------------------------------------------------------------------------------
+// Pushes the singular values, or the singular vectors and values
+//------------------------------------------------------------------------------
+static void PushSingularOutputs(int                        nargout,
+                                std::unique_ptr<hwMatrix>& U,
+                                std::unique_ptr<hwMatrix>& S,
+                                std::unique_ptr<hwMatrix>& V,
+                                std::vector<Currency>&     outputs)
+{
+    if (nargout < 2)
+    {
+        outputs.push_back(S.release());
+        return;
+    }
+
+    outputs.push_back(U.release());
+    outputs.push_back(DiagonalMatrix(*S));
+    outputs.push_back(V.release());
+}
+//------------------------------------------------------------------------------
+// Computes a few of the largest singular values and vectors of a large
+// matrix [svds]
+//------------------------------------------------------------------------------
+bool OmlSvds(EvaluatorInterface           eval,
+             const std::vector<Currency>& inputs,
+             std::vector<Currency>&       outputs)
+{
+    size_t nargin = inputs.size();
+
+    if (nargin < 1 || nargin > 4)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    KrylovOperand A;
+    int           m = 0;
+    int           n = 0;
+    int           k = 0;
+
+    GetSingularArgs(inputs, A, m, n, k);
+
+    // only the largest singular values are supported
+    if (nargin > 2 && !inputs[2].IsEmpty())
+    {
+        if (!inputs[2].IsString() || (inputs[2].StringVal() != "L" &&
+                                      inputs[2].StringVal() != "l"))
+            throw OML_Error(OML_ERR_OPTIONVAL, 3, OML_VAR_VALUE);
+    }
+
+    int    order   = _min(m, n);
+    double tol     = 1.0e-10;
+    int    maxIter = 300;
+    int    ncv     = _max(2 * k + 1, 20);
+
+    if (nargin > 3)
+    {
+        GetSpectralOptions(inputs[3], 4, tol, maxIter, ncv);
+
+        if (ncv <= k)
+            throw OML_Error(OML_ERR_OPTIONVAL, 4, OML_VAR_VALUE);
+    }
+
+    ncv = _min(ncv, order);
+
+    int                       nargout = eval.GetNargoutValue();
+    std::unique_ptr<hwMatrix> U(EvaluatorInterface::allocateMatrix());
+    std::unique_ptr<hwMatrix> S(EvaluatorInterface::allocateMatrix());
+    std::unique_ptr<hwMatrix> V(EvaluatorInterface::allocateMatrix());
+    hwMathStatus              status;
+    int                       flag = 0;
+
+    if (ncv >= order)
+    {
+        // the Krylov basis would span the whole space
+        hwMatrix full;
+        hwMatrix Uf;
+        hwMatrix Sf;
+        hwMatrix Vf;
+
+        if (A.sparse)
+            status = A.sparse->Full(full);
+        else
+            full = *A.dense;
+
+        if (status.IsOk() && order > 0)
+            status = full.SVD(2, &Uf, Sf, &Vf);
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(1);
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+        }
+
+        S->Dimension(k, 1, hwMatrix::REAL);
+        U->Dimension(m, k, hwMatrix::REAL);
+        V->Dimension(n, k, hwMatrix::REAL);
+
+        for (int j = 0; j < k; ++j)
+        {
+            (*S)(j) = Sf(j);
+
+            for (int i = 0; i < m; ++i)
+                (*U)(i, j) = Uf(i, j);
+
+            for (int i = 0; i < n; ++i)
+                (*V)(i, j) = Vf(i, j);
+        }
+    }
+    else
+    {
+        bool vectors = (nargout > 1);
+
+        {
+            // the file scope variables are set while solving
+            KrylovScope scope(&eval, &A);
+
+            status = Svds(KrylovSystem, KrylovSystemTrans, m, n, k, ncv, tol, maxIter,
+                          vectors ? U.get() : nullptr, *S, vectors ? V.get() : nullptr,
+                          flag);
+        }
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(1);
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+        }
+
+        if (flag && nargout < 4)
+            BuiltInFuncsUtils::SetWarning(eval, "Warning: svds stopped before all "
+                                          "singular values converged");
+    }
+
+    PushSingularOutputs(nargout, U, S, V, outputs);
+
+    if (nargout > 3)
+        outputs.push_back(static_cast<double>(flag));
+
+    return true;
+}
+//------------------------------------------------------------------------------
+// Computes an approximation of the largest singular values and vectors of a
+// matrix with a randomized range finder [rsvd]
+//------------------------------------------------------------------------------
+bool OmlRsvd(EvaluatorInterface           eval,
+             const std::vector<Currency>& inputs,
+             std::vector<Currency>&       outputs)
+{
+    size_t nargin = inputs.size();
+
+    if (nargin < 1 || nargin > 4)
+        throw OML_Error(OML_ERR_NUMARGIN);
+
+    KrylovOperand A;
+    int           m = 0;
+    int           n = 0;
+    int           k = 0;
+
+    GetSingularArgs(inputs, A, m, n, k);
+
+    int oversample = 10;
+    int powerIter  = 2;
+
+    if (nargin > 2 && !inputs[2].IsEmpty())
+    {
+        if (!inputs[2].IsInteger() || inputs[2].Scalar() < 0.0)
+            throw OML_Error(OML_ERR_NATURALNUM, 3, OML_VAR_VALUE);
+
+        oversample = static_cast<int>(inputs[2].Scalar());
+    }
+
+    if (nargin > 3 && !inputs[3].IsEmpty())
+    {
+        if (!inputs[3].IsInteger() || inputs[3].Scalar() < 0.0)
+            throw OML_Error(OML_ERR_NATURALNUM, 4, OML_VAR_VALUE);
+
+        powerIter = static_cast<int>(inputs[3].Scalar());
+    }
+
+    int                       nargout = eval.GetNargoutValue();
+    bool                      vectors = (nargout > 1);
+    std::unique_ptr<hwMatrix> U(EvaluatorInterface::allocateMatrix());
+    std::unique_ptr<hwMatrix> S(EvaluatorInterface::allocateMatrix(0, 1, hwMatrix::REAL));
+    std::unique_ptr<hwMatrix> V(EvaluatorInterface::allocateMatrix());
+
+    if (k > 0)
+    {
+        hwMathStatus status;
+
+        {
+            // the file scope variables are set while solving
+            KrylovScope scope(&eval, &A);
+
+            status = RandomizedSVD(KrylovSystem, KrylovSystemTrans, m, n, k, oversample,
+                                   powerIter, vectors ? U.get() : nullptr, *S,
+                                   vectors ? V.get() : nullptr);
+        }
+
+        if (!status.IsOk())
+        {
+            status.SetArg1(1);
+            BuiltInFuncsUtils::CheckMathStatus(eval, status);
+        }
+    }
+    else
+    {
+        U->Dimension(m, 0, hwMatrix::REAL);
+        V->Dimension(n, 0, hwMatrix::REAL);
+    }
+
+    PushSingularOutputs(nargout, U, S, V, outputs);
+
+    return true;
+}
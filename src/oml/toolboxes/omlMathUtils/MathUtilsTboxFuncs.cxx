@@ -25,6 +25,7 @@
 #include "SpecialFuncs.h"
 
 #define STATAN "StatisticalAnalysis"
+#define LINA   "LinearAlgebra"
 
 //------------------------------------------------------------------------------
 // Entry point which registers toolbox with oml
@@ -37,6 +38,18 @@ int InitDll(EvaluatorInterface eval)
                                  FunctionMetaData(1, 1, STATAN));
     eval.RegisterBuiltInFunction("bins", OmlBins, 
                                  FunctionMetaData(2, 1, STATAN));
+    eval.RegisterBuiltInFunction("pcg", OmlPcg, 
+                                 FunctionMetaData(7, 5, LINA));
+    eval.RegisterBuiltInFunction("bicgstab", OmlBicgstab, 
+                                 FunctionMetaData(7, 5, LINA));
+    eval.RegisterBuiltInFunction("gmres", OmlGmres, 
+                                 FunctionMetaData(8, 5, LINA));
+    eval.RegisterBuiltInFunction("eigs", OmlEigs, 
+                                 FunctionMetaData(5, 3, LINA));
+    eval.RegisterBuiltInFunction("svds", OmlSvds, 
+                                 FunctionMetaData(4, 4, LINA));
+    eval.RegisterBuiltInFunction("rsvd", OmlRsvd, 
+                                 FunctionMetaData(4, 3, LINA));
     return 1;
 }
 //------------------------------------------------------------------------------
@@ -66,6 +66,66 @@ bool OmlGamma(EvaluatorInterface           eval,
 bool OmlBins(EvaluatorInterface           eval, 
              const std::vector<Currency>& inputs, 
              std::vector<Currency>&       outputs);
+//!
+//! Returns true after solving a symmetric positive definite system with the
+//! preconditioned conjugate gradient method
+//! \param eval    Evaluator interface
+//! \param inputs  Vector of inputs
+//! \param outputs Vector of outputs
+//!
+bool OmlPcg(EvaluatorInterface           eval,
+            const std::vector<Currency>& inputs,
+            std::vector<Currency>&       outputs);
+//!
+//! Returns true after solving a linear system with the stabilized
+//! biconjugate gradient method
+//! \param eval    Evaluator interface
+//! \param inputs  Vector of inputs
+//! \param outputs Vector of outputs
+//!
+bool OmlBicgstab(EvaluatorInterface           eval,
+                 const std::vector<Currency>& inputs,
+                 std::vector<Currency>&       outputs);
+//!
+//! Returns true after solving a linear system with the restarted generalized
+//! minimum residual method
+//! \param eval    Evaluator interface
+//! \param inputs  Vector of inputs
+//! \param outputs Vector of outputs
+//!
+bool OmlGmres(EvaluatorInterface           eval,
+              const std::vector<Currency>& inputs,
+              std::vector<Currency>&       outputs);
+//!
+//! Returns true after computing a few eigenvalues and eigenvectors of a large
+//! matrix
+//! \param eval    Evaluator interface
+//! \param inputs  Vector of inputs
+//! \param outputs Vector of outputs
+//!
+bool OmlEigs(EvaluatorInterface           eval,
+             const std::vector<Currency>& inputs,
+             std::vector<Currency>&       outputs);
+//!
+//! Returns true after computing a few of the largest singular values and
+//! vectors of a large matrix
+//! \param eval    Evaluator interface
+//! \param inputs  Vector of inputs
+//! \param outputs Vector of outputs
+//!
+bool OmlSvds(EvaluatorInterface           eval,
+             const std::vector<Currency>& inputs,
+             std::vector<Currency>&       outputs);
+//!
+//! Returns true after approximating the largest singular values and vectors
+//! of a matrix with a randomized range finder
+//! \param eval    Evaluator interface
+//! \param inputs  Vector of inputs
+//! \param outputs Vector of outputs
+//!
+bool OmlRsvd(EvaluatorInterface           eval,
+             const std::vector<Currency>& inputs,
+             std::vector<Currency>&       outputs);
 
 //!
 //! Returns outputs after executing the beta function
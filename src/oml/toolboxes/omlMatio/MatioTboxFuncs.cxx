@@ -23,6 +23,8 @@
 #include "EvaluatorInt.h" 
 #include "OML_Error.h"
 #include "StructData.h" 
+#include "hwMatrix.h"
+#include "IntegerArithmetic.h"
 #include "matio.h"
 
 // Returns true after loading file in ascii format
@@ -51,6 +53,65 @@ void log_helper(int level, char* message)
 	throw OML_Error(message);
 }
 
+//------------------------------------------------------------------------------
+// Gets the currency type of a MAT integer class, or -1 if it is not one
+//------------------------------------------------------------------------------
+static int MatIntegerType(matio_classes class_type)
+{
+	switch (class_type)
+	{
+		case MAT_C_INT8:   return Currency::TYPE_INT8;
+		case MAT_C_INT16:  return Currency::TYPE_INT16;
+		case MAT_C_INT32:  return Currency::TYPE_INT32;
+		case MAT_C_INT64:  return Currency::TYPE_INT64;
+		case MAT_C_UINT8:  return Currency::TYPE_UINT8;
+		case MAT_C_UINT16: return Currency::TYPE_UINT16;
+		case MAT_C_UINT32: return Currency::TYPE_UINT32;
+		case MAT_C_UINT64: return Currency::TYPE_UINT64;
+		default:           return -1;
+	}
+}
+//------------------------------------------------------------------------------
+// Copies the data of a real 2D MAT integer variable into an integer matrix
+//------------------------------------------------------------------------------
+struct MatVarToInteger
+{
+	explicit MatVarToInteger(matvar_t* in) : var(in) {}
+
+	template <typename T>
+	void Apply()
+	{
+		int num_rows = static_cast<int>(var->dims[0]);
+		int num_cols = static_cast<int>(var->dims[1]);
+
+		hwTMatrix<T, hwTComplex<T> >* mat = new hwTMatrix<T, hwTComplex<T> >(num_rows, num_cols, hwTMatrix<T, hwTComplex<T> >::REAL);
+		result = mat;
+
+		if (mat->Size())
+			memcpy(mat->GetRealData(), var->data, mat->Size() * sizeof(T));
+	}
+
+	matvar_t* var;
+	Currency  result;
+};
+
+//------------------------------------------------------------------------------
+// Gets the data of an integer matrix
+//------------------------------------------------------------------------------
+struct IntegerDataPtr
+{
+	explicit IntegerDataPtr(const Currency& in) : cur(in), data(NULL) {}
+
+	template <typename T>
+	void Apply()
+	{
+		data = (void*) cur.MatrixInt<T>()->GetRealData();
+	}
+
+	const Currency& cur;
+	void*           data;
+};
+
 Currency MatVarToCurrency(matvar_t* var)
 {
 	if (var->class_type == MAT_C_DOUBLE)
@@ -161,6 +222,13 @@ Currency MatVarToCurrency(matvar_t* var)
 			return mat_n;
 		}
 	}
+	else if (MatIntegerType(var->class_type) >= 0 && var->rank == 2 && !var->isLogical && !var->isComplex)
+	{
+		// integer classes are kept, logicals are loaded below
+		MatVarToInteger functor(var);
+		DispatchInteger(MatIntegerType(var->class_type), functor);
+		return functor.result;
+	}
 	else if (var->class_type == MAT_C_UINT8)
 	{
 		if (var->rank == 1) // not sure about this
@@ -209,6 +277,38 @@ Currency MatVarToCurrency(matvar_t* var)
 			throw OML_Error(OML_ERR_UNSUPPORTDIM);
 		}
 	}
+	else if (var->class_type == MAT_C_SINGLE && var->rank == 2)
+	{
+		// kept in single precision
+		int num_rows = static_cast<int>(var->dims[0]);
+		int num_cols = static_cast<int>(var->dims[1]);
+		int size     = num_rows * num_cols;
+
+		hwMatrixF* mat = NULL;
+
+		if (var->isComplex)
+		{
+			mat = new hwMatrixF(num_rows, num_cols, hwMatrixF::COMPLEX);
+
+			mat_complex_split_t *complex_data = (mat_complex_split_t*)var->data;
+			float *rp = (float*)complex_data->Re;
+			float *ip = (float*)complex_data->Im;
+
+			for (int k=0; k<size; k++)
+				mat->z(k) = hwTComplex<float>(rp[k], ip[k]);
+		}
+		else
+		{
+			mat = new hwMatrixF(num_rows, num_cols, hwMatrixF::REAL);
+
+			float* data = (float*)var->data;
+
+			for (int k=0; k<size; k++)
+				(*mat)(k) = data[k];
+		}
+
+		return mat;
+	}
 	else if (var->class_type == MAT_C_CHAR)
 	{
 		if (var->rank == 2)
@@ -494,6 +594,55 @@ matvar_t* CurrencyToMatVar(const char* name, const Currency& cur)
 
 		var = Mat_VarCreate(name, MAT_C_CHAR, MAT_T_UINT8, 2, dims, (void*)ptr, flags);
 	}
+	else if (cur.IsSingle())
+	{
+		const hwMatrixF* mtx = cur.MatrixF();
+		dims[0] = mtx->M();
+		dims[1] = mtx->N();
+
+		if (mtx->IsReal())
+		{
+			var = Mat_VarCreate(name, MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, (void*) mtx->GetRealData(), 0);
+		}
+		else
+		{
+			mat_complex_split_t t;
+			float* temp_real = new float [mtx->Size()];
+			float* temp_imag = new float [mtx->Size()];
+
+			for (int j=0; j<mtx->Size(); j++)
+			{
+				temp_real[j] = mtx->z(j).Real();
+				temp_imag[j] = mtx->z(j).Imag();
+			}
+
+			t.Re = temp_real;
+			t.Im = temp_imag;
+
+			var = Mat_VarCreate(name, MAT_C_SINGLE, MAT_T_SINGLE, 2, dims, &t, MAT_F_COMPLEX);
+
+			delete [] temp_real;
+			delete [] temp_imag;
+		}
+	}
+	else if (cur.IsIntegerType())
+	{
+		static const matio_classes classes[] = { MAT_C_INT8, MAT_C_INT16, MAT_C_INT32, MAT_C_INT64,
+		                                         MAT_C_UINT8, MAT_C_UINT16, MAT_C_UINT32, MAT_C_UINT64 };
+		static const matio_types   types[]   = { MAT_T_INT8, MAT_T_INT16, MAT_T_INT32, MAT_T_INT64,
+		                                         MAT_T_UINT8, MAT_T_UINT16, MAT_T_UINT32, MAT_T_UINT64 };
+		int index = cur.GetType() - Currency::TYPE_INT8;
+		int m, n;
+
+		cur.IntegerDims(m, n);
+		dims[0] = m;
+		dims[1] = n;
+
+		IntegerDataPtr functor(cur);
+		DispatchInteger(cur.GetType(), functor);
+
+		var = Mat_VarCreate(name, classes[index], types[index], 2, dims, functor.data, 0);
+	}
 	else if (cur.IsComplex())
 	{
 		hwComplex cplx = cur.Complex();
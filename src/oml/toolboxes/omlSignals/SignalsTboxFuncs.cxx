@@ -610,9 +610,9 @@ bool OmlXcorr(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
     }
 
     Currency cur1 = inputs[0];
-    if (!cur1.IsMatrix() && !cur1.IsScalar())
+    if (!cur1.IsMatrix() && !cur1.IsScalar() && !cur1.IsComplex())
     {
-        throw OML_Error(OML_ERR_REALVECTOR, 1, OML_VAR_DATA);
+        throw OML_Error(OML_ERR_VECTOR, 1, OML_VAR_DATA);
     }
 
     const hwMatrix* v1 = cur1.ConvertToMatrix();
@@ -627,9 +627,9 @@ bool OmlXcorr(EvaluatorInterface eval, const std::vector<Currency>& inputs, std:
         }
         else
         {
-            if (!inputs[1].IsMatrix() && !inputs[1].IsScalar())
+            if (!inputs[1].IsMatrix() && !inputs[1].IsScalar() && !inputs[1].IsComplex())
             {
-                throw OML_Error(OML_ERR_REALVECTOR, 2, OML_VAR_DATA);
+                throw OML_Error(OML_ERR_VECTOR, 2, OML_VAR_DATA);
             }
             v2 = inputs[1].ConvertToMatrix();
         }